@@ -0,0 +1,322 @@
+/*
+AssetCache.hpp
+--------------
+Copyright (c) 2024, theJ89
+
+Description:
+    AssetCache, AssetHandle and AssetCacheStats are defined here.
+
+    An AssetCache loads images (into CPU memory) and textures (onto the GPU) and shares them: loading an asset that's
+    already cached returns another handle to the cached copy instead of decoding and uploading it again.
+    Images and textures can be loaded from PNG or .bsi files, and textures from KTX files too, either on disk or in memory;
+    the format is recognized from the data, not the filename.
+
+    Assets are content-addressed. Each is keyed on the 64-bit hash of its file's contents (see util/Hash.hpp), its size,
+    and what it was loaded as, so identical files at different paths share one asset, and a file that's changed since it was
+    cached is loaded again instead of returning stale pixels. The cache also remembers the hash of each path it's loaded,
+    along with the file's size and modification time; while those haven't changed, loading the path again is a hit
+    without reading the file at all.
+
+    Handles are reference-counted. An asset stays cached while any handle refers to it, and for as long as the budgets
+    allow after that: when the bytes of image pixels (CPU) or texture data (GPU) the cache holds go over their budgets,
+    assets that nothing refers to are evicted, least recently loaded first. Assets that are still referenced are never evicted,
+    so a budget can be exceeded while everything in the cache is in use.
+
+    An AssetCache and its handles aren't thread-safe; they should only be used on the thread that renders,
+    since loading and evicting textures creates and destroys them. Handles may outlive the cache: assets that are still
+    referenced when it's destroyed are kept until their last handle lets go of them.
+*/
+#ifndef BS_ASSETCACHE_HPP
+#define BS_ASSETCACHE_HPP
+
+
+
+
+//Includes
+#include <cstddef>                  //std::size_t
+#include <filesystem>               //std::filesystem::file_time_type
+#include <limits>                   //std::numeric_limits
+#include <list>                     //std::list
+#include <memory>                   //std::unique_ptr
+#include <type_traits>              //std::is_same_v
+#include <unordered_map>            //std::unordered_map
+#include <utility>                  //std::swap
+
+#include <brimstone/types.hpp>      //Brimstone::ustring, Brimstone::uint64
+#include <brimstone/Image.hpp>      //Brimstone::Image
+#include <brimstone/Graphics.hpp>   //Brimstone::Graphics, Brimstone::Texture
+#include <brimstone/Exception.hpp>  //Brimstone::NullPointerException
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Forward declarations
+class AssetCache;
+
+
+
+
+namespace Private {
+
+
+
+
+//What an asset was loaded as. The same file loaded as an image and as a texture is cached twice.
+enum class AssetKind {
+    IMAGE,
+    TEXTURE,
+    MIPMAPPED_TEXTURE
+};
+
+//Identifies an asset by its contents
+struct AssetKey {
+    uint64    hash;
+    uint64    size;
+    AssetKind kind;
+
+    bool operator ==( const AssetKey& right ) const;
+};
+
+struct AssetKeyHash {
+    std::size_t operator ()( const AssetKey& key ) const;
+};
+
+struct AssetEntry {
+    AssetCache* cache;      //nullptr if the cache was destroyed while handles still referred to the asset
+    AssetKey    key;
+
+    //Only one of these is used, depending on key.kind
+    Image       image;
+    Texture     texture;
+
+    uint64      cpuBytes;
+    uint64      gpuBytes;
+    std::size_t refs;
+};
+
+
+
+
+} //namespace Private
+
+
+
+
+//Totals for an AssetCache's loads, and the assets it currently holds
+struct AssetCacheStats {
+    std::size_t hits;        //Loads that returned an asset that was already cached
+    std::size_t misses;      //Loads that had to decode an asset, including ones that failed
+    std::size_t failures;    //Loads that failed because the data couldn't be read or decoded (also counted as misses)
+    std::size_t evictions;   //Assets evicted to stay within a budget, or by trim()
+
+    std::size_t images;      //Images currently cached
+    std::size_t textures;    //Textures currently cached
+    uint64      cpuBytes;    //Bytes of image pixels currently cached, including row padding
+    uint64      gpuBytes;    //Bytes of texture data currently cached, including mipmaps
+};
+
+//A reference-counted handle to an asset in an AssetCache.
+//T is const Image for images (which are shared, so they can't be changed), or Texture for textures.
+template< typename T >
+class AssetHandle {
+friend class AssetCache;
+public:
+    AssetHandle();
+    AssetHandle( const AssetHandle& toCopy );
+    AssetHandle& operator =( const AssetHandle& toCopy );
+    AssetHandle( AssetHandle&& toMove );
+    AssetHandle& operator =( AssetHandle&& toMove );
+    ~AssetHandle();
+
+    void        release();
+
+    bool        isValid() const;
+    T&          get() const;
+    T&          operator *() const;
+    T*          operator ->() const;
+    uint64      getHash() const;
+    std::size_t getRefCount() const;
+private:
+    explicit AssetHandle( Private::AssetEntry* const entry );
+private:
+    Private::AssetEntry* m_entry;
+};
+
+using ImageHandle   = AssetHandle< const Image >;
+using TextureHandle = AssetHandle< Texture >;
+
+class AssetCache {
+template< typename T > friend class AssetHandle;
+public:
+    static constexpr uint64 UNLIMITED = std::numeric_limits< uint64 >::max();
+public:
+    AssetCache();
+    AssetCache( const AssetCache& toCopy ) = delete;
+    AssetCache& operator =( const AssetCache& toCopy ) = delete;
+    ~AssetCache();
+
+    void                    init( Graphics& graphics );
+    void                    destroy();
+
+    ImageHandle             loadImage( const ustring& filename );
+    ImageHandle             loadImage( const void* const data, const std::size_t size );
+    TextureHandle           loadTexture( const ustring& filename, const bool generateMipmaps = true );
+    TextureHandle           loadTexture( const void* const data, const std::size_t size, const bool generateMipmaps = true );
+
+    void                    setBudget( const uint64 cpuBytes, const uint64 gpuBytes );
+    uint64                  getCPUBudget() const;
+    uint64                  getGPUBudget() const;
+    void                    trim();
+
+    std::size_t             getCount() const;
+    const AssetCacheStats&  getStats() const;
+    void                    resetStats();
+private:
+    using Entries = std::list< std::unique_ptr< Private::AssetEntry > >;
+    using Index   = std::unordered_map< Private::AssetKey, Entries::iterator, Private::AssetKeyHash >;
+
+    //What a file contained the last time it was read
+    struct PathRecord {
+        uint64                          hash;
+        uint64                          size;
+        std::filesystem::file_time_type time;
+    };
+
+    Private::AssetEntry*    load( const ustring& filename, const Private::AssetKind kind );
+    Private::AssetEntry*    load( const void* const data, const std::size_t size, const Private::AssetKind kind );
+    Private::AssetEntry*    find( const Private::AssetKey& key );
+    Private::AssetEntry*    insert( const Private::AssetKey& key, const void* const data, const std::size_t size );
+    bool                    decode( const void* const data, const std::size_t size, Private::AssetEntry& entry );
+    void                    release( Private::AssetEntry* const entry );
+    void                    evict( const bool all );
+    void                    erase( Entries::iterator it );
+private:
+    Graphics*                                  m_graphics;
+    uint64                                     m_cpuBudget;
+    uint64                                     m_gpuBudget;
+
+    //Most recently loaded first. Entries are allocated separately so handles can point at them, and keep them if the cache is destroyed first.
+    Entries                                    m_entries;
+    Index                                      m_index;
+    std::unordered_map< ustring, PathRecord >  m_paths;
+
+    AssetCacheStats                            m_stats;
+};
+
+
+
+
+template< typename T >
+AssetHandle< T >::AssetHandle() :
+    m_entry( nullptr ) {
+}
+
+template< typename T >
+AssetHandle< T >::AssetHandle( Private::AssetEntry* const entry ) :
+    m_entry( entry ) {
+    if( m_entry != nullptr )
+        ++m_entry->refs;
+}
+
+template< typename T >
+AssetHandle< T >::AssetHandle( const AssetHandle& toCopy ) :
+    AssetHandle( toCopy.m_entry ) {
+}
+
+template< typename T >
+AssetHandle< T >& AssetHandle< T >::operator =( const AssetHandle& toCopy ) {
+    AssetHandle copy( toCopy );
+    std::swap( m_entry, copy.m_entry );
+    return *this;
+}
+
+template< typename T >
+AssetHandle< T >::AssetHandle( AssetHandle&& toMove ) :
+    m_entry( toMove.m_entry ) {
+    toMove.m_entry = nullptr;
+}
+
+template< typename T >
+AssetHandle< T >& AssetHandle< T >::operator =( AssetHandle&& toMove ) {
+    std::swap( m_entry, toMove.m_entry );
+    toMove.release();
+    return *this;
+}
+
+template< typename T >
+AssetHandle< T >::~AssetHandle() {
+    release();
+}
+
+//Lets go of the asset, leaving the handle empty. If this was the last handle to it, the asset may be evicted.
+template< typename T >
+void AssetHandle< T >::release() {
+    if( m_entry == nullptr )
+        return;
+
+    Private::AssetEntry* const entry = m_entry;
+    m_entry = nullptr;
+
+    //The cache was destroyed while this asset was still referenced; the last handle to it frees it
+    if( entry->cache == nullptr ) {
+        if( --entry->refs == 0 )
+            delete entry;
+        return;
+    }
+    entry->cache->release( entry );
+}
+
+//Returns false if the handle is empty; either it was never loaded, the asset couldn't be loaded, or it's been released
+template< typename T >
+bool AssetHandle< T >::isValid() const {
+    return m_entry != nullptr;
+}
+
+//Returns the asset. Throws a NullPointerException if the handle is empty.
+template< typename T >
+T& AssetHandle< T >::get() const {
+    if( m_entry == nullptr )
+        throw NullPointerException();
+
+    if constexpr( std::is_same_v< T, Texture > )
+        return m_entry->texture;
+    else
+        return m_entry->image;
+}
+
+template< typename T >
+T& AssetHandle< T >::operator *() const {
+    return get();
+}
+
+template< typename T >
+T* AssetHandle< T >::operator ->() const {
+    return &get();
+}
+
+//Returns the hash of the asset's contents, or 0 if the handle is empty
+template< typename T >
+uint64 AssetHandle< T >::getHash() const {
+    return m_entry != nullptr ? m_entry->key.hash : 0;
+}
+
+//Returns the number of handles to the asset, including this one, or 0 if the handle is empty
+template< typename T >
+std::size_t AssetHandle< T >::getRefCount() const {
+    return m_entry != nullptr ? m_entry->refs : 0;
+}
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_ASSETCACHE_HPP
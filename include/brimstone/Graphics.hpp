@@ -8,6 +8,10 @@ Description:
     Graphics is a low-level class that acts as a wrapper around an underlying graphics API (OpenGL, Direct3D, etc).
     A Graphics object is the means by which a program renders graphics to a Window.
     It provides several methods for rendering
+
+    A Graphics object can also be initialized without a window, in which case it renders offscreen.
+    An offscreen Graphics has no window to present to, so it should render into a Framebuffer,
+    whose pixels can be read back into an Image; this is what render tests and GPU benchmarks use.
 */
 #ifndef BS_GRAPHICS_HPP
 #define BS_GRAPHICS_HPP
@@ -17,10 +21,13 @@ Description:
 
 //Includes
 #include <cstddef>                               //std::size_t
+#include <vector>                                //std::vector
 
-#include <brimstone/types.hpp>                   //Brimstone::ustring, Brimstone::uint
+#include <brimstone/types.hpp>                   //Brimstone::ustring, Brimstone::ubyte, Brimstone::uint, Brimstone::uint16, Brimstone::uint32, Brimstone::uint64
 #include <brimstone/graphics/DGraphicsImpl.hpp>  //Brimstone::Private::DGraphicsImpl, etc.
-#include <brimstone/graphics/Enums.hpp>          //Brimstone::AlphaFunc, Brimstone::ShaderType, Brimstone::FilterType, Brimstone::WrapType
+#include <brimstone/graphics/SlotPool.hpp>       //Brimstone::Private::Handle
+#include <brimstone/graphics/Enums.hpp>          //Brimstone::AlphaFunc, Brimstone::ShaderType, Brimstone::FilterType, Brimstone::WrapType, Brimstone::IndexType, etc.
+#include <brimstone/graphics/VertexLayout.hpp>   //Brimstone::VertexLayout
 
 
 
@@ -32,16 +39,33 @@ namespace Brimstone {
 
 //Forward declarations
 class Window;
+class TextureData;
 class Shader;
 class Program;
 class VertexBuffer;
+class IndexBuffer;
+class StreamingBuffer;
+class DrawIndirectBuffer;
 class Texture;
 class Sampler;
+class Framebuffer;
+class CommandBuffer;
+class Image;
 
 
 
 
 //Class definitions
+//Counts of the work submitted through a Graphics object since it was initialized.
+//Draws made and state changed by calling the graphics API directly aren't counted.
+struct GraphicsStats {
+    uint64 drawCalls;
+    uint64 instances;       //Instances drawn; a draw that isn't instanced draws one
+    uint64 triangles;       //Triangles drawn, counting every instance
+    uint64 stateChanges;    //Render state set, and programs, textures and samplers bound while executing command buffers
+    uint64 clears;
+};
+
 class Graphics {
 public:
     Graphics();
@@ -49,6 +73,7 @@ public:
     Graphics& operator =( Graphics& toCopy ) = delete;
     ~Graphics();
 
+    void            init();
     void            init( const Brimstone::Window& window );
     void            destroy();
 
@@ -58,10 +83,31 @@ public:
     Shader          createShader( const ShaderType type );
     Program         createProgram();
     VertexBuffer    createVertexBuffer();
+    IndexBuffer     createIndexBuffer();
+    StreamingBuffer createStreamingBuffer( const std::size_t regionSize, const std::size_t regionCount = 3 );
+    DrawIndirectBuffer createDrawIndirectBuffer( const std::size_t capacity, const std::size_t regionCount = 3 );
     Texture         createTexture();
     Sampler         createSampler();
+    Framebuffer     createFramebuffer();
 
     void            flush();
+    void            finish();
+
+    void            blit( Framebuffer& source, const int x, const int y, const int width, const int height,
+                          const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter = FilterType::LINEAR );
+
+    void            execute( const CommandBuffer& buffer );
+    void            execute( const CommandBuffer* const* buffers, const std::size_t count );
+
+    void            drawIndexed( VertexBuffer& vertices, IndexBuffer& indices );
+    void            drawIndexed( VertexBuffer& vertices, IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex = 0 );
+    void            draw( StreamingBuffer& vertices, const std::size_t first, const std::size_t count );
+    void            drawIndexed( StreamingBuffer& vertices, IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex = 0 );
+    void            drawInstanced( VertexBuffer& vertices, const std::size_t instanceCount );
+    void            drawIndexedInstanced( VertexBuffer& vertices, IndexBuffer& indices, const std::size_t instanceCount );
+    void            drawIndexedInstanced( VertexBuffer& vertices, IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex,
+                                          const std::size_t instanceCount, const uint baseInstance = 0 );
+    void            multiDrawIndirect( VertexBuffer& vertices, IndexBuffer& indices, DrawIndirectBuffer& commands );
 
     void            enableBackFaceCulling();
     void            disableBackFaceCulling();
@@ -95,6 +141,7 @@ public:
     void            setBlend( const bool enabled );
     bool            getBlend() const;
     void            setBlendModeToTransparency();
+    void            setBlendMode( const BlendMode mode );
 
     void            setClearColor( const float r, const float g, const float b, const float a );
     void            getClearColor( float (&rgbaOut)[4] ) const;
@@ -110,6 +157,15 @@ public:
     bool            getVSync() const;
 
     void            swapBuffers();
+
+    GraphicsStats   getStats() const;
+
+    bool            isTextureFormatSupported( const TextureFormat format ) const;
+    bool            isProgramBinarySupported() const;
+    bool            isParallelShaderCompileSupported() const;
+    bool            isMultiDrawIndirectSupported() const;
+    ustring         getDeviceName() const;
+    ustring         getDriverVersion() const;
 private:
     Private::GraphicsImpl* m_impl;
 };
@@ -129,14 +185,18 @@ public:
     void destroy();
     void setSource( const ustring& source );
     void compile();
+    void beginCompile();
+    bool isCompileComplete() const;
+    void endCompile();
 private:
-    Shader( Private::ShaderImpl* impl );
+    Shader( const Private::Handle< Private::ShaderImpl > impl );
 private:
-    Private::ShaderImpl* m_impl;
+    Private::Handle< Private::ShaderImpl > m_impl;
 };
 
 class Program {
 friend class Graphics;
+friend class CommandBuffer;
 public:
     Program();
     Program( const Program& toCopy ) = delete;
@@ -150,8 +210,15 @@ public:
 
     void attachShader( const Shader& shader );
     void detachShader( const Shader& shader );
+    void bindAttribute( const char* const name, const uint index );
 
     void link();
+    void beginLink();
+    bool isLinkComplete() const;
+    void endLink();
+    void setBinaryRetrievable( const bool retrievable );
+    bool getBinary( std::vector< ubyte >& dataOut, uint32& formatOut ) const;
+    bool setBinary( const uint32 format, const void* const data, const std::size_t size );
     void use();
     void stopUsing();
 
@@ -163,13 +230,14 @@ public:
     void setUniform( const char* const name, const int x, const int y, const int z, const int w );
     void setUniform( const char* const name, const float x, const float y, const float z, const float w );
 private:
-    Program( Private::ProgramImpl* impl );
+    Program( const Private::Handle< Private::ProgramImpl > impl );
 private:
-    Private::ProgramImpl* m_impl;
+    Private::Handle< Private::ProgramImpl > m_impl;
 };
 
 class VertexBuffer {
 friend class Graphics;
+friend class CommandBuffer;
 public:
     VertexBuffer();
     VertexBuffer( const VertexBuffer& toCopy ) = delete;
@@ -181,21 +249,120 @@ public:
     void create();
     void destroy();
 
-    void set( const float* const data, const std::size_t sizeInBytes );
-    void set( const float* const data, const std::size_t offsetInBytes, const std::size_t sizeInBytes );
+    void set( const void* const data, const std::size_t sizeInBytes );
+    void set( const void* const data, const std::size_t offsetInBytes, const std::size_t sizeInBytes );
     void bind();
     void unbind();
     void draw();
 
+    void                setLayout( const VertexLayout& layout );
+    const VertexLayout& getLayout() const;
+
+    void                addInstanceStream( const VertexBuffer& stream, const VertexLayout& layout );
+    void                clearInstanceStreams();
+
     void setType( const int type );
 private:
-    VertexBuffer( Private::VertexBufferImpl* impl );
+    VertexBuffer( const Private::Handle< Private::VertexBufferImpl > impl );
 private:
-    Private::VertexBufferImpl* m_impl;
+    Private::Handle< Private::VertexBufferImpl > m_impl;
+};
+
+class IndexBuffer {
+friend class Graphics;
+friend class CommandBuffer;
+public:
+    IndexBuffer();
+    IndexBuffer( const IndexBuffer& toCopy ) = delete;
+    IndexBuffer& operator =( const IndexBuffer& toCopy ) = delete;
+    IndexBuffer( IndexBuffer&& toMove );
+    IndexBuffer& operator =( IndexBuffer&& toMove );
+    ~IndexBuffer();
+
+    void        create();
+    void        destroy();
+
+    void        set( const uint16* const indices, const std::size_t count );
+    void        set( const uint32* const indices, const std::size_t count );
+    void        set( const void* const indices, const std::size_t count, const IndexType type );
+    void        set( const void* const indices, const std::size_t offset, const std::size_t count );
+
+    IndexType   getType() const;
+    std::size_t getCount() const;
+private:
+    IndexBuffer( const Private::Handle< Private::IndexBufferImpl > impl );
+private:
+    Private::Handle< Private::IndexBufferImpl > m_impl;
+};
+
+class StreamingBuffer {
+friend class Graphics;
+friend class CommandBuffer;
+friend class Texture;
+public:
+    StreamingBuffer();
+    StreamingBuffer( const StreamingBuffer& toCopy ) = delete;
+    StreamingBuffer& operator =( const StreamingBuffer& toCopy ) = delete;
+    StreamingBuffer( StreamingBuffer&& toMove );
+    StreamingBuffer& operator =( StreamingBuffer&& toMove );
+    ~StreamingBuffer();
+
+    void                create();
+    void                destroy();
+
+    void                setLayout( const VertexLayout& layout );
+    const VertexLayout& getLayout() const;
+
+    void                beginFrame();
+    void                endFrame();
+
+    void*               allocate( const std::size_t size, const std::size_t alignment, std::size_t& offsetOut );
+    void*               allocateVertices( const std::size_t count, std::size_t& firstOut );
+
+    std::size_t         getRegionSize() const;
+    std::size_t         getRegionCount() const;
+    std::size_t         getRemaining() const;
+    bool                isPersistent() const;
+    std::size_t         getStallCount() const;
+private:
+    StreamingBuffer( const Private::Handle< Private::StreamingBufferImpl > impl );
+private:
+    Private::Handle< Private::StreamingBufferImpl > m_impl;
+};
+
+class DrawIndirectBuffer {
+friend class Graphics;
+public:
+    DrawIndirectBuffer();
+    DrawIndirectBuffer( const DrawIndirectBuffer& toCopy ) = delete;
+    DrawIndirectBuffer& operator =( const DrawIndirectBuffer& toCopy ) = delete;
+    DrawIndirectBuffer( DrawIndirectBuffer&& toMove );
+    DrawIndirectBuffer& operator =( DrawIndirectBuffer&& toMove );
+    ~DrawIndirectBuffer();
+
+    void        create();
+    void        destroy();
+
+    void        beginFrame();
+    void        endFrame();
+
+    void        add( const std::size_t count, const std::size_t first = 0, const int baseVertex = 0, const std::size_t instanceCount = 1, const uint baseInstance = 0 );
+
+    std::size_t getCapacity() const;
+    std::size_t getRemaining() const;
+    std::size_t getBatchCount() const;
+    bool        isPersistent() const;
+    std::size_t getStallCount() const;
+private:
+    DrawIndirectBuffer( const Private::Handle< Private::DrawIndirectBufferImpl > impl );
+private:
+    Private::Handle< Private::DrawIndirectBufferImpl > m_impl;
 };
 
 class Texture {
 friend class Graphics;
+friend class CommandBuffer;
+friend class Framebuffer;
 public:
     Texture();
     Texture( const Texture& toCopy ) = delete;
@@ -208,23 +375,34 @@ public:
     void destroy();
 
     void set( const std::size_t width, const std::size_t height, const void* data );
+    void set( const TextureData& data );
+    void setStorage( const std::size_t width, const std::size_t height, const TextureFormat format, const std::size_t levels = 0 );
+    void setLevel( const std::size_t level, const void* data );
+    void setRegion( const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height, const void* data );
+    void setRegion( const std::size_t level, const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height,
+                    StreamingBuffer& source, const std::size_t offset );
+    void generateMipmaps();
+    void setBaseLevel( const std::size_t level );
 
     void bind();
     void unbind();
 
-    std::size_t getWidth() const;
-    std::size_t getHeight() const;
+    std::size_t   getWidth() const;
+    std::size_t   getHeight() const;
+    TextureFormat getFormat() const;
+    std::size_t   getLevelCount() const;
 private:
-    Texture( Private::TextureImpl* impl );
+    Texture( const Private::Handle< Private::TextureImpl > impl );
 private:
-    Private::TextureImpl* m_impl;
+    Private::Handle< Private::TextureImpl > m_impl;
 };
 
 class Sampler {
 friend class Graphics;
+friend class CommandBuffer;
 public:
     Sampler();
-    Sampler( Private::SamplerImpl* impl );
+    Sampler( const Private::Handle< Private::SamplerImpl > impl );
     Sampler( const Sampler& toCopy ) = delete;
     Sampler& operator =( const Sampler& toCopy ) = delete;
     Sampler( Sampler&& toMove );
@@ -238,11 +416,49 @@ public:
     void setMagFilter( const FilterType type );
     void setUWrap( const WrapType type );
     void setVWrap( const WrapType type );
+    void setMipFilter( const MipFilterType type );
+    void setMaxAnisotropy( const float anisotropy );
 
     void bind();
     void unbind();
 private:
-    Private::SamplerImpl* m_impl;
+    Private::Handle< Private::SamplerImpl > m_impl;
+};
+
+class Framebuffer {
+friend class Graphics;
+public:
+    Framebuffer();
+    Framebuffer( const Framebuffer& toCopy ) = delete;
+    Framebuffer& operator =( const Framebuffer& toCopy ) = delete;
+    Framebuffer( Framebuffer&& toMove );
+    Framebuffer& operator =( Framebuffer&& toMove );
+    ~Framebuffer();
+
+    void        create();
+    void        destroy();
+
+    void        setColor( Texture& texture, const std::size_t level = 0 );
+    void        setColor( const std::size_t width, const std::size_t height, const TextureFormat format, const std::size_t samples );
+    void        setDepth( const std::size_t width, const std::size_t height, const std::size_t samples = 0 );
+    bool        isComplete() const;
+
+    void        bind();
+    void        unbind();
+
+    void        read( Image& imageOut );
+    void        read( const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height, void* const rgbaOut );
+    void        blit( Framebuffer& target, const int x, const int y, const int width, const int height,
+                      const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter = FilterType::NEAREST );
+    void        resolve( Framebuffer& target );
+
+    std::size_t getWidth() const;
+    std::size_t getHeight() const;
+    std::size_t getSamples() const;
+private:
+    Framebuffer( const Private::Handle< Private::FramebufferImpl > impl );
+private:
+    Private::Handle< Private::FramebufferImpl > m_impl;
 };
 
 
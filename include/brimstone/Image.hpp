@@ -5,6 +5,24 @@ Copyright (c) 2024, theJ89
 
 Description:
     Simple class for storing a raw image.
+
+    Images are stored as RGBA8, with rows from top to bottom.
+    Storage the image allocates itself comes from a std::pmr::memory_resource (the default resource unless another one is given),
+    and each row starts on a multiple of ROW_ALIGNMENT bytes, so there may be padding after each row; see getStride().
+    An image can also be a view of pixels it doesn't own (see view()), such as a mapped buffer or part of a larger image;
+    the pixels must outlive the view, and aren't freed when the view is destroyed.
+    PNGs can be loaded from a file or decoded from memory (e.g. a file mapped into memory, or an entry in a pack file).
+    Since each PNG is read straight from where it's stored, decoding one from memory doesn't copy it first.
+    decodePNG() can also decode a PNG into storage supplied by the caller, such as memory allocated from a mapped
+    StreamingBuffer, so it can be uploaded to a texture without being copied again.
+
+    Images that are loaded often should be converted to .bsi files ahead of time with save() (or the ImageConverter tool);
+    load() maps them into memory and at most decompresses them, which is much faster than decoding a PNG.
+
+    Images can be post-processed in place (flipped, swizzled to BGRA, premultiplied, converted from sRGB to linear)
+    with vectorized operations; see util/PixelOps.hpp.
+    They can also be resized, or have a complete mipmap chain built from them for a Texture, without a GPU;
+    see util/Resample.hpp.
 */
 #ifndef BS_IMAGE_HPP
 #define BS_IMAGE_HPP
@@ -13,8 +31,13 @@ Description:
 
 
 //Includes
-#include <brimstone/types.hpp>  //Brimstone::ustring, Brimstone::ubyte
-#include <brimstone/Size.hpp>   //Brimstone::Size2i
+#include <cstddef>                           //std::size_t
+#include <memory_resource>                   //std::pmr::memory_resource
+
+#include <brimstone/types.hpp>               //Brimstone::ustring, Brimstone::ubyte, Brimstone::int32
+#include <brimstone/Size.hpp>                //Brimstone::Size2i
+#include <brimstone/graphics/ImageFile.hpp>  //Brimstone::ImageCompression
+#include <brimstone/util/Resample.hpp>       //Brimstone::ResampleFilter, Brimstone::ThreadPool
 
 
 
@@ -24,9 +47,26 @@ namespace Brimstone {
 
 
 
+//Forward declarations
+class TextureData;
+
+
+
+
 class Image {
+public:
+    //Rows of images allocated by Image start on a multiple of this many bytes
+    static constexpr std::size_t ROW_ALIGNMENT = 64;
+
+    static Image       view( ubyte* const data, const Size2i size, const std::size_t stride = 0 );
+    static std::size_t getAlignedStride( const int32 width );
+    static bool        getPNGSize( const void* const data, const std::size_t size, Size2i& sizeOut );
+    static bool        decodePNG( const void* const data, const std::size_t size, void* const destination, const std::size_t destinationSize,
+                                  const std::size_t stride = 0 );
 public:
     Image();
+    explicit Image( std::pmr::memory_resource* const resource );
+    explicit Image( const Size2i size, std::pmr::memory_resource* const resource = nullptr );
     Image( ubyte* const data, const Size2i size );
     Image( const Image& toCopy ) = delete;
     Image& operator =( const Image& toCopy ) = delete;
@@ -34,16 +74,50 @@ public:
     Image& operator =( Image&& toMove );
     ~Image();
 
-    void   set( ubyte* const data, const Size2i size );
-    bool   loadPNG( const ustring& filename );
-    void   destroy();
-
-    bool   isValid() const;
-    ubyte* getData() const;
-    Size2i getSize() const;
+    void        allocate( const Size2i size );
+    void        set( ubyte* const data, const Size2i size );
+    bool        loadPNG( const ustring& filename );
+    bool        loadPNG( const void* const data, const std::size_t size );
+    bool        load( const ustring& filename );
+    bool        load( const void* const data, const std::size_t size );
+    bool        save( const ustring& filename, const ImageCompression compression = ImageCompression::NONE, const bool mipmaps = false ) const;
+    void        destroy();
+
+    void        flipVertical();
+    void        swapRedBlue();
+    void        premultiplyAlpha();
+    void        unpremultiplyAlpha();
+    void        convertSRGBToLinear();
+
+    Image       resize( const Size2i size, const ResampleFilter filter = ResampleFilter::LANCZOS3, const bool srgb = false,
+                        ThreadPool* const pool = nullptr ) const;
+    TextureData buildMipChain( const ResampleFilter filter = ResampleFilter::KAISER, const bool srgb = false, ThreadPool* const pool = nullptr ) const;
+
+    Image       getView() const;
+    bool        isValid() const;
+    bool        isView() const;
+    ubyte*      getData() const;
+    ubyte*      getRow( const int32 y ) const;
+    Size2i      getSize() const;
+    std::size_t getStride() const;
+
+    std::pmr::memory_resource* getMemoryResource() const;
+private:
+    //How the image's pixels are freed
+    enum class Ownership {
+        NONE,       //They aren't; the image is empty or a view
+        ARRAY,      //With delete[]; given to set()
+        RESOURCE    //With the image's memory resource; allocated with allocate()
+    };
+
+    bool        decodeBSI( const ImageFile& file );
+    void        forEachRow( void ( *operation )( ubyte* const data, const std::size_t pixelCount ) );
 private:
-    ubyte* m_data;
-    Size2i m_size;
+    ubyte*                     m_data;
+    Size2i                     m_size;
+    std::size_t                m_stride;
+    Ownership                  m_ownership;
+    std::pmr::memory_resource* m_resource;
 };
 
 
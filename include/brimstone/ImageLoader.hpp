@@ -0,0 +1,118 @@
+/*
+ImageLoader.hpp
+---------------
+Copyright (c) 2024, theJ89
+
+Description:
+    ImageLoader is defined here.
+
+    An ImageLoader decodes batches of PNGs in parallel on a ThreadPool, so loading many images at once
+    scales with the number of cores instead of decoding them one after another.
+    Images can be loaded from files or from PNGs already in memory (e.g. a mapped pack file).
+
+    Each image is delivered through a std::future, or by a callback that's called on the worker thread that decoded it
+    as soon as it's ready. An image that couldn't be loaded is delivered empty (see Image::isValid()).
+
+    The loader keeps statistics on everything it's decoded, including its throughput: the number of bytes of PNG data
+    decoded per second of wall-clock time that the loader spent with at least one image in flight.
+*/
+#ifndef BS_IMAGELOADER_HPP
+#define BS_IMAGELOADER_HPP
+
+
+
+
+//Includes
+#include <chrono>                         //std::chrono::steady_clock
+#include <condition_variable>             //std::condition_variable
+#include <cstddef>                        //std::size_t
+#include <functional>                     //std::function
+#include <future>                         //std::future
+#include <memory>                         //std::unique_ptr
+#include <mutex>                          //std::mutex
+#include <vector>                         //std::vector
+
+#include <brimstone/types.hpp>            //Brimstone::ustring, Brimstone::uint64
+#include <brimstone/Image.hpp>            //Brimstone::Image
+#include <brimstone/util/ThreadPool.hpp>  //Brimstone::ThreadPool
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//A PNG in memory. The memory must stay valid until the image has been delivered.
+struct ImageBlob {
+    const void* data;
+    std::size_t size;
+};
+
+//Totals for every image an ImageLoader has finished loading
+struct ImageLoaderStats {
+    std::size_t images;         //Images decoded successfully
+    std::size_t failures;       //Images that couldn't be loaded
+    uint64      encodedBytes;   //Bytes of PNG data read
+    uint64      decodedBytes;   //Bytes of RGBA8 pixels produced
+    double      milliseconds;   //Wall-clock time spent with at least one image in flight
+};
+
+class ImageLoader {
+public:
+    //Called with the index of the image in its batch; the image can be moved out of.
+    //Anything it throws is passed to uncaughtException(), since it's called on a worker thread.
+    using Callback = std::function< void( const std::size_t index, Image& image ) >;
+public:
+    ImageLoader();
+    explicit ImageLoader( const std::size_t threadCount );
+    explicit ImageLoader( ThreadPool& pool );
+    ImageLoader( const ImageLoader& toCopy ) = delete;
+    ImageLoader& operator =( const ImageLoader& toCopy ) = delete;
+    ~ImageLoader();
+
+    std::future< Image >                load( const ustring& filename );
+    std::future< Image >                load( const ImageBlob blob );
+    std::vector< std::future< Image > > load( const std::vector< ustring >& filenames );
+    std::vector< std::future< Image > > load( const std::vector< ImageBlob >& blobs );
+    void                                load( const std::vector< ustring >& filenames, Callback callback );
+    void                                load( const std::vector< ImageBlob >& blobs, Callback callback );
+
+    void                                wait();
+
+    std::size_t                         getThreadCount() const;
+    std::size_t                         getPendingCount() const;
+    ImageLoaderStats                    getStats() const;
+    double                              getThroughput() const;
+    void                                resetStats();
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void                                begin( const std::size_t count );
+    void                                end();
+
+    Image                               decode( const ustring& filename );
+    Image                               decode( const ImageBlob blob );
+    void                                record( const Image& image, const std::size_t encodedBytes );
+private:
+    //Only set if the loader created its own pool
+    std::unique_ptr< ThreadPool >       m_ownPool;
+    ThreadPool*                         m_pool;
+
+    mutable std::mutex                  m_mutex;
+    std::condition_variable             m_idle;
+    std::size_t                         m_pending;
+    Clock::time_point                   m_busySince;
+    ImageLoaderStats                    m_stats;
+};
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_IMAGELOADER_HPP
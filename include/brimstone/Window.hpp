@@ -17,10 +17,13 @@ Description:
 //Includes
 #include <brimstone/window/DWindowImpl.hpp>    //Brimstone::Private::WindowImpl
 #include <brimstone/Bounds.hpp>                //Brimstone::Bounds2i
-#include <brimstone/types.hpp>                 //Brimstone::ustring
+#include <brimstone/types.hpp>                 //Brimstone::ustring, Brimstone::uint64
 #include <brimstone/window/WindowEvent.hpp>    //Brimstone::WindowEvent
 #include <brimstone/window/WindowDisplay.hpp>  //Brimstone::WindowDisplay
 #include <brimstone/window/WindowHandle.hpp>   //Brimstone::WindowHandle
+#include <brimstone/util/RingBuffer.hpp>       //Brimstone::RingBufferOverflow
+
+#include <cstddef>                             //std::size_t
 
 
 
@@ -49,8 +52,17 @@ public:
 
     bool            peekEvent( WindowEvent& eventOut );
     bool            getEvent( WindowEvent& eventOut );
+    std::size_t     pollEvents( WindowEvent* const eventsOut, const std::size_t max );
     void            pushEvent( const WindowEvent& eventIn );
 
+    void            setEventQueueCapacity( const std::size_t capacity, const RingBufferOverflow overflow = RingBufferOverflow::GROW );
+    std::size_t     getEventQueueCapacity() const;
+    uint64          getDroppedEventCount() const;
+
+    void            setEventCoalescing( const bool coalesce );
+    bool            getEventCoalescing() const;
+    uint64          getCoalescedEventCount() const;
+
     void            setTitle( const ustring& title );
     ustring         getTitle() const;
 
@@ -99,6 +111,9 @@ public:
     void            setKeepCursorCentered( const bool keepCursorCentered );
     bool            getKeepCursorCentered() const;
 
+    void            setRawMouseInput( const bool rawMouseInput );
+    bool            getRawMouseInput() const;
+
     void            sendToTop();
     void            sendToBottom();
 
@@ -0,0 +1,251 @@
+/*
+graphics/CommandBuffer.hpp
+--------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    CommandBuffer and the commands it records are defined here.
+
+    A CommandBuffer records draw, bind and state commands into a compact binary stream instead of executing them,
+    so scene submission can be spread across several threads: each thread records into its own CommandBuffer
+    (recording doesn't touch the graphics API, so it's safe on any thread), and the thread that owns the context
+    executes them all with Graphics::execute().
+
+    Commands are recorded in packets. Each packet is started with begin() and tagged with a 64-bit sort key
+    (see makeSortKey()). When command buffers are executed, the packets from all of them are sorted by their keys
+    (packets with equal keys keep the order they were recorded in), then replayed in that order.
+    Since packets can be reordered, each packet should set up any state its draws rely on.
+    Redundant program, texture and sampler binds between consecutive packets are skipped during replay,
+    which is what sorting by program and material is for.
+
+    Commands are stored in blocks of memory owned by the CommandBuffer. reset() keeps these blocks,
+    so once a CommandBuffer has grown to fit a frame's commands, recording doesn't allocate.
+
+    The objects referenced by recorded commands (programs, buffers, textures, samplers) must stay alive
+    until the command buffer has been executed. Commands refer to them by handle, so executing a command that refers
+    to an object that has since been destroyed throws a GraphicsException rather than using a dangling pointer.
+*/
+#ifndef BS_GRAPHICS_COMMANDBUFFER_HPP
+#define BS_GRAPHICS_COMMANDBUFFER_HPP
+
+
+
+
+//Includes
+#include <cstddef>                               //std::size_t
+#include <memory>                                //std::unique_ptr
+#include <vector>                                //std::vector
+
+#include <brimstone/types.hpp>                   //Brimstone::ubyte, Brimstone::uint, Brimstone::uint8, Brimstone::uint16, Brimstone::uint32, etc.
+#include <brimstone/graphics/DGraphicsImpl.hpp>  //Brimstone::Private::ProgramImpl, etc.
+#include <brimstone/graphics/Enums.hpp>          //Brimstone::BlendMode
+#include <brimstone/graphics/SlotPool.hpp>       //Brimstone::Private::Handle
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Forward declarations
+class Program;
+class VertexBuffer;
+class IndexBuffer;
+class StreamingBuffer;
+class Texture;
+class Sampler;
+
+
+
+
+enum class CommandType : uint16 {
+    USE_PROGRAM,
+    SET_UNIFORM,
+    BIND_TEXTURE,
+    SET_BLEND_MODE,
+    SET_DEPTH_TEST,
+    SET_DEPTH_MASK,
+    SET_BACK_FACE_CULLING,
+    SET_SCISSOR_TEST,
+    SET_SCISSOR_BOX,
+    SET_VIEWPORT,
+    SET_CLEAR_COLOR,
+    CLEAR,
+    DRAW_INDEXED,
+    DRAW_STREAMING
+};
+
+enum class UniformType : uint8 {
+    INT,
+    UINT,
+    FLOAT,
+    INT2,
+    FLOAT2,
+    INT4,
+    FLOAT4
+};
+
+//Every command starts with a header, followed by the command's data. size includes the header.
+struct alignas( 8 ) CommandHeader {
+    CommandType type;
+    uint16      size;
+};
+
+//Command data, one struct per CommandType
+namespace Commands {
+
+struct UseProgram {
+    Private::Handle< Private::ProgramImpl >         program;
+};
+
+//The uniform's null-terminated name immediately follows this struct.
+//It's set on whichever program was most recently used.
+struct SetUniform {
+    UniformType                                     type;
+    union {
+        int32                                   i[4];
+        uint32                                  u[4];
+        float                                   f[4];
+    };
+
+    const char* getName() const { return reinterpret_cast< const char* >( this + 1 ); }
+};
+
+//sampler is nullptr if the texture's own sampling state should be used
+struct BindTexture {
+    Private::Handle< Private::TextureImpl >         texture;
+    Private::Handle< Private::SamplerImpl >         sampler;
+};
+
+struct SetBlendMode {
+    BlendMode                                       mode;
+};
+
+//Used by SET_DEPTH_TEST, SET_DEPTH_MASK, SET_BACK_FACE_CULLING and SET_SCISSOR_TEST
+struct SetEnabled {
+    bool                                            enabled;
+};
+
+//Used by SET_SCISSOR_BOX and SET_VIEWPORT
+struct SetRect {
+    int32                                           x;
+    int32                                           y;
+    int32                                           width;
+    int32                                           height;
+};
+
+struct SetClearColor {
+    float                                           rgba[4];
+};
+
+//instanceCount is 0 for a draw that isn't instanced
+struct DrawIndexed {
+    Private::Handle< Private::VertexBufferImpl >    vertices;
+    Private::Handle< Private::IndexBufferImpl >     indices;
+    uint32                                          first;
+    uint32                                          count;
+    int32                                           baseVertex;
+    uint32                                          instanceCount;
+    uint32                                          baseInstance;
+};
+
+//indices is nullptr for a draw that isn't indexed
+struct DrawStreaming {
+    Private::Handle< Private::StreamingBufferImpl > vertices;
+    Private::Handle< Private::IndexBufferImpl >     indices;
+    uint32                                          first;
+    uint32                                          count;
+    int32                                           baseVertex;
+};
+
+} //namespace Commands
+
+//A packet of commands recorded together under a single sort key
+struct CommandPacket {
+    uint64          key;
+    const ubyte*    data;
+    uint32          size;
+};
+
+class CommandBuffer {
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+public:
+    CommandBuffer( const std::size_t blockSize = DEFAULT_BLOCK_SIZE );
+    CommandBuffer( const CommandBuffer& toCopy ) = delete;
+    CommandBuffer& operator =( const CommandBuffer& toCopy ) = delete;
+
+    void                    reset();
+    void                    begin( const uint64 key );
+
+    void                    useProgram( const Program& program );
+    void                    setUniform( const char* const name, const int value );
+    void                    setUniform( const char* const name, const uint value );
+    void                    setUniform( const char* const name, const float value );
+    void                    setUniform( const char* const name, const int x, const int y );
+    void                    setUniform( const char* const name, const float x, const float y );
+    void                    setUniform( const char* const name, const int x, const int y, const int z, const int w );
+    void                    setUniform( const char* const name, const float x, const float y, const float z, const float w );
+    void                    bindTexture( const Texture& texture );
+    void                    bindTexture( const Texture& texture, const Sampler& sampler );
+
+    void                    setBlendMode( const BlendMode mode );
+    void                    setDepthTest( const bool enabled );
+    void                    setDepthMask( const bool enabled );
+    void                    setBackFaceCulling( const bool enabled );
+    void                    setScissorTest( const bool enabled );
+    void                    setScissorBox( const int x, const int y, const int width, const int height );
+    void                    setViewport( const int x, const int y, const int width, const int height );
+    void                    setClearColor( const float r, const float g, const float b, const float a );
+    void                    clear();
+
+    void                    drawIndexed( const VertexBuffer& vertices, const IndexBuffer& indices );
+    void                    drawIndexed( const VertexBuffer& vertices, const IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex = 0 );
+    void                    drawIndexedInstanced( const VertexBuffer& vertices, const IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex,
+                                                  const std::size_t instanceCount, const uint baseInstance = 0 );
+    void                    draw( const StreamingBuffer& vertices, const std::size_t first, const std::size_t count );
+    void                    drawIndexed( const StreamingBuffer& vertices, const IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex = 0 );
+
+    std::size_t             getPacketCount() const;
+    const CommandPacket&    getPacket( const std::size_t index ) const;
+    std::size_t             getCommandCount() const;
+    std::size_t             getSize() const;
+    std::size_t             getCapacity() const;
+private:
+    struct Block {
+        std::unique_ptr< ubyte[] >  data;
+        std::size_t                 size;
+    };
+
+    void*                   record( const CommandType type, const std::size_t dataSize );
+    ubyte*                  allocate( const std::size_t size );
+    void                    setUniform( const char* const name, const UniformType type, const void* const values, const std::size_t valuesSize );
+    void                    setEnabled( const CommandType type, const bool enabled );
+    void                    setRect( const CommandType type, const int x, const int y, const int width, const int height );
+private:
+    std::size_t                     m_blockSize;
+    std::vector< Block >            m_blocks;
+
+    //The block commands are currently being recorded into, and how much of it has been used
+    std::size_t                     m_block;
+    std::size_t                     m_used;
+
+    std::vector< CommandPacket >    m_packets;
+    std::size_t                     m_commandCount;
+    std::size_t                     m_size;
+};
+
+uint64 makeSortKey( const uint8 pass, const uint16 program, const uint16 material, const float depth );
+void   sortCommandPackets( const CommandBuffer* const* buffers, const std::size_t count, std::vector< CommandPacket >& packetsOut );
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_COMMANDBUFFER_HPP
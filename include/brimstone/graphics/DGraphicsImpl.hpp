@@ -10,8 +10,13 @@ Description:
     * ShaderImpl
     * ProgramImpl
     * VertexBufferImpl
+    * IndexBufferImpl
+    * StreamingBufferImpl
+    * DrawIndirectBufferImpl
     * TextureImpl
     * SamplerImpl
+    * FramebufferImpl
+    * GpuProfilerImpl
 
     These types are defined as a aliases of the chosen implementation.
 */
@@ -28,19 +33,29 @@ namespace Brimstone::Private {
 
 //Types
 #if defined( BS_BUILD_DIRECT3D )
-using GraphicsImpl     = class D3DGraphicsImpl;
-using ShaderImpl       = class D3DShader;
-using ProgramImpl      = class D3DProgram;
-using VertexBufferImpl = class D3DVertexBuffer;
-using TextureImpl      = class D3DTexture;
-using SamplerImpl      = class D3DSampler;
+using GraphicsImpl           = class D3DGraphicsImpl;
+using ShaderImpl             = class D3DShader;
+using ProgramImpl            = class D3DProgram;
+using VertexBufferImpl       = class D3DVertexBuffer;
+using IndexBufferImpl        = class D3DIndexBuffer;
+using StreamingBufferImpl    = class D3DStreamingBuffer;
+using DrawIndirectBufferImpl = class D3DDrawIndirectBuffer;
+using TextureImpl            = class D3DTexture;
+using SamplerImpl            = class D3DSampler;
+using FramebufferImpl        = class D3DFramebuffer;
+using GpuProfilerImpl        = class D3DGpuProfiler;
 #elif defined( BS_BUILD_OPENGL )
-using GraphicsImpl     = class GLGraphicsImpl;
-using ShaderImpl       = class GLShader;
-using ProgramImpl      = class GLProgram;
-using VertexBufferImpl = class GLVertexBuffer;
-using TextureImpl      = class GLTexture;
-using SamplerImpl      = class GLSampler;
+using GraphicsImpl           = class GLGraphicsImpl;
+using ShaderImpl             = class GLShader;
+using ProgramImpl            = class GLProgram;
+using VertexBufferImpl       = class GLVertexBuffer;
+using IndexBufferImpl        = class GLIndexBuffer;
+using StreamingBufferImpl    = class GLStreamingBuffer;
+using DrawIndirectBufferImpl = class GLDrawIndirectBuffer;
+using TextureImpl            = class GLTexture;
+using SamplerImpl            = class GLSampler;
+using FramebufferImpl        = class GLFramebuffer;
+using GpuProfilerImpl        = class GLGpuProfiler;
 #endif
 
 
@@ -31,6 +31,13 @@ enum class FilterType {
     LINEAR
 };
 
+//A MipFilterType specifies how a Sampler chooses between (and blends) a texture's mipmap levels when minifying.
+enum class MipFilterType {
+    NONE,     //Mipmaps aren't used; only the base level is sampled
+    NEAREST,  //The closest mipmap level is sampled
+    LINEAR    //The two closest mipmap levels are sampled and blended together
+};
+
 //A WrapType specifies what type of UV wrapping a sampler should use.
 enum class WrapType {
     REPEAT,
@@ -51,6 +58,49 @@ enum class AlphaFunc {
     ALWAYS
 };
 
+//A VertexAttributeType specifies the data type of each component of a vertex attribute.
+enum class VertexAttributeType {
+    BYTE,
+    UNSIGNED_BYTE,
+    SHORT,
+    UNSIGNED_SHORT,
+    INT,
+    UNSIGNED_INT,
+    HALF_FLOAT,
+    FLOAT
+};
+
+//A BlendMode specifies how the colors of drawn primitives are combined with the colors already in the framebuffer.
+enum class BlendMode {
+    NONE,           //Blending is disabled; drawn colors replace existing colors
+    TRANSPARENCY,   //Drawn colors are interpolated with existing colors by their alpha
+    PREMULTIPLIED,  //Same as TRANSPARENCY, but drawn colors have already been multiplied by their alpha
+    ADDITIVE        //Drawn colors, multiplied by their alpha, are added to existing colors
+};
+
+//A TextureFormat specifies how the texels of a texture are stored.
+//The BC and ETC2 formats are block-compressed: texels are stored in 4x4 blocks of 8 or 16 bytes each,
+//and must be uploaded from data that has already been compressed (e.g. a .ktx file).
+enum class TextureFormat {
+    R8,            //One 8-bit channel
+    RG8,           //Two 8-bit channels
+    RGBA8,         //Four 8-bit channels
+    SRGB8_ALPHA8,  //Same as RGBA8, but RGB are sRGB-encoded and converted to linear when sampled
+    BC1_RGBA,      //S3TC DXT1; 8 bytes per block
+    BC3_RGBA,      //S3TC DXT5; 16 bytes per block
+    BC4_R,         //RGTC1; 8 bytes per block
+    BC5_RG,        //RGTC2; 16 bytes per block
+    BC7_RGBA,      //BPTC; 16 bytes per block
+    ETC2_RGB8,     //8 bytes per block
+    ETC2_RGBA8     //ETC2 + EAC alpha; 16 bytes per block
+};
+
+//An IndexType specifies the size of the indices stored in an IndexBuffer.
+enum class IndexType {
+    UNSIGNED_SHORT,
+    UNSIGNED_INT
+};
+
 
 
 
@@ -0,0 +1,176 @@
+/*
+graphics/GpuProfiler.hpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    GpuProfiler and the results it produces are defined here.
+
+    A GpuProfiler measures how long the GPU spends on each pass of a frame.
+    Passes are marked with beginScope() / endScope() (or a GpuScope) between beginFrame() and endFrame();
+    scopes can be nested. Each scope is timed on both the CPU and the GPU.
+
+    GPU times come from timestamp queries, which the GPU writes some time after the commands are submitted.
+    To avoid stalling the CPU while it waits for them, a profiler keeps a ring of frames (three by default)
+    and only reads a frame's results once the GPU reports they're available, so results arrive a few frames late.
+    If every frame in the ring is still waiting on the GPU when a new frame begins, the oldest frame is dropped
+    rather than waited on.
+
+    Besides timing, each frame counts the draws, instances, triangles and state changes submitted through Graphics,
+    and if the driver supports pipeline statistics queries, how many vertices, primitives and shader invocations the
+    GPU processed.
+
+    Every time in a GpuProfilerFrame is in milliseconds, measured from the moment beginFrame() was called on the CPU.
+    GPU timestamps are converted to the CPU's clock (GpuProfiler::Clock) using an offset measured when the
+    profiler is initialized, so CPU and GPU scopes can be drawn on a single timeline, and cpuStart can be used to
+    line a frame up with timing data from elsewhere in the program.
+
+    The context the profiler was initialized with must be current whenever the profiler is used.
+*/
+#ifndef BS_GRAPHICS_GPUPROFILER_HPP
+#define BS_GRAPHICS_GPUPROFILER_HPP
+
+
+
+
+//Includes
+#include <chrono>                                //std::chrono::steady_clock
+#include <cstddef>                               //std::size_t
+#include <functional>                            //std::function
+#include <memory>                                //std::unique_ptr
+#include <vector>                                //std::vector
+
+#include <brimstone/types.hpp>                   //Brimstone::ustring, Brimstone::uint32, Brimstone::uint64, Brimstone::int64
+#include <brimstone/Graphics.hpp>                //Brimstone::Graphics, Brimstone::GraphicsStats
+#include <brimstone/graphics/DGraphicsImpl.hpp>  //Brimstone::Private::GpuProfilerImpl
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Counts reported by the GPU for the work of a frame.
+struct GpuPipelineStatistics {
+    uint64 verticesSubmitted;
+    uint64 primitivesSubmitted;
+    uint64 vertexShaderInvocations;
+    uint64 clippingInputPrimitives;
+    uint64 clippingOutputPrimitives;
+    uint64 fragmentShaderInvocations;
+};
+
+struct GpuProfilerScope {
+    const char* name;
+    uint32      depth;      //0 for scopes that aren't nested in another scope
+    double      cpuBegin;
+    double      cpuEnd;
+    double      gpuBegin;   //0 if timer queries aren't supported
+    double      gpuEnd;
+};
+
+struct GpuProfilerFrame {
+    uint64                          index;
+
+    //Time beginFrame() was called, in milliseconds since the epoch of GpuProfiler::Clock
+    double                          cpuStart;
+    double                          cpuMilliseconds;
+
+    //When the GPU started and finished the frame's work, relative to cpuStart
+    double                          gpuBegin;
+    double                          gpuEnd;
+    double                          gpuMilliseconds;
+
+    //Scopes in the order they were begun
+    std::vector< GpuProfilerScope > scopes;
+
+    GraphicsStats                   stats;
+    bool                            hasPipelineStatistics;
+    GpuPipelineStatistics           pipelineStatistics;
+};
+
+class GpuProfiler {
+public:
+    //The clock CPU times are measured with
+    using Clock    = std::chrono::steady_clock;
+
+    //Called with each frame as soon as its results are available
+    using Callback = std::function< void( const GpuProfilerFrame& frame ) >;
+
+    static constexpr std::size_t DEFAULT_FRAME_LATENCY = 3;
+public:
+    GpuProfiler();
+    GpuProfiler( const GpuProfiler& toCopy ) = delete;
+    GpuProfiler& operator =( const GpuProfiler& toCopy ) = delete;
+    ~GpuProfiler();
+
+    void                    init( Graphics& graphics, const std::size_t frameLatency = DEFAULT_FRAME_LATENCY );
+    void                    destroy();
+    void                    calibrate();
+
+    void                    beginFrame();
+    void                    endFrame();
+    void                    beginScope( const char* const name );
+    void                    endScope();
+    void                    update();
+
+    void                    setCallback( Callback callback );
+    const GpuProfilerFrame* getLatestFrame() const;
+    ustring                 getReport() const;
+
+    bool                    isTimerSupported() const;
+    bool                    isPipelineStatisticsSupported() const;
+    std::size_t             getFrameLatency() const;
+    uint64                  getDroppedFrameCount() const;
+private:
+    struct Frame;
+
+    void                    resolve( Frame& frame );
+    double                  toFrameTime( const Frame& frame, const uint64 gpuTime ) const;
+private:
+    Graphics*                                   m_graphics;
+    std::unique_ptr< Private::GpuProfilerImpl > m_impl;
+
+    //Frames waiting on results from the GPU, indexed by frame index modulo the frame latency
+    std::vector< Frame >                        m_frames;
+    Frame*                                      m_current;
+    uint64                                      m_frameIndex;
+
+    //Indices of the scopes that are still open in the current frame
+    std::vector< std::size_t >                  m_openScopes;
+
+    //Nanoseconds to add to a GPU timestamp to get a time on the CPU's clock
+    int64                                       m_gpuToCpu;
+
+    //Timestamps read from the GPU for the frame being resolved
+    std::vector< uint64 >                       m_timestamps;
+
+    bool                                        m_hasLatest;
+    GpuProfilerFrame                            m_latest;
+    Callback                                    m_callback;
+    uint64                                      m_droppedFrames;
+};
+
+//Begins a scope on a profiler when constructed, and ends it when destroyed.
+//If the scope can't be ended, the error is passed to uncaughtException().
+class GpuScope {
+public:
+    GpuScope( GpuProfiler& profiler, const char* const name );
+    GpuScope( const GpuScope& toCopy ) = delete;
+    GpuScope& operator =( const GpuScope& toCopy ) = delete;
+    ~GpuScope();
+private:
+    GpuProfiler& m_profiler;
+};
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_GPUPROFILER_HPP
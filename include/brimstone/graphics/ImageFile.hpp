@@ -0,0 +1,116 @@
+/*
+graphics/ImageFile.hpp
+----------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    ImageFile and the .bsi ("Brimstone image") format it reads are defined here.
+
+    A .bsi file holds a texture that's already been decoded into one of the formats in TextureFormat,
+    along with (optionally) its mipmap levels, so loading it doesn't involve decoding anything:
+    the file is mapped into memory, and each level is either used in place or decompressed with LZ4.
+
+    A file starts with a header, followed by a table with the offset and stored size of each level, followed by the levels.
+    Each level starts at a multiple of IMAGE_FILE_ALIGNMENT bytes from the start of the file, so uncompressed levels
+    in a mapped file can be handed straight to Texture::setLevel() (or copied into a StreamingBuffer) without being copied first.
+    Levels are stored in the same layout as TextureData: tightly packed rows, from top to bottom.
+
+    When a file is saved with ImageCompression::LZ4, each level is compressed separately,
+    and any level that LZ4 can't make smaller is stored uncompressed (see isLevelCompressed()).
+
+    All fields are little-endian.
+    Use the ImageConverter tool to convert PNGs to .bsi files offline.
+*/
+#ifndef BS_GRAPHICS_IMAGEFILE_HPP
+#define BS_GRAPHICS_IMAGEFILE_HPP
+
+
+
+
+//Includes
+#include <cstddef>                        //std::size_t
+#include <vector>                         //std::vector
+
+#include <brimstone/types.hpp>            //Brimstone::ustring, Brimstone::ubyte, Brimstone::int32, Brimstone::uint64
+#include <brimstone/graphics/Enums.hpp>   //Brimstone::TextureFormat
+#include <brimstone/util/MappedFile.hpp>  //Brimstone::MappedFile
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Forward declarations
+class TextureData;
+
+
+
+
+//Constants
+//Levels in .bsi files start at a multiple of this many bytes from the start of the file
+constexpr std::size_t IMAGE_FILE_ALIGNMENT = 256;
+
+
+
+
+//How the levels in a .bsi file are stored
+enum class ImageCompression {
+    NONE,  //Uncompressed
+    LZ4    //Compressed with LZ4, unless that doesn't make them smaller
+};
+
+class ImageFile {
+public:
+    static bool save( const ustring& filename, const TextureData& data, const ImageCompression compression = ImageCompression::NONE );
+public:
+    ImageFile();
+    ImageFile( const ImageFile& toCopy ) = delete;
+    ImageFile& operator =( const ImageFile& toCopy ) = delete;
+
+    bool             open( const ustring& filename );
+    bool             open( const void* const data, const std::size_t size );
+    void             close();
+
+    bool             isOpen() const;
+    TextureFormat    getFormat() const;
+    int32            getWidth() const;
+    int32            getHeight() const;
+    std::size_t      getLevelCount() const;
+    ImageCompression getCompression() const;
+
+    bool             isLevelCompressed( const std::size_t level ) const;
+    const ubyte*     getLevel( const std::size_t level ) const;
+    std::size_t      getStoredLevelSize( const std::size_t level ) const;
+    std::size_t      getLevelSize( const std::size_t level ) const;
+    bool             decodeLevel( const std::size_t level, void* const destination ) const;
+private:
+    struct Level {
+        uint64 offset;
+        uint64 size;
+    };
+private:
+    bool                 parse();
+private:
+    MappedFile           m_file;
+    const ubyte*         m_data;
+    std::size_t          m_size;
+
+    TextureFormat        m_format;
+    int32                m_width;
+    int32                m_height;
+    ImageCompression     m_compression;
+    std::vector< Level > m_levels;
+};
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_IMAGEFILE_HPP
@@ -0,0 +1,109 @@
+/*
+graphics/ProgramBatch.hpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    ProgramBatch is defined here.
+
+    A ProgramBatch builds many Programs at once. Building programs one at a time with Program::link() waits for
+    each shader to compile and each program to link before starting on the next one. A batch instead starts compiling
+    every shader and linking every program up front, and only checks on them afterwards. On drivers that support
+    GL_KHR_parallel_shader_compile, this lets the driver compile them on several threads at once, and poll() can check
+    which programs are done without waiting for them, so a loading screen can keep drawing while shaders compile.
+    Even without the extension, drivers can overlap some of the work, since nothing is waited on until every
+    program has been submitted.
+
+    Info logs are only retrieved for programs that fail to build. Failures don't stop the rest of the batch;
+    getProgram() throws the failed program's log when it's asked for.
+
+    If the batch is given a ProgramCache, programs are loaded from cached binaries where possible,
+    and the binaries of programs built from source are added to the cache.
+*/
+#ifndef BS_GRAPHICS_PROGRAMBATCH_HPP
+#define BS_GRAPHICS_PROGRAMBATCH_HPP
+
+
+
+
+//Includes
+#include <cstddef>                              //std::size_t
+#include <memory>                               //std::unique_ptr
+#include <vector>                               //std::vector
+
+#include <brimstone/types.hpp>                  //Brimstone::ustring
+#include <brimstone/Graphics.hpp>               //Brimstone::Graphics, Brimstone::Program
+#include <brimstone/Stopwatch.hpp>              //Brimstone::Stopwatch
+#include <brimstone/graphics/ProgramCache.hpp>  //Brimstone::ProgramCache, Brimstone::ProgramSource
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//A ProgramBatchState describes how far along a program in a ProgramBatch is.
+enum class ProgramBatchState {
+    PENDING,    //The program has been added, but submit() hasn't been called yet
+    BUILDING,   //The program's shaders are being compiled and it is being linked
+    READY,      //The program was built (or loaded from a cached binary) successfully
+    FAILED      //A shader failed to compile, or the program failed to link
+};
+
+class ProgramBatch {
+public:
+    using Handle = std::size_t;
+public:
+    ProgramBatch();
+    ProgramBatch( const ProgramBatch& toCopy ) = delete;
+    ProgramBatch& operator =( const ProgramBatch& toCopy ) = delete;
+    ~ProgramBatch();
+
+    void                init( Graphics& graphics, ProgramCache* cache = nullptr );
+    void                clear();
+
+    Handle              add( const ProgramSource& source );
+    void                submit();
+    bool                poll();
+    void                finish();
+
+    ProgramBatchState   getState( const Handle handle ) const;
+    Program&            getProgram( const Handle handle );
+    const ustring&      getError( const Handle handle ) const;
+
+    std::size_t         getCount() const;
+    std::size_t         getPendingCount() const;
+    std::size_t         getFailedCount() const;
+    double              getElapsedMilliseconds() const;
+private:
+    struct Entry;
+
+    void                start( Entry& entry );
+    void                complete( Entry& entry );
+private:
+    Graphics*                                m_graphics;
+    ProgramCache*                            m_cache;
+
+    std::vector< std::unique_ptr< Entry > >  m_entries;
+
+    //Index of the first entry that hasn't been submitted yet
+    std::size_t                              m_submitted;
+    std::size_t                              m_pending;
+    std::size_t                              m_failed;
+
+    //Measures the time from submitting programs to the last of them being completed
+    Stopwatch                                m_timer;
+    double                                   m_elapsedMilliseconds;
+};
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_PROGRAMBATCH_HPP
@@ -0,0 +1,94 @@
+/*
+graphics/ProgramCache.hpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    ProgramSource and ProgramCache are defined here.
+
+    A ProgramCache builds Programs from source, and saves the driver's binary of each program it builds to a directory.
+    The next time the same program is requested, the binary is loaded instead, skipping compilation and linking entirely;
+    with a large number of shaders this can take seconds off of startup.
+
+    Binaries are stored under a key computed from everything that affects them: the shaders' sources, the defines and
+    attribute bindings they're built with, and the name and driver version of the GPU. Drivers may still reject a binary
+    (e.g. an update that didn't change the version string); in that case the program is built from source and its binary is replaced.
+*/
+#ifndef BS_GRAPHICS_PROGRAMCACHE_HPP
+#define BS_GRAPHICS_PROGRAMCACHE_HPP
+
+
+
+
+//Includes
+#include <cstddef>                 //std::size_t
+#include <utility>                 //std::pair
+#include <vector>                  //std::vector
+
+#include <brimstone/types.hpp>     //Brimstone::ustring, Brimstone::uint, Brimstone::uint64
+#include <brimstone/Graphics.hpp>  //Brimstone::Graphics, Brimstone::Program
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Everything needed to build a Program from source
+struct ProgramSource {
+    ustring                                  vertex;
+    ustring                                  geometry;    //Optional; no geometry shader is used if this is empty
+    ustring                                  fragment;
+
+    //Each define is either "NAME" or "NAME VALUE", and is inserted into every shader after its #version line
+    std::vector< ustring >                   defines;
+
+    //Vertex shader inputs and the attribute indices they're bound to
+    std::vector< std::pair< ustring, uint > > attributes;
+};
+
+struct ProgramCacheStats {
+    std::size_t hits;                 //Programs loaded from a cached binary
+    std::size_t misses;               //Programs built from source
+    std::size_t rejected;             //Cached binaries the driver rejected (these are also counted as misses)
+    double      compileMilliseconds;  //Time spent building programs from source
+    double      loadMilliseconds;     //Time spent loading cached binaries, including rejected ones
+};
+
+class ProgramCache {
+friend class ProgramBatch;
+public:
+    ProgramCache();
+
+    void                        init( Graphics& graphics, const ustring& directory );
+
+    Program                     load( const ProgramSource& source );
+
+    const ProgramCacheStats&    getStats() const;
+    void                        resetStats();
+
+    static ustring              applyDefines( const ustring& source, const std::vector< ustring >& defines );
+    static uint64               computeKey( const ProgramSource& source, const ustring& deviceName, const ustring& driverVersion );
+private:
+    Program                     build( const ProgramSource& source, const bool retrievable );
+    bool                        loadBinary( const uint64 key, Program& programOut );
+    void                        saveBinary( const uint64 key, const Program& program );
+    ustring                     getPath( const uint64 key ) const;
+private:
+    Graphics*                   m_graphics;
+    ustring                     m_directory;
+    bool                        m_binarySupported;
+    ProgramCacheStats           m_stats;
+};
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_PROGRAMCACHE_HPP
@@ -0,0 +1,119 @@
+/*
+graphics/RenderTarget.hpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    RenderTarget is defined here.
+
+    A RenderTarget is a texture that a scene can be rendered into instead of the window, optionally with multisampling,
+    and then drawn to the window (or another framebuffer) with present().
+
+    A RenderTarget can render at a fraction of its size and upscale when it's presented, which makes the scene
+    cheaper to render at the cost of sharpness. The fraction (the scale) can be set directly, or adjusted
+    automatically to hold a target frame time: call update() once per frame with the measured frame time
+    (e.g. GpuProfilerFrame::gpuMilliseconds), and the scale drops quickly when frames take too long and
+    creeps back up when there's time to spare.
+
+    Changing the scale doesn't reallocate anything. The target's storage is always allocated at its full size,
+    and the scene is rendered into the lower-left getRenderWidth() x getRenderHeight() pixels of it
+    (so a shader sampling getTexture() should scale its texture coordinates by getRenderWidth() / getWidth()
+    and getRenderHeight() / getHeight()).
+*/
+#ifndef BS_GRAPHICS_RENDERTARGET_HPP
+#define BS_GRAPHICS_RENDERTARGET_HPP
+
+
+
+
+//Includes
+#include <cstddef>                       //std::size_t
+
+#include <brimstone/Graphics.hpp>        //Brimstone::Graphics, Brimstone::Texture, Brimstone::Framebuffer
+#include <brimstone/graphics/Enums.hpp>  //Brimstone::TextureFormat
+
+
+
+
+namespace Brimstone {
+
+
+
+
+class RenderTarget {
+public:
+    static constexpr float DEFAULT_MIN_SCALE = 0.5f;
+    static constexpr float DEFAULT_MAX_SCALE = 1.0f;
+public:
+    RenderTarget();
+    RenderTarget( const RenderTarget& toCopy ) = delete;
+    RenderTarget& operator =( const RenderTarget& toCopy ) = delete;
+    ~RenderTarget();
+
+    void            init( Graphics& graphics, const std::size_t width, const std::size_t height,
+                          const TextureFormat format = TextureFormat::RGBA8, const std::size_t samples = 0 );
+    void            destroy();
+    void            resize( const std::size_t width, const std::size_t height );
+
+    void            begin();
+    void            end();
+    void            present();
+    void            present( const int x, const int y, const int width, const int height );
+    void            present( Framebuffer& target );
+
+    void            setScale( const float scale );
+    float           getScale() const;
+    void            setScaleRange( const float minScale, const float maxScale );
+    float           getMinScale() const;
+    float           getMaxScale() const;
+    void            setTargetFrameTime( const double milliseconds );
+    double          getTargetFrameTime() const;
+    void            update( const double frameMilliseconds );
+
+    Texture&        getTexture();
+    Framebuffer&    getFramebuffer();
+    std::size_t     getWidth() const;
+    std::size_t     getHeight() const;
+    std::size_t     getRenderWidth() const;
+    std::size_t     getRenderHeight() const;
+    std::size_t     getSamples() const;
+private:
+    void            create();
+private:
+    Graphics*       m_graphics;
+
+    //The texture that's presented, and a framebuffer to render into it.
+    //If the target is multisampled, the scene is rendered into m_multisample instead, then resolved into the texture by end().
+    Texture         m_color;
+    Framebuffer     m_framebuffer;
+    Framebuffer     m_multisample;
+
+    std::size_t     m_width;
+    std::size_t     m_height;
+    TextureFormat   m_format;
+    std::size_t     m_samples;
+
+    float           m_scale;
+    float           m_minScale;
+    float           m_maxScale;
+
+    //The frame time to hold, or 0 if the scale isn't adjusted automatically
+    double          m_targetFrameTime;
+
+    //Smoothed frame time measured at the current scale, and how many frames it's been measured over
+    double          m_averageFrameTime;
+    std::size_t     m_framesMeasured;
+
+    //The viewport that was set when begin() was called
+    int             m_viewport[4];
+};
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_RENDERTARGET_HPP
@@ -0,0 +1,350 @@
+/*
+graphics/SlotPool.hpp
+---------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    SlotPool and Handle are defined here.
+
+    The objects that implement graphics resources (GLTexture, GLVertexBuffer, etc) are stored in SlotPools rather than
+    allocated individually, and the classes in Graphics.hpp refer to them with Handles.
+
+    A SlotPool stores objects of one type in chunks of CHUNK_SIZE slots. Free slots are kept on a list, so creating or
+    destroying an object takes constant time and only allocates memory when every slot in every chunk is in use.
+    Chunks are never moved or freed while the pool exists, so an object's address doesn't change for as long as it lives.
+
+    A Handle is an object's slot index plus the generation of the slot when the object was created.
+    Every time a slot is reused its generation changes, so a Handle to an object that has since been destroyed
+    (e.g. a texture recorded into a CommandBuffer that was destroyed before the buffer was executed) is detected
+    when it's used, rather than silently referring to whatever object was created in its place.
+
+    Each type of object has a single pool, shared by every Graphics, which is returned by SlotPool::getInstance().
+    Like the graphics resources they hold, objects should only be created and destroyed on the thread the context is current on.
+*/
+#ifndef BS_GRAPHICS_SLOTPOOL_HPP
+#define BS_GRAPHICS_SLOTPOOL_HPP
+
+
+
+
+//Includes
+#include <cstddef>                  //std::size_t, std::nullptr_t
+#include <memory>                   //std::unique_ptr
+#include <new>                      //std::launder
+#include <utility>                  //std::forward
+
+#include <brimstone/types.hpp>      //Brimstone::uint32
+#include <brimstone/Exception.hpp>  //Brimstone::GraphicsException
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+template< typename T >
+class Handle {
+public:
+    constexpr Handle();
+    constexpr Handle( std::nullptr_t );
+    constexpr Handle( const uint32 index, const uint32 generation );
+
+    T*               get() const;
+    T*               operator ->() const;
+    T&               operator *() const;
+
+    constexpr bool   operator ==( const Handle& other ) const = default;
+    constexpr bool   operator ==( std::nullptr_t ) const;
+
+    constexpr uint32 getIndex() const;
+    constexpr uint32 getGeneration() const;
+private:
+    uint32 m_index;
+
+    //Odd for handles to objects, and 0 for null handles
+    uint32 m_generation;
+};
+
+template< typename T >
+class SlotPool {
+public:
+    static constexpr std::size_t CHUNK_SIZE = 256;
+    static constexpr std::size_t MAX_CHUNKS = 4096;
+public:
+    static SlotPool& getInstance();
+public:
+    SlotPool();
+    SlotPool( const SlotPool& toCopy ) = delete;
+    SlotPool& operator =( const SlotPool& toCopy ) = delete;
+    ~SlotPool();
+
+    template< typename... Args >
+    Handle< T >      create( Args&&... args );
+    void             destroy( const Handle< T > handle );
+
+    T*               get( const Handle< T > handle ) const;
+    bool             isValid( const Handle< T > handle ) const;
+
+    std::size_t      getCount() const;
+    std::size_t      getCapacity() const;
+private:
+    struct Slot {
+        alignas( T ) unsigned char storage[ sizeof( T ) ];
+
+        //Odd while the slot holds an object, even while it's free
+        uint32 generation;
+
+        //Index of the next free slot, if this slot is free
+        uint32 nextFree;
+    };
+
+    static constexpr uint32 NO_SLOT = 0xFFFFFFFF;
+
+    Slot*            getSlot( const uint32 index ) const;
+    T*               getObject( Slot& slot ) const;
+    void             grow();
+private:
+    //A fixed table of chunks, so looking up a slot never races with the table growing
+    std::unique_ptr< Slot[] > m_chunks[ MAX_CHUNKS ];
+    std::size_t               m_chunkCount;
+    uint32                    m_freeHead;
+    std::size_t               m_count;
+};
+
+//Destroys the object the given handle refers to (if any) and returns its slot to its pool
+template< typename T >
+void release( const Handle< T > handle );
+
+
+
+
+template< typename T >
+constexpr Handle< T >::Handle() :
+    m_index( 0 ),
+    m_generation( 0 ) {
+}
+
+template< typename T >
+constexpr Handle< T >::Handle( std::nullptr_t ) :
+    m_index( 0 ),
+    m_generation( 0 ) {
+}
+
+template< typename T >
+constexpr Handle< T >::Handle( const uint32 index, const uint32 generation ) :
+    m_index( index ),
+    m_generation( generation ) {
+}
+
+/*
+Handle::get
+-----------
+
+Description:
+    Returns the object this handle refers to.
+
+Arguments:
+    N/A
+
+Returns:
+    T*:                 The object, or nullptr if this is a null handle.
+
+Throws:
+    GraphicsException:  If the object this handle referred to has been destroyed.
+*/
+template< typename T >
+T* Handle< T >::get() const {
+    if( m_generation == 0 )
+        return nullptr;
+    return SlotPool< T >::getInstance().get( *this );
+}
+
+template< typename T >
+T* Handle< T >::operator ->() const {
+    return get();
+}
+
+template< typename T >
+T& Handle< T >::operator *() const {
+    return *get();
+}
+
+template< typename T >
+constexpr bool Handle< T >::operator ==( std::nullptr_t ) const {
+    return m_generation == 0;
+}
+
+template< typename T >
+constexpr uint32 Handle< T >::getIndex() const {
+    return m_index;
+}
+
+template< typename T >
+constexpr uint32 Handle< T >::getGeneration() const {
+    return m_generation;
+}
+
+
+
+
+//The pool is deliberately never destroyed, so handles held by static objects stay safe to release during shutdown
+template< typename T >
+SlotPool< T >& SlotPool< T >::getInstance() {
+    static SlotPool* const pool = new SlotPool();
+    return *pool;
+}
+
+template< typename T >
+SlotPool< T >::SlotPool() :
+    m_chunkCount( 0 ),
+    m_freeHead( NO_SLOT ),
+    m_count( 0 ) {
+}
+
+template< typename T >
+SlotPool< T >::~SlotPool() {
+    for( std::size_t c = 0; c < m_chunkCount; ++c )
+        for( std::size_t i = 0; i < CHUNK_SIZE; ++i )
+            if( m_chunks[c][i].generation & 1 )
+                getObject( m_chunks[c][i] )->~T();
+}
+
+/*
+SlotPool::create
+----------------
+
+Description:
+    Constructs an object in a free slot, adding a chunk of slots to the pool if none are free.
+
+Arguments:
+    args:               The arguments to pass to the object's constructor.
+
+Returns:
+    Handle< T >:        A handle to the new object.
+
+Throws:
+    GraphicsException:  If the pool is full.
+    Anything the object's constructor throws; if it does, the slot is left free.
+*/
+template< typename T >
+template< typename... Args >
+Handle< T > SlotPool< T >::create( Args&&... args ) {
+    if( m_freeHead == NO_SLOT )
+        grow();
+
+    const uint32 index = m_freeHead;
+    Slot&        slot  = *getSlot( index );
+    new( slot.storage ) T( std::forward< Args >( args )... );
+
+    m_freeHead = slot.nextFree;
+    ++slot.generation;
+    ++m_count;
+    return Handle< T >( index, slot.generation );
+}
+
+/*
+SlotPool::destroy
+-----------------
+
+Description:
+    Destroys the object the given handle refers to and frees its slot.
+    Every handle to the object becomes stale. Null handles are ignored.
+
+Arguments:
+    handle:             A handle to the object to destroy.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the object has already been destroyed.
+*/
+template< typename T >
+void SlotPool< T >::destroy( const Handle< T > handle ) {
+    if( handle == nullptr )
+        return;
+    if( !isValid( handle ) )
+        throw GraphicsException( "A graphics resource was destroyed twice." );
+
+    Slot& slot = *getSlot( handle.getIndex() );
+    getObject( slot )->~T();
+
+    ++slot.generation;
+    slot.nextFree = m_freeHead;
+    m_freeHead    = handle.getIndex();
+    --m_count;
+}
+
+//Returns the object the given handle refers to, or throws a GraphicsException if it's been destroyed
+template< typename T >
+T* SlotPool< T >::get( const Handle< T > handle ) const {
+    if( !isValid( handle ) )
+        throw GraphicsException( "A graphics resource was used after it was destroyed." );
+    return getObject( *getSlot( handle.getIndex() ) );
+}
+
+//Returns true if the object the given handle refers to hasn't been destroyed
+template< typename T >
+bool SlotPool< T >::isValid( const Handle< T > handle ) const {
+    if( handle == nullptr || handle.getIndex() >= m_chunkCount * CHUNK_SIZE )
+        return false;
+    return getSlot( handle.getIndex() )->generation == handle.getGeneration();
+}
+
+//Returns the number of objects in the pool
+template< typename T >
+std::size_t SlotPool< T >::getCount() const {
+    return m_count;
+}
+
+//Returns the number of objects the pool can hold before it needs another chunk
+template< typename T >
+std::size_t SlotPool< T >::getCapacity() const {
+    return m_chunkCount * CHUNK_SIZE;
+}
+
+template< typename T >
+typename SlotPool< T >::Slot* SlotPool< T >::getSlot( const uint32 index ) const {
+    return &m_chunks[ index / CHUNK_SIZE ][ index % CHUNK_SIZE ];
+}
+
+template< typename T >
+T* SlotPool< T >::getObject( Slot& slot ) const {
+    return std::launder( reinterpret_cast< T* >( slot.storage ) );
+}
+
+//Adds a chunk of free slots to the pool
+template< typename T >
+void SlotPool< T >::grow() {
+    if( m_chunkCount == MAX_CHUNKS )
+        throw GraphicsException( "Too many graphics resources." );
+
+    Slot* const       chunk = new Slot[ CHUNK_SIZE ];
+    const std::size_t first = m_chunkCount * CHUNK_SIZE;
+    for( std::size_t i = 0; i < CHUNK_SIZE; ++i ) {
+        chunk[i].generation = 0;
+        chunk[i].nextFree   = ( i + 1 < CHUNK_SIZE ) ? (uint32)( first + i + 1 ) : m_freeHead;
+    }
+    m_chunks[ m_chunkCount++ ].reset( chunk );
+    m_freeHead = (uint32)first;
+}
+
+
+
+
+template< typename T >
+void release( const Handle< T > handle ) {
+    SlotPool< T >::getInstance().destroy( handle );
+}
+
+
+
+
+} //namespace Brimstone::Private
+
+
+
+
+#endif //BS_GRAPHICS_SLOTPOOL_HPP
@@ -0,0 +1,155 @@
+/*
+graphics/SpriteBatch.hpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    SpriteQueue and SpriteBatch are defined here.
+
+    A SpriteQueue collects textured quads (sprites), sorts them by layer, blend mode and texture,
+    and writes their vertices in that order, recording one SpriteRun for each stretch of sprites that can be drawn together.
+    It doesn't touch the graphics API, so it can be used (and measured) on its own.
+
+    A SpriteBatch drives a SpriteQueue with Graphics: on flush(), it writes the queued sprites into a StreamingBuffer
+    and issues one indexed draw call per SpriteRun. Sprites that share a texture and blend mode are drawn together,
+    so packing many images into a single texture (e.g. with TextureAtlas) lets them be drawn with a single draw call.
+
+    Coordinates are in pixels, with (0,0) at the top-left of the viewport.
+*/
+#ifndef BS_GRAPHICS_SPRITEBATCH_HPP
+#define BS_GRAPHICS_SPRITEBATCH_HPP
+
+
+
+
+//Includes
+#include <cstddef>                       //std::size_t
+#include <vector>                        //std::vector
+#include <unordered_map>                 //std::unordered_map
+
+#include <brimstone/types.hpp>           //Brimstone::uint16, Brimstone::uint32, Brimstone::uint64
+#include <brimstone/Bounds.hpp>          //Brimstone::Bounds2f
+#include <brimstone/Point.hpp>           //Brimstone::Point2f
+#include <brimstone/Graphics.hpp>        //Brimstone::Graphics, Brimstone::Texture, Brimstone::Program, etc.
+#include <brimstone/graphics/Enums.hpp>  //Brimstone::BlendMode
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//A SpriteSortMode determines the order sprites in a SpriteQueue are drawn in.
+enum class SpriteSortMode {
+    DEFERRED,  //Sprites are drawn in the order they were queued; only consecutive sprites with the same state are batched together
+    TEXTURE    //Sprites are grouped by blend mode and texture, reducing the number of draw calls
+};
+
+struct Sprite {
+    Texture*       texture;   //Texture to draw the sprite with
+    Bounds2f       dest;      //Rectangle covered by the sprite, in pixels
+    Bounds2f       uv;        //Rectangle of the texture to draw, in texture coordinates ([0,1])
+    uint32         color;     //Color the texture is multiplied by; RGBA, red in the least significant byte
+    float          rotation;  //Clockwise rotation about origin, in radians
+    Point2f        origin;    //Point the sprite rotates about, relative to dest's top-left corner
+    BlendMode      blend;     //How the sprite is blended with what's behind it
+    uint16         layer;     //Sprites on lower layers are always drawn before sprites on higher layers, regardless of sort mode
+};
+
+struct SpriteVertex {
+    float  x;
+    float  y;
+    uint16 u;      //Normalized
+    uint16 v;      //Normalized
+    uint32 color;  //RGBA, normalized
+};
+
+struct SpriteRun {
+    Texture*       texture;
+    BlendMode      blend;
+    std::size_t    first;  //Index of the first sprite in this run
+    std::size_t    count;  //Number of sprites in this run
+};
+
+class SpriteQueue {
+public:
+    //Limits imposed by the layout of sort keys
+    static constexpr std::size_t MAX_SPRITES  = 1 << 24;
+    static constexpr std::size_t MAX_TEXTURES = 1 << 16;
+public:
+    SpriteQueue();
+
+    void                                    setSortMode( const SpriteSortMode mode );
+    SpriteSortMode                          getSortMode() const;
+
+    void                                    reserve( const std::size_t count );
+    bool                                    add( const Sprite& sprite );
+    void                                    clear();
+
+    std::size_t                             getCount() const;
+    bool                                    empty() const;
+
+    void                                    write( SpriteVertex* const vertices, std::vector< SpriteRun >& runsOut );
+private:
+    SpriteSortMode                          m_sortMode;
+    std::vector< Sprite >                   m_sprites;
+    std::vector< uint64 >                   m_keys;
+
+    //Each distinct texture is assigned a number (in the order they were first queued) for use in sort keys
+    std::unordered_map< Texture*, uint64 >  m_textureIndices;
+    Texture*                                m_lastTexture;
+    uint64                                  m_lastTextureIndex;
+};
+
+class SpriteBatch {
+public:
+    //Largest number of sprites a single draw call can draw (limited by the range of 16-bit indices)
+    static constexpr std::size_t MAX_SPRITES_PER_DRAW = 16384;
+
+    static constexpr uint32      WHITE = 0xFFFFFFFF;
+public:
+    SpriteBatch();
+    SpriteBatch( const SpriteBatch& toCopy ) = delete;
+    SpriteBatch& operator =( const SpriteBatch& toCopy ) = delete;
+
+    void           init( Graphics& graphics, const std::size_t maxSpritesPerFrame = 65536 );
+    void           destroy();
+
+    void           setSortMode( const SpriteSortMode mode );
+    SpriteSortMode getSortMode() const;
+    void           setViewSize( const float width, const float height );
+
+    void           begin();
+    void           draw( const Sprite& sprite );
+    void           draw( Texture& texture, const Bounds2f& dest, const Bounds2f& uv, const uint32 color = WHITE, const BlendMode blend = BlendMode::TRANSPARENCY );
+    void           flush();
+    void           end();
+
+    std::size_t    getSpriteCount() const;
+    std::size_t    getDrawCallCount() const;
+private:
+    Graphics*                m_graphics;
+    Program                  m_program;
+    StreamingBuffer          m_vertices;
+    IndexBuffer              m_indices;
+    SpriteQueue              m_queue;
+    std::vector< SpriteRun > m_runs;
+    float                    m_viewWidth;
+    float                    m_viewHeight;
+
+    //Statistics for the current frame
+    std::size_t              m_spriteCount;
+    std::size_t              m_drawCallCount;
+};
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_SPRITEBATCH_HPP
@@ -0,0 +1,151 @@
+/*
+graphics/TextureAtlas.hpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    SkylinePacker, TextureAtlasBuilder and TextureAtlas are defined here.
+
+    An atlas is a single large texture that many small images are packed into.
+    Sprites drawn from the same atlas share a texture, so SpriteBatch can draw them with a single draw call
+    instead of binding a texture per image.
+
+    SkylinePacker decides where each image goes. It tracks the "skyline" formed by the top edges of the images packed so far
+    and places each new image as low as it will fit (bottom-left heuristic, with "bottom" being the top of the texture).
+    This is fast (linear in the number of skyline segments) and wastes little space when images are added in an arbitrary order,
+    which makes it suitable for packing at runtime.
+
+    TextureAtlasBuilder packs images into a CPU-side RGBA8 buffer and can save the result to a file;
+    it doesn't use the graphics API, so it can be used by offline tools.
+
+    TextureAtlas packs images into a Texture at runtime, uploading each image as it is added with Texture::setRegion.
+    It can be started from a file saved by TextureAtlasBuilder, and images can still be added to it afterwards.
+
+    Each image is surrounded by padding filled with copies of its edge pixels, so filtering doesn't bleed neighbouring images into it.
+*/
+#ifndef BS_GRAPHICS_TEXTUREATLAS_HPP
+#define BS_GRAPHICS_TEXTUREATLAS_HPP
+
+
+
+
+//Includes
+#include <cstddef>                 //std::size_t
+#include <vector>                  //std::vector
+#include <unordered_map>           //std::unordered_map
+
+#include <brimstone/types.hpp>     //Brimstone::ustring, Brimstone::ubyte, Brimstone::int32
+#include <brimstone/Bounds.hpp>    //Brimstone::Bounds2i, Brimstone::Bounds2f
+#include <brimstone/Point.hpp>     //Brimstone::Point2i
+#include <brimstone/Image.hpp>     //Brimstone::Image
+#include <brimstone/Graphics.hpp>  //Brimstone::Graphics, Brimstone::Texture
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//A region of an atlas that an image was packed into
+struct AtlasRegion {
+    Bounds2i pixels;  //Rectangle occupied by the image (excluding padding), in pixels
+    Bounds2f uv;      //The same rectangle, in texture coordinates ([0,1])
+};
+
+class SkylinePacker {
+public:
+    SkylinePacker();
+    SkylinePacker( const int32 width, const int32 height );
+
+    void        reset( const int32 width, const int32 height );
+    bool        insert( const int32 width, const int32 height, Point2i& positionOut );
+
+    int32       getWidth() const;
+    int32       getHeight() const;
+    std::size_t getUsedArea() const;
+    float       getOccupancy() const;
+private:
+    friend class TextureAtlasBuilder;
+
+    //A horizontal segment of the skyline; rows above y (closer to the top of the texture) between x and x + width are occupied
+    struct Segment {
+        int32 x;
+        int32 y;
+        int32 width;
+    };
+
+    bool        fit( const std::size_t index, const int32 width, const int32 height, int32& yOut ) const;
+private:
+    int32                  m_width;
+    int32                  m_height;
+    std::size_t            m_usedArea;
+    std::vector< Segment > m_skyline;
+};
+
+class TextureAtlasBuilder {
+public:
+    TextureAtlasBuilder();
+    TextureAtlasBuilder( const int32 width, const int32 height, const int32 padding = 1 );
+
+    void                    reset( const int32 width, const int32 height, const int32 padding = 1 );
+
+    const AtlasRegion*      add( const ustring& name, const Image& image );
+    const AtlasRegion*      add( const ustring& name, const ubyte* const pixels, const int32 width, const int32 height, const std::size_t stride = 0 );
+    const AtlasRegion*      find( const ustring& name ) const;
+
+    bool                    save( const ustring& filename ) const;
+    bool                    load( const ustring& filename );
+
+    int32                   getWidth() const;
+    int32                   getHeight() const;
+    int32                   getPadding() const;
+    const ubyte*            getPixels() const;
+    const SkylinePacker&    getPacker() const;
+    const std::unordered_map< ustring, AtlasRegion >& getRegions() const;
+private:
+    SkylinePacker                              m_packer;
+    int32                                      m_padding;
+    std::vector< ubyte >                       m_pixels;
+    std::unordered_map< ustring, AtlasRegion > m_regions;
+};
+
+class TextureAtlas {
+public:
+    TextureAtlas();
+    TextureAtlas( const TextureAtlas& toCopy ) = delete;
+    TextureAtlas& operator =( const TextureAtlas& toCopy ) = delete;
+
+    void                    init( Graphics& graphics, const int32 width, const int32 height, const int32 padding = 1 );
+    void                    init( Graphics& graphics, const TextureAtlasBuilder& builder );
+    bool                    load( Graphics& graphics, const ustring& filename );
+    void                    destroy();
+
+    const AtlasRegion*      add( const ustring& name, const Image& image );
+    const AtlasRegion*      add( const ustring& name, const ubyte* const pixels, const int32 width, const int32 height, const std::size_t stride = 0 );
+    const AtlasRegion*      find( const ustring& name ) const;
+
+    Texture&                getTexture();
+    const SkylinePacker&    getPacker() const;
+    std::size_t             getUploadCount() const;
+private:
+    Texture                                    m_texture;
+    SkylinePacker                              m_packer;
+    int32                                      m_padding;
+    std::unordered_map< ustring, AtlasRegion > m_regions;
+
+    //Scratch space for padded copies of images being uploaded
+    std::vector< ubyte >                       m_scratch;
+    std::size_t                                m_uploads;
+};
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_TEXTUREATLAS_HPP
@@ -0,0 +1,98 @@
+/*
+graphics/TextureData.hpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    TextureData and some helper functions for working with texture formats and mipmaps are defined here.
+
+    A TextureData holds the texels of a texture and (optionally) its mipmap levels in CPU memory,
+    in one of the formats a Texture can store (see TextureFormat), ready to be uploaded with Texture::set().
+
+    Uncompressed TextureData can generate its own mipmaps on the CPU with generateMipmaps();
+    this is slower than generating them on the GPU (Texture::generateMipmaps()),
+    but the results can be prepared ahead of time, sRGB textures are filtered in linear space,
+    and a higher quality filter than the GPU's box filter can be used (see util/Resample.hpp).
+    Block-compressed TextureData must be loaded from a file that already contains any mipmaps it needs (see loadKTX() and loadBSI()).
+*/
+#ifndef BS_GRAPHICS_TEXTUREDATA_HPP
+#define BS_GRAPHICS_TEXTUREDATA_HPP
+
+
+
+
+//Includes
+#include <cstddef>                       //std::size_t
+#include <vector>                        //std::vector
+
+#include <brimstone/types.hpp>           //Brimstone::ustring, Brimstone::ubyte, Brimstone::int32
+#include <brimstone/graphics/Enums.hpp>  //Brimstone::TextureFormat
+#include <brimstone/util/Resample.hpp>   //Brimstone::ResampleFilter, Brimstone::ThreadPool
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Forward declarations
+class Image;
+class ImageFile;
+
+
+
+
+class TextureData {
+public:
+    TextureData();
+
+    void            set( const TextureFormat format, const int32 width, const int32 height, const void* const data, const std::size_t stride = 0 );
+    void            set( const Image& image );
+    bool            loadKTX( const ustring& filename );
+    bool            loadKTX( const void* const data, const std::size_t size );
+    bool            loadBSI( const ustring& filename );
+    bool            loadBSI( const void* const data, const std::size_t size );
+    void            generateMipmaps( const std::size_t levels = 0 );
+    void            generateMipmaps( const ResampleFilter filter, const std::size_t levels = 0, ThreadPool* const pool = nullptr );
+    void            clear();
+
+    bool            isValid() const;
+    TextureFormat   getFormat() const;
+    int32           getWidth() const;
+    int32           getHeight() const;
+    std::size_t     getLevelCount() const;
+    const ubyte*    getLevel( const std::size_t level ) const;
+    std::size_t     getLevelSize( const std::size_t level ) const;
+private:
+    bool            decodeBSI( const ImageFile& file );
+private:
+    TextureFormat              m_format;
+    int32                      m_width;
+    int32                      m_height;
+    std::vector< ubyte >       m_data;
+
+    //Offset of each level in m_data, plus the size of m_data at the end
+    std::vector< std::size_t > m_offsets;
+};
+
+
+
+
+//Functions
+bool        isCompressed( const TextureFormat format );
+std::size_t getBytesPerTexel( const TextureFormat format );
+std::size_t getMipLevelCount( const int32 width, const int32 height );
+int32       getMipDimension( const int32 size, const std::size_t level );
+std::size_t getTextureDataSize( const TextureFormat format, const int32 width, const int32 height );
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_TEXTUREDATA_HPP
@@ -0,0 +1,125 @@
+/*
+graphics/TextureStreamer.hpp
+----------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    TextureStreamer is defined here.
+
+    A TextureStreamer loads textures without stalling the thread that renders.
+    Loading a texture happens in three stages:
+        1. The file is decoded into a TextureData on a ThreadPool worker (and, for PNGs, mipmaps are generated there too).
+        2. On the rendering thread, update() copies decoded texels into a StreamingBuffer, which is persistently mapped when supported.
+        3. The texture's levels are filled from the StreamingBuffer with glTexSubImage2D, which acts as an asynchronous PBO upload.
+    Stages 2 and 3 are limited to a fixed number of bytes per frame, so a large texture is spread across several frames
+    instead of causing a single long one.
+
+    load() returns a handle immediately. Until the texture is ready, getTexture() returns a placeholder texture.
+    Levels are uploaded from the smallest to the largest, and as soon as a level finishes the texture starts being drawn
+    with that level as its base; the texture sharpens as its larger levels arrive.
+*/
+#ifndef BS_GRAPHICS_TEXTURESTREAMER_HPP
+#define BS_GRAPHICS_TEXTURESTREAMER_HPP
+
+
+
+
+//Includes
+#include <cstddef>                             //std::size_t
+#include <deque>                               //std::deque
+#include <functional>                          //std::function
+#include <limits>                              //std::numeric_limits
+#include <memory>                              //std::unique_ptr, std::shared_ptr
+#include <vector>                              //std::vector
+
+#include <brimstone/types.hpp>                 //Brimstone::ustring
+#include <brimstone/Graphics.hpp>              //Brimstone::Graphics, Brimstone::Texture, Brimstone::StreamingBuffer
+#include <brimstone/graphics/TextureData.hpp>  //Brimstone::TextureData
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Forward declarations
+class ThreadPool;
+
+
+
+
+//A TextureStreamState describes how far along a texture loaded by a TextureStreamer is.
+enum class TextureStreamState {
+    DECODING,   //The texture is being decoded on a worker thread
+    UPLOADING,  //The texture has been decoded and some of its levels are still being uploaded
+    READY,      //Every level of the texture has been uploaded
+    FAILED      //The texture couldn't be decoded, or its format isn't supported
+};
+
+class TextureStreamer {
+public:
+    using Handle  = std::size_t;
+
+    //Decodes a texture on a worker thread; returns false if it failed
+    using Decoder = std::function< bool( TextureData& dataOut ) >;
+
+    static constexpr Handle      INVALID_HANDLE          = std::numeric_limits< Handle >::max();
+    static constexpr std::size_t DEFAULT_BYTES_PER_FRAME = 4 * 1024 * 1024;
+public:
+    TextureStreamer();
+    TextureStreamer( const TextureStreamer& toCopy ) = delete;
+    TextureStreamer& operator =( const TextureStreamer& toCopy ) = delete;
+    ~TextureStreamer();
+
+    void                init( Graphics& graphics, ThreadPool& pool, const std::size_t bytesPerFrame = DEFAULT_BYTES_PER_FRAME );
+    void                destroy();
+
+    Handle              load( const ustring& filename, const bool generateMipmaps = true );
+    Handle              load( Decoder decoder );
+    void                update();
+
+    void                setPlaceholder( const TextureData& data );
+    Texture&            getPlaceholder();
+
+    Texture&            getTexture( const Handle handle );
+    TextureStreamState  getState( const Handle handle ) const;
+    bool                isReady( const Handle handle ) const;
+
+    std::size_t         getPendingCount() const;
+    std::size_t         getBytesPerFrame() const;
+    std::size_t         getBytesUploaded() const;
+private:
+    struct Entry;
+    struct Results;
+
+    bool                upload( Entry& entry );
+private:
+    Graphics*                                m_graphics;
+    ThreadPool*                              m_pool;
+    StreamingBuffer                          m_buffer;
+    Texture                                  m_placeholder;
+    std::size_t                              m_bytesPerFrame;
+
+    std::vector< std::unique_ptr< Entry > >  m_entries;
+
+    //Handles of decoded textures waiting to be uploaded, in the order they were decoded
+    std::deque< Handle >                     m_uploads;
+
+    //Shared with worker threads, so tasks that are still running when the streamer is destroyed have somewhere to put their results
+    std::shared_ptr< Results >               m_results;
+
+    std::size_t                              m_pending;
+    std::size_t                              m_bytesUploaded;
+};
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_TEXTURESTREAMER_HPP
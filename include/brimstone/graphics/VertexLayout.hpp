@@ -0,0 +1,91 @@
+/*
+graphics/VertexLayout.hpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    VertexLayout and VertexAttribute are defined here.
+    A VertexLayout describes how the vertices stored in a VertexBuffer are laid out in memory:
+    which attributes each vertex has, what type and how many components each attribute has,
+    where each attribute is located within a vertex, and the distance between consecutive vertices (the stride).
+
+    Attributes can also be marked as per-instance by giving them a non-zero divisor.
+    These attributes advance once every "divisor" instances rather than once per vertex.
+
+    VertexLayouts are API-agnostic. The graphics implementation bakes them into
+    whatever the underlying API uses to describe vertex formats (e.g. a vertex array object in OpenGL).
+*/
+#ifndef BS_GRAPHICS_VERTEXLAYOUT_HPP
+#define BS_GRAPHICS_VERTEXLAYOUT_HPP
+
+
+
+
+//Includes
+#include <cstddef>                       //std::size_t
+
+#include <brimstone/types.hpp>           //Brimstone::uint
+#include <brimstone/graphics/Enums.hpp>  //Brimstone::VertexAttributeType
+
+
+
+
+namespace Brimstone {
+
+
+
+
+struct VertexAttribute {
+    uint                index;       //Shader attribute location this attribute is fed to
+    uint                count;       //Number of components (1, 2, 3, or 4)
+    VertexAttributeType type;        //Data type of each component
+    bool                normalized;  //If true, integer components are mapped to [0,1] (unsigned) or [-1,1] (signed) when read as floats
+    bool                integer;     //If true, integer components are read by the shader as integers rather than floats
+    std::size_t         offset;      //Distance, in bytes, between the start of a vertex and the start of this attribute
+    uint                divisor;     //0 if this attribute advances per-vertex, otherwise the number of instances between advances
+};
+
+class VertexLayout {
+public:
+    static constexpr std::size_t MAX_ATTRIBUTES = 16;
+public:
+    VertexLayout();
+
+    VertexLayout&          add( const uint index, const uint count, const VertexAttributeType type, const bool normalized = false );
+    VertexLayout&          add( const uint index, const uint count, const VertexAttributeType type, const bool normalized, const std::size_t offset );
+    VertexLayout&          addInteger( const uint index, const uint count, const VertexAttributeType type );
+    VertexLayout&          setStride( const std::size_t stride );
+    VertexLayout&          setDivisor( const uint divisor );
+    void                   clear();
+
+    std::size_t            getStride() const;
+    std::size_t            getAttributeCount() const;
+    const VertexAttribute& getAttribute( const std::size_t i ) const;
+    const VertexAttribute* begin() const;
+    const VertexAttribute* end() const;
+    bool                   empty() const;
+private:
+    VertexLayout&          addAttribute( const VertexAttribute& attribute );
+private:
+    VertexAttribute m_attributes[ MAX_ATTRIBUTES ];
+    std::size_t     m_count;
+    std::size_t     m_stride;
+    bool            m_explicitStride;
+    uint            m_divisor;
+};
+
+
+
+
+//Forward declarations
+std::size_t getVertexAttributeTypeSize( const VertexAttributeType type );
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_GRAPHICS_VERTEXLAYOUT_HPP
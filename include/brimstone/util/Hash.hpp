@@ -0,0 +1,93 @@
+/*
+util/Hash.hpp
+-------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Non-cryptographic hash functions are defined here.
+
+    hashFNV1a computes the 64-bit FNV-1a hash of a block of memory.
+    It is simple and fast enough for hashing file contents and cache keys,
+    and its results don't change between runs, so hashes can be stored in files.
+    Hashes of several pieces of data can be combined by passing the hash of one piece as the seed of the next.
+*/
+#ifndef BS_UTIL_HASH_HPP
+#define BS_UTIL_HASH_HPP
+
+
+
+
+//Includes
+#include <cstddef>              //std::size_t
+#include <brimstone/types.hpp>  //Brimstone::uint64, Brimstone::ubyte, Brimstone::ustring
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Constants
+constexpr uint64 FNV1A_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64 FNV1A_PRIME        = 1099511628211ull;
+
+
+
+
+/*
+hashFNV1a{3}
+------------
+
+Description:
+    Computes the 64-bit FNV-1a hash of size bytes of data.
+
+Arguments:
+    data:    The data to hash.
+    size:    The number of bytes to hash.
+    seed:    The hash to start from; the hash of any data hashed before this data, or FNV1A_OFFSET_BASIS.
+
+Returns:
+    uint64:  The hash.
+*/
+inline uint64 hashFNV1a( const void* const data, const std::size_t size, const uint64 seed = FNV1A_OFFSET_BASIS ) {
+    const ubyte* bytes = static_cast< const ubyte* >( data );
+
+    uint64 hash = seed;
+    for( std::size_t i = 0; i < size; ++i ) {
+        hash ^= bytes[i];
+        hash *= FNV1A_PRIME;
+    }
+    return hash;
+}
+
+/*
+hashFNV1a{2}
+------------
+
+Description:
+    Computes the 64-bit FNV-1a hash of a string's length followed by its characters.
+    Including the length means the hashes of ("ab", "c") and ("a", "bc") differ when they are combined.
+
+Arguments:
+    str:     The string to hash.
+    seed:    The hash to start from; the hash of any data hashed before this data, or FNV1A_OFFSET_BASIS.
+
+Returns:
+    uint64:  The hash.
+*/
+inline uint64 hashFNV1a( const ustring& str, const uint64 seed = FNV1A_OFFSET_BASIS ) {
+    const uint64 length = str.size();
+    return hashFNV1a( str.data(), str.size(), hashFNV1a( &length, sizeof( length ), seed ) );
+}
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_UTIL_HASH_HPP
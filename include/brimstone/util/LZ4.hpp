@@ -0,0 +1,44 @@
+/*
+util/LZ4.hpp
+------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Functions for compressing and decompressing data in the LZ4 block format are defined here.
+
+    LZ4 trades compression ratio for speed; decompressing is little more than a series of memory copies,
+    so data that's stored compressed can often be loaded faster than it could be read uncompressed.
+    Blocks produced by compressLZ4() can be decompressed by any LZ4 implementation and vice versa.
+
+    Blocks don't record their decompressed size, so it has to be stored alongside them.
+*/
+#ifndef BS_UTIL_LZ4_HPP
+#define BS_UTIL_LZ4_HPP
+
+
+
+
+//Includes
+#include <cstddef>  //std::size_t
+
+
+
+
+namespace Brimstone {
+
+
+
+
+std::size_t getLZ4CompressBound( const std::size_t size );
+std::size_t compressLZ4( const void* const source, const std::size_t sourceSize, void* const destination, const std::size_t destinationCapacity );
+bool        decompressLZ4( const void* const source, const std::size_t sourceSize, void* const destination, const std::size_t destinationSize );
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_UTIL_LZ4_HPP
@@ -0,0 +1,80 @@
+/*
+util/MappedFile.hpp
+-------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    MappedFile is defined here.
+
+    A MappedFile maps the contents of a file into memory for reading, so it can be read in place
+    without being copied into a buffer first. Pages of the file are read by the OS as they're touched.
+
+    The mapping is read-only; writing to it is undefined behavior.
+*/
+#ifndef BS_UTIL_MAPPEDFILE_HPP
+#define BS_UTIL_MAPPEDFILE_HPP
+
+
+
+
+//Includes
+#include <cstddef>              //std::size_t
+#include <memory>               //std::unique_ptr
+
+#include <brimstone/types.hpp>  //Brimstone::ustring, Brimstone::ubyte
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+#if defined( BS_BUILD_WINDOWS )
+using MappedFileImpl = class WindowsMappedFile;
+#elif defined( BS_BUILD_LINUX )
+using MappedFileImpl = class LinuxMappedFile;
+#endif
+
+
+
+
+} //namespace Brimstone::Private
+
+
+
+
+namespace Brimstone {
+
+
+
+
+class MappedFile {
+public:
+    MappedFile();
+    MappedFile( const MappedFile& toCopy ) = delete;
+    MappedFile& operator =( const MappedFile& toCopy ) = delete;
+    MappedFile( MappedFile&& toMove );
+    MappedFile& operator =( MappedFile&& toMove );
+    ~MappedFile();
+
+    bool         open( const ustring& filename );
+    void         close();
+
+    bool         isOpen() const;
+    const ubyte* getData() const;
+    std::size_t  getSize() const;
+private:
+    std::unique_ptr< Private::MappedFileImpl > m_impl;
+};
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_UTIL_MAPPEDFILE_HPP
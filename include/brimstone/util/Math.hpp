@@ -13,7 +13,7 @@ Description:
 
 
 //Includes
-#include <brimstone/types.hpp>  //Brimstone::int32
+#include <brimstone/types.hpp>  //Brimstone::int32, Brimstone::uint16
 
 
 
@@ -38,6 +38,9 @@ uint32 closestUpperPowerOfTwo( const uint32 i );
 float fastSqrt( const float value );
 float fastInvSqrt( float value );
 
+uint16 floatToHalf( const float value );
+float  halfToFloat( const uint16 value );
+
 
 
 
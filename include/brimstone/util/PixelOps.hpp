@@ -0,0 +1,65 @@
+/*
+util/PixelOps.hpp
+-----------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Functions that convert and post-process 8-bit pixels in place are defined here.
+
+    On x86 CPUs the functions are vectorized with SSSE3 or AVX2, whichever is the best the CPU supports;
+    the instruction set is picked when the functions are first used, so the engine doesn't need to be built for a specific CPU.
+    Other CPUs (and CPUs without SSSE3) fall back to scalar loops.
+    Every instruction set produces exactly the same results.
+
+    setSIMDLevel() can force a lower instruction set to be used, e.g. to compare them in benchmarks.
+*/
+#ifndef BS_UTIL_PIXELOPS_HPP
+#define BS_UTIL_PIXELOPS_HPP
+
+
+
+
+//Includes
+#include <cstddef>              //std::size_t
+
+#include <brimstone/types.hpp>  //Brimstone::ubyte
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//The instruction sets pixel operations can be vectorized with, from worst to best
+enum class SIMDLevel {
+    NONE,
+    SSSE3,
+    AVX2
+};
+
+
+
+
+//Forward declarations
+SIMDLevel getSupportedSIMDLevel();
+SIMDLevel getSIMDLevel();
+void      setSIMDLevel( const SIMDLevel level );
+
+void      convertRGBToRGBA( ubyte* const data, const std::size_t pixelCount );
+void      swapRedBlue( ubyte* const data, const std::size_t pixelCount );
+void      premultiplyAlpha( ubyte* const data, const std::size_t pixelCount );
+void      unpremultiplyAlpha( ubyte* const data, const std::size_t pixelCount );
+void      convertSRGBToLinear( ubyte* const data, const std::size_t pixelCount );
+void      flipRows( ubyte* const data, const std::size_t rowSize, const std::size_t rowCount, const std::size_t stride = 0 );
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_UTIL_PIXELOPS_HPP
@@ -0,0 +1,67 @@
+/*
+util/Resample.hpp
+-----------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Functions for resizing 8-bit images with a choice of filters are defined here.
+
+    Images are resampled separably: each row is filtered horizontally, then each column vertically.
+    Pixels are filtered as premultiplied floats, so transparent pixels don't bleed their color into their neighbors,
+    and sRGB images are filtered in linear space.
+    The filter loops are vectorized with SSSE3 or AVX2 (see util/PixelOps.hpp); every instruction set produces exactly the same results.
+
+    The destination is split into bands of rows, which can be resampled in parallel on a ThreadPool.
+    Each band only filters the source rows it needs, so its working set stays small.
+    Splitting the work never changes the result.
+*/
+#ifndef BS_UTIL_RESAMPLE_HPP
+#define BS_UTIL_RESAMPLE_HPP
+
+
+
+
+//Includes
+#include <cstddef>              //std::size_t
+
+#include <brimstone/types.hpp>  //Brimstone::ubyte, Brimstone::int32
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Forward declarations
+class ThreadPool;
+
+
+
+
+//The filters images can be resampled with, from fastest to best
+enum class ResampleFilter {
+    BOX,       //Averages the source pixels each destination pixel covers; nearest neighbor when enlarging
+    BILINEAR,  //Triangle (tent) filter
+    LANCZOS3,  //Windowed sinc with 3 lobes. Sharp, but can ring around hard edges.
+    KAISER     //Kaiser-windowed sinc (width 3, alpha 4). Slightly softer than Lanczos with less ringing; good for mipmaps.
+};
+
+
+
+
+//Forward declarations
+void resample( const ubyte* const source, const int32 sourceWidth, const int32 sourceHeight, const std::size_t sourceStride,
+               ubyte* const destination, const int32 destinationWidth, const int32 destinationHeight, const std::size_t destinationStride,
+               const std::size_t channels, const ResampleFilter filter, const bool srgb = false, ThreadPool* const pool = nullptr );
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_UTIL_RESAMPLE_HPP
@@ -0,0 +1,372 @@
+/*
+util/RingBuffer.hpp
+-------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Defines the RingBuffer class, a first-in, first-out queue stored in a single array.
+
+    The capacity is always a power of two, so positions wrap around with a mask instead of a division.
+    Nothing is allocated while the buffer has room, unlike std::queue, whose std::deque allocates a new chunk
+    every few hundred bytes; a buffer that's drained regularly never allocates after it's created.
+
+    What happens when a value is pushed onto a full buffer is chosen with a RingBufferOverflow policy:
+    the buffer can grow, or keep its capacity and drop either the oldest value or the new one.
+    Dropped values are counted (see getDroppedCount()).
+*/
+#ifndef BS_UTIL_RINGBUFFER_HPP
+#define BS_UTIL_RINGBUFFER_HPP
+
+
+
+
+//Includes
+#include <cstddef>                  //std::size_t
+#include <utility>                  //std::move
+#include <vector>                   //std::vector
+
+#include <brimstone/types.hpp>      //Brimstone::uint64
+#include <brimstone/Exception.hpp>  //Brimstone::NoSuchElementException, Brimstone::SizeException, Brimstone::NullPointerException
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//What a RingBuffer does when a value is pushed while it's full
+enum class RingBufferOverflow {
+    GROW,         //Doubles the capacity. Nothing is lost, but pushing allocates.
+    DROP_OLDEST,  //Drops the value at the front to make room, so the buffer holds the most recent values
+    DROP_NEWEST   //Drops the value being pushed, so the buffer holds the oldest values
+};
+
+template< typename T >
+class RingBuffer {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 256;
+public:
+    explicit RingBuffer( const std::size_t capacity = DEFAULT_CAPACITY, const RingBufferOverflow overflow = RingBufferOverflow::GROW );
+
+    bool               push( const T& value );
+    bool               pop( T& valueOut );
+    std::size_t        pop( T* const valuesOut, const std::size_t max );
+    T&                 front();
+    const T&           front() const;
+    T&                 back();
+    const T&           back() const;
+    T&                 operator []( const std::size_t index );
+    const T&           operator []( const std::size_t index ) const;
+    void               clear();
+
+    void               setCapacity( const std::size_t capacity );
+    std::size_t        capacity() const;
+    void               setOverflow( const RingBufferOverflow overflow );
+    RingBufferOverflow getOverflow() const;
+
+    std::size_t        size() const;
+    bool               empty() const;
+    bool               full() const;
+
+    uint64             getDroppedCount() const;
+    void               resetDroppedCount();
+private:
+    static std::size_t roundCapacity( const std::size_t capacity );
+
+    void               reallocate( const std::size_t capacity );
+private:
+    std::vector< T >   m_values;
+    std::size_t        m_mask;
+
+    //Positions of the front of the buffer and one past its back. These only ever increase; they're masked to index m_values.
+    std::size_t        m_head;
+    std::size_t        m_tail;
+
+    RingBufferOverflow m_overflow;
+    uint64             m_dropped;
+};
+
+/*
+RingBuffer::RingBuffer
+----------------------
+
+Description:
+    Creates an empty buffer.
+
+Arguments:
+    capacity:           The number of values the buffer can hold before it overflows. Rounded up to a power of two.
+    overflow:           What to do when a value is pushed while the buffer is full.
+
+Throws:
+    SizeException:      If capacity is 0.
+*/
+template< typename T >
+RingBuffer< T >::RingBuffer( const std::size_t capacity, const RingBufferOverflow overflow ) :
+    m_values( roundCapacity( capacity ) ),
+    m_mask( m_values.size() - 1 ),
+    m_head( 0 ),
+    m_tail( 0 ),
+    m_overflow( overflow ),
+    m_dropped( 0 ) {
+}
+
+/*
+RingBuffer::push
+----------------
+
+Description:
+    Adds a value to the back of the buffer. If the buffer is full, the overflow policy decides what happens.
+
+Arguments:
+    value:  The value to add.
+
+Returns:
+    bool:   true if the value was added, false if it was dropped because the buffer is full and the policy is DROP_NEWEST.
+*/
+template< typename T >
+bool RingBuffer< T >::push( const T& value ) {
+    if( full() ) {
+        switch( m_overflow ) {
+        case RingBufferOverflow::GROW:
+            reallocate( m_values.size() * 2 );
+            break;
+        case RingBufferOverflow::DROP_OLDEST:
+            ++m_head;
+            ++m_dropped;
+            break;
+        case RingBufferOverflow::DROP_NEWEST:
+            ++m_dropped;
+            return false;
+        }
+    }
+
+    m_values[ m_tail & m_mask ] = value;
+    ++m_tail;
+    return true;
+}
+
+/*
+RingBuffer::pop{1}
+------------------
+
+Description:
+    Removes the value at the front of the buffer.
+
+Arguments:
+    valueOut:   The value is output here. If the buffer is empty, this is left unchanged.
+
+Returns:
+    bool:       true if a value was removed, false if the buffer is empty.
+*/
+template< typename T >
+bool RingBuffer< T >::pop( T& valueOut ) {
+    if( empty() )
+        return false;
+
+    valueOut = std::move( m_values[ m_head & m_mask ] );
+    ++m_head;
+    return true;
+}
+
+/*
+RingBuffer::pop{2}
+------------------
+
+Description:
+    Removes up to max values from the front of the buffer, in order.
+
+Arguments:
+    valuesOut:              The values are output here. Must have room for max values.
+    max:                    The most values to remove.
+
+Returns:
+    std::size_t:            The number of values removed.
+
+Throws:
+    NullPointerException:   If valuesOut is nullptr and max is greater than 0.
+*/
+template< typename T >
+std::size_t RingBuffer< T >::pop( T* const valuesOut, const std::size_t max ) {
+    if( valuesOut == nullptr && max > 0 )
+        throw NullPointerException();
+
+    const std::size_t count = size() < max ? size() : max;
+    for( std::size_t i = 0; i < count; ++i )
+        valuesOut[i] = std::move( m_values[ ( m_head + i ) & m_mask ] );
+    m_head += count;
+    return count;
+}
+
+//Returns the value at the front of the buffer. Throws a NoSuchElementException if the buffer is empty.
+template< typename T >
+T& RingBuffer< T >::front() {
+    if( empty() )
+        throw NoSuchElementException();
+    return m_values[ m_head & m_mask ];
+}
+
+//Returns the value at the front of the buffer. Throws a NoSuchElementException if the buffer is empty.
+template< typename T >
+const T& RingBuffer< T >::front() const {
+    if( empty() )
+        throw NoSuchElementException();
+    return m_values[ m_head & m_mask ];
+}
+
+//Returns the value at the back of the buffer (the one pushed most recently). Throws a NoSuchElementException if the buffer is empty.
+template< typename T >
+T& RingBuffer< T >::back() {
+    if( empty() )
+        throw NoSuchElementException();
+    return m_values[ ( m_tail - 1 ) & m_mask ];
+}
+
+//Returns the value at the back of the buffer (the one pushed most recently). Throws a NoSuchElementException if the buffer is empty.
+template< typename T >
+const T& RingBuffer< T >::back() const {
+    if( empty() )
+        throw NoSuchElementException();
+    return m_values[ ( m_tail - 1 ) & m_mask ];
+}
+
+//Returns the value index places from the front of the buffer. Throws a NoSuchElementException if index >= size().
+template< typename T >
+T& RingBuffer< T >::operator []( const std::size_t index ) {
+    if( index >= size() )
+        throw NoSuchElementException();
+    return m_values[ ( m_head + index ) & m_mask ];
+}
+
+//Returns the value index places from the front of the buffer. Throws a NoSuchElementException if index >= size().
+template< typename T >
+const T& RingBuffer< T >::operator []( const std::size_t index ) const {
+    if( index >= size() )
+        throw NoSuchElementException();
+    return m_values[ ( m_head + index ) & m_mask ];
+}
+
+//Removes every value from the buffer. Its capacity is kept.
+template< typename T >
+void RingBuffer< T >::clear() {
+    m_head = 0;
+    m_tail = 0;
+}
+
+/*
+RingBuffer::setCapacity
+-----------------------
+
+Description:
+    Changes the number of values the buffer can hold, keeping the values it has.
+    If it holds more than will fit, values are dropped according to the overflow policy;
+    with the GROW policy, the capacity is raised until they fit instead.
+
+Arguments:
+    capacity:       The new capacity. Rounded up to a power of two.
+
+Returns:
+    N/A
+
+Throws:
+    SizeException:  If capacity is 0.
+*/
+template< typename T >
+void RingBuffer< T >::setCapacity( const std::size_t capacity ) {
+    std::size_t rounded = roundCapacity( capacity );
+    if( size() > rounded ) {
+        switch( m_overflow ) {
+        case RingBufferOverflow::GROW:
+            rounded = roundCapacity( size() );
+            break;
+        case RingBufferOverflow::DROP_OLDEST:
+            m_dropped += size() - rounded;
+            m_head     = m_tail - rounded;
+            break;
+        case RingBufferOverflow::DROP_NEWEST:
+            m_dropped += size() - rounded;
+            m_tail     = m_head + rounded;
+            break;
+        }
+    }
+    if( rounded != m_values.size() )
+        reallocate( rounded );
+}
+
+template< typename T >
+std::size_t RingBuffer< T >::capacity() const {
+    return m_values.size();
+}
+
+template< typename T >
+void RingBuffer< T >::setOverflow( const RingBufferOverflow overflow ) {
+    m_overflow = overflow;
+}
+
+template< typename T >
+RingBufferOverflow RingBuffer< T >::getOverflow() const {
+    return m_overflow;
+}
+
+template< typename T >
+std::size_t RingBuffer< T >::size() const {
+    return m_tail - m_head;
+}
+
+template< typename T >
+bool RingBuffer< T >::empty() const {
+    return m_head == m_tail;
+}
+
+template< typename T >
+bool RingBuffer< T >::full() const {
+    return size() == m_values.size();
+}
+
+//Returns the number of values dropped because the buffer was full, since it was created or resetDroppedCount() was called
+template< typename T >
+uint64 RingBuffer< T >::getDroppedCount() const {
+    return m_dropped;
+}
+
+template< typename T >
+void RingBuffer< T >::resetDroppedCount() {
+    m_dropped = 0;
+}
+
+//Returns the smallest power of two greater than or equal to capacity. Throws a SizeException if capacity is 0.
+template< typename T >
+std::size_t RingBuffer< T >::roundCapacity( const std::size_t capacity ) {
+    if( capacity == 0 )
+        throw SizeException();
+
+    std::size_t rounded = 1;
+    while( rounded < capacity )
+        rounded *= 2;
+    return rounded;
+}
+
+//Moves the buffer's values to the front of a new array with the given capacity, which must be a power of two that they fit in
+template< typename T >
+void RingBuffer< T >::reallocate( const std::size_t capacity ) {
+    std::vector< T > values( capacity );
+    const std::size_t count = size();
+    for( std::size_t i = 0; i < count; ++i )
+        values[i] = std::move( m_values[ ( m_head + i ) & m_mask ] );
+
+    m_values = std::move( values );
+    m_mask   = capacity - 1;
+    m_head   = 0;
+    m_tail   = count;
+}
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_UTIL_RINGBUFFER_HPP
@@ -0,0 +1,107 @@
+/*
+util/ThreadPool.hpp
+-------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    ThreadPool is defined here.
+
+    A ThreadPool owns a fixed number of worker threads that run tasks from a shared FIFO queue.
+    Tasks can be posted (fire and forget) or submitted, in which case a std::future is returned
+    that receives the task's result (or the exception it threw). Posted tasks must not throw.
+
+    Tasks must not wait on the futures of other tasks in the same pool; if every worker is waiting,
+    nothing is left to run the tasks being waited on.
+*/
+#ifndef BS_UTIL_THREADPOOL_HPP
+#define BS_UTIL_THREADPOOL_HPP
+
+
+
+
+//Includes
+#include <cstddef>             //std::size_t
+#include <vector>              //std::vector
+#include <deque>               //std::deque
+#include <functional>          //std::function
+#include <future>              //std::future, std::packaged_task
+#include <memory>              //std::shared_ptr, std::make_shared
+#include <mutex>               //std::mutex, std::lock_guard
+#include <condition_variable>  //std::condition_variable
+#include <thread>              //std::thread
+#include <type_traits>         //std::invoke_result_t
+#include <utility>             //std::forward
+
+
+
+
+namespace Brimstone {
+
+
+
+
+class ThreadPool {
+public:
+    ThreadPool();
+    explicit ThreadPool( const std::size_t threadCount );
+    ThreadPool( const ThreadPool& toCopy ) = delete;
+    ThreadPool& operator =( const ThreadPool& toCopy ) = delete;
+    ~ThreadPool();
+
+    void                post( std::function< void() > task );
+
+    template< typename F >
+    auto                submit( F&& function ) -> std::future< std::invoke_result_t< F > >;
+
+    void                wait();
+
+    std::size_t         getThreadCount() const;
+    std::size_t         getPendingCount() const;
+
+    static std::size_t  getDefaultThreadCount();
+private:
+    void                run();
+private:
+    std::vector< std::thread >              m_threads;
+    std::deque< std::function< void() > >   m_tasks;
+
+    mutable std::mutex                      m_mutex;
+    std::condition_variable                 m_taskAvailable;
+    std::condition_variable                 m_idle;
+
+    //Number of tasks currently being run by workers
+    std::size_t                             m_active;
+    bool                                    m_stopping;
+};
+
+/*
+ThreadPool::submit
+------------------
+
+Description:
+    Queues a function to be called on one of the pool's threads.
+
+Arguments:
+    function:     A callable object taking no arguments.
+
+Returns:
+    std::future:  A future that receives the function's return value, or the exception it threw.
+*/
+template< typename F >
+auto ThreadPool::submit( F&& function ) -> std::future< std::invoke_result_t< F > > {
+    //std::function requires a copyable target, but std::packaged_task is move-only
+    auto task = std::make_shared< std::packaged_task< std::invoke_result_t< F >() > >( std::forward< F >( function ) );
+    auto future = task->get_future();
+    post( [task]() { (*task)(); } );
+    return future;
+}
+
+
+
+
+} //namespace Brimstone
+
+
+
+
+#endif //BS_UTIL_THREADPOOL_HPP
@@ -8,6 +8,14 @@ Description:
     WindowEvent records events sent to a Window by the operating system.
     This includes the type of event that occured (a WindowEventType),
     and data related to the event (e.g. the button / key pressed, mouse move location, etc)..
+
+    A fast mouse or a window being dragged can produce dozens of MouseMove, Move or Resize events between frames.
+    coalesceWindowEvent() merges such an event into one of the same type that's still queued,
+    so a frame processes one event for the whole motion, which keeps where it started, where it ended, and (for the mouse) how far it moved.
+
+    MouseRawMove and MouseSmoothScroll events come straight from the mouse rather than the cursor (see Window::setRawMouseInput()).
+    They report relative motion without pointer acceleration, even when the cursor can't move any further,
+    and scrolling in fractions of a wheel click, each stamped with the time the device reported it.
 */
 #ifndef BS_WINDOW_WINDOWEVENT_HPP
 #define BS_WINDOW_WINDOWEVENT_HPP
@@ -16,7 +24,8 @@ Description:
 
 
 //Includes
-#include <brimstone/types.hpp>              //Brimstone::int32, Brimstone::uchar
+#include <brimstone/types.hpp>              //Brimstone::int32, Brimstone::uchar, Brimstone::uint64
+#include <brimstone/util/RingBuffer.hpp>    //Brimstone::RingBuffer
 #include <brimstone/Point.hpp>              //Brimstone::Point2i
 #include <brimstone/input/Key.hpp>          //Brimstone::Key
 #include <brimstone/input/MouseButton.hpp>  //Brimstone::MouseButton
@@ -36,30 +45,32 @@ class Window;
 
 
 enum class WindowEventType {
-    MouseUp,        //msg.mouse
-    MouseDown,      //msg.mouse
-    MouseMove,      //msg.mouseMove
-    MouseVScroll,   //msg.mouseScroll
-    MouseHScroll,   //msg.mouseScroll
-    MouseEnter,     //msg.mouseMove
-    MouseLeave,     //msg.mouseMove
-    KeyDown,        //msg.key
-    KeyUp,          //msg.key
-    Text,           //msg.text
-    Focus,          //N/A
-    Blur,           //N/A
-    Move,           //msg.move
-    Resize,         //msg.resize
-    EnterFullscreen,//N/A
-    ExitFullscreen, //N/A
-    Maximize,       //N/A
-    Unmaximize,     //N/A
-    Minimize,       //N/A
-    Unminimize,     //N/A
-    Shade,          //N/A
-    Unshade,        //N/A
-    Restore,        //N/A
-    Close           //N/A
+    MouseUp,           //msg.mouse
+    MouseDown,         //msg.mouse
+    MouseMove,         //msg.mouseMove
+    MouseVScroll,      //msg.mouseScroll
+    MouseHScroll,      //msg.mouseScroll
+    MouseEnter,        //msg.mouseMove
+    MouseLeave,        //msg.mouseMove
+    MouseRawMove,      //msg.mouseRaw
+    MouseSmoothScroll, //msg.mouseSmoothScroll
+    KeyDown,           //msg.key
+    KeyUp,             //msg.key
+    Text,              //msg.text
+    Focus,             //N/A
+    Blur,              //N/A
+    Move,              //msg.move
+    Resize,            //msg.resize
+    EnterFullscreen,   //N/A
+    ExitFullscreen,    //N/A
+    Maximize,          //N/A
+    Unmaximize,        //N/A
+    Minimize,          //N/A
+    Unminimize,        //N/A
+    Shade,             //N/A
+    Unshade,           //N/A
+    Restore,           //N/A
+    Close              //N/A
 };
 
 struct WindowEventMouse {
@@ -75,6 +86,15 @@ struct WindowEventMouse {
 struct WindowEventMouseMove {
     int x;
     int y;
+
+    //If several moves were coalesced into this event (see Window::setEventCoalescing()), x and y are where the last one ended,
+    //firstX and firstY are where the first one ended, and dx and dy are the sum of their movements.
+    int firstX;
+    int firstY;
+    int dx;         //Movement since the cursor position before this event
+    int dy;
+    int count;      //Number of moves this event stands for; 1 unless it's been coalesced. MouseEnter / MouseLeave events have no movement.
+
     bool ctrl;
     bool alt;
     bool shift;
@@ -91,6 +111,16 @@ struct WindowEventMouseScroll {
     bool system;
 };
 
+//Relative motion (msg.mouseRaw) or scrolling (msg.mouseSmoothScroll) reported by the mouse itself (see Window::setRawMouseInput())
+struct WindowEventMouseRaw {
+    //For MouseRawMove, how far the mouse moved in device units (counts), without pointer acceleration. Positive is right / down.
+    //For MouseSmoothScroll, how far the wheel (or touchpad) scrolled, in wheel clicks. Positive is right / up, like MouseHScroll and MouseVScroll.
+    double dx;
+    double dy;
+    uint64 time;    //When the device reported it, in milliseconds. Only the differences between events' times are meaningful.
+    int    count;   //Number of reports this event stands for; 1 unless it's been coalesced, in which case dx and dy are their sums and time is the last one's.
+};
+
 struct WindowEventKey {
     Key key;
     bool ctrl;
@@ -108,11 +138,17 @@ struct WindowEventText {
 struct WindowEventMove {
     int x;
     int y;
+    int firstX;     //Where the window was after the first move coalesced into this event; the same as x and y if it hasn't been coalesced
+    int firstY;
+    int count;      //Number of moves this event stands for; 1 unless it's been coalesced
 };
 
 struct WindowEventResize {
     int w;
     int h;
+    int firstW;     //The window's size after the first resize coalesced into this event; the same as w and h if it hasn't been coalesced
+    int firstH;
+    int count;      //Number of resizes this event stands for; 1 unless it's been coalesced
 };
 
 struct WindowEvent {
@@ -121,6 +157,8 @@ struct WindowEvent {
         WindowEventMouse        mouse;
         WindowEventMouseMove    mouseMove;
         WindowEventMouseScroll  mouseScroll;
+        WindowEventMouseRaw     mouseRaw;
+        WindowEventMouseRaw     mouseSmoothScroll;
         WindowEventKey          key;
         WindowEventText         text;
         WindowEventMove         move;
@@ -131,6 +169,12 @@ struct WindowEvent {
 
 
 
+//Functions
+bool coalesceWindowEvent( RingBuffer< WindowEvent >& queue, const WindowEvent& event );
+
+
+
+
 } //namespace Brimstone
 
 
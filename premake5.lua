@@ -63,3 +63,23 @@ solution( "Brimstone" )
         --The output executable name and the library that UnitTests links to
         --is different depending on the architecture and whether or not this is the debug/release version
         doSuffixes()
+
+    project( "ImageConverter" )
+        kind( "ConsoleApp" )
+        language( "C++" )
+        files( {
+            "src/tools/**.cpp",
+            "src/tools/**.hpp"
+        } )
+
+        includedirs( "include" )
+        targetdir( "bin" )
+        libdirs( "lib" )
+
+        doFlags()
+        doBrimstoneDefines()
+        doBrimstoneLinks()
+
+        --The output executable name and the library that ImageConverter links to
+        --is different depending on the architecture and whether or not this is the debug/release version
+        doSuffixes()
@@ -79,8 +79,8 @@ end
 function doBrimstoneLinks()
     --[[
     Note: the order that we link here is important.
-    Brimstone links to LuaJIT and X11,
-    and LuaJIT links to dl.
+    Brimstone links to LuaJIT, Xi (XInput 2) and X11,
+    LuaJIT links to dl, and Xi links to X11.
     Dependent libraries need to come BEFORE the libraries they depend on.
     ]]--
 
@@ -101,14 +101,14 @@ function doBrimstoneLinks()
         links( { "luajit-5.1_x64", "gll_x86-64", "GL" } )
 
     --[[
-    All configurations link to dl and X11.
+    All configurations link to dl, Xi and X11.
     Whether we link to the 32-bit or 64-bit version is determined automatically
     based on the library directory that premake sets.
     Since I'm developing on a 64-bit OS, I needed to download the 32-bit versions of the library
     before it would allow me to build the 32-bit versions of the game.
     ]]--
     filter( {} )
-        links( { "dl", "X11", "png" } )
+        links( { "dl", "Xi", "X11", "png" } )
 end
 
 function doBrimstoneDefines()
@@ -0,0 +1,434 @@
+/*
+AssetCache.cpp
+--------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See AssetCache.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/AssetCache.hpp>            //Header
+#include <brimstone/graphics/TextureData.hpp>  //Brimstone::TextureData, Brimstone::isCompressed
+#include <brimstone/util/Hash.hpp>             //Brimstone::hashFNV1a
+
+#include <cstdio>                              //FILE, std::fopen, std::fread, std::fclose
+#include <cstring>                             //std::memcmp
+#include <memory>                              //std::make_unique
+#include <system_error>                        //std::error_code
+#include <vector>                              //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ustring;
+using ::Brimstone::ubyte;
+using ::Brimstone::uint64;
+
+
+
+
+//Constants
+constexpr ubyte PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+
+
+
+//Functions
+//Reads size bytes from the start of the file at the given path into contentsOut. Returns false if they couldn't be read.
+bool readFile( const ustring& filename, const uint64 size, std::vector< ubyte >& contentsOut ) {
+    FILE* file = std::fopen( filename.c_str(), "rb" );
+    if( file == nullptr )
+        return false;
+
+    contentsOut.resize( size );
+    const bool ok = std::fread( contentsOut.data(), 1, contentsOut.size(), file ) == contentsOut.size();
+    std::fclose( file );
+    return ok;
+}
+
+bool isPNG( const void* const data, const std::size_t size ) {
+    return size >= sizeof( PNG_SIGNATURE ) && std::memcmp( data, PNG_SIGNATURE, sizeof( PNG_SIGNATURE ) ) == 0;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+namespace Private {
+
+
+
+
+bool AssetKey::operator ==( const AssetKey& right ) const {
+    return hash == right.hash && size == right.size && kind == right.kind;
+}
+
+std::size_t AssetKeyHash::operator ()( const AssetKey& key ) const {
+    //The content hash is already well mixed; the kind only needs to separate an image from a texture of the same file
+    return (std::size_t)( key.hash ^ ( (uint64)key.kind * FNV1A_PRIME ) );
+}
+
+
+
+
+} //namespace Private
+
+
+
+
+AssetCache::AssetCache() :
+    m_graphics( nullptr ),
+    m_cpuBudget( UNLIMITED ),
+    m_gpuBudget( UNLIMITED ),
+    m_stats {} {
+}
+
+AssetCache::~AssetCache() {
+    destroy();
+}
+
+//Lets the cache load textures with the given graphics context, which must outlive the cache (or the next call to destroy())
+void AssetCache::init( Graphics& graphics ) {
+    m_graphics = &graphics;
+}
+
+//Frees every cached asset and forgets every path.
+//Assets that handles still refer to are detached from the cache instead; they stay valid, and are freed when their last handle lets go of them.
+//Detached textures are destroyed then, so the graphics context must outlive their handles.
+void AssetCache::destroy() {
+    for( std::unique_ptr< Private::AssetEntry >& entry : m_entries ) {
+        if( entry->refs > 0 ) {
+            entry->cache = nullptr;
+            entry.release();
+        }
+    }
+    m_index.clear();
+    m_paths.clear();
+    m_entries.clear();
+    m_stats.images   = 0;
+    m_stats.textures = 0;
+    m_stats.cpuBytes = 0;
+    m_stats.gpuBytes = 0;
+}
+
+/*
+AssetCache::loadImage{1}
+------------------------
+
+Description:
+    Loads the image in a PNG or .bsi file, or returns a handle to it if it's already cached.
+    The file is only read if it's new to the cache, or its size or modification time have changed since it was last read.
+
+Arguments:
+    filename:       The path to the file to load.
+
+Returns:
+    ImageHandle:    A handle to the image, or an empty handle if the file couldn't be read or decoded.
+*/
+ImageHandle AssetCache::loadImage( const ustring& filename ) {
+    return ImageHandle( load( filename, Private::AssetKind::IMAGE ) );
+}
+
+/*
+AssetCache::loadImage{2}
+------------------------
+
+Description:
+    Decodes a PNG or .bsi file in memory, or returns a handle to the image it contains if it's already cached.
+    The data is hashed every time; only the decode is skipped on a hit.
+
+Arguments:
+    data:           The contents of the file. Only needs to stay valid until this function returns.
+    size:           The size of the file, in bytes.
+
+Returns:
+    ImageHandle:    A handle to the image, or an empty handle if the data couldn't be decoded.
+*/
+ImageHandle AssetCache::loadImage( const void* const data, const std::size_t size ) {
+    return ImageHandle( load( data, size, Private::AssetKind::IMAGE ) );
+}
+
+/*
+AssetCache::loadTexture{1}
+--------------------------
+
+Description:
+    Loads the texture in a PNG, .bsi or KTX file and uploads it, or returns a handle to it if it's already cached.
+    The file is only read if it's new to the cache, or its size or modification time have changed since it was last read.
+
+Arguments:
+    filename:           The path to the file to load.
+    generateMipmaps:    If true, a complete mipmap chain is generated for uncompressed textures stored without one.
+                        A texture loaded with and without mipmaps is cached twice.
+
+Returns:
+    TextureHandle:      A handle to the texture, or an empty handle if the file couldn't be read or decoded.
+
+Throws:
+    GraphicsException:  If init() hasn't been called.
+*/
+TextureHandle AssetCache::loadTexture( const ustring& filename, const bool generateMipmaps ) {
+    if( m_graphics == nullptr )
+        throw GraphicsException( "AssetCache::init() must be called before textures can be loaded." );
+    return TextureHandle( load( filename, generateMipmaps ? Private::AssetKind::MIPMAPPED_TEXTURE : Private::AssetKind::TEXTURE ) );
+}
+
+/*
+AssetCache::loadTexture{2}
+--------------------------
+
+Description:
+    Decodes a PNG, .bsi or KTX file in memory and uploads it, or returns a handle to the texture it contains if it's already cached.
+    The data is hashed every time; only the decode and upload are skipped on a hit.
+
+Arguments:
+    data:               The contents of the file. Only needs to stay valid until this function returns.
+    size:               The size of the file, in bytes.
+    generateMipmaps:    If true, a complete mipmap chain is generated for uncompressed textures stored without one.
+
+Returns:
+    TextureHandle:      A handle to the texture, or an empty handle if the data couldn't be decoded.
+
+Throws:
+    GraphicsException:  If init() hasn't been called.
+*/
+TextureHandle AssetCache::loadTexture( const void* const data, const std::size_t size, const bool generateMipmaps ) {
+    if( m_graphics == nullptr )
+        throw GraphicsException( "AssetCache::init() must be called before textures can be loaded." );
+    return TextureHandle( load( data, size, generateMipmaps ? Private::AssetKind::MIPMAPPED_TEXTURE : Private::AssetKind::TEXTURE ) );
+}
+
+/*
+AssetCache::setBudget
+---------------------
+
+Description:
+    Sets the number of bytes of image pixels and texture data the cache tries to stay within,
+    and evicts assets that nothing refers to until it does (or until there are none left to evict).
+
+Arguments:
+    cpuBytes:   The budget for images, or UNLIMITED.
+    gpuBytes:   The budget for textures, or UNLIMITED.
+
+Returns:
+    N/A
+*/
+void AssetCache::setBudget( const uint64 cpuBytes, const uint64 gpuBytes ) {
+    m_cpuBudget = cpuBytes;
+    m_gpuBudget = gpuBytes;
+    evict( false );
+}
+
+uint64 AssetCache::getCPUBudget() const {
+    return m_cpuBudget;
+}
+
+uint64 AssetCache::getGPUBudget() const {
+    return m_gpuBudget;
+}
+
+//Evicts every asset that nothing refers to, regardless of the budgets
+void AssetCache::trim() {
+    evict( true );
+}
+
+//Returns the number of assets currently cached
+std::size_t AssetCache::getCount() const {
+    return m_entries.size();
+}
+
+const AssetCacheStats& AssetCache::getStats() const {
+    return m_stats;
+}
+
+//Resets the counts of hits, misses, failures and evictions. The counts and sizes of the assets currently cached aren't affected.
+void AssetCache::resetStats() {
+    m_stats.hits      = 0;
+    m_stats.misses    = 0;
+    m_stats.failures  = 0;
+    m_stats.evictions = 0;
+}
+
+//Returns the cached asset with the contents of the given file, loading it if necessary, or nullptr if it couldn't be loaded
+Private::AssetEntry* AssetCache::load( const ustring& filename, const Private::AssetKind kind ) {
+    std::error_code error;
+    const uint64 size = std::filesystem::file_size( filename, error );
+    const std::filesystem::file_time_type time = error ? std::filesystem::file_time_type() : std::filesystem::last_write_time( filename, error );
+    if( error ) {
+        ++m_stats.misses;
+        ++m_stats.failures;
+        return nullptr;
+    }
+
+    //If the file looks the same as it did the last time it was read, the asset with its old contents is the one it wants
+    auto path = m_paths.find( filename );
+    if( path != m_paths.end() && path->second.size == size && path->second.time == time ) {
+        Private::AssetEntry* const entry = find( Private::AssetKey { path->second.hash, size, kind } );
+        if( entry != nullptr )
+            return entry;
+    }
+
+    std::vector< ubyte > contents;
+    if( !readFile( filename, size, contents ) ) {
+        ++m_stats.misses;
+        ++m_stats.failures;
+        return nullptr;
+    }
+
+    const Private::AssetKey key { hashFNV1a( contents.data(), contents.size() ), size, kind };
+    m_paths[ filename ] = PathRecord { key.hash, size, time };
+
+    Private::AssetEntry* const entry = find( key );
+    return entry != nullptr ? entry : insert( key, contents.data(), contents.size() );
+}
+
+//Returns the cached asset with the given contents, decoding it if necessary, or nullptr if it couldn't be decoded
+Private::AssetEntry* AssetCache::load( const void* const data, const std::size_t size, const Private::AssetKind kind ) {
+    if( data == nullptr && size > 0 )
+        throw NullPointerException();
+
+    const Private::AssetKey key { hashFNV1a( data, size ), size, kind };
+    Private::AssetEntry* const entry = find( key );
+    return entry != nullptr ? entry : insert( key, data, size );
+}
+
+//Returns the cached asset with the given key, counting a hit and making it the most recently used, or nullptr if it isn't cached
+Private::AssetEntry* AssetCache::find( const Private::AssetKey& key ) {
+    auto it = m_index.find( key );
+    if( it == m_index.end() )
+        return nullptr;
+
+    m_entries.splice( m_entries.begin(), m_entries, it->second );
+    ++m_stats.hits;
+    return it->second->get();
+}
+
+//Decodes an asset that isn't cached yet and adds it to the cache, then evicts others if that put the cache over budget.
+//Returns nullptr if the asset couldn't be decoded.
+Private::AssetEntry* AssetCache::insert( const Private::AssetKey& key, const void* const data, const std::size_t size ) {
+    ++m_stats.misses;
+
+    m_entries.push_front( std::make_unique< Private::AssetEntry >() );
+    Private::AssetEntry& entry = *m_entries.front();
+    entry.cache    = this;
+    entry.key      = key;
+    entry.cpuBytes = 0;
+    entry.gpuBytes = 0;
+    entry.refs     = 0;
+    bool decoded;
+    try {
+        decoded = decode( data, size, entry );
+    } catch( ... ) {
+        m_entries.pop_front();
+        ++m_stats.failures;
+        throw;
+    }
+    if( !decoded ) {
+        m_entries.pop_front();
+        ++m_stats.failures;
+        return nullptr;
+    }
+    m_index.emplace( key, m_entries.begin() );
+
+    if( key.kind == Private::AssetKind::IMAGE )
+        ++m_stats.images;
+    else
+        ++m_stats.textures;
+    m_stats.cpuBytes += entry.cpuBytes;
+    m_stats.gpuBytes += entry.gpuBytes;
+
+    //The new asset doesn't have a handle yet, but it's about to; make sure it's not the one evicted
+    ++entry.refs;
+    evict( false );
+    --entry.refs;
+    return &entry;
+}
+
+//Decodes the given file into the entry's image or texture, and records how many bytes it takes up
+bool AssetCache::decode( const void* const data, const std::size_t size, Private::AssetEntry& entry ) {
+    if( entry.key.kind == Private::AssetKind::IMAGE ) {
+        if( !( isPNG( data, size ) ? entry.image.loadPNG( data, size ) : entry.image.load( data, size ) ) )
+            return false;
+        entry.cpuBytes = (uint64)entry.image.getStride() * entry.image.getSize().height;
+        return true;
+    }
+
+    TextureData textureData;
+    const bool  mipmaps = entry.key.kind == Private::AssetKind::MIPMAPPED_TEXTURE;
+    if( isPNG( data, size ) ) {
+        Image image;
+        if( !image.loadPNG( data, size ) )
+            return false;
+        textureData.set( image );
+    } else if( !textureData.loadKTX( data, size ) && !textureData.loadBSI( data, size ) ) {
+        return false;
+    }
+    if( mipmaps && textureData.getLevelCount() == 1 && !isCompressed( textureData.getFormat() ) )
+        textureData.generateMipmaps();
+
+    entry.texture = m_graphics->createTexture();
+    entry.texture.set( textureData );
+    for( std::size_t level = 0; level < textureData.getLevelCount(); ++level )
+        entry.gpuBytes += textureData.getLevelSize( level );
+    return true;
+}
+
+//Called when a handle lets go of an asset; if it was the last one, the asset becomes a candidate for eviction
+void AssetCache::release( Private::AssetEntry* const entry ) {
+    if( --entry->refs == 0 )
+        evict( false );
+}
+
+//Evicts assets that nothing refers to, least recently used first: all of them, or just enough to get back within the budgets.
+//An asset is only evicted for being over budget if it takes up some of the memory that's over budget.
+void AssetCache::evict( const bool all ) {
+    auto it = m_entries.end();
+    while( it != m_entries.begin() ) {
+        const bool overCPU = m_stats.cpuBytes > m_cpuBudget;
+        const bool overGPU = m_stats.gpuBytes > m_gpuBudget;
+        if( !all && !overCPU && !overGPU )
+            return;
+
+        --it;
+        const Private::AssetEntry& entry = **it;
+        if( entry.refs > 0 || !( all || ( overCPU && entry.cpuBytes > 0 ) || ( overGPU && entry.gpuBytes > 0 ) ) )
+            continue;
+
+        auto evicted = it++;
+        erase( evicted );
+        ++m_stats.evictions;
+    }
+}
+
+void AssetCache::erase( Entries::iterator it ) {
+    const Private::AssetEntry& entry = **it;
+    if( entry.key.kind == Private::AssetKind::IMAGE )
+        --m_stats.images;
+    else
+        --m_stats.textures;
+    m_stats.cpuBytes -= entry.cpuBytes;
+    m_stats.gpuBytes -= entry.gpuBytes;
+
+    m_index.erase( entry.key );
+    m_entries.erase( it );
+}
+
+
+
+
+} //namespace Brimstone
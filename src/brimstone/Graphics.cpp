@@ -15,6 +15,11 @@ Description:
 
 #include "graphics/GraphicsImpl.hpp"  //Brimstone::Private::GraphicsImpl, etc
 
+#include <brimstone/Image.hpp>        //Brimstone::Image
+#include <brimstone/Exception.hpp>    //Brimstone::BoundsException
+
+#include <memory>                     //std::unique_ptr
+
 
 
 
@@ -33,6 +38,28 @@ Graphics::~Graphics() {
         delete m_impl;
 }
 
+/*
+Graphics::init{1}
+-----------------
+
+Description:
+    Initializes the graphics without a window.
+    Nothing can be presented, so render into a Framebuffer instead.
+    On Linux this uses EGL, so it works without an X server.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If an offscreen context couldn't be created (e.g. libEGL isn't installed).
+*/
+void Graphics::init() {
+    m_impl->init();
+}
+
 void Graphics::init( const Brimstone::Window& window ) {
     m_impl->init( window );
 }
@@ -61,6 +88,19 @@ VertexBuffer Graphics::createVertexBuffer() {
     return VertexBuffer( m_impl->createVertexBuffer() );
 }
 
+IndexBuffer Graphics::createIndexBuffer() {
+    return IndexBuffer( m_impl->createIndexBuffer() );
+}
+
+StreamingBuffer Graphics::createStreamingBuffer( const std::size_t regionSize, const std::size_t regionCount ) {
+    return StreamingBuffer( m_impl->createStreamingBuffer( regionSize, regionCount ) );
+}
+
+//Creates a buffer that can hold capacity draw commands each frame; see GLDrawIndirectBuffer for details
+DrawIndirectBuffer Graphics::createDrawIndirectBuffer( const std::size_t capacity, const std::size_t regionCount ) {
+    return DrawIndirectBuffer( m_impl->createDrawIndirectBuffer( capacity, regionCount ) );
+}
+
 Texture Graphics::createTexture() {
     return Texture( m_impl->createTexture() );
 }
@@ -69,10 +109,134 @@ Sampler Graphics::createSampler() {
     return Sampler( m_impl->createSampler() );
 }
 
+Framebuffer Graphics::createFramebuffer() {
+    return Framebuffer( m_impl->createFramebuffer() );
+}
+
 void Graphics::flush() {
     m_impl->flush();
 }
 
+//Waits for every command issued so far to finish executing
+void Graphics::finish() {
+    m_impl->finish();
+}
+
+/*
+Graphics::blit
+--------------
+
+Description:
+    Copies a region of the given framebuffer's color attachment to a region of the window, scaling it if the regions' sizes differ.
+    This is how a scene rendered at a lower resolution is upscaled to the window.
+    Regions are given relative to the upper-left corner of the framebuffer and of the viewport, like the scissor box.
+
+Arguments:
+    source:             The framebuffer to copy from.
+    x:                  The left edge of the region to copy.
+    y:                  The top edge of the region to copy.
+    width:              The width of the region to copy.
+    height:             The height of the region to copy.
+    targetX:            The left edge of the region of the window to copy to.
+    targetY:            The top edge of the region of the window to copy to.
+    targetWidth:        The width of the region of the window to copy to.
+    targetHeight:       The height of the region of the window to copy to.
+    filter:             How pixels are sampled if the region is scaled.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the region couldn't be copied.
+*/
+void Graphics::blit( Framebuffer& source, const int x, const int y, const int width, const int height,
+                     const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter ) {
+    m_impl->blit( *source.m_impl, x, y, width, height, targetX, targetY, targetWidth, targetHeight, filter );
+}
+
+void Graphics::execute( const CommandBuffer& buffer ) {
+    const CommandBuffer* const buffers[] = { &buffer };
+    m_impl->execute( buffers, 1 );
+}
+
+/*
+Graphics::execute{2}
+--------------------
+
+Description:
+    Executes the commands recorded in the given command buffers.
+    The packets from every buffer are sorted by their keys and executed in that order;
+    packets with equal keys are executed in the order their buffers were given in.
+    This must be called from the thread the context is active on, and no buffer may be recorded into while this runs.
+
+Arguments:
+    buffers:            The command buffers to execute.
+    count:              The number of command buffers.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If a command failed.
+*/
+void Graphics::execute( const CommandBuffer* const* buffers, const std::size_t count ) {
+    m_impl->execute( buffers, count );
+}
+
+void Graphics::drawIndexed( VertexBuffer& vertices, IndexBuffer& indices ) {
+    m_impl->drawIndexed( *vertices.m_impl, *indices.m_impl );
+}
+
+void Graphics::drawIndexed( VertexBuffer& vertices, IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex ) {
+    m_impl->drawIndexed( *vertices.m_impl, *indices.m_impl, first, count, baseVertex );
+}
+
+void Graphics::draw( StreamingBuffer& vertices, const std::size_t first, const std::size_t count ) {
+    m_impl->draw( *vertices.m_impl, first, count );
+}
+
+void Graphics::drawIndexed( StreamingBuffer& vertices, IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex ) {
+    m_impl->drawIndexed( *vertices.m_impl, *indices.m_impl, first, count, baseVertex );
+}
+
+void Graphics::drawInstanced( VertexBuffer& vertices, const std::size_t instanceCount ) {
+    m_impl->drawInstanced( *vertices.m_impl, instanceCount );
+}
+
+void Graphics::drawIndexedInstanced( VertexBuffer& vertices, IndexBuffer& indices, const std::size_t instanceCount ) {
+    m_impl->drawIndexedInstanced( *vertices.m_impl, *indices.m_impl, instanceCount );
+}
+
+void Graphics::drawIndexedInstanced( VertexBuffer& vertices, IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex,
+                                     const std::size_t instanceCount, const uint baseInstance ) {
+    m_impl->drawIndexedInstanced( *vertices.m_impl, *indices.m_impl, first, count, baseVertex, instanceCount, baseInstance );
+}
+
+/*
+Graphics::multiDrawIndirect
+---------------------------
+
+Description:
+    Draws every command added to the given draw indirect buffer since its last batch was drawn, with a single call where supported.
+    Each command draws a range of the given index buffer, so many objects whose geometry shares a vertex and index buffer
+    can be drawn without the overhead of a draw call each.
+
+Arguments:
+    vertices:           The vertices to draw.
+    indices:            The indices of the vertices to draw.
+    commands:           The commands to draw.
+
+Returns:
+    N/A
+
+Throws:
+    BoundsException:    If BS_CHECK_INDEX is defined and one of the commands draws indices outside of the index buffer.
+    GraphicsException:  If indirect draws aren't supported.
+*/
+void Graphics::multiDrawIndirect( VertexBuffer& vertices, IndexBuffer& indices, DrawIndirectBuffer& commands ) {
+    m_impl->multiDrawIndirect( *vertices.m_impl, *indices.m_impl, *commands.m_impl );
+}
+
 void Graphics::enableBackFaceCulling() {
     m_impl->enableBackFaceCulling();
 }
@@ -185,6 +349,10 @@ void Graphics::setBlendModeToTransparency() {
     m_impl->setBlendModeToTransparency();
 }
 
+void Graphics::setBlendMode( const BlendMode mode ) {
+    m_impl->setBlendMode( mode );
+}
+
 void Graphics::setClearColor( const float r, const float g, const float b, const float a ) {
     m_impl->setClearColor( r, g, b, a );
 }
@@ -229,6 +397,34 @@ void Graphics::swapBuffers() {
     m_impl->swapBuffers();
 }
 
+GraphicsStats Graphics::getStats() const {
+    return m_impl->getStats();
+}
+
+bool Graphics::isTextureFormatSupported( const TextureFormat format ) const {
+    return m_impl->isTextureFormatSupported( format );
+}
+
+bool Graphics::isProgramBinarySupported() const {
+    return m_impl->isProgramBinarySupported();
+}
+
+bool Graphics::isParallelShaderCompileSupported() const {
+    return m_impl->isParallelShaderCompileSupported();
+}
+
+bool Graphics::isMultiDrawIndirectSupported() const {
+    return m_impl->isMultiDrawIndirectSupported();
+}
+
+ustring Graphics::getDeviceName() const {
+    return m_impl->getDeviceName();
+}
+
+ustring Graphics::getDriverVersion() const {
+    return m_impl->getDriverVersion();
+}
+
 
 
 
@@ -241,18 +437,18 @@ Shader::Shader( Shader&& toMove ) :
     toMove.m_impl = nullptr;
 }
 Shader& Shader::operator =( Shader&& toMove ) {
+    Private::release( m_impl );
     m_impl = toMove.m_impl;
     toMove.m_impl = nullptr;
     return *this;
 }
 
-Shader::Shader( Private::ShaderImpl* impl ) :
+Shader::Shader( const Private::Handle< Private::ShaderImpl > impl ) :
     m_impl( impl ) {
 }
 
 Shader::~Shader() {
-    if( m_impl != nullptr )
-        delete m_impl;
+    Private::release( m_impl );
 }
 
 void Shader::create() {
@@ -271,6 +467,18 @@ void Shader::compile() {
     m_impl->compile();
 }
 
+void Shader::beginCompile() {
+    m_impl->beginCompile();
+}
+
+bool Shader::isCompileComplete() const {
+    return m_impl->isCompileComplete();
+}
+
+void Shader::endCompile() {
+    m_impl->endCompile();
+}
+
 
 
 
@@ -283,18 +491,18 @@ Program::Program( Program&& toMove ) :
     toMove.m_impl = nullptr;
 }
 Program& Program::operator =( Program&& toMove ) {
+    Private::release( m_impl );
     m_impl = toMove.m_impl;
     toMove.m_impl = nullptr;
     return *this;
 }
 
-Program::Program( Private::ProgramImpl* impl ) :
+Program::Program( const Private::Handle< Private::ProgramImpl > impl ) :
     m_impl( impl ) {
 }
 
 Program::~Program() {
-    if( m_impl != nullptr )
-        delete m_impl;
+    Private::release( m_impl );
 }
 
 void Program::create() {
@@ -313,10 +521,38 @@ void Program::detachShader( const Shader& shader ) {
     m_impl->detachShader( *shader.m_impl );
 }
 
+void Program::bindAttribute( const char* const name, const uint index ) {
+    m_impl->bindAttribute( name, index );
+}
+
 void Program::link() {
     m_impl->link();
 }
 
+void Program::beginLink() {
+    m_impl->beginLink();
+}
+
+bool Program::isLinkComplete() const {
+    return m_impl->isLinkComplete();
+}
+
+void Program::endLink() {
+    m_impl->endLink();
+}
+
+void Program::setBinaryRetrievable( const bool retrievable ) {
+    m_impl->setBinaryRetrievable( retrievable );
+}
+
+bool Program::getBinary( std::vector< ubyte >& dataOut, uint32& formatOut ) const {
+    return m_impl->getBinary( dataOut, formatOut );
+}
+
+bool Program::setBinary( const uint32 format, const void* const data, const std::size_t size ) {
+    return m_impl->setBinary( format, data, size );
+}
+
 void Program::use() {
     m_impl->use();
 }
@@ -365,18 +601,18 @@ VertexBuffer::VertexBuffer( VertexBuffer&& toMove ) :
     toMove.m_impl = nullptr;
 }
 VertexBuffer& VertexBuffer::operator =( VertexBuffer&& toMove ) {
+    Private::release( m_impl );
     m_impl = toMove.m_impl;
     toMove.m_impl = nullptr;
     return *this;
 }
 
-VertexBuffer::VertexBuffer( Private::VertexBufferImpl* impl ) :
+VertexBuffer::VertexBuffer( const Private::Handle< Private::VertexBufferImpl > impl ) :
     m_impl( impl ) {
 }
 
 VertexBuffer::~VertexBuffer() {
-    if( m_impl != nullptr )
-        delete m_impl;
+    Private::release( m_impl );
 }
 
 void VertexBuffer::create() {
@@ -387,11 +623,11 @@ void VertexBuffer::destroy() {
     m_impl->destroy();
 }
 
-void VertexBuffer::set( const float* const data, const std::size_t sizeInBytes ) {
+void VertexBuffer::set( const void* const data, const std::size_t sizeInBytes ) {
     m_impl->set( data, sizeInBytes );
 }
 
-void VertexBuffer::set( const float* const data, const std::size_t offsetInBytes, const std::size_t sizeInBytes ) {
+void VertexBuffer::set( const void* const data, const std::size_t offsetInBytes, const std::size_t sizeInBytes ) {
     m_impl->set( data, offsetInBytes, sizeInBytes );
 }
 
@@ -407,6 +643,22 @@ void VertexBuffer::draw() {
     m_impl->draw();
 }
 
+void VertexBuffer::setLayout( const VertexLayout& layout ) {
+    m_impl->setLayout( layout );
+}
+
+const VertexLayout& VertexBuffer::getLayout() const {
+    return m_impl->getLayout();
+}
+
+void VertexBuffer::addInstanceStream( const VertexBuffer& stream, const VertexLayout& layout ) {
+    m_impl->addInstanceStream( *stream.m_impl, layout );
+}
+
+void VertexBuffer::clearInstanceStreams() {
+    m_impl->clearInstanceStreams();
+}
+
 void VertexBuffer::setType( const int type ) {
     m_impl->setType( type );
 }
@@ -414,6 +666,210 @@ void VertexBuffer::setType( const int type ) {
 
 
 
+IndexBuffer::IndexBuffer() :
+    m_impl( nullptr ) {
+}
+
+IndexBuffer::IndexBuffer( IndexBuffer&& toMove ) :
+    m_impl( toMove.m_impl ) {
+    toMove.m_impl = nullptr;
+}
+IndexBuffer& IndexBuffer::operator =( IndexBuffer&& toMove ) {
+    Private::release( m_impl );
+    m_impl = toMove.m_impl;
+    toMove.m_impl = nullptr;
+    return *this;
+}
+
+IndexBuffer::IndexBuffer( const Private::Handle< Private::IndexBufferImpl > impl ) :
+    m_impl( impl ) {
+}
+
+IndexBuffer::~IndexBuffer() {
+    Private::release( m_impl );
+}
+
+void IndexBuffer::create() {
+    m_impl->create();
+}
+
+void IndexBuffer::destroy() {
+    m_impl->destroy();
+}
+
+void IndexBuffer::set( const uint16* const indices, const std::size_t count ) {
+    m_impl->set( indices, count );
+}
+
+void IndexBuffer::set( const uint32* const indices, const std::size_t count ) {
+    m_impl->set( indices, count );
+}
+
+void IndexBuffer::set( const void* const indices, const std::size_t count, const IndexType type ) {
+    m_impl->set( indices, count, type );
+}
+
+void IndexBuffer::set( const void* const indices, const std::size_t offset, const std::size_t count ) {
+    m_impl->set( indices, offset, count );
+}
+
+IndexType IndexBuffer::getType() const {
+    return m_impl->getType();
+}
+
+std::size_t IndexBuffer::getCount() const {
+    return m_impl->getCount();
+}
+
+
+
+
+StreamingBuffer::StreamingBuffer() :
+    m_impl( nullptr ) {
+}
+
+StreamingBuffer::StreamingBuffer( StreamingBuffer&& toMove ) :
+    m_impl( toMove.m_impl ) {
+    toMove.m_impl = nullptr;
+}
+StreamingBuffer& StreamingBuffer::operator =( StreamingBuffer&& toMove ) {
+    Private::release( m_impl );
+    m_impl = toMove.m_impl;
+    toMove.m_impl = nullptr;
+    return *this;
+}
+
+StreamingBuffer::StreamingBuffer( const Private::Handle< Private::StreamingBufferImpl > impl ) :
+    m_impl( impl ) {
+}
+
+StreamingBuffer::~StreamingBuffer() {
+    Private::release( m_impl );
+}
+
+void StreamingBuffer::create() {
+    m_impl->create();
+}
+
+void StreamingBuffer::destroy() {
+    m_impl->destroy();
+}
+
+void StreamingBuffer::setLayout( const VertexLayout& layout ) {
+    m_impl->setLayout( layout );
+}
+
+const VertexLayout& StreamingBuffer::getLayout() const {
+    return m_impl->getLayout();
+}
+
+void StreamingBuffer::beginFrame() {
+    m_impl->beginFrame();
+}
+
+void StreamingBuffer::endFrame() {
+    m_impl->endFrame();
+}
+
+void* StreamingBuffer::allocate( const std::size_t size, const std::size_t alignment, std::size_t& offsetOut ) {
+    return m_impl->allocate( size, alignment, offsetOut );
+}
+
+void* StreamingBuffer::allocateVertices( const std::size_t count, std::size_t& firstOut ) {
+    return m_impl->allocateVertices( count, firstOut );
+}
+
+std::size_t StreamingBuffer::getRegionSize() const {
+    return m_impl->getRegionSize();
+}
+
+std::size_t StreamingBuffer::getRegionCount() const {
+    return m_impl->getRegionCount();
+}
+
+std::size_t StreamingBuffer::getRemaining() const {
+    return m_impl->getRemaining();
+}
+
+bool StreamingBuffer::isPersistent() const {
+    return m_impl->isPersistent();
+}
+
+std::size_t StreamingBuffer::getStallCount() const {
+    return m_impl->getStallCount();
+}
+
+
+
+
+DrawIndirectBuffer::DrawIndirectBuffer() :
+    m_impl( nullptr ) {
+}
+
+DrawIndirectBuffer::DrawIndirectBuffer( DrawIndirectBuffer&& toMove ) :
+    m_impl( toMove.m_impl ) {
+    toMove.m_impl = nullptr;
+}
+
+DrawIndirectBuffer& DrawIndirectBuffer::operator =( DrawIndirectBuffer&& toMove ) {
+    Private::release( m_impl );
+    m_impl = toMove.m_impl;
+    toMove.m_impl = nullptr;
+    return *this;
+}
+
+DrawIndirectBuffer::DrawIndirectBuffer( const Private::Handle< Private::DrawIndirectBufferImpl > impl ) :
+    m_impl( impl ) {
+}
+
+DrawIndirectBuffer::~DrawIndirectBuffer() {
+    Private::release( m_impl );
+}
+
+void DrawIndirectBuffer::create() {
+    m_impl->create();
+}
+
+void DrawIndirectBuffer::destroy() {
+    m_impl->destroy();
+}
+
+void DrawIndirectBuffer::beginFrame() {
+    m_impl->beginFrame();
+}
+
+void DrawIndirectBuffer::endFrame() {
+    m_impl->endFrame();
+}
+
+//Adds a command to the current batch; see GLDrawIndirectBuffer::add() for details
+void DrawIndirectBuffer::add( const std::size_t count, const std::size_t first, const int baseVertex, const std::size_t instanceCount, const uint baseInstance ) {
+    m_impl->add( count, first, baseVertex, instanceCount, baseInstance );
+}
+
+std::size_t DrawIndirectBuffer::getCapacity() const {
+    return m_impl->getCapacity();
+}
+
+std::size_t DrawIndirectBuffer::getRemaining() const {
+    return m_impl->getRemaining();
+}
+
+std::size_t DrawIndirectBuffer::getBatchCount() const {
+    return m_impl->getBatchCount();
+}
+
+bool DrawIndirectBuffer::isPersistent() const {
+    return m_impl->isPersistent();
+}
+
+std::size_t DrawIndirectBuffer::getStallCount() const {
+    return m_impl->getStallCount();
+}
+
+
+
+
 Texture::Texture() :
     m_impl( nullptr ) {
 }
@@ -424,18 +880,18 @@ Texture::Texture( Texture&& toMove ) :
 }
 
 Texture& Texture::operator =( Texture&& toMove ) {
+    Private::release( m_impl );
     m_impl = toMove.m_impl;
     toMove.m_impl = nullptr;
     return *this;
 }
 
-Texture::Texture( Private::TextureImpl* impl ) :
+Texture::Texture( const Private::Handle< Private::TextureImpl > impl ) :
     m_impl( impl ) {
 }
 
 Texture::~Texture() {
-    if( m_impl != nullptr )
-        delete m_impl;
+    Private::release( m_impl );
 }
 
 void Texture::create() {
@@ -450,6 +906,35 @@ void Texture::set( const std::size_t width, const std::size_t height, const void
     m_impl->set( width, height, data );
 }
 
+void Texture::set( const TextureData& data ) {
+    m_impl->set( data );
+}
+
+void Texture::setStorage( const std::size_t width, const std::size_t height, const TextureFormat format, const std::size_t levels ) {
+    m_impl->setStorage( width, height, format, levels );
+}
+
+void Texture::setLevel( const std::size_t level, const void* data ) {
+    m_impl->setLevel( level, data );
+}
+
+void Texture::setRegion( const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height, const void* data ) {
+    m_impl->setRegion( x, y, width, height, data );
+}
+
+void Texture::setRegion( const std::size_t level, const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height,
+                         StreamingBuffer& source, const std::size_t offset ) {
+    m_impl->setRegion( level, x, y, width, height, *source.m_impl, offset );
+}
+
+void Texture::generateMipmaps() {
+    m_impl->generateMipmaps();
+}
+
+void Texture::setBaseLevel( const std::size_t level ) {
+    m_impl->setBaseLevel( level );
+}
+
 void Texture::bind() {
     m_impl->bind();
 }
@@ -466,6 +951,14 @@ std::size_t Texture::getHeight() const {
     return m_impl->getHeight();
 }
 
+TextureFormat Texture::getFormat() const {
+    return m_impl->getFormat();
+}
+
+std::size_t Texture::getLevelCount() const {
+    return m_impl->getLevelCount();
+}
+
 
 
 
@@ -479,18 +972,18 @@ Sampler::Sampler( Sampler&& toMove ) :
 }
 
 Sampler& Sampler::operator =( Sampler&& toMove ) {
+    Private::release( m_impl );
     m_impl = toMove.m_impl;
     toMove.m_impl = nullptr;
     return *this;
 }
 
-Sampler::Sampler( Private::SamplerImpl* impl ) :
+Sampler::Sampler( const Private::Handle< Private::SamplerImpl > impl ) :
     m_impl( impl ) {
 }
 
 Sampler::~Sampler() {
-    if( m_impl != nullptr )
-        delete m_impl;
+    Private::release( m_impl );
 }
 void Sampler::create() {
     m_impl->create();
@@ -516,6 +1009,14 @@ void Sampler::setVWrap( const WrapType type ) {
     m_impl->setVWrap( type );
 }
 
+void Sampler::setMipFilter( const MipFilterType type ) {
+    m_impl->setMipFilter( type );
+}
+
+void Sampler::setMaxAnisotropy( const float anisotropy ) {
+    m_impl->setMaxAnisotropy( anisotropy );
+}
+
 void Sampler::bind() {
     m_impl->bind();
 }
@@ -527,4 +1028,142 @@ void Sampler::unbind() {
 
 
 
+Framebuffer::Framebuffer() :
+    m_impl( nullptr ) {
+}
+
+Framebuffer::Framebuffer( Framebuffer&& toMove ) :
+    m_impl( toMove.m_impl ) {
+    toMove.m_impl = nullptr;
+}
+
+Framebuffer& Framebuffer::operator =( Framebuffer&& toMove ) {
+    Private::release( m_impl );
+    m_impl = toMove.m_impl;
+    toMove.m_impl = nullptr;
+    return *this;
+}
+
+Framebuffer::Framebuffer( const Private::Handle< Private::FramebufferImpl > impl ) :
+    m_impl( impl ) {
+}
+
+Framebuffer::~Framebuffer() {
+    Private::release( m_impl );
+}
+
+void Framebuffer::create() {
+    m_impl->create();
+}
+
+void Framebuffer::destroy() {
+    m_impl->destroy();
+}
+
+void Framebuffer::setColor( Texture& texture, const std::size_t level ) {
+    m_impl->setColor( *texture.m_impl, level );
+}
+
+//Gives the framebuffer a color buffer of its own; see GLFramebuffer::setColor{2}() for details
+void Framebuffer::setColor( const std::size_t width, const std::size_t height, const TextureFormat format, const std::size_t samples ) {
+    m_impl->setColor( width, height, format, samples );
+}
+
+void Framebuffer::setDepth( const std::size_t width, const std::size_t height, const std::size_t samples ) {
+    m_impl->setDepth( width, height, samples );
+}
+
+bool Framebuffer::isComplete() const {
+    return m_impl->isComplete();
+}
+
+void Framebuffer::bind() {
+    m_impl->bind();
+}
+
+void Framebuffer::unbind() {
+    m_impl->unbind();
+}
+
+/*
+Framebuffer::read{1}
+--------------------
+
+Description:
+    Reads the entire color attachment back into the given image, as 8-bit RGBA pixels with the top row first.
+    This waits for any rendering into the framebuffer to finish.
+
+Arguments:
+    imageOut:           The image to read into. Any data it previously held is destroyed.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the pixels couldn't be read.
+*/
+void Framebuffer::read( Image& imageOut ) {
+    const std::size_t width  = m_impl->getWidth();
+    const std::size_t height = m_impl->getHeight();
+
+    std::unique_ptr< ubyte[] > data( new ubyte[ width * height * 4 ] );
+    m_impl->read( 0, 0, width, height, data.get() );
+    imageOut.set( data.release(), Size2i( (int)width, (int)height ) );
+}
+
+//Reads a region of the color attachment; see GLFramebuffer::read() for details
+void Framebuffer::read( const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height, void* const rgbaOut ) {
+    m_impl->read( x, y, width, height, rgbaOut );
+}
+
+//Copies a region of the color attachment to another framebuffer; see GLFramebuffer::blit() for details
+void Framebuffer::blit( Framebuffer& target, const int x, const int y, const int width, const int height,
+                        const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter ) {
+    m_impl->blit( *target.m_impl, x, y, width, height, targetX, targetY, targetWidth, targetHeight, filter );
+}
+
+/*
+Framebuffer::resolve
+--------------------
+
+Description:
+    Copies the entire color attachment to the given framebuffer, which must be the same size.
+    If this framebuffer is multisampled, the samples of each pixel are averaged as they're copied,
+    so this is how multisampled rendering is turned into a texture that can be sampled.
+
+Arguments:
+    target:             The framebuffer to copy to.
+
+Returns:
+    N/A
+
+Throws:
+    BoundsException:    If the framebuffers aren't the same size.
+    GraphicsException:  If the color attachment couldn't be copied.
+*/
+void Framebuffer::resolve( Framebuffer& target ) {
+    const int width  = (int)m_impl->getWidth();
+    const int height = (int)m_impl->getHeight();
+    if( target.m_impl->getWidth() != (std::size_t)width || target.m_impl->getHeight() != (std::size_t)height )
+        throw BoundsException();
+
+    m_impl->blit( *target.m_impl, 0, 0, width, height, 0, 0, width, height, FilterType::NEAREST );
+}
+
+std::size_t Framebuffer::getWidth() const {
+    return m_impl->getWidth();
+}
+
+std::size_t Framebuffer::getHeight() const {
+    return m_impl->getHeight();
+}
+
+std::size_t Framebuffer::getSamples() const {
+    return m_impl->getSamples();
+}
+
+
+
+
+
 }
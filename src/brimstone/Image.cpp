@@ -11,143 +11,132 @@ Description:
 
 
 //Includes
-#include <brimstone/Image.hpp>  //Header
-#include <png.h>                //png_*
+#include <brimstone/Image.hpp>                 //Header
+#include <brimstone/graphics/TextureData.hpp>  //Brimstone::TextureData
+#include <brimstone/util/PixelOps.hpp>         //Brimstone::convertRGBToRGBA, Brimstone::flipRows, Brimstone::swapRedBlue, ...
+#include <brimstone/Exception.hpp>             //Brimstone::SizeException, Brimstone::NullPointerException, Brimstone::BoundsException
 
+#include <cstdio>                              //FILE, std::fopen, std::fread, std::fclose
+#include <cstring>                             //std::memcpy, std::memmove
 
+#include <png.h>                               //png_*
 
 
-namespace {
-
 
 
+namespace {
 
-//Constants
-constexpr int IMAGE_PNG_SIG_SIZE = 8;
 
 
 
+//Types
+using ::Brimstone::ubyte;
+using ::Brimstone::Size2i;
+using ::Brimstone::Image;
 
-} //namespace
+//A PNG being read from memory
+struct PNGMemorySource {
+    const ubyte* data;
+    std::size_t  size;
+    std::size_t  offset;
+};
 
+//Where readPNG() decodes a PNG to, and what it found out about it
+struct PNGDestination {
+    //The storage to decode the image into. If this is nullptr, readPNG() allocates storage for it in image instead.
+    ubyte*       data;
+    std::size_t  size;
 
+    //The number of bytes from the start of one row to the next, or 0 if the rows are tightly packed
+    std::size_t  stride;
 
+    //If true, only the image's size is read
+    bool         headerOnly;
 
-namespace Brimstone {
+    Size2i       imageSize;
 
+    //The image to allocate storage in if data is nullptr
+    Image*       image;
+};
 
 
 
-Image::Image() :
-    m_data( nullptr ),
-    m_size( 0, 0 ) {
-}
 
-Image::Image( ubyte* const data, const Size2i size ) :
-    m_data( data ),
-    m_size( size ) {
-}
+//Constants
+constexpr int IMAGE_PNG_SIG_SIZE = 8;
 
-Image::Image( Image&& toMove ) :
-    m_data( toMove.m_data ),
-    m_size( toMove.m_size ) {
 
-    toMove.m_data = nullptr;
-}
 
-Image& Image::operator =( Image&& toMove ) {
-    m_data = toMove.m_data;
-    m_size = toMove.m_size;
-    toMove.m_data = nullptr;
 
-    return *this;
+//Functions
+//Errors are reported by returning false, so libPNG's messages aren't printed
+void onError( png_structp read, png_const_charp ) {
+    png_longjmp( read, 1 );
 }
 
-Image::~Image() {
-    destroy();
+void onWarning( png_structp, png_const_charp ) {
 }
 
-bool Image::isValid() const {
-    return m_data != nullptr;
-}
+void readFromMemory( png_structp read, png_bytep out, png_size_t count ) {
+    PNGMemorySource& source = *static_cast< PNGMemorySource* >( png_get_io_ptr( read ) );
+    if( count > source.size - source.offset )
+        png_error( read, "Unexpected end of PNG data." );
 
-void Image::set( ubyte* const data, const Size2i size ) {
-    //Destroy the previous image data if any was stored:
-    destroy();
+    std::memcpy( out, source.data + source.offset, count );
+    source.offset += count;
+}
 
-    //Set the new image data:
-    m_data = data;
-    m_size = size;
+void readFromFile( png_structp read, png_bytep out, png_size_t count ) {
+    if( std::fread( out, 1, count, static_cast< FILE* >( png_get_io_ptr( read ) ) ) != count )
+        png_error( read, "Unexpected end of PNG file." );
 }
 
 /*
-Image::loadPNG
---------------
+readPNG
+-------
 
 Description:
-    Loads a PNG image (using libPNG) from the file at the given path, filename, into this Image.
-    If the image was loaded successfully, true is returned.
-    Otherwise, false is returned.
+    Decodes a PNG as RGBA8, reading it with the given function.
+    The PNG's signature must have already been read and checked.
+    If destination.data is nullptr, the image is allocated in destination.image once its size is known, and decoded into that.
+
+    Each row is decoded straight into the destination, so no row pointers or intermediate buffers are needed.
 
 Arguments:
-    filename:  The path to the PNG image to load.
+    readFunction:   The function libPNG calls to read the PNG.
+    source:         Passed to readFunction through png_get_io_ptr().
+    destination:    Where to decode the image to; see PNGDestination.
 
 Returns:
-    bool:      true if the PNG image was loaded successfully, false otherwise.
+    bool:           true if the PNG was decoded successfully, false otherwise.
+                    If destination.image was allocated by this function and the PNG couldn't be decoded, it's destroyed again.
 */
-bool Image::loadPNG( const ustring& filename ) {
-    //Destroy the previous image data if any was stored:
-    destroy();
-
-    //Try to open file
-    FILE* file = fopen( filename.c_str(), "rb" );
-    if( file == nullptr )
-        return false;
-
-    //Try to read the file's signature
-    ubyte sig[IMAGE_PNG_SIG_SIZE];
-    if( fread( sig, 1, IMAGE_PNG_SIG_SIZE, file ) != IMAGE_PNG_SIG_SIZE ) {
-        fclose( file );
-        return false;
-    }
-
-    //Confirm that signature is valid
-    if( !png_check_sig( sig, IMAGE_PNG_SIG_SIZE ) ) {
-        fclose( file );
-        return false;
-    }
-
+bool readPNG( png_rw_ptr readFunction, void* source, PNGDestination& destination ) {
     //Try to create read struct
-    png_structp read = png_create_read_struct( PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr );
-    if( !read ) {
-        fclose( file );
+    png_structp read = png_create_read_struct( PNG_LIBPNG_VER_STRING, nullptr, onError, onWarning );
+    if( !read )
         return false;
-    }
 
     //Try to create info struct
     png_infop info = png_create_info_struct( read );
     if( !info ) {
         png_destroy_read_struct( &read, nullptr, nullptr );
-        fclose( file );
         return false;
     }
 
     //Error handling; the body of this if statement will be
     //jumped into if an error occurs while parsing the .png.
-    ubyte* data = nullptr;
-    ubyte** ptrs = nullptr;
+    //destination lives outside of this function, so its members are safe to read after the jump.
+    const bool allocate = destination.data == nullptr;
     if( setjmp( png_jmpbuf( read ) ) ) {
-        if( ptrs != nullptr )
-            delete [] ptrs;
-        if( data != nullptr )
-            delete [] data;
+        if( allocate && destination.image != nullptr )
+            destination.image->destroy();
         png_destroy_read_struct( &read, &info, nullptr );
-        fclose( file );
         return false;
     }
 
-    //Tell it to read from our file
-    png_init_io( read, file );
+    //Tell it to read from our source
+    png_set_read_fn( read, source, readFunction );
 
     //We've already read the signature, so skip it
     png_set_sig_bytes( read, IMAGE_PNG_SIG_SIZE );
@@ -160,6 +149,11 @@ bool Image::loadPNG( const ustring& filename ) {
     png_uint_32 height   = png_get_image_height( read, info );
     png_byte    depth    = png_get_bit_depth(    read, info );
     png_byte    color    = png_get_color_type(   read, info );
+    destination.imageSize.set( width, height );
+    if( destination.headerOnly ) {
+        png_destroy_read_struct( &read, &info, nullptr );
+        return true;
+    }
 
     //Perform conversions of native formats to RGBA
     switch( color ) {
@@ -186,53 +180,581 @@ bool Image::loadPNG( const ustring& filename ) {
     if( color == PNG_COLOR_TYPE_GRAY || color == PNG_COLOR_TYPE_GRAY_ALPHA )
         png_set_gray_to_rgb( read );
 
+    //Interlaced images are decoded in several passes over every row
+    const int passes = png_set_interlace_handling( read );
+
     //By this point the image should be guaranteed to be RGB8 or RGBA8.
     //If the image is RGB8, we need to convert it to RGBA8 by adding an alpha channel.
     //Because alpha is typically used to represent opacity, we want the alpha of our pixels to be 255 (full opacity).
-    //Note: PNG_COLOR_TYPE_PALETTE and PNG_COLOR_TYPE_GRAY are here because they were upgraded to RGB earlier in the function.
-    if( color == PNG_COLOR_TYPE_RGB || color == PNG_COLOR_TYPE_PALETTE || color == PNG_COLOR_TYPE_GRAY )
+    //Non-interlaced rows are expanded after they're read with convertRGBToRGBA(), which is much faster than libPNG's filler;
+    //interlaced rows are read more than once, so they have to stay RGBA between passes.
+    if( passes > 1 )
         png_set_filler( read, 0xFF, PNG_FILLER_AFTER );
-
-    //Allocate a buffer large enough to hold the entirety of the image
-    const size_t stride = 4*width;
-    data = new ubyte[stride*height];
-
-    //Allocate an array of row pointers.
-    //Direct them to the start of individual rows in the buffer we allocated
-    ptrs = new ubyte*[height];
-    for( size_t i = 0; i < height; ++i )
-        ptrs[i] = data + stride*i;
+    png_read_update_info( read, info );
+    const bool expand = png_get_channels( read, info ) == 3;
+
+    //Make sure the image fits in the destination, or allocate an image large enough to hold the entirety of it
+    if( allocate ) {
+        try {
+            destination.image->allocate( Size2i( (int)width, (int)height ) );
+        } catch( ... ) {
+            png_destroy_read_struct( &read, &info, nullptr );
+            throw;
+        }
+        destination.data   = destination.image->getData();
+        destination.stride = destination.image->getStride();
+        destination.size   = destination.stride * height;
+    }
+    const std::size_t rowSize = 4 * (std::size_t)width;
+    const std::size_t stride  = destination.stride != 0 ? destination.stride : rowSize;
+    const std::size_t size    = height == 0 ? 0 : stride * ( height - 1 ) + rowSize;
+    if( stride < rowSize || size > destination.size ) {
+        png_destroy_read_struct( &read, &info, nullptr );
+        return false;
+    }
 
     //Finally, finally read the image
-    png_read_update_info( read, info );
-    //auto rowbytes = png_get_rowbytes( read, info );
-    png_read_image( read, ptrs );
+    for( int pass = 0; pass < passes; ++pass ) {
+        for( png_uint_32 row = 0; row < height; ++row ) {
+            png_read_row( read, destination.data + stride * row, nullptr );
+            if( expand )
+                ::Brimstone::convertRGBToRGBA( destination.data + stride * row, width );
+        }
+    }
 
-    //Delete the data we allocated & close the file
-    delete [] ptrs;
+    png_read_end( read, nullptr );
     png_destroy_read_struct( &read, &info, nullptr );
-    fclose( file );
+    return true;
+}
+
+//Checks the signature of a PNG in memory and decodes the rest of it
+bool readPNG( const void* const data, const std::size_t size, PNGDestination& destination ) {
+    if( data == nullptr || size < IMAGE_PNG_SIG_SIZE || png_sig_cmp( static_cast< png_const_bytep >( data ), 0, IMAGE_PNG_SIG_SIZE ) != 0 )
+        return false;
+
+    PNGMemorySource source { static_cast< const ubyte* >( data ), size, IMAGE_PNG_SIG_SIZE };
+    return readPNG( readFromMemory, &source, destination );
+}
+
+
+
+
+} //namespace
+
 
-    //Output the image
-    m_data = data;
-    m_size.set( width, height );
 
+
+namespace Brimstone {
+
+
+
+
+Image::Image() :
+    Image( std::pmr::get_default_resource() ) {
+}
+
+//Creates an empty image that allocates its storage from the given memory resource, or the default resource if it's nullptr
+Image::Image( std::pmr::memory_resource* const resource ) :
+    m_data( nullptr ),
+    m_size( 0, 0 ),
+    m_stride( 0 ),
+    m_ownership( Ownership::NONE ),
+    m_resource( resource != nullptr ? resource : std::pmr::get_default_resource() ) {
+}
+
+//Creates an image of the given size, allocated from the given memory resource (or the default resource if it's nullptr); see allocate()
+Image::Image( const Size2i size, std::pmr::memory_resource* const resource ) :
+    Image( resource ) {
+
+    allocate( size );
+}
+
+//Creates an image that takes ownership of tightly packed pixels allocated with new ubyte[]; see set()
+Image::Image( ubyte* const data, const Size2i size ) :
+    Image() {
+
+    set( data, size );
+}
+
+Image::Image( Image&& toMove ) :
+    m_data( toMove.m_data ),
+    m_size( toMove.m_size ),
+    m_stride( toMove.m_stride ),
+    m_ownership( toMove.m_ownership ),
+    m_resource( toMove.m_resource ) {
+
+    toMove.m_data      = nullptr;
+    toMove.m_size      = Size2i( 0, 0 );
+    toMove.m_stride    = 0;
+    toMove.m_ownership = Ownership::NONE;
+}
+
+//Destroys this image's pixels and takes toMove's. This image allocates from toMove's memory resource afterwards.
+Image& Image::operator =( Image&& toMove ) {
+    if( this == &toMove )
+        return *this;
+
+    destroy();
+    m_data      = toMove.m_data;
+    m_size      = toMove.m_size;
+    m_stride    = toMove.m_stride;
+    m_ownership = toMove.m_ownership;
+    m_resource  = toMove.m_resource;
+
+    toMove.m_data      = nullptr;
+    toMove.m_size      = Size2i( 0, 0 );
+    toMove.m_stride    = 0;
+    toMove.m_ownership = Ownership::NONE;
+    return *this;
+}
+
+Image::~Image() {
+    destroy();
+}
+
+/*
+Image::view
+-----------
+
+Description:
+    Creates an image that refers to pixels it doesn't own, e.g. a mapped buffer, or a region of a larger image.
+    The pixels aren't copied, and aren't freed when the view is destroyed, so they must outlive it.
+
+Arguments:
+    data:      The first row of RGBA8 pixels.
+    size:      The width and height of the view.
+    stride:    The number of bytes from the start of one row to the next, or 0 if the rows are tightly packed.
+
+Returns:
+    Image:     The view.
+
+Throws:
+    NullPointerException:  If data is nullptr.
+    SizeException:         If size isn't positive, or stride is smaller than a row.
+*/
+Image Image::view( ubyte* const data, const Size2i size, const std::size_t stride ) {
+    if( data == nullptr )
+        throw NullPointerException();
+    if( size.width <= 0 || size.height <= 0 || ( stride != 0 && stride < (std::size_t)size.width * 4 ) )
+        throw SizeException();
+
+    Image image;
+    image.m_data   = data;
+    image.m_size   = size;
+    image.m_stride = stride != 0 ? stride : (std::size_t)size.width * 4;
+    return image;
+}
+
+//Returns the stride Image gives the images it allocates with the given width; each row is padded to a multiple of ROW_ALIGNMENT bytes
+std::size_t Image::getAlignedStride( const int32 width ) {
+    return ( (std::size_t)width * 4 + ROW_ALIGNMENT - 1 ) & ~( ROW_ALIGNMENT - 1 );
+}
+
+/*
+Image::allocate
+---------------
+
+Description:
+    Destroys the image's pixels, and allocates storage for an image of the given size from the image's memory resource.
+    The storage starts on a multiple of ROW_ALIGNMENT bytes, and each row is padded to a multiple of it (see getAlignedStride()).
+    The pixels (and the padding) are left uninitialized.
+
+Arguments:
+    size:            The width and height of the image.
+
+Returns:
+    N/A
+
+Throws:
+    SizeException:   If size isn't positive.
+*/
+void Image::allocate( const Size2i size ) {
+    destroy();
+    if( size.width <= 0 || size.height <= 0 )
+        throw SizeException();
+
+    const std::size_t stride = getAlignedStride( size.width );
+    m_data      = static_cast< ubyte* >( m_resource->allocate( stride * size.height, ROW_ALIGNMENT ) );
+    m_size      = size;
+    m_stride    = stride;
+    m_ownership = Ownership::RESOURCE;
+}
+
+//Destroys the image's pixels, and takes ownership of the given tightly packed pixels, which must have been allocated with new ubyte[]
+void Image::set( ubyte* const data, const Size2i size ) {
+    //Destroy the previous image data if any was stored:
+    destroy();
+
+    //Set the new image data:
+    if( data == nullptr )
+        return;
+    m_data      = data;
+    m_size      = size;
+    m_stride    = (std::size_t)size.width * 4;
+    m_ownership = Ownership::ARRAY;
+}
+
+/*
+Image::getPNGSize
+-----------------
+
+Description:
+    Reads the width and height of a PNG in memory, without decoding it.
+    Used to find out how much storage to give decodePNG().
+
+Arguments:
+    data:       The contents of the PNG file.
+    size:       The size of the PNG file, in bytes.
+    sizeOut:    Receives the width and height of the image.
+
+Returns:
+    bool:       true if the PNG's header was read successfully, false otherwise.
+*/
+bool Image::getPNGSize( const void* const data, const std::size_t size, Size2i& sizeOut ) {
+    PNGDestination destination { nullptr, 0, 0, true, Size2i( 0, 0 ), nullptr };
+    if( !readPNG( data, size, destination ) )
+        return false;
+
+    sizeOut = destination.imageSize;
     return true;
 }
 
+/*
+Image::decodePNG
+----------------
+
+Description:
+    Decodes a PNG in memory as RGBA8 into storage supplied by the caller, with rows from top to bottom.
+    Nothing is allocated for the image's pixels; each row is decoded straight into the destination.
+
+Arguments:
+    data:               The contents of the PNG file.
+    size:               The size of the PNG file, in bytes.
+    destination:        Where to decode the image to.
+    destinationSize:    The size of destination, in bytes.
+    stride:             The number of bytes from the start of one row to the next in destination,
+                        or 0 if the rows are tightly packed (4 * width).
+
+Returns:
+    bool:               true if the PNG was decoded successfully.
+                        false if it couldn't be decoded, or doesn't fit in the destination.
+                        If the PNG is corrupt, part of the destination may have been written to.
+*/
+bool Image::decodePNG( const void* const data, const std::size_t size, void* const destination, const std::size_t destinationSize, const std::size_t stride ) {
+    if( destination == nullptr )
+        return false;
+
+    PNGDestination out { static_cast< ubyte* >( destination ), destinationSize, stride, false, Size2i( 0, 0 ), nullptr };
+    return readPNG( data, size, out );
+}
+
+/*
+Image::loadPNG{1}
+-----------------
+
+Description:
+    Loads a PNG image (using libPNG) from the file at the given path, filename, into this Image.
+    If the image was loaded successfully, true is returned.
+    Otherwise, false is returned.
+
+Arguments:
+    filename:  The path to the PNG image to load.
+
+Returns:
+    bool:      true if the PNG image was loaded successfully, false otherwise.
+*/
+bool Image::loadPNG( const ustring& filename ) {
+    //Destroy the previous image data if any was stored:
+    destroy();
+
+    //Try to open file
+    FILE* file = std::fopen( filename.c_str(), "rb" );
+    if( file == nullptr )
+        return false;
+
+    //Try to read the file's signature, and confirm that it's valid
+    ubyte sig[IMAGE_PNG_SIG_SIZE];
+    if( std::fread( sig, 1, IMAGE_PNG_SIG_SIZE, file ) != IMAGE_PNG_SIG_SIZE || png_sig_cmp( sig, 0, IMAGE_PNG_SIG_SIZE ) != 0 ) {
+        std::fclose( file );
+        return false;
+    }
+
+    PNGDestination destination { nullptr, 0, 0, false, Size2i( 0, 0 ), this };
+    bool ok;
+    try {
+        ok = readPNG( readFromFile, file, destination );
+    } catch( ... ) {
+        std::fclose( file );
+        throw;
+    }
+    std::fclose( file );
+    return ok;
+}
+
+/*
+Image::loadPNG{2}
+-----------------
+
+Description:
+    Decodes a PNG image from memory into this Image, e.g. from a file that's been mapped into memory.
+    The PNG is read directly from the given memory rather than copied.
+
+Arguments:
+    data:      The contents of the PNG file.
+    size:      The size of the PNG file, in bytes.
+
+Returns:
+    bool:      true if the PNG image was loaded successfully, false otherwise.
+*/
+bool Image::loadPNG( const void* const data, const std::size_t size ) {
+    //Destroy the previous image data if any was stored:
+    destroy();
+
+    PNGDestination destination { nullptr, 0, 0, false, Size2i( 0, 0 ), this };
+    return readPNG( data, size, destination );
+}
+
+/*
+Image::load{1}
+--------------
+
+Description:
+    Loads the base level of a .bsi file (see ImageFile).
+    The file is mapped into memory, and its texels are copied (or decompressed) straight into the image.
+
+Arguments:
+    filename:  The path to the file to load.
+
+Returns:
+    bool:      true if the file was loaded successfully, false if it couldn't be opened, is corrupt,
+               or isn't in an RGBA8 or SRGB8_ALPHA8 format.
+*/
+bool Image::load( const ustring& filename ) {
+    //Destroy the previous image data if any was stored:
+    destroy();
+
+    ImageFile file;
+    return file.open( filename ) && decodeBSI( file );
+}
+
+/*
+Image::load{2}
+--------------
+
+Description:
+    Loads the base level of a .bsi file that's already in memory (see ImageFile).
+
+Arguments:
+    data:      The contents of the .bsi file. Only needs to stay valid until this function returns.
+    size:      The size of the file, in bytes.
+
+Returns:
+    bool:      true if the file was loaded successfully, false if it is corrupt or isn't in an RGBA8 or SRGB8_ALPHA8 format.
+*/
+bool Image::load( const void* const data, const std::size_t size ) {
+    //Destroy the previous image data if any was stored:
+    destroy();
+
+    ImageFile file;
+    return file.open( data, size ) && decodeBSI( file );
+}
+
+/*
+Image::save
+-----------
+
+Description:
+    Saves the image to a .bsi file (see ImageFile), so it can be loaded quickly with load().
+
+Arguments:
+    filename:      The path to the file to write. If it already exists, it's overwritten.
+    compression:   How to store the image.
+    mipmaps:       If true, a complete mipmap chain is generated and stored along with the image.
+
+Returns:
+    bool:          true if the file was written, false if the image is empty or the file couldn't be written.
+*/
+bool Image::save( const ustring& filename, const ImageCompression compression, const bool mipmaps ) const {
+    if( !isValid() )
+        return false;
+
+    TextureData data;
+    data.set( *this );
+    if( mipmaps )
+        data.generateMipmaps();
+    return ImageFile::save( filename, data, compression );
+}
+
+//Frees the image's pixels if it owns them, leaving it empty
 void Image::destroy() {
+    if( m_ownership == Ownership::ARRAY )
+        delete[] m_data;
+    else if( m_ownership == Ownership::RESOURCE )
+        m_resource->deallocate( m_data, m_stride * m_size.height, ROW_ALIGNMENT );
+
+    m_data      = nullptr;
+    m_size      = Size2i( 0, 0 );
+    m_stride    = 0;
+    m_ownership = Ownership::NONE;
+}
+
+//Decodes the base level of an open .bsi file into the image, which must be empty
+bool Image::decodeBSI( const ImageFile& file ) {
+    if( file.getFormat() != TextureFormat::RGBA8 && file.getFormat() != TextureFormat::SRGB8_ALPHA8 )
+        return false;
+
+    //The level is decoded tightly packed at the start of the image, then its rows are moved apart to their aligned positions,
+    //starting with the last row so none of them are overwritten before they're moved
+    allocate( Size2i( file.getWidth(), file.getHeight() ) );
+    if( !file.decodeLevel( 0, m_data ) ) {
+        destroy();
+        return false;
+    }
+    const std::size_t rowSize = (std::size_t)m_size.width * 4;
+    for( int32 y = m_size.height - 1; y > 0; --y )
+        std::memmove( m_data + y * m_stride, m_data + y * rowSize, rowSize );
+    return true;
+}
+
+//Flips the image upside down, e.g. to match OpenGL's bottom-to-top row order
+void Image::flipVertical() {
     if( m_data != nullptr )
-        delete m_data;
+        flipRows( m_data, (std::size_t)m_size.width * 4, m_size.height, m_stride );
+}
+
+//Converts the image from RGBA to BGRA (or back)
+void Image::swapRedBlue() {
+    forEachRow( ::Brimstone::swapRedBlue );
+}
+
+//Multiplies the color of each pixel by its alpha
+void Image::premultiplyAlpha() {
+    forEachRow( ::Brimstone::premultiplyAlpha );
+}
+
+//Divides the color of each pixel by its alpha, undoing premultiplyAlpha() (up to rounding)
+void Image::unpremultiplyAlpha() {
+    forEachRow( ::Brimstone::unpremultiplyAlpha );
+}
+
+//Converts the color of each pixel from sRGB to linear, leaving alpha alone
+void Image::convertSRGBToLinear() {
+    forEachRow( ::Brimstone::convertSRGBToLinear );
+}
+
+/*
+Image::resize
+-------------
+
+Description:
+    Returns a copy of the image resampled to the given size, allocated from this image's memory resource. See util/Resample.hpp.
+
+Arguments:
+    size:      The size of the new image.
+    filter:    The filter to resample with.
+    srgb:      If true, the image's color is sRGB-encoded, and is filtered in linear space.
+    pool:      If this isn't nullptr, the image is resampled on this pool's threads as well as the calling thread.
+
+Returns:
+    Image:     The resized image, or an empty image if this image is empty.
+
+Throws:
+    SizeException:  If size isn't positive.
+*/
+Image Image::resize( const Size2i size, const ResampleFilter filter, const bool srgb, ThreadPool* const pool ) const {
+    if( !isValid() )
+        return Image();
+    if( size.width <= 0 || size.height <= 0 )
+        throw SizeException();
+
+    Image resized( size, m_resource );
+    resample( m_data, m_size.width, m_size.height, m_stride, resized.m_data, size.width, size.height, resized.m_stride, 4, filter, srgb, pool );
+    return resized;
+}
+
+/*
+Image::buildMipChain
+--------------------
+
+Description:
+    Builds a complete mipmap chain from the image, ready to be uploaded with Texture::set() or saved as a .bsi file.
+    Each level is resampled from the one above it with the given filter, so no GPU is needed.
+
+Arguments:
+    filter:         The filter to resample each level with.
+    srgb:           If true, the image's color is sRGB-encoded; the levels are filtered in linear space and stored as SRGB8_ALPHA8.
+                    Otherwise they're stored as RGBA8.
+    pool:           If this isn't nullptr, each level is resampled on this pool's threads as well as the calling thread.
+
+Returns:
+    TextureData:    The image and every mipmap level below it, down to 1x1, or empty TextureData if this image is empty.
+*/
+TextureData Image::buildMipChain( const ResampleFilter filter, const bool srgb, ThreadPool* const pool ) const {
+    TextureData data;
+    if( !isValid() )
+        return data;
+
+    data.set( srgb ? TextureFormat::SRGB8_ALPHA8 : TextureFormat::RGBA8, m_size.width, m_size.height, m_data, m_stride );
+    data.generateMipmaps( filter, 0, pool );
+    return data;
+}
+
+//Returns a view of this image's pixels, or an empty image if this image is empty; see view()
+Image Image::getView() const {
+    if( m_data == nullptr )
+        return Image();
+    return view( m_data, m_size, m_stride );
+}
+
+bool Image::isValid() const {
+    return m_data != nullptr;
+}
+
+//Returns true if this image refers to pixels it doesn't own
+bool Image::isView() const {
+    return m_data != nullptr && m_ownership == Ownership::NONE;
 }
 
 ubyte* Image::getData() const {
     return m_data;
 }
 
+ubyte* Image::getRow( const int32 y ) const {
+#ifdef BS_CHECK_INDEX
+    if( y < 0 || y >= m_size.height )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    return m_data + y * m_stride;
+}
+
 Size2i Image::getSize() const {
     return m_size;
 }
 
+//Returns the number of bytes from the start of one row to the next
+std::size_t Image::getStride() const {
+    return m_stride;
+}
+
+//Returns the memory resource the image allocates its storage from
+std::pmr::memory_resource* Image::getMemoryResource() const {
+    return m_resource;
+}
+
+//Calls the given pixel operation on every pixel, a row at a time if the rows aren't tightly packed
+void Image::forEachRow( void ( *operation )( ubyte* const data, const std::size_t pixelCount ) ) {
+    if( m_data == nullptr )
+        return;
+
+    if( m_stride == (std::size_t)m_size.width * 4 ) {
+        operation( m_data, (std::size_t)m_size.width * m_size.height );
+        return;
+    }
+    for( int32 y = 0; y < m_size.height; ++y )
+        operation( m_data + y * m_stride, m_size.width );
+}
+
 
 
 
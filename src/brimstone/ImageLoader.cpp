@@ -0,0 +1,331 @@
+/*
+ImageLoader.cpp
+---------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See ImageLoader.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/ImageLoader.hpp>  //Header
+
+#include <brimstone/Exception.hpp>    //Brimstone::IException, Brimstone::Exception, Brimstone::uncaughtException
+
+#include <cstdio>                     //FILE, std::fopen, std::fread, std::fseek, std::ftell, std::fclose
+#include <exception>                  //std::exception
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ustring;
+using ::Brimstone::ubyte;
+using ::Brimstone::IException;
+using ::Brimstone::Exception;
+
+
+
+
+//Functions
+//Reads the entire file at the given path into contentsOut. Returns false if it couldn't be read.
+bool readFile( const ustring& filename, std::vector< ubyte >& contentsOut ) {
+    FILE* file = std::fopen( filename.c_str(), "rb" );
+    if( file == nullptr )
+        return false;
+
+    bool ok = std::fseek( file, 0, SEEK_END ) == 0;
+    const long size = ok ? std::ftell( file ) : -1;
+    ok = ok && size >= 0 && std::fseek( file, 0, SEEK_SET ) == 0;
+    if( ok ) {
+        contentsOut.resize( size );
+        ok = std::fread( contentsOut.data(), 1, contentsOut.size(), file ) == contentsOut.size();
+    }
+    std::fclose( file );
+    return ok;
+}
+
+//Passes the exception currently being handled to uncaughtException().
+//Tasks posted to a pool call this rather than let an exception reach the worker running them.
+void reportException() {
+    try {
+        throw;
+    } catch( const IException& ex ) {
+        ::Brimstone::uncaughtException( ex );
+    } catch( const std::exception& ex ) {
+        ::Brimstone::uncaughtException( Exception( ex.what() ) );
+    } catch( ... ) {
+        ::Brimstone::uncaughtException( Exception( "Unknown exception while loading an image." ) );
+    }
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Creates a loader with its own pool of ThreadPool::getDefaultThreadCount() threads
+ImageLoader::ImageLoader() :
+    ImageLoader( ThreadPool::getDefaultThreadCount() ) {
+}
+
+//Creates a loader with its own pool of the given number of threads
+ImageLoader::ImageLoader( const std::size_t threadCount ) :
+    m_ownPool( new ThreadPool( threadCount ) ),
+    m_pool( m_ownPool.get() ),
+    m_pending( 0 ),
+    m_stats {} {
+}
+
+//Creates a loader that decodes images on the given pool, which must outlive it
+ImageLoader::ImageLoader( ThreadPool& pool ) :
+    m_pool( &pool ),
+    m_pending( 0 ),
+    m_stats {} {
+}
+
+//Waits for every image that's still being loaded
+ImageLoader::~ImageLoader() {
+    wait();
+}
+
+/*
+ImageLoader::load{1}
+--------------------
+
+Description:
+    Queues a PNG file to be loaded on one of the loader's threads.
+
+Arguments:
+    filename:               The path to the PNG file.
+
+Returns:
+    std::future< Image >:   Receives the image once it's been decoded, or an empty image if it couldn't be loaded.
+                            If decoding throws, the exception is rethrown by std::future::get().
+*/
+std::future< Image > ImageLoader::load( const ustring& filename ) {
+    begin( 1 );
+    return m_pool->submit( [this, filename]() {
+        //The image is counted as delivered even if decoding it throws, or wait() would never return
+        Image image;
+        try {
+            image = decode( filename );
+        } catch( ... ) {
+            end();
+            throw;
+        }
+        end();
+        return image;
+    } );
+}
+
+/*
+ImageLoader::load{2}
+--------------------
+
+Description:
+    Queues a PNG in memory to be decoded on one of the loader's threads.
+    The PNG is decoded where it is, so its memory must stay valid until the image has been delivered.
+
+Arguments:
+    blob:                   The PNG to decode.
+
+Returns:
+    std::future< Image >:   Receives the image once it's been decoded, or an empty image if it couldn't be decoded.
+                            If decoding throws, the exception is rethrown by std::future::get().
+*/
+std::future< Image > ImageLoader::load( const ImageBlob blob ) {
+    begin( 1 );
+    return m_pool->submit( [this, blob]() {
+        //The image is counted as delivered even if decoding it throws, or wait() would never return
+        Image image;
+        try {
+            image = decode( blob );
+        } catch( ... ) {
+            end();
+            throw;
+        }
+        end();
+        return image;
+    } );
+}
+
+//Queues a batch of PNG files to be loaded; the futures are in the same order as the filenames
+std::vector< std::future< Image > > ImageLoader::load( const std::vector< ustring >& filenames ) {
+    std::vector< std::future< Image > > futures;
+    futures.reserve( filenames.size() );
+    for( const ustring& filename : filenames )
+        futures.push_back( load( filename ) );
+    return futures;
+}
+
+//Queues a batch of PNGs in memory to be decoded; the futures are in the same order as the blobs
+std::vector< std::future< Image > > ImageLoader::load( const std::vector< ImageBlob >& blobs ) {
+    std::vector< std::future< Image > > futures;
+    futures.reserve( blobs.size() );
+    for( const ImageBlob blob : blobs )
+        futures.push_back( load( blob ) );
+    return futures;
+}
+
+/*
+ImageLoader::load{5}
+--------------------
+
+Description:
+    Queues a batch of PNG files to be loaded, and calls the given callback with each image as soon as it's ready.
+    Images are delivered in the order they finish, not the order they were queued in.
+
+Arguments:
+    filenames:  The paths to the PNG files.
+    callback:   Called on the thread that decoded each image, with the index of its file in filenames.
+                It's called with an empty image if the file couldn't be loaded.
+                If decoding an image or the callback throws, the exception is passed to uncaughtException().
+
+Returns:
+    N/A
+*/
+void ImageLoader::load( const std::vector< ustring >& filenames, Callback callback ) {
+    begin( filenames.size() );
+    for( std::size_t i = 0; i < filenames.size(); ++i ) {
+        m_pool->post( [this, filename = filenames[i], i, callback]() {
+            try {
+                Image image = decode( filename );
+                callback( i, image );
+            } catch( ... ) {
+                reportException();
+            }
+            end();
+        } );
+    }
+}
+
+//Queues a batch of PNGs in memory to be decoded, and calls the given callback with each image as soon as it's ready; see load{5}
+void ImageLoader::load( const std::vector< ImageBlob >& blobs, Callback callback ) {
+    begin( blobs.size() );
+    for( std::size_t i = 0; i < blobs.size(); ++i ) {
+        m_pool->post( [this, blob = blobs[i], i, callback]() {
+            try {
+                Image image = decode( blob );
+                callback( i, image );
+            } catch( ... ) {
+                reportException();
+            }
+            end();
+        } );
+    }
+}
+
+//Waits until every image queued so far has been decoded and, for batches loaded with a callback, delivered
+void ImageLoader::wait() {
+    std::unique_lock< std::mutex > l( m_mutex );
+    m_idle.wait( l, [this]() { return m_pending == 0; } );
+}
+
+std::size_t ImageLoader::getThreadCount() const {
+    return m_pool->getThreadCount();
+}
+
+//Returns the number of images that have been queued and haven't been delivered yet
+std::size_t ImageLoader::getPendingCount() const {
+    std::lock_guard< std::mutex > l( m_mutex );
+    return m_pending;
+}
+
+//Returns totals for every image loaded since the loader was created or resetStats() was called.
+//If images are still being loaded, the time they've taken so far is included.
+ImageLoaderStats ImageLoader::getStats() const {
+    std::lock_guard< std::mutex > l( m_mutex );
+    ImageLoaderStats stats = m_stats;
+    if( m_pending > 0 )
+        stats.milliseconds += std::chrono::duration< double, std::milli >( Clock::now() - m_busySince ).count();
+    return stats;
+}
+
+//Returns the number of megabytes (10^6 bytes) of PNG data decoded per second, or 0 if nothing has been decoded
+double ImageLoader::getThroughput() const {
+    const ImageLoaderStats stats = getStats();
+    if( stats.milliseconds <= 0.0 )
+        return 0.0;
+    return (double)stats.encodedBytes / ( stats.milliseconds * 1000.0 );
+}
+
+void ImageLoader::resetStats() {
+    std::lock_guard< std::mutex > l( m_mutex );
+    m_stats     = {};
+    m_busySince = Clock::now();
+}
+
+//Counts images that are about to be queued, starting the clock if the loader was idle
+void ImageLoader::begin( const std::size_t count ) {
+    if( count == 0 )
+        return;
+
+    std::lock_guard< std::mutex > l( m_mutex );
+    if( m_pending == 0 )
+        m_busySince = Clock::now();
+    m_pending += count;
+}
+
+//Called when an image has been delivered, stopping the clock if it was the last one
+void ImageLoader::end() {
+    //The condition variable is notified with the mutex held, since the loader may be destroyed as soon as it's unlocked
+    std::lock_guard< std::mutex > l( m_mutex );
+    if( --m_pending == 0 ) {
+        m_stats.milliseconds += std::chrono::duration< double, std::milli >( Clock::now() - m_busySince ).count();
+        m_idle.notify_all();
+    }
+}
+
+Image ImageLoader::decode( const ustring& filename ) {
+    //Each worker reuses its own buffer for the files it reads
+    thread_local std::vector< ubyte > contents;
+
+    Image       image;
+    std::size_t size = 0;
+    if( readFile( filename, contents ) ) {
+        size = contents.size();
+        image.loadPNG( contents.data(), size );
+    }
+    record( image, size );
+    return image;
+}
+
+Image ImageLoader::decode( const ImageBlob blob ) {
+    Image image;
+    image.loadPNG( blob.data, blob.size );
+    record( image, blob.size );
+    return image;
+}
+
+void ImageLoader::record( const Image& image, const std::size_t encodedBytes ) {
+    std::lock_guard< std::mutex > l( m_mutex );
+    m_stats.encodedBytes += encodedBytes;
+    if( image.isValid() ) {
+        ++m_stats.images;
+        m_stats.decodedBytes += (uint64)image.getSize().width * image.getSize().height * 4;
+    } else {
+        ++m_stats.failures;
+    }
+}
+
+
+
+
+} //namespace Brimstone
@@ -72,10 +72,92 @@ bool Window::getEvent( WindowEvent& eventOut ) {
     return m_impl->getEvent( eventOut );
 }
 
+/*
+Window::pollEvents
+------------------
+
+Description:
+    Processes the events the operating system has queued, without blocking,
+    then removes up to max WindowEvents from the front of the window's event queue.
+    Call it until it returns 0 to drain a frame's input in a few calls, with no allocation.
+
+Arguments:
+    eventsOut:      The events are output here, oldest first. Must have room for max events.
+    max:            The most events to output.
+
+Returns:
+    std::size_t:    The number of events output.
+*/
+std::size_t Window::pollEvents( WindowEvent* const eventsOut, const std::size_t max ) {
+    return m_impl->pollEvents( eventsOut, max );
+}
+
 void Window::pushEvent( const WindowEvent& eventIn ) {
     m_impl->pushEvent( eventIn );
 }
 
+/*
+Window::setEventQueueCapacity
+-----------------------------
+
+Description:
+    Sets how many events the window's queue holds, and what happens when an event arrives while it's full.
+    By default, the queue holds 256 events and grows when it's full, so no events are lost.
+    With a fixed capacity, events that are dropped are counted by getDroppedEventCount().
+
+Arguments:
+    capacity:       The number of events the queue can hold. Rounded up to a power of two.
+    overflow:       What to do when an event arrives while the queue is full.
+
+Returns:
+    N/A
+
+Throws:
+    SizeException:  If capacity is 0.
+*/
+void Window::setEventQueueCapacity( const std::size_t capacity, const RingBufferOverflow overflow ) {
+    m_impl->setEventQueueCapacity( capacity, overflow );
+}
+
+std::size_t Window::getEventQueueCapacity() const {
+    return m_impl->getEventQueueCapacity();
+}
+
+//Returns the number of events dropped because the window's event queue was full
+uint64 Window::getDroppedEventCount() const {
+    return m_impl->getDroppedEventCount();
+}
+
+/*
+Window::setEventCoalescing
+--------------------------
+
+Description:
+    Enables or disables event coalescing.
+    While it's enabled, a MouseMove, MouseRawMove, MouseSmoothScroll, Move or Resize event that arrives while another of the same type is still queued
+    is merged into it (see coalesceWindowEvent()), so a frame sees one event per motion instead of one per mouse report.
+    It's disabled by default; applications that need every mouse report (e.g. for drawing) should leave it that way.
+    Events pushed with pushEvent() are coalesced too.
+
+Arguments:
+    coalesce:   true to merge events, false to queue every event.
+
+Returns:
+    N/A
+*/
+void Window::setEventCoalescing( const bool coalesce ) {
+    m_impl->setEventCoalescing( coalesce );
+}
+
+bool Window::getEventCoalescing() const {
+    return m_impl->getEventCoalescing();
+}
+
+//Returns the number of events that have been merged into other events because event coalescing was enabled
+uint64 Window::getCoalescedEventCount() const {
+    return m_impl->getCoalescedEventCount();
+}
+
 void Window::setTitle( const ustring& title ) {
     m_impl->setTitle( title );
 }
@@ -204,6 +286,38 @@ bool Window::getKeepCursorCentered() const {
     return m_impl->getKeepCursorCentered();
 }
 
+/*
+Window::setRawMouseInput
+------------------------
+
+Description:
+    Sets whether the window receives MouseRawMove and MouseSmoothScroll events while it has focus.
+    These come straight from the mouse: MouseRawMove reports how far it moved, without pointer acceleration and even when the
+    cursor is stuck against the edge of the window or screen, and MouseSmoothScroll reports scrolling in fractions of a wheel click.
+    Both carry the time the device reported them.
+
+    This is the way to implement mouselook. Keeping the cursor centered (see setKeepCursorCentered()) moves the cursor back
+    to the center every frame, which costs a round trip to the display server and loses motion between frames; while raw mouse input
+    is in use, frame() doesn't do that. Trap and hide the cursor (see setCursorTrapped() and setCursorVisible()) to keep it from
+    leaving the window instead.
+
+    Currently only X11 with the XInput 2 extension delivers these events. Elsewhere, no raw events are delivered, and keeping
+    the cursor centered works as before.
+
+Arguments:
+    rawMouseInput:  true to receive raw mouse events, false otherwise.
+
+Returns:
+    N/A
+*/
+void Window::setRawMouseInput( const bool rawMouseInput ) {
+    m_impl->setRawMouseInput( rawMouseInput );
+}
+
+bool Window::getRawMouseInput() const {
+    return m_impl->getRawMouseInput();
+}
+
 void Window::sendToTop() {
     return m_impl->sendToTop();
 }
@@ -0,0 +1,477 @@
+/*
+graphics/CommandBuffer.cpp
+--------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See CommandBuffer.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/CommandBuffer.hpp>  //Header
+
+#include <brimstone/Graphics.hpp>                //Brimstone::Program, Brimstone::VertexBuffer, Brimstone::IndexBuffer, etc.
+#include <brimstone/Exception.hpp>               //Brimstone::SizeException, Brimstone::BoundsException
+
+#include <algorithm>                             //std::max, std::stable_sort
+#include <cstring>                               //std::memcpy, std::strlen
+#include <limits>                                //std::numeric_limits
+#include <new>                                   //placement new
+
+
+
+
+namespace {
+
+
+
+
+//Constants
+//Every command starts on a multiple of this, so pointers in command data are aligned
+constexpr std::size_t COMMAND_ALIGNMENT = alignof( Brimstone::CommandHeader );
+
+//Number of bits of each field in a sort key, from most to least significant
+constexpr int SORT_KEY_PASS_BITS     = 8;
+constexpr int SORT_KEY_PROGRAM_BITS  = 16;
+constexpr int SORT_KEY_MATERIAL_BITS = 16;
+constexpr int SORT_KEY_DEPTH_BITS    = 24;
+static_assert( SORT_KEY_PASS_BITS + SORT_KEY_PROGRAM_BITS + SORT_KEY_MATERIAL_BITS + SORT_KEY_DEPTH_BITS == 64, "Sort key fields must fill 64 bits." );
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+CommandBuffer::CommandBuffer( const std::size_t blockSize ) :
+    m_blockSize( blockSize ),
+    m_block( 0 ),
+    m_used( 0 ),
+    m_commandCount( 0 ),
+    m_size( 0 ) {
+}
+
+/*
+CommandBuffer::reset
+--------------------
+
+Description:
+    Discards every recorded command so the buffer can be recorded into again.
+    The memory the commands were stored in is kept for reuse.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void CommandBuffer::reset() {
+    m_block        = 0;
+    m_used         = 0;
+    m_commandCount = 0;
+    m_size         = 0;
+    m_packets.clear();
+}
+
+/*
+CommandBuffer::begin
+--------------------
+
+Description:
+    Starts a new packet. Commands recorded after this are added to the packet, until the next call to begin().
+    If commands are recorded before begin() is called, they're added to a packet with a key of 0.
+
+Arguments:
+    key:  The packet's sort key. See makeSortKey().
+
+Returns:
+    N/A
+*/
+void CommandBuffer::begin( const uint64 key ) {
+    //Reuse the current packet if nothing was recorded into it
+    if( !m_packets.empty() && m_packets.back().size == 0 ) {
+        m_packets.back().key = key;
+        return;
+    }
+    m_packets.push_back( CommandPacket { key, nullptr, 0 } );
+}
+
+void CommandBuffer::useProgram( const Program& program ) {
+    Commands::UseProgram* command = static_cast< Commands::UseProgram* >( record( CommandType::USE_PROGRAM, sizeof( Commands::UseProgram ) ) );
+    command->program = program.m_impl;
+}
+
+void CommandBuffer::setUniform( const char* const name, const int value ) {
+    const int32 values[] = { value };
+    setUniform( name, UniformType::INT, values, sizeof( values ) );
+}
+
+void CommandBuffer::setUniform( const char* const name, const uint value ) {
+    const uint32 values[] = { value };
+    setUniform( name, UniformType::UINT, values, sizeof( values ) );
+}
+
+void CommandBuffer::setUniform( const char* const name, const float value ) {
+    const float values[] = { value };
+    setUniform( name, UniformType::FLOAT, values, sizeof( values ) );
+}
+
+void CommandBuffer::setUniform( const char* const name, const int x, const int y ) {
+    const int32 values[] = { x, y };
+    setUniform( name, UniformType::INT2, values, sizeof( values ) );
+}
+
+void CommandBuffer::setUniform( const char* const name, const float x, const float y ) {
+    const float values[] = { x, y };
+    setUniform( name, UniformType::FLOAT2, values, sizeof( values ) );
+}
+
+void CommandBuffer::setUniform( const char* const name, const int x, const int y, const int z, const int w ) {
+    const int32 values[] = { x, y, z, w };
+    setUniform( name, UniformType::INT4, values, sizeof( values ) );
+}
+
+void CommandBuffer::setUniform( const char* const name, const float x, const float y, const float z, const float w ) {
+    const float values[] = { x, y, z, w };
+    setUniform( name, UniformType::FLOAT4, values, sizeof( values ) );
+}
+
+void CommandBuffer::bindTexture( const Texture& texture ) {
+    Commands::BindTexture* command = static_cast< Commands::BindTexture* >( record( CommandType::BIND_TEXTURE, sizeof( Commands::BindTexture ) ) );
+    command->texture = texture.m_impl;
+    command->sampler = nullptr;
+}
+
+void CommandBuffer::bindTexture( const Texture& texture, const Sampler& sampler ) {
+    Commands::BindTexture* command = static_cast< Commands::BindTexture* >( record( CommandType::BIND_TEXTURE, sizeof( Commands::BindTexture ) ) );
+    command->texture = texture.m_impl;
+    command->sampler = sampler.m_impl;
+}
+
+void CommandBuffer::setBlendMode( const BlendMode mode ) {
+    Commands::SetBlendMode* command = static_cast< Commands::SetBlendMode* >( record( CommandType::SET_BLEND_MODE, sizeof( Commands::SetBlendMode ) ) );
+    command->mode = mode;
+}
+
+void CommandBuffer::setDepthTest( const bool enabled ) {
+    setEnabled( CommandType::SET_DEPTH_TEST, enabled );
+}
+
+void CommandBuffer::setDepthMask( const bool enabled ) {
+    setEnabled( CommandType::SET_DEPTH_MASK, enabled );
+}
+
+void CommandBuffer::setBackFaceCulling( const bool enabled ) {
+    setEnabled( CommandType::SET_BACK_FACE_CULLING, enabled );
+}
+
+void CommandBuffer::setScissorTest( const bool enabled ) {
+    setEnabled( CommandType::SET_SCISSOR_TEST, enabled );
+}
+
+void CommandBuffer::setScissorBox( const int x, const int y, const int width, const int height ) {
+    setRect( CommandType::SET_SCISSOR_BOX, x, y, width, height );
+}
+
+void CommandBuffer::setViewport( const int x, const int y, const int width, const int height ) {
+    setRect( CommandType::SET_VIEWPORT, x, y, width, height );
+}
+
+void CommandBuffer::setClearColor( const float r, const float g, const float b, const float a ) {
+    Commands::SetClearColor* command = static_cast< Commands::SetClearColor* >( record( CommandType::SET_CLEAR_COLOR, sizeof( Commands::SetClearColor ) ) );
+    command->rgba[0] = r;
+    command->rgba[1] = g;
+    command->rgba[2] = b;
+    command->rgba[3] = a;
+}
+
+void CommandBuffer::clear() {
+    record( CommandType::CLEAR, 0 );
+}
+
+void CommandBuffer::drawIndexed( const VertexBuffer& vertices, const IndexBuffer& indices ) {
+    drawIndexed( vertices, indices, 0, indices.getCount(), 0 );
+}
+
+void CommandBuffer::drawIndexed( const VertexBuffer& vertices, const IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex ) {
+    drawIndexedInstanced( vertices, indices, first, count, baseVertex, 0, 0 );
+}
+
+/*
+CommandBuffer::drawIndexedInstanced
+-----------------------------------
+
+Description:
+    Records a draw of triangles from a range of the given index buffer.
+    See Graphics::drawIndexedInstanced() for details.
+
+Arguments:
+    vertices:       The vertices to draw.
+    indices:        The indices of the vertices to draw.
+    first:          The first index to draw.
+    count:          The number of indices to draw.
+    baseVertex:     Added to every index before it is used to fetch a vertex.
+    instanceCount:  The number of instances to draw. If this is 0, the draw isn't instanced.
+    baseInstance:   The instance to start fetching per-instance attributes from.
+
+Returns:
+    N/A
+*/
+void CommandBuffer::drawIndexedInstanced( const VertexBuffer& vertices, const IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex,
+                                          const std::size_t instanceCount, const uint baseInstance ) {
+    Commands::DrawIndexed* command = static_cast< Commands::DrawIndexed* >( record( CommandType::DRAW_INDEXED, sizeof( Commands::DrawIndexed ) ) );
+    command->vertices      = vertices.m_impl;
+    command->indices       = indices.m_impl;
+    command->first         = (uint32)first;
+    command->count         = (uint32)count;
+    command->baseVertex    = baseVertex;
+    command->instanceCount = (uint32)instanceCount;
+    command->baseInstance  = baseInstance;
+}
+
+void CommandBuffer::draw( const StreamingBuffer& vertices, const std::size_t first, const std::size_t count ) {
+    Commands::DrawStreaming* command = static_cast< Commands::DrawStreaming* >( record( CommandType::DRAW_STREAMING, sizeof( Commands::DrawStreaming ) ) );
+    command->vertices   = vertices.m_impl;
+    command->indices    = nullptr;
+    command->first      = (uint32)first;
+    command->count      = (uint32)count;
+    command->baseVertex = 0;
+}
+
+void CommandBuffer::drawIndexed( const StreamingBuffer& vertices, const IndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex ) {
+    Commands::DrawStreaming* command = static_cast< Commands::DrawStreaming* >( record( CommandType::DRAW_STREAMING, sizeof( Commands::DrawStreaming ) ) );
+    command->vertices   = vertices.m_impl;
+    command->indices    = indices.m_impl;
+    command->first      = (uint32)first;
+    command->count      = (uint32)count;
+    command->baseVertex = baseVertex;
+}
+
+//Returns the number of packets that have been started, including the current one
+std::size_t CommandBuffer::getPacketCount() const {
+    return m_packets.size();
+}
+
+const CommandPacket& CommandBuffer::getPacket( const std::size_t index ) const {
+#ifdef BS_CHECK_INDEX
+    if( index >= m_packets.size() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    return m_packets[ index ];
+}
+
+std::size_t CommandBuffer::getCommandCount() const {
+    return m_commandCount;
+}
+
+//Returns the number of bytes of commands that have been recorded
+std::size_t CommandBuffer::getSize() const {
+    return m_size;
+}
+
+//Returns the number of bytes the buffer can hold across all of its blocks
+std::size_t CommandBuffer::getCapacity() const {
+    std::size_t capacity = 0;
+    for( const Block& block : m_blocks )
+        capacity += block.size;
+    return capacity;
+}
+
+/*
+CommandBuffer::record
+---------------------
+
+Description:
+    Adds a command to the current packet.
+
+Arguments:
+    type:           The type of command.
+    dataSize:       The size of the command's data, in bytes.
+
+Returns:
+    void*:          Where the command's data should be written.
+
+Throws:
+    SizeException:  If the command is too large to record.
+*/
+void* CommandBuffer::record( const CommandType type, const std::size_t dataSize ) {
+    const std::size_t size = ( sizeof( CommandHeader ) + dataSize + COMMAND_ALIGNMENT - 1 ) & ~( COMMAND_ALIGNMENT - 1 );
+    if( size > std::numeric_limits< uint16 >::max() )
+        throw SizeException();
+
+    if( m_packets.empty() )
+        begin( 0 );
+
+    ubyte* const command = allocate( size );
+
+    CommandPacket& packet = m_packets.back();
+    if( packet.size == 0 )
+        packet.data = command;
+    packet.size += (uint32)size;
+
+    ++m_commandCount;
+    m_size += size;
+
+    new( command ) CommandHeader { type, (uint16)size };
+    return command + sizeof( CommandHeader );
+}
+
+/*
+CommandBuffer::allocate
+-----------------------
+
+Description:
+    Allocates memory for a command at the end of the current packet.
+    A packet's commands are always kept contiguous: if the current block doesn't have room for the command,
+    the commands recorded so far in the current packet are copied to the start of the next block.
+
+Arguments:
+    size:    The size of the command, in bytes. This must be a multiple of COMMAND_ALIGNMENT.
+
+Returns:
+    ubyte*:  The memory for the command.
+*/
+ubyte* CommandBuffer::allocate( const std::size_t size ) {
+    if( !m_blocks.empty() && m_used + size <= m_blocks[ m_block ].size ) {
+        ubyte* const command = m_blocks[ m_block ].data.get() + m_used;
+        m_used += size;
+        return command;
+    }
+
+    CommandPacket&    packet = m_packets.back();
+    const std::size_t needed = packet.size + size;
+
+    //Use the next block if there is one and it's big enough, otherwise make one
+    const std::size_t next = m_blocks.empty() ? 0 : m_block + 1;
+    if( next == m_blocks.size() )
+        m_blocks.push_back( Block() );
+
+    Block& block = m_blocks[ next ];
+    if( block.size < needed ) {
+        block.size = std::max( m_blockSize, needed );
+        block.data.reset( new ubyte[ block.size ] );
+    }
+
+    if( packet.size != 0 ) {
+        std::memcpy( block.data.get(), packet.data, packet.size );
+        packet.data = block.data.get();
+    }
+
+    m_block = next;
+    m_used  = needed;
+    return block.data.get() + packet.size;
+}
+
+/*
+CommandBuffer::setUniform
+-------------------------
+
+Description:
+    Records a SET_UNIFORM command. The uniform's name is copied into the command.
+
+Arguments:
+    name:        The name of the uniform.
+    type:        The type of the uniform.
+    values:      The uniform's components.
+    valuesSize:  The size of the uniform's components, in bytes.
+
+Returns:
+    N/A
+*/
+void CommandBuffer::setUniform( const char* const name, const UniformType type, const void* const values, const std::size_t valuesSize ) {
+    const std::size_t nameSize = std::strlen( name ) + 1;
+
+    Commands::SetUniform* command = static_cast< Commands::SetUniform* >( record( CommandType::SET_UNIFORM, sizeof( Commands::SetUniform ) + nameSize ) );
+    command->type = type;
+    std::memcpy( command->u, values, valuesSize );
+    std::memcpy( command + 1, name, nameSize );
+}
+
+void CommandBuffer::setEnabled( const CommandType type, const bool enabled ) {
+    Commands::SetEnabled* command = static_cast< Commands::SetEnabled* >( record( type, sizeof( Commands::SetEnabled ) ) );
+    command->enabled = enabled;
+}
+
+void CommandBuffer::setRect( const CommandType type, const int x, const int y, const int width, const int height ) {
+    Commands::SetRect* command = static_cast< Commands::SetRect* >( record( type, sizeof( Commands::SetRect ) ) );
+    command->x      = x;
+    command->y      = y;
+    command->width  = width;
+    command->height = height;
+}
+
+/*
+makeSortKey
+-----------
+
+Description:
+    Builds a sort key for a packet of commands. Packets are sorted by pass first, then by program,
+    then by material, and finally by depth, so within a pass, draws that share a program and material end up together.
+
+Arguments:
+    pass:      The pass the packet is drawn in (e.g. opaque geometry, then transparent geometry, then UI).
+    program:   An identifier for the program the packet uses.
+    material:  An identifier for the textures and other settings the packet uses.
+    depth:     The depth of what the packet draws, from 0 to 1. Values outside of this range are clamped.
+               To draw back to front, pass 1 - depth instead.
+
+Returns:
+    uint64:    The sort key.
+*/
+uint64 makeSortKey( const uint8 pass, const uint16 program, const uint16 material, const float depth ) {
+    constexpr uint64 DEPTH_MAX = ( (uint64)1 << SORT_KEY_DEPTH_BITS ) - 1;
+
+    const float  clamped        = depth < 0.0f ? 0.0f : ( depth > 1.0f ? 1.0f : depth );
+    const uint64 quantizedDepth = (uint64)( (double)clamped * DEPTH_MAX + 0.5 );
+
+    return ( (uint64)pass     << ( SORT_KEY_PROGRAM_BITS + SORT_KEY_MATERIAL_BITS + SORT_KEY_DEPTH_BITS ) ) |
+           ( (uint64)program  << ( SORT_KEY_MATERIAL_BITS + SORT_KEY_DEPTH_BITS ) ) |
+           ( (uint64)material << SORT_KEY_DEPTH_BITS ) |
+           quantizedDepth;
+}
+
+/*
+sortCommandPackets
+------------------
+
+Description:
+    Gathers the packets of the given command buffers and sorts them by their keys.
+    Packets with equal keys are kept in the order they appear in buffers. Empty packets are left out.
+
+Arguments:
+    buffers:     The command buffers.
+    count:       The number of command buffers.
+    packetsOut:  Receives the sorted packets. Its previous contents are discarded.
+
+Returns:
+    N/A
+*/
+void sortCommandPackets( const CommandBuffer* const* buffers, const std::size_t count, std::vector< CommandPacket >& packetsOut ) {
+    packetsOut.clear();
+    for( std::size_t i = 0; i < count; ++i ) {
+        const CommandBuffer& buffer = *buffers[i];
+        for( std::size_t j = 0; j < buffer.getPacketCount(); ++j )
+            if( buffer.getPacket( j ).size != 0 )
+                packetsOut.push_back( buffer.getPacket( j ) );
+    }
+
+    std::stable_sort( packetsOut.begin(), packetsOut.end(), []( const CommandPacket& a, const CommandPacket& b ) {
+        return a.key < b.key;
+    } );
+}
+
+
+
+
+} //namespace Brimstone
@@ -0,0 +1,487 @@
+/*
+graphics/GpuProfiler.cpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See GpuProfiler.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/GpuProfiler.hpp>  //Header
+
+#include "GraphicsImpl.hpp"                    //Brimstone::Private::GpuProfilerImpl
+
+#include <brimstone/Exception.hpp>             //Brimstone::GraphicsException, Brimstone::IException, Brimstone::uncaughtException
+
+#include <boost/format.hpp>                    //boost::format
+
+#include <algorithm>                           //std::max, std::min
+#include <chrono>                              //std::chrono::duration_cast, std::chrono::nanoseconds
+#include <string>                              //std::string
+#include <utility>                             //std::move
+
+
+
+
+namespace {
+
+
+
+
+//Functions
+//Returns the current time on the CPU's clock in nanoseconds since its epoch
+Brimstone::int64 getCpuTime() {
+    using Clock = Brimstone::GpuProfiler::Clock;
+    return std::chrono::duration_cast< std::chrono::nanoseconds >( Clock::now().time_since_epoch() ).count();
+}
+
+Brimstone::GraphicsStats subtract( const Brimstone::GraphicsStats& a, const Brimstone::GraphicsStats& b ) {
+    Brimstone::GraphicsStats result;
+    result.drawCalls    = a.drawCalls    - b.drawCalls;
+    result.instances    = a.instances    - b.instances;
+    result.triangles    = a.triangles    - b.triangles;
+    result.stateChanges = a.stateChanges - b.stateChanges;
+    result.clears       = a.clears       - b.clears;
+    return result;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+struct GpuProfiler::Frame {
+    //True once the frame has ended, until its results are read or it's dropped
+    bool                pending;
+
+    int64               cpuStart;
+    GraphicsStats       statsStart;
+
+    //Indices of the timestamps written at the beginning and end of the frame and each of its scopes
+    std::size_t         beginTimestamp;
+    std::size_t         endTimestamp;
+    struct Timestamps {
+        std::size_t     begin;
+        std::size_t     end;
+    };
+    std::vector< Timestamps > scopeTimestamps;
+
+    GpuProfilerFrame    result;
+};
+
+
+
+
+GpuProfiler::GpuProfiler() :
+    m_graphics( nullptr ),
+    m_current( nullptr ),
+    m_frameIndex( 0 ),
+    m_gpuToCpu( 0 ),
+    m_hasLatest( false ),
+    m_latest(),
+    m_droppedFrames( 0 ) {
+}
+
+GpuProfiler::~GpuProfiler() {
+    destroy();
+}
+
+/*
+GpuProfiler::init
+-----------------
+
+Description:
+    Prepares the profiler to profile frames rendered with the given Graphics, whose context must be current.
+
+Arguments:
+    graphics:           The Graphics that frames are rendered with.
+    frameLatency:       The number of frames that can wait on results from the GPU at once (at least 1).
+                        Two or three is enough to never stall on most drivers.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the queries couldn't be created.
+*/
+void GpuProfiler::init( Graphics& graphics, const std::size_t frameLatency ) {
+    destroy();
+
+    m_graphics = &graphics;
+    m_impl.reset( new Private::GpuProfilerImpl() );
+    m_impl->create( std::max< std::size_t >( frameLatency, 1 ) );
+
+    m_frames.resize( std::max< std::size_t >( frameLatency, 1 ) );
+    for( Frame& frame : m_frames )
+        frame.pending = false;
+
+    calibrate();
+}
+
+void GpuProfiler::destroy() {
+    m_impl.reset();
+    m_frames.clear();
+    m_openScopes.clear();
+    m_graphics      = nullptr;
+    m_current       = nullptr;
+    m_frameIndex    = 0;
+    m_hasLatest     = false;
+    m_droppedFrames = 0;
+}
+
+/*
+GpuProfiler::calibrate
+----------------------
+
+Description:
+    Measures the offset between the GPU's clock and the CPU's, which is used to place GPU times on the CPU's timeline.
+    init() calls this; call it again if the two clocks appear to have drifted apart.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the profiler hasn't been initialized, or the GPU's time couldn't be read.
+*/
+void GpuProfiler::calibrate() {
+    if( m_impl == nullptr )
+        throw GraphicsException( "The profiler hasn't been initialized." );
+    if( !m_impl->isTimerSupported() )
+        return;
+
+    //Reading the GPU's time takes a moment, so the midpoint of the CPU times around it is used
+    const int64 before = getCpuTime();
+    const int64 gpu    = (int64)m_impl->getTime();
+    const int64 after  = getCpuTime();
+    m_gpuToCpu = before + ( after - before ) / 2 - gpu;
+}
+
+/*
+GpuProfiler::beginFrame
+-----------------------
+
+Description:
+    Begins profiling a new frame.
+    Results from earlier frames that have become available are read first.
+    If the frame that last used this frame's slot in the ring still hasn't received its results, it's dropped.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the profiler hasn't been initialized, a frame is already being profiled, or a query failed.
+*/
+void GpuProfiler::beginFrame() {
+    if( m_impl == nullptr )
+        throw GraphicsException( "The profiler hasn't been initialized." );
+    if( m_current != nullptr )
+        throw GraphicsException( "beginFrame() was called before the last frame ended." );
+
+    update();
+
+    const std::size_t slot  = m_frameIndex % m_frames.size();
+    Frame&            frame = m_frames[ slot ];
+    if( frame.pending ) {
+        frame.pending = false;
+        ++m_droppedFrames;
+    }
+
+    frame.cpuStart   = getCpuTime();
+    frame.statsStart = m_graphics->getStats();
+    frame.scopeTimestamps.clear();
+    frame.result.index = m_frameIndex;
+    frame.result.scopes.clear();
+
+    m_impl->begin( slot );
+    frame.beginTimestamp = m_impl->writeTimestamp();
+    m_current = &frame;
+}
+
+/*
+GpuProfiler::endFrame
+---------------------
+
+Description:
+    Ends the frame being profiled. Its results will be available once the GPU has finished it.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If no frame is being profiled, a scope is still open, or a query failed.
+*/
+void GpuProfiler::endFrame() {
+    if( m_current == nullptr )
+        throw GraphicsException( "endFrame() was called without beginFrame()." );
+    if( !m_openScopes.empty() )
+        throw GraphicsException( "endFrame() was called before every scope ended." );
+
+    Frame& frame = *m_current;
+    frame.endTimestamp = m_impl->writeTimestamp();
+    m_impl->end();
+
+    frame.result.cpuStart        = frame.cpuStart / 1000000.0;
+    frame.result.cpuMilliseconds = ( getCpuTime() - frame.cpuStart ) / 1000000.0;
+    frame.result.stats           = subtract( m_graphics->getStats(), frame.statsStart );
+    frame.pending = true;
+
+    m_current = nullptr;
+    ++m_frameIndex;
+    update();
+}
+
+/*
+GpuProfiler::beginScope
+-----------------------
+
+Description:
+    Begins timing a pass of the current frame. Scopes begun before this one ends are nested in it.
+
+Arguments:
+    name:               The name of the pass. This pointer is kept rather than the string being copied,
+                        so it must stay valid until the frame's results have been read; a string literal is best.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If no frame is being profiled, or the query failed.
+*/
+void GpuProfiler::beginScope( const char* const name ) {
+    if( m_current == nullptr )
+        throw GraphicsException( "beginScope() was called outside of a frame." );
+
+    Frame& frame = *m_current;
+    GpuProfilerScope scope;
+    scope.name     = name;
+    scope.depth    = (uint32)m_openScopes.size();
+    scope.cpuBegin = ( getCpuTime() - frame.cpuStart ) / 1000000.0;
+    scope.cpuEnd   = scope.cpuBegin;
+    scope.gpuBegin = 0.0;
+    scope.gpuEnd   = 0.0;
+
+    m_openScopes.push_back( frame.result.scopes.size() );
+    frame.result.scopes.push_back( scope );
+    frame.scopeTimestamps.push_back( { m_impl->writeTimestamp(), 0 } );
+}
+
+void GpuProfiler::endScope() {
+    if( m_current == nullptr || m_openScopes.empty() )
+        throw GraphicsException( "endScope() was called without beginScope()." );
+
+    Frame&            frame = *m_current;
+    const std::size_t index = m_openScopes.back();
+    m_openScopes.pop_back();
+
+    frame.scopeTimestamps[ index ].end = m_impl->writeTimestamp();
+    frame.result.scopes[ index ].cpuEnd = ( getCpuTime() - frame.cpuStart ) / 1000000.0;
+}
+
+/*
+GpuProfiler::update
+-------------------
+
+Description:
+    Reads the results of every frame the GPU has finished, without waiting for any that it hasn't.
+    beginFrame() and endFrame() call this, but it can be called at any time, e.g. after Graphics::finish().
+    The callback, if one is set, is called for each frame that's read, oldest first.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the results couldn't be read.
+*/
+void GpuProfiler::update() {
+    if( m_impl == nullptr )
+        return;
+
+    //Frames finish in the order they were submitted, so stop at the first that hasn't
+    const uint64 count = std::min< uint64 >( m_frameIndex, m_frames.size() );
+    for( uint64 index = m_frameIndex - count; index < m_frameIndex; ++index ) {
+        const std::size_t slot  = index % m_frames.size();
+        Frame&            frame = m_frames[ slot ];
+        if( !frame.pending || frame.result.index != index )
+            continue;
+        if( !m_impl->isAvailable( slot ) )
+            break;
+        resolve( frame );
+    }
+}
+
+void GpuProfiler::setCallback( Callback callback ) {
+    m_callback = std::move( callback );
+}
+
+/*
+GpuProfiler::getLatestFrame
+---------------------------
+
+Description:
+    Returns the results of the most recent frame whose results have been read.
+
+Arguments:
+    N/A
+
+Returns:
+    const GpuProfilerFrame*:  The frame's results, or nullptr if no frame's results have been read yet.
+                              The results are overwritten when the next frame's are read.
+*/
+const GpuProfilerFrame* GpuProfiler::getLatestFrame() const {
+    return m_hasLatest ? &m_latest : nullptr;
+}
+
+/*
+GpuProfiler::getReport
+----------------------
+
+Description:
+    Formats the results of the latest frame as text, e.g. for logging:
+        Frame 120: CPU 2.31 ms, GPU 1.87 ms
+            Draws: 412, instances: 3290, triangles: 181024, state changes: 96, clears: 2
+            Pipeline: 543072 vertices, 181024 primitives, 402310 VS invocations, 2104512 FS invocations
+            Scene                     CPU   1.20 ms  GPU   1.41 ms
+              Shadows                 CPU   0.35 ms  GPU   0.52 ms
+
+Arguments:
+    N/A
+
+Returns:
+    ustring:  The report.
+*/
+ustring GpuProfiler::getReport() const {
+    if( !m_hasLatest )
+        return "No frames have been profiled yet.";
+
+    const GpuProfilerFrame& frame = m_latest;
+    std::string report = (
+        boost::format( "Frame %d: CPU %.2f ms, GPU %.2f ms\n" ) %
+        frame.index %
+        frame.cpuMilliseconds %
+        frame.gpuMilliseconds
+    ).str();
+
+    report += (
+        boost::format( "    Draws: %d, instances: %d, triangles: %d, state changes: %d, clears: %d\n" ) %
+        frame.stats.drawCalls %
+        frame.stats.instances %
+        frame.stats.triangles %
+        frame.stats.stateChanges %
+        frame.stats.clears
+    ).str();
+
+    if( frame.hasPipelineStatistics ) {
+        report += (
+            boost::format( "    Pipeline: %d vertices, %d primitives, %d VS invocations, %d FS invocations\n" ) %
+            frame.pipelineStatistics.verticesSubmitted %
+            frame.pipelineStatistics.primitivesSubmitted %
+            frame.pipelineStatistics.vertexShaderInvocations %
+            frame.pipelineStatistics.fragmentShaderInvocations
+        ).str();
+    }
+
+    for( const GpuProfilerScope& scope : frame.scopes ) {
+        const std::string name = std::string( 2 * scope.depth, ' ' ) + scope.name;
+        report += (
+            boost::format( "    %-24s CPU %6.2f ms  GPU %6.2f ms\n" ) %
+            name %
+            ( scope.cpuEnd - scope.cpuBegin ) %
+            ( scope.gpuEnd - scope.gpuBegin )
+        ).str();
+    }
+    return report;
+}
+
+bool GpuProfiler::isTimerSupported() const {
+    return m_impl != nullptr && m_impl->isTimerSupported();
+}
+
+bool GpuProfiler::isPipelineStatisticsSupported() const {
+    return m_impl != nullptr && m_impl->isPipelineStatisticsSupported();
+}
+
+std::size_t GpuProfiler::getFrameLatency() const {
+    return m_frames.size();
+}
+
+uint64 GpuProfiler::getDroppedFrameCount() const {
+    return m_droppedFrames;
+}
+
+void GpuProfiler::resolve( Frame& frame ) {
+    const std::size_t slot = frame.result.index % m_frames.size();
+    GpuProfilerFrame& result = frame.result;
+
+    if( m_impl->isTimerSupported() ) {
+        m_timestamps.resize( m_impl->getTimestampCount( slot ) );
+        m_impl->getTimestamps( slot, m_timestamps.data() );
+
+        result.gpuBegin = toFrameTime( frame, m_timestamps[ frame.beginTimestamp ] );
+        result.gpuEnd   = toFrameTime( frame, m_timestamps[ frame.endTimestamp ] );
+        for( std::size_t i = 0; i < result.scopes.size(); ++i ) {
+            result.scopes[i].gpuBegin = toFrameTime( frame, m_timestamps[ frame.scopeTimestamps[i].begin ] );
+            result.scopes[i].gpuEnd   = toFrameTime( frame, m_timestamps[ frame.scopeTimestamps[i].end ] );
+        }
+    } else {
+        result.gpuBegin = 0.0;
+        result.gpuEnd   = 0.0;
+    }
+    result.gpuMilliseconds = result.gpuEnd - result.gpuBegin;
+
+    result.hasPipelineStatistics = m_impl->isPipelineStatisticsSupported();
+    result.pipelineStatistics    = GpuPipelineStatistics();
+    m_impl->getPipelineStatistics( slot, result.pipelineStatistics );
+
+    frame.pending = false;
+    m_latest    = result;
+    m_hasLatest = true;
+    if( m_callback )
+        m_callback( m_latest );
+}
+
+//Converts a GPU timestamp to milliseconds since the given frame began on the CPU
+double GpuProfiler::toFrameTime( const Frame& frame, const uint64 gpuTime ) const {
+    return ( (int64)gpuTime + m_gpuToCpu - frame.cpuStart ) / 1000000.0;
+}
+
+
+
+
+GpuScope::GpuScope( GpuProfiler& profiler, const char* const name ) :
+    m_profiler( profiler ) {
+    m_profiler.beginScope( name );
+}
+
+GpuScope::~GpuScope() {
+    try                           { m_profiler.endScope();   }
+    catch( const IException& ex ) { uncaughtException( ex ); }
+}
+
+
+
+
+} //namespace Brimstone
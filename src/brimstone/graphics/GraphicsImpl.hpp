@@ -24,15 +24,25 @@ Description:
 #include "../direct3d/D3DShader.hpp"
 #include "../direct3d/D3DProgram.hpp"
 #include "../direct3d/D3DVertexBuffer.hpp"
+#include "../direct3d/D3DIndexBuffer.hpp"
+#include "../direct3d/D3DStreamingBuffer.hpp"
+#include "../direct3d/D3DDrawIndirectBuffer.hpp"
 #include "../direct3d/D3DTexture.hpp"
 #include "../direct3d/D3DSampler.hpp"
+#include "../direct3d/D3DFramebuffer.hpp"
+#include "../direct3d/D3DGpuProfiler.hpp"
 #elif defined( BS_BUILD_OPENGL )
 #include "../opengl/GLGraphicsImpl.hpp"
 #include "../opengl/GLShader.hpp"
 #include "../opengl/GLProgram.hpp"
 #include "../opengl/GLVertexBuffer.hpp"
+#include "../opengl/GLIndexBuffer.hpp"
+#include "../opengl/GLStreamingBuffer.hpp"
+#include "../opengl/GLDrawIndirectBuffer.hpp"
 #include "../opengl/GLTexture.hpp"
 #include "../opengl/GLSampler.hpp"
+#include "../opengl/GLFramebuffer.hpp"
+#include "../opengl/GLGpuProfiler.hpp"
 #endif
 
 
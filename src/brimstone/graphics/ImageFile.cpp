@@ -0,0 +1,361 @@
+/*
+graphics/ImageFile.cpp
+----------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See ImageFile.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/ImageFile.hpp>    //Header
+#include <brimstone/graphics/TextureData.hpp>  //Brimstone::TextureData, Brimstone::getTextureDataSize, Brimstone::getMipLevelCount, ...
+#include <brimstone/util/LZ4.hpp>              //Brimstone::compressLZ4, Brimstone::decompressLZ4
+#include <brimstone/Exception.hpp>             //Brimstone::BoundsException
+
+#include <bit>                                 //std::endian
+#include <cstdio>                              //FILE, std::fopen, std::fwrite, std::fclose, std::remove
+#include <cstring>                             //std::memcpy, std::memcmp
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ubyte;
+using ::Brimstone::uint32;
+using ::Brimstone::uint64;
+
+struct ImageFileHeader {
+    ubyte  identifier[8];
+    uint32 version;
+    uint32 format;        //TextureFormat
+    uint32 width;
+    uint32 height;
+    uint32 levelCount;
+    uint32 compression;   //ImageCompression
+    uint32 alignment;     //IMAGE_FILE_ALIGNMENT when the file was written
+    uint32 reserved[3];
+};
+
+//An entry in the level table
+struct ImageFileLevel {
+    uint64 offset;        //From the start of the file
+    uint64 size;          //Stored size; the level is compressed if this is less than its decoded size
+};
+
+
+
+
+//Constants
+//Same structure as the PNG signature: a non-ASCII byte, the name, and line endings that catch broken file transfers
+constexpr ubyte IMAGE_FILE_IDENTIFIER[8] = { 0x89, 'B', 'S', 'I', '\r', '\n', 0x1A, '\n' };
+
+constexpr uint32 IMAGE_FILE_VERSION = 1;
+
+//Number of formats in TextureFormat
+constexpr uint32 IMAGE_FILE_FORMAT_COUNT = (uint32)::Brimstone::TextureFormat::ETC2_RGBA8 + 1;
+
+//Largest texture (in either dimension) a .bsi file is allowed to describe; anything larger is assumed to be corrupt
+constexpr uint32 IMAGE_FILE_MAX_SIZE = 1 << 15;
+
+static_assert( sizeof( ImageFileHeader ) == 48 && sizeof( ImageFileLevel ) == 16, "The layout of .bsi files must not depend on the compiler." );
+static_assert( std::endian::native == std::endian::little, ".bsi files are read and written in native byte order, which must be little-endian." );
+
+
+
+
+//Functions
+std::size_t alignUp( const std::size_t value ) {
+    return ( value + ::Brimstone::IMAGE_FILE_ALIGNMENT - 1 ) & ~( ::Brimstone::IMAGE_FILE_ALIGNMENT - 1 );
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+/*
+ImageFile::save
+---------------
+
+Description:
+    Writes every level of a TextureData to a .bsi file.
+
+Arguments:
+    filename:      The path to the file to write. If it already exists, it's overwritten.
+    data:          The texture to write.
+    compression:   How to store the levels.
+
+Returns:
+    bool:          true if the file was written, false if data is empty or the file couldn't be written.
+                   If writing fails partway through, the incomplete file is removed.
+*/
+bool ImageFile::save( const ustring& filename, const TextureData& data, const ImageCompression compression ) {
+    if( !data.isValid() )
+        return false;
+
+    const std::size_t levelCount = data.getLevelCount();
+
+    //Compress every level up front so the level table can be written before them
+    std::vector< std::vector< ubyte > > compressed( levelCount );
+    std::vector< ImageFileLevel >       levels( levelCount );
+    std::size_t offset = alignUp( sizeof( ImageFileHeader ) + levelCount * sizeof( ImageFileLevel ) );
+    for( std::size_t level = 0; level < levelCount; ++level ) {
+        const std::size_t levelSize = data.getLevelSize( level );
+        std::size_t       size      = levelSize;
+        if( compression == ImageCompression::LZ4 && levelSize > 0 ) {
+            //Anything that doesn't fit in less than the level itself isn't worth decompressing
+            compressed[ level ].resize( levelSize - 1 );
+            const std::size_t compressedSize = compressLZ4( data.getLevel( level ), levelSize, compressed[ level ].data(), levelSize - 1 );
+            if( compressedSize != 0 )
+                size = compressedSize;
+            compressed[ level ].resize( compressedSize );
+        }
+        levels[ level ] = ImageFileLevel { offset, size };
+        offset = alignUp( offset + size );
+    }
+
+    ImageFileHeader header {};
+    std::memcpy( header.identifier, IMAGE_FILE_IDENTIFIER, sizeof( IMAGE_FILE_IDENTIFIER ) );
+    header.version     = IMAGE_FILE_VERSION;
+    header.format      = (uint32)data.getFormat();
+    header.width       = (uint32)data.getWidth();
+    header.height      = (uint32)data.getHeight();
+    header.levelCount  = (uint32)levelCount;
+    header.compression = (uint32)compression;
+    header.alignment   = (uint32)IMAGE_FILE_ALIGNMENT;
+
+    FILE* file = std::fopen( filename.c_str(), "wb" );
+    if( file == nullptr )
+        return false;
+
+    const ubyte padding[ IMAGE_FILE_ALIGNMENT ] = {};
+    std::size_t written = sizeof( header ) + levels.size() * sizeof( ImageFileLevel );
+    bool ok = std::fwrite( &header, sizeof( header ), 1, file ) == 1 &&
+              std::fwrite( levels.data(), sizeof( ImageFileLevel ), levels.size(), file ) == levels.size();
+    for( std::size_t level = 0; ok && level < levelCount; ++level ) {
+        const std::size_t pad = levels[ level ].offset - written;
+        const void* const src = compressed[ level ].empty() ? (const void*)data.getLevel( level ) : compressed[ level ].data();
+        ok = std::fwrite( padding, 1, pad, file ) == pad &&
+             std::fwrite( src, 1, levels[ level ].size, file ) == levels[ level ].size;
+        written = levels[ level ].offset + levels[ level ].size;
+    }
+    ok = ( std::fclose( file ) == 0 ) && ok;
+
+    if( !ok )
+        std::remove( filename.c_str() );
+    return ok;
+}
+
+ImageFile::ImageFile() :
+    m_data( nullptr ),
+    m_size( 0 ),
+    m_format( TextureFormat::RGBA8 ),
+    m_width( 0 ),
+    m_height( 0 ),
+    m_compression( ImageCompression::NONE ) {
+}
+
+/*
+ImageFile::open{1}
+------------------
+
+Description:
+    Maps a .bsi file into memory and reads its header, closing the file that was open before (if any).
+    The levels aren't read until they're used.
+
+Arguments:
+    filename:  The path to the file to open.
+
+Returns:
+    bool:      true if the file was opened, false if it couldn't be mapped or isn't a valid .bsi file.
+*/
+bool ImageFile::open( const ustring& filename ) {
+    close();
+    if( !m_file.open( filename ) )
+        return false;
+
+    m_data = m_file.getData();
+    m_size = m_file.getSize();
+    return parse();
+}
+
+/*
+ImageFile::open{2}
+------------------
+
+Description:
+    Reads the header of a .bsi file that's already in memory (e.g. an entry in a pack file),
+    closing the file that was open before (if any).
+
+Arguments:
+    data:      The contents of the file. This must stay valid until the ImageFile is closed.
+               Levels are only aligned in memory if data is aligned to IMAGE_FILE_ALIGNMENT.
+    size:      The size of the file, in bytes.
+
+Returns:
+    bool:      true if the file was opened, false if it isn't a valid .bsi file.
+*/
+bool ImageFile::open( const void* const data, const std::size_t size ) {
+    close();
+
+    m_data = static_cast< const ubyte* >( data );
+    m_size = size;
+    return parse();
+}
+
+void ImageFile::close() {
+    m_file.close();
+    m_data        = nullptr;
+    m_size        = 0;
+    m_format      = TextureFormat::RGBA8;
+    m_width       = 0;
+    m_height      = 0;
+    m_compression = ImageCompression::NONE;
+    m_levels.clear();
+}
+
+bool ImageFile::isOpen() const {
+    return m_width > 0;
+}
+
+TextureFormat ImageFile::getFormat() const {
+    return m_format;
+}
+
+int32 ImageFile::getWidth() const {
+    return m_width;
+}
+
+int32 ImageFile::getHeight() const {
+    return m_height;
+}
+
+std::size_t ImageFile::getLevelCount() const {
+    return m_levels.size();
+}
+
+ImageCompression ImageFile::getCompression() const {
+    return m_compression;
+}
+
+//Returns true if the given level is stored compressed, and has to be decoded with decodeLevel() before it can be used
+bool ImageFile::isLevelCompressed( const std::size_t level ) const {
+    return getStoredLevelSize( level ) < getLevelSize( level );
+}
+
+//Returns the given level as it's stored in the file; if it isn't compressed, these are its texels
+const ubyte* ImageFile::getLevel( const std::size_t level ) const {
+#ifdef BS_CHECK_INDEX
+    if( level >= m_levels.size() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    return m_data + m_levels[ level ].offset;
+}
+
+std::size_t ImageFile::getStoredLevelSize( const std::size_t level ) const {
+#ifdef BS_CHECK_INDEX
+    if( level >= m_levels.size() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    return (std::size_t)m_levels[ level ].size;
+}
+
+//Returns the size of the given level once it's been decoded
+std::size_t ImageFile::getLevelSize( const std::size_t level ) const {
+#ifdef BS_CHECK_INDEX
+    if( level >= m_levels.size() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    return getTextureDataSize( m_format, getMipDimension( m_width, level ), getMipDimension( m_height, level ) );
+}
+
+/*
+ImageFile::decodeLevel
+----------------------
+
+Description:
+    Copies the texels of the given level to the given destination, decompressing them if necessary.
+
+Arguments:
+    level:         The level to decode.
+    destination:   Where to write the texels; must have room for getLevelSize( level ) bytes.
+
+Returns:
+    bool:          true if the level was decoded, false if its compressed data is corrupt.
+
+Throws:
+    BoundsException:   If level is out of bounds (only checked if BS_CHECK_INDEX is defined).
+*/
+bool ImageFile::decodeLevel( const std::size_t level, void* const destination ) const {
+    const std::size_t storedSize = getStoredLevelSize( level );
+    const std::size_t levelSize  = getLevelSize( level );
+    if( storedSize < levelSize )
+        return decompressLZ4( getLevel( level ), storedSize, destination, levelSize );
+
+    std::memcpy( destination, getLevel( level ), levelSize );
+    return true;
+}
+
+//Validates the header and level table of the file in m_data. If anything is wrong, the file is closed.
+bool ImageFile::parse() {
+    ImageFileHeader header;
+    bool ok = m_size >= sizeof( header );
+    if( ok ) {
+        std::memcpy( &header, m_data, sizeof( header ) );
+        ok = std::memcmp( header.identifier, IMAGE_FILE_IDENTIFIER, sizeof( IMAGE_FILE_IDENTIFIER ) ) == 0 &&
+             header.version == IMAGE_FILE_VERSION && header.format < IMAGE_FILE_FORMAT_COUNT &&
+             header.width  > 0 && header.width  <= IMAGE_FILE_MAX_SIZE &&
+             header.height > 0 && header.height <= IMAGE_FILE_MAX_SIZE &&
+             header.levelCount > 0 && header.levelCount <= getMipLevelCount( header.width, header.height ) &&
+             header.compression <= (uint32)ImageCompression::LZ4 &&
+             m_size >= sizeof( header ) + header.levelCount * sizeof( ImageFileLevel );
+    }
+
+    if( ok ) {
+        m_format      = (TextureFormat)header.format;
+        m_width       = (int32)header.width;
+        m_height      = (int32)header.height;
+        m_compression = (ImageCompression)header.compression;
+        m_levels.resize( header.levelCount );
+        std::memcpy( m_levels.data(), m_data + sizeof( header ), m_levels.size() * sizeof( ImageFileLevel ) );
+
+        //Levels must be stored after the level table, and must fit in the file.
+        //Uncompressed files (and levels) must store exactly as many bytes as the level decodes to.
+        const uint64 tableEnd = sizeof( header ) + m_levels.size() * sizeof( ImageFileLevel );
+        for( std::size_t level = 0; ok && level < m_levels.size(); ++level ) {
+            const Level&      entry     = m_levels[ level ];
+            const std::size_t levelSize = getLevelSize( level );
+            ok = entry.offset >= tableEnd && entry.offset <= m_size && entry.size <= m_size - entry.offset &&
+                 ( entry.size == levelSize || ( m_compression == ImageCompression::LZ4 && entry.size < levelSize ) );
+        }
+    }
+
+    if( !ok )
+        close();
+    return ok;
+}
+
+
+
+
+} //namespace Brimstone
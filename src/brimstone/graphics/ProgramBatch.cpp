@@ -0,0 +1,417 @@
+/*
+graphics/ProgramBatch.cpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See ProgramBatch.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/ProgramBatch.hpp>  //Header
+
+#include <brimstone/Exception.hpp>              //Brimstone::GraphicsException, Brimstone::BoundsException
+
+#include <utility>                              //std::move, std::pair
+
+
+
+
+namespace Brimstone {
+
+
+
+
+struct ProgramBatch::Entry {
+    ProgramSource       source;     //Released once the program has been submitted
+    ProgramBatchState   state;
+
+    Shader              vertex;
+    Shader              geometry;
+    Shader              fragment;
+    bool                hasGeometry;
+    Program             program;
+
+    //If the program is being built from source, the key to cache its binary under
+    bool                cacheable;
+    uint64              key;
+
+    ustring             error;
+};
+
+
+
+
+ProgramBatch::ProgramBatch() :
+    m_graphics( nullptr ),
+    m_cache( nullptr ),
+    m_submitted( 0 ),
+    m_pending( 0 ),
+    m_failed( 0 ),
+    m_elapsedMilliseconds( 0.0 ) {
+}
+
+ProgramBatch::~ProgramBatch() {
+    clear();
+}
+
+/*
+ProgramBatch::init
+------------------
+
+Description:
+    Sets the Graphics to build programs with, and optionally a cache to load and save their binaries with.
+
+Arguments:
+    graphics:  The Graphics to create programs with.
+    cache:     If this isn't nullptr, programs are loaded from this cache when possible,
+               and programs built from source have their binaries saved to it. It must outlive the batch's use of it.
+
+Returns:
+    N/A
+*/
+void ProgramBatch::init( Graphics& graphics, ProgramCache* const cache ) {
+    clear();
+    m_graphics = &graphics;
+    m_cache    = cache;
+}
+
+/*
+ProgramBatch::clear
+-------------------
+
+Description:
+    Removes every program from the batch. Programs that are still building are waited on first.
+    Handles returned by add() are invalidated.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void ProgramBatch::clear() {
+    //Don't destroy programs out from under the driver's compiler threads
+    for( std::size_t i = 0; i < m_submitted; ++i )
+        if( m_entries[i]->state == ProgramBatchState::BUILDING )
+            complete( *m_entries[i] );
+
+    m_entries.clear();
+    m_submitted           = 0;
+    m_pending             = 0;
+    m_failed              = 0;
+    m_elapsedMilliseconds = 0.0;
+}
+
+/*
+ProgramBatch::add
+-----------------
+
+Description:
+    Adds a program to the batch. The program isn't built until submit() is called.
+
+Arguments:
+    source:  The shaders and settings to build the program with.
+
+Returns:
+    Handle:  The handle of the program.
+*/
+ProgramBatch::Handle ProgramBatch::add( const ProgramSource& source ) {
+    const Handle handle = m_entries.size();
+
+    std::unique_ptr< Entry > entry( new Entry );
+    entry->source      = source;
+    entry->state       = ProgramBatchState::PENDING;
+    entry->hasGeometry = !source.geometry.empty();
+    entry->cacheable   = false;
+    entry->key         = 0;
+    m_entries.push_back( std::move( entry ) );
+    ++m_pending;
+
+    return handle;
+}
+
+/*
+ProgramBatch::submit
+--------------------
+
+Description:
+    Starts building every program that has been added since the last call to submit().
+    Programs with a cached binary are loaded immediately. Every other program has its shaders compiled,
+    and only once every shader has been submitted are the programs linked, so the driver isn't made to wait on any of them.
+    This doesn't wait for anything to finish; use poll() or finish() for that.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void ProgramBatch::submit() {
+    if( m_graphics == nullptr || m_submitted == m_entries.size() )
+        return;
+
+    const std::size_t first = m_submitted;
+    m_submitted = m_entries.size();
+
+    //Load anything we can from the cache first; these are done immediately
+    if( m_cache != nullptr && m_cache->m_binarySupported ) {
+        const ustring deviceName    = m_graphics->getDeviceName();
+        const ustring driverVersion = m_graphics->getDriverVersion();
+
+        for( std::size_t i = first; i < m_submitted; ++i ) {
+            Entry& entry = *m_entries[i];
+            entry.key       = ProgramCache::computeKey( entry.source, deviceName, driverVersion );
+            entry.cacheable = true;
+
+            if( m_cache->loadBinary( entry.key, entry.program ) ) {
+                ++m_cache->m_stats.hits;
+                entry.state     = ProgramBatchState::READY;
+                entry.source    = ProgramSource();
+                entry.cacheable = false;
+                --m_pending;
+            } else {
+                ++m_cache->m_stats.misses;
+            }
+        }
+    } else if( m_cache != nullptr ) {
+        m_cache->m_stats.misses += m_submitted - first;
+    }
+
+    //If nothing was building already, this is the start of a new batch of work
+    bool building = false;
+    for( std::size_t i = 0; i < first && !building; ++i )
+        building = m_entries[i]->state == ProgramBatchState::BUILDING;
+    if( !building )
+        m_timer.reset();
+
+    //Compile every shader...
+    for( std::size_t i = first; i < m_submitted; ++i )
+        if( m_entries[i]->state == ProgramBatchState::PENDING )
+            start( *m_entries[i] );
+
+    //...then link every program
+    for( std::size_t i = first; i < m_submitted; ++i ) {
+        Entry& entry = *m_entries[i];
+        if( entry.state == ProgramBatchState::BUILDING )
+            entry.program.beginLink();
+        entry.source = ProgramSource();
+    }
+
+    if( m_pending == 0 )
+        m_elapsedMilliseconds += m_timer.getMicroseconds() / 1000.0;
+}
+
+/*
+ProgramBatch::poll
+------------------
+
+Description:
+    Completes any programs that have finished building, without waiting on ones that haven't.
+    If the driver doesn't support GL_KHR_parallel_shader_compile, there's no way to tell if a program has
+    finished building without waiting for it, so this waits for every program that has been submitted.
+
+Arguments:
+    N/A
+
+Returns:
+    bool:  true if every program that has been submitted has finished building, false otherwise.
+*/
+bool ProgramBatch::poll() {
+    for( std::size_t i = 0; i < m_submitted; ++i ) {
+        Entry& entry = *m_entries[i];
+        if( entry.state == ProgramBatchState::BUILDING && entry.program.isLinkComplete() )
+            complete( entry );
+    }
+    return m_pending == m_entries.size() - m_submitted;
+}
+
+/*
+ProgramBatch::finish
+--------------------
+
+Description:
+    Submits any programs that haven't been submitted yet, then waits for every program to finish building.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void ProgramBatch::finish() {
+    submit();
+    for( std::size_t i = 0; i < m_submitted; ++i )
+        if( m_entries[i]->state == ProgramBatchState::BUILDING )
+            complete( *m_entries[i] );
+}
+
+ProgramBatchState ProgramBatch::getState( const Handle handle ) const {
+    if( handle >= m_entries.size() )
+        throw BoundsException();
+    return m_entries[ handle ]->state;
+}
+
+/*
+ProgramBatch::getProgram
+------------------------
+
+Description:
+    Returns the program with the given handle.
+    If the program hasn't finished building, this submits it if necessary and waits for it to finish.
+
+Arguments:
+    handle:             The handle of the program.
+
+Returns:
+    Program&:           The linked program.
+
+Throws:
+    BoundsException:    If handle isn't the handle of a program in the batch.
+    GraphicsException:  If the program failed to build. The exception's description is the info log of the shader or program that failed.
+*/
+Program& ProgramBatch::getProgram( const Handle handle ) {
+    if( handle >= m_entries.size() )
+        throw BoundsException();
+
+    Entry& entry = *m_entries[ handle ];
+    if( entry.state == ProgramBatchState::PENDING )
+        submit();
+    if( entry.state == ProgramBatchState::BUILDING )
+        complete( entry );
+    if( entry.state == ProgramBatchState::FAILED )
+        throw GraphicsException( entry.error );
+
+    return entry.program;
+}
+
+//Returns the info log of the shader or program that failed to build, or an empty string if the program hasn't failed
+const ustring& ProgramBatch::getError( const Handle handle ) const {
+    if( handle >= m_entries.size() )
+        throw BoundsException();
+    return m_entries[ handle ]->error;
+}
+
+std::size_t ProgramBatch::getCount() const {
+    return m_entries.size();
+}
+
+//Returns the number of programs that haven't been submitted or haven't finished building
+std::size_t ProgramBatch::getPendingCount() const {
+    return m_pending;
+}
+
+std::size_t ProgramBatch::getFailedCount() const {
+    return m_failed;
+}
+
+//Returns the total time spent between submitting programs and all of them finishing building
+double ProgramBatch::getElapsedMilliseconds() const {
+    return m_elapsedMilliseconds;
+}
+
+/*
+ProgramBatch::start
+-------------------
+
+Description:
+    Creates the shaders and program for the given entry and starts compiling its shaders.
+
+Arguments:
+    entry:  The entry to start building.
+
+Returns:
+    N/A
+*/
+void ProgramBatch::start( Entry& entry ) {
+    const ProgramSource& source = entry.source;
+
+    entry.vertex = m_graphics->createShader( ShaderType::VERTEX );
+    entry.vertex.setSource( ProgramCache::applyDefines( source.vertex, source.defines ) );
+    entry.vertex.beginCompile();
+
+    if( entry.hasGeometry ) {
+        entry.geometry = m_graphics->createShader( ShaderType::GEOMETRY );
+        entry.geometry.setSource( ProgramCache::applyDefines( source.geometry, source.defines ) );
+        entry.geometry.beginCompile();
+    }
+
+    entry.fragment = m_graphics->createShader( ShaderType::FRAGMENT );
+    entry.fragment.setSource( ProgramCache::applyDefines( source.fragment, source.defines ) );
+    entry.fragment.beginCompile();
+
+    entry.program = m_graphics->createProgram();
+    entry.program.attachShader( entry.vertex );
+    if( entry.hasGeometry )
+        entry.program.attachShader( entry.geometry );
+    entry.program.attachShader( entry.fragment );
+    for( const std::pair< ustring, uint >& attribute : source.attributes )
+        entry.program.bindAttribute( attribute.first.c_str(), attribute.second );
+    if( entry.cacheable )
+        entry.program.setBinaryRetrievable( true );
+
+    entry.state = ProgramBatchState::BUILDING;
+}
+
+/*
+ProgramBatch::complete
+----------------------
+
+Description:
+    Waits for the given entry's program to finish building and checks if it succeeded.
+    On success, the program's shaders are released and its binary is cached;
+    on failure, the info log of whichever shader or program failed is kept.
+
+Arguments:
+    entry:  The entry to complete.
+
+Returns:
+    N/A
+*/
+void ProgramBatch::complete( Entry& entry ) {
+    //If linking failed because a shader didn't compile, the shader's log is the useful one.
+    //Once the link is complete every shader has finished compiling, so checking them doesn't wait.
+    try {
+        entry.vertex.endCompile();
+        if( entry.hasGeometry )
+            entry.geometry.endCompile();
+        entry.fragment.endCompile();
+        entry.program.endLink();
+        entry.state = ProgramBatchState::READY;
+    } catch( const GraphicsException& e ) {
+        entry.state = ProgramBatchState::FAILED;
+        entry.error = e.getDescription();
+        ++m_failed;
+    }
+
+    //The shaders are no longer needed once the program is linked
+    if( entry.state == ProgramBatchState::READY ) {
+        entry.program.detachShader( entry.vertex );
+        if( entry.hasGeometry )
+            entry.program.detachShader( entry.geometry );
+        entry.program.detachShader( entry.fragment );
+    }
+    {
+        Shader vertex(   std::move( entry.vertex   ) );
+        Shader geometry( std::move( entry.geometry ) );
+        Shader fragment( std::move( entry.fragment ) );
+    }
+
+    if( entry.state == ProgramBatchState::READY && entry.cacheable )
+        m_cache->saveBinary( entry.key, entry.program );
+
+    if( --m_pending == 0 ) {
+        const double elapsed = m_timer.getMicroseconds() / 1000.0;
+        m_elapsedMilliseconds += elapsed;
+        if( m_cache != nullptr )
+            m_cache->m_stats.compileMilliseconds += elapsed;
+    }
+}
+
+
+
+
+} //namespace Brimstone
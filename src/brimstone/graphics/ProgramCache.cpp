@@ -0,0 +1,402 @@
+/*
+graphics/ProgramCache.cpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See ProgramCache.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/ProgramCache.hpp>  //Header
+
+#include <brimstone/util/Hash.hpp>              //Brimstone::hashFNV1a
+#include <brimstone/Stopwatch.hpp>              //Brimstone::Stopwatch
+#include <brimstone/Logger.hpp>                 //Brimstone::logWarning
+
+#include <cstdio>                               //std::FILE, std::fopen, std::fread, std::fwrite, std::fclose, std::snprintf
+#include <cstring>                              //std::memcmp, std::memcpy
+#include <filesystem>                           //std::filesystem::create_directories
+#include <system_error>                         //std::error_code
+#include <utility>                              //std::move
+
+#include <boost/format.hpp>                     //boost::format
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ustring;
+using ::Brimstone::ubyte;
+using ::Brimstone::uint32;
+using ::Brimstone::uint64;
+
+//Header at the start of every cached binary file; it's followed by size bytes of the binary
+struct BinaryHeader {
+    char   magic[8];
+    uint32 version;
+    uint32 format;   //Driver-specific format of the binary
+    uint64 key;      //Key the binary was cached under; guards against files being renamed
+    uint32 size;
+    uint32 reserved;
+};
+
+
+
+
+//Constants
+constexpr char   BINARY_MAGIC[8] = { 'B', 'S', 'P', 'R', 'O', 'G', 'B', '\0' };
+constexpr uint32 BINARY_VERSION  = 1;
+
+//Sanity limit on the size of a cached binary; anything larger is assumed to be corrupt
+constexpr uint32 MAX_BINARY_SIZE = 64 * 1024 * 1024;
+
+
+
+
+//Functions
+bool readFile( const ustring& path, uint64 key, uint32& formatOut, std::vector< ubyte >& dataOut ) {
+    std::FILE* file = std::fopen( path.c_str(), "rb" );
+    if( file == nullptr )
+        return false;
+
+    BinaryHeader header;
+    bool ok = std::fread( &header, sizeof( header ), 1, file ) == 1 &&
+              std::memcmp( header.magic, BINARY_MAGIC, sizeof( BINARY_MAGIC ) ) == 0 &&
+              header.version == BINARY_VERSION &&
+              header.key     == key &&
+              header.size    >  0 &&
+              header.size    <= MAX_BINARY_SIZE;
+    if( ok ) {
+        dataOut.resize( header.size );
+        ok = std::fread( dataOut.data(), header.size, 1, file ) == 1;
+        formatOut = header.format;
+    }
+
+    std::fclose( file );
+    return ok;
+}
+
+bool writeFile( const ustring& path, uint64 key, uint32 format, const std::vector< ubyte >& data ) {
+    std::FILE* file = std::fopen( path.c_str(), "wb" );
+    if( file == nullptr )
+        return false;
+
+    BinaryHeader header {};
+    std::memcpy( header.magic, BINARY_MAGIC, sizeof( BINARY_MAGIC ) );
+    header.version = BINARY_VERSION;
+    header.format  = format;
+    header.key     = key;
+    header.size    = (uint32)data.size();
+
+    const bool ok = std::fwrite( &header, sizeof( header ), 1, file ) == 1 &&
+                    std::fwrite( data.data(), data.size(), 1, file ) == 1;
+
+    return std::fclose( file ) == 0 && ok;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+ProgramCache::ProgramCache() :
+    m_graphics( nullptr ),
+    m_binarySupported( false ),
+    m_stats {} {
+}
+
+/*
+ProgramCache::init
+------------------
+
+Description:
+    Sets the Graphics to build programs with and the directory to save their binaries to.
+    The directory is created when the first binary is saved.
+
+Arguments:
+    graphics:   The Graphics to create programs with.
+    directory:  The directory to load and save binaries from. If this is empty,
+                or the driver doesn't support program binaries, every program is built from source.
+
+Returns:
+    N/A
+*/
+void ProgramCache::init( Graphics& graphics, const ustring& directory ) {
+    m_graphics        = &graphics;
+    m_directory       = directory;
+    m_binarySupported = !directory.empty() && graphics.isProgramBinarySupported();
+    m_stats           = {};
+}
+
+/*
+ProgramCache::load
+------------------
+
+Description:
+    Returns a linked program built from the given sources. If a binary of the program was cached by an earlier run,
+    the binary is loaded instead; otherwise the program is compiled and linked, and its binary is cached for the next run.
+
+Arguments:
+    source:             The shaders and settings to build the program with.
+
+Returns:
+    Program:            The linked program.
+
+Throws:
+    GraphicsException:  If the program needed to be built from source and compiling or linking it failed.
+*/
+Program ProgramCache::load( const ProgramSource& source ) {
+    if( !m_binarySupported ) {
+        ++m_stats.misses;
+        return build( source, false );
+    }
+
+    const uint64 key = computeKey( source, m_graphics->getDeviceName(), m_graphics->getDriverVersion() );
+
+    Program program;
+    if( loadBinary( key, program ) ) {
+        ++m_stats.hits;
+        return program;
+    }
+
+    ++m_stats.misses;
+    program = build( source, true );
+    saveBinary( key, program );
+    return program;
+}
+
+const ProgramCacheStats& ProgramCache::getStats() const {
+    return m_stats;
+}
+
+void ProgramCache::resetStats() {
+    m_stats = {};
+}
+
+/*
+ProgramCache::applyDefines
+--------------------------
+
+Description:
+    Returns the given shader source with a #define line for each of the given defines inserted after its #version line.
+    If the source has no #version line, the defines are inserted at the start of the source.
+
+Arguments:
+    source:    The shader source.
+    defines:   The defines; each is either "NAME" or "NAME VALUE".
+
+Returns:
+    ustring:   The source with the defines inserted.
+*/
+ustring ProgramCache::applyDefines( const ustring& source, const std::vector< ustring >& defines ) {
+    if( defines.empty() )
+        return source;
+
+    ustring lines;
+    for( const ustring& define : defines )
+        lines += "#define " + define + "\n";
+
+    //#version must be the first thing in a shader, so the defines go on the line after it
+    std::size_t insertAt = 0;
+    const std::size_t version = source.find( "#version" );
+    if( version != ustring::npos ) {
+        const std::size_t end = source.find( '\n', version );
+        if( end == ustring::npos )
+            return source + "\n" + lines;
+        insertAt = end + 1;
+    }
+
+    ustring result( source, 0, insertAt );
+    result += lines;
+    result.append( source, insertAt, ustring::npos );
+    return result;
+}
+
+/*
+ProgramCache::computeKey
+------------------------
+
+Description:
+    Computes the key a program's binary is cached under.
+    The key changes whenever anything that could change the binary does.
+
+Arguments:
+    source:         The shaders and settings the program is built with.
+    deviceName:     The name of the GPU the binary is for (see Graphics::getDeviceName()).
+    driverVersion:  The version of the driver the binary is for (see Graphics::getDriverVersion()).
+
+Returns:
+    uint64:         The key.
+*/
+uint64 ProgramCache::computeKey( const ProgramSource& source, const ustring& deviceName, const ustring& driverVersion ) {
+    uint64 hash = hashFNV1a( &BINARY_VERSION, sizeof( BINARY_VERSION ) );
+    hash = hashFNV1a( source.vertex,   hash );
+    hash = hashFNV1a( source.geometry, hash );
+    hash = hashFNV1a( source.fragment, hash );
+
+    const uint64 defineCount = source.defines.size();
+    hash = hashFNV1a( &defineCount, sizeof( defineCount ), hash );
+    for( const ustring& define : source.defines )
+        hash = hashFNV1a( define, hash );
+
+    const uint64 attributeCount = source.attributes.size();
+    hash = hashFNV1a( &attributeCount, sizeof( attributeCount ), hash );
+    for( const std::pair< ustring, uint >& attribute : source.attributes ) {
+        const uint64 index = attribute.second;
+        hash = hashFNV1a( attribute.first, hash );
+        hash = hashFNV1a( &index, sizeof( index ), hash );
+    }
+
+    hash = hashFNV1a( deviceName,    hash );
+    hash = hashFNV1a( driverVersion, hash );
+    return hash;
+}
+
+/*
+ProgramCache::build
+-------------------
+
+Description:
+    Compiles and links a program from source.
+
+Arguments:
+    source:             The shaders and settings to build the program with.
+    retrievable:        If true, the driver is told its binary will be retrieved after linking.
+
+Returns:
+    Program:            The linked program.
+
+Throws:
+    GraphicsException:  If compiling or linking the program failed.
+*/
+Program ProgramCache::build( const ProgramSource& source, const bool retrievable ) {
+    Stopwatch timer;
+
+    Shader vertex = m_graphics->createShader( ShaderType::VERTEX );
+    vertex.setSource( applyDefines( source.vertex, source.defines ) );
+    vertex.compile();
+
+    Shader geometry;
+    if( !source.geometry.empty() ) {
+        geometry = m_graphics->createShader( ShaderType::GEOMETRY );
+        geometry.setSource( applyDefines( source.geometry, source.defines ) );
+        geometry.compile();
+    }
+
+    Shader fragment = m_graphics->createShader( ShaderType::FRAGMENT );
+    fragment.setSource( applyDefines( source.fragment, source.defines ) );
+    fragment.compile();
+
+    Program program = m_graphics->createProgram();
+    program.attachShader( vertex );
+    if( !source.geometry.empty() )
+        program.attachShader( geometry );
+    program.attachShader( fragment );
+    for( const std::pair< ustring, uint >& attribute : source.attributes )
+        program.bindAttribute( attribute.first.c_str(), attribute.second );
+    if( retrievable )
+        program.setBinaryRetrievable( true );
+    program.link();
+
+    //The shaders are no longer needed once the program is linked
+    program.detachShader( vertex );
+    if( !source.geometry.empty() )
+        program.detachShader( geometry );
+    program.detachShader( fragment );
+
+    m_stats.compileMilliseconds += timer.getMicroseconds() / 1000.0;
+    return program;
+}
+
+/*
+ProgramCache::loadBinary
+------------------------
+
+Description:
+    Tries to create a program from the binary cached under the given key.
+
+Arguments:
+    key:         The program's key.
+    programOut:  Receives the program if its binary was loaded.
+
+Returns:
+    bool:        true if a cached binary was found and the driver accepted it, false otherwise.
+*/
+bool ProgramCache::loadBinary( const uint64 key, Program& programOut ) {
+    Stopwatch timer;
+
+    uint32               format;
+    std::vector< ubyte > data;
+    if( !readFile( getPath( key ), key, format, data ) )
+        return false;
+
+    Program program = m_graphics->createProgram();
+    const bool accepted = program.setBinary( format, data.data(), data.size() );
+
+    m_stats.loadMilliseconds += timer.getMicroseconds() / 1000.0;
+    if( !accepted ) {
+        ++m_stats.rejected;
+        return false;
+    }
+
+    programOut = std::move( program );
+    return true;
+}
+
+/*
+ProgramCache::saveBinary
+------------------------
+
+Description:
+    Caches the binary of the given program under the given key, replacing any binary that was there.
+    Failing to save the binary isn't an error; a warning is logged and the program will be built from source next time.
+
+Arguments:
+    key:      The program's key.
+    program:  The linked program.
+
+Returns:
+    N/A
+*/
+void ProgramCache::saveBinary( const uint64 key, const Program& program ) {
+    uint32               format;
+    std::vector< ubyte > data;
+    if( !program.getBinary( data, format ) )
+        return;
+
+    std::error_code error;
+    std::filesystem::create_directories( m_directory, error );
+
+    const ustring path = getPath( key );
+    if( !writeFile( path, key, format, data ) )
+        logWarning( ( boost::format( "Couldn't save program binary to \"%s\"." ) % path ).str() );
+}
+
+//Returns the path of the file the binary with the given key is cached in
+ustring ProgramCache::getPath( const uint64 key ) const {
+    char filename[32];
+    std::snprintf( filename, sizeof( filename ), "%016llx.bin", (unsigned long long)key );
+    return ( std::filesystem::path( m_directory ) / filename ).string();
+}
+
+
+
+
+} //namespace Brimstone
@@ -0,0 +1,424 @@
+/*
+graphics/RenderTarget.cpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See RenderTarget.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/RenderTarget.hpp>  //Header
+
+#include <brimstone/Exception.hpp>              //Brimstone::GraphicsException
+
+#include <algorithm>                            //std::min, std::max, std::clamp
+#include <cmath>                                //std::sqrt, std::lround
+#include <limits>                               //std::numeric_limits
+#include <utility>                              //std::move
+
+
+
+
+namespace {
+
+
+
+
+//Constants
+//How much of each new frame time is blended into the average
+constexpr double SMOOTHING = 0.1;
+
+//How many frames the frame time is averaged over each time before the scale is adjusted
+constexpr std::size_t SETTLE_FRAMES = 8;
+
+//The scale only grows if frames take less than this fraction of the target frame time, and grows to bring them up to it,
+//which leaves some headroom so the scale doesn't bounce between growing and shrinking
+constexpr double HEADROOM = 0.85;
+
+//The most the scale can grow by at a time; it shrinks as much as it needs to right away
+constexpr double MAX_GROWTH = 1.05;
+
+
+
+
+//Functions
+//Destroys whatever the given object holds, leaving it empty
+template< typename T >
+void release( T& object ) {
+    T released( std::move( object ) );
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+RenderTarget::RenderTarget() :
+    m_graphics( nullptr ),
+    m_width( 0 ),
+    m_height( 0 ),
+    m_format( TextureFormat::RGBA8 ),
+    m_samples( 0 ),
+    m_scale( DEFAULT_MAX_SCALE ),
+    m_minScale( DEFAULT_MIN_SCALE ),
+    m_maxScale( DEFAULT_MAX_SCALE ),
+    m_targetFrameTime( 0.0 ),
+    m_averageFrameTime( 0.0 ),
+    m_framesMeasured( 0 ),
+    m_viewport{ 0, 0, 0, 0 } {
+}
+
+RenderTarget::~RenderTarget() {
+    destroy();
+}
+
+/*
+RenderTarget::init
+------------------
+
+Description:
+    Creates the target's texture and framebuffers.
+    The scale, scale range and target frame time are kept from before, so they can be set before or after init().
+
+Arguments:
+    graphics:           The Graphics to create the target with.
+    width:              The width of the target, in pixels.
+    height:             The height of the target, in pixels.
+    format:             The format of the target's texture. Must not be a compressed format.
+    samples:            The number of samples per pixel to render with, or 0 to render without multisampling.
+                        This is clamped to the most the driver supports; getSamples() returns the number actually used.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the target couldn't be created.
+*/
+void RenderTarget::init( Graphics& graphics, const std::size_t width, const std::size_t height, const TextureFormat format, const std::size_t samples ) {
+    m_graphics = &graphics;
+    m_width    = width;
+    m_height   = height;
+    m_format   = format;
+    m_samples  = samples;
+    create();
+}
+
+void RenderTarget::destroy() {
+    release( m_multisample );
+    release( m_framebuffer );
+    release( m_color );
+    m_graphics = nullptr;
+    m_width    = 0;
+    m_height   = 0;
+    m_samples  = 0;
+}
+
+//Recreates the target at the given size, e.g. after the window it's presented to was resized; its contents are lost
+void RenderTarget::resize( const std::size_t width, const std::size_t height ) {
+    if( width == m_width && height == m_height )
+        return;
+    m_width  = width;
+    m_height = height;
+    create();
+}
+
+/*
+RenderTarget::begin
+-------------------
+
+Description:
+    Binds the target so the commands that follow render into it, and sets the viewport to the part of it being rendered to
+    (the lower-left getRenderWidth() x getRenderHeight() pixels).
+    The viewport that was set before is saved, and restored by end().
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    N/A
+*/
+void RenderTarget::begin() {
+    m_graphics->getViewport( m_viewport );
+    if( m_samples > 0 )
+        m_multisample.bind();
+    else
+        m_framebuffer.bind();
+    m_graphics->setViewport( 0, 0, (int)getRenderWidth(), (int)getRenderHeight() );
+}
+
+/*
+RenderTarget::end
+-----------------
+
+Description:
+    Stops rendering into the target. If it's multisampled, the part that was rendered to is resolved into its texture.
+    Afterwards, the window is bound again and the viewport set before begin() is restored.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the target couldn't be resolved.
+*/
+void RenderTarget::end() {
+    if( m_samples > 0 ) {
+        const int renderWidth  = (int)getRenderWidth();
+        const int renderHeight = (int)getRenderHeight();
+        const int top          = (int)m_height - renderHeight;
+        m_multisample.blit( m_framebuffer, 0, top, renderWidth, renderHeight, 0, top, renderWidth, renderHeight );
+        m_multisample.unbind();
+    } else {
+        m_framebuffer.unbind();
+    }
+    m_graphics->setViewport( m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3] );
+}
+
+/*
+RenderTarget::present{1}
+------------------------
+
+Description:
+    Copies what was rendered into the target to the entire viewport, upscaling it if the target was rendered at less than full scale.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the target couldn't be copied.
+*/
+void RenderTarget::present() {
+    int viewport[4];
+    m_graphics->getViewport( viewport );
+    present( 0, 0, viewport[2], viewport[3] );
+}
+
+/*
+RenderTarget::present{2}
+------------------------
+
+Description:
+    Copies what was rendered into the target to a region of the window, scaling it to fit.
+    Like the scissor box, the region is relative to the upper-left corner of the viewport.
+
+Arguments:
+    x:                  The left edge of the region.
+    y:                  The top edge of the region.
+    width:              The width of the region.
+    height:             The height of the region.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the target couldn't be copied.
+*/
+void RenderTarget::present( const int x, const int y, const int width, const int height ) {
+    const int renderHeight = (int)getRenderHeight();
+    m_graphics->blit( m_framebuffer, 0, (int)m_height - renderHeight, (int)getRenderWidth(), renderHeight, x, y, width, height, FilterType::LINEAR );
+}
+
+/*
+RenderTarget::present{3}
+------------------------
+
+Description:
+    Copies what was rendered into the target to the whole of another framebuffer, scaling it to fit.
+
+Arguments:
+    target:             The framebuffer to copy to.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the target couldn't be copied.
+*/
+void RenderTarget::present( Framebuffer& target ) {
+    const int renderHeight = (int)getRenderHeight();
+    m_framebuffer.blit( target, 0, (int)m_height - renderHeight, (int)getRenderWidth(), renderHeight,
+                        0, 0, (int)target.getWidth(), (int)target.getHeight(), FilterType::LINEAR );
+}
+
+//Sets the fraction of the target's width and height to render at, clamped to the scale range
+void RenderTarget::setScale( const float scale ) {
+    m_scale          = std::clamp( scale, m_minScale, m_maxScale );
+    m_framesMeasured = 0;
+}
+
+float RenderTarget::getScale() const {
+    return m_scale;
+}
+
+/*
+RenderTarget::setScaleRange
+---------------------------
+
+Description:
+    Sets the smallest and largest scale the target can be rendered at, which limits both setScale() and update().
+    Both ends of the range are clamped to (0, 1], and the current scale is clamped to the new range.
+
+Arguments:
+    minScale:           The smallest scale. Scales at or below 0 are treated as the smallest positive float.
+    maxScale:           The largest scale. Scales below minScale are treated as minScale.
+
+Returns:
+    N/A
+
+Throws:
+    N/A
+*/
+void RenderTarget::setScaleRange( const float minScale, const float maxScale ) {
+    m_minScale = std::clamp( minScale, std::numeric_limits< float >::min(), 1.0f );
+    m_maxScale = std::clamp( maxScale, m_minScale, 1.0f );
+    setScale( m_scale );
+}
+
+float RenderTarget::getMinScale() const {
+    return m_minScale;
+}
+
+float RenderTarget::getMaxScale() const {
+    return m_maxScale;
+}
+
+//Sets the frame time update() tries to hold, in milliseconds. If it's 0, update() leaves the scale alone.
+void RenderTarget::setTargetFrameTime( const double milliseconds ) {
+    m_targetFrameTime = milliseconds;
+    m_framesMeasured  = 0;
+}
+
+double RenderTarget::getTargetFrameTime() const {
+    return m_targetFrameTime;
+}
+
+/*
+RenderTarget::update
+--------------------
+
+Description:
+    Adjusts the scale to hold the target frame time, given how long the last frame took.
+    Should be called once a frame; the frame time can be measured on the CPU or GPU, whichever limits the frame rate.
+
+    Frame times are averaged over several frames before the scale is adjusted, and measured afresh after every adjustment.
+    The time it takes to render a frame is assumed to be proportional to the number of pixels rendered,
+    so when frames take too long the scale shrinks in a single step by as much as that predicts it needs to.
+    When frames take much less than the target, the scale grows gradually instead, since growing too far
+    would cause the very stutter this is meant to avoid.
+
+Arguments:
+    frameMilliseconds:  How long the last frame took, in milliseconds.
+
+Returns:
+    N/A
+
+Throws:
+    N/A
+*/
+void RenderTarget::update( const double frameMilliseconds ) {
+    if( m_targetFrameTime <= 0.0 )
+        return;
+
+    if( m_framesMeasured == 0 )
+        m_averageFrameTime = frameMilliseconds;
+    else
+        m_averageFrameTime += SMOOTHING * ( frameMilliseconds - m_averageFrameTime );
+    if( ++m_framesMeasured < SETTLE_FRAMES )
+        return;
+
+    //Pixels are proportional to the square of the scale
+    double scale = m_scale;
+    if( m_averageFrameTime > m_targetFrameTime )
+        scale *= std::sqrt( m_targetFrameTime / m_averageFrameTime );
+    else if( m_averageFrameTime < m_targetFrameTime * HEADROOM )
+        scale *= std::min( std::sqrt( m_targetFrameTime * HEADROOM / m_averageFrameTime ), MAX_GROWTH );
+
+    setScale( (float)scale );
+}
+
+Texture& RenderTarget::getTexture() {
+    return m_color;
+}
+
+//Returns the framebuffer the target's texture is attached to, which is what present() copies from
+Framebuffer& RenderTarget::getFramebuffer() {
+    return m_framebuffer;
+}
+
+std::size_t RenderTarget::getWidth() const {
+    return m_width;
+}
+
+std::size_t RenderTarget::getHeight() const {
+    return m_height;
+}
+
+//Returns the width of the part of the target that's rendered to at the current scale
+std::size_t RenderTarget::getRenderWidth() const {
+    return std::clamp< std::size_t >( (std::size_t)std::lround( m_width * m_scale ), 1, m_width );
+}
+
+std::size_t RenderTarget::getRenderHeight() const {
+    return std::clamp< std::size_t >( (std::size_t)std::lround( m_height * m_scale ), 1, m_height );
+}
+
+std::size_t RenderTarget::getSamples() const {
+    return m_samples;
+}
+
+//(Re)creates the texture and framebuffers at the current size
+void RenderTarget::create() {
+    release( m_multisample );
+    release( m_framebuffer );
+    release( m_color );
+
+    m_color = m_graphics->createTexture();
+    m_color.setStorage( m_width, m_height, m_format, 1 );
+
+    m_framebuffer = m_graphics->createFramebuffer();
+    m_framebuffer.setColor( m_color );
+
+    if( m_samples > 0 ) {
+        m_multisample = m_graphics->createFramebuffer();
+        m_multisample.setColor( m_width, m_height, m_format, m_samples );
+        m_multisample.setDepth( m_width, m_height, m_samples );
+        m_samples = m_multisample.getSamples();
+
+        //The driver doesn't support multisampling with this format
+        if( m_samples == 0 )
+            release( m_multisample );
+        else if( !m_multisample.isComplete() )
+            throw GraphicsException( "The render target's multisampled framebuffer is incomplete." );
+    }
+
+    //A multisampled target renders into m_multisample's depth buffer instead
+    if( m_samples == 0 )
+        m_framebuffer.setDepth( m_width, m_height );
+    if( !m_framebuffer.isComplete() )
+        throw GraphicsException( "The render target's framebuffer is incomplete." );
+}
+
+
+
+
+} //namespace Brimstone
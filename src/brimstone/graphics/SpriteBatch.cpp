@@ -0,0 +1,467 @@
+/*
+graphics/SpriteBatch.cpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See SpriteBatch.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/SpriteBatch.hpp>   //Header
+
+#include <brimstone/graphics/VertexLayout.hpp>  //Brimstone::VertexLayout
+#include <brimstone/Exception.hpp>              //Brimstone::GraphicsException
+
+#include <algorithm>                            //std::sort, std::is_sorted, std::min
+#include <cmath>                                //std::sin, std::cos
+#include <utility>                              //std::move
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::uint;
+using ::Brimstone::uint16;
+using ::Brimstone::uint64;
+
+
+
+
+//Constants
+//Layout of a sort key, from the most significant bit to the least significant bit:
+//    layer:    16 bits
+//    blend:     8 bits
+//    texture:  16 bits
+//    sequence: 24 bits (index of the sprite in the queue)
+constexpr int    KEY_LAYER_SHIFT   = 48;
+constexpr int    KEY_BLEND_SHIFT   = 40;
+constexpr int    KEY_TEXTURE_SHIFT = 24;
+constexpr uint64 KEY_SEQUENCE_MASK = ( 1 << 24 ) - 1;
+
+const char* const VERTEX_SHADER_SOURCE =
+    "#version 130\n"
+    "uniform vec2 viewSize;\n"
+    "in vec2 position;\n"
+    "in vec2 texCoord;\n"
+    "in vec4 color;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    gl_Position  = vec4( position.x / viewSize.x * 2.0 - 1.0, 1.0 - position.y / viewSize.y * 2.0, 0.0, 1.0 );\n"
+    "    fragTexCoord = texCoord;\n"
+    "    fragColor    = color;\n"
+    "}\n";
+
+const char* const FRAGMENT_SHADER_SOURCE =
+    "#version 130\n"
+    "uniform sampler2D tex;\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "out vec4 outColor;\n"
+    "void main() {\n"
+    "    outColor = texture( tex, fragTexCoord ) * fragColor;\n"
+    "}\n";
+
+//Attribute indices
+constexpr uint ATTRIB_POSITION = 0;
+constexpr uint ATTRIB_TEXCOORD = 1;
+constexpr uint ATTRIB_COLOR    = 2;
+
+uint16 toUnorm16( const float value ) {
+    if( value <= 0.0f )
+        return 0;
+    if( value >= 1.0f )
+        return 65535;
+    return (uint16)( value * 65535.0f + 0.5f );
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+SpriteQueue::SpriteQueue() :
+    m_sortMode( SpriteSortMode::TEXTURE ),
+    m_lastTexture( nullptr ),
+    m_lastTextureIndex( 0 ) {
+}
+
+void SpriteQueue::setSortMode( const SpriteSortMode mode ) {
+    m_sortMode = mode;
+}
+
+SpriteSortMode SpriteQueue::getSortMode() const {
+    return m_sortMode;
+}
+
+void SpriteQueue::reserve( const std::size_t count ) {
+    m_sprites.reserve( count );
+    m_keys.reserve( count );
+}
+
+/*
+SpriteQueue::add
+----------------
+
+Description:
+    Adds a sprite to the queue.
+
+Arguments:
+    sprite:  The sprite to add.
+
+Returns:
+    bool:    true if the sprite was added,
+             false if the queue is full (it has MAX_SPRITES sprites or MAX_TEXTURES different textures) and must be written and cleared first.
+*/
+bool SpriteQueue::add( const Sprite& sprite ) {
+    const std::size_t sequence = m_sprites.size();
+    if( sequence == MAX_SPRITES )
+        return false;
+
+    uint64 key = (uint64)sprite.layer << KEY_LAYER_SHIFT | sequence;
+    if( m_sortMode == SpriteSortMode::TEXTURE ) {
+        //Consecutive sprites usually share a texture, so check the last texture we saw before searching
+        if( sprite.texture != m_lastTexture ) {
+            auto it = m_textureIndices.find( sprite.texture );
+            if( it == m_textureIndices.end() ) {
+                if( m_textureIndices.size() == MAX_TEXTURES )
+                    return false;
+                it = m_textureIndices.emplace( sprite.texture, m_textureIndices.size() ).first;
+            }
+            m_lastTexture      = sprite.texture;
+            m_lastTextureIndex = it->second;
+        }
+        key |= (uint64)sprite.blend << KEY_BLEND_SHIFT | m_lastTextureIndex << KEY_TEXTURE_SHIFT;
+    }
+
+    m_sprites.push_back( sprite );
+    m_keys.push_back( key );
+    return true;
+}
+
+void SpriteQueue::clear() {
+    m_sprites.clear();
+    m_keys.clear();
+    m_textureIndices.clear();
+    m_lastTexture      = nullptr;
+    m_lastTextureIndex = 0;
+}
+
+std::size_t SpriteQueue::getCount() const {
+    return m_sprites.size();
+}
+
+bool SpriteQueue::empty() const {
+    return m_sprites.empty();
+}
+
+/*
+SpriteQueue::write
+------------------
+
+Description:
+    Sorts the queued sprites and writes their vertices (4 per sprite: top-left, top-right, bottom-right, bottom-left) in sorted order.
+    A SpriteRun is appended to runsOut for each stretch of consecutive sprites that share a texture and blend mode.
+
+Arguments:
+    vertices:  Receives the vertices. Must have room for 4 * getCount() vertices.
+    runsOut:   Cleared, then receives the runs.
+
+Returns:
+    N/A
+*/
+void SpriteQueue::write( SpriteVertex* const vertices, std::vector< SpriteRun >& runsOut ) {
+    runsOut.clear();
+
+    //Sprites are frequently queued in an order that's already sorted
+    if( !std::is_sorted( m_keys.begin(), m_keys.end() ) )
+        std::sort( m_keys.begin(), m_keys.end() );
+
+    SpriteVertex* v = vertices;
+    for( std::size_t i = 0; i < m_keys.size(); ++i ) {
+        const Sprite& s = m_sprites[ m_keys[i] & KEY_SEQUENCE_MASK ];
+
+        if( runsOut.empty() || runsOut.back().texture != s.texture || runsOut.back().blend != s.blend )
+            runsOut.push_back( SpriteRun { s.texture, s.blend, i, 0 } );
+        ++runsOut.back().count;
+
+        const uint16 u0 = toUnorm16( s.uv.minX );
+        const uint16 v0 = toUnorm16( s.uv.minY );
+        const uint16 u1 = toUnorm16( s.uv.maxX );
+        const uint16 v1 = toUnorm16( s.uv.maxY );
+
+        if( s.rotation == 0.0f ) {
+            v[0] = SpriteVertex { s.dest.minX, s.dest.minY, u0, v0, s.color };
+            v[1] = SpriteVertex { s.dest.maxX, s.dest.minY, u1, v0, s.color };
+            v[2] = SpriteVertex { s.dest.maxX, s.dest.maxY, u1, v1, s.color };
+            v[3] = SpriteVertex { s.dest.minX, s.dest.maxY, u0, v1, s.color };
+        } else {
+            //Corners relative to the origin, rotated, then translated back
+            const float c  = std::cos( s.rotation );
+            const float sn = std::sin( s.rotation );
+            const float ox = s.dest.minX + s.origin.x;
+            const float oy = s.dest.minY + s.origin.y;
+            const float x0 = s.dest.minX - ox;
+            const float y0 = s.dest.minY - oy;
+            const float x1 = s.dest.maxX - ox;
+            const float y1 = s.dest.maxY - oy;
+
+            v[0] = SpriteVertex { ox + x0*c - y0*sn, oy + x0*sn + y0*c, u0, v0, s.color };
+            v[1] = SpriteVertex { ox + x1*c - y0*sn, oy + x1*sn + y0*c, u1, v0, s.color };
+            v[2] = SpriteVertex { ox + x1*c - y1*sn, oy + x1*sn + y1*c, u1, v1, s.color };
+            v[3] = SpriteVertex { ox + x0*c - y1*sn, oy + x0*sn + y1*c, u0, v1, s.color };
+        }
+        v += 4;
+    }
+}
+
+
+
+
+SpriteBatch::SpriteBatch() :
+    m_graphics( nullptr ),
+    m_viewWidth( 1.0f ),
+    m_viewHeight( 1.0f ),
+    m_spriteCount( 0 ),
+    m_drawCallCount( 0 ) {
+}
+
+/*
+SpriteBatch::init
+-----------------
+
+Description:
+    Creates the resources the sprite batch needs to draw with the given Graphics.
+
+Arguments:
+    graphics:            The Graphics to draw with.
+    maxSpritesPerFrame:  The largest number of sprites that can be drawn between begin() and end().
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:   If creating any of the resources failed.
+*/
+void SpriteBatch::init( Graphics& graphics, const std::size_t maxSpritesPerFrame ) {
+    m_graphics = &graphics;
+
+    Shader vs = graphics.createShader( ShaderType::VERTEX );
+    vs.setSource( VERTEX_SHADER_SOURCE );
+    vs.compile();
+
+    Shader fs = graphics.createShader( ShaderType::FRAGMENT );
+    fs.setSource( FRAGMENT_SHADER_SOURCE );
+    fs.compile();
+
+    m_program = graphics.createProgram();
+    m_program.attachShader( vs );
+    m_program.attachShader( fs );
+    m_program.bindAttribute( "position", ATTRIB_POSITION );
+    m_program.bindAttribute( "texCoord", ATTRIB_TEXCOORD );
+    m_program.bindAttribute( "color",    ATTRIB_COLOR    );
+    m_program.link();
+    m_program.detachShader( vs );
+    m_program.detachShader( fs );
+
+    m_program.use();
+    m_program.setUniform( "tex", 0 );
+    m_program.stopUsing();
+
+    m_vertices = graphics.createStreamingBuffer( maxSpritesPerFrame * 4 * sizeof( SpriteVertex ) );
+    m_vertices.setLayout(
+        VertexLayout()
+            .add( ATTRIB_POSITION, 2, VertexAttributeType::FLOAT                )
+            .add( ATTRIB_TEXCOORD, 2, VertexAttributeType::UNSIGNED_SHORT, true )
+            .add( ATTRIB_COLOR,    4, VertexAttributeType::UNSIGNED_BYTE,  true )
+    );
+
+    //Every draw call starts at index 0 and uses the base vertex to select its sprites,
+    //so the index buffer only needs to cover the largest draw call.
+    std::vector< uint16 > indices( MAX_SPRITES_PER_DRAW * 6 );
+    for( std::size_t i = 0; i < MAX_SPRITES_PER_DRAW; ++i ) {
+        const uint16 v = (uint16)( i * 4 );
+        uint16* index = &indices[ i * 6 ];
+        index[0] = v;
+        index[1] = v + 1;
+        index[2] = v + 2;
+        index[3] = v + 2;
+        index[4] = v + 3;
+        index[5] = v;
+    }
+    m_indices = graphics.createIndexBuffer();
+    m_indices.set( indices.data(), indices.size() );
+
+    m_queue.reserve( std::min< std::size_t >( maxSpritesPerFrame, SpriteQueue::MAX_SPRITES ) );
+}
+
+void SpriteBatch::destroy() {
+    //Move the resources into temporaries so they're released when the temporaries go out of scope
+    {
+        IndexBuffer     indices(  std::move( m_indices  ) );
+        StreamingBuffer vertices( std::move( m_vertices ) );
+        Program         program(  std::move( m_program  ) );
+    }
+    m_graphics = nullptr;
+    m_queue.clear();
+}
+
+void SpriteBatch::setSortMode( const SpriteSortMode mode ) {
+    flush();
+    m_queue.setSortMode( mode );
+}
+
+SpriteSortMode SpriteBatch::getSortMode() const {
+    return m_queue.getSortMode();
+}
+
+/*
+SpriteBatch::setViewSize
+------------------------
+
+Description:
+    Sets the size of the viewport in pixels.
+    Sprites are positioned in a coordinate system where (0,0) is the viewport's top-left corner and (width,height) is its bottom-right corner.
+
+Arguments:
+    width:   The width of the viewport, in pixels.
+    height:  The height of the viewport, in pixels.
+
+Returns:
+    N/A
+*/
+void SpriteBatch::setViewSize( const float width, const float height ) {
+    flush();
+    m_viewWidth  = width;
+    m_viewHeight = height;
+}
+
+void SpriteBatch::begin() {
+    m_vertices.beginFrame();
+    m_spriteCount   = 0;
+    m_drawCallCount = 0;
+}
+
+/*
+SpriteBatch::draw{1}
+--------------------
+
+Description:
+    Queues a sprite to be drawn. Queued sprites are drawn when flush() or end() is called,
+    or when the queue fills up.
+
+Arguments:
+    sprite:              The sprite to draw.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:   If more than maxSpritesPerFrame sprites have been drawn this frame.
+*/
+void SpriteBatch::draw( const Sprite& sprite ) {
+    //Flush if the queue is full or the sprites already in it would use up the rest of this frame's vertex space
+    const std::size_t remaining = m_vertices.getRemaining() / ( 4 * sizeof( SpriteVertex ) );
+    if( m_queue.getCount() >= remaining ) {
+        flush();
+        if( m_vertices.getRemaining() < 4 * sizeof( SpriteVertex ) )
+            throw GraphicsException( "Sprite batch is full." );
+    }
+
+    if( !m_queue.add( sprite ) ) {
+        flush();
+        m_queue.add( sprite );
+    }
+}
+
+void SpriteBatch::draw( Texture& texture, const Bounds2f& dest, const Bounds2f& uv, const uint32 color, const BlendMode blend ) {
+    draw( Sprite { &texture, dest, uv, color, 0.0f, Point2f( 0.0f ), blend, 0 } );
+}
+
+/*
+SpriteBatch::flush
+------------------
+
+Description:
+    Draws every queued sprite, then clears the queue.
+    Each run of sprites sharing a texture and blend mode is drawn with one draw call
+    (or more, if the run has more than MAX_SPRITES_PER_DRAW sprites).
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void SpriteBatch::flush() {
+    if( m_queue.empty() )
+        return;
+
+    const std::size_t count = m_queue.getCount();
+    std::size_t firstVertex;
+    SpriteVertex* vertices = static_cast< SpriteVertex* >( m_vertices.allocateVertices( count * 4, firstVertex ) );
+    m_queue.write( vertices, m_runs );
+    m_queue.clear();
+
+    m_program.use();
+    m_program.setUniform( "viewSize", m_viewWidth, m_viewHeight );
+
+    Texture*  texture = nullptr;
+    BlendMode blend   = BlendMode::NONE;
+    bool      first   = true;
+    for( const SpriteRun& run : m_runs ) {
+        if( first || run.blend != blend ) {
+            m_graphics->setBlendMode( run.blend );
+            blend = run.blend;
+        }
+        if( first || run.texture != texture ) {
+            run.texture->bind();
+            texture = run.texture;
+        }
+        first = false;
+
+        for( std::size_t i = 0; i < run.count; i += MAX_SPRITES_PER_DRAW ) {
+            const std::size_t sprites = std::min( run.count - i, MAX_SPRITES_PER_DRAW );
+            m_graphics->drawIndexed( m_vertices, m_indices, 0, sprites * 6, (int)( firstVertex + ( run.first + i ) * 4 ) );
+            ++m_drawCallCount;
+        }
+    }
+
+    m_program.stopUsing();
+    m_spriteCount += count;
+}
+
+void SpriteBatch::end() {
+    flush();
+    m_vertices.endFrame();
+}
+
+std::size_t SpriteBatch::getSpriteCount() const {
+    return m_spriteCount;
+}
+
+std::size_t SpriteBatch::getDrawCallCount() const {
+    return m_drawCallCount;
+}
+
+
+
+
+} //namespace Brimstone
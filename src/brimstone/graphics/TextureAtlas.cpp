@@ -0,0 +1,733 @@
+/*
+graphics/TextureAtlas.cpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See TextureAtlas.hpp for more information.
+
+    Atlas files saved by TextureAtlasBuilder::save() have the following layout
+    (all integers are 32-bit and stored in the machine's native byte order):
+        magic:     8 bytes, "BSATLAS\0"
+        version:   FILE_VERSION
+        width, height, padding
+        skyline:   segment count, followed by x, y, width for each segment
+        regions:   region count, followed by name length, name (not null-terminated), minX, minY, maxX, maxY for each region
+        pixels:    width * height RGBA8 pixels, row by row starting with the top row
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/TextureAtlas.hpp>  //Header
+
+#include <algorithm>                            //std::min, std::max
+#include <cstdio>                               //FILE, std::fopen, std::fread, std::fwrite, std::fclose
+#include <cstring>                              //std::memcpy, std::memcmp
+#include <limits>                               //std::numeric_limits
+#include <utility>                              //std::move
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ubyte;
+using ::Brimstone::int32;
+using ::Brimstone::uint32;
+using ::Brimstone::ustring;
+using ::Brimstone::AtlasRegion;
+
+
+
+
+//Constants
+constexpr char        FILE_MAGIC[8] = { 'B', 'S', 'A', 'T', 'L', 'A', 'S', '\0' };
+constexpr uint32      FILE_VERSION  = 1;
+
+//Largest atlas (in either dimension) a file is allowed to describe; anything larger is assumed to be corrupt
+constexpr uint32      FILE_MAX_SIZE = 1 << 15;
+
+constexpr std::size_t BYTES_PER_PIXEL = 4;
+
+
+
+
+//Functions
+/*
+writePadded
+-----------
+
+Description:
+    Copies a width x height RGBA8 image into dest, surrounded by padding pixels on each side.
+    The padding is filled by extending the image's edge pixels outwards.
+
+Arguments:
+    pixels:      RGBA8 pixels of the image.
+    width:       Width of the image.
+    height:      Height of the image.
+    stride:      Number of bytes between the starts of consecutive rows of pixels.
+    padding:     Number of pixels of padding on each side.
+    dest:        Top-left corner of the (width + 2*padding) x (height + 2*padding) destination rectangle.
+    destStride:  Number of bytes between the starts of consecutive rows of dest.
+
+Returns:
+    N/A
+*/
+void writePadded( const ubyte* const pixels, const int32 width, const int32 height, const std::size_t stride, const int32 padding,
+                  ubyte* const dest, const std::size_t destStride ) {
+    const std::size_t rowSize = width * BYTES_PER_PIXEL;
+
+    for( int32 y = 0; y < height + 2*padding; ++y ) {
+        const int32  sourceY = std::min( std::max( y - padding, 0 ), height - 1 );
+        const ubyte* source  = pixels + sourceY * stride;
+        ubyte*       row     = dest + y * destStride;
+
+        for( int32 x = 0; x < padding; ++x )
+            std::memcpy( row + x * BYTES_PER_PIXEL, source, BYTES_PER_PIXEL );
+
+        std::memcpy( row + padding * BYTES_PER_PIXEL, source, rowSize );
+
+        for( int32 x = padding + width; x < width + 2*padding; ++x )
+            std::memcpy( row + x * BYTES_PER_PIXEL, source + rowSize - BYTES_PER_PIXEL, BYTES_PER_PIXEL );
+    }
+}
+
+AtlasRegion makeRegion( const int32 x, const int32 y, const int32 width, const int32 height, const int32 atlasWidth, const int32 atlasHeight ) {
+    AtlasRegion region;
+    region.pixels.set( x, y, x + width, y + height );
+    region.uv.set(
+        (float)region.pixels.minX / atlasWidth,
+        (float)region.pixels.minY / atlasHeight,
+        (float)region.pixels.maxX / atlasWidth,
+        (float)region.pixels.maxY / atlasHeight
+    );
+    return region;
+}
+
+bool writeUint32( FILE* const file, const uint32 value ) {
+    return std::fwrite( &value, sizeof( value ), 1, file ) == 1;
+}
+
+bool readUint32( FILE* const file, uint32& valueOut ) {
+    return std::fread( &valueOut, sizeof( valueOut ), 1, file ) == 1;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+SkylinePacker::SkylinePacker() {
+    reset( 0, 0 );
+}
+
+SkylinePacker::SkylinePacker( const int32 width, const int32 height ) {
+    reset( width, height );
+}
+
+/*
+SkylinePacker::reset
+--------------------
+
+Description:
+    Forgets everything that has been packed so far and starts packing into an empty width x height rectangle.
+
+Arguments:
+    width:   Width of the rectangle to pack into.
+    height:  Height of the rectangle to pack into.
+
+Returns:
+    N/A
+*/
+void SkylinePacker::reset( const int32 width, const int32 height ) {
+    m_width    = width;
+    m_height   = height;
+    m_usedArea = 0;
+
+    m_skyline.clear();
+    m_skyline.push_back( { 0, 0, width } );
+}
+
+/*
+SkylinePacker::insert
+---------------------
+
+Description:
+    Finds a place for a width x height rectangle and marks it as occupied.
+    Of the places the rectangle fits, the one where its bottom edge ends up highest is chosen;
+    ties go to the narrowest skyline segment, which leaves wider segments free for wider rectangles.
+
+Arguments:
+    width:        Width of the rectangle.
+    height:       Height of the rectangle.
+    positionOut:  Receives the top-left corner of the rectangle if a place was found.
+
+Returns:
+    bool:         true if the rectangle was placed, false if there was no room left for it (or it was empty).
+*/
+bool SkylinePacker::insert( const int32 width, const int32 height, Point2i& positionOut ) {
+    if( width <= 0 || height <= 0 )
+        return false;
+
+    std::size_t bestIndex  = m_skyline.size();
+    int32       bestBottom = std::numeric_limits< int32 >::max();
+    int32       bestWidth  = std::numeric_limits< int32 >::max();
+    int32       bestY      = 0;
+
+    for( std::size_t i = 0; i < m_skyline.size(); ++i ) {
+        int32 y;
+        if( !fit( i, width, height, y ) )
+            continue;
+
+        const int32 bottom = y + height;
+        if( bottom < bestBottom || ( bottom == bestBottom && m_skyline[i].width < bestWidth ) ) {
+            bestIndex  = i;
+            bestBottom = bottom;
+            bestWidth  = m_skyline[i].width;
+            bestY      = y;
+        }
+    }
+
+    if( bestIndex == m_skyline.size() )
+        return false;
+
+    const int32 x = m_skyline[ bestIndex ].x;
+    m_skyline.insert( m_skyline.begin() + bestIndex, { x, bestY + height, width } );
+
+    //Trim the segments the new segment now covers
+    for( std::size_t i = bestIndex + 1; i < m_skyline.size(); ) {
+        const Segment& previous = m_skyline[ i - 1 ];
+        const int32    overlap  = previous.x + previous.width - m_skyline[i].x;
+        if( overlap <= 0 )
+            break;
+
+        m_skyline[i].x     += overlap;
+        m_skyline[i].width -= overlap;
+        if( m_skyline[i].width > 0 )
+            break;
+
+        m_skyline.erase( m_skyline.begin() + i );
+    }
+
+    //Merge neighbouring segments at the same height
+    for( std::size_t i = 0; i + 1 < m_skyline.size(); ) {
+        if( m_skyline[i].y == m_skyline[ i + 1 ].y ) {
+            m_skyline[i].width += m_skyline[ i + 1 ].width;
+            m_skyline.erase( m_skyline.begin() + i + 1 );
+        } else {
+            ++i;
+        }
+    }
+
+    m_usedArea += (std::size_t)width * height;
+    positionOut.set( x, bestY );
+    return true;
+}
+
+/*
+SkylinePacker::fit
+------------------
+
+Description:
+    Determines whether a width x height rectangle whose left edge is aligned with the given skyline segment fits in the packing area,
+    and if so, how far down it has to go to sit on top of every segment it spans.
+
+Arguments:
+    index:   Index of the skyline segment.
+    width:   Width of the rectangle.
+    height:  Height of the rectangle.
+    yOut:    Receives the top edge of the rectangle if it fits.
+
+Returns:
+    bool:    true if the rectangle fits, false otherwise.
+*/
+bool SkylinePacker::fit( const std::size_t index, const int32 width, const int32 height, int32& yOut ) const {
+    if( m_skyline[ index ].x + width > m_width )
+        return false;
+
+    int32 y         = 0;
+    int32 remaining = width;
+    for( std::size_t i = index; remaining > 0; ++i ) {
+        y = std::max( y, m_skyline[i].y );
+        if( y + height > m_height )
+            return false;
+        remaining -= m_skyline[i].width;
+    }
+
+    yOut = y;
+    return true;
+}
+
+int32 SkylinePacker::getWidth() const {
+    return m_width;
+}
+
+int32 SkylinePacker::getHeight() const {
+    return m_height;
+}
+
+std::size_t SkylinePacker::getUsedArea() const {
+    return m_usedArea;
+}
+
+/*
+SkylinePacker::getOccupancy
+---------------------------
+
+Description:
+    Returns the fraction of the packing area that has been handed out by insert().
+
+Arguments:
+    N/A
+
+Returns:
+    float:  A number between 0 and 1.
+*/
+float SkylinePacker::getOccupancy() const {
+    if( m_width <= 0 || m_height <= 0 )
+        return 0.0f;
+    return (float)m_usedArea / ( (float)m_width * m_height );
+}
+
+
+
+
+TextureAtlasBuilder::TextureAtlasBuilder() :
+    m_padding( 0 ) {
+}
+
+TextureAtlasBuilder::TextureAtlasBuilder( const int32 width, const int32 height, const int32 padding ) {
+    reset( width, height, padding );
+}
+
+/*
+TextureAtlasBuilder::reset
+--------------------------
+
+Description:
+    Discards every image added so far and starts over with an empty (transparent black) width x height atlas.
+
+Arguments:
+    width:    Width of the atlas, in pixels.
+    height:   Height of the atlas, in pixels.
+    padding:  Number of pixels of padding placed around each image.
+
+Returns:
+    N/A
+*/
+void TextureAtlasBuilder::reset( const int32 width, const int32 height, const int32 padding ) {
+    m_packer.reset( width, height );
+    m_padding = padding;
+    m_pixels.assign( (std::size_t)width * height * BYTES_PER_PIXEL, 0 );
+    m_regions.clear();
+}
+
+const AtlasRegion* TextureAtlasBuilder::add( const ustring& name, const Image& image ) {
+    const Size2i size = image.getSize();
+    return add( name, image.getData(), size.width, size.height, image.getStride() );
+}
+
+/*
+TextureAtlasBuilder::add
+------------------------
+
+Description:
+    Packs an image into the atlas under the given name.
+    If an image has already been added under that name, the existing image's region is returned instead.
+
+Arguments:
+    name:                The name to find the image by.
+    pixels:              RGBA8 pixels of the image.
+    width:               Width of the image.
+    height:              Height of the image.
+    stride:              Number of bytes between the starts of consecutive rows of pixels, or 0 if they're tightly packed.
+
+Returns:
+    const AtlasRegion*:  The region the image was packed into, or nullptr if the image is empty or there wasn't enough room left
+                         in the atlas.
+                         The region remains valid until the atlas is reset.
+*/
+const AtlasRegion* TextureAtlasBuilder::add( const ustring& name, const ubyte* const pixels, const int32 width, const int32 height, const std::size_t stride ) {
+    const AtlasRegion* existing = find( name );
+    if( existing != nullptr )
+        return existing;
+
+    //Empty images have nothing to pack; with padding they would still be placed and read outside of pixels
+    if( pixels == nullptr || width <= 0 || height <= 0 )
+        return nullptr;
+
+    Point2i position;
+    if( !m_packer.insert( width + 2*m_padding, height + 2*m_padding, position ) )
+        return nullptr;
+
+    const std::size_t atlasStride = m_packer.getWidth() * BYTES_PER_PIXEL;
+    writePadded( pixels, width, height, stride != 0 ? stride : width * BYTES_PER_PIXEL, m_padding,
+                 &m_pixels[ position.y * atlasStride + position.x * BYTES_PER_PIXEL ], atlasStride );
+
+    const AtlasRegion region = makeRegion( position.x + m_padding, position.y + m_padding, width, height, m_packer.getWidth(), m_packer.getHeight() );
+    return &m_regions.emplace( name, region ).first->second;
+}
+
+const AtlasRegion* TextureAtlasBuilder::find( const ustring& name ) const {
+    auto it = m_regions.find( name );
+    if( it == m_regions.end() )
+        return nullptr;
+    return &it->second;
+}
+
+/*
+TextureAtlasBuilder::save
+-------------------------
+
+Description:
+    Saves the atlas (its pixels, the regions of the images packed into it, and the state of its packer) to the given file.
+    The file can be loaded with load(), or with TextureAtlas::load() to upload it to a texture.
+
+Arguments:
+    filename:  The path of the file to save to.
+
+Returns:
+    bool:      true if the atlas was saved successfully, false otherwise.
+*/
+bool TextureAtlasBuilder::save( const ustring& filename ) const {
+    FILE* file = std::fopen( filename.c_str(), "wb" );
+    if( file == nullptr )
+        return false;
+
+    bool ok = std::fwrite( FILE_MAGIC, sizeof( FILE_MAGIC ), 1, file ) == 1 &&
+              writeUint32( file, FILE_VERSION ) &&
+              writeUint32( file, m_packer.getWidth() ) &&
+              writeUint32( file, m_packer.getHeight() ) &&
+              writeUint32( file, m_padding ) &&
+              writeUint32( file, (uint32)m_packer.m_skyline.size() );
+
+    for( const SkylinePacker::Segment& segment : m_packer.m_skyline ) {
+        ok = ok && writeUint32( file, segment.x ) &&
+                   writeUint32( file, segment.y ) &&
+                   writeUint32( file, segment.width );
+    }
+
+    ok = ok && writeUint32( file, (uint32)m_regions.size() );
+    for( const auto& entry : m_regions ) {
+        const Bounds2i& pixels = entry.second.pixels;
+        ok = ok && writeUint32( file, (uint32)entry.first.size() ) &&
+                   std::fwrite( entry.first.data(), 1, entry.first.size(), file ) == entry.first.size() &&
+                   writeUint32( file, pixels.minX ) &&
+                   writeUint32( file, pixels.minY ) &&
+                   writeUint32( file, pixels.maxX ) &&
+                   writeUint32( file, pixels.maxY );
+    }
+
+    ok = ok && std::fwrite( m_pixels.data(), 1, m_pixels.size(), file ) == m_pixels.size();
+
+    return ( std::fclose( file ) == 0 ) && ok;
+}
+
+/*
+TextureAtlasBuilder::load
+-------------------------
+
+Description:
+    Replaces the contents of this builder with an atlas saved by save().
+    More images can be added to the atlas afterwards.
+    If the file couldn't be loaded, the builder is left empty.
+
+Arguments:
+    filename:  The path of the file to load.
+
+Returns:
+    bool:      true if the atlas was loaded successfully, false otherwise.
+*/
+bool TextureAtlasBuilder::load( const ustring& filename ) {
+    reset( 0, 0, 0 );
+
+    FILE* file = std::fopen( filename.c_str(), "rb" );
+    if( file == nullptr )
+        return false;
+
+    char   magic[ sizeof( FILE_MAGIC ) ];
+    uint32 version, width, height, padding, segmentCount;
+    bool ok = std::fread( magic, sizeof( magic ), 1, file ) == 1 &&
+              std::memcmp( magic, FILE_MAGIC, sizeof( magic ) ) == 0 &&
+              readUint32( file, version ) && version == FILE_VERSION &&
+              readUint32( file, width )   && width  <= FILE_MAX_SIZE &&
+              readUint32( file, height )  && height <= FILE_MAX_SIZE &&
+              readUint32( file, padding ) && padding <= FILE_MAX_SIZE &&
+              readUint32( file, segmentCount ) && segmentCount >= 1 && segmentCount <= width + 1;
+
+    if( ok ) {
+        reset( width, height, padding );
+
+        //The segments must cover the atlas from left to right with no gaps or overlaps, and stay inside it,
+        //or packing into the loaded atlas would write outside of its pixels
+        m_packer.m_skyline.resize( segmentCount );
+        uint32 end = 0;
+        for( SkylinePacker::Segment& segment : m_packer.m_skyline ) {
+            uint32 x = 0, y = 0, w = 0;
+            ok = ok && readUint32( file, x ) && readUint32( file, y ) && readUint32( file, w ) &&
+                 x == end && ( w > 0 || width == 0 ) && w <= width - x && y <= height;
+            segment = { (int32)x, (int32)y, (int32)w };
+            end     = x + w;
+        }
+        ok = ok && end == width;
+    }
+
+    uint32 regionCount = 0;
+    ok = ok && readUint32( file, regionCount );
+    for( uint32 i = 0; ok && i < regionCount; ++i ) {
+        uint32  nameLength, minX, minY, maxX, maxY;
+        ustring name;
+        ok = readUint32( file, nameLength ) && nameLength <= FILE_MAX_SIZE;
+        if( ok ) {
+            name.resize( nameLength );
+            ok = std::fread( name.data(), 1, nameLength, file ) == nameLength;
+        }
+        ok = ok && readUint32( file, minX ) && readUint32( file, minY ) &&
+                   readUint32( file, maxX ) && readUint32( file, maxY ) &&
+                   minX <= maxX && maxX <= width && minY <= maxY && maxY <= height;
+        if( ok ) {
+            m_regions.emplace( std::move( name ), makeRegion( minX, minY, maxX - minX, maxY - minY, width, height ) );
+            m_packer.m_usedArea += (std::size_t)( maxX - minX + 2*padding ) * ( maxY - minY + 2*padding );
+        }
+    }
+
+    ok = ok && std::fread( m_pixels.data(), 1, m_pixels.size(), file ) == m_pixels.size();
+    std::fclose( file );
+
+    if( !ok )
+        reset( 0, 0, 0 );
+    return ok;
+}
+
+int32 TextureAtlasBuilder::getWidth() const {
+    return m_packer.getWidth();
+}
+
+int32 TextureAtlasBuilder::getHeight() const {
+    return m_packer.getHeight();
+}
+
+int32 TextureAtlasBuilder::getPadding() const {
+    return m_padding;
+}
+
+const ubyte* TextureAtlasBuilder::getPixels() const {
+    return m_pixels.data();
+}
+
+const SkylinePacker& TextureAtlasBuilder::getPacker() const {
+    return m_packer;
+}
+
+const std::unordered_map< ustring, AtlasRegion >& TextureAtlasBuilder::getRegions() const {
+    return m_regions;
+}
+
+
+
+
+TextureAtlas::TextureAtlas() :
+    m_padding( 0 ),
+    m_uploads( 0 ) {
+}
+
+/*
+TextureAtlas::init{4}
+---------------------
+
+Description:
+    Creates an empty width x height atlas texture.
+
+Arguments:
+    graphics:           The Graphics to create the texture with.
+    width:              Width of the atlas, in pixels.
+    height:             Height of the atlas, in pixels.
+    padding:            Number of pixels of padding placed around each image.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the texture couldn't be created.
+*/
+void TextureAtlas::init( Graphics& graphics, const int32 width, const int32 height, const int32 padding ) {
+    destroy();
+
+    m_texture = graphics.createTexture();
+    m_texture.set( width, height, nullptr );
+    m_packer.reset( width, height );
+    m_padding = padding;
+}
+
+/*
+TextureAtlas::init{2}
+---------------------
+
+Description:
+    Creates an atlas texture from an atlas packed by a TextureAtlasBuilder.
+    The builder's images are uploaded all at once, and more images can be added to the atlas afterwards.
+
+Arguments:
+    graphics:           The Graphics to create the texture with.
+    builder:            The builder to copy the atlas from.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the texture couldn't be created.
+*/
+void TextureAtlas::init( Graphics& graphics, const TextureAtlasBuilder& builder ) {
+    destroy();
+
+    m_texture = graphics.createTexture();
+    m_texture.set( builder.getWidth(), builder.getHeight(), builder.getPixels() );
+    m_packer  = builder.getPacker();
+    m_padding = builder.getPadding();
+    m_regions = builder.getRegions();
+    ++m_uploads;
+}
+
+/*
+TextureAtlas::load
+------------------
+
+Description:
+    Creates an atlas texture from a file saved by TextureAtlasBuilder::save().
+
+Arguments:
+    graphics:           The Graphics to create the texture with.
+    filename:           The path of the file to load.
+
+Returns:
+    bool:               true if the atlas was loaded successfully, false if the file couldn't be read.
+
+Throws:
+    GraphicsException:  If the texture couldn't be created.
+*/
+bool TextureAtlas::load( Graphics& graphics, const ustring& filename ) {
+    TextureAtlasBuilder builder;
+    if( !builder.load( filename ) )
+        return false;
+
+    init( graphics, builder );
+    return true;
+}
+
+void TextureAtlas::destroy() {
+    //Move the texture into a temporary so it's released when the temporary goes out of scope
+    {
+        Texture texture( std::move( m_texture ) );
+    }
+    m_packer.reset( 0, 0 );
+    m_padding = 0;
+    m_regions.clear();
+    m_scratch.clear();
+    m_scratch.shrink_to_fit();
+    m_uploads = 0;
+}
+
+const AtlasRegion* TextureAtlas::add( const ustring& name, const Image& image ) {
+    const Size2i size = image.getSize();
+    return add( name, image.getData(), size.width, size.height, image.getStride() );
+}
+
+/*
+TextureAtlas::add
+-----------------
+
+Description:
+    Packs an image into the atlas under the given name and uploads it to the atlas texture.
+    Only the image's region of the texture is uploaded; the rest of the texture is left as it is.
+    If an image has already been added under that name, the existing image's region is returned instead.
+
+Arguments:
+    name:                The name to find the image by.
+    pixels:              RGBA8 pixels of the image.
+    width:               Width of the image.
+    height:              Height of the image.
+    stride:              Number of bytes between the starts of consecutive rows of pixels, or 0 if they're tightly packed.
+
+Returns:
+    const AtlasRegion*:  The region the image was packed into, or nullptr if the image is empty or there wasn't enough room left
+                         in the atlas.
+                         The region remains valid until the atlas is destroyed.
+
+Throws:
+    GraphicsException:   If uploading the image failed.
+*/
+const AtlasRegion* TextureAtlas::add( const ustring& name, const ubyte* const pixels, const int32 width, const int32 height, const std::size_t stride ) {
+    const AtlasRegion* existing = find( name );
+    if( existing != nullptr )
+        return existing;
+
+    //Empty images have nothing to pack; with padding they would still be placed and read outside of pixels
+    if( pixels == nullptr || width <= 0 || height <= 0 )
+        return nullptr;
+
+    const int32 paddedWidth  = width  + 2*m_padding;
+    const int32 paddedHeight = height + 2*m_padding;
+
+    Point2i position;
+    if( !m_packer.insert( paddedWidth, paddedHeight, position ) )
+        return nullptr;
+
+    m_scratch.resize( (std::size_t)paddedWidth * paddedHeight * BYTES_PER_PIXEL );
+    writePadded( pixels, width, height, stride != 0 ? stride : width * BYTES_PER_PIXEL, m_padding, m_scratch.data(), paddedWidth * BYTES_PER_PIXEL );
+    m_texture.setRegion( position.x, position.y, paddedWidth, paddedHeight, m_scratch.data() );
+    ++m_uploads;
+
+    const AtlasRegion region = makeRegion( position.x + m_padding, position.y + m_padding, width, height, m_packer.getWidth(), m_packer.getHeight() );
+    return &m_regions.emplace( name, region ).first->second;
+}
+
+const AtlasRegion* TextureAtlas::find( const ustring& name ) const {
+    auto it = m_regions.find( name );
+    if( it == m_regions.end() )
+        return nullptr;
+    return &it->second;
+}
+
+Texture& TextureAtlas::getTexture() {
+    return m_texture;
+}
+
+const SkylinePacker& TextureAtlas::getPacker() const {
+    return m_packer;
+}
+
+/*
+TextureAtlas::getUploadCount
+----------------------------
+
+Description:
+    Returns the number of times the atlas has uploaded pixels to its texture since it was initialized.
+
+Arguments:
+    N/A
+
+Returns:
+    std::size_t:  The number of uploads.
+*/
+std::size_t TextureAtlas::getUploadCount() const {
+    return m_uploads;
+}
+
+
+
+
+} //namespace Brimstone
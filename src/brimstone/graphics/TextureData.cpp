@@ -0,0 +1,675 @@
+/*
+graphics/TextureData.cpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See TextureData.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/TextureData.hpp>  //Header
+
+#include <brimstone/graphics/ImageFile.hpp>    //Brimstone::ImageFile
+#include <brimstone/Image.hpp>                 //Brimstone::Image
+#include <brimstone/Exception.hpp>             //Brimstone::SizeException, Brimstone::FormatException, Brimstone::BoundsException
+
+#include <algorithm>                           //std::max, std::min
+#include <cmath>                               //std::pow
+#include <cstdio>                              //FILE, std::fopen, std::fread, std::fseek, std::ftell, std::fclose
+#include <cstring>                             //std::memcpy, std::memcmp
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ubyte;
+using ::Brimstone::uint32;
+using ::Brimstone::int32;
+using ::Brimstone::TextureFormat;
+
+
+
+
+//Constants
+constexpr std::size_t TextureFormatToBytesPerTexel[] {
+    1,  //R8
+    2,  //RG8
+    4,  //RGBA8
+    4,  //SRGB8_ALPHA8
+    0,  //BC1_RGBA
+    0,  //BC3_RGBA
+    0,  //BC4_R
+    0,  //BC5_RG
+    0,  //BC7_RGBA
+    0,  //ETC2_RGB8
+    0   //ETC2_RGBA8
+};
+
+//Number of bytes in each 4x4 block of a block-compressed format
+constexpr std::size_t TextureFormatToBlockSize[] {
+    0,   //R8
+    0,   //RG8
+    0,   //RGBA8
+    0,   //SRGB8_ALPHA8
+    8,   //BC1_RGBA
+    16,  //BC3_RGBA
+    8,   //BC4_R
+    16,  //BC5_RG
+    16,  //BC7_RGBA
+    8,   //ETC2_RGB8
+    16   //ETC2_RGBA8
+};
+
+//KTX files identify their format with an OpenGL internal format
+constexpr uint32 TextureFormatToKTXFormat[] {
+    0x8229,  //R8           (GL_R8)
+    0x822B,  //RG8          (GL_RG8)
+    0x8058,  //RGBA8        (GL_RGBA8)
+    0x8C43,  //SRGB8_ALPHA8 (GL_SRGB8_ALPHA8)
+    0x83F1,  //BC1_RGBA     (GL_COMPRESSED_RGBA_S3TC_DXT1_EXT)
+    0x83F3,  //BC3_RGBA     (GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+    0x8DBB,  //BC4_R        (GL_COMPRESSED_RED_RGTC1)
+    0x8DBD,  //BC5_RG       (GL_COMPRESSED_RG_RGTC2)
+    0x8E8C,  //BC7_RGBA     (GL_COMPRESSED_RGBA_BPTC_UNORM)
+    0x9274,  //ETC2_RGB8    (GL_COMPRESSED_RGB8_ETC2)
+    0x9278   //ETC2_RGBA8   (GL_COMPRESSED_RGBA8_ETC2_EAC)
+};
+
+constexpr std::size_t TEXTURE_FORMAT_COUNT = sizeof( TextureFormatToKTXFormat ) / sizeof( TextureFormatToKTXFormat[0] );
+
+constexpr ubyte KTX_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+constexpr uint32 KTX_ENDIAN_NATIVE  = 0x04030201;
+constexpr uint32 KTX_ENDIAN_SWAPPED = 0x01020304;
+
+//Number of 32-bit fields in a KTX header following the identifier
+constexpr std::size_t KTX_HEADER_FIELDS = 13;
+
+//Largest texture (in either dimension) a KTX file is allowed to describe; anything larger is assumed to be corrupt
+constexpr uint32 KTX_MAX_SIZE = 1 << 15;
+
+
+
+
+//Functions
+uint32 swapBytes( const uint32 value ) {
+    return ( value >> 24 ) | ( ( value >> 8 ) & 0xFF00 ) | ( ( value << 8 ) & 0xFF0000 ) | ( value << 24 );
+}
+
+std::size_t alignTo4( const std::size_t value ) {
+    return ( value + 3 ) & ~(std::size_t)3;
+}
+
+//Returns a table mapping each 8-bit sRGB value to its linear value
+const float* getSRGBToLinearTable() {
+    static const struct Table {
+        float values[256];
+        Table() {
+            for( int i = 0; i < 256; ++i ) {
+                const float c = i / 255.0f;
+                values[i] = ( c <= 0.04045f ) ? c / 12.92f : std::pow( ( c + 0.055f ) / 1.055f, 2.4f );
+            }
+        }
+    } table;
+    return table.values;
+}
+
+ubyte linearToSRGB( const float value ) {
+    const float c = ( value <= 0.0031308f ) ? value * 12.92f : 1.055f * std::pow( value, 1.0f / 2.4f ) - 0.055f;
+    return (ubyte)std::min( std::max( c * 255.0f + 0.5f, 0.0f ), 255.0f );
+}
+
+/*
+downsample
+----------
+
+Description:
+    Generates the next mipmap level of an uncompressed image by averaging each 2x2 square of texels.
+    When a dimension is odd, the last row / column is averaged with itself.
+
+Arguments:
+    source:        The texels of the source level.
+    sourceWidth:   Width of the source level.
+    sourceHeight:  Height of the source level.
+    channels:      Number of 8-bit channels per texel.
+    srgb:          If true, the first three channels are sRGB-encoded and are averaged in linear space.
+    dest:          Receives the texels of the next level.
+
+Returns:
+    N/A
+*/
+void downsample( const ubyte* const source, const int32 sourceWidth, const int32 sourceHeight, const std::size_t channels, const bool srgb, ubyte* const dest ) {
+    const int32       width   = std::max( sourceWidth  / 2, 1 );
+    const int32       height  = std::max( sourceHeight / 2, 1 );
+    const std::size_t stride  = sourceWidth * channels;
+    const float*      linear  = getSRGBToLinearTable();
+
+    ubyte* out = dest;
+    for( int32 y = 0; y < height; ++y ) {
+        const ubyte* row0 = source + std::min( 2*y,     sourceHeight - 1 ) * stride;
+        const ubyte* row1 = source + std::min( 2*y + 1, sourceHeight - 1 ) * stride;
+
+        for( int32 x = 0; x < width; ++x ) {
+            const std::size_t x0 = std::min( 2*x,     sourceWidth - 1 ) * channels;
+            const std::size_t x1 = std::min( 2*x + 1, sourceWidth - 1 ) * channels;
+
+            for( std::size_t c = 0; c < channels; ++c ) {
+                if( srgb && c < 3 ) {
+                    const float sum = linear[ row0[ x0 + c ] ] + linear[ row0[ x1 + c ] ] + linear[ row1[ x0 + c ] ] + linear[ row1[ x1 + c ] ];
+                    *out++ = linearToSRGB( sum * 0.25f );
+                } else {
+                    const uint32 sum = row0[ x0 + c ] + row0[ x1 + c ] + row1[ x0 + c ] + row1[ x1 + c ];
+                    *out++ = (ubyte)( ( sum + 2 ) / 4 );
+                }
+            }
+        }
+    }
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+TextureData::TextureData() :
+    m_format( TextureFormat::RGBA8 ),
+    m_width( 0 ),
+    m_height( 0 ) {
+}
+
+/*
+TextureData::set{5}
+-------------------
+
+Description:
+    Replaces the contents of this TextureData with a single (base) level.
+
+Arguments:
+    format:          The format of the texels.
+    width:           Width of the texture.
+    height:          Height of the texture.
+    data:            The texels, or nullptr to fill the level with zeroes.
+    stride:          The number of bytes from the start of one row of texels (or of blocks, for block-compressed formats)
+                     in data to the next, or 0 if the rows are tightly packed.
+
+Returns:
+    N/A
+
+Throws:
+    SizeException:   If width or height isn't positive, or stride is smaller than a row.
+*/
+void TextureData::set( const TextureFormat format, const int32 width, const int32 height, const void* const data, const std::size_t stride ) {
+    if( width <= 0 || height <= 0 )
+        throw SizeException();
+
+    const std::size_t size    = getTextureDataSize( format, width, height );
+    const std::size_t rowSize = getTextureDataSize( format, width, 1 );
+    if( stride != 0 && stride < rowSize )
+        throw SizeException();
+
+    m_format = format;
+    m_width  = width;
+    m_height = height;
+    m_data.assign( size, 0 );
+    m_offsets.assign( { 0, size } );
+
+    if( data == nullptr )
+        return;
+    if( stride == 0 || stride == rowSize ) {
+        std::memcpy( m_data.data(), data, size );
+        return;
+    }
+    for( std::size_t row = 0; row < size / rowSize; ++row )
+        std::memcpy( &m_data[ row * rowSize ], static_cast< const ubyte* >( data ) + row * stride, rowSize );
+}
+
+//Replaces the contents of this TextureData with an RGBA8 copy of the given image
+void TextureData::set( const Image& image ) {
+    const Size2i size = image.getSize();
+    set( TextureFormat::RGBA8, size.width, size.height, image.getData(), image.getStride() );
+}
+
+/*
+TextureData::loadKTX{1}
+-----------------------
+
+Description:
+    Loads a texture from a KTX (version 1) file.
+    See loadKTX{2} for the kinds of files that are supported.
+
+Arguments:
+    filename:  The path to the file to load.
+
+Returns:
+    bool:      true if the file was loaded successfully, false otherwise.
+*/
+bool TextureData::loadKTX( const ustring& filename ) {
+    FILE* file = std::fopen( filename.c_str(), "rb" );
+    if( file == nullptr )
+        return false;
+
+    std::vector< ubyte > contents;
+    bool ok = std::fseek( file, 0, SEEK_END ) == 0;
+    const long size = ok ? std::ftell( file ) : -1;
+    ok = ok && size >= 0 && std::fseek( file, 0, SEEK_SET ) == 0;
+    if( ok ) {
+        contents.resize( size );
+        ok = std::fread( contents.data(), 1, contents.size(), file ) == contents.size();
+    }
+    std::fclose( file );
+
+    if( !ok ) {
+        clear();
+        return false;
+    }
+    return loadKTX( contents.data(), contents.size() );
+}
+
+/*
+TextureData::loadKTX{2}
+-----------------------
+
+Description:
+    Loads a texture from the contents of a KTX (version 1) file.
+    Only single 2D textures (no arrays, cube maps or 3D textures) in one of the formats in TextureFormat are supported.
+    If the file has mipmap levels, they are loaded as well.
+    If the texture couldn't be loaded, this TextureData is left empty.
+
+Arguments:
+    data:  The contents of the file.
+    size:  The size of the file, in bytes.
+
+Returns:
+    bool:  true if the texture was loaded successfully, false otherwise.
+*/
+bool TextureData::loadKTX( const void* const data, const std::size_t size ) {
+    clear();
+
+    const ubyte* bytes = static_cast< const ubyte* >( data );
+    const std::size_t headerSize = sizeof( KTX_IDENTIFIER ) + KTX_HEADER_FIELDS * sizeof( uint32 );
+    if( size < headerSize || std::memcmp( bytes, KTX_IDENTIFIER, sizeof( KTX_IDENTIFIER ) ) != 0 )
+        return false;
+
+    uint32 header[ KTX_HEADER_FIELDS ];
+    std::memcpy( header, bytes + sizeof( KTX_IDENTIFIER ), sizeof( header ) );
+
+    const bool swapped = header[0] == KTX_ENDIAN_SWAPPED;
+    if( !swapped && header[0] != KTX_ENDIAN_NATIVE )
+        return false;
+    if( swapped )
+        for( uint32& field : header )
+            field = swapBytes( field );
+
+    const uint32 internalFormat = header[4];
+    const uint32 width          = header[6];
+    const uint32 height         = header[7];
+    const uint32 depth          = header[8];
+    const uint32 arrayElements  = header[9];
+    const uint32 faces          = header[10];
+    const uint32 levels         = std::max( header[11], (uint32)1 );
+    const uint32 keyValueBytes  = header[12];
+
+    std::size_t f = 0;
+    while( f < TEXTURE_FORMAT_COUNT && TextureFormatToKTXFormat[f] != internalFormat )
+        ++f;
+
+    if( f == TEXTURE_FORMAT_COUNT || width == 0 || height == 0 || width > KTX_MAX_SIZE || height > KTX_MAX_SIZE ||
+        depth > 1 || arrayElements > 0 || faces != 1 || levels > getMipLevelCount( width, height ) )
+        return false;
+
+    const TextureFormat format = (TextureFormat)f;
+    const std::size_t   texel  = TextureFormatToBytesPerTexel[f];
+
+    std::size_t offset = headerSize + keyValueBytes;
+    for( uint32 level = 0; level < levels; ++level ) {
+        uint32 imageSize;
+        if( offset + sizeof( imageSize ) > size )
+            break;
+        std::memcpy( &imageSize, bytes + offset, sizeof( imageSize ) );
+        if( swapped )
+            imageSize = swapBytes( imageSize );
+        offset += sizeof( imageSize );
+
+        const int32       levelWidth  = getMipDimension( width,  level );
+        const int32       levelHeight = getMipDimension( height, level );
+        const std::size_t levelSize   = getTextureDataSize( format, levelWidth, levelHeight );
+        if( offset + imageSize > size )
+            break;
+
+        if( imageSize == levelSize ) {
+            m_data.insert( m_data.end(), bytes + offset, bytes + offset + levelSize );
+        } else if( texel != 0 && imageSize == alignTo4( levelWidth * texel ) * levelHeight ) {
+            //Uncompressed rows in KTX files are padded to a multiple of 4 bytes; strip the padding
+            const std::size_t rowSize   = levelWidth * texel;
+            const std::size_t rowStride = alignTo4( rowSize );
+            for( int32 y = 0; y < levelHeight; ++y )
+                m_data.insert( m_data.end(), bytes + offset + y * rowStride, bytes + offset + y * rowStride + rowSize );
+        } else {
+            break;
+        }
+
+        m_offsets.push_back( m_data.size() - levelSize );
+        offset += alignTo4( imageSize );
+    }
+
+    if( m_offsets.size() != levels ) {
+        clear();
+        return false;
+    }
+
+    m_offsets.push_back( m_data.size() );
+    m_format = format;
+    m_width  = width;
+    m_height = height;
+    return true;
+}
+
+/*
+TextureData::loadBSI{1}
+-----------------------
+
+Description:
+    Loads a texture, and any mipmap levels it has, from a .bsi file (see ImageFile).
+    If the texture couldn't be loaded, this TextureData is left empty.
+
+Arguments:
+    filename:  The path to the file to load.
+
+Returns:
+    bool:      true if the file was loaded successfully, false otherwise.
+*/
+bool TextureData::loadBSI( const ustring& filename ) {
+    clear();
+
+    ImageFile file;
+    return file.open( filename ) && decodeBSI( file );
+}
+
+/*
+TextureData::loadBSI{2}
+-----------------------
+
+Description:
+    Loads a texture, and any mipmap levels it has, from a .bsi file that's already in memory (see ImageFile).
+    If the texture couldn't be loaded, this TextureData is left empty.
+
+Arguments:
+    data:      The contents of the .bsi file. Only needs to stay valid until this function returns.
+    size:      The size of the file, in bytes.
+
+Returns:
+    bool:      true if the file was loaded successfully, false otherwise.
+*/
+bool TextureData::loadBSI( const void* const data, const std::size_t size ) {
+    clear();
+
+    ImageFile file;
+    return file.open( data, size ) && decodeBSI( file );
+}
+
+/*
+TextureData::generateMipmaps
+----------------------------
+
+Description:
+    Replaces any existing mipmap levels with levels generated from the base level by repeatedly halving it with a box filter.
+    sRGB textures are filtered in linear space.
+
+Arguments:
+    levels:            The total number of levels (including the base level) to end up with,
+                       or 0 to generate every level down to 1x1.
+
+Returns:
+    N/A
+
+Throws:
+    FormatException:   If the texture is block-compressed.
+    BoundsException:   If levels is greater than the number of levels the texture can have.
+*/
+void TextureData::generateMipmaps( const std::size_t levels ) {
+    if( !isValid() )
+        return;
+
+    if( isCompressed( m_format ) )
+        throw FormatException();
+
+    const std::size_t maxLevels = getMipLevelCount( m_width, m_height );
+    if( levels > maxLevels )
+        throw BoundsException();
+
+    const std::size_t count    = ( levels == 0 ) ? maxLevels : levels;
+    const std::size_t channels = TextureFormatToBytesPerTexel[ (std::size_t)m_format ];
+    const bool        srgb     = m_format == TextureFormat::SRGB8_ALPHA8;
+
+    m_offsets.resize( 1 );
+    std::size_t total = 0;
+    for( std::size_t level = 0; level < count; ++level )
+        total += getTextureDataSize( m_format, getMipDimension( m_width, level ), getMipDimension( m_height, level ) );
+    m_data.resize( total );
+
+    for( std::size_t level = 1; level < count; ++level ) {
+        const std::size_t source = m_offsets[ level - 1 ];
+        const std::size_t dest   = source + getTextureDataSize( m_format, getMipDimension( m_width, level - 1 ), getMipDimension( m_height, level - 1 ) );
+        downsample( &m_data[ source ], getMipDimension( m_width, level - 1 ), getMipDimension( m_height, level - 1 ), channels, srgb, &m_data[ dest ] );
+        m_offsets.push_back( dest );
+    }
+    m_offsets.push_back( total );
+}
+
+/*
+TextureData::generateMipmaps{2}
+-------------------------------
+
+Description:
+    Replaces any existing mipmap levels with levels generated by resampling each level from the one above it
+    with the given filter (see util/Resample.hpp). sRGB textures are filtered in linear space.
+
+Arguments:
+    filter:            The filter to resample each level with.
+    levels:            The total number of levels (including the base level) to end up with,
+                       or 0 to generate every level down to 1x1.
+    pool:              If this isn't nullptr, each level is resampled on this pool's threads as well as the calling thread.
+
+Returns:
+    N/A
+
+Throws:
+    FormatException:   If the texture is block-compressed.
+    BoundsException:   If levels is greater than the number of levels the texture can have.
+*/
+void TextureData::generateMipmaps( const ResampleFilter filter, const std::size_t levels, ThreadPool* const pool ) {
+    if( !isValid() )
+        return;
+
+    if( isCompressed( m_format ) )
+        throw FormatException();
+
+    const std::size_t maxLevels = getMipLevelCount( m_width, m_height );
+    if( levels > maxLevels )
+        throw BoundsException();
+
+    const std::size_t count    = ( levels == 0 ) ? maxLevels : levels;
+    const std::size_t channels = TextureFormatToBytesPerTexel[ (std::size_t)m_format ];
+    const bool        srgb     = m_format == TextureFormat::SRGB8_ALPHA8;
+
+    m_offsets.resize( 1 );
+    std::size_t total = 0;
+    for( std::size_t level = 0; level < count; ++level ) {
+        total += getTextureDataSize( m_format, getMipDimension( m_width, level ), getMipDimension( m_height, level ) );
+        m_offsets.push_back( total );
+    }
+    m_data.resize( total );
+
+    for( std::size_t level = 1; level < count; ++level ) {
+        resample( &m_data[ m_offsets[ level - 1 ] ], getMipDimension( m_width, level - 1 ), getMipDimension( m_height, level - 1 ), 0,
+                  &m_data[ m_offsets[ level ] ],     getMipDimension( m_width, level ),     getMipDimension( m_height, level ),     0,
+                  channels, filter, srgb, pool );
+    }
+}
+
+void TextureData::clear() {
+    m_format = TextureFormat::RGBA8;
+    m_width  = 0;
+    m_height = 0;
+    m_data.clear();
+    m_offsets.clear();
+}
+
+//Decodes every level of an open .bsi file into this TextureData, which must be empty
+bool TextureData::decodeBSI( const ImageFile& file ) {
+    const std::size_t levels = file.getLevelCount();
+    std::size_t total = 0;
+    for( std::size_t level = 0; level < levels; ++level ) {
+        m_offsets.push_back( total );
+        total += file.getLevelSize( level );
+    }
+    m_offsets.push_back( total );
+    m_data.resize( total );
+
+    for( std::size_t level = 0; level < levels; ++level ) {
+        if( !file.decodeLevel( level, &m_data[ m_offsets[ level ] ] ) ) {
+            clear();
+            return false;
+        }
+    }
+
+    m_format = file.getFormat();
+    m_width  = file.getWidth();
+    m_height = file.getHeight();
+    return true;
+}
+
+bool TextureData::isValid() const {
+    return m_width > 0;
+}
+
+TextureFormat TextureData::getFormat() const {
+    return m_format;
+}
+
+int32 TextureData::getWidth() const {
+    return m_width;
+}
+
+int32 TextureData::getHeight() const {
+    return m_height;
+}
+
+std::size_t TextureData::getLevelCount() const {
+    return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+}
+
+const ubyte* TextureData::getLevel( const std::size_t level ) const {
+#ifdef BS_CHECK_INDEX
+    if( level >= getLevelCount() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    return m_data.data() + m_offsets[ level ];
+}
+
+std::size_t TextureData::getLevelSize( const std::size_t level ) const {
+#ifdef BS_CHECK_INDEX
+    if( level >= getLevelCount() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    return m_offsets[ level + 1 ] - m_offsets[ level ];
+}
+
+
+
+
+bool isCompressed( const TextureFormat format ) {
+    return TextureFormatToBlockSize[ (std::size_t)format ] != 0;
+}
+
+/*
+getBytesPerTexel
+----------------
+
+Description:
+    Returns the number of bytes each texel of an uncompressed format takes up.
+
+Arguments:
+    format:       The format.
+
+Returns:
+    std::size_t:  The number of bytes per texel, or 0 if the format is block-compressed.
+*/
+std::size_t getBytesPerTexel( const TextureFormat format ) {
+    return TextureFormatToBytesPerTexel[ (std::size_t)format ];
+}
+
+/*
+getMipLevelCount
+----------------
+
+Description:
+    Returns the number of levels in a complete mipmap chain (down to 1x1) for a texture of the given size, including the base level.
+
+Arguments:
+    width:        Width of the texture.
+    height:       Height of the texture.
+
+Returns:
+    std::size_t:  The number of levels, or 0 if width or height isn't positive.
+*/
+std::size_t getMipLevelCount( const int32 width, const int32 height ) {
+    if( width <= 0 || height <= 0 )
+        return 0;
+
+    std::size_t levels = 1;
+    for( int32 size = std::max( width, height ); size > 1; size /= 2 )
+        ++levels;
+    return levels;
+}
+
+int32 getMipDimension( const int32 size, const std::size_t level ) {
+    return std::max( size >> level, 1 );
+}
+
+/*
+getTextureDataSize
+------------------
+
+Description:
+    Returns the number of bytes needed to store a single width x height level of a texture in the given format.
+    Block-compressed formats are rounded up to a whole number of 4x4 blocks.
+
+Arguments:
+    format:       The format of the texture.
+    width:        Width of the level.
+    height:       Height of the level.
+
+Returns:
+    std::size_t:  The size of the level, in bytes.
+*/
+std::size_t getTextureDataSize( const TextureFormat format, const int32 width, const int32 height ) {
+    const std::size_t block = TextureFormatToBlockSize[ (std::size_t)format ];
+    if( block != 0 )
+        return (std::size_t)( ( width + 3 ) / 4 ) * ( ( height + 3 ) / 4 ) * block;
+    return (std::size_t)width * height * TextureFormatToBytesPerTexel[ (std::size_t)format ];
+}
+
+
+
+
+} //namespace Brimstone
@@ -0,0 +1,432 @@
+/*
+graphics/TextureStreamer.cpp
+----------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See TextureStreamer.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/TextureStreamer.hpp>  //Header
+
+#include <brimstone/util/ThreadPool.hpp>           //Brimstone::ThreadPool
+#include <brimstone/Image.hpp>                     //Brimstone::Image
+#include <brimstone/Exception.hpp>                 //Brimstone::BoundsException
+
+#include <algorithm>                               //std::min
+#include <cstring>                                 //std::memcpy
+#include <mutex>                                   //std::mutex, std::lock_guard
+#include <utility>                                 //std::move
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ustring;
+using ::Brimstone::ubyte;
+using ::Brimstone::TextureData;
+
+
+
+
+//Constants
+//Alignment of each upload within the streaming buffer; a multiple of every texel and block size
+constexpr std::size_t UPLOAD_ALIGNMENT = 16;
+
+constexpr ubyte PLACEHOLDER_TEXEL[4] = { 128, 128, 128, 255 };
+
+
+
+
+//Functions
+bool endsWith( const ustring& str, const char* const suffix ) {
+    const std::size_t length = std::strlen( suffix );
+    return str.size() >= length && str.compare( str.size() - length, length, suffix ) == 0;
+}
+
+/*
+decodeFile
+----------
+
+Description:
+    Decodes a .ktx, .bsi or .png file into a TextureData.
+
+Arguments:
+    filename:         The path to the file.
+    generateMipmaps:  If true and the file is a PNG (or an uncompressed .bsi file without mipmaps), a complete mipmap chain is generated for it.
+    dataOut:          Receives the decoded texture.
+
+Returns:
+    bool:             true if the file was decoded successfully, false otherwise.
+*/
+bool decodeFile( const ustring& filename, const bool generateMipmaps, TextureData& dataOut ) {
+    if( endsWith( filename, ".ktx" ) )
+        return dataOut.loadKTX( filename );
+
+    if( endsWith( filename, ".bsi" ) ) {
+        if( !dataOut.loadBSI( filename ) )
+            return false;
+        if( generateMipmaps && dataOut.getLevelCount() == 1 && !isCompressed( dataOut.getFormat() ) )
+            dataOut.generateMipmaps();
+        return true;
+    }
+
+    Brimstone::Image image;
+    if( !image.loadPNG( filename ) )
+        return false;
+
+    dataOut.set( image );
+    if( generateMipmaps )
+        dataOut.generateMipmaps();
+    return true;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+struct TextureStreamer::Entry {
+    Texture             texture;
+    TextureData         data;
+    TextureStreamState  state;
+
+    //Level currently being uploaded, and the next row of it to upload
+    std::size_t         level;
+    int32               row;
+
+    //true once at least one level has been uploaded
+    bool                drawable;
+};
+
+struct TextureStreamer::Results {
+    struct Result {
+        Handle          handle;
+        TextureData     data;
+        bool            ok;
+    };
+
+    std::mutex              mutex;
+    std::vector< Result >   results;
+};
+
+
+
+
+TextureStreamer::TextureStreamer() :
+    m_graphics( nullptr ),
+    m_pool( nullptr ),
+    m_bytesPerFrame( 0 ),
+    m_pending( 0 ),
+    m_bytesUploaded( 0 ) {
+}
+
+TextureStreamer::~TextureStreamer() {
+    destroy();
+}
+
+/*
+TextureStreamer::init
+---------------------
+
+Description:
+    Creates the resources the streamer needs to upload textures with the given Graphics.
+
+Arguments:
+    graphics:           The Graphics to create textures with.
+    pool:               The thread pool to decode textures on. It must outlive the streamer's use of it.
+    bytesPerFrame:      The largest number of bytes of texels that will be uploaded each time update() is called.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If creating any of the resources failed.
+*/
+void TextureStreamer::init( Graphics& graphics, ThreadPool& pool, const std::size_t bytesPerFrame ) {
+    destroy();
+
+    m_graphics      = &graphics;
+    m_pool          = &pool;
+    m_bytesPerFrame = bytesPerFrame;
+    m_buffer        = graphics.createStreamingBuffer( bytesPerFrame );
+    m_results       = std::make_shared< Results >();
+
+    TextureData placeholder;
+    placeholder.set( TextureFormat::RGBA8, 1, 1, PLACEHOLDER_TEXEL );
+    m_placeholder = graphics.createTexture();
+    m_placeholder.set( placeholder );
+}
+
+/*
+TextureStreamer::destroy
+------------------------
+
+Description:
+    Releases every texture loaded by the streamer, along with the streamer's own resources.
+    Textures still being decoded are discarded when their workers finish.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void TextureStreamer::destroy() {
+    //Move the resources into temporaries so they're released when the temporaries go out of scope
+    {
+        Texture         placeholder( std::move( m_placeholder ) );
+        StreamingBuffer buffer(      std::move( m_buffer      ) );
+    }
+    m_entries.clear();
+    m_uploads.clear();
+    m_results.reset();
+    m_graphics      = nullptr;
+    m_pool          = nullptr;
+    m_pending       = 0;
+    m_bytesUploaded = 0;
+}
+
+TextureStreamer::Handle TextureStreamer::load( const ustring& filename, const bool generateMipmaps ) {
+    return load( [filename, generateMipmaps]( TextureData& dataOut ) {
+        return decodeFile( filename, generateMipmaps, dataOut );
+    } );
+}
+
+/*
+TextureStreamer::load
+---------------------
+
+Description:
+    Starts loading a texture. decoder is called on a worker thread to produce the texture's texels,
+    which are then uploaded over the course of the following calls to update().
+
+Arguments:
+    decoder:  Fills the given TextureData with the texture, returning false if it failed.
+              If it throws, the texture fails to load.
+
+Returns:
+    Handle:   The handle of the texture, or INVALID_HANDLE if the streamer hasn't been initialized.
+*/
+TextureStreamer::Handle TextureStreamer::load( Decoder decoder ) {
+    if( m_pool == nullptr )
+        return INVALID_HANDLE;
+
+    const Handle handle = m_entries.size();
+
+    std::unique_ptr< Entry > entry( new Entry );
+    entry->state    = TextureStreamState::DECODING;
+    entry->level    = 0;
+    entry->row      = 0;
+    entry->drawable = false;
+    m_entries.push_back( std::move( entry ) );
+    ++m_pending;
+
+    std::shared_ptr< Results > results = m_results;
+    m_pool->post( [handle, results, decoder = std::move( decoder )]() {
+        Results::Result result { handle, TextureData(), false };
+        try {
+            result.ok = decoder( result.data ) && result.data.isValid();
+        } catch( ... ) {
+            result.ok = false;
+        }
+
+        std::lock_guard< std::mutex > l( results->mutex );
+        results->results.push_back( std::move( result ) );
+    } );
+
+    return handle;
+}
+
+/*
+TextureStreamer::update
+-----------------------
+
+Description:
+    Prepares textures that have finished decoding for upload and uploads as many of their texels as this frame's budget allows.
+    This should be called once per frame, from the thread that renders.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If creating or uploading to a texture failed.
+*/
+void TextureStreamer::update() {
+    if( m_graphics == nullptr )
+        return;
+
+    std::vector< Results::Result > decoded;
+    {
+        std::lock_guard< std::mutex > l( m_results->mutex );
+        decoded.swap( m_results->results );
+    }
+
+    for( Results::Result& result : decoded ) {
+        Entry& entry = *m_entries[ result.handle ];
+        if( !result.ok || !m_graphics->isTextureFormatSupported( result.data.getFormat() ) ) {
+            entry.state = TextureStreamState::FAILED;
+            --m_pending;
+            continue;
+        }
+
+        entry.data    = std::move( result.data );
+        entry.texture = m_graphics->createTexture();
+        entry.texture.setStorage( entry.data.getWidth(), entry.data.getHeight(), entry.data.getFormat(), entry.data.getLevelCount() );
+        entry.state   = TextureStreamState::UPLOADING;
+        entry.level   = entry.data.getLevelCount() - 1;
+        entry.row     = 0;
+        m_uploads.push_back( result.handle );
+    }
+
+    m_bytesUploaded = 0;
+    if( m_uploads.empty() )
+        return;
+
+    m_buffer.beginFrame();
+    while( !m_uploads.empty() && upload( *m_entries[ m_uploads.front() ] ) )
+        m_uploads.pop_front();
+    m_buffer.endFrame();
+}
+
+void TextureStreamer::setPlaceholder( const TextureData& data ) {
+    m_placeholder.set( data );
+}
+
+Texture& TextureStreamer::getPlaceholder() {
+    return m_placeholder;
+}
+
+/*
+TextureStreamer::getTexture
+---------------------------
+
+Description:
+    Returns the texture with the given handle if at least one of its levels has been uploaded,
+    or the placeholder texture otherwise (including if the texture failed to load).
+
+Arguments:
+    handle:    The handle of the texture.
+
+Returns:
+    Texture&:  The texture to draw with.
+*/
+Texture& TextureStreamer::getTexture( const Handle handle ) {
+    if( handle < m_entries.size() && m_entries[ handle ]->drawable )
+        return m_entries[ handle ]->texture;
+    return m_placeholder;
+}
+
+TextureStreamState TextureStreamer::getState( const Handle handle ) const {
+    if( handle >= m_entries.size() )
+        throw BoundsException();
+    return m_entries[ handle ]->state;
+}
+
+bool TextureStreamer::isReady( const Handle handle ) const {
+    return handle < m_entries.size() && m_entries[ handle ]->state == TextureStreamState::READY;
+}
+
+//Returns the number of textures that are still decoding or uploading
+std::size_t TextureStreamer::getPendingCount() const {
+    return m_pending;
+}
+
+std::size_t TextureStreamer::getBytesPerFrame() const {
+    return m_bytesPerFrame;
+}
+
+//Returns the number of bytes of texels uploaded by the last call to update()
+std::size_t TextureStreamer::getBytesUploaded() const {
+    return m_bytesUploaded;
+}
+
+/*
+TextureStreamer::upload
+-----------------------
+
+Description:
+    Uploads as much of the given texture as fits in what's left of this frame's budget.
+    Levels are uploaded whole rows (or for block-compressed formats, whole rows of blocks) at a time.
+
+Arguments:
+    entry:  The texture to upload.
+
+Returns:
+    bool:   true if the texture is done uploading (or failed), false if the budget ran out first.
+*/
+bool TextureStreamer::upload( Entry& entry ) {
+    const TextureFormat format      = entry.data.getFormat();
+    const int32         rowsPerStep = isCompressed( format ) ? 4 : 1;
+
+    while( true ) {
+        const int32       width     = getMipDimension( entry.data.getWidth(),  entry.level );
+        const int32       height    = getMipDimension( entry.data.getHeight(), entry.level );
+        const std::size_t stepSize  = getTextureDataSize( format, width, std::min( rowsPerStep, height ) );
+        const std::size_t remaining = m_buffer.getRemaining();
+        const std::size_t steps     = ( remaining > UPLOAD_ALIGNMENT ) ? ( remaining - UPLOAD_ALIGNMENT ) / stepSize : 0;
+
+        if( steps == 0 ) {
+            //A single row that doesn't fit in an empty region will never fit
+            if( remaining == m_buffer.getRegionSize() ) {
+                entry.state = TextureStreamState::FAILED;
+                entry.data.clear();
+                --m_pending;
+                return true;
+            }
+            return false;
+        }
+
+        const int32       rows   = (int32)std::min< std::size_t >( steps * rowsPerStep, height - entry.row );
+        const std::size_t start  = getTextureDataSize( format, width, entry.row );
+        const std::size_t bytes  = getTextureDataSize( format, width, rows );
+        std::size_t       offset;
+
+        void* dest = m_buffer.allocate( bytes, UPLOAD_ALIGNMENT, offset );
+        std::memcpy( dest, entry.data.getLevel( entry.level ) + start, bytes );
+        entry.texture.setRegion( entry.level, 0, entry.row, width, rows, m_buffer, offset );
+
+        m_bytesUploaded += bytes;
+        entry.row       += rows;
+        if( entry.row < height )
+            continue;
+
+        //The level is complete; start drawing with it
+        entry.texture.setBaseLevel( entry.level );
+        entry.drawable = true;
+        entry.row      = 0;
+
+        if( entry.level == 0 ) {
+            entry.state = TextureStreamState::READY;
+            entry.data.clear();
+            --m_pending;
+            return true;
+        }
+        --entry.level;
+    }
+}
+
+
+
+
+} //namespace Brimstone
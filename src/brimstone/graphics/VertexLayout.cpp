@@ -0,0 +1,252 @@
+/*
+graphics/VertexLayout.cpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See VertexLayout.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/graphics/VertexLayout.hpp>  //Header
+
+#include <brimstone/Exception.hpp>              //Brimstone::GraphicsException, Brimstone::BoundsException
+
+
+
+
+namespace {
+
+
+
+
+//Constants
+constexpr std::size_t vertexAttributeTypeSizeMap[] = {
+    1,  //<= BYTE
+    1,  //<= UNSIGNED_BYTE
+    2,  //<= SHORT
+    2,  //<= UNSIGNED_SHORT
+    4,  //<= INT
+    4,  //<= UNSIGNED_INT
+    2,  //<= HALF_FLOAT
+    4   //<= FLOAT
+};
+
+//Attributes whose offsets are calculated automatically are aligned to this many bytes.
+//Most hardware fetches vertex attributes in 4-byte units; misaligned attributes can take a slow path in the driver.
+constexpr std::size_t AUTO_ALIGNMENT = 4;
+
+constexpr std::size_t alignUp( const std::size_t value, const std::size_t alignment ) {
+    return ( value + alignment - 1 ) / alignment * alignment;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+VertexLayout::VertexLayout() :
+    m_count( 0 ),
+    m_stride( 0 ),
+    m_explicitStride( false ),
+    m_divisor( 0 ) {
+}
+
+/*
+VertexLayout::add{1}
+--------------------
+
+Description:
+    Appends an attribute to the layout.
+    The attribute is placed immediately after the last attribute in the layout (aligned to 4 bytes).
+    Unless a stride was set explicitly, the stride grows to accommodate the attribute.
+
+Arguments:
+    index:       The shader attribute location this attribute is fed to.
+    count:       The number of components the attribute has (1, 2, 3, or 4).
+    type:        The data type of each component.
+    normalized:  If true, integer components are normalized to [0,1] or [-1,1] when read by the shader as floats.
+
+Returns:
+    VertexLayout&:      This layout, so calls can be chained.
+
+Throws:
+    GraphicsException:  If count is not between 1 and 4, or the layout already has MAX_ATTRIBUTES attributes.
+*/
+VertexLayout& VertexLayout::add( const uint index, const uint count, const VertexAttributeType type, const bool normalized ) {
+    std::size_t offset = 0;
+    for( std::size_t i = 0; i < m_count; ++i ) {
+        const VertexAttribute& a = m_attributes[i];
+        std::size_t end = a.offset + a.count * getVertexAttributeTypeSize( a.type );
+        if( end > offset )
+            offset = end;
+    }
+    return add( index, count, type, normalized, alignUp( offset, AUTO_ALIGNMENT ) );
+}
+
+/*
+VertexLayout::add{2}
+--------------------
+
+Description:
+    Adds an attribute to the layout at the given offset.
+
+Arguments:
+    index:       The shader attribute location this attribute is fed to.
+    count:       The number of components the attribute has (1, 2, 3, or 4).
+    type:        The data type of each component.
+    normalized:  If true, integer components are normalized to [0,1] or [-1,1] when read by the shader as floats.
+    offset:      Distance, in bytes, between the start of a vertex and the start of this attribute.
+
+Returns:
+    VertexLayout&:      This layout, so calls can be chained.
+
+Throws:
+    GraphicsException:  If count is not between 1 and 4, or the layout already has MAX_ATTRIBUTES attributes.
+*/
+VertexLayout& VertexLayout::add( const uint index, const uint count, const VertexAttributeType type, const bool normalized, const std::size_t offset ) {
+    return addAttribute( VertexAttribute { index, count, type, normalized, false, offset, m_divisor } );
+}
+
+/*
+VertexLayout::addInteger
+------------------------
+
+Description:
+    Appends an integer attribute to the layout.
+    Unlike attributes added with add(), the shader reads integer attributes as integers (int, ivec2, uvec4, etc) rather than converting them to floats.
+
+Arguments:
+    index:  The shader attribute location this attribute is fed to.
+    count:  The number of components the attribute has (1, 2, 3, or 4).
+    type:   The data type of each component. Must be an integer type.
+
+Returns:
+    VertexLayout&:      This layout, so calls can be chained.
+
+Throws:
+    GraphicsException:  If type is a floating point type, count is not between 1 and 4,
+                        or the layout already has MAX_ATTRIBUTES attributes.
+*/
+VertexLayout& VertexLayout::addInteger( const uint index, const uint count, const VertexAttributeType type ) {
+    if( type == VertexAttributeType::HALF_FLOAT || type == VertexAttributeType::FLOAT )
+        throw GraphicsException( "Integer vertex attributes must have an integer type." );
+
+    add( index, count, type, false );
+    m_attributes[ m_count - 1 ].integer = true;
+    return *this;
+}
+
+VertexLayout& VertexLayout::addAttribute( const VertexAttribute& attribute ) {
+    if( attribute.count < 1 || attribute.count > 4 )
+        throw GraphicsException( "Vertex attributes must have between 1 and 4 components." );
+    if( m_count == MAX_ATTRIBUTES )
+        throw GraphicsException( "Vertex layout has too many attributes." );
+
+    m_attributes[ m_count++ ] = attribute;
+
+    //Grow the stride to fit the new attribute unless the user told us what it should be
+    if( !m_explicitStride ) {
+        std::size_t end = alignUp( attribute.offset + attribute.count * getVertexAttributeTypeSize( attribute.type ), AUTO_ALIGNMENT );
+        if( end > m_stride )
+            m_stride = end;
+    }
+
+    return *this;
+}
+
+/*
+VertexLayout::setStride
+-----------------------
+
+Description:
+    Sets the distance, in bytes, between the start of consecutive vertices.
+    By default the stride is calculated from the attributes in the layout;
+    this can be used to add padding or to interleave data the layout doesn't describe.
+
+Arguments:
+    stride:  The distance between consecutive vertices, in bytes.
+
+Returns:
+    VertexLayout&:  This layout, so calls can be chained.
+*/
+VertexLayout& VertexLayout::setStride( const std::size_t stride ) {
+    m_stride         = stride;
+    m_explicitStride = true;
+    return *this;
+}
+
+/*
+VertexLayout::setDivisor
+------------------------
+
+Description:
+    Sets the divisor of every attribute in the layout, including attributes added afterwards.
+    A divisor of 0 makes attributes advance once per vertex.
+    A divisor of N makes attributes advance once every N instances, which is how per-instance data is supplied to instanced draws.
+
+Arguments:
+    divisor:  The divisor to use.
+
+Returns:
+    VertexLayout&:  This layout, so calls can be chained.
+*/
+VertexLayout& VertexLayout::setDivisor( const uint divisor ) {
+    m_divisor = divisor;
+    for( std::size_t i = 0; i < m_count; ++i )
+        m_attributes[i].divisor = divisor;
+    return *this;
+}
+
+void VertexLayout::clear() {
+    m_count          = 0;
+    m_stride         = 0;
+    m_explicitStride = false;
+    m_divisor        = 0;
+}
+
+std::size_t VertexLayout::getStride() const {
+    return m_stride;
+}
+
+std::size_t VertexLayout::getAttributeCount() const {
+    return m_count;
+}
+
+const VertexAttribute& VertexLayout::getAttribute( const std::size_t i ) const {
+    if( i >= m_count )
+        throw BoundsException();
+    return m_attributes[i];
+}
+
+const VertexAttribute* VertexLayout::begin() const {
+    return m_attributes;
+}
+
+const VertexAttribute* VertexLayout::end() const {
+    return m_attributes + m_count;
+}
+
+bool VertexLayout::empty() const {
+    return m_count == 0;
+}
+
+std::size_t getVertexAttributeTypeSize( const VertexAttributeType type ) {
+    return vertexAttributeTypeSizeMap[ (std::size_t)type ];
+}
+
+
+
+
+} //namespace Brimstone
@@ -0,0 +1,77 @@
+/*
+linux/LinuxMappedFile.cpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See LinuxMappedFile.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include "LinuxMappedFile.hpp"  //Header
+
+#include <fcntl.h>              //open, O_RDONLY, O_CLOEXEC
+#include <sys/mman.h>           //mmap, munmap, PROT_READ, MAP_PRIVATE, MAP_FAILED
+#include <sys/stat.h>           //fstat, struct stat
+#include <unistd.h>             //close
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+LinuxMappedFile::LinuxMappedFile() :
+    m_data( nullptr ),
+    m_size( 0 ) {
+}
+
+LinuxMappedFile::~LinuxMappedFile() {
+    if( m_data != nullptr )
+        munmap( m_data, m_size );
+}
+
+bool LinuxMappedFile::open( const ustring& filename ) {
+    const int file = ::open( filename.c_str(), O_RDONLY | O_CLOEXEC );
+    if( file < 0 )
+        return false;
+
+    struct stat info;
+    if( fstat( file, &info ) != 0 || !S_ISREG( info.st_mode ) ) {
+        ::close( file );
+        return false;
+    }
+
+    //Empty files can't be mapped, but there's nothing to map anyway
+    if( info.st_size > 0 ) {
+        void* const data = mmap( nullptr, (std::size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+        if( data == MAP_FAILED ) {
+            ::close( file );
+            return false;
+        }
+        m_data = data;
+        m_size = (std::size_t)info.st_size;
+    }
+
+    //The mapping keeps its own reference to the file
+    ::close( file );
+    return true;
+}
+
+const ubyte* LinuxMappedFile::getData() const {
+    return static_cast< const ubyte* >( m_data );
+}
+
+std::size_t LinuxMappedFile::getSize() const {
+    return m_size;
+}
+
+
+
+
+} //namespace Brimstone::Private
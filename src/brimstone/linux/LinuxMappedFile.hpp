@@ -0,0 +1,53 @@
+/*
+linux/LinuxMappedFile.hpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    LinuxMappedFile is defined here.
+    It maps files into memory with mmap().
+*/
+#ifndef BS_LINUX_LINUXMAPPEDFILE_HPP
+#define BS_LINUX_LINUXMAPPEDFILE_HPP
+
+
+
+
+//Includes
+#include <cstddef>              //std::size_t
+
+#include <brimstone/types.hpp>  //Brimstone::ustring, Brimstone::ubyte
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+class LinuxMappedFile {
+public:
+    LinuxMappedFile();
+    LinuxMappedFile( const LinuxMappedFile& toCopy ) = delete;
+    LinuxMappedFile& operator =( const LinuxMappedFile& toCopy ) = delete;
+    ~LinuxMappedFile();
+
+    bool         open( const ustring& filename );
+
+    const ubyte* getData() const;
+    std::size_t  getSize() const;
+private:
+    void*       m_data;
+    std::size_t m_size;
+};
+
+
+
+
+} //namespace Brimstone::Private
+
+
+
+
+#endif //BS_LINUX_LINUXMAPPEDFILE_HPP
@@ -18,6 +18,15 @@ Description:
 
 #include <GL/glx.h>               //GLX*, glX*
 
+//EGL is loaded at runtime, so its functions are loaded into the pointers below rather than declared
+#define EGL_EGL_PROTOTYPES 0
+#include <EGL/egl.h>              //EGL*, PFNEGL*PROC
+#include <EGL/eglext.h>           //EGL_PLATFORM_SURFACELESS_MESA, PFNEGLGETPLATFORMDISPLAYEXTPROC
+
+#include <dlfcn.h>                //dlopen, dlsym, dlclose
+
+#include <memory>                 //std::unique_ptr
+
 
 
 
@@ -35,6 +44,24 @@ GLXSWAPINTERVALEXTPROC glXSwapIntervalEXT = nullptr;
 //TEMP
 #define GLX_SWAP_INTERVAL_EXT 0x20F1
 
+PFNEGLGETPROCADDRESSPROC        eglGetProcAddress       = nullptr;
+PFNEGLQUERYSTRINGPROC           eglQueryString          = nullptr;
+PFNEGLGETDISPLAYPROC            eglGetDisplay           = nullptr;
+PFNEGLINITIALIZEPROC            eglInitialize           = nullptr;
+PFNEGLTERMINATEPROC             eglTerminate            = nullptr;
+PFNEGLBINDAPIPROC               eglBindAPI              = nullptr;
+PFNEGLCHOOSECONFIGPROC          eglChooseConfig         = nullptr;
+PFNEGLCREATECONTEXTPROC         eglCreateContext        = nullptr;
+PFNEGLDESTROYCONTEXTPROC        eglDestroyContext       = nullptr;
+PFNEGLCREATEPBUFFERSURFACEPROC  eglCreatePbufferSurface = nullptr;
+PFNEGLDESTROYSURFACEPROC        eglDestroySurface       = nullptr;
+PFNEGLMAKECURRENTPROC           eglMakeCurrent          = nullptr;
+PFNEGLGETCURRENTCONTEXTPROC     eglGetCurrentContext    = nullptr;
+
+//Constants
+//Tried in order when loading EGL
+constexpr const char* EGL_LIBRARY_NAMES[] = { "libEGL.so.1", "libEGL.so" };
+
 /*
 isExtensionSupported
 --------------------
@@ -92,6 +119,40 @@ bool isExtensionSupported( const char* extensions, const char* extension ) {
     }
 }
 
+/*
+loadEGL
+-------
+
+Description:
+    Loads the EGL functions used by offscreen contexts from the given library.
+
+Arguments:
+    library:  A handle to libEGL returned by dlopen().
+
+Returns:
+    bool:     true if every function was loaded, false otherwise.
+*/
+bool loadEGL( void* library ) {
+    eglGetProcAddress       = (PFNEGLGETPROCADDRESSPROC)dlsym(       library, "eglGetProcAddress"       );
+    eglQueryString          = (PFNEGLQUERYSTRINGPROC)dlsym(          library, "eglQueryString"          );
+    eglGetDisplay           = (PFNEGLGETDISPLAYPROC)dlsym(           library, "eglGetDisplay"           );
+    eglInitialize           = (PFNEGLINITIALIZEPROC)dlsym(           library, "eglInitialize"           );
+    eglTerminate            = (PFNEGLTERMINATEPROC)dlsym(            library, "eglTerminate"            );
+    eglBindAPI              = (PFNEGLBINDAPIPROC)dlsym(              library, "eglBindAPI"              );
+    eglChooseConfig         = (PFNEGLCHOOSECONFIGPROC)dlsym(         library, "eglChooseConfig"         );
+    eglCreateContext        = (PFNEGLCREATECONTEXTPROC)dlsym(        library, "eglCreateContext"        );
+    eglDestroyContext       = (PFNEGLDESTROYCONTEXTPROC)dlsym(       library, "eglDestroyContext"       );
+    eglCreatePbufferSurface = (PFNEGLCREATEPBUFFERSURFACEPROC)dlsym( library, "eglCreatePbufferSurface" );
+    eglDestroySurface       = (PFNEGLDESTROYSURFACEPROC)dlsym(       library, "eglDestroySurface"       );
+    eglMakeCurrent          = (PFNEGLMAKECURRENTPROC)dlsym(          library, "eglMakeCurrent"          );
+    eglGetCurrentContext    = (PFNEGLGETCURRENTCONTEXTPROC)dlsym(    library, "eglGetCurrentContext"    );
+
+    return eglGetProcAddress != nullptr && eglQueryString    != nullptr && eglGetDisplay           != nullptr && eglInitialize     != nullptr &&
+           eglTerminate      != nullptr && eglBindAPI        != nullptr && eglChooseConfig         != nullptr && eglCreateContext  != nullptr &&
+           eglDestroyContext != nullptr && eglMakeCurrent    != nullptr && eglCreatePbufferSurface != nullptr && eglDestroySurface != nullptr &&
+           eglGetCurrentContext != nullptr;
+}
+
 
 
 
@@ -105,18 +166,25 @@ namespace Brimstone::Private {
 
 
 
-int         LinuxGLContext::m_contextCount   = 0;
-bool        LinuxGLContext::m_glxInitialized = false;
-Display*    LinuxGLContext::m_display        = nullptr;
-GLXFBConfig LinuxGLContext::m_bestFBC        = nullptr;
-
+int         LinuxGLContext::m_contextCount    = 0;
+bool        LinuxGLContext::m_glxInitialized  = false;
+Display*    LinuxGLContext::m_display         = nullptr;
+GLXFBConfig LinuxGLContext::m_bestFBC         = nullptr;
+void*       LinuxGLContext::m_eglLibrary      = nullptr;
+EGLDisplay  LinuxGLContext::m_eglDisplay      = EGL_NO_DISPLAY;
+EGLConfig   LinuxGLContext::m_eglConfig       = nullptr;
+bool        LinuxGLContext::m_eglSurfaceless  = false;
+int         LinuxGLContext::m_eglContextCount = 0;
 
 
 
 
 LinuxGLContext::LinuxGLContext() :
     m_context( nullptr ),
-    m_window( 0 ) {
+    m_window( 0 ),
+    m_offscreen( false ),
+    m_eglContext( EGL_NO_CONTEXT ),
+    m_eglSurface( EGL_NO_SURFACE ) {
 }
 
 LinuxGLContext::LinuxGLContext( const Window& window ) :
@@ -297,6 +365,122 @@ void LinuxGLContext::destroyGLX() {
     glXCreateContextAttribsARB = nullptr;
 }
 
+/*
+LinuxGLContext::initEGL
+-----------------------
+
+Description:
+    Loads libEGL and initializes EGL, for use by offscreen contexts.
+    Mesa's surfaceless platform is used if it's available, since it doesn't need an X server or a GPU;
+    otherwise, EGL's default display is used.
+
+    If EGL has already been initialized, the function returns immediately.
+
+Arguments:
+    N/A
+
+Returns:
+    void:               N/A
+
+Throws:
+    GraphicsException:  If libEGL couldn't be loaded, or EGL couldn't be initialized with OpenGL support.
+*/
+void LinuxGLContext::initEGL() {
+    if( m_eglLibrary != nullptr )
+        return;
+
+    void* library = nullptr;
+    for( const char* name : EGL_LIBRARY_NAMES )
+        if( ( library = dlopen( name, RTLD_NOW | RTLD_LOCAL ) ) != nullptr )
+            break;
+    if( library == nullptr )
+        throw GraphicsException( "Couldn't load libEGL." );
+
+    //Automatically unload libEGL if we fail past this point
+    std::unique_ptr< void, int (*)( void* ) > uptr( library, &dlclose );
+    if( !loadEGL( library ) )
+        throw GraphicsException( "Couldn't load EGL functions." );
+
+    //Client extensions are queried without a display. EGL implementations that don't support them return nullptr here.
+    EGLDisplay display = EGL_NO_DISPLAY;
+    const char* clientExts = eglQueryString( EGL_NO_DISPLAY, EGL_EXTENSIONS );
+    if( clientExts != nullptr && isExtensionSupported( clientExts, "EGL_EXT_platform_base" ) && isExtensionSupported( clientExts, "EGL_MESA_platform_surfaceless" ) ) {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress( "eglGetPlatformDisplayEXT" );
+        if( eglGetPlatformDisplayEXT != nullptr )
+            display = eglGetPlatformDisplayEXT( EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr );
+    }
+    if( display == EGL_NO_DISPLAY )
+        display = eglGetDisplay( EGL_DEFAULT_DISPLAY );
+    if( display == EGL_NO_DISPLAY )
+        throw GraphicsException( "eglGetDisplay() failed." );
+
+    EGLint eglMajor, eglMinor;
+    if( eglInitialize( display, &eglMajor, &eglMinor ) == EGL_FALSE )
+        throw GraphicsException( "eglInitialize() failed." );
+
+    EGLConfig config = nullptr;
+    bool surfaceless;
+    try {
+        //Contexts created after this will be OpenGL contexts rather than OpenGL ES contexts
+        if( eglBindAPI( EGL_OPENGL_API ) == EGL_FALSE )
+            throw GraphicsException( "EGL doesn't support OpenGL." );
+
+        //If we can make a context current without a surface, we don't need to create a pbuffer for each context.
+        const char* eglExts = eglQueryString( display, EGL_EXTENSIONS );
+        surfaceless = eglExts != nullptr && isExtensionSupported( eglExts, "EGL_KHR_surfaceless_context" );
+
+        //Offscreen contexts render into framebuffer objects, so the config only needs to describe a color buffer.
+        //NOTE: EGL_SURFACE_TYPE is a mask of the surface types the config must support; 0 matches any config.
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE    , surfaceless ? 0 : EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE , EGL_OPENGL_BIT,
+            EGL_RED_SIZE        , 8,
+            EGL_GREEN_SIZE      , 8,
+            EGL_BLUE_SIZE       , 8,
+            EGL_ALPHA_SIZE      , 8,
+            EGL_NONE
+        };
+
+        EGLint configCount = 0;
+        if( eglChooseConfig( display, configAttribs, &config, 1, &configCount ) == EGL_FALSE || configCount == 0 )
+            throw GraphicsException( "No EGL config matching requirements could be found." );
+    } catch( ... ) {
+        eglTerminate( display );
+        throw;
+    }
+
+    m_eglLibrary     = uptr.release();
+    m_eglDisplay     = display;
+    m_eglConfig      = config;
+    m_eglSurfaceless = surfaceless;
+}
+
+/*
+LinuxGLContext::destroyEGL
+--------------------------
+
+Description:
+    Terminates EGL and unloads libEGL. Called after the last offscreen context is destroyed.
+
+Arguments:
+    N/A
+
+Returns:
+    void:  N/A
+*/
+void LinuxGLContext::destroyEGL() {
+    if( m_eglLibrary == nullptr )
+        return;
+
+    eglTerminate( m_eglDisplay );
+    dlclose( m_eglLibrary );
+
+    m_eglLibrary     = nullptr;
+    m_eglDisplay     = EGL_NO_DISPLAY;
+    m_eglConfig      = nullptr;
+    m_eglSurfaceless = false;
+}
+
 /*
 LinuxGLContext::getIdealVisualInfo
 ----------------------------------
@@ -324,14 +508,61 @@ XVisualInfo LinuxGLContext::getIdealVisualInfo( Display* display ) {
     return XVisualInfo( vi );
 }
 
-//Windowless init currently isn't supported
+/*
+LinuxGLContext::init{1}
+-----------------------
+
+Description:
+    Initialize an offscreen context.
+    This doesn't need a window or an X server; see LinuxGLContext.hpp for details.
+
+    Initializes EGL if it hasn't been already.
+
+Arguments:
+    N/A
+
+Returns:
+    void:               N/A
+
+Throws:
+    GraphicsException:  If EGL isn't available, or the context couldn't be created.
+*/
 void LinuxGLContext::init() {
-    throw NotImplementedException();
+    initEGL();
+    ++m_eglContextCount;
+
+    m_offscreen = true;
+
+    //Request a GL 3.0 or higher context, as we do with GLX
+    //NOTE: Requesting a version requires EGL 1.5 or EGL_KHR_create_context; if that fails, we settle for whatever version EGL gives us by default.
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 0,
+        EGL_NONE
+    };
+    m_eglContext = eglCreateContext( m_eglDisplay, m_eglConfig, EGL_NO_CONTEXT, contextAttribs );
+    if( m_eglContext == EGL_NO_CONTEXT )
+        m_eglContext = eglCreateContext( m_eglDisplay, m_eglConfig, EGL_NO_CONTEXT, nullptr );
+    if( m_eglContext == EGL_NO_CONTEXT )
+        throw GraphicsException( "Context creation failed." );
+
+    //A context has to be made current with a surface unless EGL_KHR_surfaceless_context is supported.
+    //We'll never render to it, so it only needs to be 1x1.
+    if( !m_eglSurfaceless ) {
+        const EGLint pbufferAttribs[] = {
+            EGL_WIDTH,  1,
+            EGL_HEIGHT, 1,
+            EGL_NONE
+        };
+        m_eglSurface = eglCreatePbufferSurface( m_eglDisplay, m_eglConfig, pbufferAttribs );
+        if( m_eglSurface == EGL_NO_SURFACE )
+            throw GraphicsException( "eglCreatePbufferSurface() failed." );
+    }
 }
 
 /*
-LinuxGLContext::init
---------------------
+LinuxGLContext::init{2}
+-----------------------
 
 Description:
     Initialize the context with the given window.
@@ -426,6 +657,21 @@ void LinuxGLContext::destroy() {
 }
 
 void LinuxGLContext::destroyContext() {
+    if( m_eglContext != EGL_NO_CONTEXT ) {
+        if( eglGetCurrentContext() == m_eglContext )
+            eglMakeCurrent( m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT );
+
+        if( m_eglSurface != EGL_NO_SURFACE ) {
+            eglDestroySurface( m_eglDisplay, m_eglSurface );
+            m_eglSurface = EGL_NO_SURFACE;
+        }
+
+        if( eglDestroyContext( m_eglDisplay, m_eglContext ) == EGL_FALSE )
+            throw GraphicsException( "eglDestroyContext() failed." );
+
+        m_eglContext = EGL_NO_CONTEXT;
+    }
+
     if( m_context != nullptr ) {
         //BUG: If m_display has been closed, e.g. because the last XWindow was destroyed, any of these glX calls that use m_display will result in a segfault.
         if( glXGetCurrentContext() == m_context )
@@ -442,22 +688,41 @@ void LinuxGLContext::destroyContext() {
 }
 
 void LinuxGLContext::destroyFinish() {
-    if( m_window != 0 )
-        m_window = 0;
+    if( m_offscreen ) {
+        m_offscreen = false;
+        if( --m_eglContextCount == 0 )
+            destroyEGL();
+        return;
+    }
 
-    if( --m_contextCount == 0 )
-        destroyGLX();
+    //Only contexts that were initialized with a window count towards GLX's context count,
+    //and they only count once, even if destroy() is called before the destructor.
+    if( m_window != 0 ) {
+        m_window = 0;
+        if( --m_contextCount == 0 )
+            destroyGLX();
+    }
 }
 
 void LinuxGLContext::begin() {
-    glXMakeCurrent( m_display, m_window, m_context );
+    if( m_offscreen )
+        eglMakeCurrent( m_eglDisplay, m_eglSurface, m_eglSurface, m_eglContext );
+    else
+        glXMakeCurrent( m_display, m_window, m_context );
 }
 
 void LinuxGLContext::end() {
-    glXMakeCurrent( m_display, 0, nullptr );
+    if( m_offscreen )
+        eglMakeCurrent( m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT );
+    else
+        glXMakeCurrent( m_display, 0, nullptr );
 }
 
+//Offscreen contexts never present anything, so vsync doesn't apply to them; this does nothing for them
 void LinuxGLContext::setVSync( const bool enabled ) {
+    if( m_offscreen )
+        return;
+
     xerrBegin();
     glXSwapIntervalEXT( m_display, m_window, enabled ? 1 : 0 );
     xerrEnd();
@@ -467,6 +732,9 @@ void LinuxGLContext::setVSync( const bool enabled ) {
 }
 
 bool LinuxGLContext::getVSync() const {
+    if( m_offscreen )
+        return false;
+
     unsigned int interval;
     xerrBegin();
     glXQueryDrawable( m_display, m_window, GLX_SWAP_INTERVAL_EXT, &interval );
@@ -477,8 +745,31 @@ bool LinuxGLContext::getVSync() const {
     return interval == 1;
 }
 
+//Offscreen contexts have nothing to swap; this does nothing for them
 void LinuxGLContext::swapBuffers() {
-    glXSwapBuffers( m_display, m_window );
+    if( !m_offscreen )
+        glXSwapBuffers( m_display, m_window );
+}
+
+/*
+LinuxGLContext::getProcAddress
+------------------------------
+
+Description:
+    Loads an OpenGL function that isn't loaded by gll (e.g. functions from extensions that aren't part of core OpenGL).
+
+Arguments:
+    name:   The name of the function.
+
+Returns:
+    void*:  A pointer to the function. This can be non-null even if the function isn't supported,
+            so check that the extension providing it is supported first.
+*/
+void* LinuxGLContext::getProcAddress( const char* const name ) {
+    //If offscreen contexts are in use, functions have to be loaded through EGL
+    if( m_eglLibrary != nullptr )
+        return (void*)eglGetProcAddress( name );
+    return (void*)glXGetProcAddressARB( reinterpret_cast<const GLubyte*>( name ) );
 }
 
 
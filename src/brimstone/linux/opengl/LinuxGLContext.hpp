@@ -5,6 +5,13 @@ Copyright (c) 2024, theJ89
 
 Description:
     Linux implementation of the OpenGL context.
+
+    Contexts created for a window use GLX.
+    Contexts created without a window are offscreen contexts, and use EGL instead, so they work without an X server
+    (e.g. on a build machine running Mesa's llvmpipe). An offscreen context has no default framebuffer to speak of,
+    so anything rendered with one should be rendered into a Framebuffer.
+    libEGL is loaded when the first offscreen context is created rather than linked against,
+    so Brimstone doesn't require it unless offscreen contexts are used.
 */
 #ifndef BS_LINUX_OPENGL_LINUXGLCONTEXT_HPP
 #define BS_LINUX_OPENGL_LINUXGLCONTEXT_HPP
@@ -17,7 +24,6 @@ Description:
 
 #include <X11/Xlib.h>              //X11
 #include <X11/Xutil.h>             //X11
-#include <X11/Xos.h>               //X11
 
 
 
@@ -26,6 +32,12 @@ Description:
 using GLXContext  = struct __GLXcontextRec*;
 using GLXFBConfig = struct __GLXFBConfigRec*;
 
+//EGL's handles are opaque pointers; egl.h is only included by the implementation
+using EGLDisplay  = void*;
+using EGLConfig   = void*;
+using EGLContext  = void*;
+using EGLSurface  = void*;
+
 
 
 
@@ -68,24 +80,40 @@ public:
     void setVSync( const bool enabled );
     bool getVSync() const;
 
-    void swapBuffers();    
+    void swapBuffers();
 private:
     void destroyContext();
     void destroyFinish();
 private:
     GLXContext m_context;
     ::Window   m_window;
+
+    //Used instead of the above by offscreen contexts.
+    //m_eglSurface is a 1x1 pbuffer, or nullptr if EGL supports making contexts current without a surface.
+    bool       m_offscreen;
+    EGLContext m_eglContext;
+    EGLSurface m_eglSurface;
 public:
     static XVisualInfo getIdealVisualInfo( Display* display );
+    static void*       getProcAddress( const char* const name );
 private:
     static void initGLX( Display* display );
     static void destroyGLX();
+    static void initEGL();
+    static void destroyEGL();
 private:
     static bool        m_glxInitialized;
     static Display*    m_display;
     static GLXFBConfig m_bestFBC;
 
     static int         m_contextCount;
+
+    static void*       m_eglLibrary;
+    static EGLDisplay  m_eglDisplay;
+    static EGLConfig   m_eglConfig;
+    static bool        m_eglSurfaceless;
+
+    static int         m_eglContextCount;
 };
 
 
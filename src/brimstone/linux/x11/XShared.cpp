@@ -13,8 +13,11 @@ Description:
 //Includes
 #include "XShared.hpp"                   //Header
 #include "XPixmap.hpp"                   //Brimstone::Private::XPixmap
+#include "XException.hpp"                //Brimstone::Private::xerrBegin, Brimstone::Private::xerrEnd
 #include "../opengl/LinuxGLContext.hpp"  //Brimstone::LinuxGLContext::getIdealVisualInfo (TEMP?)
 
+#include <X11/extensions/XInput2.h>      //X11; XIQueryVersion, XISelectEvents
+
 
 
 
@@ -38,6 +41,7 @@ int          XShared::m_screen                      = 0;
 XColormap    XShared::m_colormap;
 XInputMethod XShared::m_inputMethod;
 XCursor      XShared::m_blankCursor;
+int          XShared::m_xiOpcode                    = -1;
 ::Atom       XShared::m_atomWmDeleteWindow          = None;
 ::Atom       XShared::m_atomNetWmName               = None;
 ::Atom       XShared::m_atomNetWmState              = None;
@@ -99,6 +103,19 @@ void XShared::init() {
     //Create a blank cursor:
     createBlankCursor();
 
+    //Check for XInput 2, which raw mouse input uses.
+    //NOTE:
+    //    XIQueryVersion() tells the server which version of the protocol we speak; we ask for 2.1 because scroll valuators were added in it.
+    //    If the server only has 2.0, it replies with that instead; raw motion still works, but devices won't report any scroll valuators.
+    int xiEvent, xiError;
+    if( XQueryExtension( display, "XInputExtension", &m_xiOpcode, &xiEvent, &xiError ) ) {
+        int major = 2, minor = 1;
+        if( XIQueryVersion( display, &major, &minor ) != Success || major < 2 )
+            m_xiOpcode = -1;
+    } else {
+        m_xiOpcode = -1;
+    }
+
     //Look up various Atoms we use:
     //NOTE:
     //    An Atom is basically just an association of a unique name (e.g. "SOME_ATOM_NAME") with a unique ID number (e.g. 12345).
@@ -151,6 +168,9 @@ void XShared::destroy() {
     m_atomNetWmName               = None;
     m_atomWmDeleteWindow          = None;
 
+    //Forget about XInput 2:
+    m_xiOpcode = -1;
+
     //Destroy blank cursor:
     m_blankCursor.destroy();
 
@@ -218,6 +238,55 @@ void XShared::createBlankCursor() {
     m_blankCursor.create( pixmap, pixmap, &color, &color, 0, 0 );
 }
 
+/*
+XShared::selectRawEvents
+------------------------
+
+Description:
+    Starts or stops listening for XInput 2 raw motion events from every pointer, along with the events that say a device
+    has been added, removed or changed (so information about its scroll valuators can be updated).
+    Raw events aren't sent to any particular window, so they're selected on the root window; there's one selection for the whole display.
+    Does nothing if XInput 2 isn't supported.
+
+Arguments:
+    select:      true to start receiving raw events, false to stop.
+
+Returns:
+    N/A
+
+Throws:
+    XException:  If a call to an Xlib function fails.
+*/
+void XShared::selectRawEvents( const bool select ) {
+    if( m_xiOpcode == -1 )
+        return;
+
+    unsigned char rawMask[ XIMaskLen( XI_RawMotion ) ]           = {};
+    unsigned char deviceMask[ XIMaskLen( XI_HierarchyChanged ) ] = {};
+    if( select ) {
+        XISetMask( rawMask, XI_RawMotion );
+        XISetMask( rawMask, XI_DeviceChanged );
+        XISetMask( deviceMask, XI_HierarchyChanged );
+    }
+
+    //Raw events are selected on the master pointers; hierarchy changes can only be selected for all devices.
+    //Selecting an empty mask clears the selection.
+    XIEventMask masks[2];
+    masks[0].deviceid = XIAllMasterDevices;
+    masks[0].mask_len = sizeof( rawMask );
+    masks[0].mask     = rawMask;
+    masks[1].deviceid = XIAllDevices;
+    masks[1].mask_len = sizeof( deviceMask );
+    masks[1].mask     = deviceMask;
+
+    xerrBegin();
+    XISelectEvents( m_display.get(), m_rootWindow, masks, 2 );
+    XFlush( m_display.get() );
+    xerrEnd();
+    if( xerrExists() )
+        throw xerrGet();
+}
+
 
 
 
@@ -33,6 +33,7 @@ public:
     static void init();
     static void destroy();
     static void createBlankCursor();
+    static void selectRawEvents( const bool select );
 
     static inline ::Display* getDisplay() {
         return m_display.get();
@@ -62,6 +63,16 @@ public:
         return m_blankCursor.get();
     }
 
+    //Returns true if the display server supports XInput 2, which raw mouse input needs
+    static inline bool hasXInput2() {
+        return m_xiOpcode != -1;
+    }
+
+    //Returns the major opcode of the XInput extension, which identifies its GenericEvents, or -1 if XInput 2 isn't supported
+    static inline int getXIOpcode() {
+        return m_xiOpcode;
+    }
+
 private:
     static bool           m_initialized;
     static XDisplay       m_display;
@@ -71,6 +82,7 @@ private:
     static XColormap      m_colormap;
     static XInputMethod   m_inputMethod;
     static XCursor        m_blankCursor;
+    static int            m_xiOpcode;
 public:
     static Atom           m_atomWmDeleteWindow;
     static Atom           m_atomNetWmName;
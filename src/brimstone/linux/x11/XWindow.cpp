@@ -34,6 +34,7 @@ Description:
 
 #include <X11/XF86keysym.h>          //X11; XF86XK_*
 #include <X11/Xatom.h>               //X11; XA_ATOM
+#include <X11/extensions/XInput2.h>  //X11; XIRawEvent, XIQueryDevice
 
 #include <boost/format.hpp>          //boost::format
 
@@ -563,6 +564,7 @@ namespace Brimstone::Private {
 
 std::mutex               XWindow::m_windowsMutex;
 XWindow::XWinToWindowMap XWindow::m_windowMap;
+XWindow::XRawDeviceMap   XWindow::m_rawDevices;
 
 
 
@@ -770,6 +772,10 @@ void XWindow::open() {
         m_windowMap.emplace( m_window, *this );
     }
 
+    //Start listening for raw mouse events if this window wants them:
+    if( m_rawMouseInput )
+        updateRawEventSelection();
+
     //Display the window to the user
     xerrBegin();
     XMapWindow( display, m_window );
@@ -828,8 +834,13 @@ void XWindow::close() {
         }
 
         //If this is the last window being closed, clean up shared X11 resources (display, etc):
-        if( m_windowMap.empty() )
+        if( m_windowMap.empty() ) {
+            m_rawDevices.clear();
             XShared::destroy();
+        //Otherwise, stop listening for raw mouse events if this was the last window that wanted them:
+        } else if( m_rawMouseInput ) {
+            updateRawEventSelection();
+        }
 
         m_window = None;
     }
@@ -867,7 +878,8 @@ Returns:
     N/A
 */
 void XWindow::frame() {
-    if( m_keepCursorCentered ) {
+    //With raw mouse input, mouselook uses MouseRawMove events instead, which don't need the cursor to be moved back to the center.
+    if( m_keepCursorCentered && !isRawMouseInputActive() ) {
         //Calculate the coordinates for the center of the window, relative to the origin of the window:
         Point2i center(
             ( m_bounds.maxX - m_bounds.minX ) >> 1, //x >> 1 == x / 2
@@ -907,7 +919,7 @@ XWindow::peekEvent
 Description:
     If a Brimstone WindowEvent is available, outputs the event and returns true. Otherwise, returns false.
 
-    Specifically, processes all queued X11 events, which potentially generates Brimstone WindowEvents.
+    Specifically, if the event queue is empty, processes all queued X11 events, which potentially generates Brimstone WindowEvents.
     Aferwards, if at least one Brimstone WindowEvent is present on the queue, removes the front event from the queue, outputs it to eventOut, and returns true.
     Otherwise, eventOut is left unchanged and false is returned.
 
@@ -924,72 +936,41 @@ bool XWindow::peekEvent( WindowEvent& eventOut ) {
         return false;
 
     //Nothing in event queue
-    if( m_eventQueue.empty() ) {
-        ::Display* const display = XShared::getDisplay();
-        //Process all messages currently in the application's message queue
-        XEvent event, nextEvent;
-        int i = XPending( display );
-        while( i > 0 ) {
-            //Grab the next event.
-            XNextEvent( display, &event );
-            --i;
-
-            //If this event was a KeyRelease, there's a possibility that this event and the event that follow it belong to a KeyRelease, KeyPress event pair generated by auto-repeat rather
-            //than from the key actually being pressed/released by the user.
-            //We want to be able to identify these auto-repeated KeyPress/KeyRelease events so we can filter them out or identify them as such.
-            if( event.type == KeyRelease ) {
-                do {
-                    //Grab the next event if one exists.
-                    if( i > 0 ) {
-                        XNextEvent( display, &nextEvent );
-                        --i;
-                    //If there is no next event, process the event as we normally would, then exit the inner loop.
-                    } else {
-                        mainProc( event, false );
-                        break;
-                    }
-
-                    //If the next event is...
-                    if(
-                        nextEvent.type         == KeyPress           &&  //a KeyPress event,
-                        nextEvent.xkey.window  == event.xkey.window  &&  //occurred on the same window as the first event,
-                        nextEvent.xkey.serial  == event.xkey.serial  &&  //has the same serial number as the first event,
-                        nextEvent.xkey.keycode == event.xkey.keycode     //and was for the same key as the first event,
-                    //...then the first and second events are part of an auto-repeated keypress.
-                    ) {
-                        //If key repeat is enabled, ignore the KeyRelease event, but process the KeyPress event, making sure to mark it as a repeated key event.
-                        //Otherwise, ignore both events.
-                        if( m_keyRepeat )
-                            mainProc( nextEvent, true );
-                        //Exit the inner loop:
-                        break;
-                    //This event isn't part of an auto-repeated keypress.
-                    } else {
-                        //Process the event as we normally would.
-                        mainProc( event, false );
-                        //The next event could be a KeyRelease event; if so, it can be part of a key KeyRelease, KeyPress pair.
-                        //Swap the next event with the current event.
-                        event = nextEvent;
-                    }
-                } while( event.type == KeyRelease );
-            //Not a KeyRelease event, process as usual.
-            } else {
-                mainProc( event, false );
-            }
-        }
+    if( m_eventQueue.empty() )
+        processPendingEvents();
+
+    //Even after processing the messages in the queue, it's possible that:
+    //1.) The message queue was empty
+    //2.) No messages for this window were processed
+    //So pop() can still fail here.
+    return m_eventQueue.pop( eventOut );
+}
 
-        //Even after processing the messages in the queue, it's possible that:
-        //1.) The message queue was empty
-        //2.) No messages for this window were processed
-        //So we need to check for these situations here.
-        if( m_eventQueue.empty() )
-            return false;
-    }
+/*
+XWindow::pollEvents
+-------------------
 
-    //Pop a message from the queue
-    eventOut = m_eventQueue.front();
-    m_eventQueue.pop();
-    return true;
+Description:
+    Processes all queued X11 events, then removes up to max Brimstone WindowEvents from the front of the event queue.
+    A frame's worth of input can be drained with a single call, without blocking or allocating:
+        WindowEvent events[64];
+        std::size_t count;
+        while( ( count = window.pollEvents( events, 64 ) ) > 0 ) ...
+
+Arguments:
+    eventsOut:      The events are output here, oldest first. Must have room for max events.
+    max:            The most events to output.
+
+Returns:
+    std::size_t:    The number of events output. 0 is always returned if the window is not open.
+*/
+std::size_t XWindow::pollEvents( WindowEvent* const eventsOut, const std::size_t max ) {
+    //Window not open
+    if( m_window == None )
+        return 0;
+
+    processPendingEvents();
+    return m_eventQueue.pop( eventsOut, max );
 }
 
 /*
@@ -1067,9 +1048,79 @@ bool XWindow::getEvent( WindowEvent& eventOut ) {
     }
 
     //Pop a message from the queue
-    eventOut = m_eventQueue.front();
-    m_eventQueue.pop();
-    return true;
+    return m_eventQueue.pop( eventOut );
+}
+
+/*
+XWindow::processPendingEvents
+-----------------------------
+
+Description:
+    Processes every X11 event that's currently queued, without blocking, which potentially generates Brimstone WindowEvents.
+    Events for every open window are processed, not just this one.
+
+    If key repeat is disabled, KeyRelease / KeyPress pairs generated by auto-repeat are filtered out;
+    otherwise, the KeyPress is marked as repeated and its KeyRelease is dropped.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void XWindow::processPendingEvents() {
+    ::Display* const display = XShared::getDisplay();
+    //Process all messages currently in the application's message queue
+    XEvent event, nextEvent;
+    int i = XPending( display );
+    while( i > 0 ) {
+        //Grab the next event.
+        XNextEvent( display, &event );
+        --i;
+
+        //If this event was a KeyRelease, there's a possibility that this event and the event that follow it belong to a KeyRelease, KeyPress event pair generated by auto-repeat rather
+        //than from the key actually being pressed/released by the user.
+        //We want to be able to identify these auto-repeated KeyPress/KeyRelease events so we can filter them out or identify them as such.
+        if( event.type == KeyRelease ) {
+            do {
+                //Grab the next event if one exists.
+                if( i > 0 ) {
+                    XNextEvent( display, &nextEvent );
+                    --i;
+                //If there is no next event, process the event as we normally would, then exit the inner loop.
+                } else {
+                    mainProc( event, false );
+                    break;
+                }
+
+                //If the next event is...
+                if(
+                    nextEvent.type         == KeyPress           &&  //a KeyPress event,
+                    nextEvent.xkey.window  == event.xkey.window  &&  //occurred on the same window as the first event,
+                    nextEvent.xkey.serial  == event.xkey.serial  &&  //has the same serial number as the first event,
+                    nextEvent.xkey.keycode == event.xkey.keycode     //and was for the same key as the first event,
+                //...then the first and second events are part of an auto-repeated keypress.
+                ) {
+                    //If key repeat is enabled, ignore the KeyRelease event, but process the KeyPress event, making sure to mark it as a repeated key event.
+                    //Otherwise, ignore both events.
+                    if( m_keyRepeat )
+                        mainProc( nextEvent, true );
+                    //Exit the inner loop:
+                    break;
+                //This event isn't part of an auto-repeated keypress.
+                } else {
+                    //Process the event as we normally would.
+                    mainProc( event, false );
+                    //The next event could be a KeyRelease event; if so, it can be part of a key KeyRelease, KeyPress pair.
+                    //Swap the next event with the current event.
+                    event = nextEvent;
+                }
+            } while( event.type == KeyRelease );
+        //Not a KeyRelease event, process as usual.
+        } else {
+            mainProc( event, false );
+        }
+    }
 }
 
 /*
@@ -1088,6 +1139,12 @@ Returns:
     N/A
 */
 void XWindow::mainProc( XEvent& xEvent, const bool repeated ) {
+    //XInput 2 events don't belong to any window; they're routed by rawProc():
+    if( xEvent.type == GenericEvent ) {
+        rawProc( xEvent.xcookie );
+        return;
+    }
+
     //Locate what XWindow this belongs to
     auto it = m_windowMap.find( xEvent.xany.window );
     if( it == m_windowMap.end() )
@@ -1096,6 +1153,134 @@ void XWindow::mainProc( XEvent& xEvent, const bool repeated ) {
     it->second.windowProc( xEvent, repeated );
 }
 
+/*
+XWindow::rawProc
+----------------
+
+Description:
+    Processes an XInput 2 event.
+    Raw motion is translated into MouseRawMove and MouseSmoothScroll events, which are pushed to every focused window that
+    uses raw mouse input (see setRawMouseInput()). Raw events aren't sent to any particular window, so this is where they're routed.
+    When devices are added, removed or changed, what we know about them is forgotten, and looked up again when they're next used.
+    GenericEvents from other extensions are ignored.
+
+Arguments:
+    cookie:      The event's cookie. Its data is retrieved and freed here.
+
+Returns:
+    N/A
+
+Throws:
+    Exception:   If the device that sent a raw event couldn't be queried.
+    XException:  If a call to an Xlib function fails.
+*/
+void XWindow::rawProc( XGenericEventCookie& cookie ) {
+    ::Display* const display = XShared::getDisplay();
+    if( cookie.extension != XShared::getXIOpcode() || !XGetEventData( display, &cookie ) )
+        return;
+
+    //The event's data has to be freed even if handling it fails
+    try {
+        rawEventProc( cookie );
+    } catch( ... ) {
+        XFreeEventData( display, &cookie );
+        throw;
+    }
+    XFreeEventData( display, &cookie );
+}
+
+/*
+XWindow::rawEventProc
+---------------------
+
+Description:
+    Handles the data of an XInput 2 event for rawProc().
+
+Arguments:
+    cookie:      The event's cookie, with its data retrieved.
+
+Returns:
+    N/A
+
+Throws:
+    Exception:   If the device that sent a raw event couldn't be queried.
+    XException:  If a call to an Xlib function fails.
+*/
+void XWindow::rawEventProc( const XGenericEventCookie& cookie ) {
+    switch( cookie.evtype ) {
+    case XI_RawMotion: {
+        const XIRawEvent& raw    = *static_cast< const XIRawEvent* >( cookie.data );
+        const XRawDevice& device = getRawDevice( raw.sourceid );
+
+        //The event has a value for each valuator set in its mask, in order. Valuators 0 and 1 are the X and Y axes.
+        //NOTE:
+        //    raw_values are what the device reported, before pointer acceleration was applied.
+        //    For relative devices (mice, touchpads) that's how far they moved, and how far they scrolled on their scroll valuators.
+        double move[2]   = { 0.0, 0.0 };
+        double scroll[2] = { 0.0, 0.0 };
+        bool   moved     = false;
+        bool   scrolled  = false;
+        const double* value = raw.raw_values;
+        for( int i = 0; i < raw.valuators.mask_len * 8; ++i ) {
+            if( !XIMaskIsSet( raw.valuators.mask, i ) )
+                continue;
+
+            const double v = *value++;
+            if( i < 2 ) {
+                move[i] = v;
+                moved   = device.relative;
+                continue;
+            }
+            for( const XScrollValuator& valuator : device.scrollValuators ) {
+                if( valuator.number == i ) {
+                    //XInput 2 scrolls down and right for positive values; MouseVScroll and MouseSmoothScroll use positive values for up.
+                    if( valuator.vertical )
+                        scroll[1] -= v / valuator.increment;
+                    else
+                        scroll[0] += v / valuator.increment;
+                    scrolled = true;
+                    break;
+                }
+            }
+        }
+
+        WindowEvent moveEvent;
+        moveEvent.type           = WindowEventType::MouseRawMove;
+        moveEvent.mouseRaw.dx    = move[0];
+        moveEvent.mouseRaw.dy    = move[1];
+        moveEvent.mouseRaw.time  = raw.time;
+        moveEvent.mouseRaw.count = 1;
+
+        WindowEvent scrollEvent;
+        scrollEvent.type                    = WindowEventType::MouseSmoothScroll;
+        scrollEvent.mouseSmoothScroll.dx    = scroll[0];
+        scrollEvent.mouseSmoothScroll.dy    = scroll[1];
+        scrollEvent.mouseSmoothScroll.time  = raw.time;
+        scrollEvent.mouseSmoothScroll.count = 1;
+
+        for( auto& it : m_windowMap ) {
+            XWindow& window = it.second;
+            if( !window.m_rawMouseInput || !window.m_focused )
+                continue;
+
+            if( moved )
+                window.pushEvent( moveEvent );
+            if( scrolled )
+                window.pushEvent( scrollEvent );
+        }
+    } break;
+    //A device's valuators changed. This is also sent when a master pointer switches to another device, which doesn't change any devices.
+    case XI_DeviceChanged:
+        if( static_cast< const XIDeviceChangedEvent* >( cookie.data )->reason == XIDeviceChange )
+            m_rawDevices.clear();
+        break;
+    //Devices were added or removed
+    case XI_HierarchyChanged:
+        m_rawDevices.clear();
+        break;
+    }
+}
+
 /*
 XWindow::windowProc
 -------------------
@@ -1120,6 +1305,8 @@ void XWindow::windowProc( XEvent& xEvent, const bool repeated ) {
             auto p = getCursorPosFromXEvent( xEvent.xmotion );
 
             if( p != m_cursorPos ) {
+                const int dx = p.x - m_cursorPos.x;
+                const int dy = p.y - m_cursorPos.y;
                 m_cursorPos = p;
 
                 unsigned int state = xEvent.xmotion.state;
@@ -1128,6 +1315,11 @@ void XWindow::windowProc( XEvent& xEvent, const bool repeated ) {
                 e.type             = WindowEventType::MouseMove;
                 e.mouseMove.x      = p.x;
                 e.mouseMove.y      = p.y;
+                e.mouseMove.firstX = p.x;
+                e.mouseMove.firstY = p.y;
+                e.mouseMove.dx     = dx;
+                e.mouseMove.dy     = dy;
+                e.mouseMove.count  = 1;
                 e.mouseMove.ctrl   = state & ControlMask;
                 e.mouseMove.alt    = state & Mod1Mask;
                 e.mouseMove.shift  = state & ShiftMask;
@@ -1221,6 +1413,11 @@ void XWindow::windowProc( XEvent& xEvent, const bool repeated ) {
             e.type = WindowEventType::MouseEnter;
             e.mouseMove.x      = p.x;
             e.mouseMove.y      = p.y;
+            e.mouseMove.firstX = p.x;
+            e.mouseMove.firstY = p.y;
+            e.mouseMove.dx     = 0;
+            e.mouseMove.dy     = 0;
+            e.mouseMove.count  = 1;
             e.mouseMove.ctrl   = state & ControlMask;
             e.mouseMove.alt    = state & Mod1Mask;
             e.mouseMove.shift  = state & ShiftMask;
@@ -1241,6 +1438,11 @@ void XWindow::windowProc( XEvent& xEvent, const bool repeated ) {
             e.type = WindowEventType::MouseLeave;
             e.mouseMove.x      = p.x;
             e.mouseMove.y      = p.y;
+            e.mouseMove.firstX = p.x;
+            e.mouseMove.firstY = p.y;
+            e.mouseMove.dx     = 0;
+            e.mouseMove.dy     = 0;
+            e.mouseMove.count  = 1;
             e.mouseMove.ctrl   = state & ControlMask;
             e.mouseMove.alt    = state & Mod1Mask;
             e.mouseMove.shift  = state & ShiftMask;
@@ -1355,9 +1557,12 @@ void XWindow::windowProc( XEvent& xEvent, const bool repeated ) {
 
                 //Push event
                 WindowEvent e;
-                e.type   = WindowEventType::Move;
-                e.move.x = pos.x;
-                e.move.y = pos.y;
+                e.type        = WindowEventType::Move;
+                e.move.x      = pos.x;
+                e.move.y      = pos.y;
+                e.move.firstX = pos.x;
+                e.move.firstY = pos.y;
+                e.move.count  = 1;
 
                 pushEvent( e );
             }
@@ -1373,9 +1578,12 @@ void XWindow::windowProc( XEvent& xEvent, const bool repeated ) {
 
                 //Push event
                 WindowEvent e;
-                e.type     = WindowEventType::Resize;
-                e.resize.w = size.w;
-                e.resize.h = size.h;
+                e.type          = WindowEventType::Resize;
+                e.resize.w      = size.w;
+                e.resize.h      = size.h;
+                e.resize.firstW = size.w;
+                e.resize.firstH = size.h;
+                e.resize.count  = 1;
 
                 pushEvent( e );
             }
@@ -2319,6 +2527,36 @@ void XWindow::setCursorVisible( const bool cursorVisible ) {
     BaseWindowImpl::setCursorVisible( cursorVisible );
 }
 
+/*
+XWindow::setRawMouseInput
+-------------------------
+
+Description:
+    Sets whether the window receives MouseRawMove and MouseSmoothScroll events while it's focused.
+    These are generated from XInput 2 raw motion events. If the X server doesn't support XInput 2, the setting is kept,
+    but no raw events are generated.
+
+Arguments:
+    rawMouseInput:  true to receive raw mouse events, false otherwise.
+
+Returns:
+    N/A
+
+Throws:
+    XException:     If a call to an Xlib function fails.
+*/
+void XWindow::setRawMouseInput( const bool rawMouseInput ) {
+    //If we're already at the requested state, there's nothing to do:
+    if( m_rawMouseInput == rawMouseInput )
+        return;
+
+    BaseWindowImpl::setRawMouseInput( rawMouseInput );
+
+    //If the window is open, start or stop listening for raw events:
+    if( m_window != None )
+        updateRawEventSelection();
+}
+
 /*
 XWindow::sendToTop
 ------------------
@@ -2929,6 +3167,93 @@ void XWindow::updateWindowHierarchy() {
     m_topLevelWindow = topLevelWindow;
 }
 
+//Returns true if the window wants raw mouse input and the X server can provide it
+bool XWindow::isRawMouseInputActive() const {
+    return m_rawMouseInput && XShared::hasXInput2();
+}
+
+/*
+XWindow::updateRawEventSelection
+--------------------------------
+
+Description:
+    Listens for XInput 2 raw events if any open window uses raw mouse input, or stops listening otherwise.
+    Raw motion is reported for every movement of every mouse, so we don't ask for it unless something uses it.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    XException:  If a call to an Xlib function fails.
+*/
+void XWindow::updateRawEventSelection() {
+    bool select = false;
+    for( const auto& it : m_windowMap )
+        select = select || it.second.m_rawMouseInput;
+
+    XShared::selectRawEvents( select );
+}
+
+/*
+XWindow::getRawDevice
+---------------------
+
+Description:
+    Returns what raw motion from the given XInput 2 device means: whether its X and Y valuators are relative,
+    and which of its valuators scroll (XInput 2.1 and up).
+    The first time a device is seen, the X server is asked about it; after that, the answer is cached until devices change.
+
+Arguments:
+    deviceId:     The ID of the device.
+
+Returns:
+    XRawDevice:   Information about the device.
+
+Throws:
+    Exception:    If the device couldn't be queried.
+    XException:   If a call to an Xlib function fails (e.g. the device was unplugged before its event was processed).
+*/
+const XWindow::XRawDevice& XWindow::getRawDevice( const int deviceId ) {
+    auto it = m_rawDevices.find( deviceId );
+    if( it != m_rawDevices.end() )
+        return it->second;
+
+    int count = 0;
+    xerrBegin();
+    XIDeviceInfo* const info = XIQueryDevice( XShared::getDisplay(), deviceId, &count );
+    xerrEnd();
+    if( xerrExists() ) {
+        if( info != nullptr )
+            XIFreeDeviceInfo( info );
+        throw xerrGet();
+    }
+    if( info == nullptr )
+        throw Exception( "XIQueryDevice() failed." );
+
+    //Only cache the device once it's been queried successfully
+    XRawDevice& device = m_rawDevices[ deviceId ];
+    device.relative = false;
+
+    for( int i = 0; i < info->num_classes; ++i ) {
+        const XIAnyClassInfo* const c = info->classes[i];
+        if( c->type == XIValuatorClass ) {
+            const XIValuatorClassInfo* const valuator = reinterpret_cast< const XIValuatorClassInfo* >( c );
+            if( valuator->number == 0 )
+                device.relative = valuator->mode == XIModeRelative;
+        } else if( c->type == XIScrollClass ) {
+            const XIScrollClassInfo* const scroll = reinterpret_cast< const XIScrollClassInfo* >( c );
+            if( scroll->increment != 0.0 )
+                device.scrollValuators.push_back( { scroll->number, scroll->scroll_type == XIScrollTypeVertical, scroll->increment } );
+        }
+    }
+    XIFreeDeviceInfo( info );
+
+    return device;
+}
+
 
 
 
@@ -13,7 +13,9 @@ Description:
 
 
 //Includes
+#include <cstddef>                             //std::size_t
 #include <unordered_map>                       //std::unordered_map
+#include <vector>                              //std::vector
 #include <mutex>                               //std::mutex
 
 #include <X11/Xlib.h>                          //X11
@@ -37,6 +39,20 @@ namespace Brimstone::Private {
 class XWindow : public BaseWindowImpl {
 private:
     using XWinToWindowMap = std::unordered_map< ::Window, XWindow& >;
+
+    //An XInput 2 valuator (axis) that a device scrolls with
+    struct XScrollValuator {
+        int    number;
+        bool   vertical;
+        double increment;   //How far the valuator moves for one wheel click
+    };
+
+    //What raw motion from an XInput 2 device means
+    struct XRawDevice {
+        bool                           relative;   //false for devices like tablets, whose X and Y valuators are positions rather than movement
+        std::vector< XScrollValuator > scrollValuators;
+    };
+    using XRawDeviceMap = std::unordered_map< int, XRawDevice >;
 public:
     XWindow();
     XWindow( XWindow& toCopy ) = delete;
@@ -51,6 +67,7 @@ public:
 
     bool            peekEvent( WindowEvent& eventOut );
     bool            getEvent( WindowEvent& eventOut );
+    std::size_t     pollEvents( WindowEvent* const eventsOut, const std::size_t max );
 
     void            setTitle( const ustring& title );
 
@@ -81,6 +98,8 @@ public:
     void            setCursorTrapped( const bool cursorTrapped );
 
     void            setCursorVisible( const bool cursorVisible );
+
+    void            setRawMouseInput( const bool rawMouseInput );
     
     void            sendToTop();
     void            sendToBottom();
@@ -92,6 +111,7 @@ public:
     WindowHandle    getHandle() const;
 
 private:
+    void            processPendingEvents();
     void            windowProc( XEvent& xEvent, const bool repeated );
     void            setFullscreenInternal( const bool fullscreen );
     void            setMaximizedInternal( const bool maximized );
@@ -102,6 +122,7 @@ private:
     void            updateFrameExtents();
     void            updateFrameExtentsFromBounds();
     void            updateWindowHierarchy();
+    bool            isRawMouseInputActive() const;
 
 private:
     //This is sort of annoying. Both Brimstone and X11 define "Window",
@@ -121,10 +142,15 @@ private:
     bool                    m_pendingFocus;
 private:
     static void             mainProc( XEvent& xEvent, const bool repeated );
+    static void             rawProc( XGenericEventCookie& cookie );
+    static void             rawEventProc( const XGenericEventCookie& cookie );
+    static void             updateRawEventSelection();
+    static const XRawDevice& getRawDevice( const int deviceId );
 
 private:
     static std::mutex       m_windowsMutex;
     static XWinToWindowMap  m_windowMap;
+    static XRawDeviceMap    m_rawDevices;
 };
 
 
@@ -0,0 +1,196 @@
+/*
+opengl/GLDrawIndirectBuffer.cpp
+-------------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See GLDrawIndirectBuffer.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include "GLDrawIndirectBuffer.hpp"  //Header
+
+#include <brimstone/Exception.hpp>   //Brimstone::GraphicsException
+
+#include <gll/gl_4_6_comp.hpp>       //gll::* (GL 4.6 and below + compatibility)
+using namespace gll;
+
+
+
+
+namespace {
+
+
+
+
+//Types
+//A command in the layout glMultiDrawElementsIndirect reads
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint  baseVertex;
+    GLuint baseInstance;
+};
+static_assert( sizeof( DrawElementsIndirectCommand ) == Brimstone::Private::GLDrawIndirectBuffer::COMMAND_SIZE );
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+/*
+GLDrawIndirectBuffer::GLDrawIndirectBuffer
+------------------------------------------
+
+Description:
+    Creates a buffer that can hold capacity commands each frame.
+
+Arguments:
+    capacity:           The number of commands that can be added each frame.
+    regionCount:        The number of frames the buffer's commands are kept for (see GLStreamingBuffer).
+
+Throws:
+    GraphicsException:  If capacity is 0, regionCount is out of range, or the buffer couldn't be created.
+*/
+GLDrawIndirectBuffer::GLDrawIndirectBuffer( const std::size_t capacity, const std::size_t regionCount ) :
+    m_commands( capacity * COMMAND_SIZE, regionCount ),
+    m_batchOffset( 0 ),
+    m_batchCount( 0 ),
+    m_batchInstances( 0 ),
+    m_batchTriangles( 0 ),
+    m_batchIndexEnd( 0 ) {
+}
+
+void GLDrawIndirectBuffer::create() {
+    m_commands.create();
+}
+
+void GLDrawIndirectBuffer::destroy() {
+    m_commands.destroy();
+    endBatch();
+}
+
+//Waits until the GPU has read the commands last written to this frame's region; see GLStreamingBuffer::beginFrame()
+void GLDrawIndirectBuffer::beginFrame() {
+    m_commands.beginFrame();
+    endBatch();
+}
+
+void GLDrawIndirectBuffer::endFrame() {
+    m_commands.endFrame();
+    endBatch();
+}
+
+/*
+GLDrawIndirectBuffer::add
+-------------------------
+
+Description:
+    Adds a command to the current batch that draws a range of an index buffer.
+    The command is written straight into the buffer the GPU reads it from.
+
+Arguments:
+    count:              The number of indices to draw.
+    first:              The index of the first index to draw.
+    baseVertex:         A value added to each index before the vertex it refers to is fetched.
+    instanceCount:      The number of instances to draw.
+    baseInstance:       The index of the first instance; per-instance data is read starting from this instance.
+                        Requires OpenGL 4.2 (or GL_ARB_base_instance); must be 0 otherwise.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the buffer already holds capacity commands this frame.
+*/
+void GLDrawIndirectBuffer::add( const std::size_t count, const std::size_t first, const int baseVertex, const std::size_t instanceCount, const uint baseInstance ) {
+    std::size_t offset;
+    DrawElementsIndirectCommand* command = static_cast< DrawElementsIndirectCommand* >(
+        m_commands.allocate( COMMAND_SIZE, sizeof( GLuint ), offset )
+    );
+    command->count         = (GLuint)count;
+    command->instanceCount = (GLuint)instanceCount;
+    command->firstIndex    = (GLuint)first;
+    command->baseVertex    = baseVertex;
+    command->baseInstance  = baseInstance;
+
+    if( m_batchCount == 0 )
+        m_batchOffset = offset;
+    ++m_batchCount;
+    m_batchInstances += instanceCount;
+    m_batchTriangles += ( count / 3 ) * instanceCount;
+    if( first + count > m_batchIndexEnd )
+        m_batchIndexEnd = first + count;
+}
+
+//Returns the number of commands that can be added each frame
+std::size_t GLDrawIndirectBuffer::getCapacity() const {
+    return m_commands.getRegionSize() / COMMAND_SIZE;
+}
+
+//Returns the number of commands that can still be added this frame
+std::size_t GLDrawIndirectBuffer::getRemaining() const {
+    return m_commands.getRemaining() / COMMAND_SIZE;
+}
+
+//Returns the number of commands in the current batch, i.e. added since the last batch was drawn
+std::size_t GLDrawIndirectBuffer::getBatchCount() const {
+    return m_batchCount;
+}
+
+bool GLDrawIndirectBuffer::isPersistent() const {
+    return m_commands.isPersistent();
+}
+
+std::size_t GLDrawIndirectBuffer::getStallCount() const {
+    return m_commands.getStallCount();
+}
+
+GLuint GLDrawIndirectBuffer::getName() const {
+    return m_commands.getName();
+}
+
+std::size_t GLDrawIndirectBuffer::getBatchOffset() const {
+    return m_batchOffset;
+}
+
+uint64 GLDrawIndirectBuffer::getBatchInstances() const {
+    return m_batchInstances;
+}
+
+uint64 GLDrawIndirectBuffer::getBatchTriangles() const {
+    return m_batchTriangles;
+}
+
+std::size_t GLDrawIndirectBuffer::getBatchIndexEnd() const {
+    return m_batchIndexEnd;
+}
+
+void GLDrawIndirectBuffer::flush() {
+    m_commands.flush();
+}
+
+void GLDrawIndirectBuffer::endBatch() {
+    m_batchOffset    = 0;
+    m_batchCount     = 0;
+    m_batchInstances = 0;
+    m_batchTriangles = 0;
+    m_batchIndexEnd  = 0;
+}
+
+
+
+
+} //namespace Brimstone::Private
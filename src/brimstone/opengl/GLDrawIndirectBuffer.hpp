@@ -0,0 +1,93 @@
+/*
+opengl/GLDrawIndirectBuffer.hpp
+-------------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    GLDrawIndirectBuffer is defined here.
+    These objects hold draw commands that the GPU reads itself, so many objects that share a vertex and index buffer
+    can be drawn with a single call to glMultiDrawElementsIndirect (OpenGL 4.3 or GL_ARB_multi_draw_indirect).
+
+    Commands are rewritten every frame, so they're stored in a GLStreamingBuffer: add() writes each command straight into
+    the persistently mapped buffer (or its CPU-side copy, if persistent mapping isn't supported), and the ring of regions
+    keeps it from overwriting commands the GPU hasn't read yet.
+
+    Commands are drawn in batches; a batch is every command added since the last batch was drawn.
+*/
+#ifndef BS_OPENGL_GLDRAWINDIRECTBUFFER_HPP
+#define BS_OPENGL_GLDRAWINDIRECTBUFFER_HPP
+
+
+
+
+//Includes
+#include "GLStreamingBuffer.hpp"  //Brimstone::Private::GLStreamingBuffer
+
+#include <cstddef>                //std::size_t
+
+#include <brimstone/types.hpp>    //Brimstone::uint, Brimstone::uint32, Brimstone::uint64
+
+#include <gll/gl_types.hpp>       //gll::GLuint
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+class GLDrawIndirectBuffer {
+friend class GLGraphicsImpl;
+public:
+    //The size of a command as the GPU reads it (a DrawElementsIndirectCommand)
+    static constexpr std::size_t COMMAND_SIZE = 5 * sizeof( uint32 );
+public:
+    GLDrawIndirectBuffer( const std::size_t capacity, const std::size_t regionCount );
+    GLDrawIndirectBuffer( GLDrawIndirectBuffer& toCopy ) = delete;
+    GLDrawIndirectBuffer& operator =( GLDrawIndirectBuffer& toCopy ) = delete;
+
+    void        create();
+    void        destroy();
+
+    void        beginFrame();
+    void        endFrame();
+
+    void        add( const std::size_t count, const std::size_t first, const int baseVertex, const std::size_t instanceCount, const uint baseInstance );
+
+    std::size_t getCapacity() const;
+    std::size_t getRemaining() const;
+    std::size_t getBatchCount() const;
+    bool        isPersistent() const;
+    std::size_t getStallCount() const;
+private:
+    //Used by GLGraphicsImpl to draw the current batch
+    gll::GLuint getName() const;
+    std::size_t getBatchOffset() const;
+    uint64      getBatchInstances() const;
+    uint64      getBatchTriangles() const;
+    std::size_t getBatchIndexEnd() const;
+    void        flush();
+    void        endBatch();
+private:
+    GLStreamingBuffer m_commands;
+
+    //The offset of the first command in the current batch, and how many commands it has
+    std::size_t       m_batchOffset;
+    std::size_t       m_batchCount;
+
+    //Totals for the current batch; its instances and triangles are counted in GraphicsStats, and its indices are bounds checked
+    uint64            m_batchInstances;
+    uint64            m_batchTriangles;
+    std::size_t       m_batchIndexEnd;
+};
+
+
+
+
+} //namespace Brimstone::Private
+
+
+
+
+#endif //BS_OPENGL_GLDRAWINDIRECTBUFFER_HPP
@@ -0,0 +1,359 @@
+/*
+opengl/GLFramebuffer.cpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See GLFramebuffer.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include "GLFramebuffer.hpp"        //Header
+#include "GLTexture.hpp"            //Brimstone::Private::GLTexture
+
+#include <brimstone/Exception.hpp>  //Brimstone::GraphicsException, Brimstone::BoundsException
+
+#include <algorithm>                //std::max, std::min, std::swap_ranges
+
+#include <gll/gl_4_6_comp.hpp>      //gll::* (GL 4.6 and below + compatibility)
+using namespace gll;
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+GLFramebuffer::GLFramebuffer() :
+    m_name( 0 ),
+    m_color( 0 ),
+    m_depth( 0 ),
+    m_width( 0 ),
+    m_height( 0 ),
+    m_samples( 0 ) {
+    create();
+}
+
+GLFramebuffer::~GLFramebuffer() {
+    destroy();
+}
+
+void GLFramebuffer::create() {
+    glGenFramebuffers( 1, &m_name );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glGenFramebuffers() failed." );
+}
+
+void GLFramebuffer::destroy() {
+    destroyColor();
+    if( m_depth != 0 ) {
+        glDeleteRenderbuffers( 1, &m_depth );
+        m_depth = 0;
+    }
+    if( m_name != 0 ) {
+        glDeleteFramebuffers( 1, &m_name );
+        m_name = 0;
+    }
+    m_width   = 0;
+    m_height  = 0;
+    m_samples = 0;
+}
+
+/*
+GLFramebuffer::setColor{1}
+--------------------------
+
+Description:
+    Attaches a level of the given texture as the framebuffer's color buffer.
+    The texture must have storage for that level (e.g. from setStorage()) and stay alive while it's attached.
+    The size of the framebuffer is the size of this level.
+
+Arguments:
+    texture:            The texture to render into.
+    level:              The mipmap level of the texture to render into.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the texture couldn't be attached.
+*/
+void GLFramebuffer::setColor( GLTexture& texture, const std::size_t level ) {
+    const GLuint previous = getBound();
+    glBindFramebuffer( GL_FRAMEBUFFER, m_name );
+    glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.getName(), level );
+    glBindFramebuffer( GL_FRAMEBUFFER, previous );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glFramebufferTexture2D() failed." );
+
+    //Replaces the renderbuffer, if there was one
+    destroyColor();
+    m_width   = std::max( (GLsizei)texture.getWidth()  >> level, 1 );
+    m_height  = std::max( (GLsizei)texture.getHeight() >> level, 1 );
+    m_samples = 0;
+}
+
+/*
+GLFramebuffer::setColor{2}
+--------------------------
+
+Description:
+    Gives the framebuffer a color buffer of its own, which is usually done to render with multisampling.
+    The color buffer is a renderbuffer, so it can't be sampled like a texture;
+    to use what was rendered, it has to be resolved into a framebuffer with a texture attached with blit().
+
+    Drivers support a limited number of samples; the number asked for is clamped to GL_MAX_SAMPLES,
+    and drivers may round it up. getSamples() returns the number actually used.
+
+Arguments:
+    width:              The width of the color buffer.
+    height:             The height of the color buffer.
+    format:             The format of the color buffer. Must be uncompressed.
+    samples:            The number of samples per pixel, or 0 for a color buffer that isn't multisampled.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If format is compressed, or the color buffer couldn't be created.
+*/
+void GLFramebuffer::setColor( const std::size_t width, const std::size_t height, const TextureFormat format, const std::size_t samples ) {
+    if( format != TextureFormat::R8 && format != TextureFormat::RG8 && format != TextureFormat::RGBA8 && format != TextureFormat::SRGB8_ALPHA8 )
+        throw GraphicsException( "Compressed formats can't be rendered to." );
+
+    if( m_color == 0 )
+        glGenRenderbuffers( 1, &m_color );
+
+    glBindRenderbuffer( GL_RENDERBUFFER, m_color );
+    glRenderbufferStorageMultisample( GL_RENDERBUFFER, getSampleCount( samples ), GLTexture::getInternalFormat( format ), width, height );
+    GLint actualSamples = 0;
+    glGetRenderbufferParameteriv( GL_RENDERBUFFER, GL_RENDERBUFFER_SAMPLES, &actualSamples );
+    glBindRenderbuffer( GL_RENDERBUFFER, 0 );
+
+    const GLuint previous = getBound();
+    glBindFramebuffer( GL_FRAMEBUFFER, m_name );
+    glFramebufferRenderbuffer( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_color );
+    glBindFramebuffer( GL_FRAMEBUFFER, previous );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glRenderbufferStorageMultisample() failed." );
+
+    m_width   = (GLsizei)width;
+    m_height  = (GLsizei)height;
+    m_samples = actualSamples;
+}
+
+/*
+GLFramebuffer::setDepth
+-----------------------
+
+Description:
+    Gives the framebuffer a depth buffer of the given size, with 24 bits of depth and 8 bits of stencil.
+    This should match the size and number of samples of the color attachment.
+
+Arguments:
+    width:              The width of the depth buffer.
+    height:             The height of the depth buffer.
+    samples:            The number of samples per pixel, or 0 for a depth buffer that isn't multisampled.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the depth buffer couldn't be created.
+*/
+void GLFramebuffer::setDepth( const std::size_t width, const std::size_t height, const std::size_t samples ) {
+    if( m_depth == 0 )
+        glGenRenderbuffers( 1, &m_depth );
+
+    glBindRenderbuffer( GL_RENDERBUFFER, m_depth );
+    glRenderbufferStorageMultisample( GL_RENDERBUFFER, getSampleCount( samples ), GL_DEPTH24_STENCIL8, width, height );
+    glBindRenderbuffer( GL_RENDERBUFFER, 0 );
+
+    const GLuint previous = getBound();
+    glBindFramebuffer( GL_FRAMEBUFFER, m_name );
+    glFramebufferRenderbuffer( GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depth );
+    glBindFramebuffer( GL_FRAMEBUFFER, previous );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glRenderbufferStorage() failed." );
+}
+
+//Returns true if the framebuffer's attachments can be rendered to
+bool GLFramebuffer::isComplete() const {
+    const GLuint previous = getBound();
+    glBindFramebuffer( GL_FRAMEBUFFER, m_name );
+    const GLenum status = glCheckFramebufferStatus( GL_FRAMEBUFFER );
+    glBindFramebuffer( GL_FRAMEBUFFER, previous );
+    return status == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void GLFramebuffer::bind() {
+    glBindFramebuffer( GL_FRAMEBUFFER, m_name );
+}
+
+void GLFramebuffer::unbind() {
+    glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+}
+
+/*
+GLFramebuffer::read
+-------------------
+
+Description:
+    Reads a region of the color attachment back to memory as 8-bit RGBA pixels.
+    This waits for any rendering into the framebuffer to finish.
+
+    Like the scissor box, the region is given relative to the upper-left corner of the framebuffer,
+    and rows are written top-to-bottom, so the pixels are laid out like an Image.
+
+Arguments:
+    x:                  The left edge of the region.
+    y:                  The top edge of the region.
+    width:              The width of the region.
+    height:             The height of the region.
+    rgbaOut:            Receives width * height * 4 bytes.
+
+Returns:
+    N/A
+
+Throws:
+    BoundsException:    If the region doesn't fit inside the framebuffer.
+    GraphicsException:  If the pixels couldn't be read.
+*/
+void GLFramebuffer::read( const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height, void* const rgbaOut ) {
+    if( x + width > (std::size_t)m_width || y + height > (std::size_t)m_height )
+        throw BoundsException();
+    if( width == 0 || height == 0 )
+        return;
+
+    GLint previous;
+    glGetIntegerv( GL_READ_FRAMEBUFFER_BINDING, &previous );
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, m_name );
+    glReadBuffer( GL_COLOR_ATTACHMENT0 );
+    glPixelStorei( GL_PACK_ALIGNMENT, 4 );
+
+    //OpenGL measures from the lower-left corner...
+    glReadPixels( x, m_height - y - height, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgbaOut );
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, previous );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glReadPixels() failed." );
+
+    //...and returns the bottom row first
+    unsigned char* const pixels = static_cast< unsigned char* >( rgbaOut );
+    const std::size_t    stride = width * 4;
+    for( std::size_t top = 0, bottom = height - 1; top < bottom; ++top, --bottom )
+        std::swap_ranges( pixels + top * stride, pixels + ( top + 1 ) * stride, pixels + bottom * stride );
+}
+
+/*
+GLFramebuffer::blit
+-------------------
+
+Description:
+    Copies a region of the color attachment to a region of another framebuffer's, scaling it if the regions' sizes differ.
+    If this framebuffer is multisampled, the samples of each pixel are averaged (resolved) as they're copied;
+    in that case OpenGL requires the two regions to be the same size.
+
+    Like read(), regions are given relative to the upper-left corner of their framebuffers.
+
+Arguments:
+    target:             The framebuffer to copy to.
+    x:                  The left edge of the region to copy.
+    y:                  The top edge of the region to copy.
+    width:              The width of the region to copy.
+    height:             The height of the region to copy.
+    targetX:            The left edge of the region to copy to.
+    targetY:            The top edge of the region to copy to.
+    targetWidth:        The width of the region to copy to.
+    targetHeight:       The height of the region to copy to.
+    filter:             How pixels are sampled if the region is scaled.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the region couldn't be copied, e.g. because a multisampled region would have been scaled.
+*/
+void GLFramebuffer::blit( GLFramebuffer& target, const int x, const int y, const int width, const int height,
+                          const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter ) {
+    blit( target.m_name, target.m_height, x, y, width, height, targetX, targetY, targetWidth, targetHeight, filter );
+}
+
+//Same as blit(), but copies to the window's framebuffer instead, which is windowHeight pixels tall
+void GLFramebuffer::blitToWindow( const int windowHeight, const int x, const int y, const int width, const int height,
+                                  const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter ) {
+    blit( 0, windowHeight, x, y, width, height, targetX, targetY, targetWidth, targetHeight, filter );
+}
+
+std::size_t GLFramebuffer::getWidth() const {
+    return m_width;
+}
+
+std::size_t GLFramebuffer::getHeight() const {
+    return m_height;
+}
+
+std::size_t GLFramebuffer::getSamples() const {
+    return m_samples;
+}
+
+GLuint GLFramebuffer::getName() const {
+    return m_name;
+}
+
+void GLFramebuffer::destroyColor() {
+    if( m_color != 0 ) {
+        glDeleteRenderbuffers( 1, &m_color );
+        m_color = 0;
+    }
+}
+
+void GLFramebuffer::blit( const GLuint target, const int targetFramebufferHeight, const int x, const int y, const int width, const int height,
+                          const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter ) {
+    GLint previousRead, previousDraw;
+    glGetIntegerv( GL_READ_FRAMEBUFFER_BINDING, &previousRead );
+    glGetIntegerv( GL_DRAW_FRAMEBUFFER_BINDING, &previousDraw );
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, m_name );
+    glBindFramebuffer( GL_DRAW_FRAMEBUFFER, target );
+
+    //Flip both regions so they're measured from the lower-left corner, like OpenGL expects
+    const int bottom       = m_height - y - height;
+    const int targetBottom = targetFramebufferHeight - targetY - targetHeight;
+    glBlitFramebuffer(
+        x,       bottom,       x + width,             bottom + height,
+        targetX, targetBottom, targetX + targetWidth, targetBottom + targetHeight,
+        GL_COLOR_BUFFER_BIT, filter == FilterType::LINEAR ? GL_LINEAR : GL_NEAREST
+    );
+
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, previousRead );
+    glBindFramebuffer( GL_DRAW_FRAMEBUFFER, previousDraw );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glBlitFramebuffer() failed." );
+}
+
+//Attachments are changed by binding the framebuffer, which would unbind whatever is being rendered to.
+//Anything that does so rebinds the framebuffer this returns afterwards.
+GLuint GLFramebuffer::getBound() {
+    GLint name;
+    glGetIntegerv( GL_DRAW_FRAMEBUFFER_BINDING, &name );
+    return name;
+}
+
+//Clamps a number of samples to the most the driver supports
+GLsizei GLFramebuffer::getSampleCount( const std::size_t samples ) {
+    if( samples == 0 )
+        return 0;
+
+    GLint maxSamples = 0;
+    glGetIntegerv( GL_MAX_SAMPLES, &maxSamples );
+    return (GLsizei)std::min( samples, (std::size_t)std::max( maxSamples, 1 ) );
+}
+
+
+
+
+} //namespace Brimstone::Private
@@ -0,0 +1,91 @@
+/*
+opengl/GLFramebuffer.hpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    OpenGL implementation of Framebuffer, using a framebuffer object.
+    The color attachment is either a texture owned by the caller, or a (usually multisampled) renderbuffer owned by the framebuffer;
+    the depth attachment is a renderbuffer owned by the framebuffer.
+*/
+#ifndef BS_OPENGL_GLFRAMEBUFFER_HPP
+#define BS_OPENGL_GLFRAMEBUFFER_HPP
+
+
+
+
+//Includes
+#include <cstddef>                       //std::size_t
+
+#include <brimstone/graphics/Enums.hpp>  //Brimstone::TextureFormat, Brimstone::FilterType
+
+#include <gll/gl_types.hpp>              //gll::GLuint, gll::GLsizei
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+//Forward declarations
+class GLTexture;
+
+
+
+
+class GLFramebuffer {
+public:
+    GLFramebuffer();
+    ~GLFramebuffer();
+
+    void        create();
+    void        destroy();
+
+    void        setColor( GLTexture& texture, const std::size_t level );
+    void        setColor( const std::size_t width, const std::size_t height, const TextureFormat format, const std::size_t samples );
+    void        setDepth( const std::size_t width, const std::size_t height, const std::size_t samples );
+    bool        isComplete() const;
+
+    void        bind();
+    void        unbind();
+
+    void        read( const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height, void* const rgbaOut );
+    void        blit( GLFramebuffer& target, const int x, const int y, const int width, const int height,
+                      const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter );
+    void        blitToWindow( const int windowHeight, const int x, const int y, const int width, const int height,
+                              const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter );
+
+    std::size_t getWidth() const;
+    std::size_t getHeight() const;
+    std::size_t getSamples() const;
+    gll::GLuint getName() const;
+private:
+    void        destroyColor();
+    void        blit( const gll::GLuint target, const int targetFramebufferHeight, const int x, const int y, const int width, const int height,
+                      const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter );
+    static gll::GLuint getBound();
+    static gll::GLsizei getSampleCount( const std::size_t samples );
+private:
+    gll::GLuint  m_name;
+    gll::GLuint  m_color;
+    gll::GLuint  m_depth;
+
+    //Size of the color attachment
+    gll::GLsizei m_width;
+    gll::GLsizei m_height;
+
+    //Samples per pixel of the color attachment; 0 if it isn't multisampled
+    gll::GLsizei m_samples;
+};
+
+
+
+
+} //namespace Brimstone::Private
+
+
+
+
+#endif //BS_OPENGL_GLFRAMEBUFFER_HPP
@@ -0,0 +1,365 @@
+/*
+opengl/GLGpuProfiler.cpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See GLGpuProfiler.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include "GLGpuProfiler.hpp"        //Header
+#include "GLGraphicsImpl.hpp"       //Brimstone::Private::GLGraphicsImpl::isVersionSupported, Brimstone::Private::GLGraphicsImpl::isExtensionSupported
+
+#include <brimstone/Exception.hpp>  //Brimstone::GraphicsException, Brimstone::BoundsException, Brimstone::IException, Brimstone::uncaughtException
+
+#include <gll/gl_4_6_comp.hpp>      //gll::* (GL 4.6 and below + compatibility)
+using namespace gll;
+
+
+
+
+namespace {
+
+
+
+
+//Constants
+//Pipeline statistics queries, in the order their results are stored in a GpuPipelineStatistics
+constexpr GLenum STATISTIC_TARGETS[ Brimstone::Private::GLGpuProfiler::STATISTIC_COUNT ] {
+    GL_VERTICES_SUBMITTED,
+    GL_PRIMITIVES_SUBMITTED,
+    GL_VERTEX_SHADER_INVOCATIONS,
+    GL_CLIPPING_INPUT_PRIMITIVES,
+    GL_CLIPPING_OUTPUT_PRIMITIVES,
+    GL_FRAGMENT_SHADER_INVOCATIONS
+};
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+GLGpuProfiler::GLGpuProfiler() :
+    m_current( nullptr ),
+    m_timer( false ),
+    m_pipelineStatistics( false ) {
+}
+
+GLGpuProfiler::~GLGpuProfiler() {
+    try                           { end();                   }
+    catch( const IException& ex ) { uncaughtException( ex ); }
+
+    destroy();
+}
+
+/*
+GLGpuProfiler::create
+---------------------
+
+Description:
+    Checks which queries the context supports and creates the pipeline statistics queries for each slot.
+    Timestamp queries are created as they're needed.
+
+Arguments:
+    slotCount:          The number of frames that can be in flight at once.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the queries couldn't be created.
+*/
+void GLGpuProfiler::create( const std::size_t slotCount ) {
+    destroy();
+
+    m_timer              = GLGraphicsImpl::isVersionSupported( 3, 3 ) || GLGraphicsImpl::isExtensionSupported( "GL_ARB_timer_query" );
+    m_pipelineStatistics = GLGraphicsImpl::isVersionSupported( 4, 6 ) || GLGraphicsImpl::isExtensionSupported( "GL_ARB_pipeline_statistics_query" );
+
+    m_slots.resize( slotCount );
+    for( Slot& slot : m_slots ) {
+        slot.used = 0;
+        for( GLuint& query : slot.statistics )
+            query = 0;
+        if( m_pipelineStatistics ) {
+            glGenQueries( (GLsizei)STATISTIC_COUNT, slot.statistics );
+            if( glGetError() != GL_NO_ERROR )
+                throw GraphicsException( "glGenQueries() failed." );
+        }
+    }
+}
+
+void GLGpuProfiler::destroy() {
+    end();
+    for( Slot& slot : m_slots ) {
+        if( !slot.timestamps.empty() )
+            glDeleteQueries( (GLsizei)slot.timestamps.size(), slot.timestamps.data() );
+        if( slot.statistics[0] != 0 )
+            glDeleteQueries( (GLsizei)STATISTIC_COUNT, slot.statistics );
+    }
+    m_slots.clear();
+    m_current = nullptr;
+}
+
+/*
+GLGpuProfiler::begin
+--------------------
+
+Description:
+    Starts recording a frame into the given slot.
+    Any results the slot still holds from an earlier frame are discarded.
+    If pipeline statistics are supported, their queries are begun here, so no other pipeline statistics
+    queries can be active until end() is called.
+
+Arguments:
+    slot:               The slot to record into.
+
+Returns:
+    N/A
+
+Throws:
+    BoundsException:    If BS_CHECK_INDEX is defined and slot is out of range.
+    GraphicsException:  If the pipeline statistics queries couldn't be begun.
+*/
+void GLGpuProfiler::begin( const std::size_t slot ) {
+#ifdef BS_CHECK_INDEX
+    if( slot >= m_slots.size() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    m_current       = &m_slots[ slot ];
+    m_current->used = 0;
+
+    if( m_pipelineStatistics ) {
+        for( std::size_t i = 0; i < STATISTIC_COUNT; ++i )
+            glBeginQuery( STATISTIC_TARGETS[i], m_current->statistics[i] );
+        if( glGetError() != GL_NO_ERROR )
+            throw GraphicsException( "glBeginQuery() failed." );
+    }
+}
+
+void GLGpuProfiler::end() {
+    if( m_current == nullptr )
+        return;
+
+    //The frame is over even if its queries couldn't be ended, so destroy() can still clean up afterwards
+    m_current = nullptr;
+    if( m_pipelineStatistics ) {
+        for( std::size_t i = 0; i < STATISTIC_COUNT; ++i )
+            glEndQuery( STATISTIC_TARGETS[i] );
+        if( glGetError() != GL_NO_ERROR )
+            throw GraphicsException( "glEndQuery() failed." );
+    }
+}
+
+/*
+GLGpuProfiler::writeTimestamp
+-----------------------------
+
+Description:
+    Has the GPU record the time once every command submitted before this call has completed.
+
+Arguments:
+    N/A
+
+Returns:
+    std::size_t:        The index of the timestamp in the current slot.
+                        If timer queries aren't supported, nothing is recorded and 0 is returned.
+
+Throws:
+    GraphicsException:  If called outside of begin() / end(), or the query failed.
+*/
+std::size_t GLGpuProfiler::writeTimestamp() {
+    if( m_current == nullptr )
+        throw GraphicsException( "A timestamp was written outside of a frame." );
+    if( !m_timer )
+        return 0;
+
+    Slot& slot = *m_current;
+    if( slot.used == slot.timestamps.size() ) {
+        //Double the number of queries in the slot rather than creating them one at a time
+        const std::size_t count = slot.timestamps.empty() ? 16 : slot.timestamps.size();
+        slot.timestamps.resize( slot.timestamps.size() + count );
+        glGenQueries( (GLsizei)count, slot.timestamps.data() + slot.used );
+        if( glGetError() != GL_NO_ERROR )
+            throw GraphicsException( "glGenQueries() failed." );
+    }
+
+    glQueryCounter( slot.timestamps[ slot.used ], GL_TIMESTAMP );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glQueryCounter() failed." );
+    return slot.used++;
+}
+
+/*
+GLGpuProfiler::isAvailable
+--------------------------
+
+Description:
+    Checks whether the results of the frame last recorded in the given slot can be read without waiting on the GPU.
+    Queries complete in order, so only the last of them is checked.
+
+Arguments:
+    slot:               The slot to check.
+
+Returns:
+    bool:               true if the results are available, false otherwise.
+
+Throws:
+    BoundsException:    If BS_CHECK_INDEX is defined and slot is out of range.
+    GraphicsException:  If the queries couldn't be checked.
+*/
+bool GLGpuProfiler::isAvailable( const std::size_t slot ) const {
+#ifdef BS_CHECK_INDEX
+    if( slot >= m_slots.size() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    const Slot& s = m_slots[ slot ];
+    GLuint available = GL_TRUE;
+    if( s.used > 0 )
+        glGetQueryObjectuiv( s.timestamps[ s.used - 1 ], GL_QUERY_RESULT_AVAILABLE, &available );
+    if( available == GL_TRUE && m_pipelineStatistics )
+        glGetQueryObjectuiv( s.statistics[ STATISTIC_COUNT - 1 ], GL_QUERY_RESULT_AVAILABLE, &available );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glGetQueryObjectuiv() failed." );
+    return available == GL_TRUE;
+}
+
+std::size_t GLGpuProfiler::getTimestampCount( const std::size_t slot ) const {
+#ifdef BS_CHECK_INDEX
+    if( slot >= m_slots.size() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    return m_slots[ slot ].used;
+}
+
+/*
+GLGpuProfiler::getTimestamps
+----------------------------
+
+Description:
+    Reads the timestamps written during the frame last recorded in the given slot.
+    This waits on the GPU if the results aren't available yet; check with isAvailable() first to avoid stalling.
+
+Arguments:
+    slot:               The slot to read from.
+    timestampsOut:      Receives getTimestampCount( slot ) timestamps, in nanoseconds.
+
+Returns:
+    N/A
+
+Throws:
+    BoundsException:    If BS_CHECK_INDEX is defined and slot is out of range.
+    GraphicsException:  If the results couldn't be read.
+*/
+void GLGpuProfiler::getTimestamps( const std::size_t slot, uint64* const timestampsOut ) const {
+#ifdef BS_CHECK_INDEX
+    if( slot >= m_slots.size() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    const Slot& s = m_slots[ slot ];
+    for( std::size_t i = 0; i < s.used; ++i ) {
+        GLuint64 time;
+        glGetQueryObjectui64v( s.timestamps[i], GL_QUERY_RESULT, &time );
+        timestampsOut[i] = time;
+    }
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glGetQueryObjectui64v() failed." );
+}
+
+/*
+GLGpuProfiler::getPipelineStatistics
+------------------------------------
+
+Description:
+    Reads the pipeline statistics of the frame last recorded in the given slot.
+    Like getTimestamps(), this waits on the GPU if the results aren't available yet.
+
+Arguments:
+    slot:               The slot to read from.
+    statisticsOut:      Receives the statistics. Left unchanged if pipeline statistics aren't supported.
+
+Returns:
+    N/A
+
+Throws:
+    BoundsException:    If BS_CHECK_INDEX is defined and slot is out of range.
+    GraphicsException:  If the results couldn't be read.
+*/
+void GLGpuProfiler::getPipelineStatistics( const std::size_t slot, GpuPipelineStatistics& statisticsOut ) const {
+#ifdef BS_CHECK_INDEX
+    if( slot >= m_slots.size() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    if( !m_pipelineStatistics )
+        return;
+
+    GLuint64 values[ STATISTIC_COUNT ];
+    for( std::size_t i = 0; i < STATISTIC_COUNT; ++i )
+        glGetQueryObjectui64v( m_slots[ slot ].statistics[i], GL_QUERY_RESULT, &values[i] );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glGetQueryObjectui64v() failed." );
+
+    statisticsOut.verticesSubmitted         = values[0];
+    statisticsOut.primitivesSubmitted       = values[1];
+    statisticsOut.vertexShaderInvocations   = values[2];
+    statisticsOut.clippingInputPrimitives   = values[3];
+    statisticsOut.clippingOutputPrimitives  = values[4];
+    statisticsOut.fragmentShaderInvocations = values[5];
+}
+
+bool GLGpuProfiler::isTimerSupported() const {
+    return m_timer;
+}
+
+bool GLGpuProfiler::isPipelineStatisticsSupported() const {
+    return m_pipelineStatistics;
+}
+
+/*
+GLGpuProfiler::getTime
+----------------------
+
+Description:
+    Returns the GPU's current time, on the same clock as the timestamps it writes.
+    Unlike a timestamp query, this doesn't wait for submitted commands to complete.
+
+Arguments:
+    N/A
+
+Returns:
+    uint64:             The GPU's time in nanoseconds, or 0 if timer queries aren't supported.
+
+Throws:
+    GraphicsException:  If the time couldn't be read.
+*/
+uint64 GLGpuProfiler::getTime() const {
+    if( !m_timer )
+        return 0;
+
+    GLint64 time;
+    glGetInteger64v( GL_TIMESTAMP, &time );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glGetInteger64v() failed." );
+    return (uint64)time;
+}
+
+
+
+
+} //namespace Brimstone::Private
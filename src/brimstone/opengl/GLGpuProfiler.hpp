@@ -0,0 +1,81 @@
+/*
+opengl/GLGpuProfiler.hpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    OpenGL implementation of the queries a GpuProfiler makes.
+    Timing uses GL_TIMESTAMP queries (OpenGL 3.3 or ARB_timer_query), which unlike GL_TIME_ELAPSED queries can be nested.
+    Pipeline statistics use the queries from OpenGL 4.6 or ARB_pipeline_statistics_query.
+
+    Queries are kept in slots, one per frame the profiler has in flight.
+    A slot's queries are reused once their results have been read (or the frame they belonged to was dropped).
+*/
+#ifndef BS_OPENGL_GLGPUPROFILER_HPP
+#define BS_OPENGL_GLGPUPROFILER_HPP
+
+
+
+
+//Includes
+#include <cstddef>                             //std::size_t
+#include <vector>                              //std::vector
+
+#include <brimstone/types.hpp>                 //Brimstone::uint64
+#include <brimstone/graphics/GpuProfiler.hpp>  //Brimstone::GpuPipelineStatistics
+
+#include <gll/gl_types.hpp>                    //gll::GLuint
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+class GLGpuProfiler {
+public:
+    static constexpr std::size_t STATISTIC_COUNT = 6;
+public:
+    GLGpuProfiler();
+    ~GLGpuProfiler();
+
+    void        create( const std::size_t slotCount );
+    void        destroy();
+
+    void        begin( const std::size_t slot );
+    void        end();
+    std::size_t writeTimestamp();
+
+    bool        isAvailable( const std::size_t slot ) const;
+    std::size_t getTimestampCount( const std::size_t slot ) const;
+    void        getTimestamps( const std::size_t slot, uint64* const timestampsOut ) const;
+    void        getPipelineStatistics( const std::size_t slot, GpuPipelineStatistics& statisticsOut ) const;
+
+    bool        isTimerSupported() const;
+    bool        isPipelineStatisticsSupported() const;
+    uint64      getTime() const;
+private:
+    struct Slot {
+        //Timestamp queries, grown as needed; the first used of them were written to in the slot's last frame
+        std::vector< gll::GLuint > timestamps;
+        std::size_t                used;
+        gll::GLuint                statistics[ STATISTIC_COUNT ];
+    };
+private:
+    std::vector< Slot > m_slots;
+    Slot*               m_current;
+    bool                m_timer;
+    bool                m_pipelineStatistics;
+};
+
+
+
+
+} //namespace Brimstone::Private
+
+
+
+
+#endif //BS_OPENGL_GLGPUPROFILER_HPP
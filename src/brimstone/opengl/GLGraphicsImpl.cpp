@@ -11,19 +11,26 @@ Description:
 
 
 //Includes
-#include "GLGraphicsImpl.hpp"    //Header
-#include "GLShader.hpp"          //Brimstone::GLShader
-#include "GLProgram.hpp"         //Brimstone::GLProgram
-#include "GLVertexBuffer.hpp"    //Brimstone::GLVertexBuffer
-#include "GLTexture.hpp"         //Brimstone::GLTexture
-#include "GLSampler.hpp"         //Brimstone::GLSampler
-
-#include <brimstone/Logger.hpp>  //Brimstone::logInfo
-
-#include <boost/format.hpp>      //boost::format
-
-#include <gll/loader.hpp>        //gll::Load
-#include <gll/gl_4_6_comp.hpp>   //gll::* (GL 4.6 and below + compatibility)
+#include "GLGraphicsImpl.hpp"        //Header
+#include "GLShader.hpp"              //Brimstone::GLShader
+#include "GLProgram.hpp"             //Brimstone::GLProgram
+#include "GLVertexBuffer.hpp"        //Brimstone::GLVertexBuffer
+#include "GLIndexBuffer.hpp"         //Brimstone::GLIndexBuffer
+#include "GLStreamingBuffer.hpp"     //Brimstone::GLStreamingBuffer
+#include "GLDrawIndirectBuffer.hpp"  //Brimstone::GLDrawIndirectBuffer
+#include "GLTexture.hpp"             //Brimstone::GLTexture
+#include "GLSampler.hpp"             //Brimstone::GLSampler
+#include "GLFramebuffer.hpp"         //Brimstone::GLFramebuffer
+
+#include <brimstone/Logger.hpp>      //Brimstone::logInfo
+#include <brimstone/Exception.hpp>   //Brimstone::GraphicsException, Brimstone::BoundsException
+
+#include <boost/format.hpp>          //boost::format
+
+#include <algorithm>                 //std::sort, std::binary_search
+
+#include <gll/loader.hpp>            //gll::Load
+#include <gll/gl_4_6_comp.hpp>       //gll::* (GL 4.6 and below + compatibility)
 using namespace gll;
 
 
@@ -59,6 +66,29 @@ constexpr Brimstone::AlphaFunc GLAlphaFuncToAlphaFunc[] {
     ALWAYS,                 //GL_ALWAYS
 };
 
+//Passed to glMaxShaderCompilerThreadsKHR to let the driver decide how many threads to compile shaders on
+constexpr GLuint MAX_SHADER_COMPILER_THREADS = 0xFFFFFFFF;
+
+
+
+
+//Functions
+//Sets a uniform on the given program from a SET_UNIFORM command
+void setUniform( Brimstone::Private::GLProgram& program, const Brimstone::Commands::SetUniform& command ) {
+    using Brimstone::UniformType;
+
+    const char* const name = command.getName();
+    switch( command.type ) {
+    case UniformType::INT:    program.setUniform( name, command.i[0] );                                             break;
+    case UniformType::UINT:   program.setUniform( name, command.u[0] );                                             break;
+    case UniformType::FLOAT:  program.setUniform( name, command.f[0] );                                             break;
+    case UniformType::INT2:   program.setUniform( name, command.i[0], command.i[1] );                               break;
+    case UniformType::FLOAT2: program.setUniform( name, command.f[0], command.f[1] );                               break;
+    case UniformType::INT4:   program.setUniform( name, command.i[0], command.i[1], command.i[2], command.i[3] );   break;
+    case UniformType::FLOAT4: program.setUniform( name, command.f[0], command.f[1], command.f[2], command.f[3] );   break;
+    }
+}
+
 
 
 
@@ -73,10 +103,29 @@ namespace Brimstone::Private {
 
 
 //Static initializers
-std::atomic<bool> GLGraphicsImpl::m_initialized( false );
+std::atomic<bool>        GLGraphicsImpl::m_initialized( false );
+int                      GLGraphicsImpl::m_versionMajor( 0 );
+int                      GLGraphicsImpl::m_versionMinor( 0 );
+std::vector<std::string> GLGraphicsImpl::m_extensions;
+std::string              GLGraphicsImpl::m_deviceName;
+std::string              GLGraphicsImpl::m_driverVersion;
+bool                     GLGraphicsImpl::m_parallelShaderCompile( false );
+
+void GLGraphicsImpl::init() {
+    m_context.init();
+    m_stats = GraphicsStats();
+
+    initOpenGL( m_context );
+
+    //Offscreen contexts have no default framebuffer worth rendering to, so this is likely empty
+    begin();
+    getViewport( m_viewport.data );
+    end();
+}
 
 void GLGraphicsImpl::init( const Brimstone::Window& window ) {
     m_context.init( window );
+    m_stats = GraphicsStats();
 
     //After the first context is created, we can load OpenGL extensions, among other things.
     initOpenGL( m_context );
@@ -99,47 +148,375 @@ void GLGraphicsImpl::end() {
     m_context.end();
 }
 
-GLShader* GLGraphicsImpl::createShader( const ShaderType type ) {
-    //TEMP: heap allocation
-    return new GLShader( type );
+Handle< GLShader > GLGraphicsImpl::createShader( const ShaderType type ) {
+    return SlotPool< GLShader >::getInstance().create( type );
 }
 
-GLProgram* GLGraphicsImpl::createProgram() {
-    //TEMP: heap allocation
-    return new GLProgram();
+Handle< GLProgram > GLGraphicsImpl::createProgram() {
+    return SlotPool< GLProgram >::getInstance().create();
 }
 
-GLVertexBuffer* GLGraphicsImpl::createVertexBuffer() {
-    //TEMP: heap allocation
-    return new GLVertexBuffer();
+Handle< GLVertexBuffer > GLGraphicsImpl::createVertexBuffer() {
+    return SlotPool< GLVertexBuffer >::getInstance().create();
 }
 
-GLTexture* GLGraphicsImpl::createTexture() {
-    //TEMP: heap allocation
-    return new GLTexture();
+Handle< GLIndexBuffer > GLGraphicsImpl::createIndexBuffer() {
+    return SlotPool< GLIndexBuffer >::getInstance().create();
 }
 
-GLSampler* GLGraphicsImpl::createSampler() {
-    //TEMP: heap allocation
-    return new GLSampler();
+Handle< GLStreamingBuffer > GLGraphicsImpl::createStreamingBuffer( const std::size_t regionSize, const std::size_t regionCount ) {
+    return SlotPool< GLStreamingBuffer >::getInstance().create( regionSize, regionCount );
+}
+
+Handle< GLDrawIndirectBuffer > GLGraphicsImpl::createDrawIndirectBuffer( const std::size_t capacity, const std::size_t regionCount ) {
+    return SlotPool< GLDrawIndirectBuffer >::getInstance().create( capacity, regionCount );
+}
+
+Handle< GLTexture > GLGraphicsImpl::createTexture() {
+    return SlotPool< GLTexture >::getInstance().create();
+}
+
+Handle< GLSampler > GLGraphicsImpl::createSampler() {
+    return SlotPool< GLSampler >::getInstance().create();
+}
+
+Handle< GLFramebuffer > GLGraphicsImpl::createFramebuffer() {
+    return SlotPool< GLFramebuffer >::getInstance().create();
 }
 
 void GLGraphicsImpl::flush() {
     glFlush();
 }
 
+void GLGraphicsImpl::finish() {
+    glFinish();
+}
+
+void GLGraphicsImpl::blit( GLFramebuffer& source, const int x, const int y, const int width, const int height,
+                           const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter ) {
+    //Like the scissor box, the window's region is measured from the top of the viewport
+    source.blitToWindow( m_viewport.getHeight(), x, y, width, height, targetX, targetY, targetWidth, targetHeight, filter );
+}
+
+/*
+GLGraphicsImpl::execute
+-----------------------
+
+Description:
+    Sorts the packets of the given command buffers by their keys and replays their commands.
+    Binding a program, texture or sampler that's already bound by an earlier packet is skipped.
+
+Arguments:
+    buffers:            The command buffers to execute.
+    count:              The number of command buffers.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If a uniform is set before any program is used, a command refers to an object that has been destroyed,
+                        or a command failed.
+*/
+void GLGraphicsImpl::execute( const CommandBuffer* const* buffers, const std::size_t count ) {
+    sortCommandPackets( buffers, count, m_packets );
+
+    //What's bound isn't known before the first packet, so the first bind of each is never skipped
+    Handle< GLProgram > program;
+    Handle< GLTexture > texture;
+    Handle< GLSampler > sampler;
+    bool                samplerKnown = false;
+
+    for( const CommandPacket& packet : m_packets ) {
+        const ubyte*       command = packet.data;
+        const ubyte* const end     = packet.data + packet.size;
+        while( command < end ) {
+            const CommandHeader& header = *reinterpret_cast< const CommandHeader* >( command );
+            const void*          data   = command + sizeof( CommandHeader );
+            command += header.size;
+
+            switch( header.type ) {
+            case CommandType::USE_PROGRAM: {
+                const Commands::UseProgram& c = *static_cast< const Commands::UseProgram* >( data );
+                if( c.program != program ) {
+                    c.program->use();
+                    program = c.program;
+                    ++m_stats.stateChanges;
+                }
+                break;
+            }
+            case CommandType::SET_UNIFORM: {
+                const Commands::SetUniform& c = *static_cast< const Commands::SetUniform* >( data );
+                if( program == nullptr )
+                    throw GraphicsException( "A uniform was set before a program was used." );
+                setUniform( *program, c );
+                break;
+            }
+            case CommandType::BIND_TEXTURE: {
+                const Commands::BindTexture& c = *static_cast< const Commands::BindTexture* >( data );
+                if( c.texture != texture ) {
+                    c.texture->bind();
+                    texture = c.texture;
+                    ++m_stats.stateChanges;
+                }
+                if( c.sampler != sampler || !samplerKnown ) {
+                    if( c.sampler != nullptr )
+                        c.sampler->bind();
+                    else
+                        glBindSampler( 0, 0 );
+                    sampler      = c.sampler;
+                    samplerKnown = true;
+                    ++m_stats.stateChanges;
+                }
+                break;
+            }
+            case CommandType::SET_BLEND_MODE:
+                setBlendMode( static_cast< const Commands::SetBlendMode* >( data )->mode );
+                break;
+            case CommandType::SET_DEPTH_TEST:
+                setDepthTest( static_cast< const Commands::SetEnabled* >( data )->enabled );
+                break;
+            case CommandType::SET_DEPTH_MASK:
+                setDepthMask( static_cast< const Commands::SetEnabled* >( data )->enabled );
+                break;
+            case CommandType::SET_BACK_FACE_CULLING:
+                setBackFaceCulling( static_cast< const Commands::SetEnabled* >( data )->enabled );
+                break;
+            case CommandType::SET_SCISSOR_TEST:
+                setScissorTest( static_cast< const Commands::SetEnabled* >( data )->enabled );
+                break;
+            case CommandType::SET_SCISSOR_BOX: {
+                const Commands::SetRect& c = *static_cast< const Commands::SetRect* >( data );
+                setScissorBox( c.x, c.y, c.width, c.height );
+                break;
+            }
+            case CommandType::SET_VIEWPORT: {
+                const Commands::SetRect& c = *static_cast< const Commands::SetRect* >( data );
+                setViewport( c.x, c.y, c.width, c.height );
+                break;
+            }
+            case CommandType::SET_CLEAR_COLOR: {
+                const Commands::SetClearColor& c = *static_cast< const Commands::SetClearColor* >( data );
+                setClearColor( c.rgba[0], c.rgba[1], c.rgba[2], c.rgba[3] );
+                break;
+            }
+            case CommandType::CLEAR:
+                clear();
+                break;
+            case CommandType::DRAW_INDEXED: {
+                const Commands::DrawIndexed& c = *static_cast< const Commands::DrawIndexed* >( data );
+                if( c.instanceCount == 0 )
+                    drawIndexed( *c.vertices, *c.indices, c.first, c.count, c.baseVertex );
+                else
+                    drawIndexedInstanced( *c.vertices, *c.indices, c.first, c.count, c.baseVertex, c.instanceCount, c.baseInstance );
+                break;
+            }
+            case CommandType::DRAW_STREAMING: {
+                const Commands::DrawStreaming& c = *static_cast< const Commands::DrawStreaming* >( data );
+                if( c.indices == nullptr )
+                    draw( *c.vertices, c.first, c.count );
+                else
+                    drawIndexed( *c.vertices, *c.indices, c.first, c.count, c.baseVertex );
+                break;
+            }
+            }
+        }
+    }
+}
+
+void GLGraphicsImpl::drawIndexed( GLVertexBuffer& vertices, GLIndexBuffer& indices ) {
+    drawIndexed( vertices, indices, 0, indices.getCount(), 0 );
+}
+
+/*
+GLGraphicsImpl::drawIndexed{2}
+------------------------------
+
+Description:
+    Draws triangles from a range of the given index buffer.
+    baseVertex is added to every index before it is used to fetch a vertex,
+    which allows several meshes to share one vertex buffer and one index buffer without rewriting their indices.
+
+Arguments:
+    vertices:         The vertices to draw.
+    indices:          The indices of the vertices to draw.
+    first:            The first index to draw.
+    count:            The number of indices to draw.
+    baseVertex:       A value added to every index.
+
+Returns:
+    N/A
+
+Throws:
+    BoundsException:  If BS_CHECK_INDEX is defined and the range is outside of the index buffer.
+*/
+void GLGraphicsImpl::drawIndexed( GLVertexBuffer& vertices, GLIndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex ) {
+    drawElements( vertices.getVertexArray(), indices, first, count, baseVertex );
+}
+
+/*
+GLGraphicsImpl::draw
+--------------------
+
+Description:
+    Draws triangles from vertices allocated from a streaming buffer this frame.
+
+Arguments:
+    vertices:  The streaming buffer holding the vertices.
+    first:     The index of the first vertex to draw (as returned by allocateVertices()).
+    count:     The number of vertices to draw.
+
+Returns:
+    N/A
+*/
+void GLGraphicsImpl::draw( GLStreamingBuffer& vertices, const std::size_t first, const std::size_t count ) {
+    vertices.flush();
+    glBindVertexArray( vertices.getVertexArray() );
+    glDrawArrays( GL_TRIANGLES, (GLint)first, (GLsizei)count );
+    countDraw( count, 1 );
+}
+
+void GLGraphicsImpl::drawIndexed( GLStreamingBuffer& vertices, GLIndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex ) {
+    vertices.flush();
+    drawElements( vertices.getVertexArray(), indices, first, count, baseVertex );
+}
+
+/*
+GLGraphicsImpl::drawInstanced
+-----------------------------
+
+Description:
+    Draws every vertex in the given vertex buffer instanceCount times.
+    Per-instance data is supplied by instance streams attached to the vertex buffer.
+
+Arguments:
+    vertices:       The vertices to draw.
+    instanceCount:  The number of instances to draw.
+
+Returns:
+    N/A
+*/
+void GLGraphicsImpl::drawInstanced( GLVertexBuffer& vertices, const std::size_t instanceCount ) {
+    glBindVertexArray( vertices.getVertexArray() );
+    glDrawArraysInstanced( GL_TRIANGLES, 0, vertices.getCount(), (GLsizei)instanceCount );
+    countDraw( vertices.getCount(), instanceCount );
+}
+
+void GLGraphicsImpl::drawIndexedInstanced( GLVertexBuffer& vertices, GLIndexBuffer& indices, const std::size_t instanceCount ) {
+    drawIndexedInstanced( vertices, indices, 0, indices.getCount(), 0, instanceCount, 0 );
+}
+
+/*
+GLGraphicsImpl::drawIndexedInstanced{2}
+---------------------------------------
+
+Description:
+    Draws a range of the given index buffer instanceCount times.
+    Per-instance data is supplied by instance streams attached to the vertex buffer.
+
+Arguments:
+    vertices:         The vertices to draw.
+    indices:          The indices of the vertices to draw.
+    first:            The first index to draw.
+    count:            The number of indices to draw.
+    baseVertex:       A value added to every index.
+    instanceCount:    The number of instances to draw.
+    baseInstance:     The instance that per-instance attributes start at. Requires OpenGL 4.2 if non-zero.
+
+Returns:
+    N/A
+
+Throws:
+    BoundsException:  If BS_CHECK_INDEX is defined and the range is outside of the index buffer.
+*/
+void GLGraphicsImpl::drawIndexedInstanced( GLVertexBuffer& vertices, GLIndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex,
+                                           const std::size_t instanceCount, const uint baseInstance ) {
+#ifdef BS_CHECK_INDEX
+    if( first + count > indices.getCount() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    glBindVertexArray( vertices.getVertexArray() );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, indices.getName() );
+
+    const GLvoid* offset = (const GLvoid*)( first * indices.getIndexSize() );
+    if( baseInstance != 0 )
+        glDrawElementsInstancedBaseVertexBaseInstance( GL_TRIANGLES, (GLsizei)count, indices.getGLType(), offset, (GLsizei)instanceCount, baseVertex, baseInstance );
+    else if( baseVertex != 0 )
+        glDrawElementsInstancedBaseVertex( GL_TRIANGLES, (GLsizei)count, indices.getGLType(), offset, (GLsizei)instanceCount, baseVertex );
+    else
+        glDrawElementsInstanced( GL_TRIANGLES, (GLsizei)count, indices.getGLType(), offset, (GLsizei)instanceCount );
+    countDraw( count, instanceCount );
+}
+
+/*
+GLGraphicsImpl::multiDrawIndirect
+---------------------------------
+
+Description:
+    Draws every command in the current batch of the given draw indirect buffer,
+    with a single call if isMultiDrawIndirectSupported() returns true, then starts a new batch.
+    Every command draws from the same vertex and index buffers.
+    The batch counts as a single draw call in GraphicsStats.
+
+Arguments:
+    vertices:           The vertices to draw.
+    indices:            The indices of the vertices to draw.
+    commands:           The commands to draw.
+
+Returns:
+    N/A
+
+Throws:
+    BoundsException:    If BS_CHECK_INDEX is defined and one of the commands draws indices outside of the index buffer.
+    GraphicsException:  If indirect draws aren't supported (they require OpenGL 4.0 or GL_ARB_draw_indirect).
+*/
+void GLGraphicsImpl::multiDrawIndirect( GLVertexBuffer& vertices, GLIndexBuffer& indices, GLDrawIndirectBuffer& commands ) {
+    const std::size_t count = commands.getBatchCount();
+    if( count == 0 )
+        return;
+
+#ifdef BS_CHECK_INDEX
+    if( commands.getBatchIndexEnd() > indices.getCount() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    commands.flush();
+    glBindVertexArray( vertices.getVertexArray() );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, indices.getName() );
+    glBindBuffer( GL_DRAW_INDIRECT_BUFFER, commands.getName() );
+
+    const std::size_t offset = commands.getBatchOffset();
+    if( isMultiDrawIndirectSupported() ) {
+        glMultiDrawElementsIndirect( GL_TRIANGLES, indices.getGLType(), (const GLvoid*)offset, (GLsizei)count, 0 );
+    } else if( isVersionSupported( 4, 0 ) || isExtensionSupported( "GL_ARB_draw_indirect" ) ) {
+        for( std::size_t i = 0; i < count; ++i )
+            glDrawElementsIndirect( GL_TRIANGLES, indices.getGLType(), (const GLvoid*)( offset + i * GLDrawIndirectBuffer::COMMAND_SIZE ) );
+    } else {
+        glBindBuffer( GL_DRAW_INDIRECT_BUFFER, 0 );
+        throw GraphicsException( "Indirect draws aren't supported." );
+    }
+    glBindBuffer( GL_DRAW_INDIRECT_BUFFER, 0 );
+
+    ++m_stats.drawCalls;
+    m_stats.instances += commands.getBatchInstances();
+    m_stats.triangles += commands.getBatchTriangles();
+    commands.endBatch();
+}
+
 void GLGraphicsImpl::enableBackFaceCulling() {
     //Initial value of GL_CULL_FACE_MODE is GL_BACK; no need to set it explicitly:
     //glCullFace( GL_BACK );
     glEnable( GL_CULL_FACE );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glEnable() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::disableBackFaceCulling() {
     glDisable( GL_CULL_FACE );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glDisable() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::setBackFaceCulling( const bool enabled ) {
@@ -162,12 +539,14 @@ void GLGraphicsImpl::enableDepthTest() {
     glEnable( GL_DEPTH_TEST );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glEnable() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::disableDepthTest() {
     glDisable( GL_DEPTH_TEST );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glDisable() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::setDepthTest( const bool enabled ) {
@@ -190,6 +569,7 @@ void GLGraphicsImpl::setDepthMask( const bool enabled ) {
     glDepthMask( enabled ? GL_TRUE : GL_FALSE );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glDepthMask() failed." );
+    ++m_stats.stateChanges;
 }
 
 bool GLGraphicsImpl::getDepthMask() const {
@@ -204,12 +584,14 @@ void GLGraphicsImpl::enableScissorTest() {
     glEnable( GL_SCISSOR_TEST );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glEnable() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::disableScissorTest() {
     glDisable( GL_SCISSOR_TEST );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glDisable() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::setScissorTest( const bool enabled ) {
@@ -235,6 +617,7 @@ void GLGraphicsImpl::setScissorBox( const int x, const int y, const int width, c
     glScissor( x, m_viewport.getHeight() - y - height, width, height );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glScissor() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::getScissorBox( int (&xywhOut)[4] ) const {
@@ -248,12 +631,14 @@ void GLGraphicsImpl::enableAlphaTest() {
     glEnable( GL_ALPHA_TEST );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glEnable() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::disableAlphaTest() {
     glDisable( GL_ALPHA_TEST );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glDisable() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::setAlphaTest( const bool enabled ) {
@@ -276,6 +661,7 @@ void GLGraphicsImpl::setAlphaFunc( const AlphaFunc func, const float ref ) {
     glAlphaFunc( AlphaFuncToGLAlphaFunc[ (int)func ], ref );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glAlphaFunc() failed." );
+    ++m_stats.stateChanges;
 }
 
 AlphaFunc GLGraphicsImpl::getAlphaFunc() const {
@@ -298,12 +684,14 @@ void GLGraphicsImpl::enableBlend() {
     glEnable( GL_BLEND );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glEnable() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::disableBlend() {
     glDisable( GL_BLEND );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glDisable() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::setBlend( const bool enabled ) {
@@ -350,12 +738,56 @@ void GLGraphicsImpl::setBlendModeToTransparency() {
     glBlendFuncSeparate( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glBlendFuncSeparate() failed." );
+    ++m_stats.stateChanges;
+}
+
+/*
+GLGraphicsImpl::setBlendMode
+----------------------------
+
+Description:
+    Enables or disables blending and sets the blending equation appropriate for the given mode.
+
+Arguments:
+    mode:               The blend mode to use.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If OpenGL rejected the blend settings.
+*/
+void GLGraphicsImpl::setBlendMode( const BlendMode mode ) {
+    switch( mode ) {
+    case BlendMode::NONE:
+        disableBlend();
+        return;
+    case BlendMode::TRANSPARENCY:
+        setBlendModeToTransparency();
+        break;
+    case BlendMode::PREMULTIPLIED:
+        //Source RGB has already been multiplied by source alpha:
+        //    1*s_rgb + (1 - s_a) * d_rgb
+        glBlendEquationSeparate( GL_FUNC_ADD, GL_FUNC_ADD );
+        glBlendFuncSeparate( GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE );
+        break;
+    case BlendMode::ADDITIVE:
+        //    s_a*s_rgb + 1*d_rgb
+        glBlendEquationSeparate( GL_FUNC_ADD, GL_FUNC_ADD );
+        glBlendFuncSeparate( GL_SRC_ALPHA, GL_ONE, GL_ZERO, GL_ONE );
+        break;
+    }
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glBlendFuncSeparate() failed." );
+
+    enableBlend();
 }
 
 void GLGraphicsImpl::setClearColor( const float r, const float g, const float b, const float a ) {
     glClearColor( r, g, b, a );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glClearColor() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::getClearColor( float (&rgbaOut)[4] ) const {
@@ -368,12 +800,14 @@ void GLGraphicsImpl::setClearDepth( const float depth ) {
     glClearDepthf( depth );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glClearDepthf() failed." );
+    ++m_stats.stateChanges;
 }
 
 void GLGraphicsImpl::setClearDepth( const double depth ) {
     glClearDepth( depth );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glClearDepth() failed." );
+    ++m_stats.stateChanges;
 }
 
 double GLGraphicsImpl::getClearDepth() const {
@@ -386,6 +820,7 @@ double GLGraphicsImpl::getClearDepth() const {
 
 void GLGraphicsImpl::clear() {
     glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+    ++m_stats.clears;
 }
 
 void GLGraphicsImpl::setViewport( const int x, const int y, const int width, const int height ) {
@@ -397,6 +832,7 @@ void GLGraphicsImpl::setViewport( const int x, const int y, const int width, con
     glViewport( x, y, width, height );
     if( glGetError() != GL_NO_ERROR )
         throw GraphicsException( "glViewport() failed." );
+    ++m_stats.stateChanges;
     m_viewport.set( x, y, width, height );
 }
 
@@ -421,6 +857,10 @@ void GLGraphicsImpl::swapBuffers() {
     m_context.swapBuffers();
 }
 
+const GraphicsStats& GLGraphicsImpl::getStats() const {
+    return m_stats;
+}
+
 void GLGraphicsImpl::initOpenGL( GLContext& context ) {
     //Is this the first time we've called this function?
     //If m_initialized is "false", set it to "true" and continue.
@@ -439,25 +879,223 @@ void GLGraphicsImpl::initOpenGL( GLContext& context ) {
     GLint major, minor;
     glGetIntegerv( GL_MAJOR_VERSION, &major );
     glGetIntegerv( GL_MINOR_VERSION, &minor );
+    m_versionMajor = major;
+    m_versionMinor = minor;
 
     logInfo( ( boost::format( "OpenGL version is %d.%d." ) % major % minor ).str() );
 
-    //Log supported extensions
+    //GL_VERSION includes the driver's own version after the OpenGL version
+    m_deviceName    = reinterpret_cast< const char* >( glGetString( GL_RENDERER ) );
+    m_driverVersion = reinterpret_cast< const char* >( glGetString( GL_VERSION  ) );
+    logInfo( ( boost::format( "Renderer is %s (%s)." ) % m_deviceName % m_driverVersion ).str() );
+
+    //Log supported extensions and remember them so we can check for optional features later
     GLint extensions;
     glGetIntegerv( GL_NUM_EXTENSIONS, &extensions );
     logInfo( "Supported extensions:" );
+    m_extensions.clear();
+    m_extensions.reserve( extensions );
     for( GLuint i = 0; i < (GLuint)extensions; ++i ) {
+        const char* name = reinterpret_cast< const char* >( glGetStringi( GL_EXTENSIONS, i ) );
         logInfo( (
             boost::format( "%4d:    %s" ) %
             (i+1) %
-            glGetStringi( GL_EXTENSIONS, i )
+            name
         ).str() );
+        m_extensions.emplace_back( name );
+    }
+    std::sort( m_extensions.begin(), m_extensions.end() );
+
+    //If the driver can compile shaders on its own threads, let it use as many as it likes.
+    //The ARB version of the extension is identical to the KHR one.
+    m_parallelShaderCompile = false;
+    const char* maxThreadsName = nullptr;
+    if( isExtensionSupported( "GL_KHR_parallel_shader_compile" ) )
+        maxThreadsName = "glMaxShaderCompilerThreadsKHR";
+    else if( isExtensionSupported( "GL_ARB_parallel_shader_compile" ) )
+        maxThreadsName = "glMaxShaderCompilerThreadsARB";
+
+    if( maxThreadsName != nullptr ) {
+        using MaxShaderCompilerThreadsProc = void (*)( GLuint count );
+        MaxShaderCompilerThreadsProc glMaxShaderCompilerThreads = (MaxShaderCompilerThreadsProc)GLContext::getProcAddress( maxThreadsName );
+        if( glMaxShaderCompilerThreads != nullptr ) {
+            glMaxShaderCompilerThreads( MAX_SHADER_COMPILER_THREADS );
+            m_parallelShaderCompile = true;
+            logInfo( "Shaders will be compiled in parallel." );
+        }
     }
 
     //Done using it
     context.end();
 }
 
+void GLGraphicsImpl::drawElements( const GLuint vao, GLIndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex ) {
+#ifdef BS_CHECK_INDEX
+    if( first + count > indices.getCount() )
+        throw BoundsException();
+#endif //BS_CHECK_INDEX
+
+    //The element array binding is part of the VAO's state
+    glBindVertexArray( vao );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, indices.getName() );
+
+    const GLvoid* offset = (const GLvoid*)( first * indices.getIndexSize() );
+    if( baseVertex == 0 )
+        glDrawElements( GL_TRIANGLES, (GLsizei)count, indices.getGLType(), offset );
+    else
+        glDrawElementsBaseVertex( GL_TRIANGLES, (GLsizei)count, indices.getGLType(), offset, baseVertex );
+    countDraw( count, 1 );
+}
+
+void GLGraphicsImpl::countDraw( const std::size_t vertexCount, const std::size_t instanceCount ) {
+    ++m_stats.drawCalls;
+    m_stats.instances += instanceCount;
+    m_stats.triangles += ( vertexCount / 3 ) * instanceCount;
+}
+
+/*
+GLGraphicsImpl::isVersionSupported
+----------------------------------
+
+Description:
+    Returns true if the version of OpenGL we're using is at least major.minor.
+    initOpenGL() must have been called first.
+
+Arguments:
+    major:  The major version to check for.
+    minor:  The minor version to check for.
+
+Returns:
+    bool:   true if the version is supported, false otherwise.
+*/
+bool GLGraphicsImpl::isVersionSupported( const int major, const int minor ) {
+    return m_versionMajor > major || ( m_versionMajor == major && m_versionMinor >= minor );
+}
+
+/*
+GLGraphicsImpl::isExtensionSupported
+------------------------------------
+
+Description:
+    Returns true if the extension with the given name (e.g. "GL_ARB_buffer_storage") is supported.
+    initOpenGL() must have been called first.
+
+Arguments:
+    name:   The name of the extension to check for.
+
+Returns:
+    bool:   true if the extension is supported, false otherwise.
+*/
+bool GLGraphicsImpl::isExtensionSupported( const char* const name ) {
+    return std::binary_search( m_extensions.begin(), m_extensions.end(), name );
+}
+
+/*
+GLGraphicsImpl::isTextureFormatSupported
+----------------------------------------
+
+Description:
+    Returns true if textures can be created in the given format.
+    Uncompressed formats are always supported; block-compressed formats depend on the version of OpenGL and its extensions.
+    initOpenGL() must have been called first.
+
+Arguments:
+    format:  The format to check for.
+
+Returns:
+    bool:    true if the format is supported, false otherwise.
+*/
+bool GLGraphicsImpl::isTextureFormatSupported( const TextureFormat format ) {
+    switch( format ) {
+    case TextureFormat::BC1_RGBA:
+    case TextureFormat::BC3_RGBA:
+        return isExtensionSupported( "GL_EXT_texture_compression_s3tc" );
+    case TextureFormat::BC4_R:
+    case TextureFormat::BC5_RG:
+        return isVersionSupported( 3, 0 ) || isExtensionSupported( "GL_ARB_texture_compression_rgtc" );
+    case TextureFormat::BC7_RGBA:
+        return isVersionSupported( 4, 2 ) || isExtensionSupported( "GL_ARB_texture_compression_bptc" );
+    case TextureFormat::ETC2_RGB8:
+    case TextureFormat::ETC2_RGBA8:
+        return isVersionSupported( 4, 3 ) || isExtensionSupported( "GL_ARB_ES3_compatibility" );
+    default:
+        return true;
+    }
+}
+
+/*
+GLGraphicsImpl::isProgramBinarySupported
+----------------------------------------
+
+Description:
+    Returns true if linked programs can be saved and reloaded as binaries (OpenGL 4.1 or GL_ARB_get_program_binary),
+    and the driver provides at least one binary format to save them in.
+    initOpenGL() must have been called first, and a context must be active.
+
+Arguments:
+    N/A
+
+Returns:
+    bool:  true if program binaries are supported, false otherwise.
+*/
+bool GLGraphicsImpl::isProgramBinarySupported() {
+    if( !isVersionSupported( 4, 1 ) && !isExtensionSupported( "GL_ARB_get_program_binary" ) )
+        return false;
+
+    GLint formats = 0;
+    glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &formats );
+    return formats > 0;
+}
+
+/*
+GLGraphicsImpl::isParallelShaderCompileSupported
+------------------------------------------------
+
+Description:
+    Returns true if the driver compiles shaders and links programs on its own threads (GL_KHR_parallel_shader_compile),
+    so GLShader::isCompileComplete() and GLProgram::isLinkComplete() can check on them without waiting.
+    initOpenGL() must have been called first.
+
+Arguments:
+    N/A
+
+Returns:
+    bool:  true if parallel shader compilation is supported, false otherwise.
+*/
+bool GLGraphicsImpl::isParallelShaderCompileSupported() {
+    return m_parallelShaderCompile;
+}
+
+/*
+GLGraphicsImpl::isMultiDrawIndirectSupported
+--------------------------------------------
+
+Description:
+    Returns true if a batch of indirect draws can be submitted with a single call (OpenGL 4.3 or GL_ARB_multi_draw_indirect).
+    Otherwise multiDrawIndirect() submits each command in the batch separately, which still avoids
+    setting up each draw on the CPU, but not the cost of the calls themselves.
+    initOpenGL() must have been called first.
+
+Arguments:
+    N/A
+
+Returns:
+    bool:  true if multi-draw indirect is supported, false otherwise.
+*/
+bool GLGraphicsImpl::isMultiDrawIndirectSupported() {
+    return isVersionSupported( 4, 3 ) || isExtensionSupported( "GL_ARB_multi_draw_indirect" );
+}
+
+//Returns the name of the GPU (GL_RENDERER)
+const std::string& GLGraphicsImpl::getDeviceName() {
+    return m_deviceName;
+}
+
+//Returns the OpenGL version string, which includes the driver's version (GL_VERSION)
+const std::string& GLGraphicsImpl::getDriverVersion() {
+    return m_driverVersion;
+}
+
 
 
 
@@ -13,12 +13,21 @@ Description:
 
 
 //Includes
-#include <brimstone/graphics/Enums.hpp>  //Brimstone::AlphaFunc, Brimstone::ShaderType
-#include <brimstone/Bounds.hpp>          //Brimstone::Bounds2i
+#include <brimstone/graphics/Enums.hpp>          //Brimstone::AlphaFunc, Brimstone::ShaderType
+#include <brimstone/Bounds.hpp>                  //Brimstone::Bounds2i
+#include <brimstone/types.hpp>                   //Brimstone::uint
+#include <brimstone/graphics/CommandBuffer.hpp>  //Brimstone::CommandBuffer, Brimstone::CommandPacket
+#include <brimstone/Graphics.hpp>                //Brimstone::GraphicsStats
+#include <brimstone/graphics/SlotPool.hpp>       //Brimstone::Private::Handle
 
-#include "GLContext.hpp"                 //Brimstone::Private::GLContext
+#include "GLContext.hpp"                         //Brimstone::Private::GLContext
 
-#include <atomic>                        //std::atomic
+#include <gll/gl_types.hpp>                      //gll::GLuint
+
+#include <atomic>                                //std::atomic
+#include <cstddef>                               //std::size_t
+#include <string>                                //std::string
+#include <vector>                                //std::vector
 
 
 
@@ -50,27 +59,52 @@ namespace Brimstone::Private {
 class GLShader;
 class GLProgram;
 class GLVertexBuffer;
+class GLIndexBuffer;
+class GLStreamingBuffer;
+class GLDrawIndirectBuffer;
 class GLTexture;
 class GLSampler;
+class GLFramebuffer;
 
 
 
 
 class GLGraphicsImpl {
 public:
+    void            init();
     void            init( const Brimstone::Window& window );
     void            destroy();
 
     void            begin();
     void            end();
 
-    GLShader*       createShader( const ShaderType type );
-    GLProgram*      createProgram();
-    GLVertexBuffer* createVertexBuffer();
-    GLTexture*      createTexture();
-    GLSampler*      createSampler();
+    Handle< GLShader >             createShader( const ShaderType type );
+    Handle< GLProgram >            createProgram();
+    Handle< GLVertexBuffer >       createVertexBuffer();
+    Handle< GLIndexBuffer >        createIndexBuffer();
+    Handle< GLStreamingBuffer >    createStreamingBuffer( const std::size_t regionSize, const std::size_t regionCount );
+    Handle< GLDrawIndirectBuffer > createDrawIndirectBuffer( const std::size_t capacity, const std::size_t regionCount );
+    Handle< GLTexture >            createTexture();
+    Handle< GLSampler >            createSampler();
+    Handle< GLFramebuffer >        createFramebuffer();
 
     void            flush();
+    void            finish();
+
+    void            blit( GLFramebuffer& source, const int x, const int y, const int width, const int height,
+                          const int targetX, const int targetY, const int targetWidth, const int targetHeight, const FilterType filter );
+
+    void            execute( const CommandBuffer* const* buffers, const std::size_t count );
+
+    void            drawIndexed( GLVertexBuffer& vertices, GLIndexBuffer& indices );
+    void            drawIndexed( GLVertexBuffer& vertices, GLIndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex );
+    void            draw( GLStreamingBuffer& vertices, const std::size_t first, const std::size_t count );
+    void            drawIndexed( GLStreamingBuffer& vertices, GLIndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex );
+    void            drawInstanced( GLVertexBuffer& vertices, const std::size_t instanceCount );
+    void            drawIndexedInstanced( GLVertexBuffer& vertices, GLIndexBuffer& indices, const std::size_t instanceCount );
+    void            drawIndexedInstanced( GLVertexBuffer& vertices, GLIndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex,
+                                          const std::size_t instanceCount, const uint baseInstance );
+    void            multiDrawIndirect( GLVertexBuffer& vertices, GLIndexBuffer& indices, GLDrawIndirectBuffer& commands );
 
     void            enableBackFaceCulling();
     void            disableBackFaceCulling();
@@ -104,6 +138,7 @@ public:
     void            setBlend( const bool enabled );
     bool            getBlend() const;
     void            setBlendModeToTransparency();
+    void            setBlendMode( const BlendMode mode );
 
     void            setClearColor( const float r, const float g, const float b, const float a );
     void            getClearColor( float (&rgbaOut)[4] ) const;
@@ -119,6 +154,11 @@ public:
     bool            getVSync() const;
 
     void            swapBuffers();
+
+    const GraphicsStats& getStats() const;
+private:
+    void            drawElements( const gll::GLuint vao, GLIndexBuffer& indices, const std::size_t first, const std::size_t count, const int baseVertex );
+    void            countDraw( const std::size_t vertexCount, const std::size_t instanceCount );
 private:
     //Context used by this object
     GLContext   m_context;
@@ -126,6 +166,12 @@ private:
     //Current viewport info
     Bounds2i    m_viewport;
 
+    //Packets of the command buffers being executed, in the order they're executed in
+    std::vector< CommandPacket > m_packets;
+
+    //Work submitted since the context was created
+    GraphicsStats m_stats;
+
     //Current projection-view-world matrix
     //Matrix4x4f  m_pvw;
 
@@ -133,8 +179,24 @@ private:
     //Bounds2i    m_scissor;
 public:
     static void initOpenGL( GLContext& context );
+    static bool isVersionSupported( const int major, const int minor );
+    static bool isExtensionSupported( const char* const name );
+    static bool isTextureFormatSupported( const TextureFormat format );
+    static bool isProgramBinarySupported();
+    static bool isParallelShaderCompileSupported();
+    static bool isMultiDrawIndirectSupported();
+    static const std::string& getDeviceName();
+    static const std::string& getDriverVersion();
 private:
-    static std::atomic<bool>    m_initialized;
+    static std::atomic<bool>        m_initialized;
+
+    //Version of OpenGL and extensions supported by the context used to initialize OpenGL
+    static int                      m_versionMajor;
+    static int                      m_versionMinor;
+    static std::vector<std::string> m_extensions;
+    static std::string              m_deviceName;
+    static std::string              m_driverVersion;
+    static bool                     m_parallelShaderCompile;
 };
 
 
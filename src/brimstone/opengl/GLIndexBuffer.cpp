@@ -0,0 +1,166 @@
+/*
+opengl/GLIndexBuffer.cpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See GLIndexBuffer.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include "GLIndexBuffer.hpp"        //Header
+
+#include <brimstone/Exception.hpp>  //Brimstone::GraphicsException
+
+#include <gll/gl_4_6_comp.hpp>      //gll::* (GL 4.6 and below + compatibility)
+using namespace gll;
+
+
+
+
+namespace {
+
+
+
+
+//Constants
+constexpr GLenum IndexTypeToGLType[] {
+    GL_UNSIGNED_SHORT,  //UNSIGNED_SHORT
+    GL_UNSIGNED_INT     //UNSIGNED_INT
+};
+
+constexpr std::size_t IndexTypeToSize[] {
+    2,  //UNSIGNED_SHORT
+    4   //UNSIGNED_INT
+};
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+GLIndexBuffer::GLIndexBuffer() :
+    m_name( 0 ),
+    m_count( 0 ),
+    m_type( IndexType::UNSIGNED_SHORT ) {
+    create();
+}
+
+GLIndexBuffer::~GLIndexBuffer() {
+    destroy();
+}
+
+void GLIndexBuffer::create() {
+    glGenBuffers( 1, &m_name );
+}
+
+void GLIndexBuffer::destroy() {
+    if( m_name != 0 ) {
+        glDeleteBuffers( 1, &m_name );
+        m_name = 0;
+    }
+}
+
+void GLIndexBuffer::set( const uint16* const indices, const std::size_t count ) {
+    set( indices, count, IndexType::UNSIGNED_SHORT );
+}
+
+void GLIndexBuffer::set( const uint32* const indices, const std::size_t count ) {
+    set( indices, count, IndexType::UNSIGNED_INT );
+}
+
+/*
+GLIndexBuffer::set{3}
+---------------------
+
+Description:
+    Replaces the contents of the index buffer.
+
+Arguments:
+    indices:  Pointer to count indices of the given type.
+    count:    Number of indices.
+    type:     Type of the indices.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the buffer couldn't be filled.
+*/
+void GLIndexBuffer::set( const void* const indices, const std::size_t count, const IndexType type ) {
+    //Binding GL_ELEMENT_ARRAY_BUFFER changes the state of the currently bound VAO (if any),
+    //so we fill the buffer through GL_COPY_WRITE_BUFFER instead.
+    glBindBuffer( GL_COPY_WRITE_BUFFER, m_name );
+    glBufferData( GL_COPY_WRITE_BUFFER, count * IndexTypeToSize[ (int)type ], indices, GL_STATIC_DRAW );
+    glBindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "glBufferData() failed." );
+
+    m_count = count;
+    m_type  = type;
+}
+
+/*
+GLIndexBuffer::set{4}
+---------------------
+
+Description:
+    Replaces a range of indices in the index buffer.
+    The indices must be of the same type as the buffer's existing indices.
+
+Arguments:
+    indices:  Pointer to count indices of the buffer's type.
+    offset:   Index of the first index to replace.
+    count:    Number of indices to replace.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the range is outside of the buffer.
+*/
+void GLIndexBuffer::set( const void* const indices, const std::size_t offset, const std::size_t count ) {
+    if( offset + count > m_count )
+        throw GraphicsException( "Index range is outside of the index buffer." );
+
+    const std::size_t size = IndexTypeToSize[ (int)m_type ];
+    glBindBuffer( GL_COPY_WRITE_BUFFER, m_name );
+    glBufferSubData( GL_COPY_WRITE_BUFFER, offset * size, count * size, indices );
+    glBindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+}
+
+IndexType GLIndexBuffer::getType() const {
+    return m_type;
+}
+
+std::size_t GLIndexBuffer::getCount() const {
+    return m_count;
+}
+
+GLuint GLIndexBuffer::getName() const {
+    return m_name;
+}
+
+GLenum GLIndexBuffer::getGLType() const {
+    return IndexTypeToGLType[ (int)m_type ];
+}
+
+std::size_t GLIndexBuffer::getIndexSize() const {
+    return IndexTypeToSize[ (int)m_type ];
+}
+
+
+
+
+} //namespace Brimstone::Private
@@ -0,0 +1,70 @@
+/*
+opengl/GLIndexBuffer.hpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    GLIndexBuffer is defined here.
+    These objects wrap OpenGL element array buffers.
+
+    An index buffer stores 16-bit or 32-bit indices into a vertex buffer,
+    letting vertices shared by several triangles be stored and processed once.
+*/
+#ifndef BS_OPENGL_GLINDEXBUFFER_HPP
+#define BS_OPENGL_GLINDEXBUFFER_HPP
+
+
+
+
+//Includes
+#include <cstddef>                       //std::size_t
+
+#include <brimstone/types.hpp>           //Brimstone::uint16, Brimstone::uint32
+#include <brimstone/graphics/Enums.hpp>  //Brimstone::IndexType
+
+#include <gll/gl_types.hpp>              //gll::GLuint, gll::GLenum
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+class GLIndexBuffer {
+public:
+    GLIndexBuffer();
+    GLIndexBuffer( GLIndexBuffer& toCopy ) = delete;
+    GLIndexBuffer& operator =( GLIndexBuffer& toCopy ) = delete;
+    ~GLIndexBuffer();
+
+    void        create();
+    void        destroy();
+
+    void        set( const uint16* const indices, const std::size_t count );
+    void        set( const uint32* const indices, const std::size_t count );
+    void        set( const void* const indices, const std::size_t count, const IndexType type );
+    void        set( const void* const indices, const std::size_t offset, const std::size_t count );
+
+    IndexType   getType() const;
+    std::size_t getCount() const;
+
+    gll::GLuint getName() const;
+    gll::GLenum getGLType() const;
+    std::size_t getIndexSize() const;
+private:
+    gll::GLuint m_name;
+    std::size_t m_count;
+    IndexType   m_type;
+};
+
+
+
+
+} //namespace Brimstone::Private
+
+
+
+
+#endif //BS_OPENGL_GLINDEXBUFFER_HPP
@@ -13,6 +13,7 @@ Description:
 //Includes
 #include "GLProgram.hpp"            //Header
 #include "GLShader.hpp"             //Brimstone::Private::GLShader
+#include "GLGraphicsImpl.hpp"       //Brimstone::Private::GLGraphicsImpl
 
 #include <brimstone/Exception.hpp>  //Brimstone::GraphicsException
 
@@ -29,6 +30,13 @@ namespace Brimstone::Private {
 
 
 
+//Constants
+//Queries whether a compile or link running on a driver thread has finished (KHR_parallel_shader_compile)
+constexpr GLenum COMPLETION_STATUS = 0x91B1;
+
+
+
+
 GLProgram::GLProgram() :
     m_name( 0 ) {
     create();
@@ -56,9 +64,92 @@ void GLProgram::detachShader( const GLShader& shader ) {
     glDetachShader( m_name, shader.m_name );
 }
 
+/*
+GLProgram::bindAttribute
+------------------------
+
+Description:
+    Binds the vertex shader input with the given name to the given attribute index,
+    so it is fed by the vertex attribute with that index in a VertexLayout.
+    Takes effect the next time the program is linked.
+
+Arguments:
+    name:   The name of the vertex shader input.
+    index:  The attribute index to bind it to.
+
+Returns:
+    N/A
+*/
+void GLProgram::bindAttribute( const GLchar* const name, const GLuint index ) {
+    glBindAttribLocation( m_name, index, name );
+}
+
 void GLProgram::link() {
+    beginLink();
+    endLink();
+}
+
+/*
+GLProgram::beginLink
+--------------------
+
+Description:
+    Starts linking the program without waiting for the result.
+    The attached shaders don't need to have finished compiling; if the driver supports GL_KHR_parallel_shader_compile,
+    the link is queued behind their compiles on the driver's threads.
+    isLinkComplete() can be used to check if it's done, and endLink() must be called afterwards to check for errors.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void GLProgram::beginLink() {
     glLinkProgram( m_name );
+}
+
+/*
+GLProgram::isLinkComplete
+-------------------------
+
+Description:
+    Returns true if a link started with beginLink() has finished, without waiting for it.
+    If the driver doesn't support GL_KHR_parallel_shader_compile, this always returns true.
+
+Arguments:
+    N/A
+
+Returns:
+    bool:  true if endLink() can be called without waiting for the link to finish.
+*/
+bool GLProgram::isLinkComplete() const {
+    if( !GLGraphicsImpl::isParallelShaderCompileSupported() )
+        return true;
+
+    GLint complete = GL_FALSE;
+    glGetProgramiv( m_name, COMPLETION_STATUS, &complete );
+    return complete == GL_TRUE;
+}
+
+/*
+GLProgram::endLink
+------------------
+
+Description:
+    Waits for a link started with beginLink() to finish, then checks if it succeeded.
+    The program's info log is only retrieved if it didn't.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
 
+Throws:
+    GraphicsException:  If the program failed to link. The exception's description is the program's info log.
+*/
+void GLProgram::endLink() {
     //Check if the shader program linked successfully or not
     GLint status = GL_FALSE;
     glGetProgramiv( m_name, GL_LINK_STATUS, &status );
@@ -77,6 +168,83 @@ void GLProgram::link() {
     throw GraphicsException( log.get() );
 }
 
+/*
+GLProgram::setBinaryRetrievable
+-------------------------------
+
+Description:
+    Hints to the driver that getBinary() will be called after the program is linked,
+    so it should keep the program's binary around. Takes effect the next time the program is linked.
+
+Arguments:
+    retrievable:  true if the binary will be retrieved.
+
+Returns:
+    N/A
+*/
+void GLProgram::setBinaryRetrievable( const bool retrievable ) {
+    glProgramParameteri( m_name, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, retrievable ? GL_TRUE : GL_FALSE );
+}
+
+/*
+GLProgram::getBinary
+--------------------
+
+Description:
+    Retrieves the driver-specific binary of the linked program, which can be given to setBinary() later to skip compiling and linking.
+    The binary is only valid for the same GPU and driver version it was retrieved with.
+
+Arguments:
+    dataOut:    Receives the binary.
+    formatOut:  Receives the driver-specific format of the binary.
+
+Returns:
+    bool:       true if the binary was retrieved, false otherwise (e.g. if the program isn't linked or the driver doesn't provide binaries).
+*/
+bool GLProgram::getBinary( std::vector< ubyte >& dataOut, uint32& formatOut ) const {
+    GLint length = 0;
+    glGetProgramiv( m_name, GL_PROGRAM_BINARY_LENGTH, &length );
+    if( length <= 0 )
+        return false;
+
+    dataOut.resize( length );
+    GLenum format = 0;
+    glGetProgramBinary( m_name, length, &length, &format, dataOut.data() );
+    dataOut.resize( length );
+    formatOut = format;
+
+    return glGetError() == GL_NO_ERROR && length > 0;
+}
+
+/*
+GLProgram::setBinary
+--------------------
+
+Description:
+    Replaces the program with a binary retrieved by getBinary(), linking it without compiling any shaders.
+    The driver is free to reject binaries (e.g. after a driver update), in which case the program is left unlinked
+    and should be built from source instead.
+
+Arguments:
+    format:  The format of the binary, as returned by getBinary().
+    data:    The binary.
+    size:    The size of the binary, in bytes.
+
+Returns:
+    bool:    true if the binary was accepted, false otherwise.
+*/
+bool GLProgram::setBinary( const uint32 format, const void* const data, const std::size_t size ) {
+    glProgramBinary( m_name, format, data, (GLsizei)size );
+
+    GLint status = GL_FALSE;
+    glGetProgramiv( m_name, GL_LINK_STATUS, &status );
+
+    //Rejected binaries with unknown formats raise GL_INVALID_ENUM; don't let it linger
+    const bool accepted = glGetError() == GL_NO_ERROR && status == GL_TRUE;
+    while( glGetError() != GL_NO_ERROR ) {}
+    return accepted;
+}
+
 void GLProgram::use() {
     glUseProgram( m_name );
 }
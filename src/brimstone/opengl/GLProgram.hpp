@@ -14,7 +14,10 @@ Description:
 
 
 //Includes
-#include <gll/gl_types.hpp>  //gll:GLchar
+#include <cstddef>              //std::size_t
+#include <vector>               //std::vector
+#include <brimstone/types.hpp>  //Brimstone::ubyte, Brimstone::uint32
+#include <gll/gl_types.hpp>     //gll:GLchar
 
 
 
@@ -42,8 +45,15 @@ public:
 
     void attachShader( const GLShader& shader );
     void detachShader( const GLShader& shader );
+    void bindAttribute( const char* const name, const unsigned int index );
 
     void link();
+    void beginLink();
+    bool isLinkComplete() const;
+    void endLink();
+    void setBinaryRetrievable( const bool retrievable );
+    bool getBinary( std::vector< ubyte >& dataOut, uint32& formatOut ) const;
+    bool setBinary( const uint32 format, const void* const data, const std::size_t size );
     void use();
     void stopUsing();
 
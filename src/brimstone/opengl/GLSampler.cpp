@@ -12,8 +12,11 @@ Description:
 
 //Includes
 #include "GLSampler.hpp"                //Header
+#include "GLGraphicsImpl.hpp"           //Brimstone::Private::GLGraphicsImpl::isVersionSupported, Brimstone::Private::GLGraphicsImpl::isExtensionSupported
 
-#include <brimstone/graphics/Enums.hpp> //Brimstone::FilterType
+#include <brimstone/graphics/Enums.hpp> //Brimstone::FilterType, Brimstone::MipFilterType
+
+#include <algorithm>                    //std::min, std::max
 
 #include <gll/gl_4_6_comp.hpp>          //gll::* (GL 4.6 and below + compatibility)
 using namespace gll;
@@ -31,6 +34,12 @@ constexpr int FilterTypeToGLFilterType[] {
     GL_LINEAR,      //LINEAR
 };
 
+//Indexed by [FilterType][MipFilterType]
+constexpr int FilterTypesToGLMinFilterType[][3] {
+    { GL_NEAREST, GL_NEAREST_MIPMAP_NEAREST, GL_NEAREST_MIPMAP_LINEAR },  //NEAREST
+    { GL_LINEAR,  GL_LINEAR_MIPMAP_NEAREST,  GL_LINEAR_MIPMAP_LINEAR  }   //LINEAR
+};
+
 constexpr int WrapTypeToGLWrapType[] {
     GL_REPEAT,                  //REPEAT,
     GL_MIRRORED_REPEAT,         //MIRRORED_REPEAT,
@@ -52,7 +61,9 @@ namespace Brimstone::Private {
 
 
 GLSampler::GLSampler() :
-    m_name( 0 ) {
+    m_name( 0 ),
+    m_minFilter( FilterType::NEAREST ),
+    m_mipFilter( MipFilterType::NONE ) {
     create();
 }
 
@@ -94,7 +105,8 @@ void GLSampler::unbind() {
 }
 
 void GLSampler::setMinFilter( const FilterType type ) {
-    glSamplerParameteri( m_name, GL_TEXTURE_MIN_FILTER, FilterTypeToGLFilterType[ (int)type ] );
+    m_minFilter = type;
+    updateMinFilter();
 }
 
 void GLSampler::setMagFilter( const FilterType type ) {
@@ -109,6 +121,53 @@ void GLSampler::setVWrap( const WrapType type ) {
     glSamplerParameteri( m_name, GL_TEXTURE_WRAP_T, WrapTypeToGLWrapType[ (int)type ] );
 }
 
+/*
+GLSampler::setMipFilter
+-----------------------
+
+Description:
+    Sets how mipmap levels are chosen when a texture is minified.
+    This only has an effect on textures that have more than one level.
+
+Arguments:
+    type:  The type of mip filter to use.
+
+Returns:
+    N/A
+*/
+void GLSampler::setMipFilter( const MipFilterType type ) {
+    m_mipFilter = type;
+    updateMinFilter();
+}
+
+/*
+GLSampler::setMaxAnisotropy
+---------------------------
+
+Description:
+    Sets the maximum degree of anisotropic filtering, which keeps textures viewed at steep angles sharp.
+    1 disables anisotropic filtering. Values above the largest degree the implementation supports are clamped.
+    If anisotropic filtering isn't supported (OpenGL 4.6 or GL_EXT_texture_filter_anisotropic), this does nothing.
+
+Arguments:
+    anisotropy:  The maximum degree of anisotropy, e.g. 16.
+
+Returns:
+    N/A
+*/
+void GLSampler::setMaxAnisotropy( const float anisotropy ) {
+    if( !GLGraphicsImpl::isVersionSupported( 4, 6 ) && !GLGraphicsImpl::isExtensionSupported( "GL_EXT_texture_filter_anisotropic" ) )
+        return;
+
+    GLfloat limit = 1.0f;
+    glGetFloatv( GL_MAX_TEXTURE_MAX_ANISOTROPY, &limit );
+    glSamplerParameterf( m_name, GL_TEXTURE_MAX_ANISOTROPY, std::min( std::max( anisotropy, 1.0f ), limit ) );
+}
+
+void GLSampler::updateMinFilter() {
+    glSamplerParameteri( m_name, GL_TEXTURE_MIN_FILTER, FilterTypesToGLMinFilterType[ (int)m_minFilter ][ (int)m_mipFilter ] );
+}
+
 
 
 
@@ -26,6 +26,7 @@ namespace Brimstone {
 
 //Forward declarations
 enum class FilterType;
+enum class MipFilterType;
 enum class WrapType;
 
 
@@ -53,11 +54,19 @@ public:
     void setMagFilter( const FilterType type );
     void setUWrap( const WrapType type );
     void setVWrap( const WrapType type );
+    void setMipFilter( const MipFilterType type );
+    void setMaxAnisotropy( const float anisotropy );
 
     void bind();
     void unbind();
+private:
+    void updateMinFilter();
 private:
     gll::GLuint m_name;
+
+    //OpenGL combines the min filter and the mip filter into a single setting
+    FilterType    m_minFilter;
+    MipFilterType m_mipFilter;
 };
 
 
@@ -12,6 +12,7 @@ Description:
 
 //Includes
 #include "GLShader.hpp"                  //Header
+#include "GLGraphicsImpl.hpp"            //Brimstone::Private::GLGraphicsImpl
 
 #include <brimstone/types.hpp>           //Brimstone::ustring
 #include <brimstone/graphics/Enums.hpp>  //Brimstone::ShaderType
@@ -31,6 +32,9 @@ namespace Brimstone::Private {
 
 
 //Constants
+//Queries whether a compile or link running on a driver thread has finished (KHR_parallel_shader_compile)
+constexpr GLenum COMPLETION_STATUS = 0x91B1;
+
 constexpr int ShaderTypeToGLShaderType[] {
     GL_VERTEX_SHADER,       //VERTEX
     GL_GEOMETRY_SHADER,     //GEOMETRY
@@ -65,9 +69,70 @@ void GLShader::setSource( const ustring& source ) {
 }
 
 void GLShader::compile() {
-    //Compile shader
+    beginCompile();
+    endCompile();
+}
+
+/*
+GLShader::beginCompile
+----------------------
+
+Description:
+    Starts compiling the shader without waiting for the result.
+    If the driver supports GL_KHR_parallel_shader_compile, the shader is compiled on one of the driver's threads;
+    isCompileComplete() can be used to check if it's done, and endCompile() must be called afterwards to check for errors.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void GLShader::beginCompile() {
     glCompileShader( m_name );
+}
+
+/*
+GLShader::isCompileComplete
+---------------------------
+
+Description:
+    Returns true if a compile started with beginCompile() has finished, without waiting for it.
+    If the driver doesn't support GL_KHR_parallel_shader_compile, this always returns true.
+
+Arguments:
+    N/A
+
+Returns:
+    bool:  true if endCompile() can be called without waiting for the compile to finish.
+*/
+bool GLShader::isCompileComplete() const {
+    if( !GLGraphicsImpl::isParallelShaderCompileSupported() )
+        return true;
 
+    GLint complete = GL_FALSE;
+    glGetShaderiv( m_name, COMPLETION_STATUS, &complete );
+    return complete == GL_TRUE;
+}
+
+/*
+GLShader::endCompile
+--------------------
+
+Description:
+    Waits for a compile started with beginCompile() to finish, then checks if it succeeded.
+    The shader's info log is only retrieved if it didn't.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the shader failed to compile. The exception's description is the shader's info log.
+*/
+void GLShader::endCompile() {
     //Check if the shader compiled successfully or not
     GLint status = GL_FALSE;
     glGetShaderiv( m_name, GL_COMPILE_STATUS, &status );
@@ -53,6 +53,9 @@ public:
     void destroy();
     void setSource( const ustring& source );
     void compile();
+    void beginCompile();
+    bool isCompileComplete() const;
+    void endCompile();
 private:
     ShaderType  m_type;
     gll::GLuint m_name;
@@ -0,0 +1,356 @@
+/*
+opengl/GLStreamingBuffer.cpp
+----------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See GLStreamingBuffer.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include "GLStreamingBuffer.hpp"    //Header
+#include "GLVertexLayout.hpp"       //Brimstone::Private::enableGLVertexLayout, Brimstone::Private::disableGLVertexLayout
+#include "GLGraphicsImpl.hpp"       //Brimstone::Private::GLGraphicsImpl::isVersionSupported, Brimstone::Private::GLGraphicsImpl::isExtensionSupported
+
+#include <brimstone/Exception.hpp>  //Brimstone::GraphicsException
+
+#include <gll/gl_4_6_comp.hpp>      //gll::* (GL 4.6 and below + compatibility)
+using namespace gll;
+
+
+
+
+namespace {
+
+
+
+
+//Constants
+//How long to wait for a fence each time we're forced to wait on one, in nanoseconds
+constexpr GLuint64 FENCE_TIMEOUT = 1000000000;
+
+constexpr GLbitfield PERSISTENT_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+/*
+GLStreamingBuffer::GLStreamingBuffer
+------------------------------------
+
+Description:
+    Creates a streaming buffer with regionCount regions of regionSize bytes each.
+    regionCount should be the number of frames the GPU is allowed to lag behind the CPU, plus one;
+    three regions is usually enough.
+
+Arguments:
+    regionSize:         The number of bytes that can be allocated each frame.
+    regionCount:        The number of regions (between 1 and MAX_REGIONS).
+
+Throws:
+    GraphicsException:  If regionSize is 0, regionCount is out of range, or the buffer couldn't be created.
+*/
+GLStreamingBuffer::GLStreamingBuffer( const std::size_t regionSize, const std::size_t regionCount ) :
+    m_name( 0 ),
+    m_vao( 0 ),
+    m_data( nullptr ),
+    m_persistent( false ),
+    m_regionSize( regionSize ),
+    m_regionCount( regionCount ),
+    m_region( 0 ),
+    m_fences {},
+    m_head( 0 ),
+    m_flushed( 0 ),
+    m_stalls( 0 ) {
+    if( regionSize == 0 || regionCount == 0 || regionCount > MAX_REGIONS )
+        throw GraphicsException( "Invalid streaming buffer size." );
+
+    create();
+}
+
+GLStreamingBuffer::~GLStreamingBuffer() {
+    destroy();
+}
+
+void GLStreamingBuffer::create() {
+    const GLsizeiptr size = (GLsizeiptr)( m_regionSize * m_regionCount );
+
+    glGenVertexArrays( 1, &m_vao );
+    glGenBuffers( 1, &m_name );
+    glBindBuffer( GL_COPY_WRITE_BUFFER, m_name );
+
+    m_persistent = GLGraphicsImpl::isVersionSupported( 4, 4 ) || GLGraphicsImpl::isExtensionSupported( "GL_ARB_buffer_storage" );
+    if( m_persistent ) {
+        //Immutable storage that stays mapped for its entire lifetime.
+        //Coherent mapping means writes become visible to the GPU without explicitly flushing them.
+        glBufferStorage( GL_COPY_WRITE_BUFFER, size, nullptr, PERSISTENT_FLAGS );
+        m_data = static_cast< ubyte* >( glMapBufferRange( GL_COPY_WRITE_BUFFER, 0, size, PERSISTENT_FLAGS ) );
+    } else {
+        glBufferData( GL_COPY_WRITE_BUFFER, size, nullptr, GL_STREAM_DRAW );
+        m_shadow.reset( new ubyte[ size ] );
+        m_data = m_shadow.get();
+    }
+
+    glBindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+
+    //This is called from the constructor, so the destructor won't release what was created if this throws
+    const bool glFailed = glGetError() != GL_NO_ERROR;
+    if( m_data == nullptr || glFailed ) {
+        destroy();
+        throw GraphicsException( "Failed to create streaming buffer." );
+    }
+}
+
+void GLStreamingBuffer::destroy() {
+    for( GLsync& fence : m_fences ) {
+        if( fence != nullptr ) {
+            glDeleteSync( fence );
+            fence = nullptr;
+        }
+    }
+
+    if( m_name != 0 ) {
+        if( m_persistent && m_data != nullptr ) {
+            glBindBuffer( GL_COPY_WRITE_BUFFER, m_name );
+            glUnmapBuffer( GL_COPY_WRITE_BUFFER );
+            glBindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+        }
+        glDeleteBuffers( 1, &m_name );
+        m_name = 0;
+    }
+    m_data = nullptr;
+    m_shadow.reset();
+
+    if( m_vao != 0 ) {
+        glDeleteVertexArrays( 1, &m_vao );
+        m_vao = 0;
+    }
+}
+
+/*
+GLStreamingBuffer::setLayout
+----------------------------
+
+Description:
+    Sets the layout of vertices allocated with allocateVertices() and records it into the buffer's VAO.
+
+Arguments:
+    layout:             The layout of the vertices in this buffer.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If OpenGL rejected one of the attributes.
+*/
+void GLStreamingBuffer::setLayout( const VertexLayout& layout ) {
+    glBindVertexArray( m_vao );
+    disableGLVertexLayout( m_layout );
+    enableGLVertexLayout( m_name, layout, 0 );
+    glBindVertexArray( 0 );
+
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "Failed to set vertex layout." );
+
+    m_layout = layout;
+}
+
+const VertexLayout& GLStreamingBuffer::getLayout() const {
+    return m_layout;
+}
+
+/*
+GLStreamingBuffer::beginFrame
+-----------------------------
+
+Description:
+    Prepares the current region for writing.
+    If the GPU hasn't finished drawing the last frame that used this region, waits for it to finish.
+    This should only happen if the GPU falls more than getRegionCount() frames behind;
+    getStallCount() reports how many times it has happened.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If waiting on the region's fence failed.
+*/
+void GLStreamingBuffer::beginFrame() {
+    GLsync& fence = m_fences[ m_region ];
+    if( fence != nullptr ) {
+        GLenum result = glClientWaitSync( fence, 0, 0 );
+        if( result == GL_TIMEOUT_EXPIRED ) {
+            ++m_stalls;
+            do {
+                result = glClientWaitSync( fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT );
+            } while( result == GL_TIMEOUT_EXPIRED );
+        }
+
+        glDeleteSync( fence );
+        fence = nullptr;
+
+        if( result == GL_WAIT_FAILED )
+            throw GraphicsException( "glClientWaitSync() failed." );
+    }
+
+    m_head    = 0;
+    m_flushed = 0;
+}
+
+/*
+GLStreamingBuffer::endFrame
+---------------------------
+
+Description:
+    Marks the end of the commands that use the current region and moves on to the next region.
+    Everything allocated this frame must have been drawn before this is called.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void GLStreamingBuffer::endFrame() {
+    flush();
+
+    m_fences[ m_region ] = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+    m_region = ( m_region + 1 ) % m_regionCount;
+    m_head    = 0;
+    m_flushed = 0;
+}
+
+/*
+GLStreamingBuffer::allocate
+---------------------------
+
+Description:
+    Allocates size bytes from the current region.
+    The returned pointer can be written to until the frame ends; it should not be read from.
+
+Arguments:
+    size:               The number of bytes to allocate.
+    alignment:          The offset of the allocation from the start of the buffer will be a multiple of this.
+    offsetOut:          Receives the offset of the allocation from the start of the buffer.
+
+Returns:
+    void*:              A pointer to the allocated memory.
+
+Throws:
+    GraphicsException:  If the current region doesn't have enough space left.
+*/
+void* GLStreamingBuffer::allocate( const std::size_t size, const std::size_t alignment, std::size_t& offsetOut ) {
+    const std::size_t regionStart = m_region * m_regionSize;
+    const std::size_t a           = ( alignment != 0 ) ? alignment : 1;
+    const std::size_t offset      = ( regionStart + m_head + a - 1 ) / a * a;
+
+    if( offset + size > regionStart + m_regionSize )
+        throw GraphicsException( "Streaming buffer region is full." );
+
+    m_head    = offset + size - regionStart;
+    offsetOut = offset;
+    return m_data + offset;
+}
+
+/*
+GLStreamingBuffer::allocateVertices
+-----------------------------------
+
+Description:
+    Allocates space for count vertices of the layout set with setLayout().
+
+Arguments:
+    count:              The number of vertices to allocate.
+    firstOut:           Receives the index of the first allocated vertex. Pass this to draw calls as the first (or base) vertex.
+
+Returns:
+    void*:              A pointer to the allocated vertices.
+
+Throws:
+    GraphicsException:  If no layout has been set or the current region doesn't have enough space left.
+*/
+void* GLStreamingBuffer::allocateVertices( const std::size_t count, std::size_t& firstOut ) {
+    const std::size_t stride = m_layout.getStride();
+    if( stride == 0 )
+        throw GraphicsException( "Streaming buffer has no vertex layout." );
+
+    std::size_t offset;
+    void* data = allocate( count * stride, stride, offset );
+    firstOut = offset / stride;
+    return data;
+}
+
+/*
+GLStreamingBuffer::flush
+------------------------
+
+Description:
+    Makes data written since the last flush visible to the GPU.
+    When the buffer is persistently mapped this does nothing. Otherwise, the data is uploaded with glBufferSubData.
+    Draw calls that use the buffer call this automatically.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void GLStreamingBuffer::flush() {
+    if( m_persistent || m_flushed == m_head )
+        return;
+
+    const std::size_t offset = m_region * m_regionSize + m_flushed;
+    glBindBuffer( GL_COPY_WRITE_BUFFER, m_name );
+    glBufferSubData( GL_COPY_WRITE_BUFFER, offset, m_head - m_flushed, m_data + offset );
+    glBindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+    m_flushed = m_head;
+}
+
+std::size_t GLStreamingBuffer::getRegionSize() const {
+    return m_regionSize;
+}
+
+std::size_t GLStreamingBuffer::getRegionCount() const {
+    return m_regionCount;
+}
+
+std::size_t GLStreamingBuffer::getRemaining() const {
+    return m_regionSize - m_head;
+}
+
+bool GLStreamingBuffer::isPersistent() const {
+    return m_persistent;
+}
+
+std::size_t GLStreamingBuffer::getStallCount() const {
+    return m_stalls;
+}
+
+GLuint GLStreamingBuffer::getName() const {
+    return m_name;
+}
+
+GLuint GLStreamingBuffer::getVertexArray() const {
+    return m_vao;
+}
+
+
+
+
+} //namespace Brimstone::Private
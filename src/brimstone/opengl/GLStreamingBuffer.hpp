@@ -0,0 +1,104 @@
+/*
+opengl/GLStreamingBuffer.hpp
+----------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    GLStreamingBuffer is defined here.
+    These objects wrap an OpenGL buffer intended for data that is rewritten every frame
+    (UI, particles, debug lines, etc).
+
+    The buffer is split into a ring of regions, one per frame in flight.
+    Each frame, allocations are carved out of the current region and written to directly through a pointer;
+    when the frame ends, a fence is placed in the command stream to mark when the GPU is done with the region.
+    The region is only reused once its fence has signaled, so writes never race with the GPU
+    and (as long as the GPU isn't more than regionCount frames behind) never wait on it.
+
+    When glBufferStorage is supported (OpenGL 4.4 or GL_ARB_buffer_storage), the buffer is mapped persistently and coherently
+    and allocations point directly into GPU-visible memory. Otherwise allocations point into a CPU-side copy of the buffer,
+    which is uploaded with glBufferSubData before it is drawn.
+*/
+#ifndef BS_OPENGL_GLSTREAMINGBUFFER_HPP
+#define BS_OPENGL_GLSTREAMINGBUFFER_HPP
+
+
+
+
+//Includes
+#include <cstddef>                              //std::size_t
+#include <memory>                               //std::unique_ptr
+
+#include <brimstone/types.hpp>                  //Brimstone::ubyte
+#include <brimstone/graphics/VertexLayout.hpp>  //Brimstone::VertexLayout
+
+#include <gll/gl_types.hpp>                     //gll::GLuint, gll::GLsync
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+class GLStreamingBuffer {
+public:
+    static constexpr std::size_t MAX_REGIONS = 4;
+public:
+    GLStreamingBuffer( const std::size_t regionSize, const std::size_t regionCount );
+    GLStreamingBuffer( GLStreamingBuffer& toCopy ) = delete;
+    GLStreamingBuffer& operator =( GLStreamingBuffer& toCopy ) = delete;
+    ~GLStreamingBuffer();
+
+    void                create();
+    void                destroy();
+
+    void                setLayout( const VertexLayout& layout );
+    const VertexLayout& getLayout() const;
+
+    void                beginFrame();
+    void                endFrame();
+
+    void*               allocate( const std::size_t size, const std::size_t alignment, std::size_t& offsetOut );
+    void*               allocateVertices( const std::size_t count, std::size_t& firstOut );
+    void                flush();
+
+    std::size_t         getRegionSize() const;
+    std::size_t         getRegionCount() const;
+    std::size_t         getRemaining() const;
+    bool                isPersistent() const;
+    std::size_t         getStallCount() const;
+
+    gll::GLuint         getName() const;
+    gll::GLuint         getVertexArray() const;
+private:
+    gll::GLuint                m_name;
+    gll::GLuint                m_vao;
+    VertexLayout               m_layout;
+
+    //Either the persistently mapped buffer or, if persistent mapping isn't supported, a CPU-side copy of the buffer
+    ubyte*                     m_data;
+    std::unique_ptr< ubyte[] > m_shadow;
+    bool                       m_persistent;
+
+    std::size_t                m_regionSize;
+    std::size_t                m_regionCount;
+    std::size_t                m_region;
+    gll::GLsync                m_fences[ MAX_REGIONS ];
+
+    //Offsets, relative to the start of the current region, of the next allocation and of the first byte that hasn't been uploaded yet
+    std::size_t                m_head;
+    std::size_t                m_flushed;
+
+    std::size_t                m_stalls;
+};
+
+
+
+
+} //namespace Brimstone::Private
+
+
+
+
+#endif //BS_OPENGL_GLSTREAMINGBUFFER_HPP
@@ -11,21 +11,84 @@ Description:
 
 
 //Includes
-#include "GLTexture.hpp"        //Header
+#include "GLTexture.hpp"                       //Header
+#include "GLStreamingBuffer.hpp"               //Brimstone::Private::GLStreamingBuffer
+#include "GLGraphicsImpl.hpp"                  //Brimstone::Private::GLGraphicsImpl::isVersionSupported, Brimstone::Private::GLGraphicsImpl::isExtensionSupported
 
-#include <gll/gl_4_6_comp.hpp>  //gll::* (GL 4.6 and below + compatibility)
+#include <brimstone/graphics/TextureData.hpp>  //Brimstone::TextureData, Brimstone::getTextureDataSize, Brimstone::getMipLevelCount, etc.
+#include <brimstone/Exception.hpp>             //Brimstone::GraphicsException
+
+#include <gll/gl_4_6_comp.hpp>                 //gll::* (GL 4.6 and below + compatibility)
 using namespace gll;
 
 
 
 
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::TextureFormat;
+
+
+
+
+//Constants
+//Block-compressed formats that aren't part of core OpenGL (EXT_texture_compression_s3tc)
+constexpr GLenum COMPRESSED_RGBA_S3TC_DXT1 = 0x83F1;
+constexpr GLenum COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+
+constexpr GLenum TextureFormatToGLInternalFormat[] {
+    GL_R8,                              //R8
+    GL_RG8,                             //RG8
+    GL_RGBA8,                           //RGBA8
+    GL_SRGB8_ALPHA8,                    //SRGB8_ALPHA8
+    COMPRESSED_RGBA_S3TC_DXT1,          //BC1_RGBA
+    COMPRESSED_RGBA_S3TC_DXT5,          //BC3_RGBA
+    GL_COMPRESSED_RED_RGTC1,            //BC4_R
+    GL_COMPRESSED_RG_RGTC2,             //BC5_RG
+    GL_COMPRESSED_RGBA_BPTC_UNORM,      //BC7_RGBA
+    GL_COMPRESSED_RGB8_ETC2,            //ETC2_RGB8
+    GL_COMPRESSED_RGBA8_ETC2_EAC        //ETC2_RGBA8
+};
+
+//Client-side format of uncompressed texels; unused for compressed formats
+constexpr GLenum TextureFormatToGLFormat[] {
+    GL_RED,   //R8
+    GL_RG,    //RG8
+    GL_RGBA,  //RGBA8
+    GL_RGBA,  //SRGB8_ALPHA8
+    GL_NONE,  //BC1_RGBA
+    GL_NONE,  //BC3_RGBA
+    GL_NONE,  //BC4_R
+    GL_NONE,  //BC5_RG
+    GL_NONE,  //BC7_RGBA
+    GL_NONE,  //ETC2_RGB8
+    GL_NONE   //ETC2_RGBA8
+};
+
+
+
+
+} //namespace
+
+
+
+
 namespace Brimstone::Private {
 
 
 
 
 GLTexture::GLTexture() :
-    m_name( 0 ) {
+    m_name( 0 ),
+    m_width( 0 ),
+    m_height( 0 ),
+    m_format( TextureFormat::RGBA8 ),
+    m_levels( 0 ),
+    m_immutable( false ) {
     create();
 }
 
@@ -51,13 +114,247 @@ void GLTexture::destroy() {
 }
 
 void GLTexture::set( const std::size_t width, const std::size_t height, const void* data ) {
+    //Immutable storage can't be respecified, so replace the texture with a new one
+    if( m_immutable )
+        recreate();
+
     m_width  = width;
     m_height = height;
+    m_format = TextureFormat::RGBA8;
+    m_levels = 1;
     glBindTexture( GL_TEXTURE_2D, m_name );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0 );
     glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data );
     glBindTexture( GL_TEXTURE_2D, 0 );
 }
 
+/*
+GLTexture::set{1}
+-----------------
+
+Description:
+    Gives the texture storage matching data's format, size and number of levels, and uploads every level of data into it.
+
+Arguments:
+    data:               The texels to upload.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If data is empty, or if the storage couldn't be allocated.
+*/
+void GLTexture::set( const TextureData& data ) {
+    if( !data.isValid() )
+        throw GraphicsException( "Texture data is empty." );
+
+    setStorage( data.getWidth(), data.getHeight(), data.getFormat(), data.getLevelCount() );
+    for( std::size_t level = 0; level < data.getLevelCount(); ++level )
+        setLevel( level, data.getLevel( level ) );
+}
+
+/*
+GLTexture::setStorage
+---------------------
+
+Description:
+    Replaces the texture's storage with levels levels of the given format, starting with a width x height base level.
+    The contents of the levels are undefined until they're set with setLevel(), setRegion() or generateMipmaps().
+
+    The storage is allocated with glTexStorage2D if it is supported (OpenGL 4.2 or GL_ARB_texture_storage).
+    Otherwise each level is allocated individually with glTexImage2D / glCompressedTexImage2D.
+
+Arguments:
+    width:              Width of the base level.
+    height:             Height of the base level.
+    format:             The format of the texels.
+    levels:             Number of mipmap levels, including the base level, or 0 for a complete mipmap chain (down to 1x1).
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the size or number of levels is invalid, or if the storage couldn't be allocated.
+*/
+void GLTexture::setStorage( const std::size_t width, const std::size_t height, const TextureFormat format, const std::size_t levels ) {
+    const std::size_t maxLevels = getMipLevelCount( (int32)width, (int32)height );
+    if( maxLevels == 0 || levels > maxLevels )
+        throw GraphicsException( "Invalid texture size or level count." );
+
+    //Storage can only be allocated once per texture object
+    recreate();
+
+    m_width     = width;
+    m_height    = height;
+    m_format    = format;
+    m_levels    = ( levels == 0 ) ? maxLevels : levels;
+    m_immutable = GLGraphicsImpl::isVersionSupported( 4, 2 ) || GLGraphicsImpl::isExtensionSupported( "GL_ARB_texture_storage" );
+
+    const GLenum internalFormat = TextureFormatToGLInternalFormat[ (int)format ];
+
+    glBindTexture( GL_TEXTURE_2D, m_name );
+    if( m_immutable ) {
+        glTexStorage2D( GL_TEXTURE_2D, m_levels, internalFormat, m_width, m_height );
+    } else {
+        for( std::size_t level = 0; level < m_levels; ++level ) {
+            const GLsizei w = getMipDimension( m_width,  level );
+            const GLsizei h = getMipDimension( m_height, level );
+            if( isCompressed( format ) )
+                glCompressedTexImage2D( GL_TEXTURE_2D, level, internalFormat, w, h, 0, getTextureDataSize( format, w, h ), nullptr );
+            else
+                glTexImage2D( GL_TEXTURE_2D, level, internalFormat, w, h, 0, TextureFormatToGLFormat[ (int)format ], GL_UNSIGNED_BYTE, nullptr );
+        }
+    }
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_levels - 1 );
+    glBindTexture( GL_TEXTURE_2D, 0 );
+
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "Failed to allocate texture storage." );
+}
+
+/*
+GLTexture::setLevel
+-------------------
+
+Description:
+    Replaces the entire contents of one of the texture's levels.
+
+Arguments:
+    level:              The level to replace.
+    data:               getTextureDataSize( getFormat(), width, height ) bytes of texels,
+                        where width and height are the dimensions of the level.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the level doesn't exist.
+*/
+void GLTexture::setLevel( const std::size_t level, const void* data ) {
+    if( level >= m_levels )
+        throw GraphicsException( "Texture level doesn't exist." );
+
+    const GLsizei w = getMipDimension( m_width,  level );
+    const GLsizei h = getMipDimension( m_height, level );
+
+    glBindTexture( GL_TEXTURE_2D, m_name );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    if( isCompressed( m_format ) )
+        glCompressedTexSubImage2D( GL_TEXTURE_2D, level, 0, 0, w, h, TextureFormatToGLInternalFormat[ (int)m_format ], getTextureDataSize( m_format, w, h ), data );
+    else
+        glTexSubImage2D( GL_TEXTURE_2D, level, 0, 0, w, h, TextureFormatToGLFormat[ (int)m_format ], GL_UNSIGNED_BYTE, data );
+    glBindTexture( GL_TEXTURE_2D, 0 );
+}
+
+/*
+GLTexture::setRegion
+--------------------
+
+Description:
+    Replaces a rectangular region of the texture's pixels, leaving the rest of the texture untouched.
+    The texture must have been given storage with set() or setStorage() beforehand, in an uncompressed format.
+
+Arguments:
+    x:       Left edge of the region, in pixels.
+    y:       Top edge of the region, in pixels.
+    width:   Width of the region, in pixels.
+    height:  Height of the region, in pixels.
+    data:    Tightly packed pixels in the texture's format, width * height of them.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the region is outside of the texture, or the texture is block-compressed.
+*/
+void GLTexture::setRegion( const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height, const void* data ) {
+    if( x + width > (std::size_t)m_width || y + height > (std::size_t)m_height )
+        throw GraphicsException( "Texture region is outside of the texture." );
+    if( isCompressed( m_format ) )
+        throw GraphicsException( "Regions of compressed textures can't be replaced." );
+
+    glBindTexture( GL_TEXTURE_2D, m_name );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    glTexSubImage2D( GL_TEXTURE_2D, 0, x, y, width, height, TextureFormatToGLFormat[ (int)m_format ], GL_UNSIGNED_BYTE, data );
+    glBindTexture( GL_TEXTURE_2D, 0 );
+}
+
+/*
+GLTexture::setRegion{7}
+-----------------------
+
+Description:
+    Replaces a rectangular region of one of the texture's levels with texels copied from a streaming buffer,
+    using the buffer as a pixel unpack buffer (PBO). The copy is performed by the GPU asynchronously,
+    so the CPU doesn't wait for it; the buffer's fences keep its memory from being overwritten until the copy is done.
+
+    For block-compressed formats, x, y, width and height must be multiples of 4,
+    except that the region can end at the level's right / bottom edge.
+
+Arguments:
+    level:              The level to copy to.
+    x:                  Left edge of the region, in texels.
+    y:                  Top edge of the region, in texels.
+    width:              Width of the region, in texels.
+    height:             Height of the region, in texels.
+    source:             The buffer to copy the texels from.
+    offset:             Offset of the texels in the buffer, in bytes (as returned by GLStreamingBuffer::allocate()).
+                        The texels must be tightly packed, getTextureDataSize( getFormat(), width, height ) bytes of them.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the level doesn't exist or the region is outside of it.
+*/
+void GLTexture::setRegion( const std::size_t level, const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height,
+                           GLStreamingBuffer& source, const std::size_t offset ) {
+    if( level >= m_levels )
+        throw GraphicsException( "Texture level doesn't exist." );
+    if( x + width > (std::size_t)getMipDimension( m_width, level ) || y + height > (std::size_t)getMipDimension( m_height, level ) )
+        throw GraphicsException( "Texture region is outside of the texture." );
+
+    source.flush();
+
+    //With a buffer bound to GL_PIXEL_UNPACK_BUFFER, the data "pointer" is an offset into the buffer
+    const void* data = reinterpret_cast< const void* >( offset );
+
+    glBindBuffer( GL_PIXEL_UNPACK_BUFFER, source.getName() );
+    glBindTexture( GL_TEXTURE_2D, m_name );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    if( isCompressed( m_format ) )
+        glCompressedTexSubImage2D( GL_TEXTURE_2D, level, x, y, width, height, TextureFormatToGLInternalFormat[ (int)m_format ], getTextureDataSize( m_format, width, height ), data );
+    else
+        glTexSubImage2D( GL_TEXTURE_2D, level, x, y, width, height, TextureFormatToGLFormat[ (int)m_format ], GL_UNSIGNED_BYTE, data );
+    glBindTexture( GL_TEXTURE_2D, 0 );
+    glBindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+}
+
+/*
+GLTexture::generateMipmaps
+--------------------------
+
+Description:
+    Fills every level after the base level by downsampling the base level on the GPU (glGenerateMipmap).
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the texture is block-compressed.
+*/
+void GLTexture::generateMipmaps() {
+    if( isCompressed( m_format ) )
+        throw GraphicsException( "Mipmaps of compressed textures can't be generated." );
+
+    glBindTexture( GL_TEXTURE_2D, m_name );
+    glGenerateMipmap( GL_TEXTURE_2D );
+    glBindTexture( GL_TEXTURE_2D, 0 );
+}
+
 void GLTexture::bind() {
     glActiveTexture( GL_TEXTURE0 );
     glBindTexture( GL_TEXTURE_2D, m_name );
@@ -75,6 +372,55 @@ std::size_t GLTexture::getHeight() const {
     return m_height;
 }
 
+/*
+GLTexture::setBaseLevel
+-----------------------
+
+Description:
+    Sets the largest level that will be sampled from. Levels above it (larger ones) are ignored,
+    so a texture whose smaller levels have been filled can be drawn before its larger levels are.
+
+Arguments:
+    level:              The new base level.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If the level doesn't exist.
+*/
+void GLTexture::setBaseLevel( const std::size_t level ) {
+    if( level >= m_levels )
+        throw GraphicsException( "Texture level doesn't exist." );
+
+    glBindTexture( GL_TEXTURE_2D, m_name );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level );
+    glBindTexture( GL_TEXTURE_2D, 0 );
+}
+
+TextureFormat GLTexture::getFormat() const {
+    return m_format;
+}
+
+std::size_t GLTexture::getLevelCount() const {
+    return m_levels;
+}
+
+GLuint GLTexture::getName() const {
+    return m_name;
+}
+
+//Returns the sized internal format OpenGL stores texels of the given format in
+GLenum GLTexture::getInternalFormat( const TextureFormat format ) {
+    return TextureFormatToGLInternalFormat[ (int)format ];
+}
+
+void GLTexture::recreate() {
+    destroy();
+    create();
+    m_immutable = false;
+}
+
 
 
 
@@ -6,6 +6,11 @@ Copyright (c) 2024, theJ89
 Description:
     GLTexture is defined here.
     These objects wrap OpenGL textures.
+
+    set() gives the texture a single, mutable RGBA8 level.
+    setStorage() gives the texture levels of any TextureFormat; when glTexStorage2D is supported
+    (OpenGL 4.2 or GL_ARB_texture_storage), the storage is immutable, which lets the driver allocate the whole mipmap chain up front
+    and skip completeness checks when the texture is bound. Levels are then filled with setLevel(), setRegion(), or generateMipmaps().
 */
 #ifndef BS_OPENGL_GLTEXTURE_HPP
 #define BS_OPENGL_GLTEXTURE_HPP
@@ -14,8 +19,25 @@ Description:
 
 
 //Includes
-#include <cstddef>           //std::size_t
-#include <gll/gl_types.hpp>  //gll::GLsizei
+#include <cstddef>                       //std::size_t
+#include <brimstone/graphics/Enums.hpp>  //Brimstone::TextureFormat
+#include <gll/gl_types.hpp>              //gll::GLsizei, gll::GLuint, gll::GLenum
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Forward declarations
+class TextureData;
+
+
+
+
+} //namespace Brimstone
 
 
 
@@ -25,6 +47,12 @@ namespace Brimstone::Private {
 
 
 
+//Forward declarations
+class GLStreamingBuffer;
+
+
+
+
 class GLTexture {
 public:
     GLTexture();
@@ -34,17 +62,36 @@ public:
     void destroy();
 
     void set( const std::size_t width, const std::size_t height, const void* data );
+    void set( const TextureData& data );
+    void setStorage( const std::size_t width, const std::size_t height, const TextureFormat format, const std::size_t levels );
+    void setLevel( const std::size_t level, const void* data );
+    void setRegion( const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height, const void* data );
+    void setRegion( const std::size_t level, const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height,
+                    GLStreamingBuffer& source, const std::size_t offset );
+    void generateMipmaps();
+    void setBaseLevel( const std::size_t level );
 
     void bind();
     void unbind();
 
-    std::size_t getWidth() const;
-    std::size_t getHeight() const;
+    std::size_t   getWidth() const;
+    std::size_t   getHeight() const;
+    TextureFormat getFormat() const;
+    std::size_t   getLevelCount() const;
+    gll::GLuint   getName() const;
+public:
+    static gll::GLenum getInternalFormat( const TextureFormat format );
+private:
+    void recreate();
 private:
     gll::GLuint m_name;
 
     gll::GLsizei m_width;
     gll::GLsizei m_height;
+
+    TextureFormat m_format;
+    std::size_t   m_levels;
+    bool          m_immutable;
 };
 
 
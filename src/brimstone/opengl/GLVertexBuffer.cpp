@@ -11,14 +11,50 @@ Description:
 
 
 //Includes
-#include "GLVertexBuffer.hpp"   //Header
+#include "GLVertexBuffer.hpp"       //Header
+#include "GLVertexLayout.hpp"       //Brimstone::Private::enableGLVertexLayout, Brimstone::Private::disableGLVertexLayout
 
-#include <gll/gl_4_6_comp.hpp>  //gll::* (GL 4.6 and below + compatibility)
+#include <brimstone/Exception.hpp>  //Brimstone::GraphicsException
+
+#include <gll/gl_4_6_comp.hpp>      //gll::* (GL 4.6 and below + compatibility)
 using namespace gll;
 
 
 
 
+namespace {
+
+
+
+
+using enum Brimstone::VertexAttributeType;
+
+//Constants
+//TEMP: Layouts for the vertex formats that used to be hardcoded into bind(); used by setType().
+//3D textured, colored, lit
+const Brimstone::VertexLayout LAYOUT_3D = Brimstone::VertexLayout()
+    .add( 0, 4, FLOAT )    //Position
+    .add( 1, 3, FLOAT )    //Color
+    .add( 2, 2, FLOAT )    //UV (texture coordinates)
+    .add( 3, 3, FLOAT );   //Normal ('facing direction')
+
+//2D untextured
+const Brimstone::VertexLayout LAYOUT_2D = Brimstone::VertexLayout()
+    .add( 0, 2, FLOAT );   //Position
+
+//2D textured
+const Brimstone::VertexLayout LAYOUT_2D_TEXTURED = Brimstone::VertexLayout()
+    .add( 0, 2, FLOAT )    //Position
+    .add( 1, 2, FLOAT );   //UV (texture coordinates)
+
+
+
+
+} //namespace
+
+
+
+
 namespace Brimstone::Private {
 
 
@@ -26,7 +62,10 @@ namespace Brimstone::Private {
 
 GLVertexBuffer::GLVertexBuffer() :
     m_name( 0 ),
-    m_count( 0 ) {
+    m_vao( 0 ),
+    m_count( 0 ),
+    m_size( 0 ),
+    m_streamAttributes( 0 ) {
     create();
 }
 
@@ -36,142 +75,155 @@ GLVertexBuffer::~GLVertexBuffer() {
 
 void GLVertexBuffer::create() {
     glGenBuffers( 1, &m_name );
+    glGenVertexArrays( 1, &m_vao );
 }
 
 void GLVertexBuffer::destroy() {
+    if( m_vao != 0 ) {
+        glDeleteVertexArrays( 1, &m_vao );
+        m_vao = 0;
+    }
     if( m_name != 0 ) {
         glDeleteBuffers( 1, &m_name );
         m_name = 0;
     }
 }
 
-void GLVertexBuffer::set( const float* const data, const std::size_t sizeInBytes ) {
+void GLVertexBuffer::set( const void* const data, const std::size_t sizeInBytes ) {
     //Temporarily bind the buffer to GL_ARRAY_BUFFER so we can fill it
     //with the data the user provided
     glBindBuffer( GL_ARRAY_BUFFER, m_name                            );
     glBufferData( GL_ARRAY_BUFFER, sizeInBytes, data, GL_STATIC_DRAW );
     glBindBuffer( GL_ARRAY_BUFFER, 0                                 );
 
-    int vsize = 0;
-    switch( m_type ) {
-    case 0:
-        vsize = 12;
-        break;
-    case 1:
-        vsize = 2;
-        break;
-    case 2:
-        vsize = 4;
-        break;
-    }
-
-    //Number of vertices in the buffer, determined by dividing
-    //the size of the buffer by the size of a single vertex
-    m_count = sizeInBytes / (vsize*sizeof(float));
+    m_size = sizeInBytes;
+    updateCount();
 }
 
-void GLVertexBuffer::set( const float* const data, const std::size_t offsetInBytes, const std::size_t sizeInBytes ) {
+void GLVertexBuffer::set( const void* const data, const std::size_t offsetInBytes, const std::size_t sizeInBytes ) {
     glBindBuffer( GL_ARRAY_BUFFER, m_name );
     glBufferSubData( GL_ARRAY_BUFFER, offsetInBytes, sizeInBytes, data );
     glBindBuffer( GL_ARRAY_BUFFER, 0 );
 }
 
 void GLVertexBuffer::bind() {
-    //IMPORTANT: Whether or not a buffer is bound has an impact on glVertexAttribPointer.
-    //If a buffer is bound, glVertexAttribPointer treats the last argument as a BYTE OFFSET.
-    //Otherwise, it treats the last argument as a pointer to the first attribute in client memory.
-    //OpenGL 3.1+ removed the ability to use client memory, which means we NEED to bind the buffer before calling glVertexAttribPointer.
-    //See for more info: http://stackoverflow.com/questions/15380491/glvertexattribpointer-in-opengl-and-in-opengles
-    glBindBuffer( GL_ARRAY_BUFFER, m_name );
-
-    //TEMP: attribute arrays hardcoded in
-    /*
-    glVertexAttribPointer(
-        index,      //ID# of the attribute, starting from 0
-        count,      //number of elements that make up the attribute. Can be 1,2,3, or 4.
-        type,       //type of data used. Can be GL_BYTE, GL_UNSIGNED_BYTE, GL_SHORT, GL_UNSIGNED_SHORT, GL_FIXED, or GL_FLOAT.
-        normalized, //If type is GL_FIXED, providing GL_TRUE normalizes provided numbers, and performs direct conversion otherwise. I don't understand it that well.
-        stride,     //Distance, in bytes, between two attributes of the same type.
-        pointer     //Distance, in bytes, between the beginning of the array and the first attribute of this type.
-    );
-
-    Note:
-    Because our attributes are arranged in a per-vertex fashion, (e.g. {0,1,2,3}, {0,1,2,3}, ... )
-    The stride for all attributes will be the same (the sum of all the attribute sizes).
-    The offset for each attribute will be the sum of the attribute sizes that came before it.
-    */
-    switch( m_type ) {
-    //3D textured, colored, lit
-    case 0:
-        //Position
-        glEnableVertexAttribArray( 0 );
-        glVertexAttribPointer( 0, 4, GL_FLOAT, GL_FALSE, 12*sizeof( float ), (GLvoid*)(0*sizeof(float)) );
-
-        //Color
-        glEnableVertexAttribArray( 1 );
-        glVertexAttribPointer( 1, 3, GL_FLOAT, GL_FALSE, 12*sizeof( float ), (GLvoid*)(4*sizeof(float)) );
-
-        //UV (texture coordinates)
-        glEnableVertexAttribArray( 2 );
-        glVertexAttribPointer( 2, 2, GL_FLOAT, GL_FALSE, 12*sizeof( float ), (GLvoid*)(7*sizeof(float)) );
-
-        //Normal ('facing direction')
-        glEnableVertexAttribArray( 3 );
-        glVertexAttribPointer( 3, 3, GL_FLOAT, GL_FALSE, 12*sizeof( float ), (GLvoid*)(9*sizeof(float)) );
-        break;
-    //2D untextured
-    case 1:
-        //Position
-        glEnableVertexAttribArray( 0 );
-        glVertexAttribPointer( 0, 2, GL_FLOAT, GL_FALSE, 2*sizeof( float ), (GLvoid*)(0*sizeof(float)) );
-        break;
-    //2D textured
-    case 2:
-        //Position
-        glEnableVertexAttribArray( 0 );
-        glVertexAttribPointer( 0, 2, GL_FLOAT, GL_FALSE, 4*sizeof( float ), (GLvoid*)(0*sizeof(float)) );
-
-        //UV (texture coordinates)
-        glEnableVertexAttribArray( 1 );
-        glVertexAttribPointer( 1, 2, GL_FLOAT, GL_FALSE, 4*sizeof( float ), (GLvoid*)(2*sizeof(float)) );
-        break;
-    }
+    //All of the attribute state was recorded into the VAO by setLayout()
+    glBindVertexArray( m_vao );
 }
 
 void GLVertexBuffer::unbind() {
-    //TEMP: attribute arrays hardcoded in
-    switch( m_type ) {
-    //3D textured, colored, lit
-    case 0:
-        glDisableVertexAttribArray( 0 );
-        glDisableVertexAttribArray( 1 );
-        glDisableVertexAttribArray( 2 );
-        glDisableVertexAttribArray( 3 );
-        break;
-    //2D untextured
-    case 1:
-        glDisableVertexAttribArray( 0 );
-        break;
-    //2D textured
-    case 2:
-        glDisableVertexAttribArray( 0 );
-        glDisableVertexAttribArray( 1 );
-        break;
-    }
-
-    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+    glBindVertexArray( 0 );
 }
 
 void GLVertexBuffer::draw() {
     glDrawArrays( GL_TRIANGLES, 0, m_count );
 }
 
+/*
+GLVertexBuffer::setLayout
+-------------------------
+
+Description:
+    Sets the layout of the vertices stored in this buffer.
+    The attribute arrays the layout describes are recorded into this buffer's vertex array object
+    so they don't have to be re-specified every time the buffer is bound.
+
+Arguments:
+    layout:             The layout of the vertices in this buffer.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If OpenGL rejected one of the attributes.
+*/
+void GLVertexBuffer::setLayout( const VertexLayout& layout ) {
+    glBindVertexArray( m_vao );
+
+    //Disable attribute arrays enabled by the previous layout
+    disableGLVertexLayout( m_layout );
+    enableGLVertexLayout( m_name, layout, 0 );
+
+    glBindVertexArray( 0 );
+
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "Failed to set vertex layout." );
+
+    m_layout = layout;
+    updateCount();
+}
+
+const VertexLayout& GLVertexBuffer::getLayout() const {
+    return m_layout;
+}
+
+/*
+GLVertexBuffer::addInstanceStream
+---------------------------------
+
+Description:
+    Attaches per-instance attributes stored in another buffer to this buffer's vertex array object.
+    When this buffer is drawn with an instanced draw call, the stream's attributes advance once per instance
+    (or once every "divisor" instances) rather than once per vertex.
+    Attributes in the layout with a divisor of 0 are given a divisor of 1.
+
+    The stream buffer must outlive this buffer's use of it.
+
+Arguments:
+    stream:             The buffer holding the per-instance data.
+    layout:             The layout of the per-instance data in the stream.
+
+Returns:
+    N/A
+
+Throws:
+    GraphicsException:  If OpenGL rejected one of the attributes.
+*/
+void GLVertexBuffer::addInstanceStream( const GLVertexBuffer& stream, const VertexLayout& layout ) {
+    glBindVertexArray( m_vao );
+    enableGLVertexLayout( stream.m_name, layout, 1 );
+    glBindVertexArray( 0 );
+
+    if( glGetError() != GL_NO_ERROR )
+        throw GraphicsException( "Failed to add instance stream." );
+
+    for( const VertexAttribute& a : layout )
+        m_streamAttributes |= 1u << a.index;
+}
+
+void GLVertexBuffer::clearInstanceStreams() {
+    glBindVertexArray( m_vao );
+    for( uint i = 0; m_streamAttributes != 0; ++i, m_streamAttributes >>= 1 )
+        if( m_streamAttributes & 1 )
+            glDisableVertexAttribArray( i );
+    glBindVertexArray( 0 );
+}
+
+GLuint GLVertexBuffer::getVertexArray() const {
+    return m_vao;
+}
+
+GLsizei GLVertexBuffer::getCount() const {
+    return m_count;
+}
+
 //TEMP
 void GLVertexBuffer::setType( const int type ) {
-    m_type = type;
+    switch( type ) {
+    case 0: setLayout( LAYOUT_3D );          break;
+    case 1: setLayout( LAYOUT_2D );          break;
+    case 2: setLayout( LAYOUT_2D_TEXTURED ); break;
+    }
+}
+
+void GLVertexBuffer::updateCount() {
+    //Number of vertices in the buffer, determined by dividing
+    //the size of the buffer by the size of a single vertex
+    const std::size_t stride = m_layout.getStride();
+    m_count = stride != 0 ? (GLsizei)( m_size / stride ) : 0;
 }
 
 
 
 
-} //namespace Brimstone
+} //namespace Brimstone::Private
@@ -6,6 +6,10 @@ Copyright (c) 2024, theJ89
 Description:
     GLVertexBuffer is defined here.
     These objects wrap OpenGL buffers.
+
+    The buffer's VertexLayout is baked into a vertex array object (VAO) when it is set,
+    so binding the buffer for drawing only requires binding its VAO.
+    Per-instance attributes stored in other buffers can be attached to the VAO as instance streams.
 */
 #ifndef BS_OPENGL_GLVERTEXBUFFER_HPP
 #define BS_OPENGL_GLVERTEXBUFFER_HPP
@@ -14,8 +18,12 @@ Description:
 
 
 //Includes
-#include <cstddef>           //std::size_t
-#include <gll/gl_types.hpp>  //gll::GLuint, gll::GLsizei
+#include <cstddef>                              //std::size_t
+#include <brimstone/graphics/VertexLayout.hpp>  //Brimstone::VertexLayout
+
+#include <brimstone/types.hpp>                  //Brimstone::uint32
+
+#include <gll/gl_types.hpp>                     //gll::GLuint, gll::GLsizei
 
 
 
@@ -35,17 +43,31 @@ public:
     void create();
     void destroy();
 
-    void set( const float* const data, const std::size_t sizeInBytes );
-    void set( const float* const data, const std::size_t offsetInBytes, const std::size_t sizeInBytes );
+    void set( const void* const data, const std::size_t sizeInBytes );
+    void set( const void* const data, const std::size_t offsetInBytes, const std::size_t sizeInBytes );
     void bind();
     void unbind();
     void draw();
 
+    void                setLayout( const VertexLayout& layout );
+    const VertexLayout& getLayout() const;
+
+    void                addInstanceStream( const GLVertexBuffer& stream, const VertexLayout& layout );
+    void                clearInstanceStreams();
+
+    gll::GLuint         getVertexArray() const;
+    gll::GLsizei        getCount() const;
+
     void setType( const int type );
+private:
+    void updateCount();
 private:
     gll::GLuint  m_name;
+    gll::GLuint  m_vao;
     gll::GLsizei m_count;
-    int          m_type;
+    std::size_t  m_size;
+    VertexLayout m_layout;
+    uint32       m_streamAttributes;  //Bitmask of attribute indices enabled by instance streams
 };
 
 
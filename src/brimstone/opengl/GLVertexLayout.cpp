@@ -0,0 +1,103 @@
+/*
+opengl/GLVertexLayout.cpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See GLVertexLayout.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include "GLVertexLayout.hpp"   //Header
+
+#include <gll/gl_4_6_comp.hpp>  //gll::* (GL 4.6 and below + compatibility)
+using namespace gll;
+
+
+
+
+namespace {
+
+
+
+
+//Constants
+constexpr GLenum VertexAttributeTypeToGLType[] {
+    GL_BYTE,            //BYTE
+    GL_UNSIGNED_BYTE,   //UNSIGNED_BYTE
+    GL_SHORT,           //SHORT
+    GL_UNSIGNED_SHORT,  //UNSIGNED_SHORT
+    GL_INT,             //INT
+    GL_UNSIGNED_INT,    //UNSIGNED_INT
+    GL_HALF_FLOAT,      //HALF_FLOAT
+    GL_FLOAT            //FLOAT
+};
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+/*
+enableGLVertexLayout
+--------------------
+
+Description:
+    Enables and specifies the attribute arrays described by the given layout in the currently bound VAO.
+    The attributes source their data from the given buffer.
+
+Arguments:
+    buffer:          The buffer holding the vertex data.
+    layout:          The layout of the vertex data.
+    defaultDivisor:  The divisor given to attributes whose divisor is 0.
+
+Returns:
+    N/A
+*/
+void enableGLVertexLayout( const GLuint buffer, const VertexLayout& layout, const uint defaultDivisor ) {
+    //IMPORTANT: Whether or not a buffer is bound has an impact on glVertexAttribPointer.
+    //If a buffer is bound, glVertexAttribPointer treats the last argument as a BYTE OFFSET.
+    //Otherwise, it treats the last argument as a pointer to the first attribute in client memory.
+    //OpenGL 3.1+ removed the ability to use client memory, which means we NEED to bind the buffer before calling glVertexAttribPointer.
+    //The VAO remembers which buffer was bound to GL_ARRAY_BUFFER when each attribute was specified.
+    //See for more info: http://stackoverflow.com/questions/15380491/glvertexattribpointer-in-opengl-and-in-opengles
+    glBindBuffer( GL_ARRAY_BUFFER, buffer );
+
+    const GLsizei stride = (GLsizei)layout.getStride();
+    for( const VertexAttribute& a : layout ) {
+        glEnableVertexAttribArray( a.index );
+
+        //Integer attributes are read by the shader as-is; everything else is converted to floats (and optionally normalized)
+        const GLenum type = VertexAttributeTypeToGLType[ (int)a.type ];
+        if( a.integer ) {
+            glVertexAttribIPointer( a.index, a.count, type, stride, (GLvoid*)a.offset );
+        } else {
+            glVertexAttribPointer( a.index, a.count, type, a.normalized ? GL_TRUE : GL_FALSE, stride, (GLvoid*)a.offset );
+        }
+
+        glVertexAttribDivisor( a.index, ( a.divisor == 0 ) ? defaultDivisor : a.divisor );
+    }
+
+    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+}
+
+void disableGLVertexLayout( const VertexLayout& layout ) {
+    for( const VertexAttribute& a : layout )
+        glDisableVertexAttribArray( a.index );
+}
+
+
+
+
+} //namespace Brimstone::Private
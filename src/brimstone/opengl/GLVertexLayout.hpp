@@ -0,0 +1,42 @@
+/*
+opengl/GLVertexLayout.hpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Functions for recording a VertexLayout into the currently bound vertex array object (VAO).
+    These are shared by every OpenGL object that owns a VAO (vertex buffers, streaming buffers, etc).
+*/
+#ifndef BS_OPENGL_GLVERTEXLAYOUT_HPP
+#define BS_OPENGL_GLVERTEXLAYOUT_HPP
+
+
+
+
+//Includes
+#include <brimstone/types.hpp>                  //Brimstone::uint
+#include <brimstone/graphics/VertexLayout.hpp>  //Brimstone::VertexLayout
+
+#include <gll/gl_types.hpp>                     //gll::GLuint
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+//Forward declarations
+void enableGLVertexLayout( const gll::GLuint buffer, const VertexLayout& layout, const uint defaultDivisor );
+void disableGLVertexLayout( const VertexLayout& layout );
+
+
+
+
+} //namespace Brimstone::Private
+
+
+
+
+#endif //BS_OPENGL_GLVERTEXLAYOUT_HPP
@@ -0,0 +1,293 @@
+/*
+util/LZ4.cpp
+------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See util/LZ4.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/util/LZ4.hpp>  //Header
+#include <brimstone/types.hpp>     //Brimstone::ubyte, Brimstone::uint16, Brimstone::uint32
+
+#include <cstring>                 //std::memcpy, std::memset
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ubyte;
+using ::Brimstone::uint16;
+using ::Brimstone::uint32;
+
+
+
+
+//Constants
+//Matches are at least this long
+constexpr std::size_t LZ4_MIN_MATCH     = 4;
+
+//The last match must start at least this many bytes before the end of the block...
+constexpr std::size_t LZ4_MF_LIMIT      = 12;
+
+//...and the block must end with at least this many literals
+constexpr std::size_t LZ4_LAST_LITERALS = 5;
+
+//Matches can refer back at most this far
+constexpr std::size_t LZ4_MAX_DISTANCE  = 65535;
+
+//The compressor remembers the last position each 4-byte sequence was seen at in a table of this many entries
+constexpr uint32      LZ4_HASH_BITS     = 12;
+constexpr std::size_t LZ4_HASH_SIZE     = (std::size_t)1 << LZ4_HASH_BITS;
+
+
+
+
+//Functions
+uint32 read32( const ubyte* const bytes ) {
+    uint32 value;
+    std::memcpy( &value, bytes, sizeof( value ) );
+    return value;
+}
+
+uint32 hashSequence( const uint32 sequence ) {
+    return ( sequence * 2654435761u ) >> ( 32 - LZ4_HASH_BITS );
+}
+
+//Writes a length that didn't fit in a token nibble as a run of 255s followed by the remainder
+ubyte* writeLength( ubyte* out, std::size_t length ) {
+    for( ; length >= 255; length -= 255 )
+        *out++ = 255;
+    *out++ = (ubyte)length;
+    return out;
+}
+
+//Reads the rest of a length that started in a token nibble. Returns false if the input ran out.
+bool readLength( const ubyte*& in, const ubyte* const end, std::size_t& length ) {
+    ubyte next;
+    do {
+        if( in == end )
+            return false;
+        next = *in++;
+        length += next;
+    } while( next == 255 );
+    return true;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+/*
+getLZ4CompressBound
+-------------------
+
+Description:
+    Returns the largest size that compressing the given number of bytes can produce.
+    Data that doesn't compress well grows slightly.
+
+Arguments:
+    size:          The number of bytes to compress.
+
+Returns:
+    std::size_t:   The size of buffer that compressLZ4() is guaranteed to succeed with.
+*/
+std::size_t getLZ4CompressBound( const std::size_t size ) {
+    return size + size / 255 + 16;
+}
+
+/*
+compressLZ4
+-----------
+
+Description:
+    Compresses data into a single LZ4 block.
+
+Arguments:
+    source:                 The data to compress.
+    sourceSize:             The number of bytes to compress.
+    destination:            Where to write the block.
+    destinationCapacity:    The size of destination, in bytes.
+                            If this is at least getLZ4CompressBound( sourceSize ), compression can't fail.
+
+Returns:
+    std::size_t:            The size of the block, or 0 if it didn't fit in destination.
+                            Note that compressing 0 bytes produces a 1-byte block.
+*/
+std::size_t compressLZ4( const void* const source, const std::size_t sourceSize, void* const destination, const std::size_t destinationCapacity ) {
+    const ubyte* const in     = static_cast< const ubyte* >( source );
+    const ubyte* const inEnd  = in + sourceSize;
+    ubyte* const       out    = static_cast< ubyte* >( destination );
+    ubyte* const       outEnd = out + destinationCapacity;
+
+    ubyte*       op     = out;
+    const ubyte* anchor = in;
+
+    if( sourceSize > LZ4_MF_LIMIT ) {
+        //Positions are stored relative to the start of the source, so 0 doubles as "not seen yet"
+        uint32 table[ LZ4_HASH_SIZE ];
+        std::memset( table, 0, sizeof( table ) );
+
+        const ubyte* const matchLimit = inEnd - LZ4_LAST_LITERALS;
+        const ubyte* const searchEnd  = inEnd - LZ4_MF_LIMIT;
+
+        const ubyte* ip = in + 1;
+        while( ip <= searchEnd ) {
+            const uint32       sequence  = read32( ip );
+            const uint32       hash      = hashSequence( sequence );
+            const ubyte* const candidate = in + table[ hash ];
+            table[ hash ] = (uint32)( ip - in );
+
+            if( candidate == in || (std::size_t)( ip - candidate ) > LZ4_MAX_DISTANCE || read32( candidate ) != sequence ) {
+                ++ip;
+                continue;
+            }
+
+            //Extend the match backwards over literals that also match...
+            const ubyte* matchStart = ip;
+            const ubyte* reference  = candidate;
+            while( matchStart > anchor && reference > in && matchStart[-1] == reference[-1] ) {
+                --matchStart;
+                --reference;
+            }
+
+            //...and forwards as far as it goes
+            const ubyte* matchEnd = ip + LZ4_MIN_MATCH;
+            const ubyte* refEnd   = candidate + LZ4_MIN_MATCH;
+            while( matchEnd < matchLimit && *matchEnd == *refEnd ) {
+                ++matchEnd;
+                ++refEnd;
+            }
+
+            const std::size_t literals    = (std::size_t)( matchStart - anchor );
+            const std::size_t matchLength = (std::size_t)( matchEnd - matchStart ) - LZ4_MIN_MATCH;
+            if( (std::size_t)( outEnd - op ) < 1 + literals + literals / 255 + 1 + 2 + matchLength / 255 + 1 )
+                return 0;
+
+            ubyte* token = op++;
+            *token = (ubyte)( ( literals >= 15 ? 15 : literals ) << 4 );
+            if( literals >= 15 )
+                op = writeLength( op, literals - 15 );
+            std::memcpy( op, anchor, literals );
+            op += literals;
+
+            const uint16 distance = (uint16)( matchStart - reference );
+            *op++ = (ubyte)( distance & 0xFF );
+            *op++ = (ubyte)( distance >> 8 );
+
+            *token |= (ubyte)( matchLength >= 15 ? 15 : matchLength );
+            if( matchLength >= 15 )
+                op = writeLength( op, matchLength - 15 );
+
+            anchor = ip = matchEnd;
+            if( ip <= searchEnd )
+                table[ hashSequence( read32( ip - 2 ) ) ] = (uint32)( ip - 2 - in );
+        }
+    }
+
+    //Everything after the last match is stored as literals
+    const std::size_t literals = (std::size_t)( inEnd - anchor );
+    if( (std::size_t)( outEnd - op ) < 1 + literals + literals / 255 + 1 )
+        return 0;
+
+    *op++ = (ubyte)( ( literals >= 15 ? 15 : literals ) << 4 );
+    if( literals >= 15 )
+        op = writeLength( op, literals - 15 );
+    if( literals > 0 )
+        std::memcpy( op, anchor, literals );
+    op += literals;
+
+    return (std::size_t)( op - out );
+}
+
+/*
+decompressLZ4
+-------------
+
+Description:
+    Decompresses a single LZ4 block.
+    The block is checked as it's decompressed, so corrupt or malicious blocks are rejected rather than
+    reading or writing out of bounds.
+
+Arguments:
+    source:            The block to decompress.
+    sourceSize:        The size of the block, in bytes.
+    destination:       Where to write the decompressed data. Its contents are undefined if decompression fails.
+    destinationSize:   The size the block decompresses to, in bytes.
+
+Returns:
+    bool:              true if the block was decompressed and decompressed to exactly destinationSize bytes, false otherwise.
+*/
+bool decompressLZ4( const void* const source, const std::size_t sourceSize, void* const destination, const std::size_t destinationSize ) {
+    const ubyte*       ip     = static_cast< const ubyte* >( source );
+    const ubyte* const inEnd  = ip + sourceSize;
+    ubyte* const       out    = static_cast< ubyte* >( destination );
+    ubyte*             op     = out;
+    ubyte* const       outEnd = out + destinationSize;
+
+    while( ip < inEnd ) {
+        const ubyte token = *ip++;
+
+        std::size_t literals = token >> 4;
+        if( literals == 15 && !readLength( ip, inEnd, literals ) )
+            return false;
+        if( literals > (std::size_t)( inEnd - ip ) || literals > (std::size_t)( outEnd - op ) )
+            return false;
+        std::memcpy( op, ip, literals );
+        ip += literals;
+        op += literals;
+
+        //The last sequence has no match
+        if( ip == inEnd )
+            break;
+
+        if( inEnd - ip < 2 )
+            return false;
+        const std::size_t distance = (std::size_t)ip[0] | ( (std::size_t)ip[1] << 8 );
+        ip += 2;
+        if( distance == 0 || distance > (std::size_t)( op - out ) )
+            return false;
+
+        std::size_t length = token & 15;
+        if( length == 15 && !readLength( ip, inEnd, length ) )
+            return false;
+        length += LZ4_MIN_MATCH;
+        if( length > (std::size_t)( outEnd - op ) )
+            return false;
+
+        //Matches can overlap the bytes they produce (e.g. a distance of 1 repeats a byte), so copy them in order
+        const ubyte* match = op - distance;
+        if( distance >= length ) {
+            std::memcpy( op, match, length );
+            op += length;
+        } else {
+            for( std::size_t i = 0; i < length; ++i )
+                *op++ = *match++;
+        }
+    }
+
+    return op == outEnd;
+}
+
+
+
+
+} //namespace Brimstone
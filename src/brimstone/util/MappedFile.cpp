@@ -0,0 +1,95 @@
+/*
+util/MappedFile.cpp
+-------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See MappedFile.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/util/MappedFile.hpp>  //Header
+
+#include <utility>                        //std::move
+
+
+
+
+//Brimstone::Private::MappedFileImpl
+#if defined( BS_BUILD_WINDOWS )
+#include "../windows/WindowsMappedFile.hpp"  //Brimstone::Private::WindowsMappedFile
+#elif defined( BS_BUILD_LINUX )
+#include "../linux/LinuxMappedFile.hpp"      //Brimstone::Private::LinuxMappedFile
+#endif
+
+
+
+
+namespace Brimstone {
+
+
+
+
+MappedFile::MappedFile() {
+}
+
+MappedFile::MappedFile( MappedFile&& toMove ) :
+    m_impl( std::move( toMove.m_impl ) ) {
+}
+
+MappedFile& MappedFile::operator =( MappedFile&& toMove ) {
+    m_impl = std::move( toMove.m_impl );
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+}
+
+/*
+MappedFile::open
+----------------
+
+Description:
+    Maps the file at the given path into memory, closing the file that was mapped before (if any).
+
+Arguments:
+    filename:   The path to the file to map.
+
+Returns:
+    bool:       true if the file was mapped, false if it couldn't be opened or mapped.
+                An empty file can be opened; its data is nullptr.
+*/
+bool MappedFile::open( const ustring& filename ) {
+    close();
+
+    std::unique_ptr< Private::MappedFileImpl > impl( new Private::MappedFileImpl() );
+    if( !impl->open( filename ) )
+        return false;
+
+    m_impl = std::move( impl );
+    return true;
+}
+
+void MappedFile::close() {
+    m_impl.reset();
+}
+
+bool MappedFile::isOpen() const {
+    return m_impl != nullptr;
+}
+
+const ubyte* MappedFile::getData() const {
+    return m_impl != nullptr ? m_impl->getData() : nullptr;
+}
+
+std::size_t MappedFile::getSize() const {
+    return m_impl != nullptr ? m_impl->getSize() : 0;
+}
+
+
+
+
+} //namespace Brimstone
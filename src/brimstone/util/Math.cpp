@@ -14,6 +14,8 @@ Description:
 #include <brimstone/util/Math.hpp>      //Header
 #include <brimstone/util/Macros.hpp>    //BS_ASSERT_NONZERO_DIVISOR, BS_ASSERT_DOMAIN_GTE
 
+#include <bit>                          //std::bit_cast
+
 
 
 
@@ -143,6 +145,95 @@ float fastInvSqrt( float value ) {
     return value;
 }
 
+/*
+floatToHalf
+-----------
+
+Description:
+    Converts a 32-bit (single precision) float to a 16-bit (half precision) float, rounding to the nearest representable value (ties to even).
+    Values too large to be represented become infinity, values too small become zero, and NaNs remain NaNs.
+
+    Half floats are typically used to store vertex attributes or texels compactly when full single precision isn't needed.
+
+Arguments:
+    value:   The float to convert.
+
+Returns:
+    uint16:  The bits of the equivalent half float.
+*/
+uint16 floatToHalf( const float value ) {
+    const uint32 bits = std::bit_cast< uint32 >( value );
+    const uint32 sign = ( bits >> 16 ) & 0x8000;
+    const uint32 abs  = bits & 0x7FFFFFFF;
+
+    //Infinity / NaN. Keep NaNs quiet NaNs.
+    if( abs >= 0x7F800000 )
+        return (uint16)( sign | 0x7C00 | ( abs > 0x7F800000 ? 0x0200 : 0 ) );
+
+    //Too large to be represented (>= 65536); becomes infinity.
+    //Values between 65504 (the largest half) and 65536 are handled by rounding below, which can carry into infinity.
+    if( abs >= 0x47800000 )
+        return (uint16)( sign | 0x7C00 );
+
+    //Smaller than the smallest normal half (2^-14); the result is a subnormal half or zero.
+    if( abs < 0x38800000 ) {
+        //Smaller than half of the smallest subnormal half (2^-25); rounds to zero.
+        if( abs < 0x33000000 )
+            return (uint16)sign;
+
+        //A subnormal half is mantissa * 2^-24. Shift the float's mantissa (with its implicit leading 1) into place.
+        const uint32 shift    = 126 - ( abs >> 23 );
+        const uint32 mantissa = ( abs & 0x007FFFFF ) | 0x00800000;
+        const uint32 rest     = mantissa & ( ( 1u << shift ) - 1 );
+        const uint32 halfway  = 1u << ( shift - 1 );
+        uint32 half = mantissa >> shift;
+        if( rest > halfway || ( rest == halfway && ( half & 1 ) ) )
+            ++half;
+        return (uint16)( sign | half );
+    }
+
+    //Normal half. Rebias the exponent from 127 to 15 and drop the 13 lowest bits of the mantissa, rounding to nearest even.
+    //NOTE: If rounding overflows the mantissa, the carry correctly increments the exponent.
+    uint32 half = ( abs - 0x38000000 ) >> 13;
+    const uint32 rest = abs & 0x1FFF;
+    if( rest > 0x1000 || ( rest == 0x1000 && ( half & 1 ) ) )
+        ++half;
+    return (uint16)( sign | half );
+}
+
+/*
+halfToFloat
+-----------
+
+Description:
+    Converts a 16-bit (half precision) float to a 32-bit (single precision) float.
+    Every half float can be represented exactly as a float, so this conversion is lossless.
+
+Arguments:
+    value:  The bits of the half float to convert.
+
+Returns:
+    float:  The equivalent float.
+*/
+float halfToFloat( const uint16 value ) {
+    const uint32 sign     = (uint32)( value & 0x8000 ) << 16;
+    const uint32 exponent = ( value >> 10 ) & 0x1F;
+    const uint32 mantissa = value & 0x03FF;
+
+    //Zero / subnormal half (mantissa * 2^-24)
+    if( exponent == 0 ) {
+        const float magnitude = (float)mantissa * ( 1.0f / 16777216.0f );
+        return sign ? -magnitude : magnitude;
+    }
+
+    //Infinity / NaN
+    if( exponent == 31 )
+        return std::bit_cast< float >( sign | 0x7F800000 | ( mantissa << 13 ) );
+
+    //Normal half. Rebias the exponent from 15 to 127.
+    return std::bit_cast< float >( sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 ) );
+}
+
 
 
 
@@ -0,0 +1,443 @@
+/*
+util/PixelOps.cpp
+-----------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See util/PixelOps.hpp for more information.
+
+    Each operation has a scalar version, which also handles any pixels left over after the vectorized versions,
+    and (on x86) SSSE3 and AVX2 versions. convertRGBToRGBA() and unpremultiplyAlpha() use their SSSE3 versions on AVX2 CPUs too;
+    widening them to 256 bits needs extra cross-lane work that made them slower in the Image_pixelOps benchmark.
+*/
+
+
+
+
+//Includes
+#include <brimstone/util/PixelOps.hpp>  //Header
+#include "SIMD.hpp"                     //BS_SIMD_X86, BS_TARGET, _mm_*, _mm256_*
+
+#include <algorithm>                    //std::min, std::swap
+#include <atomic>                       //std::atomic
+#include <cmath>                        //std::pow
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ubyte;
+using ::Brimstone::SIMDLevel;
+
+//The multipliers for each channel of a pixel with a given alpha
+using UnpremultiplyTable = float[256][4];
+
+
+
+
+//Constants
+//Added to scaled channels before they're truncated when unpremultiplying. It's slightly more than 0.5 so that
+//results exactly halfway between two values round up despite float error; nothing else is closer than 1/510 to halfway.
+constexpr float UNPREMULTIPLY_BIAS = 0.5f + 1.0f / 1024.0f;
+
+
+
+
+//Functions
+//Returns the multipliers that unpremultiplyAlpha() scales each channel of a pixel with the given alpha by
+const UnpremultiplyTable& getUnpremultiplyTable() {
+    static const struct Table {
+        alignas( 16 ) UnpremultiplyTable values;
+        Table() {
+            for( int a = 0; a < 256; ++a ) {
+                const float inverse = ( a == 0 ) ? 0.0f : 255.0f / a;
+                values[a][0] = values[a][1] = values[a][2] = inverse;
+                values[a][3] = 1.0f;
+            }
+        }
+    } table;
+    return table.values;
+}
+
+//Returns a table mapping each 8-bit sRGB value to the nearest 8-bit linear value
+const ubyte* getSRGBToLinearTable() {
+    static const struct Table {
+        ubyte values[256];
+        Table() {
+            for( int i = 0; i < 256; ++i ) {
+                const double c = i / 255.0;
+                const double l = ( c <= 0.04045 ) ? c / 12.92 : std::pow( ( c + 0.055 ) / 1.055, 2.4 );
+                values[i] = (ubyte)( l * 255.0 + 0.5 );
+            }
+        }
+    } table;
+    return table.values;
+}
+
+SIMDLevel detectSIMDLevel() {
+#if defined( BS_SIMD_X86 ) && defined( _MSC_VER )
+    int info[4];
+    __cpuid( info, 1 );
+    const bool ssse3 = ( info[2] & ( 1 << 9 ) ) != 0;
+
+    //AVX registers are only usable if the OS saves them (OSXSAVE, and XCR0 has the SSE and AVX bits set)
+    bool avx2 = false;
+    if( ( info[2] & ( 1 << 27 ) ) != 0 && ( info[2] & ( 1 << 28 ) ) != 0 && ( _xgetbv( 0 ) & 6 ) == 6 ) {
+        __cpuidex( info, 7, 0 );
+        avx2 = ( info[1] & ( 1 << 5 ) ) != 0;
+    }
+#elif defined( BS_SIMD_X86 )
+    __builtin_cpu_init();
+    const bool ssse3 = __builtin_cpu_supports( "ssse3" );
+    const bool avx2  = __builtin_cpu_supports( "avx2" );
+#else
+    const bool ssse3 = false;
+    const bool avx2  = false;
+#endif
+
+    return avx2 ? SIMDLevel::AVX2 : ssse3 ? SIMDLevel::SSSE3 : SIMDLevel::NONE;
+}
+
+std::atomic< SIMDLevel >& getLevel() {
+    static std::atomic< SIMDLevel > level( ::Brimstone::getSupportedSIMDLevel() );
+    return level;
+}
+
+//Converts pixels [begin, end) from RGB to RGBA, from the last pixel to the first
+void rgbToRGBAScalar( ubyte* const data, const std::size_t begin, std::size_t end ) {
+    while( end > begin ) {
+        --end;
+        const ubyte r = data[ end * 3     ];
+        const ubyte g = data[ end * 3 + 1 ];
+        const ubyte b = data[ end * 3 + 2 ];
+        data[ end * 4     ] = r;
+        data[ end * 4 + 1 ] = g;
+        data[ end * 4 + 2 ] = b;
+        data[ end * 4 + 3 ] = 255;
+    }
+}
+
+void swapRedBlueScalar( ubyte* const data, const std::size_t begin, const std::size_t end ) {
+    for( std::size_t i = begin; i < end; ++i )
+        std::swap( data[ i * 4 ], data[ i * 4 + 2 ] );
+}
+
+//Each channel becomes round( c * a / 255 ), computed exactly without dividing
+void premultiplyAlphaScalar( ubyte* const data, const std::size_t begin, const std::size_t end ) {
+    for( std::size_t i = begin; i < end; ++i ) {
+        ubyte* const pixel = data + i * 4;
+        const unsigned a = pixel[3];
+        for( int c = 0; c < 3; ++c ) {
+            const unsigned t = pixel[c] * a + 128;
+            pixel[c] = (ubyte)( ( t + ( t >> 8 ) ) >> 8 );
+        }
+    }
+}
+
+//Each channel becomes min( round( c * 255 / a ), 255 ), or 0 if a is 0.
+//This is computed in single precision the same way the vectorized versions compute it, and is exact for every c and a.
+void unpremultiplyAlphaScalar( ubyte* const data, const std::size_t begin, const std::size_t end ) {
+    const UnpremultiplyTable& table = getUnpremultiplyTable();
+    for( std::size_t i = begin; i < end; ++i ) {
+        ubyte* const pixel   = data + i * 4;
+        const float  inverse = table[ pixel[3] ][0];
+        for( int c = 0; c < 3; ++c )
+            pixel[c] = (ubyte)std::min( (int)( (float)pixel[c] * inverse + UNPREMULTIPLY_BIAS ), 255 );
+    }
+}
+
+void flipRowsScalar( ubyte* const top, ubyte* const bottom, const std::size_t begin, const std::size_t end ) {
+    for( std::size_t i = begin; i < end; ++i )
+        std::swap( top[i], bottom[i] );
+}
+
+
+
+
+#if defined( BS_SIMD_X86 )
+BS_TARGET( "ssse3" )
+void rgbToRGBASSSE3( ubyte* const data, const std::size_t pixelCount ) {
+    //Vectors read 16 bytes for every 12 they convert. Working backwards, the extra bytes are always either
+    //pixels that haven't been converted yet or bytes of the buffer that are about to be overwritten.
+    const std::size_t vectorEnd = pixelCount & ~(std::size_t)3;
+    rgbToRGBAScalar( data, vectorEnd, pixelCount );
+
+    const __m128i shuffle = _mm_setr_epi8( 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1 );
+    const __m128i alpha   = _mm_set1_epi32( (int)0xFF000000 );
+    for( std::size_t i = vectorEnd; i > 0; ) {
+        i -= 4;
+        const __m128i rgb = _mm_loadu_si128( (const __m128i*)( data + i * 3 ) );
+        _mm_storeu_si128( (__m128i*)( data + i * 4 ), _mm_or_si128( _mm_shuffle_epi8( rgb, shuffle ), alpha ) );
+    }
+}
+
+BS_TARGET( "ssse3" )
+void swapRedBlueSSSE3( ubyte* const data, const std::size_t pixelCount ) {
+    const __m128i shuffle = _mm_setr_epi8( 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 );
+    std::size_t i = 0;
+    for( ; i + 4 <= pixelCount; i += 4 ) {
+        const __m128i pixels = _mm_loadu_si128( (const __m128i*)( data + i * 4 ) );
+        _mm_storeu_si128( (__m128i*)( data + i * 4 ), _mm_shuffle_epi8( pixels, shuffle ) );
+    }
+    swapRedBlueScalar( data, i, pixelCount );
+}
+
+//Premultiplies two pixels, with their channels widened to 16 bits
+BS_TARGET( "ssse3" )
+__m128i premultiply16( const __m128i pixels ) {
+    //Multiply color channels by alpha, and alpha by 255 (which leaves it unchanged)
+    const __m128i colorMask = _mm_setr_epi16( -1, -1, -1, 0, -1, -1, -1, 0 );
+    const __m128i alpha255  = _mm_setr_epi16( 0, 0, 0, 255, 0, 0, 0, 255 );
+    __m128i alpha = _mm_shufflehi_epi16( _mm_shufflelo_epi16( pixels, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 3, 3, 3, 3 ) );
+    alpha = _mm_or_si128( _mm_and_si128( alpha, colorMask ), alpha255 );
+
+    const __m128i t = _mm_add_epi16( _mm_mullo_epi16( pixels, alpha ), _mm_set1_epi16( 128 ) );
+    return _mm_srli_epi16( _mm_add_epi16( t, _mm_srli_epi16( t, 8 ) ), 8 );
+}
+
+BS_TARGET( "ssse3" )
+void premultiplyAlphaSSSE3( ubyte* const data, const std::size_t pixelCount ) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for( ; i + 4 <= pixelCount; i += 4 ) {
+        const __m128i pixels = _mm_loadu_si128( (const __m128i*)( data + i * 4 ) );
+        const __m128i lo = premultiply16( _mm_unpacklo_epi8( pixels, zero ) );
+        const __m128i hi = premultiply16( _mm_unpackhi_epi8( pixels, zero ) );
+        _mm_storeu_si128( (__m128i*)( data + i * 4 ), _mm_packus_epi16( lo, hi ) );
+    }
+    premultiplyAlphaScalar( data, i, pixelCount );
+}
+
+//Unpremultiplies one pixel, with its channels widened to 32 bits
+BS_TARGET( "ssse3" )
+__m128i unpremultiply32( const __m128i pixel, const float* const multipliers ) {
+    const __m128 scaled = _mm_mul_ps( _mm_cvtepi32_ps( pixel ), _mm_load_ps( multipliers ) );
+    return _mm_cvttps_epi32( _mm_add_ps( scaled, _mm_set1_ps( UNPREMULTIPLY_BIAS ) ) );
+}
+
+BS_TARGET( "ssse3" )
+void unpremultiplyAlphaSSSE3( ubyte* const data, const std::size_t pixelCount ) {
+    const UnpremultiplyTable& table = getUnpremultiplyTable();
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for( ; i + 4 <= pixelCount; i += 4 ) {
+        ubyte* const  p      = data + i * 4;
+        const __m128i pixels = _mm_loadu_si128( (const __m128i*)p );
+        const __m128i lo     = _mm_unpacklo_epi8( pixels, zero );
+        const __m128i hi     = _mm_unpackhi_epi8( pixels, zero );
+        const __m128i p0     = unpremultiply32( _mm_unpacklo_epi16( lo, zero ), table[ p[3] ] );
+        const __m128i p1     = unpremultiply32( _mm_unpackhi_epi16( lo, zero ), table[ p[7] ] );
+        const __m128i p2     = unpremultiply32( _mm_unpacklo_epi16( hi, zero ), table[ p[11] ] );
+        const __m128i p3     = unpremultiply32( _mm_unpackhi_epi16( hi, zero ), table[ p[15] ] );
+
+        //Saturating packs clamp the channels to 255
+        _mm_storeu_si128( (__m128i*)p, _mm_packus_epi16( _mm_packs_epi32( p0, p1 ), _mm_packs_epi32( p2, p3 ) ) );
+    }
+    unpremultiplyAlphaScalar( data, i, pixelCount );
+}
+
+BS_TARGET( "ssse3" )
+void flipRowsSSSE3( ubyte* const top, ubyte* const bottom, const std::size_t rowSize ) {
+    std::size_t i = 0;
+    for( ; i + 16 <= rowSize; i += 16 ) {
+        const __m128i a = _mm_loadu_si128( (const __m128i*)( top    + i ) );
+        const __m128i b = _mm_loadu_si128( (const __m128i*)( bottom + i ) );
+        _mm_storeu_si128( (__m128i*)( top    + i ), b );
+        _mm_storeu_si128( (__m128i*)( bottom + i ), a );
+    }
+    flipRowsScalar( top, bottom, i, rowSize );
+}
+
+
+
+
+BS_TARGET( "avx2" )
+void swapRedBlueAVX2( ubyte* const data, const std::size_t pixelCount ) {
+    const __m256i shuffle = _mm256_setr_epi8( 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                              2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 );
+    std::size_t i = 0;
+    for( ; i + 8 <= pixelCount; i += 8 ) {
+        const __m256i pixels = _mm256_loadu_si256( (const __m256i*)( data + i * 4 ) );
+        _mm256_storeu_si256( (__m256i*)( data + i * 4 ), _mm256_shuffle_epi8( pixels, shuffle ) );
+    }
+    swapRedBlueScalar( data, i, pixelCount );
+}
+
+BS_TARGET( "avx2" )
+__m256i premultiply16AVX2( const __m256i pixels ) {
+    const __m256i colorMask = _mm256_setr_epi16( -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0 );
+    const __m256i alpha255  = _mm256_setr_epi16( 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255 );
+    __m256i alpha = _mm256_shufflehi_epi16( _mm256_shufflelo_epi16( pixels, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 3, 3, 3, 3 ) );
+    alpha = _mm256_or_si256( _mm256_and_si256( alpha, colorMask ), alpha255 );
+
+    const __m256i t = _mm256_add_epi16( _mm256_mullo_epi16( pixels, alpha ), _mm256_set1_epi16( 128 ) );
+    return _mm256_srli_epi16( _mm256_add_epi16( t, _mm256_srli_epi16( t, 8 ) ), 8 );
+}
+
+BS_TARGET( "avx2" )
+void premultiplyAlphaAVX2( ubyte* const data, const std::size_t pixelCount ) {
+    //Unpacking and packing both work within 128-bit lanes, so the pixels end up back in their original order
+    const __m256i zero = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for( ; i + 8 <= pixelCount; i += 8 ) {
+        const __m256i pixels = _mm256_loadu_si256( (const __m256i*)( data + i * 4 ) );
+        const __m256i lo = premultiply16AVX2( _mm256_unpacklo_epi8( pixels, zero ) );
+        const __m256i hi = premultiply16AVX2( _mm256_unpackhi_epi8( pixels, zero ) );
+        _mm256_storeu_si256( (__m256i*)( data + i * 4 ), _mm256_packus_epi16( lo, hi ) );
+    }
+    premultiplyAlphaScalar( data, i, pixelCount );
+}
+
+BS_TARGET( "avx2" )
+void flipRowsAVX2( ubyte* const top, ubyte* const bottom, const std::size_t rowSize ) {
+    std::size_t i = 0;
+    for( ; i + 32 <= rowSize; i += 32 ) {
+        const __m256i a = _mm256_loadu_si256( (const __m256i*)( top    + i ) );
+        const __m256i b = _mm256_loadu_si256( (const __m256i*)( bottom + i ) );
+        _mm256_storeu_si256( (__m256i*)( top    + i ), b );
+        _mm256_storeu_si256( (__m256i*)( bottom + i ), a );
+    }
+    flipRowsScalar( top, bottom, i, rowSize );
+}
+#endif //BS_SIMD_X86
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+//Returns the best instruction set this CPU supports
+SIMDLevel getSupportedSIMDLevel() {
+    static const SIMDLevel level = detectSIMDLevel();
+    return level;
+}
+
+//Returns the instruction set pixel operations are currently using
+SIMDLevel getSIMDLevel() {
+    return getLevel().load( std::memory_order_relaxed );
+}
+
+//Makes pixel operations use the given instruction set, or the best one the CPU supports if it doesn't support that one
+void setSIMDLevel( const SIMDLevel level ) {
+    getLevel().store( std::min( level, getSupportedSIMDLevel() ), std::memory_order_relaxed );
+}
+
+/*
+convertRGBToRGBA
+----------------
+
+Description:
+    Expands RGB8 pixels to RGBA8 in place, with an alpha of 255.
+
+Arguments:
+    data:        Holds pixelCount RGB pixels at the start, and must have room for pixelCount RGBA pixels.
+    pixelCount:  The number of pixels to convert.
+
+Returns:
+    N/A
+*/
+void convertRGBToRGBA( ubyte* const data, const std::size_t pixelCount ) {
+    switch( getSIMDLevel() ) {
+#if defined( BS_SIMD_X86 )
+    case SIMDLevel::AVX2:
+    case SIMDLevel::SSSE3: rgbToRGBASSSE3( data, pixelCount );     return;
+#endif
+    default:               rgbToRGBAScalar( data, 0, pixelCount ); return;
+    }
+}
+
+//Swaps the first and third channels of RGBA8 pixels in place, converting RGBA to BGRA or vice versa
+void swapRedBlue( ubyte* const data, const std::size_t pixelCount ) {
+    switch( getSIMDLevel() ) {
+#if defined( BS_SIMD_X86 )
+    case SIMDLevel::AVX2:  swapRedBlueAVX2( data, pixelCount );      return;
+    case SIMDLevel::SSSE3: swapRedBlueSSSE3( data, pixelCount );     return;
+#endif
+    default:               swapRedBlueScalar( data, 0, pixelCount ); return;
+    }
+}
+
+//Multiplies the color channels of RGBA8 pixels by their alpha in place, rounding to the nearest value
+void premultiplyAlpha( ubyte* const data, const std::size_t pixelCount ) {
+    switch( getSIMDLevel() ) {
+#if defined( BS_SIMD_X86 )
+    case SIMDLevel::AVX2:  premultiplyAlphaAVX2( data, pixelCount );      return;
+    case SIMDLevel::SSSE3: premultiplyAlphaSSSE3( data, pixelCount );     return;
+#endif
+    default:               premultiplyAlphaScalar( data, 0, pixelCount ); return;
+    }
+}
+
+//Divides the color channels of premultiplied RGBA8 pixels by their alpha in place, rounding to the nearest value.
+//Pixels with an alpha of 0 become transparent black.
+void unpremultiplyAlpha( ubyte* const data, const std::size_t pixelCount ) {
+    switch( getSIMDLevel() ) {
+#if defined( BS_SIMD_X86 )
+    case SIMDLevel::AVX2:
+    case SIMDLevel::SSSE3: unpremultiplyAlphaSSSE3( data, pixelCount );     return;
+#endif
+    default:               unpremultiplyAlphaScalar( data, 0, pixelCount ); return;
+    }
+}
+
+//Converts the color channels of RGBA8 pixels from sRGB to linear in place, leaving alpha alone.
+//This is a table lookup for every instruction set; it's faster than computing the curve in vectors.
+void convertSRGBToLinear( ubyte* const data, const std::size_t pixelCount ) {
+    const ubyte* const table = getSRGBToLinearTable();
+    for( std::size_t i = 0; i < pixelCount; ++i ) {
+        ubyte* const pixel = data + i * 4;
+        pixel[0] = table[ pixel[0] ];
+        pixel[1] = table[ pixel[1] ];
+        pixel[2] = table[ pixel[2] ];
+    }
+}
+
+/*
+flipRows
+--------
+
+Description:
+    Reverses the order of the rows of an image in place, flipping it vertically.
+
+Arguments:
+    data:      The first row of the image.
+    rowSize:   The size of each row, in bytes.
+    rowCount:  The number of rows.
+    stride:    The number of bytes from the start of one row to the next, or 0 if the rows are tightly packed.
+
+Returns:
+    N/A
+*/
+void flipRows( ubyte* const data, const std::size_t rowSize, const std::size_t rowCount, const std::size_t stride ) {
+    const std::size_t step  = stride != 0 ? stride : rowSize;
+    const SIMDLevel   level = getSIMDLevel();
+    for( std::size_t y = 0; y < rowCount / 2; ++y ) {
+        ubyte* const top    = data + y * step;
+        ubyte* const bottom = data + ( rowCount - 1 - y ) * step;
+        switch( level ) {
+#if defined( BS_SIMD_X86 )
+        case SIMDLevel::AVX2:  flipRowsAVX2( top, bottom, rowSize );      break;
+        case SIMDLevel::SSSE3: flipRowsSSSE3( top, bottom, rowSize );     break;
+#endif
+        default:               flipRowsScalar( top, bottom, 0, rowSize ); break;
+        }
+    }
+}
+
+
+
+
+} //namespace Brimstone
@@ -0,0 +1,516 @@
+/*
+util/Resample.cpp
+-----------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See util/Resample.hpp for more information.
+
+    The weights each destination pixel gives the source pixels around it are computed once per axis, ahead of time.
+    Source pixels past the edges of the image are clamped to the nearest edge pixel, so their weights are folded into it.
+
+    Each band of destination rows converts and horizontally filters the source rows it needs into a buffer of floats,
+    then sums those rows vertically into each destination row. The vertical sums work on whole rows at a time and are
+    vectorized with SSE or AVX2; the horizontal filter is vectorized with SSE for four-channel images.
+    Every version sums the same products in the same order, so the instruction set doesn't change the result.
+*/
+
+
+
+
+//Includes
+#include <brimstone/util/Resample.hpp>    //Header
+#include "SIMD.hpp"                       //BS_SIMD_X86, BS_TARGET, _mm_*, _mm256_*
+
+#include <brimstone/util/PixelOps.hpp>    //Brimstone::SIMDLevel, Brimstone::getSIMDLevel
+#include <brimstone/util/ThreadPool.hpp>  //Brimstone::ThreadPool
+#include <brimstone/Exception.hpp>        //Brimstone::NullPointerException, Brimstone::SizeException, Brimstone::BoundsException
+
+#include <algorithm>                      //std::min, std::max
+#include <atomic>                         //std::atomic
+#include <cmath>                          //std::sin, std::sqrt, std::pow, std::floor, std::ceil, std::abs
+#include <future>                         //std::future
+#include <vector>                         //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ubyte;
+using ::Brimstone::int32;
+using ::Brimstone::ResampleFilter;
+using ::Brimstone::SIMDLevel;
+
+//The source pixels that contribute to each destination pixel along one axis, and how much
+struct Contributions {
+    std::vector< int32 >       first;    //The first source pixel each destination pixel uses
+    std::vector< int32 >       count;    //The number of source pixels each destination pixel uses
+    std::vector< std::size_t > offset;   //Where the weights for each destination pixel start in weights
+    std::vector< float >       weights;  //The weight of each source pixel each destination pixel uses; these add up to 1
+};
+
+//Everything the bands of a resample share
+struct Job {
+    const ubyte*  source;
+    int32         sourceWidth;
+    std::size_t   sourceStride;
+    ubyte*        destination;
+    int32         destinationWidth;
+    std::size_t   destinationStride;
+    std::size_t   channels;
+    bool          srgb;
+    SIMDLevel     level;
+    Contributions horizontal;
+    Contributions vertical;
+};
+
+//Working memory for resampling bands, reused by each thread for every band it resamples
+struct Buffers {
+    std::vector< float > decoded;   //A source row, converted to floats
+    std::vector< float > filtered;  //The horizontally filtered source rows the band uses
+    std::vector< float > summed;    //A destination row before it's converted back to bytes
+};
+
+
+
+
+//Constants
+constexpr double PI            = 3.14159265358979323846;
+constexpr double KAISER_WIDTH  = 3.0;
+constexpr double KAISER_ALPHA  = 4.0;
+
+//The most destination rows a band resamples. More rows means less of the source is filtered horizontally twice
+//(by neighboring bands), but a larger buffer of filtered rows.
+constexpr int32  MAX_BAND_ROWS = 64;
+constexpr int32  MIN_BAND_ROWS = 8;
+
+
+
+
+//Functions
+double sinc( const double x ) {
+    if( x == 0.0 )
+        return 1.0;
+    return std::sin( PI * x ) / ( PI * x );
+}
+
+//The zeroth-order modified Bessel function of the first kind, used by the Kaiser window
+double besselI0( const double x ) {
+    const double q    = x * x / 4.0;
+    double       sum  = 1.0;
+    double       term = 1.0;
+    for( int k = 1; k < 50 && term > sum * 1e-12; ++k ) {
+        term *= q / ( (double)k * k );
+        sum  += term;
+    }
+    return sum;
+}
+
+//Returns how far from its center (in source pixels, before scaling) the given filter reaches
+double getSupport( const ResampleFilter filter ) {
+    switch( filter ) {
+    case ResampleFilter::BOX:      return 0.5;
+    case ResampleFilter::BILINEAR: return 1.0;
+    case ResampleFilter::LANCZOS3: return 3.0;
+    default:                       return KAISER_WIDTH;
+    }
+}
+
+double evaluate( const ResampleFilter filter, const double x ) {
+    switch( filter ) {
+    case ResampleFilter::BOX:
+        return ( x >= -0.5 && x < 0.5 ) ? 1.0 : 0.0;
+    case ResampleFilter::BILINEAR:
+        return std::max( 1.0 - std::abs( x ), 0.0 );
+    case ResampleFilter::LANCZOS3:
+        return std::abs( x ) < 3.0 ? sinc( x ) * sinc( x / 3.0 ) : 0.0;
+    default: {
+        const double t = x / KAISER_WIDTH;
+        if( std::abs( t ) >= 1.0 )
+            return 0.0;
+        return sinc( x ) * besselI0( KAISER_ALPHA * std::sqrt( 1.0 - t * t ) ) / besselI0( KAISER_ALPHA );
+    }
+    }
+}
+
+/*
+makeContributions
+-----------------
+
+Description:
+    Works out which source pixels contribute to each destination pixel along one axis, and how much.
+
+    Pixel centers are at half-integer coordinates, so destination pixel i is centered over ( i + 0.5 ) * sourceSize / destinationSize.
+    When shrinking, the filter is stretched to cover every source pixel the destination pixel covers.
+
+Arguments:
+    sourceSize:       The number of source pixels along the axis.
+    destinationSize:  The number of destination pixels along the axis.
+    filter:           The filter to resample with.
+
+Returns:
+    Contributions:    The contributions to each destination pixel.
+*/
+Contributions makeContributions( const int32 sourceSize, const int32 destinationSize, const ResampleFilter filter ) {
+    const double scale       = (double)sourceSize / destinationSize;
+    const double filterScale = std::max( scale, 1.0 );
+    const double support     = getSupport( filter ) * filterScale;
+
+    Contributions contributions;
+    contributions.first.resize( destinationSize );
+    contributions.count.resize( destinationSize );
+    contributions.offset.resize( destinationSize );
+
+    std::vector< double > weights;
+    for( int32 i = 0; i < destinationSize; ++i ) {
+        const double center = ( i + 0.5 ) * scale;
+        const int32  begin  = (int32)std::floor( center - support - 0.5 );
+        const int32  end    = (int32)std::ceil( center + support - 0.5 );
+        int32        first  = std::min( std::max( begin, 0 ), sourceSize - 1 );
+        int32        last   = std::min( std::max( end,   0 ), sourceSize - 1 );
+
+        //Pixels past the edges take the weights of the edge pixels they're clamped to
+        weights.assign( last - first + 1, 0.0 );
+        for( int32 j = begin; j <= end; ++j ) {
+            const int32 clamped = std::min( std::max( j, 0 ), sourceSize - 1 );
+            weights[ clamped - first ] += evaluate( filter, ( j + 0.5 - center ) / filterScale );
+        }
+
+        //Trim pixels that don't contribute anything from either end
+        int32 low  = 0;
+        int32 high = last - first;
+        while( low < high && weights[ low ] == 0.0 )
+            ++low;
+        while( high > low && weights[ high ] == 0.0 )
+            --high;
+        first += low;
+        last   = first + high - low;
+
+        double sum = 0.0;
+        for( int32 j = low; j <= high; ++j )
+            sum += weights[j];
+
+        contributions.first[i]  = first;
+        contributions.count[i]  = last - first + 1;
+        contributions.offset[i] = contributions.weights.size();
+        for( int32 j = low; j <= high; ++j )
+            contributions.weights.push_back( sum != 0.0 ? (float)( weights[j] / sum ) : 1.0f / ( high - low + 1 ) );
+    }
+    return contributions;
+}
+
+//Returns a table mapping each 8-bit value to a float in [0, 1]
+const float* getUnormToFloatTable() {
+    static const struct Table {
+        float values[256];
+        Table() {
+            for( int i = 0; i < 256; ++i )
+                values[i] = (float)( i / 255.0 );
+        }
+    } table;
+    return table.values;
+}
+
+//Returns a table mapping each 8-bit sRGB value to a linear float in [0, 1]
+const float* getSRGBToLinearTable() {
+    static const struct Table {
+        float values[256];
+        Table() {
+            for( int i = 0; i < 256; ++i ) {
+                const double c = i / 255.0;
+                values[i] = (float)( ( c <= 0.04045 ) ? c / 12.92 : std::pow( ( c + 0.055 ) / 1.055, 2.4 ) );
+            }
+        }
+    } table;
+    return table.values;
+}
+
+//Returns a table mapping linear values in [0, 1], quantized to 16 bits, to the nearest 8-bit sRGB value
+const ubyte* getLinearToSRGBTable() {
+    static const struct Table {
+        ubyte values[65536];
+        Table() {
+            for( int i = 0; i < 65536; ++i ) {
+                const double l = i / 65535.0;
+                const double c = ( l <= 0.0031308 ) ? l * 12.92 : 1.055 * std::pow( l, 1.0 / 2.4 ) - 0.055;
+                values[i] = (ubyte)( c * 255.0 + 0.5 );
+            }
+        }
+    } table;
+    return table.values;
+}
+
+//Converts a row of pixels to floats. The color of four-channel pixels is multiplied by their alpha.
+void decodeRow( const ubyte* const source, const int32 width, const std::size_t channels, const bool srgb, float* const out ) {
+    const float* const unorm = getUnormToFloatTable();
+    const float* const color = srgb ? getSRGBToLinearTable() : unorm;
+    if( channels == 4 ) {
+        for( int32 x = 0; x < width; ++x ) {
+            const ubyte* const pixel = source + x * 4;
+            const float        a     = unorm[ pixel[3] ];
+            out[ x * 4     ] = color[ pixel[0] ] * a;
+            out[ x * 4 + 1 ] = color[ pixel[1] ] * a;
+            out[ x * 4 + 2 ] = color[ pixel[2] ] * a;
+            out[ x * 4 + 3 ] = a;
+        }
+    } else {
+        for( std::size_t i = 0; i < width * channels; ++i )
+            out[i] = color[ source[i] ];
+    }
+}
+
+ubyte encodeUnorm( const float value ) {
+    return (ubyte)( std::min( std::max( value, 0.0f ), 1.0f ) * 255.0f + 0.5f );
+}
+
+ubyte encodeSRGB( const float value ) {
+    return getLinearToSRGBTable()[ (int)( std::min( std::max( value, 0.0f ), 1.0f ) * 65535.0f + 0.5f ) ];
+}
+
+//Converts a row of floats back to pixels, undoing decodeRow()
+void encodeRow( const float* const row, const int32 width, const std::size_t channels, const bool srgb, ubyte* const out ) {
+    if( channels == 4 ) {
+        for( int32 x = 0; x < width; ++x ) {
+            const float* const pixel = row + x * 4;
+            const float        a     = std::min( pixel[3], 1.0f );
+            const float        scale = a > 0.0f ? 1.0f / a : 0.0f;
+            for( int c = 0; c < 3; ++c )
+                out[ x * 4 + c ] = srgb ? encodeSRGB( pixel[c] * scale ) : encodeUnorm( pixel[c] * scale );
+            out[ x * 4 + 3 ] = encodeUnorm( a );
+        }
+    } else {
+        for( std::size_t i = 0; i < width * channels; ++i )
+            out[i] = srgb ? encodeSRGB( row[i] ) : encodeUnorm( row[i] );
+    }
+}
+
+//Filters a row of source pixels horizontally into a row of destination pixels
+void filterRowScalar( const float* const row, const Contributions& contributions, const int32 width, const std::size_t channels, float* const out ) {
+    for( int32 x = 0; x < width; ++x ) {
+        const float* const weights = &contributions.weights[ contributions.offset[x] ];
+        const float* const source  = row + contributions.first[x] * channels;
+        const int32        count   = contributions.count[x];
+        for( std::size_t c = 0; c < channels; ++c ) {
+            float sum = 0.0f;
+            for( int32 k = 0; k < count; ++k )
+                sum = sum + weights[k] * source[ k * channels + c ];
+            out[ x * channels + c ] = sum;
+        }
+    }
+}
+
+//Sums the given rows of floats, weighting each one, into out. Each element adds up its products in row order.
+void sumRowsScalar( const float* const* const rows, const float* const weights, const int32 count, const std::size_t begin, const std::size_t end,
+                    float* const out ) {
+    for( std::size_t i = begin; i < end; ++i ) {
+        float sum = 0.0f;
+        for( int32 k = 0; k < count; ++k )
+            sum = sum + weights[k] * rows[k][i];
+        out[i] = sum;
+    }
+}
+
+
+
+
+#if defined( BS_SIMD_X86 )
+//Each four-channel pixel fits in one vector
+BS_TARGET( "ssse3" )
+void filterRowSSSE3( const float* const row, const Contributions& contributions, const int32 width, float* const out ) {
+    for( int32 x = 0; x < width; ++x ) {
+        const float* const weights = &contributions.weights[ contributions.offset[x] ];
+        const float* const source  = row + contributions.first[x] * 4;
+        const int32        count   = contributions.count[x];
+        __m128 sum = _mm_setzero_ps();
+        for( int32 k = 0; k < count; ++k )
+            sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( weights[k] ), _mm_loadu_ps( source + k * 4 ) ) );
+        _mm_storeu_ps( out + x * 4, sum );
+    }
+}
+
+BS_TARGET( "ssse3" )
+void sumRowsSSSE3( const float* const* const rows, const float* const weights, const int32 count, const std::size_t size, float* const out ) {
+    std::size_t i = 0;
+    for( ; i + 4 <= size; i += 4 ) {
+        __m128 sum = _mm_setzero_ps();
+        for( int32 k = 0; k < count; ++k )
+            sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( weights[k] ), _mm_loadu_ps( rows[k] + i ) ) );
+        _mm_storeu_ps( out + i, sum );
+    }
+    sumRowsScalar( rows, weights, count, i, size, out );
+}
+
+//Multiplies and adds separately instead of using FMA, so the results match the other versions exactly
+BS_TARGET( "avx2" )
+void sumRowsAVX2( const float* const* const rows, const float* const weights, const int32 count, const std::size_t size, float* const out ) {
+    std::size_t i = 0;
+    for( ; i + 8 <= size; i += 8 ) {
+        __m256 sum = _mm256_setzero_ps();
+        for( int32 k = 0; k < count; ++k )
+            sum = _mm256_add_ps( sum, _mm256_mul_ps( _mm256_set1_ps( weights[k] ), _mm256_loadu_ps( rows[k] + i ) ) );
+        _mm256_storeu_ps( out + i, sum );
+    }
+    sumRowsScalar( rows, weights, count, i, size, out );
+}
+#endif //BS_SIMD_X86
+
+void filterRow( const Job& job, const float* const row, float* const out ) {
+#if defined( BS_SIMD_X86 )
+    if( job.channels == 4 && job.level != SIMDLevel::NONE )
+        return filterRowSSSE3( row, job.horizontal, job.destinationWidth, out );
+#endif
+    filterRowScalar( row, job.horizontal, job.destinationWidth, job.channels, out );
+}
+
+void sumRows( const Job& job, const float* const* const rows, const float* const weights, const int32 count, const std::size_t size, float* const out ) {
+    switch( job.level ) {
+#if defined( BS_SIMD_X86 )
+    case SIMDLevel::AVX2:  sumRowsAVX2( rows, weights, count, size, out );     return;
+    case SIMDLevel::SSSE3: sumRowsSSSE3( rows, weights, count, size, out );    return;
+#endif
+    default:               sumRowsScalar( rows, weights, count, 0, size, out ); return;
+    }
+}
+
+//Resamples destination rows [begin, end)
+void resampleBand( const Job& job, const int32 begin, const int32 end, Buffers& buffers ) {
+    const Contributions& vertical  = job.vertical;
+    const std::size_t    rowLength = job.destinationWidth * job.channels;
+
+    //Filter every source row the band uses horizontally
+    int32 first = vertical.first[ begin ];
+    int32 last  = first;
+    for( int32 y = begin; y < end; ++y ) {
+        first = std::min( first, vertical.first[y] );
+        last  = std::max( last,  vertical.first[y] + vertical.count[y] );
+    }
+    buffers.decoded.resize( job.sourceWidth * job.channels );
+    buffers.filtered.resize( ( last - first ) * rowLength );
+    buffers.summed.resize( rowLength );
+    for( int32 y = first; y < last; ++y ) {
+        decodeRow( job.source + y * job.sourceStride, job.sourceWidth, job.channels, job.srgb, buffers.decoded.data() );
+        filterRow( job, buffers.decoded.data(), &buffers.filtered[ ( y - first ) * rowLength ] );
+    }
+
+    //Then filter them vertically into each destination row
+    std::vector< const float* > rows;
+    for( int32 y = begin; y < end; ++y ) {
+        rows.clear();
+        for( int32 k = 0; k < vertical.count[y]; ++k )
+            rows.push_back( &buffers.filtered[ ( vertical.first[y] + k - first ) * rowLength ] );
+        sumRows( job, rows.data(), &vertical.weights[ vertical.offset[y] ], vertical.count[y], rowLength, buffers.summed.data() );
+        encodeRow( buffers.summed.data(), job.destinationWidth, job.channels, job.srgb, job.destination + y * job.destinationStride );
+    }
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+/*
+resample
+--------
+
+Description:
+    Resizes an image with the given filter.
+
+Arguments:
+    source:              The first row of the image to resample.
+    sourceWidth:         The width of the source image.
+    sourceHeight:        The height of the source image.
+    sourceStride:        The number of bytes from the start of one source row to the next, or 0 if the rows are tightly packed.
+    destination:         The first row of the image to write. It must not overlap the source image.
+    destinationWidth:    The width to resize the image to.
+    destinationHeight:   The height to resize the image to.
+    destinationStride:   The number of bytes from the start of one destination row to the next, or 0 if the rows are tightly packed.
+                         Any padding between rows is left alone.
+    channels:            The number of 8-bit channels in each pixel (1 to 4). The fourth channel is alpha.
+    filter:              The filter to resample with.
+    srgb:                If true, every channel except alpha is sRGB-encoded, and is filtered in linear space.
+    pool:                If this isn't nullptr, bands of the image are resampled on this pool's threads as well as the calling thread.
+                         This must not be called from one of the pool's threads.
+
+Returns:
+    N/A
+
+Throws:
+    NullPointerException:  If source or destination is nullptr.
+    BoundsException:       If channels isn't between 1 and 4.
+    SizeException:         If any width or height isn't positive, or a stride is smaller than a row.
+*/
+void resample( const ubyte* const source, const int32 sourceWidth, const int32 sourceHeight, const std::size_t sourceStride,
+               ubyte* const destination, const int32 destinationWidth, const int32 destinationHeight, const std::size_t destinationStride,
+               const std::size_t channels, const ResampleFilter filter, const bool srgb, ThreadPool* const pool ) {
+    if( source == nullptr || destination == nullptr )
+        throw NullPointerException();
+    if( channels < 1 || channels > 4 )
+        throw BoundsException();
+    if( sourceWidth <= 0 || sourceHeight <= 0 || destinationWidth <= 0 || destinationHeight <= 0 )
+        throw SizeException();
+
+    const std::size_t sourceRow      = sourceWidth * channels;
+    const std::size_t destinationRow = destinationWidth * channels;
+    if( ( sourceStride != 0 && sourceStride < sourceRow ) || ( destinationStride != 0 && destinationStride < destinationRow ) )
+        throw SizeException();
+
+    Job job;
+    job.source            = source;
+    job.sourceWidth       = sourceWidth;
+    job.sourceStride      = sourceStride != 0 ? sourceStride : sourceRow;
+    job.destination       = destination;
+    job.destinationWidth  = destinationWidth;
+    job.destinationStride = destinationStride != 0 ? destinationStride : destinationRow;
+    job.channels          = channels;
+    job.srgb              = srgb;
+    job.level             = getSIMDLevel();
+    job.horizontal        = makeContributions( sourceWidth,  destinationWidth,  filter );
+    job.vertical          = makeContributions( sourceHeight, destinationHeight, filter );
+
+    //Give every thread at least one band, as long as the bands don't get too small
+    const int32 threads   = pool != nullptr ? (int32)pool->getThreadCount() + 1 : 1;
+    const int32 bandRows  = std::max( std::min( MAX_BAND_ROWS, ( destinationHeight + threads - 1 ) / threads ), MIN_BAND_ROWS );
+    const int32 bandCount = ( destinationHeight + bandRows - 1 ) / bandRows;
+
+    std::atomic< int32 > next( 0 );
+    auto work = [&job, &next, bandRows, bandCount, destinationHeight]() {
+        Buffers buffers;
+        for( int32 band = next++; band < bandCount; band = next++ )
+            resampleBand( job, band * bandRows, std::min( ( band + 1 ) * bandRows, destinationHeight ), buffers );
+    };
+
+    std::vector< std::future< void > > helpers;
+    for( int32 i = 1; i < std::min( threads, bandCount ); ++i )
+        helpers.push_back( pool->submit( work ) );
+
+    //The helpers refer to this frame, so they have to finish before anything is thrown from here
+    try {
+        work();
+    } catch( ... ) {
+        for( std::future< void >& helper : helpers )
+            helper.wait();
+        throw;
+    }
+    for( std::future< void >& helper : helpers )
+        helper.wait();
+    for( std::future< void >& helper : helpers )
+        helper.get();
+}
+
+
+
+
+} //namespace Brimstone
@@ -0,0 +1,42 @@
+/*
+util/SIMD.hpp
+-------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Includes the intrinsics that vectorized code in the engine uses, and defines macros for using them.
+
+    BS_SIMD_X86 is defined when building for x86 or x86-64, where SSSE3 and AVX2 versions of functions are compiled.
+    BS_TARGET( isa ) marks a function as using the given instruction set (e.g. "avx2"), so it can be compiled
+    without building the whole engine for that instruction set. It must only be called after checking
+    getSIMDLevel() (see util/PixelOps.hpp).
+*/
+#ifndef BS_UTIL_SIMD_HPP
+#define BS_UTIL_SIMD_HPP
+
+
+
+
+//Includes
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#define BS_SIMD_X86
+#include <immintrin.h>  //_mm_*, _mm256_*
+#if defined( _MSC_VER )
+#include <intrin.h>     //__cpuid, __cpuidex, _xgetbv
+#endif
+#endif
+
+
+
+
+//Macros
+#if defined( BS_SIMD_X86 ) && defined( __GNUC__ )
+#define BS_TARGET( isa ) __attribute__(( target( isa ) ))
+#else
+#define BS_TARGET( isa )
+#endif
+
+
+
+
+#endif //BS_UTIL_SIMD_HPP
@@ -0,0 +1,147 @@
+/*
+util/ThreadPool.cpp
+-------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See ThreadPool.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/util/ThreadPool.hpp>  //Header
+
+#include <algorithm>                      //std::max
+
+
+
+
+namespace Brimstone {
+
+
+
+
+ThreadPool::ThreadPool() :
+    ThreadPool( getDefaultThreadCount() ) {
+}
+
+/*
+ThreadPool::ThreadPool
+----------------------
+
+Description:
+    Starts a pool with the given number of worker threads.
+
+Arguments:
+    threadCount:  The number of worker threads to start. At least one thread is always started.
+*/
+ThreadPool::ThreadPool( const std::size_t threadCount ) :
+    m_active( 0 ),
+    m_stopping( false ) {
+
+    const std::size_t count = std::max( threadCount, (std::size_t)1 );
+    m_threads.reserve( count );
+    for( std::size_t i = 0; i < count; ++i )
+        m_threads.emplace_back( &ThreadPool::run, this );
+}
+
+/*
+ThreadPool::~ThreadPool
+-----------------------
+
+Description:
+    Runs any tasks that are still queued, then stops the worker threads.
+*/
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard< std::mutex > l( m_mutex );
+        m_stopping = true;
+    }
+    m_taskAvailable.notify_all();
+
+    for( std::thread& thread : m_threads )
+        thread.join();
+}
+
+void ThreadPool::post( std::function< void() > task ) {
+    {
+        std::lock_guard< std::mutex > l( m_mutex );
+        m_tasks.push_back( std::move( task ) );
+    }
+    m_taskAvailable.notify_one();
+}
+
+/*
+ThreadPool::wait
+----------------
+
+Description:
+    Blocks until every queued task has finished running.
+    Must not be called from one of the pool's own threads.
+
+Arguments:
+    N/A
+
+Returns:
+    N/A
+*/
+void ThreadPool::wait() {
+    std::unique_lock< std::mutex > l( m_mutex );
+    m_idle.wait( l, [this]() { return m_tasks.empty() && m_active == 0; } );
+}
+
+std::size_t ThreadPool::getThreadCount() const {
+    return m_threads.size();
+}
+
+std::size_t ThreadPool::getPendingCount() const {
+    std::lock_guard< std::mutex > l( m_mutex );
+    return m_tasks.size() + m_active;
+}
+
+/*
+ThreadPool::getDefaultThreadCount
+---------------------------------
+
+Description:
+    Returns the number of threads a pool should use by default: one fewer than the number of hardware threads,
+    leaving one for the thread that submits work (typically the main / rendering thread).
+
+Arguments:
+    N/A
+
+Returns:
+    std::size_t:  The default number of threads (at least 1).
+*/
+std::size_t ThreadPool::getDefaultThreadCount() {
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    return ( hardware > 1 ) ? hardware - 1 : 1;
+}
+
+void ThreadPool::run() {
+    std::unique_lock< std::mutex > l( m_mutex );
+    while( true ) {
+        m_taskAvailable.wait( l, [this]() { return m_stopping || !m_tasks.empty(); } );
+        if( m_tasks.empty() )
+            return;
+
+        std::function< void() > task = std::move( m_tasks.front() );
+        m_tasks.pop_front();
+        ++m_active;
+
+        l.unlock();
+        task();
+        l.lock();
+
+        --m_active;
+        if( m_tasks.empty() && m_active == 0 )
+            m_idle.notify_all();
+    }
+}
+
+
+
+
+} //namespace Brimstone
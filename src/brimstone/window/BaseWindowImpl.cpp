@@ -33,12 +33,43 @@ BaseWindowImpl::BaseWindowImpl() :
     m_mouseCapture( false ),
     m_cursorTrapped( false ),
     m_cursorVisible( true ),
-    m_keepCursorCentered( false )
+    m_keepCursorCentered( false ),
+    m_rawMouseInput( false ),
+    m_coalesceEvents( false ),
+    m_coalescedEvents( 0 )
 {
 }
 
 void BaseWindowImpl::pushEvent( const WindowEvent& eventIn ) {
-    m_eventQueue.push( eventIn );
+    if( !m_coalesceEvents )
+        m_eventQueue.push( eventIn );
+    else if( coalesceWindowEvent( m_eventQueue, eventIn ) )
+        ++m_coalescedEvents;
+}
+
+void BaseWindowImpl::setEventQueueCapacity( const std::size_t capacity, const RingBufferOverflow overflow ) {
+    m_eventQueue.setOverflow( overflow );
+    m_eventQueue.setCapacity( capacity );
+}
+
+std::size_t BaseWindowImpl::getEventQueueCapacity() const {
+    return m_eventQueue.capacity();
+}
+
+uint64 BaseWindowImpl::getDroppedEventCount() const {
+    return m_eventQueue.getDroppedCount();
+}
+
+void BaseWindowImpl::setEventCoalescing( const bool coalesce ) {
+    m_coalesceEvents = coalesce;
+}
+
+bool BaseWindowImpl::getEventCoalescing() const {
+    return m_coalesceEvents;
+}
+
+uint64 BaseWindowImpl::getCoalescedEventCount() const {
+    return m_coalescedEvents;
 }
 
 void BaseWindowImpl::setTitle( const ustring& title ) {
@@ -173,6 +204,14 @@ bool BaseWindowImpl::getKeepCursorCentered() const {
     return m_keepCursorCentered;
 }
 
+void BaseWindowImpl::setRawMouseInput( const bool rawMouseInput ) {
+    m_rawMouseInput = rawMouseInput;
+}
+
+bool BaseWindowImpl::getRawMouseInput() const {
+    return m_rawMouseInput;
+}
+
 
 
 
@@ -16,9 +16,10 @@ Description:
 #include <brimstone/window/WindowEvent.hpp>  //Brimstone::WindowEvent
 #include <brimstone/Point.hpp>               //Brimstone::Point2i
 #include <brimstone/Bounds.hpp>              //Brimstone::Bounds2i
-#include <brimstone/types.hpp>               //Brimstone::ustring
+#include <brimstone/types.hpp>               //Brimstone::ustring, Brimstone::uint64
+#include <brimstone/util/RingBuffer.hpp>     //Brimstone::RingBuffer, Brimstone::RingBufferOverflow
 
-#include <queue>                             //std::queue
+#include <cstddef>                           //std::size_t
 
 
 
@@ -34,6 +35,14 @@ public:
 
     void            pushEvent( const WindowEvent& eventIn );
 
+    void            setEventQueueCapacity( const std::size_t capacity, const RingBufferOverflow overflow );
+    std::size_t     getEventQueueCapacity() const;
+    uint64          getDroppedEventCount() const;
+
+    void            setEventCoalescing( const bool coalesce );
+    bool            getEventCoalescing() const;
+    uint64          getCoalescedEventCount() const;
+
     void            setTitle( const ustring& title );
     ustring         getTitle() const;
 
@@ -83,6 +92,9 @@ public:
 
     void            setKeepCursorCentered( const bool keepCursorCentered );
     bool            getKeepCursorCentered() const;
+
+    void            setRawMouseInput( const bool rawMouseInput );
+    bool            getRawMouseInput() const;
 protected:
     ustring                     m_title;
     Point2i                     m_cursorPos;
@@ -100,8 +112,11 @@ protected:
     bool                        m_cursorTrapped;
     bool                        m_cursorVisible;
     bool                        m_keepCursorCentered;
+    bool                        m_rawMouseInput;
+    bool                        m_coalesceEvents;
+    uint64                      m_coalescedEvents;
 
-    std::queue< WindowEvent >   m_eventQueue;
+    RingBuffer< WindowEvent >   m_eventQueue;
 };
 
 
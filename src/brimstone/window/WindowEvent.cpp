@@ -0,0 +1,144 @@
+/*
+window/WindowEvent.cpp
+----------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See WindowEvent.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include <brimstone/window/WindowEvent.hpp>  //Header
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::WindowEvent;
+using ::Brimstone::WindowEventType;
+using ::Brimstone::WindowEventMouseRaw;
+
+
+
+
+//Functions
+bool isGeometryEvent( const WindowEventType type ) {
+    return type == WindowEventType::Move || type == WindowEventType::Resize;
+}
+
+//Returns true for the events that are only merged with the event at the back of the queue
+bool isMouseEvent( const WindowEventType type ) {
+    return type == WindowEventType::MouseMove || type == WindowEventType::MouseRawMove || type == WindowEventType::MouseSmoothScroll;
+}
+
+//Adds the motion or scrolling in from to into
+void mergeRaw( WindowEventMouseRaw& into, const WindowEventMouseRaw& from ) {
+    into.dx    += from.dx;
+    into.dy    += from.dy;
+    into.time   = from.time;
+    into.count += from.count;
+}
+
+//Merges event into queued, which is an event of the same type that happened before it. Returns false if they can't be merged.
+bool merge( WindowEvent& queued, const WindowEvent& event ) {
+    switch( event.type ) {
+    case WindowEventType::MouseMove: {
+        //Moves made with different modifier keys held mean different things (e.g. a shift-drag), so they're kept apart
+        const auto& from = event.mouseMove;
+        auto&       into = queued.mouseMove;
+        if( from.ctrl != into.ctrl || from.alt != into.alt || from.shift != into.shift || from.system != into.system )
+            return false;
+        into.x      = from.x;
+        into.y      = from.y;
+        into.dx    += from.dx;
+        into.dy    += from.dy;
+        into.count += from.count;
+    } break;
+    case WindowEventType::MouseRawMove:
+        mergeRaw( queued.mouseRaw, event.mouseRaw );
+        break;
+    case WindowEventType::MouseSmoothScroll:
+        mergeRaw( queued.mouseSmoothScroll, event.mouseSmoothScroll );
+        break;
+    case WindowEventType::Move:
+        queued.move.x      = event.move.x;
+        queued.move.y      = event.move.y;
+        queued.move.count += event.move.count;
+        break;
+    case WindowEventType::Resize:
+        queued.resize.w      = event.resize.w;
+        queued.resize.h      = event.resize.h;
+        queued.resize.count += event.resize.count;
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace Brimstone {
+
+
+
+
+/*
+coalesceWindowEvent
+-------------------
+
+Description:
+    Adds an event to the back of a queue. If it's a MouseMove, MouseRawMove, MouseSmoothScroll, Move or Resize event,
+    it may be merged into an event of the same type that's still in the queue instead:
+        * A MouseMove is merged into the event at the back of the queue, if that's a MouseMove made with the same modifier keys.
+          Moves are never merged across other events, so they stay in order with clicks and key presses.
+        * Likewise, a MouseRawMove or MouseSmoothScroll is merged into the event at the back of the queue, if that's the same type.
+        * A Move or Resize is merged into the latest event of the same type, as long as the only events after it are Moves and Resizes.
+          A window being dragged by a corner alternates between the two, and neither changes what the other means.
+    The merged event keeps the first event's starting point, and takes the new event's position, size or time;
+    its movement and count are the sums of both events'.
+
+Arguments:
+    queue:  The queue to add the event to.
+    event:  The event to add.
+
+Returns:
+    bool:   true if the event was merged into one in the queue, false if it was pushed onto the back of it.
+*/
+bool coalesceWindowEvent( RingBuffer< WindowEvent >& queue, const WindowEvent& event ) {
+    const bool geometry = isGeometryEvent( event.type );
+    if( isMouseEvent( event.type ) || geometry ) {
+        for( std::size_t i = queue.size(); i > 0; --i ) {
+            WindowEvent& queued = queue[ i - 1 ];
+            if( queued.type == event.type ) {
+                if( merge( queued, event ) )
+                    return true;
+                break;
+            }
+            if( !geometry || !isGeometryEvent( queued.type ) )
+                break;
+        }
+    }
+
+    queue.push( event );
+    return false;
+}
+
+
+
+
+} //namespace Brimstone
@@ -0,0 +1,78 @@
+/*
+windows/WindowsMappedFile.cpp
+-----------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See WindowsMappedFile.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include "WindowsMappedFile.hpp"  //Header
+#include "WindowsHeader.hpp"      //HANDLE, CreateFileW, CreateFileMappingW, MapViewOfFile, UnmapViewOfFile, CloseHandle, etc.
+#include "WindowsUtil.hpp"        //Brimstone::Private::utf8to16
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+WindowsMappedFile::WindowsMappedFile() :
+    m_data( nullptr ),
+    m_size( 0 ) {
+}
+
+WindowsMappedFile::~WindowsMappedFile() {
+    if( m_data != nullptr )
+        UnmapViewOfFile( m_data );
+}
+
+bool WindowsMappedFile::open( const ustring& filename ) {
+    const HANDLE file = CreateFileW( utf8to16( filename ).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+    if( file == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER size;
+    if( !GetFileSizeEx( file, &size ) ) {
+        CloseHandle( file );
+        return false;
+    }
+
+    //Empty files can't be mapped, but there's nothing to map anyway
+    if( size.QuadPart > 0 ) {
+        const HANDLE mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        const void*  data    = mapping != nullptr ? MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) : nullptr;
+
+        //The view keeps its own references to the mapping and the file
+        if( mapping != nullptr )
+            CloseHandle( mapping );
+        if( data == nullptr ) {
+            CloseHandle( file );
+            return false;
+        }
+        m_data = data;
+        m_size = (std::size_t)size.QuadPart;
+    }
+
+    CloseHandle( file );
+    return true;
+}
+
+const ubyte* WindowsMappedFile::getData() const {
+    return static_cast< const ubyte* >( m_data );
+}
+
+std::size_t WindowsMappedFile::getSize() const {
+    return m_size;
+}
+
+
+
+
+} //namespace Brimstone::Private
@@ -0,0 +1,53 @@
+/*
+windows/WindowsMappedFile.hpp
+-----------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    WindowsMappedFile is defined here.
+    It maps files into memory with CreateFileMapping() and MapViewOfFile().
+*/
+#ifndef BS_WINDOWS_WINDOWSMAPPEDFILE_HPP
+#define BS_WINDOWS_WINDOWSMAPPEDFILE_HPP
+
+
+
+
+//Includes
+#include <cstddef>              //std::size_t
+
+#include <brimstone/types.hpp>  //Brimstone::ustring, Brimstone::ubyte
+
+
+
+
+namespace Brimstone::Private {
+
+
+
+
+class WindowsMappedFile {
+public:
+    WindowsMappedFile();
+    WindowsMappedFile( const WindowsMappedFile& toCopy ) = delete;
+    WindowsMappedFile& operator =( const WindowsMappedFile& toCopy ) = delete;
+    ~WindowsMappedFile();
+
+    bool         open( const ustring& filename );
+
+    const ubyte* getData() const;
+    std::size_t  getSize() const;
+private:
+    const void* m_data;
+    std::size_t m_size;
+};
+
+
+
+
+} //namespace Brimstone::Private
+
+
+
+
+#endif //BS_WINDOWS_WINDOWSMAPPEDFILE_HPP
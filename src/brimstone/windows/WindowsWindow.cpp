@@ -520,9 +520,32 @@ bool WindowsWindow::peekEvent( WindowEvent& eventOut ) {
     }
 
     //Pop a message from the queue
-    eventOut = m_eventQueue.front();
-    m_eventQueue.pop();
-    return true;
+    return m_eventQueue.pop( eventOut );
+}
+
+/*
+WindowsWindow::pollEvents
+-------------------------
+
+Description:
+    Processes all messages that are currently in the message queue for the thread that called this function,
+    then removes up to max Brimstone WindowEvents from the front of the window's event queue.
+    A frame's worth of input can be drained with a single call, without blocking or allocating.
+
+Arguments:
+    eventsOut:      The events are output here, oldest first. Must have room for max events.
+    max:            The most events to output.
+
+Returns:
+    std::size_t:    The number of events output.
+*/
+std::size_t WindowsWindow::pollEvents( WindowEvent* const eventsOut, const std::size_t max ) {
+    MSG msg;
+    while( PeekMessage( &msg, nullptr, 0, 0, PM_REMOVE ) ) {
+        TranslateMessage( &msg );
+        DispatchMessage( &msg );
+    }
+    return m_eventQueue.pop( eventsOut, max );
 }
 
 /*
@@ -563,9 +586,7 @@ bool WindowsWindow::getEvent( WindowEvent& eventOut ) {
     }
 
     //Pop a message from the queue
-    eventOut = m_eventQueue.front();
-    m_eventQueue.pop();
-    return true;
+    return m_eventQueue.pop( eventOut );
 }
 
 void WindowsWindow::setResizable( const bool resizable ) {
@@ -806,6 +827,8 @@ LRESULT WindowsWindow::windowProc( UINT message, WPARAM wParam, LPARAM lParam )
         WindowEvent e;
 
         auto p = getCursorPos( lParam );
+        const int dx = p.x - m_cursorPos.x;
+        const int dy = p.y - m_cursorPos.y;
         m_cursorPos = p;
 
         //If the mouse wasn't previously hovering over this window, set it as hovering and push a MouseEnter event:
@@ -815,8 +838,13 @@ LRESULT WindowsWindow::windowProc( UINT message, WPARAM wParam, LPARAM lParam )
 
             //TODO: Needs testing and probably more work
             e.type = WindowEvent::MouseEnter;
-            e.mouseMove.x = p.x;
-            e.mouseMove.y = p.y;
+            e.mouseMove.x      = p.x;
+            e.mouseMove.y      = p.y;
+            e.mouseMove.firstX = p.x;
+            e.mouseMove.firstY = p.y;
+            e.mouseMove.dx     = 0;
+            e.mouseMove.dy     = 0;
+            e.mouseMove.count  = 1;
             //TODO
             e.mouseMove.ctrl   = false;
             e.mouseMove.alt    = false;
@@ -826,9 +854,14 @@ LRESULT WindowsWindow::windowProc( UINT message, WPARAM wParam, LPARAM lParam )
             pushEvent( e );
         }
 
-        e.type        = WindowEventType::MouseMove;
-        e.mouseMove.x = p.x;
-        e.mouseMove.y = p.y;
+        e.type             = WindowEventType::MouseMove;
+        e.mouseMove.x      = p.x;
+        e.mouseMove.y      = p.y;
+        e.mouseMove.firstX = p.x;
+        e.mouseMove.firstY = p.y;
+        e.mouseMove.dx     = dx;
+        e.mouseMove.dy     = dy;
+        e.mouseMove.count  = 1;
         //TODO
         e.mouseMove.ctrl   = false;
         e.mouseMove.alt    = false;
@@ -1094,8 +1127,13 @@ LRESULT WindowsWindow::windowProc( UINT message, WPARAM wParam, LPARAM lParam )
         //Push MouseLeave event:
         WindowEvent e;
         e.type = WindowEvent::MouseLeave;
-        e.mouseMove.x = m_cursorPos.x;
-        e.mouseMove.y = m_cursorPos.y;
+        e.mouseMove.x      = m_cursorPos.x;
+        e.mouseMove.y      = m_cursorPos.y;
+        e.mouseMove.firstX = m_cursorPos.x;
+        e.mouseMove.firstY = m_cursorPos.y;
+        e.mouseMove.dx     = 0;
+        e.mouseMove.dy     = 0;
+        e.mouseMove.count  = 1;
         //TODO
         e.mouseMove.ctrl   = false;
         e.mouseMove.alt    = false;
@@ -1128,9 +1166,12 @@ LRESULT WindowsWindow::windowProc( UINT message, WPARAM wParam, LPARAM lParam )
         m_bounds.setPosition( pos );
 
         WindowEvent e;
-        e.type = WindowEventType::Move;
-        e.move.x = pos.x;
-        e.move.y = pos.y;
+        e.type        = WindowEventType::Move;
+        e.move.x      = pos.x;
+        e.move.y      = pos.y;
+        e.move.firstX = pos.x;
+        e.move.firstY = pos.y;
+        e.move.count  = 1;
 
         pushEvent( e );
 
@@ -1146,9 +1187,12 @@ LRESULT WindowsWindow::windowProc( UINT message, WPARAM wParam, LPARAM lParam )
         m_bounds.setSize( size );
 
         WindowEvent e;
-        e.type = WindowEventType::Resize;
-        e.resize.w = size.w;
-        e.resize.h = size.h;
+        e.type          = WindowEventType::Resize;
+        e.resize.w      = size.w;
+        e.resize.h      = size.h;
+        e.resize.firstW = size.w;
+        e.resize.firstH = size.h;
+        e.resize.count  = 1;
 
         pushEvent( e );
 
@@ -51,6 +51,7 @@ public:
 
     bool            peekEvent( WindowEvent& eventOut );
     bool            getEvent( WindowEvent& eventOut );
+    std::size_t     pollEvents( WindowEvent* const eventsOut, const std::size_t max );
 
     void            setTitle( const ustring& title );
     
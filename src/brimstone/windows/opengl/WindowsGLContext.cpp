@@ -178,6 +178,30 @@ void WindowsGLContext::swapBuffers() {
         throwWindowsException();
 }
 
+/*
+WindowsGLContext::getProcAddress
+--------------------------------
+
+Description:
+    Loads an OpenGL function that isn't loaded by gll (e.g. functions from extensions that aren't part of core OpenGL).
+    A context must be active.
+
+Arguments:
+    name:   The name of the function.
+
+Returns:
+    void*:  A pointer to the function, or nullptr if it couldn't be loaded.
+*/
+void* WindowsGLContext::getProcAddress( const char* const name ) {
+    PROC proc = wglGetProcAddress( name );
+
+    //wglGetProcAddress can return these values instead of nullptr on failure
+    const INT_PTR value = (INT_PTR)proc;
+    if( value == 0 || value == 1 || value == 2 || value == 3 || value == -1 )
+        return nullptr;
+    return (void*)proc;
+}
+
 
 
 
@@ -57,6 +57,8 @@ public:
     bool getVSync() const;
     
     void swapBuffers();
+
+    static void* getProcAddress( const char* const name );
 private:
     void init( HWND hwnd );
     void destroyContext();
@@ -0,0 +1,73 @@
+/*
+Benchmark.cpp
+-------------
+Copyright (c) 2024, theJ89
+
+Description:
+    See Benchmark.hpp for more information.
+*/
+
+
+
+
+//Includes
+#include "Benchmark.hpp"  //Header
+
+#include <iostream>       //std::cout
+#include <iomanip>        //std::setw, std::setprecision
+#include <ctime>          //std::clock, CLOCKS_PER_SEC
+#include <chrono>         //std::chrono::steady_clock
+
+
+
+
+namespace UnitTest {
+
+
+
+
+std::set< Benchmark* >& getBenchmarks() {
+    static std::set< Benchmark* > benchmarks;
+    return benchmarks;
+}
+
+Benchmark::Benchmark( const std::string& name, RunBenchmarkPtr fn ) :
+    m_name( name ),
+    m_function( fn ) {
+    getBenchmarks().insert( this );
+}
+
+std::string Benchmark::getName() const {
+    return m_name;
+}
+
+void Benchmark::run() {
+    m_function();
+}
+
+//reportBenchmark
+//Prints a single result of the benchmark that's currently running
+void reportBenchmark( const std::string& metric, const double value, const std::string& units ) {
+    std::cout << "    " << std::left << std::setw( 40 ) << metric
+              << std::right << std::setw( 14 ) << std::fixed << std::setprecision( 2 ) << value
+              << " " << units << std::endl;
+}
+
+//getCPUMilliseconds
+//Returns the amount of CPU time the process has used, in milliseconds.
+//Unlike wall-clock time, this isn't inflated by time spent waiting on other processes or the GPU.
+double getCPUMilliseconds() {
+    return 1000.0 * (double)std::clock() / CLOCKS_PER_SEC;
+}
+
+//getWallMilliseconds
+//Returns the time elapsed since an arbitrary point, in milliseconds.
+//Unlike CPU time, this includes time spent waiting on the GPU, so it's what GPU work should be measured with.
+double getWallMilliseconds() {
+    return std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+
+
+} //namespace UnitTest
@@ -0,0 +1,73 @@
+/*
+Benchmark.hpp
+-------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Defines Benchmark, a named function that measures the performance of some part of the engine
+    and reports its results with reportBenchmark().
+
+    Benchmarks are defined like unit tests:
+        UT_BENCHMARK_BEGIN( name )
+            ...
+            reportBenchmark( "things per ms", count / ms, "things/ms" );
+        UT_BENCHMARK_END()
+*/
+#ifndef UT_BENCHMARK_HPP
+#define UT_BENCHMARK_HPP
+
+
+
+
+//Includes
+#include <string>  //std::string
+#include <set>     //std::set
+
+
+
+
+//Macros
+#define UT_BENCHMARK_BEGIN( name )                          \
+    ::UnitTest::Benchmark benchmark_##name( #name, []() {
+
+#define UT_BENCHMARK_END()                                  \
+    } );
+
+
+
+
+namespace UnitTest {
+
+
+
+
+class Benchmark {
+private:
+    using RunBenchmarkPtr = void(*)();
+public:
+    Benchmark( const std::string& name, RunBenchmarkPtr fn );
+    std::string getName() const;
+    void run();
+private:
+    std::string     m_name;
+    RunBenchmarkPtr m_function;
+};
+
+
+
+
+//Forward declarations
+std::set< Benchmark* >& getBenchmarks();
+void reportBenchmark( const std::string& metric, const double value, const std::string& units );
+double getCPUMilliseconds();
+double getWallMilliseconds();
+
+
+
+
+} //namespace UnitTest
+
+
+
+
+#endif //UT_BENCHMARK_HPP
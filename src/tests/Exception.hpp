@@ -50,6 +50,16 @@ Description:
 */
 class EOFError : public Exception { using Exception::Exception; };
 
+/*
+SkipTest
+--------
+
+Description:
+    Thrown by a test that can't run in the current environment (e.g. a render test on a machine without an OpenGL driver).
+    The test is reported as skipped rather than failed. The description says why it was skipped.
+*/
+class SkipTest : public Exception { using Exception::Exception; };
+
 
 
 
@@ -0,0 +1,177 @@
+/*
+benchmark/ImageDecode.cpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Benchmarks for ImageLoader and .bsi files.
+
+    ImageLoader_decode decodes a batch of PNGs in memory one after another with Image::loadPNG(), then in parallel with
+    ImageLoaders of increasing numbers of threads, and reports each one's throughput in megabytes of PNG data per second.
+
+    Image_loadFormats writes the same images to PNG files, uncompressed .bsi files and LZ4-compressed .bsi files,
+    then loads each set with Image::loadPNG() and Image::load(), and reports the average time to load an image.
+*/
+
+
+
+
+//Includes
+#include "../Benchmark.hpp"               //UT_BENCHMARK_BEGIN, UT_BENCHMARK_END, UnitTest::reportBenchmark, UnitTest::getWallMilliseconds
+#include "../utils.hpp"                   //UnitTest::encodePNG
+
+#include <brimstone/ImageLoader.hpp>      //Brimstone::ImageLoader, Brimstone::ImageBlob
+#include <brimstone/util/ThreadPool.hpp>  //Brimstone::ThreadPool
+
+#include <cstddef>                        //std::size_t
+#include <cstdio>                         //std::fopen, std::fwrite, std::fclose, std::remove
+#include <random>                         //std::mt19937
+#include <string>                         //std::to_string
+#include <vector>                         //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::Image;
+using ::Brimstone::ImageLoader;
+using ::Brimstone::ImageBlob;
+using ::Brimstone::ThreadPool;
+using ::Brimstone::ImageCompression;
+using ::Brimstone::Size2i;
+using ::Brimstone::ustring;
+using ::Brimstone::ubyte;
+
+
+
+
+//Constants
+const int cv_imageCount = 256;
+const int cv_imageSize  = 256;
+const int cv_fileCount  = 64;
+
+
+
+
+//Functions
+//Fills the given cv_imageSize x cv_imageSize RGBA8 pixels with the index-th test image:
+//smooth gradients with some noise, so the images compress about as well as typical textures
+void makePixels( const int index, std::mt19937& random, ubyte* const pixels ) {
+    for( int p = 0; p < cv_imageSize * cv_imageSize; ++p ) {
+        const int x = p % cv_imageSize;
+        const int y = p / cv_imageSize;
+        pixels[ p * 4     ] = (ubyte)( x + index );
+        pixels[ p * 4 + 1 ] = (ubyte)( y + ( random() & 7 ) );
+        pixels[ p * 4 + 2 ] = (ubyte)( x ^ y );
+        pixels[ p * 4 + 3 ] = 255;
+    }
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_BENCHMARK_BEGIN( ImageLoader_decode )
+    std::mt19937 random( 1 );
+    std::vector< std::vector< ubyte > > pngs( cv_imageCount );
+    std::vector< ImageBlob >            blobs;
+    std::vector< ubyte >                pixels( cv_imageSize * cv_imageSize * 4 );
+    std::size_t                         bytes = 0;
+    for( int i = 0; i < cv_imageCount; ++i ) {
+        makePixels( i, random, pixels.data() );
+        pngs[i] = encodePNG( pixels.data(), cv_imageSize, cv_imageSize, 4 );
+        blobs.push_back( ImageBlob { pngs[i].data(), pngs[i].size() } );
+        bytes += pngs[i].size();
+    }
+
+    //One after another, on this thread
+    double begin = getWallMilliseconds();
+    for( const ImageBlob blob : blobs ) {
+        Image image;
+        image.loadPNG( blob.data, blob.size );
+    }
+    double elapsed = getWallMilliseconds() - begin;
+    reportBenchmark( "serial decode", bytes / ( elapsed * 1000.0 ), "MB/s" );
+
+    //In parallel, delivering each image to a callback as soon as it's decoded
+    const std::size_t maxThreads = ThreadPool::getDefaultThreadCount();
+    for( std::size_t threads = 1; ; threads *= 2 ) {
+        if( threads > maxThreads )
+            threads = maxThreads;
+
+        ImageLoader loader( threads );
+        loader.load( blobs, []( const std::size_t, Image& ) {} );
+        loader.wait();
+        reportBenchmark( "parallel decode, " + std::to_string( threads ) + " threads", loader.getThroughput(), "MB/s" );
+
+        if( threads == maxThreads )
+            break;
+    }
+UT_BENCHMARK_END()
+
+UT_BENCHMARK_BEGIN( Image_loadFormats )
+    std::mt19937 random( 1 );
+    std::vector< ustring > pngFiles, rawFiles, lz4Files;
+    for( int i = 0; i < cv_fileCount; ++i ) {
+        const ustring name = "Image_loadFormats" + std::to_string( i );
+        pngFiles.push_back( name + ".png" );
+        rawFiles.push_back( name + ".bsi" );
+        lz4Files.push_back( name + "_lz4.bsi" );
+
+        ubyte* pixels = new ubyte[ cv_imageSize * cv_imageSize * 4 ];
+        makePixels( i, random, pixels );
+        const Image image( pixels, Size2i( cv_imageSize, cv_imageSize ) );
+
+        const std::vector< ubyte > png = encodePNG( pixels, cv_imageSize, cv_imageSize, 4 );
+        FILE* file = std::fopen( pngFiles.back().c_str(), "wb" );
+        std::fwrite( png.data(), 1, png.size(), file );
+        std::fclose( file );
+        image.save( rawFiles.back() );
+        image.save( lz4Files.back(), ImageCompression::LZ4 );
+    }
+
+    //Each set is loaded twice, and only the second pass is timed, so every format is read from the OS's file cache
+    const auto measure = [&]( const std::vector< ustring >& files, const bool png ) {
+        double elapsed = 0.0;
+        for( int pass = 0; pass < 2; ++pass ) {
+            const double begin = getWallMilliseconds();
+            for( const ustring& filename : files ) {
+                Image image;
+                if( png )
+                    image.loadPNG( filename );
+                else
+                    image.load( filename );
+            }
+            elapsed = getWallMilliseconds() - begin;
+        }
+        return elapsed / cv_fileCount;
+    };
+    reportBenchmark( "loadPNG",          measure( pngFiles, true  ), "ms/image" );
+    reportBenchmark( "load (.bsi)",      measure( rawFiles, false ), "ms/image" );
+    reportBenchmark( "load (.bsi, LZ4)", measure( lz4Files, false ), "ms/image" );
+
+    for( int i = 0; i < cv_fileCount; ++i ) {
+        std::remove( pngFiles[i].c_str() );
+        std::remove( rawFiles[i].c_str() );
+        std::remove( lz4Files[i].c_str() );
+    }
+UT_BENCHMARK_END()
+
+
+
+
+} //namespace UnitTest
@@ -0,0 +1,147 @@
+/*
+benchmark/ImageOps.cpp
+----------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Benchmarks for the pixel operations and resampling.
+    Runs each pixel operation over a large RGBA8 image with every instruction set this CPU supports,
+    and reports each one's throughput in megabytes of pixels per second.
+    Resamples a large RGBA8 image with each filter on one thread and on every core, and builds a mipmap chain from it.
+*/
+
+
+
+
+//Includes
+#include "../Benchmark.hpp"                    //UT_BENCHMARK_BEGIN, UT_BENCHMARK_END, UnitTest::reportBenchmark, UnitTest::getWallMilliseconds
+
+#include <brimstone/util/PixelOps.hpp>         //Brimstone::convertRGBToRGBA, Brimstone::swapRedBlue, Brimstone::SIMDLevel, ...
+#include <brimstone/util/Resample.hpp>         //Brimstone::resample, Brimstone::ResampleFilter
+#include <brimstone/util/ThreadPool.hpp>       //Brimstone::ThreadPool
+#include <brimstone/Image.hpp>                 //Brimstone::Image
+#include <brimstone/graphics/TextureData.hpp>  //Brimstone::TextureData
+
+#include <algorithm>                           //std::copy
+#include <cstddef>                             //std::size_t
+#include <random>                              //std::mt19937
+#include <string>                              //std::string
+#include <vector>                              //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::SIMDLevel;
+using ::Brimstone::ubyte;
+using ::Brimstone::ResampleFilter;
+using ::Brimstone::ThreadPool;
+using ::Brimstone::Image;
+using ::Brimstone::Size2i;
+
+struct Operation {
+    const char* name;
+    void      (*function)( ubyte* const data, const std::size_t pixelCount );
+};
+
+
+
+
+//Constants
+const std::size_t cv_pixelCount = 2048 * 2048;
+const int         cv_repeats    = 8;
+
+const char* const cv_levelNames[] = { "scalar", "SSSE3", "AVX2" };
+
+const ResampleFilter cv_filters[]     = { ResampleFilter::BOX, ResampleFilter::BILINEAR, ResampleFilter::LANCZOS3, ResampleFilter::KAISER };
+const char* const    cv_filterNames[] = { "box", "bilinear", "Lanczos3", "Kaiser" };
+
+
+
+
+//Functions
+void flip( ubyte* const data, const std::size_t pixelCount ) {
+    ::Brimstone::flipRows( data, 2048 * 4, pixelCount / 2048 );
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_BENCHMARK_BEGIN( Image_pixelOps )
+    const Operation operations[] = {
+        { "RGB to RGBA",    ::Brimstone::convertRGBToRGBA    },
+        { "swap red/blue",  ::Brimstone::swapRedBlue         },
+        { "premultiply",    ::Brimstone::premultiplyAlpha    },
+        { "unpremultiply",  ::Brimstone::unpremultiplyAlpha  },
+        { "sRGB to linear", ::Brimstone::convertSRGBToLinear },
+        { "flip",           flip                             }
+    };
+
+    std::mt19937 random( 1 );
+    std::vector< ubyte > pixels( cv_pixelCount * 4 );
+    for( ubyte& b : pixels )
+        b = (ubyte)random();
+
+    for( const Operation& operation : operations ) {
+        for( SIMDLevel level : { SIMDLevel::NONE, SIMDLevel::SSSE3, SIMDLevel::AVX2 } ) {
+            if( level > ::Brimstone::getSupportedSIMDLevel() )
+                break;
+            ::Brimstone::setSIMDLevel( level );
+
+            const double begin = getWallMilliseconds();
+            for( int i = 0; i < cv_repeats; ++i )
+                operation.function( pixels.data(), cv_pixelCount );
+            const double elapsed = getWallMilliseconds() - begin;
+            reportBenchmark( std::string( operation.name ) + ", " + cv_levelNames[ (int)level ], cv_pixelCount * 4.0 * cv_repeats / ( elapsed * 1000.0 ), "MB/s" );
+        }
+    }
+    ::Brimstone::setSIMDLevel( ::Brimstone::getSupportedSIMDLevel() );
+UT_BENCHMARK_END()
+
+UT_BENCHMARK_BEGIN( Image_resample )
+    //Halves a 2048x2048 image with each filter, reporting megapixels of source image per second
+    std::mt19937 random( 2 );
+    std::vector< ubyte > source( cv_pixelCount * 4 );
+    for( ubyte& b : source )
+        b = (ubyte)random();
+    std::vector< ubyte > destination( cv_pixelCount );
+
+    ThreadPool pool;
+    const std::string cores = std::to_string( pool.getThreadCount() + 1 ) + " threads";
+    for( int i = 0; i < 4; ++i ) {
+        for( ThreadPool* const p : { (ThreadPool*)nullptr, &pool } ) {
+            const double begin = getWallMilliseconds();
+            ::Brimstone::resample( source.data(), 2048, 2048, 0, destination.data(), 1024, 1024, 0, 4, cv_filters[i], true, p );
+            const double elapsed = getWallMilliseconds() - begin;
+            reportBenchmark( std::string( cv_filterNames[i] ) + ", " + ( p != nullptr ? cores : "1 thread" ), cv_pixelCount / ( elapsed * 1000.0 ), "MP/s" );
+        }
+    }
+
+    //Every level of a 2048x2048 sRGB texture
+    ubyte* const data = new ubyte[ source.size() ];
+    std::copy( source.begin(), source.end(), data );
+    const Image  image( data, Size2i( 2048, 2048 ) );
+    const double begin = getWallMilliseconds();
+    const ::Brimstone::TextureData chain = image.buildMipChain( ResampleFilter::KAISER, true, &pool );
+    reportBenchmark( "buildMipChain, Kaiser, " + cores, getWallMilliseconds() - begin, "ms" );
+UT_BENCHMARK_END()
+
+
+
+
+} //namespace UnitTest
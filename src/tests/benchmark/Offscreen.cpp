@@ -0,0 +1,328 @@
+/*
+benchmark/Offscreen.cpp
+-----------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    GPU benchmarks, run with an offscreen Graphics rendering into a Framebuffer.
+    Every measurement waits for the GPU to finish with Graphics::finish() and is timed with wall-clock time,
+    so it covers the GPU's work rather than just the time taken to issue commands.
+    Where timer queries are supported, the draws are also timed on the GPU itself with a GpuProfiler.
+    How meaningful those times are depends on the driver; software rasterizers such as llvmpipe may write timestamps
+    when commands are queued rather than when they're executed.
+    Skipped on machines where an offscreen context can't be created.
+*/
+
+
+
+
+//Includes
+#include "../Benchmark.hpp"                    //UT_BENCHMARK_BEGIN, UT_BENCHMARK_END, UnitTest::reportBenchmark, UnitTest::getWallMilliseconds
+#include "../Exception.hpp"                    //UnitTest::SkipTest
+
+#include <brimstone/Graphics.hpp>              //Brimstone::Graphics, Brimstone::Framebuffer, Brimstone::Texture, Brimstone::Program, etc.
+#include <brimstone/graphics/GpuProfiler.hpp>  //Brimstone::GpuProfiler, Brimstone::GpuProfilerFrame
+#include <brimstone/graphics/SlotPool.hpp>     //Brimstone::Private::SlotPool, Brimstone::Private::Handle
+#include <brimstone/Image.hpp>                 //Brimstone::Image
+#include <brimstone/Exception.hpp>             //Brimstone::IException
+
+#include <cstddef>                             //std::size_t
+#include <iterator>                            //std::begin, std::end
+#include <memory>                              //std::unique_ptr
+#include <string>                              //std::string
+#include <vector>                              //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::Graphics;
+using ::Brimstone::Framebuffer;
+using ::Brimstone::Texture;
+using ::Brimstone::TextureFormat;
+using ::Brimstone::Shader;
+using ::Brimstone::ShaderType;
+using ::Brimstone::Program;
+using ::Brimstone::VertexBuffer;
+using ::Brimstone::IndexBuffer;
+using ::Brimstone::DrawIndirectBuffer;
+using ::Brimstone::VertexLayout;
+using ::Brimstone::VertexAttributeType;
+using ::Brimstone::BlendMode;
+using ::Brimstone::Image;
+using ::Brimstone::GpuProfiler;
+using ::Brimstone::GpuProfilerFrame;
+using ::Brimstone::GpuProfilerScope;
+using ::Brimstone::uint16;
+using ::Brimstone::Private::SlotPool;
+using ::Brimstone::Private::Handle;
+
+//Stands in for a graphics resource object when measuring what it costs to allocate one
+struct Resource {
+    unsigned int name;
+    unsigned int vao;
+    std::size_t  size;
+    std::size_t  count;
+    std::size_t  attributes[4];
+};
+
+
+
+
+//Constants
+const std::size_t cv_size        = 1024;
+const int         cv_fillDraws   = 200;
+const int         cv_smallDraws  = 10000;
+const int         cv_reads       = 20;
+const int         cv_frames      = 60;
+const std::size_t cv_transients  = 4096;
+
+constexpr const char* cv_vertexSource =
+    "#version 130\n"
+    "in vec3 position;\n"
+    "uniform vec2 u_offset;\n"
+    "void main() { gl_Position = vec4( position.xy + u_offset, position.z, 1.0 ); }\n";
+
+constexpr const char* cv_fragmentSource =
+    "#version 130\n"
+    "uniform vec4 u_color;\n"
+    "void main() { gl_FragColor = u_color; }\n";
+
+
+
+
+//Functions
+//Initializes an offscreen Graphics and makes its context current.
+//Throws SkipTest if an offscreen context can't be created on this machine.
+void initGraphics( Graphics& graphics ) {
+    try {
+        graphics.init();
+        graphics.begin();
+    } catch( const ::Brimstone::IException& e ) {
+        throw ::UnitTest::SkipTest( "no offscreen context: " + std::string( e.getDescription() ) );
+    }
+}
+
+Program createProgram( Graphics& graphics ) {
+    Shader vertex = graphics.createShader( ShaderType::VERTEX );
+    vertex.setSource( cv_vertexSource );
+    vertex.compile();
+
+    Shader fragment = graphics.createShader( ShaderType::FRAGMENT );
+    fragment.setSource( cv_fragmentSource );
+    fragment.compile();
+
+    Program program = graphics.createProgram();
+    program.attachShader( vertex );
+    program.attachShader( fragment );
+    program.bindAttribute( "position", 0 );
+    program.link();
+    return program;
+}
+
+//Fills the given buffers with a rectangle in normalized device coordinates
+void createRect( Graphics& graphics, const float left, const float bottom, const float right, const float top, VertexBuffer& verticesOut, IndexBuffer& indicesOut ) {
+    const float positions[] = {
+        left,  bottom, 0.0f,
+        right, bottom, 0.0f,
+        right, top,    0.0f,
+        left,  top,    0.0f
+    };
+    const uint16 indices[] = { 0, 1, 2, 0, 2, 3 };
+
+    verticesOut = graphics.createVertexBuffer();
+    verticesOut.setLayout( VertexLayout().add( 0, 3, VertexAttributeType::FLOAT ) );
+    verticesOut.set( positions, sizeof( positions ) );
+
+    indicesOut = graphics.createIndexBuffer();
+    indicesOut.set( indices, 6 );
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_BENCHMARK_BEGIN( Render_offscreen )
+    Graphics graphics;
+    initGraphics( graphics );
+
+    Texture color = graphics.createTexture();
+    color.setStorage( cv_size, cv_size, TextureFormat::RGBA8, 1 );
+
+    Framebuffer framebuffer = graphics.createFramebuffer();
+    framebuffer.setColor( color );
+    framebuffer.setDepth( cv_size, cv_size );
+    framebuffer.bind();
+    graphics.setViewport( 0, 0, cv_size, cv_size );
+    graphics.setClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+
+    Program program = createProgram( graphics );
+    program.use();
+    program.setUniform( "u_color", 1.0f, 0.5f, 0.25f, 0.1f );
+    program.setUniform( "u_offset", 0.0f, 0.0f );
+
+    //Fill rate: blended rectangles covering the whole framebuffer
+    VertexBuffer fullVertices;
+    IndexBuffer  fullIndices;
+    createRect( graphics, -1.0f, -1.0f, 1.0f, 1.0f, fullVertices, fullIndices );
+    graphics.setBlendMode( BlendMode::TRANSPARENCY );
+    graphics.finish();
+
+    GpuProfiler profiler;
+    profiler.init( graphics );
+    profiler.beginFrame();
+
+    double begin = getWallMilliseconds();
+    profiler.beginScope( "fill" );
+    for( int i = 0; i < cv_fillDraws; ++i )
+        graphics.drawIndexed( fullVertices, fullIndices );
+    profiler.endScope();
+    graphics.finish();
+    double elapsed = getWallMilliseconds() - begin;
+    reportBenchmark( "blended fill rate", (double)( cv_size * cv_size ) * cv_fillDraws / ( elapsed * 1000.0 ), "Mpixels/s" );
+
+    //Draw call throughput: tiny rectangles, each with its own uniforms
+    VertexBuffer smallVertices;
+    IndexBuffer  smallIndices;
+    createRect( graphics, -1.0f, -1.0f, -0.99f, -0.99f, smallVertices, smallIndices );
+    graphics.setBlendMode( BlendMode::NONE );
+    graphics.finish();
+
+    begin = getWallMilliseconds();
+    profiler.beginScope( "small draws" );
+    for( int i = 0; i < cv_smallDraws; ++i ) {
+        program.setUniform( "u_offset", ( i % 100 ) * 0.02f, ( i / 100 % 100 ) * 0.02f );
+        graphics.drawIndexed( smallVertices, smallIndices );
+    }
+    profiler.endScope();
+    graphics.finish();
+    elapsed = getWallMilliseconds() - begin;
+    reportBenchmark( "small draws per ms", cv_smallDraws / elapsed, "draws/ms" );
+
+    //The same rectangles with their positions baked into one shared vertex buffer,
+    //drawn with a call each and then all at once from a draw indirect buffer
+    std::vector< float > positions;
+    positions.reserve( cv_smallDraws * 12 );
+    for( int i = 0; i < cv_smallDraws; ++i ) {
+        const float left   = -1.0f + ( i % 100 ) * 0.02f;
+        const float bottom = -1.0f + ( i / 100 % 100 ) * 0.02f;
+        const float corners[] = {
+            left,          bottom,          0.0f,
+            left + 0.01f,  bottom,          0.0f,
+            left + 0.01f,  bottom + 0.01f,  0.0f,
+            left,          bottom + 0.01f,  0.0f
+        };
+        positions.insert( positions.end(), std::begin( corners ), std::end( corners ) );
+    }
+    VertexBuffer sharedVertices = graphics.createVertexBuffer();
+    sharedVertices.setLayout( VertexLayout().add( 0, 3, VertexAttributeType::FLOAT ) );
+    sharedVertices.set( positions.data(), positions.size() * sizeof( float ) );
+    program.setUniform( "u_offset", 0.0f, 0.0f );
+    graphics.finish();
+
+    begin = getWallMilliseconds();
+    for( int i = 0; i < cv_smallDraws; ++i )
+        graphics.drawIndexed( sharedVertices, smallIndices, 0, 6, i * 4 );
+    graphics.finish();
+    elapsed = getWallMilliseconds() - begin;
+    reportBenchmark( "shared buffer draws per ms", cv_smallDraws / elapsed, "draws/ms" );
+
+    DrawIndirectBuffer commands = graphics.createDrawIndirectBuffer( cv_smallDraws );
+    begin = getWallMilliseconds();
+    commands.beginFrame();
+    for( int i = 0; i < cv_smallDraws; ++i )
+        commands.add( 6, 0, i * 4 );
+    graphics.multiDrawIndirect( sharedVertices, smallIndices, commands );
+    commands.endFrame();
+    graphics.finish();
+    elapsed = getWallMilliseconds() - begin;
+    reportBenchmark( "indirect draws per ms", cv_smallDraws / elapsed, "draws/ms" );
+    program.stopUsing();
+
+    //The GPU is idle after finish(), so the frame's results can be read right away
+    profiler.endFrame();
+    profiler.update();
+    const GpuProfilerFrame* frame = profiler.getLatestFrame();
+    if( frame != nullptr && profiler.isTimerSupported() ) {
+        const GpuProfilerScope& fill  = frame->scopes[0];
+        const GpuProfilerScope& small = frame->scopes[1];
+        reportBenchmark( "blended fill GPU time", fill.gpuEnd - fill.gpuBegin, "ms" );
+        reportBenchmark( "small draws GPU time", small.gpuEnd - small.gpuBegin, "ms" );
+    }
+
+    //Readback of the whole framebuffer into an Image
+    Image image;
+    begin = getWallMilliseconds();
+    for( int i = 0; i < cv_reads; ++i )
+        framebuffer.read( image );
+    elapsed = getWallMilliseconds() - begin;
+    reportBenchmark( "readback", (double)( cv_size * cv_size * 4 ) * cv_reads / ( elapsed * 1000.0 ), "MB/s" );
+
+    framebuffer.unbind();
+UT_BENCHMARK_END()
+
+
+UT_BENCHMARK_BEGIN( Render_transientBuffers )
+    Graphics graphics;
+    initGraphics( graphics );
+
+    //Every frame, thousands of small vertex buffers are created, filled, and destroyed again
+    const float                 positions[9] = {};
+    std::vector< VertexBuffer > buffers( cv_transients );
+    double begin = getWallMilliseconds();
+    for( int frame = 0; frame < cv_frames; ++frame ) {
+        for( VertexBuffer& buffer : buffers ) {
+            buffer = graphics.createVertexBuffer();
+            buffer.set( positions, sizeof( positions ) );
+        }
+        for( VertexBuffer& buffer : buffers )
+            buffer = VertexBuffer();
+        graphics.finish();
+    }
+    double elapsed = getWallMilliseconds() - begin;
+    reportBenchmark( "transient buffers per ms", cv_transients * cv_frames / elapsed, "buffers/ms" );
+
+    //Just the cost of allocating the objects that implement them, from a pool and from the heap
+    std::vector< Handle< Resource > > handles( cv_transients );
+    SlotPool< Resource >              pool;
+    begin = getWallMilliseconds();
+    for( int frame = 0; frame < cv_frames; ++frame ) {
+        for( Handle< Resource >& handle : handles )
+            handle = pool.create();
+        for( Handle< Resource >& handle : handles )
+            pool.destroy( handle );
+    }
+    elapsed = getWallMilliseconds() - begin;
+    reportBenchmark( "pool create/destroy per ms", cv_transients * cv_frames / elapsed, "objects/ms" );
+
+    std::vector< std::unique_ptr< Resource > > objects( cv_transients );
+    begin = getWallMilliseconds();
+    for( int frame = 0; frame < cv_frames; ++frame ) {
+        for( std::unique_ptr< Resource >& object : objects )
+            object.reset( new Resource() );
+        for( std::unique_ptr< Resource >& object : objects )
+            object.reset();
+    }
+    elapsed = getWallMilliseconds() - begin;
+    reportBenchmark( "heap create/destroy per ms", cv_transients * cv_frames / elapsed, "objects/ms" );
+UT_BENCHMARK_END()
+
+
+
+
+} //namespace UnitTest
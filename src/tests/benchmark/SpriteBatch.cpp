@@ -0,0 +1,123 @@
+/*
+benchmark/SpriteBatch.cpp
+-------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Stress benchmark for SpriteQueue, the CPU side of SpriteBatch.
+    Measures how many sprites per millisecond of CPU time can be queued, sorted, and written out as vertices.
+*/
+
+
+
+
+//Includes
+#include "../Benchmark.hpp"                    //UT_BENCHMARK_BEGIN, UT_BENCHMARK_END, UnitTest::reportBenchmark, UnitTest::getCPUMilliseconds
+
+#include <brimstone/graphics/SpriteBatch.hpp>  //Brimstone::SpriteQueue, Brimstone::Sprite, Brimstone::SpriteVertex, Brimstone::SpriteRun
+#include <brimstone/Graphics.hpp>              //Brimstone::Texture
+
+#include <vector>                              //std::vector
+#include <random>                              //std::mt19937, std::uniform_real_distribution, std::uniform_int_distribution
+#include <cstddef>                             //std::size_t
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::SpriteQueue;
+using ::Brimstone::SpriteSortMode;
+using ::Brimstone::Sprite;
+using ::Brimstone::SpriteVertex;
+using ::Brimstone::SpriteRun;
+using ::Brimstone::Texture;
+using ::Brimstone::Bounds2f;
+using ::Brimstone::Point2f;
+using ::Brimstone::BlendMode;
+
+
+
+
+//Constants
+const std::size_t cv_spriteCount  = 100000;
+const std::size_t cv_textureCount = 8;
+const int         cv_frames       = 20;
+
+
+
+
+//Functions
+//Runs cv_frames frames of cv_spriteCount sprites through a SpriteQueue with the given sort mode and reports the results
+void measureSpriteQueue( const SpriteSortMode mode, const char* const label ) {
+    //Only the identities of the textures matter here; they don't need to be created
+    Texture textures[ cv_textureCount ];
+
+    std::mt19937 rng( 12345 );
+    std::uniform_real_distribution< float > position( 0.0f, 1920.0f );
+    std::uniform_real_distribution< float > angle( 0.0f, 6.28f );
+    std::uniform_int_distribution< std::size_t > texture( 0, cv_textureCount - 1 );
+    std::uniform_int_distribution< int > chance( 0, 9 );
+
+    std::vector< Sprite > sprites;
+    sprites.reserve( cv_spriteCount );
+    for( std::size_t i = 0; i < cv_spriteCount; ++i ) {
+        const float x = position( rng );
+        const float y = position( rng );
+        sprites.push_back( Sprite {
+            &textures[ texture( rng ) ],
+            Bounds2f( x, y, x + 32.0f, y + 32.0f ),
+            Bounds2f( 0.0f, 0.0f, 1.0f, 1.0f ),
+            0xFFFFFFFF,
+            chance( rng ) == 0 ? angle( rng ) : 0.0f,
+            Point2f( 16.0f ),
+            chance( rng ) == 0 ? BlendMode::ADDITIVE : BlendMode::TRANSPARENCY,
+            0
+        } );
+    }
+
+    SpriteQueue queue;
+    queue.setSortMode( mode );
+    queue.reserve( cv_spriteCount );
+    std::vector< SpriteVertex > vertices( cv_spriteCount * 4 );
+    std::vector< SpriteRun > runs;
+
+    const double begin = ::UnitTest::getCPUMilliseconds();
+    for( int frame = 0; frame < cv_frames; ++frame ) {
+        for( const Sprite& sprite : sprites )
+            queue.add( sprite );
+        queue.write( vertices.data(), runs );
+        queue.clear();
+    }
+    const double elapsed = ::UnitTest::getCPUMilliseconds() - begin;
+
+    ::UnitTest::reportBenchmark( std::string( label ) + " sprites per CPU ms", cv_spriteCount * cv_frames / elapsed, "sprites/ms" );
+    ::UnitTest::reportBenchmark( std::string( label ) + " draw calls per frame", (double)runs.size(), "draws" );
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_BENCHMARK_BEGIN( SpriteQueue_stress )
+    measureSpriteQueue( SpriteSortMode::TEXTURE,  "TEXTURE"  );
+    measureSpriteQueue( SpriteSortMode::DEFERRED, "DEFERRED" );
+UT_BENCHMARK_END()
+
+
+
+
+} //namespace UnitTest
@@ -16,7 +16,8 @@ Description:
 #include "console/Menu.hpp"       //UnitTest::menu
 #include "MeasureXTime.hpp"       //UnitTest::measure
 #include "Test.hpp"               //UnitTest::getTests
-#include "Exception.hpp"          //UnitTest::EOFError
+#include "Benchmark.hpp"          //UnitTest::getBenchmarks
+#include "Exception.hpp"          //UnitTest::EOFError, UnitTest::SkipTest
 
 
 
@@ -27,7 +28,7 @@ namespace {
 
 
 //Constants
-constexpr const char* choices[] = { "Do Tests", "", "Quit" };
+constexpr const char* choices[] = { "Do Tests", "Do Benchmarks", "Quit" };
 
 
 
@@ -45,6 +46,7 @@ namespace UnitTest {
 void doTests() {
     int pass  = 0;
     int fail  = 0;
+    int skip  = 0;
     int total = 0;
     bool status;
     bool exception;
@@ -52,6 +54,14 @@ void doTests() {
         try {
             status = test->run();
             exception = false;
+        } catch( const SkipTest& e ) {
+            setTextColor( TextColors::YELLOW );
+            std::cout << "SKIP";
+            setTextColor();
+            std::cout << ": " << test->getName() << " (" << e.getDescription() << ")" << std::endl;
+            ++skip;
+            ++total;
+            continue;
         } catch( ... ) { status = false; exception = true; }
 
         if( status ) {
@@ -79,15 +89,46 @@ void doTests() {
     setTextColor( TextColors::YELLOW );
     std::cout << "Unit tests complete." << std::endl;
     setTextColor();
-    std::cout << "Passed: " << pass  << std::endl
-              << "Failed: " << fail  << std::endl
-              << "Total:  " << total << std::endl
+    std::cout << "Passed:  " << pass  << std::endl
+              << "Failed:  " << fail  << std::endl
+              << "Skipped: " << skip  << std::endl
+              << "Total:   " << total << std::endl
               << std::endl;
 }
 
 
 
 
+void doBenchmarks() {
+    for( auto benchmark : getBenchmarks() ) {
+        setTextColor( TextColors::YELLOW );
+        std::cout << benchmark->getName() << std::endl;
+        setTextColor();
+
+        try {
+            benchmark->run();
+        } catch( const SkipTest& e ) {
+            setTextColor( TextColors::YELLOW );
+            std::cout << "    SKIP";
+            setTextColor();
+            std::cout << ": " << e.getDescription() << std::endl;
+        } catch( ... ) {
+            setTextColor( TextColors::PURPLE );
+            std::cout << "    XCPT";
+            setTextColor();
+            std::cout << ": benchmark threw an exception." << std::endl;
+        }
+        std::cout << std::endl;
+    }
+    setTextColor( TextColors::YELLOW );
+    std::cout << "Benchmarks complete." << std::endl;
+    setTextColor();
+    std::cout << std::endl;
+}
+
+
+
+
 } //namespace UnitTest
 
 
@@ -119,6 +160,9 @@ int main( int /* argc */, char** /* argv */ ) {
             case 0: {
                 doTests();
             } break;
+            case 1: {
+                doBenchmarks();
+            } break;
         }
     } while( choice != 2 );
 
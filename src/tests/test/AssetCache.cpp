@@ -0,0 +1,253 @@
+/*
+test/AssetCache.cpp
+-------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for AssetCache's images. Its textures are tested with the other tests that need a context, in Render.cpp.
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"               //UT_TEST_BEGIN, UT_TEST_END
+#include "../utils.hpp"              //UnitTest::encodePNG
+
+#include <brimstone/AssetCache.hpp>  //Brimstone::AssetCache, Brimstone::ImageHandle, Brimstone::AssetCacheStats
+#include <brimstone/Exception.hpp>   //Brimstone::NullPointerException
+
+#include <cstdio>                    //std::fopen, std::fwrite, std::fclose, std::remove
+#include <cstring>                   //std::memcmp
+#include <utility>                   //std::move
+#include <vector>                    //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::AssetCache;
+using ::Brimstone::AssetCacheStats;
+using ::Brimstone::ImageHandle;
+using ::Brimstone::ustring;
+using ::Brimstone::ubyte;
+using ::Brimstone::uint64;
+
+
+
+
+//Constants
+constexpr int cv_width  = 16;
+constexpr int cv_height = 8;
+
+//Bytes of pixels each test image takes up in the cache
+constexpr uint64 cv_imageBytes = cv_width * 4 * cv_height;
+
+
+
+
+//Functions
+std::vector< ubyte > makePixels( const int seed ) {
+    std::vector< ubyte > pixels( cv_width * cv_height * 4 );
+    for( std::size_t i = 0; i < pixels.size(); ++i )
+        pixels[i] = (ubyte)( i * 7 + seed * 31 );
+    return pixels;
+}
+
+std::vector< ubyte > makePNG( const int seed ) {
+    return ::UnitTest::encodePNG( makePixels( seed ).data(), cv_width, cv_height, 4 );
+}
+
+bool isImage( const ImageHandle& handle, const int seed ) {
+    const std::vector< ubyte > pixels = makePixels( seed );
+    if( !handle.isValid() || handle->getSize().width != cv_width || handle->getSize().height != cv_height )
+        return false;
+    for( int y = 0; y < cv_height; ++y )
+        if( std::memcmp( handle->getRow( y ), &pixels[ y * cv_width * 4 ], cv_width * 4 ) != 0 )
+            return false;
+    return true;
+}
+
+void writeFile( const ustring& filename, const std::vector< ubyte >& contents ) {
+    FILE* file = std::fopen( filename.c_str(), "wb" );
+    std::fwrite( contents.data(), 1, contents.size(), file );
+    std::fclose( file );
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( AssetCache_dedup )
+    const std::vector< ubyte > png   = makePNG( 0 );
+    const std::vector< ubyte > other = makePNG( 1 );
+
+    //Loading the same data twice decodes it once and shares the image
+    AssetCache  cache;
+    ImageHandle first  = cache.loadImage( png.data(), png.size() );
+    ImageHandle second = cache.loadImage( png.data(), png.size() );
+    ImageHandle third  = cache.loadImage( other.data(), other.size() );
+    if( !isImage( first, 0 ) || !isImage( third, 1 ) || &first.get() != &second.get() || &first.get() == &third.get() ||
+        first.getRefCount() != 2 || third.getRefCount() != 1 || first.getHash() == third.getHash() )
+        return false;
+
+    const AssetCacheStats& stats = cache.getStats();
+    if( stats.hits != 1 || stats.misses != 2 || stats.failures != 0 || stats.images != 2 || stats.textures != 0 ||
+        stats.cpuBytes != 2 * cv_imageBytes || stats.gpuBytes != 0 || cache.getCount() != 2 )
+        return false;
+
+    //Data that isn't an image is a failed miss
+    const ubyte garbage[16] = { 1, 2, 3 };
+    if( cache.loadImage( garbage, sizeof( garbage ) ).isValid() || stats.misses != 3 || stats.failures != 1 || cache.getCount() != 2 )
+        return false;
+
+    cache.resetStats();
+    return stats.hits == 0 && stats.misses == 0 && stats.failures == 0 && stats.images == 2 && stats.cpuBytes == 2 * cv_imageBytes;
+UT_TEST_END()
+
+UT_TEST_BEGIN( AssetCache_files )
+    const std::vector< ubyte > png = makePNG( 2 );
+    writeFile( "AssetCache_files0.png", png );
+    writeFile( "AssetCache_files1.png", png );
+
+    //Identical files at different paths share one image, and loading a path again is a hit
+    AssetCache  cache;
+    ImageHandle first  = cache.loadImage( "AssetCache_files0.png" );
+    ImageHandle second = cache.loadImage( "AssetCache_files1.png" );
+    ImageHandle again  = cache.loadImage( "AssetCache_files0.png" );
+    bool ok = isImage( first, 2 ) && &first.get() == &second.get() && &first.get() == &again.get() &&
+              cache.getStats().hits == 2 && cache.getStats().misses == 1 && cache.getCount() == 1;
+
+    //A file that's changed is loaded again; handles to its old contents keep them
+    std::vector< ubyte > changed = makePNG( 3 );
+    changed.resize( changed.size() + 1 );
+    writeFile( "AssetCache_files0.png", changed );
+    ImageHandle reloaded = cache.loadImage( "AssetCache_files0.png" );
+    ok = ok && isImage( reloaded, 3 ) && isImage( first, 2 ) && cache.getCount() == 2;
+
+    std::remove( "AssetCache_files0.png" );
+    std::remove( "AssetCache_files1.png" );
+
+    //Files that don't exist give empty handles
+    return ok && !cache.loadImage( "AssetCache_files_missing.png" ).isValid() && cache.getStats().failures == 1;
+UT_TEST_END()
+
+UT_TEST_BEGIN( AssetCache_handles )
+    const std::vector< ubyte > png = makePNG( 4 );
+    AssetCache cache;
+
+    ImageHandle handle = cache.loadImage( png.data(), png.size() );
+    ImageHandle copy( handle );
+    ImageHandle moved( std::move( copy ) );
+    if( copy.isValid() || copy.getRefCount() != 0 || handle.getRefCount() != 2 )
+        return false;
+
+    copy = moved;
+    moved.release();
+    moved.release();
+    if( moved.isValid() || handle.getRefCount() != 2 )
+        return false;
+
+    //Releasing every handle leaves the image cached until it's trimmed
+    handle = ImageHandle();
+    copy   = std::move( handle );
+    if( copy.isValid() || cache.getCount() != 1 )
+        return false;
+    cache.trim();
+    if( cache.getCount() != 0 || cache.getStats().evictions != 1 || cache.getStats().cpuBytes != 0 || cache.getStats().images != 0 )
+        return false;
+
+    try {
+        copy.get();
+        return false;
+    } catch( const ::Brimstone::NullPointerException& ) {
+    }
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( AssetCache_outlive )
+    const std::vector< ubyte > png   = makePNG( 5 );
+    const std::vector< ubyte > other = makePNG( 6 );
+
+    //Handles that outlive their cache keep their images; the last one to let go frees it
+    ImageHandle handle, copy;
+    {
+        AssetCache cache;
+        handle = cache.loadImage( png.data(), png.size() );
+        copy   = handle;
+        cache.loadImage( other.data(), other.size() );
+    }
+    if( !isImage( handle, 5 ) || !isImage( copy, 5 ) || handle.getRefCount() != 2 )
+        return false;
+    handle.release();
+    if( !isImage( copy, 5 ) || copy.getRefCount() != 1 )
+        return false;
+
+    //Destroying a cache explicitly detaches its referenced assets the same way, and the cache can be used again
+    AssetCache cache;
+    ImageHandle reused = cache.loadImage( png.data(), png.size() );
+    cache.destroy();
+    ImageHandle reloaded = cache.loadImage( png.data(), png.size() );
+    return isImage( reused, 5 ) && isImage( reloaded, 5 ) && &reused.get() != &reloaded.get() &&
+           cache.getCount() == 1 && cache.getStats().images == 1;
+UT_TEST_END()
+
+UT_TEST_BEGIN( AssetCache_budget )
+    std::vector< std::vector< ubyte > > pngs;
+    for( int i = 0; i < 4; ++i )
+        pngs.push_back( makePNG( 10 + i ) );
+
+    AssetCache cache;
+    cache.setBudget( 2 * cv_imageBytes, AssetCache::UNLIMITED );
+
+    //Images that are still referenced are never evicted, even over budget
+    std::vector< ImageHandle > handles;
+    for( int i = 0; i < 3; ++i )
+        handles.push_back( cache.loadImage( pngs[i].data(), pngs[i].size() ) );
+    if( cache.getCount() != 3 || cache.getStats().cpuBytes != 3 * cv_imageBytes )
+        return false;
+
+    //Once they're released, the least recently used is evicted
+    for( ImageHandle& handle : handles )
+        handle.release();
+    if( cache.getCount() != 2 || cache.getStats().evictions != 1 || cache.getStats().cpuBytes != 2 * cv_imageBytes )
+        return false;
+
+    //Bringing 0 back evicts 1, leaving 0 and 2 cached
+    if( !isImage( cache.loadImage( pngs[0].data(), pngs[0].size() ), 10 ) || cache.getStats().misses != 4 || cache.getStats().evictions != 2 )
+        return false;
+
+    //A hit makes an image the most recently used: loading 2 again means loading 3 evicts 0 instead of 2
+    cache.resetStats();
+    cache.loadImage( pngs[2].data(), pngs[2].size() );
+    cache.loadImage( pngs[3].data(), pngs[3].size() );
+    if( cache.getStats().hits != 1 || cache.getStats().evictions != 1 || cache.getCount() != 2 )
+        return false;
+    const ImageHandle two   = cache.loadImage( pngs[2].data(), pngs[2].size() );
+    const ImageHandle three = cache.loadImage( pngs[3].data(), pngs[3].size() );
+    if( !isImage( two, 12 ) || !isImage( three, 13 ) || cache.getStats().hits != 3 )
+        return false;
+
+    //Lowering the budget evicts right away, but only what isn't referenced
+    cache.setBudget( 0, 0 );
+    return cache.getCount() == 2 && cache.getStats().cpuBytes == 2 * cv_imageBytes;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
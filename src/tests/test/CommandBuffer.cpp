@@ -0,0 +1,208 @@
+/*
+test/CommandBuffer.cpp
+----------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for CommandBuffer
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                           //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/graphics/CommandBuffer.hpp>  //Brimstone::CommandBuffer, Brimstone::makeSortKey, Brimstone::sortCommandPackets
+#include <brimstone/Graphics.hpp>                //Brimstone::Program, Brimstone::VertexBuffer, Brimstone::IndexBuffer
+#include <brimstone/util/ThreadPool.hpp>         //Brimstone::ThreadPool
+
+#include <cstring>                               //std::strcmp
+#include <vector>                                //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::CommandBuffer;
+using ::Brimstone::CommandHeader;
+using ::Brimstone::CommandPacket;
+using ::Brimstone::CommandType;
+using ::Brimstone::ThreadPool;
+using ::Brimstone::ubyte;
+using ::Brimstone::uint64;
+namespace Commands = ::Brimstone::Commands;
+
+
+
+
+//Functions
+//Returns the types of the commands in the given packet, in order
+std::vector< CommandType > getCommandTypes( const CommandPacket& packet ) {
+    std::vector< CommandType > types;
+    for( const ubyte* command = packet.data; command < packet.data + packet.size; ) {
+        const CommandHeader& header = *reinterpret_cast< const CommandHeader* >( command );
+        types.push_back( header.type );
+        command += header.size;
+    }
+    return types;
+}
+
+template< typename T >
+const T& getCommand( const CommandPacket& packet, std::size_t index ) {
+    const ubyte* command = packet.data;
+    for( ; index > 0; --index )
+        command += reinterpret_cast< const CommandHeader* >( command )->size;
+    return *reinterpret_cast< const T* >( command + sizeof( CommandHeader ) );
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( CommandBuffer_record )
+    Brimstone::Program      program;
+    Brimstone::VertexBuffer vertices;
+    Brimstone::IndexBuffer  indices;
+
+    CommandBuffer buffer;
+    buffer.setClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+    buffer.clear();
+    buffer.begin( 5 );
+    buffer.useProgram( program );
+    buffer.setUniform( "u_color", 1.0f, 0.5f, 0.25f, 1.0f );
+    buffer.drawIndexed( vertices, indices, 6, 12, 3 );
+
+    if( buffer.getPacketCount() != 2 || buffer.getCommandCount() != 5 )
+        return false;
+
+    //Commands recorded before begin() go in a packet with a key of 0
+    const CommandPacket& first  = buffer.getPacket( 0 );
+    const CommandPacket& second = buffer.getPacket( 1 );
+    const std::vector< CommandType > expected = { CommandType::USE_PROGRAM, CommandType::SET_UNIFORM, CommandType::DRAW_INDEXED };
+    if( first.key != 0 || getCommandTypes( first ) != std::vector< CommandType > { CommandType::SET_CLEAR_COLOR, CommandType::CLEAR } ||
+        second.key != 5 || getCommandTypes( second ) != expected )
+        return false;
+
+    const Commands::SetUniform&  uniform = getCommand< Commands::SetUniform >( second, 1 );
+    const Commands::DrawIndexed& draw    = getCommand< Commands::DrawIndexed >( second, 2 );
+    return std::strcmp( uniform.getName(), "u_color" ) == 0 && uniform.f[1] == 0.5f &&
+           draw.first == 6 && draw.count == 12 && draw.baseVertex == 3 && draw.instanceCount == 0 &&
+           buffer.getSize() == first.size + second.size;
+UT_TEST_END()
+
+UT_TEST_BEGIN( CommandBuffer_packetsStayContiguous )
+    //Blocks only fit a few commands, so packets have to move to new blocks as they grow
+    CommandBuffer buffer( 64 );
+    for( int i = 0; i < 10; ++i ) {
+        buffer.begin( i );
+        for( int j = 0; j <= i; ++j )
+            buffer.setUniform( "u_index", j );
+    }
+
+    for( int i = 0; i < 10; ++i ) {
+        const CommandPacket& packet = buffer.getPacket( i );
+        if( getCommandTypes( packet ).size() != (std::size_t)i + 1 )
+            return false;
+        for( int j = 0; j <= i; ++j ) {
+            const Commands::SetUniform& uniform = getCommand< Commands::SetUniform >( packet, j );
+            if( uniform.i[0] != j || std::strcmp( uniform.getName(), "u_index" ) != 0 )
+                return false;
+        }
+    }
+
+    //Memory is reused after a reset
+    const std::size_t capacity = buffer.getCapacity();
+    buffer.reset();
+    for( int i = 0; i < 10; ++i ) {
+        buffer.begin( i );
+        for( int j = 0; j <= i; ++j )
+            buffer.setUniform( "u_index", j );
+    }
+    return buffer.getCapacity() == capacity && buffer.getCommandCount() == 55;
+UT_TEST_END()
+
+UT_TEST_BEGIN( CommandBuffer_sortPackets )
+    CommandBuffer a;
+    CommandBuffer b;
+    a.begin( 3 ); a.setDepthTest( true );
+    a.begin( 1 ); a.setDepthTest( false );
+    a.begin( 9 );   //Empty packets are left out
+    b.begin( 1 ); b.setDepthMask( false );
+    b.begin( 0 ); b.clear();
+
+    const CommandBuffer* const buffers[] = { &a, &b };
+    std::vector< CommandPacket > packets;
+    Brimstone::sortCommandPackets( buffers, 2, packets );
+
+    //Packets with equal keys stay in the order they were given in
+    return packets.size() == 4 &&
+           packets[0].key == 0 && getCommandTypes( packets[0] )[0] == CommandType::CLEAR &&
+           packets[1].key == 1 && getCommandTypes( packets[1] )[0] == CommandType::SET_DEPTH_TEST &&
+           packets[2].key == 1 && getCommandTypes( packets[2] )[0] == CommandType::SET_DEPTH_MASK &&
+           packets[3].key == 3;
+UT_TEST_END()
+
+UT_TEST_BEGIN( CommandBuffer_recordInParallel )
+    //Each thread records into its own buffer; packets from all of them interleave once sorted
+    ThreadPool                   pool( 4 );
+    std::vector< CommandBuffer > buffers( 4 );
+    for( std::size_t t = 0; t < buffers.size(); ++t ) {
+        CommandBuffer* const buffer = &buffers[t];
+        pool.post( [buffer, t]() {
+            for( int i = 0; i < 100; ++i ) {
+                buffer->begin( (uint64)i * 4 + t );
+                buffer->setViewport( 0, 0, i, (int)t );
+            }
+        } );
+    }
+    pool.wait();
+
+    std::vector< const CommandBuffer* > pointers;
+    for( const CommandBuffer& buffer : buffers )
+        pointers.push_back( &buffer );
+
+    std::vector< CommandPacket > packets;
+    Brimstone::sortCommandPackets( pointers.data(), pointers.size(), packets );
+    if( packets.size() != 400 )
+        return false;
+
+    for( std::size_t i = 0; i < packets.size(); ++i ) {
+        const Commands::SetRect& viewport = getCommand< Commands::SetRect >( packets[i], 0 );
+        if( packets[i].key != i || viewport.width != (int)( i / 4 ) || viewport.height != (int)( i % 4 ) )
+            return false;
+    }
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( CommandBuffer_makeSortKey )
+    using Brimstone::makeSortKey;
+
+    //Pass, then program, then material, then depth
+    return makeSortKey( 0, 65535, 65535, 1.0f ) < makeSortKey( 1, 0, 0, 0.0f ) &&
+           makeSortKey( 1, 2, 65535, 1.0f )     < makeSortKey( 1, 3, 0, 0.0f ) &&
+           makeSortKey( 1, 2, 7, 1.0f )         < makeSortKey( 1, 2, 8, 0.0f ) &&
+           makeSortKey( 1, 2, 7, 0.25f )        < makeSortKey( 1, 2, 7, 0.5f ) &&
+           makeSortKey( 1, 2, 7, -1.0f )        == makeSortKey( 1, 2, 7, 0.0f ) &&
+           makeSortKey( 1, 2, 7, 2.0f )         == makeSortKey( 1, 2, 7, 1.0f ) &&
+           makeSortKey( 255, 0, 0, 0.0f )       == (uint64)255 << 56;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
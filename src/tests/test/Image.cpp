@@ -0,0 +1,323 @@
+/*
+test/Image.cpp
+--------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for Image
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                         //UT_TEST_BEGIN, UT_TEST_END
+#include "../utils.hpp"                        //UnitTest::encodePNG
+
+#include <brimstone/Image.hpp>                 //Brimstone::Image
+#include <brimstone/graphics/TextureData.hpp>  //Brimstone::TextureData
+#include <brimstone/util/ThreadPool.hpp>       //Brimstone::ThreadPool
+#include <brimstone/Exception.hpp>             //Brimstone::SizeException, Brimstone::NullPointerException
+
+#include <cstdint>                             //std::uintptr_t
+#include <cstring>                             //std::memcmp
+#include <map>                                 //std::map
+#include <memory_resource>                     //std::pmr::memory_resource, std::pmr::new_delete_resource
+#include <utility>                             //std::move
+#include <vector>                              //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::Image;
+using ::Brimstone::TextureData;
+using ::Brimstone::TextureFormat;
+using ::Brimstone::ResampleFilter;
+using ::Brimstone::ThreadPool;
+
+//Keeps track of the allocations made from it that haven't been freed yet,
+//and checks each one is freed with the size and alignment it was made with
+class CountingResource : public std::pmr::memory_resource {
+public:
+    int                            mismatches = 0;
+    std::map< void*, std::size_t >    live;
+private:
+    void* do_allocate( std::size_t bytes, std::size_t alignment ) override {
+        void* const p = std::pmr::new_delete_resource()->allocate( bytes, alignment );
+        live[p] = bytes;
+        return p;
+    }
+    void do_deallocate( void* p, std::size_t bytes, std::size_t alignment ) override {
+        if( live.count( p ) == 0 || live[p] != bytes || alignment != Image::ROW_ALIGNMENT )
+            ++mismatches;
+        live.erase( p );
+        std::pmr::new_delete_resource()->deallocate( p, bytes, alignment );
+    }
+    bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override {
+        return this == &other;
+    }
+};
+using ::Brimstone::Size2i;
+using ::Brimstone::ubyte;
+
+
+
+
+//Constants
+constexpr int cv_width  = 5;
+constexpr int cv_height = 3;
+
+
+
+
+//Functions
+//Returns the pixels of a cv_width x cv_height test image with the given number of channels per pixel
+std::vector< ubyte > makePixels( const int channels ) {
+    std::vector< ubyte > pixels( cv_width * cv_height * channels );
+    for( std::size_t i = 0; i < pixels.size(); ++i )
+        pixels[i] = (ubyte)( i * 7 + 3 );
+    return pixels;
+}
+
+//Encodes the given pixels as a cv_width x cv_height PNG
+std::vector< ubyte > makePNG( const std::vector< ubyte >& pixels, const int channels, const bool interlaced ) {
+    return ::UnitTest::encodePNG( pixels.data(), cv_width, cv_height, channels, interlaced );
+}
+
+//Returns true if the given image matches the given pixels with the given number of channels, expanded to RGBA
+bool matches( const Image& image, const std::vector< ubyte >& pixels, const int channels ) {
+    for( int y = 0; y < cv_height; ++y ) {
+        for( int x = 0; x < cv_width; ++x ) {
+            const ubyte* rgba   = image.getRow( y ) + x * 4;
+            const ubyte* source = &pixels[ ( y * cv_width + x ) * channels ];
+            const ubyte  r = source[0];
+            const ubyte  g = channels >= 3 ? source[1] : r;
+            const ubyte  b = channels >= 3 ? source[2] : r;
+            const ubyte  a = channels == 4 ? source[3] : 255;
+            if( rgba[0] != r || rgba[1] != g || rgba[2] != b || rgba[3] != a )
+                return false;
+        }
+    }
+    return true;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( Image_loadPNGFromMemory )
+    const std::vector< ubyte > rgba = makePixels( 4 );
+    const std::vector< ubyte > png  = makePNG( rgba, 4, false );
+
+    Image image;
+    return image.loadPNG( png.data(), png.size() ) &&
+           image.getSize().width == cv_width && image.getSize().height == cv_height &&
+           matches( image, rgba, 4 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Image_loadPNGConversions )
+    //Grayscale and RGB images are expanded to RGBA, and interlaced images are decoded too
+    const std::vector< ubyte > gray = makePixels( 1 );
+    const std::vector< ubyte > rgb  = makePixels( 3 );
+    const std::vector< ubyte > grayPNG       = makePNG( gray, 1, false );
+    const std::vector< ubyte > rgbPNG        = makePNG( rgb,  3, false );
+    const std::vector< ubyte > interlacedPNG = makePNG( rgb,  3, true  );
+
+    Image grayImage, rgbImage, interlacedImage;
+    return grayImage.loadPNG( grayPNG.data(), grayPNG.size() ) && matches( grayImage, gray, 1 ) &&
+           rgbImage.loadPNG( rgbPNG.data(), rgbPNG.size() ) && matches( rgbImage, rgb, 3 ) &&
+           interlacedImage.loadPNG( interlacedPNG.data(), interlacedPNG.size() ) && matches( interlacedImage, rgb, 3 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Image_loadPNGInvalid )
+    const std::vector< ubyte > png = makePNG( makePixels( 4 ), 4, false );
+
+    //Truncated data, data that isn't a PNG, and no data at all are all rejected
+    const ubyte notPNG[16] = { 'G', 'I', 'F', '8', '9', 'a' };
+    Image truncated, other, empty;
+    return !truncated.loadPNG( png.data(), png.size() / 2 ) && !truncated.isValid() &&
+           !other.loadPNG( notPNG, sizeof( notPNG ) ) &&
+           !empty.loadPNG( nullptr, 0 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Image_decodePNG )
+    const std::vector< ubyte > rgba = makePixels( 4 );
+    const std::vector< ubyte > png  = makePNG( rgba, 4, true );
+
+    Size2i size;
+    if( !Image::getPNGSize( png.data(), png.size(), size ) || size.width != cv_width || size.height != cv_height )
+        return false;
+
+    //A valid signature followed by a truncated IHDR chunk fails without an image to clean up
+    if( Image::getPNGSize( png.data(), 20, size ) )
+        return false;
+
+    //Rows are written with the given stride, and the padding between them is left alone
+    const std::size_t    stride = cv_width * 4 + 12;
+    std::vector< ubyte > storage( stride * cv_height, 0xCD );
+    if( !Image::decodePNG( png.data(), png.size(), storage.data(), storage.size(), stride ) )
+        return false;
+    for( int y = 0; y < cv_height; ++y ) {
+        if( std::memcmp( &storage[ y * stride ], &rgba[ y * cv_width * 4 ], cv_width * 4 ) != 0 )
+            return false;
+        for( std::size_t x = cv_width * 4; x < stride && y < cv_height - 1; ++x )
+            if( storage[ y * stride + x ] != 0xCD )
+                return false;
+    }
+
+    //The last row doesn't need padding after it, but storage too small for the image is rejected
+    return Image::decodePNG( png.data(), png.size(), storage.data(), stride * ( cv_height - 1 ) + cv_width * 4, stride ) &&
+           !Image::decodePNG( png.data(), png.size(), storage.data(), stride * ( cv_height - 1 ), stride ) &&
+           !Image::decodePNG( png.data(), png.size(), storage.data(), storage.size(), cv_width * 4 - 1 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Image_alignedStorage )
+    //Rows are padded to ROW_ALIGNMENT bytes, and every row starts on a multiple of it
+    CountingResource resource;
+    {
+        Image image( Size2i( 5, 3 ), &resource );
+        if( resource.live.size() != 1 || image.getStride() != Image::ROW_ALIGNMENT || image.getMemoryResource() != &resource || image.isView() )
+            return false;
+        for( int y = 0; y < 3; ++y )
+            if( (std::uintptr_t)image.getRow( y ) % Image::ROW_ALIGNMENT != 0 )
+                return false;
+
+        //PNGs are decoded into storage from the image's resource, replacing what it held
+        const std::vector< ubyte > rgba = makePixels( 4 );
+        const std::vector< ubyte > png  = makePNG( rgba, 4, false );
+        if( !image.loadPNG( png.data(), png.size() ) || !matches( image, rgba, 4 ) || resource.live.size() != 1 )
+            return false;
+
+        image.destroy();
+        if( resource.live.size() != 0 || image.isValid() || image.getStride() != 0 )
+            return false;
+    }
+    return resource.live.empty() && resource.mismatches == 0 && Image::getAlignedStride( 16 ) == 64 && Image::getAlignedStride( 17 ) == 128;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Image_move )
+    CountingResource resource;
+    {
+        Image a( Size2i( 4, 4 ), &resource );
+        Image b( Size2i( 8, 2 ), &resource );
+        ubyte* const pixels = b.getData();
+
+        //Moving b into a frees a's old pixels, and leaves b empty
+        a = std::move( b );
+        if( resource.live.size() != 1 || a.getData() != pixels || a.getSize().width != 8 || b.isValid() || b.getSize().width != 0 )
+            return false;
+
+        Image c( std::move( a ) );
+        if( c.getData() != pixels || a.isValid() || resource.live.size() != 1 )
+            return false;
+
+        //Images that were moved from can be reused
+        a.allocate( Size2i( 2, 2 ) );
+        if( resource.live.size() != 2 )
+            return false;
+    }
+    return resource.live.empty() && resource.mismatches == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Image_view )
+    //A view reads and writes the pixels it was given through its stride, without touching the padding or freeing them
+    const std::size_t    stride = 3 * 4 + 8;
+    std::vector< ubyte > pixels( stride * 2, 0xCD );
+    for( int y = 0; y < 2; ++y )
+        for( int x = 0; x < 3 * 4; ++x )
+            pixels[ y * stride + x ] = (ubyte)( y * 16 + x );
+    {
+        Image view = Image::view( pixels.data(), Size2i( 3, 2 ), stride );
+        if( !view.isView() || view.getStride() != stride || view.getRow( 1 ) != &pixels[ stride ] )
+            return false;
+        view.swapRedBlue();
+        view.flipVertical();
+    }
+    for( int y = 0; y < 2; ++y ) {
+        for( std::size_t x = 0; x < stride; ++x ) {
+            //Each row came from the other row, with its first and third channels swapped
+            const std::size_t channel = x % 4 == 0 ? x + 2 : x % 4 == 2 ? x - 2 : x;
+            const ubyte       expect  = x < 3 * 4 ? (ubyte)( ( 1 - y ) * 16 + channel ) : 0xCD;
+            if( pixels[ y * stride + x ] != expect )
+                return false;
+        }
+    }
+
+    //Views of an image share its pixels, and outliving views don't free them
+    Image owner( Size2i( 2, 2 ) );
+    {
+        const Image view = owner.getView();
+        if( view.getData() != owner.getData() || view.getStride() != owner.getStride() || owner.isView() )
+            return false;
+    }
+    try {
+        Image::view( pixels.data(), Size2i( 3, 2 ), 11 );
+        return false;
+    } catch( const ::Brimstone::SizeException& ) {
+    }
+    try {
+        Image::view( nullptr, Size2i( 3, 2 ) );
+        return false;
+    } catch( const ::Brimstone::NullPointerException& ) {
+    }
+    return owner.isValid() && !Image().getView().isValid();
+UT_TEST_END()
+
+UT_TEST_BEGIN( Image_resize )
+    //A 4x2 image, white on the left and black on the right, halved with a box filter
+    ubyte* const data = new ubyte[ 4 * 2 * 4 ];
+    for( int i = 0; i < 4 * 2; ++i ) {
+        const ubyte c = ( i % 4 ) < 2 ? 255 : 0;
+        data[ i * 4 ] = data[ i * 4 + 1 ] = data[ i * 4 + 2 ] = c;
+        data[ i * 4 + 3 ] = 255;
+    }
+    const Image image( data, Size2i( 4, 2 ) );
+    const Image resized = image.resize( Size2i( 2, 1 ), ResampleFilter::BOX );
+
+    const ubyte* const pixels = resized.getData();
+    return resized.getSize().width == 2 && resized.getSize().height == 1 &&
+           pixels[0] == 255 && pixels[2] == 255 && pixels[3] == 255 &&
+           pixels[4] == 0   && pixels[6] == 0   && pixels[7] == 255 &&
+           !Image().resize( Size2i( 2, 2 ) ).isValid();
+UT_TEST_END()
+
+UT_TEST_BEGIN( Image_buildMipChain )
+    //Every level down to 1x1 is built, and a solid color stays the same at every level
+    ubyte* const data = new ubyte[ 37 * 10 * 4 ];
+    for( int i = 0; i < 37 * 10 * 4; ++i )
+        data[i] = (ubyte)( 60 + ( i % 4 ) * 50 );
+    const Image image( data, Size2i( 37, 10 ) );
+
+    ThreadPool        pool( 2 );
+    const TextureData chain = image.buildMipChain( ResampleFilter::KAISER, true, &pool );
+    if( chain.getFormat() != TextureFormat::SRGB8_ALPHA8 || chain.getLevelCount() != 6 )
+        return false;
+    for( std::size_t level = 0; level < chain.getLevelCount(); ++level ) {
+        if( chain.getLevelSize( level ) != (std::size_t)::Brimstone::getMipDimension( 37, level ) * ::Brimstone::getMipDimension( 10, level ) * 4 )
+            return false;
+        for( std::size_t i = 0; i < chain.getLevelSize( level ); ++i )
+            if( chain.getLevel( level )[i] != 60 + ( i % 4 ) * 50 )
+                return false;
+    }
+    return image.buildMipChain().getFormat() == TextureFormat::RGBA8 && !Image().buildMipChain().isValid();
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
@@ -0,0 +1,229 @@
+/*
+test/ImageFile.cpp
+------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for ImageFile, and the Image and TextureData functions that use it
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                         //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/graphics/ImageFile.hpp>    //Brimstone::ImageFile, Brimstone::ImageCompression, Brimstone::IMAGE_FILE_ALIGNMENT
+#include <brimstone/graphics/TextureData.hpp>  //Brimstone::TextureData
+#include <brimstone/Image.hpp>                 //Brimstone::Image
+
+#include <cstdio>                              //std::fopen, std::fread, std::fwrite, std::fclose, std::remove
+#include <cstring>                             //std::memcmp, std::memcpy
+#include <vector>                              //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ImageFile;
+using ::Brimstone::ImageCompression;
+using ::Brimstone::TextureData;
+using ::Brimstone::TextureFormat;
+using ::Brimstone::Image;
+using ::Brimstone::Size2i;
+using ::Brimstone::ustring;
+using ::Brimstone::ubyte;
+
+
+
+
+//Constants
+constexpr int cv_width  = 37;
+constexpr int cv_height = 20;
+
+
+
+
+//Functions
+//Returns a cv_width x cv_height RGBA8 image with a gradient in it. Each row is repeated 4 times, so it compresses.
+Image makeImage() {
+    ubyte* data = new ubyte[ cv_width * cv_height * 4 ];
+    for( int i = 0; i < cv_width * cv_height; ++i ) {
+        data[ i * 4     ] = (ubyte)( i % cv_width );
+        data[ i * 4 + 1 ] = (ubyte)( i / cv_width / 4 );
+        data[ i * 4 + 2 ] = 0;
+        data[ i * 4 + 3 ] = 255;
+    }
+    return Image( data, Size2i( cv_width, cv_height ) );
+}
+
+//Returns true if the two images are the same size and have the same pixels, whatever their strides are
+bool equals( const Image& a, const Image& b ) {
+    if( a.getSize().width != b.getSize().width || a.getSize().height != b.getSize().height )
+        return false;
+    for( int y = 0; y < a.getSize().height; ++y )
+        if( std::memcmp( a.getRow( y ), b.getRow( y ), a.getSize().width * 4 ) != 0 )
+            return false;
+    return true;
+}
+
+std::vector< ubyte > readFile( const ustring& filename ) {
+    std::vector< ubyte > contents;
+    FILE* file = std::fopen( filename.c_str(), "rb" );
+    if( file == nullptr )
+        return contents;
+    ubyte buffer[4096];
+    for( std::size_t read; ( read = std::fread( buffer, 1, sizeof( buffer ), file ) ) > 0; )
+        contents.insert( contents.end(), buffer, buffer + read );
+    std::fclose( file );
+    return contents;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( ImageFile_saveLoad )
+    const Image source = makeImage();
+    const ustring raw = "ImageFile_saveLoad.bsi";
+    const ustring lz4 = "ImageFile_saveLoad_lz4.bsi";
+
+    Image rawImage, lz4Image;
+    const bool ok = source.save( raw ) && source.save( lz4, ImageCompression::LZ4 ) &&
+                    rawImage.load( raw ) && lz4Image.load( lz4 ) && equals( rawImage, source ) && equals( lz4Image, source );
+
+    //The compressed file is smaller, and its level is stored compressed
+    ImageFile file;
+    const bool compressed = file.open( lz4 ) && file.getCompression() == ImageCompression::LZ4 &&
+                            file.isLevelCompressed( 0 ) && file.getStoredLevelSize( 0 ) < file.getLevelSize( 0 ) &&
+                            readFile( lz4 ).size() < readFile( raw ).size();
+    file.close();
+
+    std::remove( raw.c_str() );
+    std::remove( lz4.c_str() );
+    return ok && compressed;
+UT_TEST_END()
+
+UT_TEST_BEGIN( ImageFile_mipmaps )
+    //Every level survives a round trip, and each one starts at an aligned offset in the mapped file
+    TextureData data;
+    data.set( makeImage() );
+    data.generateMipmaps();
+
+    const ustring filename = "ImageFile_mipmaps.bsi";
+    TextureData loaded;
+    bool ok = ImageFile::save( filename, data, ImageCompression::LZ4 ) && loaded.loadBSI( filename ) &&
+              loaded.getFormat() == TextureFormat::RGBA8 && loaded.getLevelCount() == data.getLevelCount() &&
+              loaded.getLevelCount() == 6;
+    for( std::size_t level = 0; ok && level < data.getLevelCount(); ++level )
+        ok = loaded.getLevelSize( level ) == data.getLevelSize( level ) &&
+             std::memcmp( loaded.getLevel( level ), data.getLevel( level ), data.getLevelSize( level ) ) == 0;
+
+    ImageFile file;
+    ok = ok && file.open( filename ) && file.getWidth() == cv_width && file.getHeight() == cv_height;
+    for( std::size_t level = 0; ok && level < file.getLevelCount(); ++level )
+        ok = (std::size_t)file.getLevel( level ) % ::Brimstone::IMAGE_FILE_ALIGNMENT == 0;
+    file.close();
+
+    std::remove( filename.c_str() );
+    return ok;
+UT_TEST_END()
+
+UT_TEST_BEGIN( ImageFile_openMemory )
+    //Block-compressed formats are stored as-is
+    std::vector< ubyte > blocks( 4 * 2 * 16 );
+    for( std::size_t i = 0; i < blocks.size(); ++i )
+        blocks[i] = (ubyte)( i * 31 );
+    TextureData data;
+    data.set( TextureFormat::BC7_RGBA, 16, 8, blocks.data() );
+
+    const ustring filename = "ImageFile_openMemory.bsi";
+    if( !ImageFile::save( filename, data ) )
+        return false;
+    const std::vector< ubyte > contents = readFile( filename );
+    std::remove( filename.c_str() );
+
+    ImageFile file;
+    std::vector< ubyte > decoded( blocks.size() );
+    return file.open( contents.data(), contents.size() ) && file.getFormat() == TextureFormat::BC7_RGBA &&
+           file.getLevelCount() == 1 && !file.isLevelCompressed( 0 ) &&
+           std::memcmp( file.getLevel( 0 ), blocks.data(), blocks.size() ) == 0 &&
+           file.decodeLevel( 0, decoded.data() ) && decoded == blocks;
+UT_TEST_END()
+
+UT_TEST_BEGIN( ImageFile_loadMemory )
+    //Images and TextureData load .bsi files in memory the same as files on disk
+    const Image source = makeImage();
+    TextureData data;
+    data.set( source );
+    data.generateMipmaps();
+    const ustring filename = "ImageFile_loadMemory.bsi";
+    if( !ImageFile::save( filename, data, ImageCompression::LZ4 ) )
+        return false;
+    const std::vector< ubyte > contents = readFile( filename );
+    std::remove( filename.c_str() );
+
+    Image       image;
+    TextureData loaded;
+    if( !image.load( contents.data(), contents.size() ) || !equals( image, source ) ||
+        !loaded.loadBSI( contents.data(), contents.size() ) || loaded.getLevelCount() != data.getLevelCount() )
+        return false;
+    for( std::size_t level = 0; level < data.getLevelCount(); ++level )
+        if( std::memcmp( loaded.getLevel( level ), data.getLevel( level ), data.getLevelSize( level ) ) != 0 )
+            return false;
+
+    //A truncated file is rejected, leaving both empty
+    return !image.load( contents.data(), contents.size() - 1 ) && !image.isValid() &&
+           !loaded.loadBSI( contents.data(), contents.size() - 1 ) && !loaded.isValid();
+UT_TEST_END()
+
+UT_TEST_BEGIN( ImageFile_invalid )
+    TextureData data;
+    data.set( makeImage() );
+    const ustring filename = "ImageFile_invalid.bsi";
+    if( !ImageFile::save( filename, data, ImageCompression::LZ4 ) )
+        return false;
+    const std::vector< ubyte > contents = readFile( filename );
+    std::remove( filename.c_str() );
+
+    //Truncated files, files with a bad identifier or impossible dimensions, and missing files are rejected
+    std::vector< ubyte > badIdentifier = contents;
+    badIdentifier[1] = 'X';
+    std::vector< ubyte > badSize = contents;
+    const ubyte zero[4] = {};
+    std::memcpy( &badSize[16], zero, sizeof( zero ) );
+
+    //Corrupt compressed data is detected when the level is decoded
+    std::vector< ubyte > badLevel = contents;
+    for( std::size_t i = ::Brimstone::IMAGE_FILE_ALIGNMENT; i < badLevel.size(); ++i )
+        badLevel[i] = 0xFF;
+
+    ImageFile file;
+    std::vector< ubyte > decoded( data.getLevelSize( 0 ) );
+    Image image;
+    return !file.open( contents.data(), contents.size() - 1 ) && !file.isOpen() &&
+           !file.open( badIdentifier.data(), badIdentifier.size() ) &&
+           !file.open( badSize.data(), badSize.size() ) &&
+           !file.open( contents.data(), 20 ) &&
+           file.open( badLevel.data(), badLevel.size() ) && !file.decodeLevel( 0, decoded.data() ) &&
+           !image.load( "ImageFile_missing.bsi" );
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
@@ -0,0 +1,226 @@
+/*
+test/ImageLoader.cpp
+--------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for ImageLoader
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                     //UT_TEST_BEGIN, UT_TEST_END
+#include "../utils.hpp"                    //UnitTest::encodePNG
+
+#include <brimstone/ImageLoader.hpp>       //Brimstone::ImageLoader, Brimstone::ImageBlob, Brimstone::ImageLoaderStats
+#include <brimstone/Exception.hpp>         //Brimstone::IException, Brimstone::Exception, Brimstone::UncaughtExceptionHandler
+#include <brimstone/signals/Delegate.hpp>  //Brimstone::Delegate
+#include <brimstone/util/ThreadPool.hpp>   //Brimstone::ThreadPool
+
+#include <atomic>                          //std::atomic
+#include <cstdio>                          //std::fopen, std::fwrite, std::fclose, std::remove
+#include <cstring>                         //std::memcmp
+#include <future>                          //std::future
+#include <mutex>                           //std::mutex, std::lock_guard
+#include <string>                          //std::to_string
+#include <utility>                         //std::move
+#include <vector>                          //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::Image;
+using ::Brimstone::ImageLoader;
+using ::Brimstone::ImageBlob;
+using ::Brimstone::ImageLoaderStats;
+using ::Brimstone::ThreadPool;
+using ::Brimstone::ustring;
+using ::Brimstone::ubyte;
+using ::Brimstone::IException;
+using ::Brimstone::Exception;
+using ::Brimstone::UncaughtExceptionHandler;
+
+
+
+
+//Constants
+constexpr int cv_imageCount = 32;
+
+
+
+
+//Globals
+std::atomic< int > g_uncaught( 0 );
+
+
+
+
+//Functions
+//Returns the pixels of the index-th test image, which is ( index + 1 ) x 3 pixels
+std::vector< ubyte > makePixels( const int index ) {
+    std::vector< ubyte > pixels( ( index + 1 ) * 3 * 4 );
+    for( std::size_t i = 0; i < pixels.size(); ++i )
+        pixels[i] = (ubyte)( i * 13 + index );
+    return pixels;
+}
+
+std::vector< std::vector< ubyte > > makePNGs() {
+    std::vector< std::vector< ubyte > > pngs;
+    for( int i = 0; i < cv_imageCount; ++i )
+        pngs.push_back( ::UnitTest::encodePNG( makePixels( i ).data(), i + 1, 3, 4 ) );
+    return pngs;
+}
+
+void countUncaught( const IException& ) {
+    ++g_uncaught;
+}
+
+bool isImage( const Image& image, const int index ) {
+    const std::vector< ubyte > pixels = makePixels( index );
+    if( !image.isValid() || image.getSize().width != index + 1 || image.getSize().height != 3 )
+        return false;
+    for( int y = 0; y < 3; ++y )
+        if( std::memcmp( image.getRow( y ), &pixels[ y * ( index + 1 ) * 4 ], ( index + 1 ) * 4 ) != 0 )
+            return false;
+    return true;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( ImageLoader_futures )
+    const std::vector< std::vector< ubyte > > pngs = makePNGs();
+    std::vector< ImageBlob > blobs;
+    for( const std::vector< ubyte >& png : pngs )
+        blobs.push_back( ImageBlob { png.data(), png.size() } );
+
+    //The futures are in the same order as the blobs
+    ImageLoader loader( 4 );
+    std::vector< std::future< Image > > futures = loader.load( blobs );
+    for( int i = 0; i < cv_imageCount; ++i )
+        if( !isImage( futures[i].get(), i ) )
+            return false;
+
+    loader.wait();
+    const ImageLoaderStats stats = loader.getStats();
+    std::size_t encoded = 0;
+    for( const std::vector< ubyte >& png : pngs )
+        encoded += png.size();
+    return loader.getThreadCount() == 4 && loader.getPendingCount() == 0 &&
+           stats.images == cv_imageCount && stats.failures == 0 && stats.encodedBytes == encoded &&
+           stats.decodedBytes == (std::size_t)( cv_imageCount * ( cv_imageCount + 1 ) / 2 * 3 * 4 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( ImageLoader_callback )
+    const std::vector< std::vector< ubyte > > pngs = makePNGs();
+    std::vector< ImageBlob > blobs;
+    for( const std::vector< ubyte >& png : pngs )
+        blobs.push_back( ImageBlob { png.data(), png.size() } );
+
+    //Every image is delivered exactly once before wait() returns, and can be moved out of
+    ThreadPool           pool( 3 );
+    ImageLoader          loader( pool );
+    std::mutex           mutex;
+    std::vector< Image > images( cv_imageCount );
+    std::vector< int >   delivered( cv_imageCount, 0 );
+    loader.load( blobs, [&]( const std::size_t index, Image& image ) {
+        std::lock_guard< std::mutex > l( mutex );
+        images[ index ] = std::move( image );
+        ++delivered[ index ];
+    } );
+    loader.wait();
+
+    for( int i = 0; i < cv_imageCount; ++i )
+        if( delivered[i] != 1 || !isImage( images[i], i ) )
+            return false;
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( ImageLoader_callbackThrows )
+    const std::vector< std::vector< ubyte > > pngs = makePNGs();
+    std::vector< ImageBlob > blobs;
+    for( const std::vector< ubyte >& png : pngs )
+        blobs.push_back( ImageBlob { png.data(), png.size() } );
+
+    //A callback that throws has its exception reported instead of ending the worker, and wait() still returns
+    const UncaughtExceptionHandler previous = ::Brimstone::getUncaughtExceptionHandler();
+    ::Brimstone::setUncaughtExceptionHandler( countUncaught );
+    g_uncaught = 0;
+
+    std::atomic< int > delivered( 0 );
+    {
+        ImageLoader loader( 2 );
+        loader.load( blobs, [&]( const std::size_t index, Image& ) {
+            if( index % 2 == 0 )
+                throw Exception( "Callback failed." );
+            ++delivered;
+        } );
+        loader.wait();
+    }
+    ::Brimstone::setUncaughtExceptionHandler( previous );
+    return g_uncaught == cv_imageCount / 2 && delivered == cv_imageCount / 2;
+UT_TEST_END()
+
+UT_TEST_BEGIN( ImageLoader_files )
+    const std::vector< std::vector< ubyte > > pngs = makePNGs();
+    std::vector< ustring > filenames;
+    for( int i = 0; i < 4; ++i ) {
+        filenames.push_back( "ImageLoader_files" + std::to_string( i ) + ".png" );
+        FILE* file = std::fopen( filenames.back().c_str(), "wb" );
+        std::fwrite( pngs[i].data(), 1, pngs[i].size(), file );
+        std::fclose( file );
+    }
+
+    //Files that don't exist are delivered as empty images
+    filenames.push_back( "ImageLoader_files_missing.png" );
+
+    ImageLoader loader( 2 );
+    std::vector< std::future< Image > > futures = loader.load( filenames );
+    bool ok = true;
+    for( int i = 0; i < 4; ++i )
+        ok = ok && isImage( futures[i].get(), i );
+    ok = ok && !futures[4].get().isValid();
+
+    for( int i = 0; i < 4; ++i )
+        std::remove( filenames[i].c_str() );
+
+    loader.wait();
+    const ImageLoaderStats stats = loader.getStats();
+    return ok && stats.images == 4 && stats.failures == 1 && stats.milliseconds > 0.0 && loader.getThroughput() > 0.0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( ImageLoader_invalid )
+    //Data that isn't a PNG counts as a failure
+    const ubyte notPNG[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    ImageLoader loader( 1 );
+    const bool ok = !loader.load( ImageBlob { notPNG, sizeof( notPNG ) } ).get().isValid();
+    loader.wait();
+    if( !ok || loader.getStats().failures != 1 )
+        return false;
+
+    loader.resetStats();
+    return loader.getStats().failures == 0 && loader.getThroughput() == 0.0;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
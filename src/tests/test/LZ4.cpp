@@ -0,0 +1,119 @@
+/*
+test/LZ4.cpp
+------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for the LZ4 functions
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"             //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/util/LZ4.hpp>  //Brimstone::compressLZ4, Brimstone::decompressLZ4, Brimstone::getLZ4CompressBound
+#include <brimstone/types.hpp>     //Brimstone::ubyte
+
+#include <random>                  //std::mt19937
+#include <vector>                  //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ubyte;
+
+
+
+
+//Functions
+//Compresses and decompresses the given data, returning the size of the block (or 0 if the round trip failed)
+std::size_t roundTrip( const std::vector< ubyte >& data ) {
+    std::vector< ubyte > block( ::Brimstone::getLZ4CompressBound( data.size() ) );
+    const std::size_t size = ::Brimstone::compressLZ4( data.data(), data.size(), block.data(), block.size() );
+    if( size == 0 )
+        return 0;
+
+    std::vector< ubyte > decompressed( data.size() );
+    if( !::Brimstone::decompressLZ4( block.data(), size, decompressed.data(), decompressed.size() ) || decompressed != data )
+        return 0;
+    return size;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( LZ4_roundTrip )
+    //Repetitive data compresses well, including runs longer than the distance they repeat at
+    std::vector< ubyte > repetitive( 100000 );
+    for( std::size_t i = 0; i < repetitive.size(); ++i )
+        repetitive[i] = (ubyte)( ( i / 64 ) % 7 );
+    const std::size_t repetitiveSize = roundTrip( repetitive );
+
+    //Random data doesn't compress at all, but still fits in the bound
+    std::mt19937 random( 7 );
+    std::vector< ubyte > noise( 70000 );
+    for( ubyte& b : noise )
+        b = (ubyte)random();
+    const std::size_t noiseSize = roundTrip( noise );
+
+    return repetitiveSize != 0 && repetitiveSize < repetitive.size() / 50 && noiseSize > noise.size();
+UT_TEST_END()
+
+UT_TEST_BEGIN( LZ4_smallInputs )
+    //Inputs too small to contain a match are stored as literals
+    for( std::size_t size = 0; size <= 20; ++size ) {
+        std::vector< ubyte > data( size, 'a' );
+        if( roundTrip( data ) == 0 )
+            return false;
+    }
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( LZ4_knownBlock )
+    //A block from the reference implementation: the literal "abcd", then a 12-byte match 4 bytes back, then the literals "abcde"
+    const ubyte block[] = { 0x48, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x50, 'a', 'b', 'c', 'd', 'e' };
+    const char  text[]  = "abcdabcdabcdabcdabcde";
+    ubyte out[ sizeof( text ) - 1 ];
+    return ::Brimstone::decompressLZ4( block, sizeof( block ), out, sizeof( out ) ) &&
+           std::vector< ubyte >( out, out + sizeof( out ) ) == std::vector< ubyte >( text, text + sizeof( out ) );
+UT_TEST_END()
+
+UT_TEST_BEGIN( LZ4_corrupt )
+    std::vector< ubyte > data( 4096 );
+    for( std::size_t i = 0; i < data.size(); ++i )
+        data[i] = (ubyte)( i % 13 );
+    std::vector< ubyte > block( ::Brimstone::getLZ4CompressBound( data.size() ) );
+    block.resize( ::Brimstone::compressLZ4( data.data(), data.size(), block.data(), block.size() ) );
+
+    //Truncated blocks, blocks that decompress to the wrong size, and matches that refer back past the start are rejected
+    std::vector< ubyte > out( data.size() + 1 );
+    const ubyte badDistance[] = { 0x1F, 'a', 0x02, 0x00, 0x00 };
+    return !::Brimstone::decompressLZ4( block.data(), block.size() - 1, out.data(), data.size() ) &&
+           !::Brimstone::decompressLZ4( block.data(), block.size(), out.data(), data.size() - 1 ) &&
+           !::Brimstone::decompressLZ4( block.data(), block.size(), out.data(), data.size() + 1 ) &&
+           !::Brimstone::decompressLZ4( badDistance, sizeof( badDistance ), out.data(), out.size() ) &&
+           ::Brimstone::compressLZ4( data.data(), data.size(), block.data(), 8 ) == 0;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
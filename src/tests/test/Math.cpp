@@ -0,0 +1,106 @@
+/*
+test/Math.cpp
+-------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for math utilities
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"              //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/util/Math.hpp>  //Brimstone::floatToHalf, Brimstone::halfToFloat
+#include <brimstone/types.hpp>      //Brimstone::uint16, Brimstone::uint32
+
+#include <limits>                   //std::numeric_limits
+#include <cmath>                    //std::isnan, std::isinf
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::uint16;
+using ::Brimstone::uint32;
+using ::Brimstone::floatToHalf;
+using ::Brimstone::halfToFloat;
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( Math_floatToHalf )
+    return floatToHalf(  0.0f     ) == 0x0000 &&
+           floatToHalf( -0.0f     ) == 0x8000 &&
+           floatToHalf(  1.0f     ) == 0x3C00 &&
+           floatToHalf( -2.0f     ) == 0xC000 &&
+           floatToHalf(  0.5f     ) == 0x3800 &&
+           floatToHalf(  65504.0f ) == 0x7BFF;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Math_floatToHalf_round )
+    //1 + 2^-11 is halfway between 1 and the next half; ties round to even
+    return floatToHalf( 1.00048828125f ) == 0x3C00 &&
+           floatToHalf( 1.00146484375f ) == 0x3C02;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Math_floatToHalf_overflow )
+    return floatToHalf(  100000.0f                                ) == 0x7C00 &&
+           floatToHalf( -std::numeric_limits< float >::infinity() ) == 0xFC00;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Math_floatToHalf_subnormal )
+    //Smallest positive subnormal half is 2^-24
+    return floatToHalf( 5.9604644775390625e-8f ) == 0x0001 &&
+           floatToHalf( 1e-10f                  ) == 0x0000;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Math_floatToHalf_nan )
+    const uint16 h = floatToHalf( std::numeric_limits< float >::quiet_NaN() );
+    return ( h & 0x7C00 ) == 0x7C00 &&
+           ( h & 0x03FF ) != 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Math_halfToFloat )
+    return halfToFloat( 0x0000 ) ==  0.0f     &&
+           halfToFloat( 0x3C00 ) ==  1.0f     &&
+           halfToFloat( 0xC000 ) == -2.0f     &&
+           halfToFloat( 0x7BFF ) ==  65504.0f &&
+           halfToFloat( 0x0001 ) ==  5.9604644775390625e-8f &&
+           std::isinf( halfToFloat( 0x7C00 ) ) &&
+           std::isnan( halfToFloat( 0x7E00 ) );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Math_halfRoundTrip )
+    //Every finite half converts to a float and back unchanged
+    for( uint32 i = 0; i < 0x10000; ++i ) {
+        const uint16 h = (uint16)i;
+        if( ( h & 0x7C00 ) == 0x7C00 )
+            continue;
+        if( floatToHalf( halfToFloat( h ) ) != h )
+            return false;
+    }
+    return true;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
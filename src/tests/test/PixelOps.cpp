@@ -0,0 +1,190 @@
+/*
+test/PixelOps.cpp
+-----------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for the pixel operations.
+    Each operation is checked against a reference with every instruction set this CPU supports.
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                  //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/util/PixelOps.hpp>  //Brimstone::convertRGBToRGBA, Brimstone::swapRedBlue, Brimstone::SIMDLevel, ...
+
+#include <algorithm>                    //std::min
+#include <cmath>                        //std::pow
+#include <functional>                   //std::function
+#include <random>                       //std::mt19937
+#include <vector>                       //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::SIMDLevel;
+using ::Brimstone::ubyte;
+
+
+
+
+//Constants
+//Enough pixels for several vectors of every width, plus some left over
+constexpr std::size_t cv_pixelCount = 67;
+
+
+
+
+//Functions
+std::vector< ubyte > makeRandom( const std::size_t size ) {
+    std::mt19937 random( (unsigned)size );
+    std::vector< ubyte > data( size );
+    for( ubyte& b : data )
+        b = (ubyte)random();
+    return data;
+}
+
+//Runs the given test once with each instruction set this CPU supports, then goes back to the best one
+bool forEachLevel( const std::function< bool() >& test ) {
+    bool ok = true;
+    for( SIMDLevel level : { SIMDLevel::NONE, SIMDLevel::SSSE3, SIMDLevel::AVX2 } ) {
+        if( level > ::Brimstone::getSupportedSIMDLevel() )
+            break;
+        ::Brimstone::setSIMDLevel( level );
+        ok = ok && ::Brimstone::getSIMDLevel() == level && test();
+    }
+    ::Brimstone::setSIMDLevel( ::Brimstone::getSupportedSIMDLevel() );
+    return ok;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( PixelOps_convertRGBToRGBA )
+    return forEachLevel( []() {
+        for( std::size_t count = 0; count <= cv_pixelCount; ++count ) {
+            const std::vector< ubyte > rgb = makeRandom( count * 3 );
+            std::vector< ubyte > data( count * 4 );
+            std::copy( rgb.begin(), rgb.end(), data.begin() );
+
+            ::Brimstone::convertRGBToRGBA( data.data(), count );
+            for( std::size_t i = 0; i < count; ++i )
+                if( data[ i * 4 ] != rgb[ i * 3 ] || data[ i * 4 + 1 ] != rgb[ i * 3 + 1 ] || data[ i * 4 + 2 ] != rgb[ i * 3 + 2 ] || data[ i * 4 + 3 ] != 255 )
+                    return false;
+        }
+        return true;
+    } );
+UT_TEST_END()
+
+UT_TEST_BEGIN( PixelOps_swapRedBlue )
+    return forEachLevel( []() {
+        const std::vector< ubyte > rgba = makeRandom( cv_pixelCount * 4 );
+        std::vector< ubyte > data = rgba;
+        ::Brimstone::swapRedBlue( data.data(), cv_pixelCount );
+        for( std::size_t i = 0; i < cv_pixelCount; ++i )
+            if( data[ i * 4 ] != rgba[ i * 4 + 2 ] || data[ i * 4 + 1 ] != rgba[ i * 4 + 1 ] || data[ i * 4 + 2 ] != rgba[ i * 4 ] || data[ i * 4 + 3 ] != rgba[ i * 4 + 3 ] )
+                return false;
+        return true;
+    } );
+UT_TEST_END()
+
+UT_TEST_BEGIN( PixelOps_premultiplyAlpha )
+    //Every combination of channel and alpha rounds to the nearest value
+    return forEachLevel( []() {
+        std::vector< ubyte > data( 256 * 256 * 4 );
+        for( std::size_t i = 0; i < 256 * 256; ++i ) {
+            data[ i * 4     ] = data[ i * 4 + 1 ] = data[ i * 4 + 2 ] = (ubyte)( i % 256 );
+            data[ i * 4 + 3 ] = (ubyte)( i / 256 );
+        }
+        ::Brimstone::premultiplyAlpha( data.data(), 256 * 256 );
+        for( std::size_t i = 0; i < 256 * 256; ++i ) {
+            const std::size_t expected = ( ( i % 256 ) * ( i / 256 ) * 2 + 255 ) / 510;
+            if( data[ i * 4 ] != expected || data[ i * 4 + 2 ] != expected || data[ i * 4 + 3 ] != i / 256 )
+                return false;
+        }
+        return true;
+    } );
+UT_TEST_END()
+
+UT_TEST_BEGIN( PixelOps_unpremultiplyAlpha )
+    //Every combination of channel and alpha rounds to the nearest value, channels greater than alpha saturate,
+    //and pixels with no alpha become black
+    return forEachLevel( []() {
+        std::vector< ubyte > data( 256 * 256 * 4 );
+        for( std::size_t i = 0; i < 256 * 256; ++i ) {
+            data[ i * 4     ] = data[ i * 4 + 1 ] = data[ i * 4 + 2 ] = (ubyte)( i % 256 );
+            data[ i * 4 + 3 ] = (ubyte)( i / 256 );
+        }
+        ::Brimstone::unpremultiplyAlpha( data.data(), 256 * 256 );
+        for( std::size_t i = 0; i < 256 * 256; ++i ) {
+            const std::size_t c = i % 256;
+            const std::size_t a = i / 256;
+            const std::size_t expected = ( a == 0 ) ? 0 : std::min( ( c * 510 + a ) / ( 2 * a ), (std::size_t)255 );
+            if( data[ i * 4 ] != expected || data[ i * 4 + 1 ] != expected || data[ i * 4 + 3 ] != a )
+                return false;
+        }
+        return true;
+    } );
+UT_TEST_END()
+
+UT_TEST_BEGIN( PixelOps_convertSRGBToLinear )
+    return forEachLevel( []() {
+        std::vector< ubyte > data( 256 * 4 );
+        for( std::size_t i = 0; i < 256; ++i )
+            data[ i * 4 ] = data[ i * 4 + 1 ] = data[ i * 4 + 2 ] = data[ i * 4 + 3 ] = (ubyte)i;
+        ::Brimstone::convertSRGBToLinear( data.data(), 256 );
+
+        for( std::size_t i = 0; i < 256; ++i ) {
+            const double c = i / 255.0;
+            const double l = ( c <= 0.04045 ) ? c / 12.92 : std::pow( ( c + 0.055 ) / 1.055, 2.4 );
+            if( data[ i * 4 ] != (ubyte)( l * 255.0 + 0.5 ) || data[ i * 4 + 2 ] != data[ i * 4 ] || data[ i * 4 + 3 ] != i )
+                return false;
+        }
+        return data[ 255 * 4 ] == 255 && data[ 128 * 4 ] == 55 && data[0] == 0;
+    } );
+UT_TEST_END()
+
+UT_TEST_BEGIN( PixelOps_flipRows )
+    //Rows of an odd number of bytes, with padding between them that's left alone
+    return forEachLevel( []() {
+        constexpr std::size_t rowSize = 75;
+        constexpr std::size_t stride  = 80;
+        for( std::size_t rows = 0; rows <= 5; ++rows ) {
+            const std::vector< ubyte > image = makeRandom( rows * stride );
+            std::vector< ubyte > data = image;
+            ::Brimstone::flipRows( data.data(), rowSize, rows, stride );
+            for( std::size_t y = 0; y < rows; ++y ) {
+                for( std::size_t x = 0; x < stride; ++x ) {
+                    const ubyte expected = x < rowSize ? image[ ( rows - 1 - y ) * stride + x ] : image[ y * stride + x ];
+                    if( data[ y * stride + x ] != expected )
+                        return false;
+                }
+            }
+        }
+        return true;
+    } );
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
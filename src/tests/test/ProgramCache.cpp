@@ -0,0 +1,113 @@
+/*
+test/ProgramCache.cpp
+---------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for ProgramCache and hashFNV1a
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                          //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/graphics/ProgramCache.hpp>  //Brimstone::ProgramCache, Brimstone::ProgramSource
+#include <brimstone/util/Hash.hpp>              //Brimstone::hashFNV1a
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ProgramCache;
+using ::Brimstone::ProgramSource;
+using ::Brimstone::ustring;
+using ::Brimstone::uint64;
+
+
+
+
+//Functions
+ProgramSource makeSource() {
+    ProgramSource source;
+    source.vertex     = "#version 330\nin vec2 position;\nvoid main() { gl_Position = vec4( position, 0, 1 ); }\n";
+    source.fragment   = "#version 330\nout vec4 color;\nvoid main() { color = vec4( 1 ); }\n";
+    source.defines    = { "USE_FOG", "LIGHTS 4" };
+    source.attributes = { { "position", 0 } };
+    return source;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( Hash_FNV1a )
+    return Brimstone::hashFNV1a( "", 0 )       == 0xcbf29ce484222325ull &&
+           Brimstone::hashFNV1a( "a", 1 )      == 0xaf63dc4c8601ec8cull &&
+           Brimstone::hashFNV1a( "foobar", 6 ) == 0x85944171f73967e8ull &&
+           Brimstone::hashFNV1a( ustring( "ab" ), Brimstone::hashFNV1a( ustring( "c" ) ) ) !=
+           Brimstone::hashFNV1a( ustring( "a" ),  Brimstone::hashFNV1a( ustring( "bc" ) ) );
+UT_TEST_END()
+
+UT_TEST_BEGIN( ProgramCache_applyDefines )
+    const std::vector< ustring > defines = { "USE_FOG", "LIGHTS 4" };
+    return ProgramCache::applyDefines( "#version 330\nvoid main() {}\n", defines ) == "#version 330\n#define USE_FOG\n#define LIGHTS 4\nvoid main() {}\n" &&
+           ProgramCache::applyDefines( "void main() {}\n", defines )               == "#define USE_FOG\n#define LIGHTS 4\nvoid main() {}\n" &&
+           ProgramCache::applyDefines( "#version 330", defines )                   == "#version 330\n#define USE_FOG\n#define LIGHTS 4\n" &&
+           ProgramCache::applyDefines( "#version 330\n", {} )                      == "#version 330\n";
+UT_TEST_END()
+
+UT_TEST_BEGIN( ProgramCache_computeKey )
+    const ProgramSource source = makeSource();
+    const uint64        key    = ProgramCache::computeKey( source, "GPU", "4.6.0 Driver 1.0" );
+
+    //Same inputs, same key
+    if( ProgramCache::computeKey( makeSource(), "GPU", "4.6.0 Driver 1.0" ) != key )
+        return false;
+
+    //Anything that could change the binary changes the key
+    ProgramSource changed = makeSource();
+    changed.fragment += "\n";
+    if( ProgramCache::computeKey( changed, "GPU", "4.6.0 Driver 1.0" ) == key )
+        return false;
+
+    changed = makeSource();
+    changed.defines[1] = "LIGHTS 8";
+    if( ProgramCache::computeKey( changed, "GPU", "4.6.0 Driver 1.0" ) == key )
+        return false;
+
+    changed = makeSource();
+    changed.attributes[0].second = 1;
+    if( ProgramCache::computeKey( changed, "GPU", "4.6.0 Driver 1.0" ) == key )
+        return false;
+
+    //Moving text between shaders changes the key
+    changed = makeSource();
+    changed.geometry = changed.vertex;
+    changed.vertex.clear();
+    if( ProgramCache::computeKey( changed, "GPU", "4.6.0 Driver 1.0" ) == key )
+        return false;
+
+    return ProgramCache::computeKey( source, "Other GPU", "4.6.0 Driver 1.0" ) != key &&
+           ProgramCache::computeKey( source, "GPU",       "4.6.0 Driver 1.1" ) != key;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
@@ -0,0 +1,814 @@
+/*
+test/Render.cpp
+---------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Render regression tests.
+    These render simple scenes into a Framebuffer with an offscreen Graphics and check the pixels read back from it.
+    They're skipped on machines where an offscreen context can't be created.
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                           //UT_TEST_BEGIN, UT_TEST_END
+#include "../Exception.hpp"                      //UnitTest::SkipTest
+#include "../utils.hpp"                          //UnitTest::encodePNG
+
+#include <brimstone/Graphics.hpp>                //Brimstone::Graphics, Brimstone::Framebuffer, Brimstone::Texture, Brimstone::Program, etc.
+#include <brimstone/graphics/CommandBuffer.hpp>  //Brimstone::CommandBuffer
+#include <brimstone/graphics/GpuProfiler.hpp>    //Brimstone::GpuProfiler, Brimstone::GpuProfilerFrame, Brimstone::GpuScope
+#include <brimstone/graphics/RenderTarget.hpp>   //Brimstone::RenderTarget
+#include <brimstone/Image.hpp>                   //Brimstone::Image
+#include <brimstone/AssetCache.hpp>              //Brimstone::AssetCache, Brimstone::TextureHandle
+#include <brimstone/Exception.hpp>               //Brimstone::IException, Brimstone::BoundsException, Brimstone::GraphicsException, Brimstone::UncaughtExceptionHandler
+#include <brimstone/signals/Delegate.hpp>        //Brimstone::Delegate
+
+#include <cstdlib>                               //std::abs
+#include <cstring>                               //std::strcmp
+#include <string>                                //std::string
+#include <vector>                                //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::Graphics;
+using ::Brimstone::Framebuffer;
+using ::Brimstone::Texture;
+using ::Brimstone::TextureFormat;
+using ::Brimstone::Shader;
+using ::Brimstone::ShaderType;
+using ::Brimstone::Program;
+using ::Brimstone::VertexBuffer;
+using ::Brimstone::IndexBuffer;
+using ::Brimstone::DrawIndirectBuffer;
+using ::Brimstone::VertexLayout;
+using ::Brimstone::VertexAttributeType;
+using ::Brimstone::BlendMode;
+using ::Brimstone::Image;
+using ::Brimstone::GraphicsStats;
+using ::Brimstone::GpuProfiler;
+using ::Brimstone::GpuProfilerFrame;
+using ::Brimstone::GpuScope;
+using ::Brimstone::IException;
+using ::Brimstone::UncaughtExceptionHandler;
+using ::Brimstone::RenderTarget;
+using ::Brimstone::CommandBuffer;
+using ::Brimstone::AssetCache;
+using ::Brimstone::TextureHandle;
+using ::Brimstone::ubyte;
+using ::Brimstone::uint16;
+using ::Brimstone::uint64;
+
+
+
+
+//Constants
+constexpr int cv_size = 32;
+
+constexpr const char* cv_vertexSource =
+    "#version 130\n"
+    "in vec3 position;\n"
+    "void main() { gl_Position = vec4( position, 1.0 ); }\n";
+
+constexpr const char* cv_fragmentSource =
+    "#version 130\n"
+    "uniform vec4 u_color;\n"
+    "void main() { gl_FragColor = u_color; }\n";
+
+
+
+
+//Functions
+//Returns an offscreen Graphics shared by every render test, with its context current.
+//Throws SkipTest if an offscreen context can't be created on this machine.
+Graphics& getGraphics() {
+    static Graphics    graphics;
+    static bool        initialized = false;
+    static std::string error;
+
+    if( !initialized && error.empty() ) {
+        try {
+            graphics.init();
+            graphics.begin();
+            initialized = true;
+        } catch( const ::Brimstone::IException& e ) {
+            error = e.getDescription();
+        }
+    }
+    if( !initialized )
+        throw ::UnitTest::SkipTest( "no offscreen context: " + error );
+
+    //Benchmarks create contexts of their own, so make sure this one is current
+    graphics.begin();
+    return graphics;
+}
+
+//Creates a cv_size x cv_size render target with a depth buffer, binds it, and resets the state the tests change
+void beginTarget( Graphics& graphics, Texture& colorOut, Framebuffer& framebufferOut ) {
+    colorOut = graphics.createTexture();
+    colorOut.setStorage( cv_size, cv_size, TextureFormat::RGBA8, 1 );
+
+    framebufferOut = graphics.createFramebuffer();
+    framebufferOut.setColor( colorOut );
+    framebufferOut.setDepth( cv_size, cv_size );
+    framebufferOut.bind();
+
+    graphics.setViewport( 0, 0, cv_size, cv_size );
+    graphics.setScissorTest( false );
+    graphics.setDepthTest( false );
+    graphics.setDepthMask( true );
+    graphics.setBlendMode( BlendMode::NONE );
+    graphics.setClearDepth( 1.0f );
+}
+
+//Builds a program that fills whatever it draws with the u_color uniform
+Program createColorProgram( Graphics& graphics ) {
+    Shader vertex = graphics.createShader( ShaderType::VERTEX );
+    vertex.setSource( cv_vertexSource );
+    vertex.compile();
+
+    Shader fragment = graphics.createShader( ShaderType::FRAGMENT );
+    fragment.setSource( cv_fragmentSource );
+    fragment.compile();
+
+    Program program = graphics.createProgram();
+    program.attachShader( vertex );
+    program.attachShader( fragment );
+    program.bindAttribute( "position", 0 );
+    program.link();
+    return program;
+}
+
+//Draws a rectangle in normalized device coordinates at the given depth with the given program, which must be in use
+void drawRect( Graphics& graphics, const float left, const float bottom, const float right, const float top, const float z ) {
+    const float positions[] = {
+        left,  bottom, z,
+        right, bottom, z,
+        right, top,    z,
+        left,  top,    z
+    };
+    const uint16 indices[] = { 0, 1, 2, 0, 2, 3 };
+
+    VertexBuffer vertexBuffer = graphics.createVertexBuffer();
+    vertexBuffer.setLayout( VertexLayout().add( 0, 3, VertexAttributeType::FLOAT ) );
+    vertexBuffer.set( positions, sizeof( positions ) );
+
+    IndexBuffer indexBuffer = graphics.createIndexBuffer();
+    indexBuffer.set( indices, 6 );
+
+    graphics.drawIndexed( vertexBuffer, indexBuffer );
+}
+
+//Returns true if the pixel at ( x, y ), measured from the top-left of the image, is within tolerance of the given color
+bool isPixel( const Image& image, const int x, const int y, const int r, const int g, const int b, const int a, const int tolerance = 1 ) {
+    const ubyte* pixel = image.getData() + ( y * image.getSize().width + x ) * 4;
+    return std::abs( pixel[0] - r ) <= tolerance && std::abs( pixel[1] - g ) <= tolerance &&
+           std::abs( pixel[2] - b ) <= tolerance && std::abs( pixel[3] - a ) <= tolerance;
+}
+
+//Counts the errors passed to uncaughtException() while it's installed as the handler
+int g_uncaught = 0;
+void countUncaught( const IException& ) {
+    ++g_uncaught;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( Render_clear )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+    if( !framebuffer.isComplete() )
+        return false;
+
+    graphics.setClearColor( 1.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+
+    Image image;
+    framebuffer.read( image );
+    if( image.getSize().width != cv_size || image.getSize().height != cv_size )
+        return false;
+
+    for( int y = 0; y < cv_size; ++y )
+        for( int x = 0; x < cv_size; ++x )
+            if( !isPixel( image, x, y, 255, 0, 0, 255, 0 ) )
+                return false;
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_readIsTopDown )
+    //The scissor box is measured from the top of the framebuffer, like an Image is, so the green strip should be at the top of the image
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    graphics.setClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+    graphics.setScissorTest( true );
+    graphics.setScissorBox( 0, 0, cv_size, 8 );
+    graphics.setClearColor( 0.0f, 1.0f, 0.0f, 1.0f );
+    graphics.clear();
+    graphics.setScissorTest( false );
+
+    Image image;
+    framebuffer.read( image );
+    return isPixel( image, 0,           0,           0, 255, 0, 255, 0 ) &&
+           isPixel( image, 5,           7,           0, 255, 0, 255, 0 ) &&
+           isPixel( image, 5,           8,           0, 0,   0, 255, 0 ) &&
+           isPixel( image, cv_size - 1, cv_size - 1, 0, 0,   0, 255, 0 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_readRegion )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    graphics.setClearColor( 0.0f, 0.0f, 1.0f, 1.0f );
+    graphics.clear();
+    graphics.setScissorTest( true );
+    graphics.setScissorBox( 4, 4, 2, 2 );
+    graphics.setClearColor( 1.0f, 1.0f, 1.0f, 1.0f );
+    graphics.clear();
+    graphics.setScissorTest( false );
+
+    //A 4x4 region with the white square in the right half of its top two rows
+    ubyte pixels[ 4 * 4 * 4 ];
+    framebuffer.read( 2, 4, 4, 4, pixels );
+    const ubyte* topLeft     = pixels;
+    const ubyte* topRight    = pixels + ( 0 * 4 + 3 ) * 4;
+    const ubyte* bottomRight = pixels + ( 3 * 4 + 3 ) * 4;
+    if( topLeft[0] != 0 || topLeft[2] != 255 || topRight[0] != 255 || topRight[1] != 255 || bottomRight[0] != 0 || bottomRight[2] != 255 )
+        return false;
+
+    //Regions have to fit in the framebuffer
+    try {
+        framebuffer.read( cv_size - 2, 0, 4, 4, pixels );
+        return false;
+    } catch( const ::Brimstone::BoundsException& ) {
+    }
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_drawRect )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    graphics.setClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+
+    //Fill the upper-left quarter; +y is up in normalized device coordinates
+    Program program = createColorProgram( graphics );
+    program.use();
+    program.setUniform( "u_color", 0.0f, 0.0f, 1.0f, 1.0f );
+    drawRect( graphics, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f );
+    program.stopUsing();
+
+    Image image;
+    framebuffer.read( image );
+    return isPixel( image, 0,               0,               0, 0, 255, 255, 0 ) &&
+           isPixel( image, cv_size / 2 - 1, cv_size / 2 - 1, 0, 0, 255, 255, 0 ) &&
+           isPixel( image, cv_size / 2,     0,               0, 0, 0,   255, 0 ) &&
+           isPixel( image, 0,               cv_size / 2,     0, 0, 0,   255, 0 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_depthTest )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    graphics.setClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+    graphics.setDepthTest( true );
+
+    //The nearer rectangle is drawn first; the farther one shouldn't draw over it
+    Program program = createColorProgram( graphics );
+    program.use();
+    program.setUniform( "u_color", 1.0f, 0.0f, 0.0f, 1.0f );
+    drawRect( graphics, -1.0f, -1.0f, 0.0f, 1.0f, -0.5f );
+    program.setUniform( "u_color", 0.0f, 1.0f, 0.0f, 1.0f );
+    drawRect( graphics, -1.0f, -1.0f, 1.0f, 1.0f, 0.5f );
+    program.stopUsing();
+    graphics.setDepthTest( false );
+
+    Image image;
+    framebuffer.read( image );
+    return isPixel( image, 0,           cv_size / 2, 255, 0,   0, 255, 0 ) &&
+           isPixel( image, cv_size - 1, cv_size / 2, 0,   255, 0, 255, 0 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_blendTransparency )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    graphics.setClearColor( 0.0f, 0.0f, 1.0f, 1.0f );
+    graphics.clear();
+    graphics.setBlendMode( BlendMode::TRANSPARENCY );
+
+    Program program = createColorProgram( graphics );
+    program.use();
+    program.setUniform( "u_color", 1.0f, 0.0f, 0.0f, 0.5f );
+    drawRect( graphics, -1.0f, -1.0f, 1.0f, 1.0f, 0.0f );
+    program.stopUsing();
+    graphics.setBlendMode( BlendMode::NONE );
+
+    //Half red over blue; the destination stays opaque
+    Image image;
+    framebuffer.read( image );
+    return isPixel( image, cv_size / 2, cv_size / 2, 128, 0, 128, 255 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_graphicsStats )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    const GraphicsStats before = graphics.getStats();
+    graphics.setClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+
+    Program program = createColorProgram( graphics );
+    program.use();
+    program.setUniform( "u_color", 1.0f, 1.0f, 1.0f, 1.0f );
+    drawRect( graphics, -1.0f, -1.0f, 0.0f, 0.0f, 0.0f );
+    drawRect( graphics, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f );
+    program.stopUsing();
+
+    const GraphicsStats after = graphics.getStats();
+    return after.drawCalls    - before.drawCalls    == 2 &&
+           after.instances    - before.instances    == 2 &&
+           after.triangles    - before.triangles    == 4 &&
+           after.clears       - before.clears       == 1 &&
+           after.stateChanges - before.stateChanges == 1;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_multiDrawIndirect )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    //Two rectangles sharing one vertex buffer and one set of indices: the left half of the target, and its top-right quarter
+    const float positions[] = {
+        -1.0f, -1.0f, 0.0f,    0.0f, -1.0f, 0.0f,    0.0f, 1.0f, 0.0f,    -1.0f, 1.0f, 0.0f,
+         0.0f,  0.0f, 0.0f,    1.0f,  0.0f, 0.0f,    1.0f, 1.0f, 0.0f,     0.0f, 1.0f, 0.0f
+    };
+    const uint16 indices[] = { 0, 1, 2, 0, 2, 3 };
+
+    VertexBuffer vertexBuffer = graphics.createVertexBuffer();
+    vertexBuffer.setLayout( VertexLayout().add( 0, 3, VertexAttributeType::FLOAT ) );
+    vertexBuffer.set( positions, sizeof( positions ) );
+    IndexBuffer indexBuffer = graphics.createIndexBuffer();
+    indexBuffer.set( indices, 6 );
+
+    DrawIndirectBuffer commands = graphics.createDrawIndirectBuffer( 16 );
+    if( commands.getCapacity() != 16 )
+        return false;
+
+    graphics.setClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+    Program program = createColorProgram( graphics );
+    program.use();
+    program.setUniform( "u_color", 0.0f, 1.0f, 0.0f, 1.0f );
+
+    commands.beginFrame();
+    commands.add( 6, 0, 0 );
+    commands.add( 6, 0, 4 );
+    if( commands.getBatchCount() != 2 || commands.getRemaining() != 14 )
+        return false;
+
+    const GraphicsStats before = graphics.getStats();
+    graphics.multiDrawIndirect( vertexBuffer, indexBuffer, commands );
+    const GraphicsStats after = graphics.getStats();
+    if( commands.getBatchCount() != 0 )
+        return false;
+
+#ifdef BS_CHECK_INDEX
+    //Commands can't draw past the end of the index buffer
+    commands.add( 6, 3 );
+    try {
+        graphics.multiDrawIndirect( vertexBuffer, indexBuffer, commands );
+        return false;
+    } catch( const ::Brimstone::BoundsException& ) {
+    }
+#endif //BS_CHECK_INDEX
+    commands.endFrame();
+    program.stopUsing();
+
+    //Both rectangles are drawn by one draw call
+    if( after.drawCalls - before.drawCalls != 1 || after.instances - before.instances != 2 || after.triangles - before.triangles != 4 )
+        return false;
+
+    Image image;
+    framebuffer.read( image );
+    return isPixel( image, 4,           4,           0, 255, 0, 255, 0 ) &&
+           isPixel( image, 4,           cv_size - 4, 0, 255, 0, 255, 0 ) &&
+           isPixel( image, cv_size - 4, 4,           0, 255, 0, 255, 0 ) &&
+           isPixel( image, cv_size - 4, cv_size - 4, 0, 0,   0, 255, 0 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_gpuProfiler )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    GpuProfiler profiler;
+    profiler.init( graphics );
+    if( profiler.getLatestFrame() != nullptr )
+        return false;
+
+    Program program = createColorProgram( graphics );
+    program.use();
+    program.setUniform( "u_color", 1.0f, 1.0f, 1.0f, 1.0f );
+
+    profiler.beginFrame();
+    {
+        GpuScope scene( profiler, "scene" );
+        graphics.clear();
+        {
+            GpuScope rect( profiler, "rect" );
+            drawRect( graphics, -1.0f, -1.0f, 1.0f, 1.0f, 0.0f );
+        }
+    }
+    profiler.endFrame();
+    program.stopUsing();
+
+    //Results can't be read before the GPU has finished the frame
+    graphics.finish();
+    profiler.update();
+
+    const GpuProfilerFrame* frame = profiler.getLatestFrame();
+    if( frame == nullptr || frame->index != 0 || frame->scopes.size() != 2 )
+        return false;
+
+    const Brimstone::GpuProfilerScope& scene = frame->scopes[0];
+    const Brimstone::GpuProfilerScope& rect  = frame->scopes[1];
+    if( std::strcmp( scene.name, "scene" ) != 0 || scene.depth != 0 ||
+        std::strcmp( rect.name, "rect" )   != 0 || rect.depth  != 1 ||
+        rect.cpuBegin < scene.cpuBegin || rect.cpuEnd > scene.cpuEnd || scene.cpuEnd > frame->cpuMilliseconds )
+        return false;
+
+    if( frame->stats.drawCalls != 1 || frame->stats.triangles != 2 || frame->stats.clears != 1 )
+        return false;
+
+    //GPU times are on the same timeline as the CPU's, so the GPU can't have started the frame before the CPU did
+    if( profiler.isTimerSupported() &&
+        ( frame->gpuBegin < -1.0 || rect.gpuBegin < scene.gpuBegin || rect.gpuEnd > scene.gpuEnd || scene.gpuEnd > frame->gpuEnd ||
+          frame->gpuMilliseconds < 0.0 ) )
+        return false;
+
+    if( profiler.isPipelineStatisticsSupported() &&
+        ( !frame->hasPipelineStatistics || frame->pipelineStatistics.primitivesSubmitted != 2 || frame->pipelineStatistics.fragmentShaderInvocations == 0 ) )
+        return false;
+
+    return profiler.getReport().find( "rect" ) != std::string::npos;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_gpuProfilerRing )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    //Every frame either has its results read or is dropped; none are waited on
+    GpuProfiler profiler;
+    profiler.init( graphics, 2 );
+    std::size_t resolved = 0;
+    uint64      last     = 0;
+    bool        ordered  = true;
+    profiler.setCallback( [&]( const GpuProfilerFrame& frame ) {
+        if( resolved > 0 && frame.index <= last )
+            ordered = false;
+        last = frame.index;
+        ++resolved;
+    } );
+
+    for( int i = 0; i < 10; ++i ) {
+        profiler.beginFrame();
+        graphics.clear();
+        profiler.endFrame();
+    }
+    graphics.finish();
+    profiler.update();
+    if( !ordered || resolved + profiler.getDroppedFrameCount() != 10 || last != 9 )
+        return false;
+
+    //Frames and scopes have to be balanced
+    try {
+        profiler.endScope();
+        return false;
+    } catch( const ::Brimstone::GraphicsException& ) {
+    }
+    try {
+        profiler.beginFrame();
+        profiler.beginScope( "open" );
+        profiler.endFrame();
+        return false;
+    } catch( const ::Brimstone::GraphicsException& ) {
+    }
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_gpuScopeUnwind )
+    Graphics& graphics = getGraphics();
+    GpuProfiler profiler;
+    profiler.init( graphics );
+    profiler.beginFrame();
+
+    //A scope that can't be ended while the stack unwinds reports the error, so the exception being thrown still propagates
+    const UncaughtExceptionHandler previous = ::Brimstone::getUncaughtExceptionHandler();
+    ::Brimstone::setUncaughtExceptionHandler( countUncaught );
+    g_uncaught = 0;
+    bool propagated = false;
+    try {
+        GpuScope scope( profiler, "scope" );
+        profiler.endScope();
+        throw ::Brimstone::BoundsException();
+    } catch( const ::Brimstone::BoundsException& ) {
+        propagated = true;
+    }
+    ::Brimstone::setUncaughtExceptionHandler( previous );
+
+    profiler.endFrame();
+    return propagated && g_uncaught == 1;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_msaaResolve )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    Framebuffer multisample = graphics.createFramebuffer();
+    multisample.setColor( cv_size, cv_size, TextureFormat::RGBA8, 4 );
+    multisample.setDepth( cv_size, cv_size, 4 );
+    if( multisample.getSamples() == 0 )
+        throw ::UnitTest::SkipTest( "multisampling isn't supported" );
+    if( !multisample.isComplete() )
+        return false;
+    multisample.bind();
+
+    graphics.setClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+
+    //The rectangle's left edge runs down the middle of column 10, so the pixels in that column are only partly covered
+    Program program = createColorProgram( graphics );
+    program.use();
+    program.setUniform( "u_color", 1.0f, 0.0f, 0.0f, 1.0f );
+    drawRect( graphics, -1.0f + 10.5f * 2.0f / cv_size, -1.0f, 1.0f, 1.0f, 0.0f );
+
+    multisample.resolve( framebuffer );
+
+    Image image;
+    framebuffer.read( image );
+    const int edge = image.getData()[ ( 16 * cv_size + 10 ) * 4 ];
+    return isPixel( image, 9, 16, 0, 0, 0, 255, 0 ) && isPixel( image, 11, 16, 255, 0, 0, 255, 0 ) && edge > 32 && edge < 224;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_blitScaled )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+    graphics.setClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+
+    //A half-size source with a red square in its top-left quarter
+    const int half = cv_size / 2;
+    Texture sourceColor = graphics.createTexture();
+    sourceColor.setStorage( half, half, TextureFormat::RGBA8, 1 );
+    Framebuffer source = graphics.createFramebuffer();
+    source.setColor( sourceColor );
+    source.bind();
+    graphics.setViewport( 0, 0, half, half );
+    graphics.clear();
+    graphics.setScissorTest( true );
+    graphics.setScissorBox( 0, 0, half / 2, half / 2 );
+    graphics.setClearColor( 1.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+    graphics.setScissorTest( false );
+
+    //Scaling the whole source up to the target should put the red square in the target's top-left quarter
+    source.blit( framebuffer, 0, 0, half, half, 0, 0, cv_size, cv_size );
+    Image image;
+    framebuffer.read( image );
+    if( !isPixel( image, 0,        0,        255, 0, 0, 255, 0 ) ||
+        !isPixel( image, half - 1, half - 1, 255, 0, 0, 255, 0 ) ||
+        !isPixel( image, half,     half,     0,   0, 0, 255, 0 ) ||
+        !isPixel( image, cv_size - 1, 0,     0,   0, 0, 255, 0 ) ||
+        !isPixel( image, 0, cv_size - 1,     0,   0, 0, 255, 0 ) )
+        return false;
+
+    //Copying just the red square to the target's bottom-right quarter
+    source.blit( framebuffer, 0, 0, half / 2, half / 2, half, half, half, half );
+    framebuffer.read( image );
+    return isPixel( image, half,        half,        255, 0, 0, 255, 0 ) &&
+           isPixel( image, cv_size - 1, cv_size - 1, 255, 0, 0, 255, 0 ) &&
+           isPixel( image, cv_size - 1, half - 1,    0,   0, 0, 255, 0 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_renderTarget )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    RenderTarget target;
+    target.init( graphics, cv_size, cv_size, TextureFormat::RGBA8, 4 );
+    target.setScale( 0.5f );
+    if( target.getRenderWidth() != cv_size / 2 || target.getRenderHeight() != cv_size / 2 )
+        return false;
+
+    //Fill the top-left quarter of the scene with blue
+    target.begin();
+    graphics.setClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+    graphics.clear();
+    Program program = createColorProgram( graphics );
+    program.use();
+    program.setUniform( "u_color", 0.0f, 0.0f, 1.0f, 1.0f );
+    drawRect( graphics, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f );
+    target.end();
+
+    //end() restores the viewport that was set before begin()
+    int viewport[4];
+    graphics.getViewport( viewport );
+    if( viewport[2] != cv_size || viewport[3] != cv_size )
+        return false;
+
+    //Presenting upscales the half-size scene to fill the framebuffer
+    target.present( framebuffer );
+    Image image;
+    framebuffer.read( image );
+    return isPixel( image, 4,           4,           0, 0, 255, 255, 0 ) &&
+           isPixel( image, cv_size - 4, 4,           0, 0, 0,   255, 0 ) &&
+           isPixel( image, 4,           cv_size - 4, 0, 0, 0,   255, 0 ) &&
+           isPixel( image, cv_size - 4, cv_size - 4, 0, 0, 0,   255, 0 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_renderTargetDynamicScale )
+    //Adjusting the scale doesn't need a context
+    RenderTarget target;
+    target.setScaleRange( 0.5f, 1.0f );
+    target.setTargetFrameTime( 10.0 );
+
+    //Frames that take twice as long as they should shrink the scale, but no further than the minimum
+    for( int i = 0; i < 8; ++i )
+        target.update( 20.0 );
+    if( target.getScale() >= 1.0f || target.getScale() < 0.5f )
+        return false;
+    for( int i = 0; i < 100; ++i )
+        target.update( 20.0 );
+    if( target.getScale() != 0.5f )
+        return false;
+
+    //Frames that take half as long as they should grow it again, gradually
+    for( int i = 0; i < 16; ++i )
+        target.update( 5.0 );
+    if( target.getScale() <= 0.5f || target.getScale() > 0.6f )
+        return false;
+    for( int i = 0; i < 200; ++i )
+        target.update( 5.0 );
+    if( target.getScale() != 1.0f )
+        return false;
+
+    //Frames that are within budget leave it alone
+    target.setScale( 0.75f );
+    for( int i = 0; i < 100; ++i )
+        target.update( 9.0 );
+    if( target.getScale() != 0.75f )
+        return false;
+
+    //The range is kept within (0, 1], so the target is never rendered larger than it is
+    target.setScaleRange( 0.5f, 2.0f );
+    target.setScale( 3.0f );
+    if( target.getMaxScale() != 1.0f || target.getScale() != 1.0f )
+        return false;
+    target.setScaleRange( 1.5f, 2.0f );
+    if( target.getMinScale() != 1.0f || target.getMaxScale() != 1.0f || target.getScale() != 1.0f )
+        return false;
+    target.setScaleRange( -1.0f, 0.25f );
+    target.setScale( 0.0f );
+    return target.getMinScale() > 0.0f && target.getScale() > 0.0f && target.getMaxScale() == 0.25f;
+UT_TEST_END()
+
+
+UT_TEST_BEGIN( Render_destroyedResources )
+    Graphics&   graphics = getGraphics();
+    Texture     color;
+    Framebuffer framebuffer;
+    beginTarget( graphics, color, framebuffer );
+
+    //Executing a command that refers to a texture destroyed after it was recorded throws, even if another texture
+    //has been created in its place since
+    CommandBuffer buffer;
+    {
+        Texture texture = graphics.createTexture();
+        texture.setStorage( 4, 4, TextureFormat::RGBA8, 1 );
+        buffer.bindTexture( texture );
+    }
+    Texture replacement = graphics.createTexture();
+    replacement.setStorage( 4, 4, TextureFormat::RGBA8, 1 );
+    try {
+        graphics.execute( buffer );
+        return false;
+    } catch( const ::Brimstone::GraphicsException& ) {
+    }
+
+    //Assigning to a buffer destroys the one it held
+    const float  positions[9] = {};
+    const uint16 indices[3]   = { 0, 1, 2 };
+    VertexBuffer vertices     = graphics.createVertexBuffer();
+    vertices.setLayout( VertexLayout().add( 0, 3, VertexAttributeType::FLOAT ) );
+    vertices.set( positions, sizeof( positions ) );
+    IndexBuffer  indexBuffer  = graphics.createIndexBuffer();
+    indexBuffer.set( indices, 3 );
+
+    Program program = createColorProgram( graphics );
+    buffer.reset();
+    buffer.useProgram( program );
+    buffer.drawIndexed( vertices, indexBuffer );
+    vertices = graphics.createVertexBuffer();
+    try {
+        graphics.execute( buffer );
+        return false;
+    } catch( const ::Brimstone::GraphicsException& ) {
+    }
+
+    //Resources that are still alive are used as normal
+    buffer.reset();
+    buffer.bindTexture( replacement );
+    graphics.execute( buffer );
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Render_assetCache )
+    std::vector< ubyte > pixels( 16 * 16 * 4 );
+    for( std::size_t i = 0; i < pixels.size(); ++i )
+        pixels[i] = (ubyte)( i * 3 );
+    const std::vector< ubyte > png = ::UnitTest::encodePNG( pixels.data(), 16, 16, 4 );
+
+    //Textures can't be loaded until the cache has a context
+    AssetCache cache;
+    try {
+        cache.loadTexture( png.data(), png.size() );
+        return false;
+    } catch( const ::Brimstone::GraphicsException& ) {
+    }
+    cache.init( getGraphics() );
+
+    //The same data is uploaded once; with and without mipmaps are separate textures
+    TextureHandle mipmapped = cache.loadTexture( png.data(), png.size() );
+    TextureHandle again     = cache.loadTexture( png.data(), png.size() );
+    TextureHandle base      = cache.loadTexture( png.data(), png.size(), false );
+    const uint64  mipBytes  = ( 16 * 16 + 8 * 8 + 4 * 4 + 2 * 2 + 1 ) * 4;
+    if( &mipmapped.get() != &again.get() || &mipmapped.get() == &base.get() ||
+        mipmapped->getWidth() != 16 || mipmapped->getLevelCount() != 5 || base->getLevelCount() != 1 ||
+        cache.getStats().hits != 1 || cache.getStats().misses != 2 || cache.getStats().textures != 2 ||
+        cache.getStats().gpuBytes != mipBytes + 16 * 16 * 4 || cache.getStats().cpuBytes != 0 )
+        return false;
+
+    //The GPU budget evicts the least recently used textures that aren't referenced, and doesn't touch images
+    const ::Brimstone::ImageHandle image = cache.loadImage( png.data(), png.size() );
+    mipmapped.release();
+    again.release();
+    base.release();
+    cache.setBudget( AssetCache::UNLIMITED, mipBytes );
+    if( cache.getCount() != 2 || cache.getStats().textures != 1 || cache.getStats().gpuBytes != 16 * 16 * 4 )
+        return false;
+    cache.setBudget( 0, 0 );
+    return cache.getCount() == 1 && cache.getStats().images == 1 && cache.getStats().gpuBytes == 0 && cache.getStats().evictions == 2;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
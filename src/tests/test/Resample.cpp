@@ -0,0 +1,217 @@
+/*
+test/Resample.cpp
+-----------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for resample()
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                    //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/util/Resample.hpp>    //Brimstone::resample, Brimstone::ResampleFilter
+#include <brimstone/util/PixelOps.hpp>    //Brimstone::SIMDLevel, Brimstone::setSIMDLevel, ...
+#include <brimstone/util/ThreadPool.hpp>  //Brimstone::ThreadPool
+#include <brimstone/Exception.hpp>        //Brimstone::SizeException, Brimstone::BoundsException, Brimstone::NullPointerException
+
+#include <cmath>                          //std::abs
+#include <random>                         //std::mt19937
+#include <vector>                         //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ResampleFilter;
+using ::Brimstone::SIMDLevel;
+using ::Brimstone::ThreadPool;
+using ::Brimstone::ubyte;
+
+
+
+
+//Constants
+const ResampleFilter cv_filters[] = { ResampleFilter::BOX, ResampleFilter::BILINEAR, ResampleFilter::LANCZOS3, ResampleFilter::KAISER };
+
+
+
+
+//Functions
+//Returns random pixels. If channels is 4, every pixel's alpha is at least 1, so its color survives being premultiplied.
+std::vector< ubyte > makeRandom( const int width, const int height, const std::size_t channels ) {
+    std::mt19937 random( (unsigned)( width * 31 + height * 7 + channels ) );
+    std::vector< ubyte > pixels( width * height * channels );
+    for( std::size_t i = 0; i < pixels.size(); ++i )
+        pixels[i] = ( channels == 4 && i % 4 == 3 ) ? (ubyte)( random() % 255 + 1 ) : (ubyte)random();
+    return pixels;
+}
+
+std::vector< ubyte > resample( const std::vector< ubyte >& source, const int sourceWidth, const int sourceHeight,
+                               const int width, const int height, const std::size_t channels, const ResampleFilter filter,
+                               const bool srgb = false, ThreadPool* const pool = nullptr ) {
+    std::vector< ubyte > destination( width * height * channels );
+    ::Brimstone::resample( source.data(), sourceWidth, sourceHeight, 0, destination.data(), width, height, 0, channels, filter, srgb, pool );
+    return destination;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( Resample_constant )
+    //A solid color stays the same whether it's enlarged or shrunk, with every filter, in linear or sRGB space
+    const ubyte color[4] = { 200, 100, 37, 128 };
+    std::vector< ubyte > source( 37 * 23 * 4 );
+    for( std::size_t i = 0; i < source.size(); ++i )
+        source[i] = color[ i % 4 ];
+
+    for( const ResampleFilter filter : cv_filters ) {
+        for( const bool srgb : { false, true } ) {
+            for( const std::vector< ubyte >& destination : { resample( source, 37, 23, 13, 41, 4, filter, srgb ),
+                                                             resample( source, 37, 23, 1, 1, 4, filter, srgb ) } ) {
+                for( std::size_t i = 0; i < destination.size(); ++i )
+                    if( destination[i] != color[ i % 4 ] )
+                        return false;
+            }
+        }
+    }
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Resample_identity )
+    //Resampling to the same size leaves every pixel alone
+    for( std::size_t channels = 1; channels <= 4; ++channels ) {
+        const std::vector< ubyte > source = makeRandom( 19, 11, channels );
+        for( const ResampleFilter filter : cv_filters )
+            if( resample( source, 19, 11, 19, 11, channels, filter ) != source )
+                return false;
+    }
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Resample_boxHalf )
+    //Halving with a box filter averages each 2x2 block
+    const std::vector< ubyte > source      = makeRandom( 10, 6, 1 );
+    const std::vector< ubyte > destination = resample( source, 10, 6, 5, 3, 1, ResampleFilter::BOX );
+    for( int y = 0; y < 3; ++y ) {
+        for( int x = 0; x < 5; ++x ) {
+            const double average = ( source[ ( y * 2 ) * 10 + x * 2 ] + source[ ( y * 2 ) * 10 + x * 2 + 1 ] +
+                                     source[ ( y * 2 + 1 ) * 10 + x * 2 ] + source[ ( y * 2 + 1 ) * 10 + x * 2 + 1 ] ) / 4.0;
+            if( std::abs( destination[ y * 5 + x ] - average ) > 0.5 )
+                return false;
+        }
+    }
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Resample_premultiplied )
+    //Transparent pixels don't darken their neighbors, and fully transparent results are transparent black
+    const ubyte source[] = { 0,   0,   0,   0,
+                             255, 255, 255, 255 };
+    ubyte destination[4];
+    ::Brimstone::resample( source, 2, 1, 0, destination, 1, 1, 0, 4, ResampleFilter::BOX );
+    if( destination[0] != 255 || destination[1] != 255 || destination[2] != 255 || destination[3] != 128 )
+        return false;
+
+    const ubyte transparent[] = { 10, 20, 30, 0,  40, 50, 60, 0 };
+    ::Brimstone::resample( transparent, 2, 1, 0, destination, 1, 1, 0, 4, ResampleFilter::BOX );
+    return destination[0] == 0 && destination[1] == 0 && destination[2] == 0 && destination[3] == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Resample_consistent )
+    //Every instruction set and any number of threads give exactly the same result as the scalar version on one thread
+    ThreadPool pool( 3 );
+    for( const std::size_t channels : { (std::size_t)3, (std::size_t)4 } ) {
+        const std::vector< ubyte > source = makeRandom( 61, 147, channels );
+        for( const ResampleFilter filter : cv_filters ) {
+            for( const bool srgb : { false, true } ) {
+                ::Brimstone::setSIMDLevel( SIMDLevel::NONE );
+                const std::vector< ubyte > expected = resample( source, 61, 147, 29, 203, channels, filter, srgb );
+                for( SIMDLevel level : { SIMDLevel::NONE, SIMDLevel::SSSE3, SIMDLevel::AVX2 } ) {
+                    if( level > ::Brimstone::getSupportedSIMDLevel() )
+                        break;
+                    ::Brimstone::setSIMDLevel( level );
+                    if( resample( source, 61, 147, 29, 203, channels, filter, srgb ) != expected ||
+                        resample( source, 61, 147, 29, 203, channels, filter, srgb, &pool ) != expected ) {
+                        ::Brimstone::setSIMDLevel( ::Brimstone::getSupportedSIMDLevel() );
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    ::Brimstone::setSIMDLevel( ::Brimstone::getSupportedSIMDLevel() );
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Resample_stride )
+    //Rows are read and written with the given strides, and the padding between destination rows is left alone
+    const std::vector< ubyte > packed   = makeRandom( 9, 7, 4 );
+    const std::vector< ubyte > expected = resample( packed, 9, 7, 5, 4, 4, ResampleFilter::LANCZOS3 );
+
+    const std::size_t    sourceStride = 9 * 4 + 5;
+    std::vector< ubyte > source( sourceStride * 7, 0xCD );
+    for( int y = 0; y < 7; ++y )
+        for( int x = 0; x < 9 * 4; ++x )
+            source[ y * sourceStride + x ] = packed[ y * 9 * 4 + x ];
+
+    const std::size_t    destinationStride = 5 * 4 + 3;
+    std::vector< ubyte > destination( destinationStride * 4, 0xAB );
+    ::Brimstone::resample( source.data(), 9, 7, sourceStride, destination.data(), 5, 4, destinationStride, 4, ResampleFilter::LANCZOS3 );
+    for( int y = 0; y < 4; ++y ) {
+        for( std::size_t x = 0; x < destinationStride; ++x ) {
+            const ubyte expect = x < 5 * 4 ? expected[ y * 5 * 4 + x ] : 0xAB;
+            if( destination[ y * destinationStride + x ] != expect )
+                return false;
+        }
+    }
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( Resample_invalid )
+    ubyte pixels[16] = {};
+    try {
+        ::Brimstone::resample( pixels, 2, 2, 0, pixels + 8, 1, 1, 0, 5, ResampleFilter::BOX );
+        return false;
+    } catch( const ::Brimstone::BoundsException& ) {
+    }
+    try {
+        ::Brimstone::resample( pixels, 2, 2, 0, pixels + 8, 0, 1, 0, 1, ResampleFilter::BOX );
+        return false;
+    } catch( const ::Brimstone::SizeException& ) {
+    }
+    try {
+        ::Brimstone::resample( pixels, 2, 2, 1, pixels + 8, 1, 1, 0, 1, ResampleFilter::BOX );
+        return false;
+    } catch( const ::Brimstone::SizeException& ) {
+    }
+    try {
+        ::Brimstone::resample( nullptr, 2, 2, 0, pixels, 1, 1, 0, 1, ResampleFilter::BOX );
+        return false;
+    } catch( const ::Brimstone::NullPointerException& ) {
+    }
+    return true;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
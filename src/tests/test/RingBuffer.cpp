@@ -0,0 +1,167 @@
+/*
+test/RingBuffer.cpp
+-------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for RingBuffer
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                    //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/util/RingBuffer.hpp>  //Brimstone::RingBuffer, Brimstone::RingBufferOverflow
+#include <brimstone/Exception.hpp>        //Brimstone::SizeException, Brimstone::NoSuchElementException
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::RingBuffer;
+using ::Brimstone::RingBufferOverflow;
+
+
+
+
+//Functions
+//Pops every value in the buffer, and returns true if they're first, first + 1, ..., last
+bool drains( RingBuffer< int >& buffer, const int first, const int last ) {
+    int value;
+    for( int expected = first; expected <= last; ++expected )
+        if( !buffer.pop( value ) || value != expected )
+            return false;
+    return buffer.empty() && !buffer.pop( value );
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( RingBuffer_fifo )
+    //Capacities are rounded up to a power of two
+    RingBuffer< int > buffer( 5, RingBufferOverflow::DROP_NEWEST );
+    if( buffer.capacity() != 8 || !buffer.empty() || buffer.size() != 0 )
+        return false;
+
+    //Values come out in the order they went in, including after the positions wrap around the end of the array
+    for( int round = 0; round < 5; ++round ) {
+        for( int i = 0; i < 6; ++i )
+            buffer.push( round * 10 + i );
+        if( buffer.size() != 6 || buffer.front() != round * 10 || !drains( buffer, round * 10, round * 10 + 5 ) )
+            return false;
+    }
+    return buffer.capacity() == 8 && buffer.getDroppedCount() == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( RingBuffer_batch )
+    RingBuffer< int > buffer( 4 );
+    for( int i = 0; i < 3; ++i )
+        buffer.push( i );
+    int first;
+    buffer.pop( first );
+    for( int i = 3; i < 6; ++i )
+        buffer.push( i );
+
+    //Batches are taken from the front, wrapping around, and stop when the buffer is empty
+    int values[8] = {};
+    if( buffer.pop( values, 3 ) != 3 || values[0] != 1 || values[1] != 2 || values[2] != 3 )
+        return false;
+    if( buffer.pop( values, 8 ) != 2 || values[0] != 4 || values[1] != 5 || !buffer.empty() )
+        return false;
+    return buffer.pop( values, 8 ) == 0 && buffer.pop( nullptr, 0 ) == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( RingBuffer_overflow )
+    //GROW keeps everything
+    RingBuffer< int > grow( 2 );
+    for( int i = 0; i < 9; ++i )
+        grow.push( i );
+    if( grow.capacity() != 16 || grow.getDroppedCount() != 0 || !drains( grow, 0, 8 ) )
+        return false;
+
+    //DROP_OLDEST keeps the most recent values
+    RingBuffer< int > oldest( 4, RingBufferOverflow::DROP_OLDEST );
+    for( int i = 0; i < 7; ++i )
+        if( !oldest.push( i ) )
+            return false;
+    if( !oldest.full() || oldest.getDroppedCount() != 3 || !drains( oldest, 3, 6 ) )
+        return false;
+
+    //DROP_NEWEST keeps the oldest values, and reports that the new ones were dropped
+    RingBuffer< int > newest( 4, RingBufferOverflow::DROP_NEWEST );
+    for( int i = 0; i < 4; ++i )
+        newest.push( i );
+    if( newest.push( 4 ) || newest.push( 5 ) || newest.getDroppedCount() != 2 || !drains( newest, 0, 3 ) )
+        return false;
+    newest.resetDroppedCount();
+    return newest.getDroppedCount() == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( RingBuffer_setCapacity )
+    //Growing keeps every value in order
+    RingBuffer< int > buffer( 4, RingBufferOverflow::DROP_OLDEST );
+    for( int i = 0; i < 6; ++i )
+        buffer.push( i );
+    buffer.setCapacity( 16 );
+    for( int i = 6; i < 10; ++i )
+        buffer.push( i );
+    if( buffer.capacity() != 16 || !drains( buffer, 2, 9 ) )
+        return false;
+
+    //Shrinking below the number of values drops according to the policy
+    for( int i = 0; i < 10; ++i )
+        buffer.push( i );
+    buffer.setCapacity( 4 );
+    if( buffer.capacity() != 4 || buffer.getDroppedCount() != 2 + 6 || !drains( buffer, 6, 9 ) )
+        return false;
+
+    buffer.setOverflow( RingBufferOverflow::DROP_NEWEST );
+    buffer.setCapacity( 8 );
+    for( int i = 0; i < 8; ++i )
+        buffer.push( i );
+    buffer.setCapacity( 2 );
+    if( buffer.capacity() != 2 || !drains( buffer, 0, 1 ) )
+        return false;
+
+    //Except with GROW, which keeps them
+    buffer.setOverflow( RingBufferOverflow::GROW );
+    for( int i = 0; i < 5; ++i )
+        buffer.push( i );
+    buffer.setCapacity( 1 );
+    if( buffer.capacity() != 8 || !drains( buffer, 0, 4 ) )
+        return false;
+
+    try {
+        buffer.setCapacity( 0 );
+        return false;
+    } catch( const ::Brimstone::SizeException& ) {
+    }
+    try {
+        buffer.front();
+        return false;
+    } catch( const ::Brimstone::NoSuchElementException& ) {
+    }
+    return true;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
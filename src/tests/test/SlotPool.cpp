@@ -0,0 +1,146 @@
+/*
+test/SlotPool.cpp
+-----------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for SlotPool and Handle
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                      //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/graphics/SlotPool.hpp>  //Brimstone::Private::SlotPool, Brimstone::Private::Handle
+#include <brimstone/Exception.hpp>          //Brimstone::GraphicsException
+
+#include <vector>                           //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::Private::SlotPool;
+using ::Brimstone::Private::Handle;
+
+//Counts how many of it are alive
+struct Counted {
+    static int alive;
+
+    int value;
+
+    Counted( const int value ) : value( value ) { ++alive; }
+    ~Counted()                                  { --alive; }
+};
+int Counted::alive = 0;
+
+struct Throws {
+    Throws() { throw 0; }
+};
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( SlotPool_createDestroy )
+    SlotPool< Counted > pool;
+    Handle< Counted >   a = pool.create( 1 );
+    Handle< Counted >   b = pool.create( 2 );
+    if( Counted::alive != 2 || pool.getCount() != 2 || pool.getCapacity() != SlotPool< Counted >::CHUNK_SIZE )
+        return false;
+    if( pool.get( a )->value != 1 || pool.get( b )->value != 2 || a == b )
+        return false;
+
+    pool.destroy( a );
+    return Counted::alive == 1 && pool.getCount() == 1 && !pool.isValid( a ) && pool.isValid( b );
+UT_TEST_END()
+
+UT_TEST_BEGIN( SlotPool_staleHandles )
+    SlotPool< Counted > pool;
+    Handle< Counted >   a = pool.create( 1 );
+    pool.destroy( a );
+
+    //The freed slot is reused, but handles to the object that was in it are still stale
+    Handle< Counted > b = pool.create( 2 );
+    if( b.getIndex() != a.getIndex() || b == a || pool.isValid( a ) || pool.get( b )->value != 2 )
+        return false;
+    try {
+        pool.get( a );
+        return false;
+    } catch( const ::Brimstone::GraphicsException& ) {
+    }
+    try {
+        pool.destroy( a );
+        return false;
+    } catch( const ::Brimstone::GraphicsException& ) {
+    }
+
+    //Null handles are never valid, and destroying one does nothing
+    pool.destroy( nullptr );
+    return !pool.isValid( nullptr ) && pool.getCount() == 1;
+UT_TEST_END()
+
+UT_TEST_BEGIN( SlotPool_grow )
+    //Objects don't move when the pool grows
+    SlotPool< Counted >               pool;
+    std::vector< Handle< Counted > >  handles;
+    std::vector< Counted* >           objects;
+    for( int i = 0; i < 1000; ++i ) {
+        handles.push_back( pool.create( i ) );
+        objects.push_back( pool.get( handles.back() ) );
+    }
+    if( pool.getCapacity() != 4 * SlotPool< Counted >::CHUNK_SIZE )
+        return false;
+    for( int i = 0; i < 1000; ++i )
+        if( pool.get( handles[i] ) != objects[i] || objects[i]->value != i )
+            return false;
+
+    //Freed slots are reused before the pool grows again
+    for( int i = 0; i < 1000; ++i )
+        pool.destroy( handles[i] );
+    for( int i = 0; i < 1000; ++i )
+        pool.create( i );
+    return pool.getCapacity() == 4 * SlotPool< Counted >::CHUNK_SIZE;
+UT_TEST_END()
+
+UT_TEST_BEGIN( SlotPool_destroysLiveObjects )
+    {
+        SlotPool< Counted > pool;
+        pool.create( 1 );
+        pool.destroy( pool.create( 2 ) );
+        pool.create( 3 );
+    }
+    return Counted::alive == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( SlotPool_constructorThrows )
+    //If an object's constructor throws, its slot stays free
+    SlotPool< Throws > pool;
+    try {
+        pool.create();
+        return false;
+    } catch( int ) {
+    }
+    return pool.getCount() == 0;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
@@ -0,0 +1,177 @@
+/*
+test/SpriteQueue.cpp
+--------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for SpriteQueue
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                         //UT_TEST_BEGIN, UT_TEST_END
+#include "../utils.hpp"                        //UnitTest::isWithin
+
+#include <brimstone/graphics/SpriteBatch.hpp>  //Brimstone::SpriteQueue, Brimstone::Sprite, Brimstone::SpriteVertex, Brimstone::SpriteRun
+#include <brimstone/Graphics.hpp>              //Brimstone::Texture
+
+#include <vector>                              //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::SpriteQueue;
+using ::Brimstone::SpriteSortMode;
+using ::Brimstone::Sprite;
+using ::Brimstone::SpriteVertex;
+using ::Brimstone::SpriteRun;
+using ::Brimstone::Texture;
+using ::Brimstone::Bounds2f;
+using ::Brimstone::Point2f;
+using ::Brimstone::BlendMode;
+using ::Brimstone::uint16;
+
+
+
+
+//Functions
+Sprite makeSprite( Texture& texture, const float x, const BlendMode blend = BlendMode::TRANSPARENCY, const uint16 layer = 0 ) {
+    return Sprite { &texture, Bounds2f( x, 0.0f, x + 1.0f, 1.0f ), Bounds2f( 0.0f, 0.0f, 1.0f, 1.0f ), 0xFFFFFFFF, 0.0f, Point2f( 0.0f ), blend, layer };
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( SpriteQueue_writeVertices )
+    Texture t;
+    SpriteQueue o;
+    o.add( Sprite { &t, Bounds2f( 1.0f, 2.0f, 3.0f, 4.0f ), Bounds2f( 0.0f, 0.5f, 1.0f, 1.0f ), 0x11223344, 0.0f, Point2f( 0.0f ), BlendMode::TRANSPARENCY, 0 } );
+
+    SpriteVertex v[4];
+    std::vector< SpriteRun > runs;
+    o.write( v, runs );
+
+    return v[0].x == 1.0f && v[0].y == 2.0f && v[0].u == 0     && v[0].v == 32768 &&
+           v[1].x == 3.0f && v[1].y == 2.0f && v[1].u == 65535 && v[1].v == 32768 &&
+           v[2].x == 3.0f && v[2].y == 4.0f && v[2].u == 65535 && v[2].v == 65535 &&
+           v[3].x == 1.0f && v[3].y == 4.0f && v[3].u == 0     && v[3].v == 65535 &&
+           v[0].color == 0x11223344;
+UT_TEST_END()
+
+UT_TEST_BEGIN( SpriteQueue_writeRotated )
+    Texture t;
+    SpriteQueue o;
+    //Half-turn about the center of the sprite swaps opposite corners
+    o.add( Sprite { &t, Bounds2f( 2.0f, 2.0f, 4.0f, 4.0f ), Bounds2f( 0.0f, 0.0f, 1.0f, 1.0f ), 0xFFFFFFFF, 3.14159265f, Point2f( 1.0f ), BlendMode::TRANSPARENCY, 0 } );
+
+    SpriteVertex v[4];
+    std::vector< SpriteRun > runs;
+    o.write( v, runs );
+
+    return isWithin( v[0].x, 4.0f, 0.0001f ) && isWithin( v[0].y, 4.0f, 0.0001f ) &&
+           isWithin( v[2].x, 2.0f, 0.0001f ) && isWithin( v[2].y, 2.0f, 0.0001f );
+UT_TEST_END()
+
+UT_TEST_BEGIN( SpriteQueue_textureSortMergesRuns )
+    Texture a, b;
+    SpriteQueue o;
+    o.setSortMode( SpriteSortMode::TEXTURE );
+    o.add( makeSprite( a, 0.0f ) );
+    o.add( makeSprite( b, 1.0f ) );
+    o.add( makeSprite( a, 2.0f ) );
+    o.add( makeSprite( b, 3.0f ) );
+
+    SpriteVertex v[16];
+    std::vector< SpriteRun > runs;
+    o.write( v, runs );
+
+    //Sprites using the same texture are drawn together, in the order they were queued
+    return runs.size()     == 2  &&
+           runs[0].texture == &a && runs[0].first == 0 && runs[0].count == 2 &&
+           runs[1].texture == &b && runs[1].first == 2 && runs[1].count == 2 &&
+           v[0].x  == 0.0f && v[4].x  == 2.0f &&
+           v[8].x  == 1.0f && v[12].x == 3.0f;
+UT_TEST_END()
+
+UT_TEST_BEGIN( SpriteQueue_textureSortSeparatesBlend )
+    Texture a;
+    SpriteQueue o;
+    o.add( makeSprite( a, 0.0f, BlendMode::ADDITIVE     ) );
+    o.add( makeSprite( a, 1.0f, BlendMode::TRANSPARENCY ) );
+    o.add( makeSprite( a, 2.0f, BlendMode::ADDITIVE     ) );
+
+    SpriteVertex v[12];
+    std::vector< SpriteRun > runs;
+    o.write( v, runs );
+
+    return runs.size() == 2 &&
+           runs[0].blend == BlendMode::TRANSPARENCY && runs[0].count == 1 &&
+           runs[1].blend == BlendMode::ADDITIVE     && runs[1].count == 2;
+UT_TEST_END()
+
+UT_TEST_BEGIN( SpriteQueue_deferredKeepsOrder )
+    Texture a, b;
+    SpriteQueue o;
+    o.setSortMode( SpriteSortMode::DEFERRED );
+    o.add( makeSprite( a, 0.0f ) );
+    o.add( makeSprite( a, 1.0f ) );
+    o.add( makeSprite( b, 2.0f ) );
+    o.add( makeSprite( a, 3.0f ) );
+
+    SpriteVertex v[16];
+    std::vector< SpriteRun > runs;
+    o.write( v, runs );
+
+    return runs.size() == 3 &&
+           runs[0].count == 2 && runs[1].count == 1 && runs[2].count == 1 &&
+           v[0].x == 0.0f && v[4].x == 1.0f && v[8].x == 2.0f && v[12].x == 3.0f;
+UT_TEST_END()
+
+UT_TEST_BEGIN( SpriteQueue_layers )
+    Texture a, b;
+    SpriteQueue o;
+    o.add( makeSprite( a, 0.0f, BlendMode::TRANSPARENCY, 1 ) );
+    o.add( makeSprite( b, 1.0f, BlendMode::TRANSPARENCY, 0 ) );
+    o.add( makeSprite( a, 2.0f, BlendMode::TRANSPARENCY, 0 ) );
+
+    SpriteVertex v[12];
+    std::vector< SpriteRun > runs;
+    o.write( v, runs );
+
+    //Layer 0 is drawn first, even though its sprites were queued last
+    return runs.size() == 3 &&
+           runs[0].texture == &a && runs[1].texture == &b && runs[2].texture == &a &&
+           v[0].x == 2.0f && v[4].x == 1.0f && v[8].x == 0.0f;
+UT_TEST_END()
+
+UT_TEST_BEGIN( SpriteQueue_clear )
+    Texture a;
+    SpriteQueue o;
+    o.add( makeSprite( a, 0.0f ) );
+    o.clear();
+
+    return o.empty() && o.getCount() == 0;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
@@ -0,0 +1,235 @@
+/*
+test/TextureAtlas.cpp
+---------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for SkylinePacker and TextureAtlasBuilder
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                          //UT_TEST_BEGIN, UT_TEST_END
+#include "../utils.hpp"                         //UnitTest::isWithin
+
+#include <brimstone/graphics/TextureAtlas.hpp>  //Brimstone::SkylinePacker, Brimstone::TextureAtlasBuilder, Brimstone::TextureAtlas, Brimstone::AtlasRegion
+
+#include <cstdio>                               //std::fopen, std::fseek, std::fwrite, std::fclose, std::remove
+#include <vector>                               //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::SkylinePacker;
+using ::Brimstone::TextureAtlasBuilder;
+using ::Brimstone::TextureAtlas;
+using ::Brimstone::AtlasRegion;
+using ::Brimstone::Bounds2i;
+using ::Brimstone::Point2i;
+using ::Brimstone::ubyte;
+using ::Brimstone::int32;
+using ::Brimstone::uint32;
+
+
+
+
+//Functions
+//Returns a width x height RGBA8 image whose pixels are all the given value
+std::vector< ubyte > makePixels( const int32 width, const int32 height, const ubyte value ) {
+    return std::vector< ubyte >( (std::size_t)width * height * 4, value );
+}
+
+bool overlaps( const Bounds2i& a, const Bounds2i& b ) {
+    return a.minX < b.maxX && b.minX < a.maxX && a.minY < b.maxY && b.minY < a.maxY;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( SkylinePacker_noOverlap )
+    SkylinePacker packer( 64, 64 );
+
+    //Pack rectangles of assorted sizes until the packer runs out of room
+    std::vector< Bounds2i > placed;
+    for( int32 i = 0; i < 200; ++i ) {
+        const int32 w = 3 + ( i * 7 ) % 11;
+        const int32 h = 2 + ( i * 5 ) % 9;
+
+        Point2i p;
+        if( !packer.insert( w, h, p ) )
+            continue;
+
+        Bounds2i b( p.x, p.y, p.x + w, p.y + h );
+        if( b.minX < 0 || b.minY < 0 || b.maxX > 64 || b.maxY > 64 )
+            return false;
+        for( const Bounds2i& other : placed )
+            if( overlaps( b, other ) )
+                return false;
+        placed.push_back( b );
+    }
+
+    return placed.size() > 20 && packer.getOccupancy() > 0.5f && packer.getOccupancy() <= 1.0f;
+UT_TEST_END()
+
+UT_TEST_BEGIN( SkylinePacker_full )
+    SkylinePacker packer( 8, 8 );
+    Point2i p;
+
+    //Four 4x4 squares fill the area exactly; a fifth doesn't fit
+    for( int i = 0; i < 4; ++i )
+        if( !packer.insert( 4, 4, p ) )
+            return false;
+
+    return !packer.insert( 1, 1, p ) &&
+           !packer.insert( 0, 4, p ) &&
+           packer.getUsedArea() == 64 &&
+           isWithin( packer.getOccupancy(), 1.0f, 0.0001f );
+UT_TEST_END()
+
+UT_TEST_BEGIN( SkylinePacker_tooLarge )
+    SkylinePacker packer( 16, 16 );
+    Point2i p;
+
+    return !packer.insert( 17, 1, p ) &&
+           !packer.insert( 1, 17, p ) &&
+           packer.insert( 16, 16, p ) && p.x == 0 && p.y == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureAtlasBuilder_add )
+    TextureAtlasBuilder builder( 32, 16, 1 );
+    std::vector< ubyte > red = makePixels( 4, 2, 0x80 );
+
+    const AtlasRegion* region = builder.add( "red", red.data(), 4, 2 );
+    if( region == nullptr )
+        return false;
+
+    //The image sits inside one pixel of padding
+    const Bounds2i& b = region->pixels;
+    if( b.minX != 1 || b.minY != 1 || b.maxX != 5 || b.maxY != 3 )
+        return false;
+
+    //The padding is filled with the image's edge pixels
+    const ubyte* pixels = builder.getPixels();
+    if( pixels[0] != 0x80 || pixels[ ( 3 * 32 + 5 ) * 4 ] != 0x80 || pixels[ ( 4 * 32 + 6 ) * 4 ] != 0 )
+        return false;
+
+    //Adding the same name again returns the existing region
+    return isWithin( region->uv.minX, 1.0f / 32.0f, 0.0001f ) &&
+           isWithin( region->uv.maxY, 3.0f / 16.0f, 0.0001f ) &&
+           builder.add( "red", red.data(), 4, 2 ) == region &&
+           builder.find( "red" ) == region &&
+           builder.find( "blue" ) == nullptr &&
+           builder.getRegions().size() == 1;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureAtlasBuilder_addEmpty )
+    TextureAtlasBuilder builder( 32, 16, 2 );
+    std::vector< ubyte > red = makePixels( 4, 2, 0x80 );
+
+    //Images with no pixels aren't packed, even though their padding alone would fit
+    if( builder.add( "a", red.data(), 0, 2 ) != nullptr ||
+        builder.add( "b", red.data(), 4, 0 ) != nullptr ||
+        builder.add( "c", red.data(), -4, 2 ) != nullptr ||
+        builder.add( "d", red.data(), 4, -2 ) != nullptr ||
+        builder.add( "e", nullptr, 4, 2 ) != nullptr )
+        return false;
+    if( !builder.getRegions().empty() || builder.getPacker().getUsedArea() != 0 )
+        return false;
+
+    //The same goes for an atlas on the GPU; it's rejected before anything is uploaded
+    TextureAtlas atlas;
+    return atlas.add( "a", red.data(), 0, 2 ) == nullptr &&
+           atlas.add( "b", red.data(), 4, -2 ) == nullptr &&
+           atlas.getUploadCount() == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureAtlasBuilder_saveLoad )
+    const char* const filename = "TextureAtlasBuilder_saveLoad.atlas";
+
+    TextureAtlasBuilder builder( 16, 16, 1 );
+    std::vector< ubyte > a = makePixels( 3, 3, 0x11 );
+    std::vector< ubyte > b = makePixels( 5, 2, 0x22 );
+    builder.add( "a", a.data(), 3, 3 );
+    builder.add( "b", b.data(), 5, 2 );
+    if( !builder.save( filename ) )
+        return false;
+
+    TextureAtlasBuilder loaded;
+    const bool ok = loaded.load( filename );
+    std::remove( filename );
+    if( !ok )
+        return false;
+
+    const AtlasRegion* la = loaded.find( "a" );
+    const AtlasRegion* lb = loaded.find( "b" );
+    if( la == nullptr || lb == nullptr || la->pixels != builder.find( "a" )->pixels || lb->pixels != builder.find( "b" )->pixels )
+        return false;
+
+    for( std::size_t i = 0; i < 16 * 16 * 4; ++i )
+        if( loaded.getPixels()[i] != builder.getPixels()[i] )
+            return false;
+
+    //Packing continues where the saved atlas left off
+    std::vector< ubyte > c = makePixels( 4, 4, 0x33 );
+    const AtlasRegion* lc = loaded.add( "c", c.data(), 4, 4 );
+    return lc != nullptr && !overlaps( lc->pixels, la->pixels ) && !overlaps( lc->pixels, lb->pixels );
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureAtlasBuilder_loadCorrupt )
+    const char* const filename = "TextureAtlasBuilder_loadCorrupt.atlas";
+
+    //An empty 16x16 atlas has one skyline segment, { 0, 0, 16 }, stored after the magic, version, width, height, padding and segment count
+    const long   segmentOffset      = 8 + 5 * sizeof( uint32 );
+    const uint32 corruptSegments[][3] = {
+        { 0,  0,  32 },     //Wider than the atlas
+        { 4,  0,  12 },     //Doesn't start at 0
+        { 0,  0,  8  },     //Doesn't reach the right edge
+        { 0,  0,  0  },     //Empty
+        { 0,  17, 16 }      //Below the bottom of the atlas
+    };
+
+    bool ok = TextureAtlasBuilder( 16, 16 ).save( filename );
+    for( const uint32 ( &segment )[3] : corruptSegments ) {
+        FILE* file = std::fopen( filename, "r+b" );
+        ok = ok && file != nullptr &&
+             std::fseek( file, segmentOffset, SEEK_SET ) == 0 &&
+             std::fwrite( segment, sizeof( segment ), 1, file ) == 1;
+        if( file != nullptr )
+            std::fclose( file );
+
+        TextureAtlasBuilder builder;
+        ok = ok && !builder.load( filename ) && builder.getWidth() == 0 && builder.getRegions().empty();
+    }
+    std::remove( filename );
+    return ok;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureAtlasBuilder_loadMissing )
+    TextureAtlasBuilder builder( 8, 8 );
+    return !builder.load( "TextureAtlasBuilder_loadMissing.atlas" ) &&
+           builder.getWidth() == 0 &&
+           builder.getRegions().empty();
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
@@ -0,0 +1,217 @@
+/*
+test/TextureData.cpp
+--------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for TextureData
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                         //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/graphics/TextureData.hpp>  //Brimstone::TextureData, Brimstone::getMipLevelCount, Brimstone::ResampleFilter, etc.
+#include <brimstone/Exception.hpp>             //Brimstone::FormatException
+
+#include <cstring>                             //std::memcpy
+#include <vector>                              //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::TextureData;
+using ::Brimstone::TextureFormat;
+using ::Brimstone::ResampleFilter;
+using ::Brimstone::FormatException;
+using ::Brimstone::ubyte;
+using ::Brimstone::uint32;
+
+
+
+
+//Functions
+//Builds the contents of a little-endian KTX file containing a single 2D texture
+std::vector< ubyte > makeKTX( const uint32 internalFormat, const uint32 width, const uint32 height, const std::vector< std::vector< ubyte > >& levels ) {
+    const ubyte identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+    const uint32 header[13] = {
+        0x04030201,             //endianness
+        0, 1, 0,                //glType, glTypeSize, glFormat (compressed)
+        internalFormat, 0,      //glInternalFormat, glBaseInternalFormat
+        width, height, 0,       //pixelWidth, pixelHeight, pixelDepth
+        0, 1,                   //numberOfArrayElements, numberOfFaces
+        (uint32)levels.size(),  //numberOfMipmapLevels
+        0                       //bytesOfKeyValueData
+    };
+
+    std::vector< ubyte > file( identifier, identifier + sizeof( identifier ) );
+    file.resize( file.size() + sizeof( header ) );
+    std::memcpy( &file[ sizeof( identifier ) ], header, sizeof( header ) );
+
+    for( const std::vector< ubyte >& level : levels ) {
+        const uint32 size = (uint32)level.size();
+        file.insert( file.end(), (const ubyte*)&size, (const ubyte*)&size + sizeof( size ) );
+        file.insert( file.end(), level.begin(), level.end() );
+        file.resize( ( file.size() + 3 ) & ~(std::size_t)3 );
+    }
+    return file;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( TextureData_mipLevelCount )
+    return Brimstone::getMipLevelCount( 1, 1 )     == 1  &&
+           Brimstone::getMipLevelCount( 256, 256 ) == 9  &&
+           Brimstone::getMipLevelCount( 300, 20 )  == 9  &&
+           Brimstone::getMipLevelCount( 0, 16 )    == 0  &&
+           Brimstone::getMipDimension( 300, 3 )    == 37 &&
+           Brimstone::getMipDimension( 20, 8 )     == 1;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureData_dataSize )
+    return Brimstone::getTextureDataSize( TextureFormat::R8,       3, 5 ) == 15  &&
+           Brimstone::getTextureDataSize( TextureFormat::RG8,      3, 5 ) == 30  &&
+           Brimstone::getTextureDataSize( TextureFormat::RGBA8,    3, 5 ) == 60  &&
+           Brimstone::getTextureDataSize( TextureFormat::BC1_RGBA, 3, 5 ) == 16  &&
+           Brimstone::getTextureDataSize( TextureFormat::BC7_RGBA, 8, 8 ) == 64  &&
+           Brimstone::getTextureDataSize( TextureFormat::BC4_R,    1, 1 ) == 8   &&
+           Brimstone::isCompressed( TextureFormat::ETC2_RGBA8 ) &&
+           !Brimstone::isCompressed( TextureFormat::SRGB8_ALPHA8 );
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureData_generateMipmaps )
+    //4x2 R8 texture; left half 0, right half 200
+    const ubyte texels[] = { 0, 0, 200, 200,
+                             0, 0, 200, 200 };
+    TextureData data;
+    data.set( TextureFormat::R8, 4, 2, texels );
+    data.generateMipmaps();
+
+    if( data.getLevelCount() != 3 || data.getLevelSize( 1 ) != 2 || data.getLevelSize( 2 ) != 1 )
+        return false;
+
+    const ubyte* level1 = data.getLevel( 1 );
+    const ubyte* level2 = data.getLevel( 2 );
+    return level1[0] == 0 && level1[1] == 200 && level2[0] == 100;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureData_generateMipmapsSRGB )
+    //sRGB black and white average to sRGB 188 (linear 0.5), not 128; alpha is averaged as-is
+    const ubyte texels[] = { 0,   0,   0,   0,
+                             255, 255, 255, 255 };
+    TextureData data;
+    data.set( TextureFormat::SRGB8_ALPHA8, 2, 1, texels );
+    data.generateMipmaps();
+
+    const ubyte* level1 = data.getLevel( 1 );
+    return data.getLevelCount() == 2 && level1[0] == 188 && level1[2] == 188 && level1[3] == 128;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureData_generateMipmapsFiltered )
+    //With a box filter, a 4x2 R8 texture gets the same levels as generateMipmaps{1} gives it
+    const ubyte texels[] = { 0, 0, 200, 200,
+                             0, 0, 200, 200 };
+    TextureData data;
+    data.set( TextureFormat::R8, 4, 2, texels );
+    data.generateMipmaps( ResampleFilter::BOX );
+
+    const ubyte* level1 = data.getLevel( 1 );
+    const ubyte* level2 = data.getLevel( 2 );
+    if( data.getLevelCount() != 3 || level1[0] != 0 || level1[1] != 200 || level2[0] != 100 )
+        return false;
+
+    //Fewer levels can be asked for, and other filters keep a flat texture flat
+    const ubyte flat[] = { 90, 90, 90, 90, 90, 90, 90, 90 };
+    data.set( TextureFormat::RG8, 2, 2, flat );
+    data.generateMipmaps( ResampleFilter::LANCZOS3, 1 );
+    if( data.getLevelCount() != 1 )
+        return false;
+    data.generateMipmaps( ResampleFilter::LANCZOS3 );
+    return data.getLevelCount() == 2 && data.getLevel( 1 )[0] == 90 && data.getLevel( 1 )[1] == 90;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureData_generateMipmapsCompressed )
+    TextureData data;
+    data.set( TextureFormat::BC1_RGBA, 4, 4, nullptr );
+    try {
+        data.generateMipmaps();
+    } catch( const FormatException& ) {
+        return true;
+    }
+    return false;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureData_loadKTX )
+    //8x8 BC1 texture with all 4 levels
+    const std::vector< std::vector< ubyte > > levels = {
+        std::vector< ubyte >( 32, 1 ),
+        std::vector< ubyte >( 8,  2 ),
+        std::vector< ubyte >( 8,  3 ),
+        std::vector< ubyte >( 8,  4 )
+    };
+    const std::vector< ubyte > file = makeKTX( 0x83F1, 8, 8, levels );
+
+    TextureData data;
+    if( !data.loadKTX( file.data(), file.size() ) )
+        return false;
+
+    return data.getFormat() == TextureFormat::BC1_RGBA &&
+           data.getWidth() == 8 && data.getHeight() == 8 &&
+           data.getLevelCount() == 4 &&
+           data.getLevelSize( 0 ) == 32 && data.getLevel( 0 )[31] == 1 &&
+           data.getLevelSize( 3 ) == 8  && data.getLevel( 3 )[0]  == 4;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureData_loadKTXPaddedRows )
+    //3x2 R8 texture; KTX pads each row to 4 bytes
+    const std::vector< std::vector< ubyte > > levels = {
+        { 1, 2, 3, 0,
+          4, 5, 6, 0 }
+    };
+    const std::vector< ubyte > file = makeKTX( 0x8229, 3, 2, levels );
+
+    TextureData data;
+    if( !data.loadKTX( file.data(), file.size() ) || data.getLevelSize( 0 ) != 6 )
+        return false;
+
+    const ubyte* texels = data.getLevel( 0 );
+    return texels[2] == 3 && texels[3] == 4 && texels[5] == 6;
+UT_TEST_END()
+
+UT_TEST_BEGIN( TextureData_loadKTXInvalid )
+    std::vector< ubyte > file = makeKTX( 0x83F1, 8, 8, { std::vector< ubyte >( 32, 1 ) } );
+
+    //Truncated
+    TextureData data;
+    if( data.loadKTX( file.data(), file.size() - 1 ) || data.isValid() )
+        return false;
+
+    //Unsupported format
+    file = makeKTX( 0x1234, 8, 8, { std::vector< ubyte >( 32, 1 ) } );
+    return !data.loadKTX( file.data(), file.size() ) &&
+           !data.loadKTX( "TextureData_loadKTXInvalid.ktx" );
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
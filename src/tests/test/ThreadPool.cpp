@@ -0,0 +1,97 @@
+/*
+test/ThreadPool.cpp
+-------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for ThreadPool
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                    //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/util/ThreadPool.hpp>  //Brimstone::ThreadPool
+
+#include <atomic>                         //std::atomic
+#include <future>                         //std::future
+#include <stdexcept>                      //std::runtime_error
+#include <vector>                         //std::vector
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::ThreadPool;
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( ThreadPool_submit )
+    ThreadPool pool( 4 );
+
+    std::vector< std::future< int > > results;
+    for( int i = 0; i < 100; ++i )
+        results.push_back( pool.submit( [i]() { return i * i; } ) );
+
+    for( int i = 0; i < 100; ++i )
+        if( results[i].get() != i * i )
+            return false;
+
+    return pool.getThreadCount() == 4;
+UT_TEST_END()
+
+UT_TEST_BEGIN( ThreadPool_submitException )
+    ThreadPool pool( 2 );
+    std::future< void > result = pool.submit( []() { throw std::runtime_error( "expected" ); } );
+
+    try {
+        result.get();
+    } catch( const std::runtime_error& ) {
+        return true;
+    }
+    return false;
+UT_TEST_END()
+
+UT_TEST_BEGIN( ThreadPool_wait )
+    ThreadPool pool( 3 );
+    std::atomic< int > count( 0 );
+
+    for( int i = 0; i < 1000; ++i )
+        pool.post( [&count]() { ++count; } );
+    pool.wait();
+
+    return count == 1000 && pool.getPendingCount() == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( ThreadPool_destructorRunsQueuedTasks )
+    std::atomic< int > count( 0 );
+    {
+        ThreadPool pool( 1 );
+        for( int i = 0; i < 50; ++i )
+            pool.post( [&count]() { ++count; } );
+    }
+    return count == 50;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
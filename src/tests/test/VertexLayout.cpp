@@ -0,0 +1,198 @@
+/*
+test/VertexLayout.cpp
+---------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for VertexLayout
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                          //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/graphics/VertexLayout.hpp>  //Brimstone::VertexLayout, Brimstone::VertexAttribute, Brimstone::VertexAttributeType
+#include <brimstone/Exception.hpp>              //Brimstone::GraphicsException, Brimstone::BoundsException
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::VertexLayout;
+using ::Brimstone::VertexAttribute;
+using ::Brimstone::VertexAttributeType;
+using ::Brimstone::GraphicsException;
+using ::Brimstone::BoundsException;
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( VertexLayout_constructor )
+    VertexLayout o;
+
+    return o.empty()                  &&
+           o.getAttributeCount() == 0 &&
+           o.getStride()         == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_addOffsets )
+    VertexLayout o;
+    o.add( 0, 3, VertexAttributeType::FLOAT                )
+     .add( 1, 4, VertexAttributeType::UNSIGNED_BYTE, true  )
+     .add( 2, 2, VertexAttributeType::HALF_FLOAT           );
+
+    return o.getAttributeCount()   == 3  &&
+           o.getAttribute(0).offset == 0  &&
+           o.getAttribute(1).offset == 12 &&
+           o.getAttribute(2).offset == 16 &&
+           o.getAttribute(1).normalized   &&
+           o.getStride()           == 20;
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_addAligned )
+    VertexLayout o;
+    o.add( 0, 3, VertexAttributeType::UNSIGNED_BYTE, true )
+     .add( 1, 1, VertexAttributeType::SHORT               );
+
+    //3 bytes rounded up to 4, plus 2 bytes rounded up to 4
+    return o.getAttribute(1).offset == 4 &&
+           o.getStride()            == 8;
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_addOffset )
+    VertexLayout o;
+    o.add( 0, 2, VertexAttributeType::FLOAT, false, 8 );
+
+    return o.getAttribute(0).offset == 8 &&
+           o.getStride()            == 16;
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_addInteger )
+    VertexLayout o;
+    o.addInteger( 5, 4, VertexAttributeType::UNSIGNED_BYTE );
+
+    const VertexAttribute& a = o.getAttribute(0);
+    return a.index   == 5     &&
+           a.integer == true  &&
+           o.getStride() == 4;
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_addInteger_float )
+    VertexLayout o;
+
+    try {
+        o.addInteger( 0, 1, VertexAttributeType::FLOAT );
+        return false;
+    } catch( const GraphicsException& ) {}
+
+    return o.empty();
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_add_badCount )
+    VertexLayout o;
+
+    try {
+        o.add( 0, 0, VertexAttributeType::FLOAT );
+        return false;
+    } catch( const GraphicsException& ) {}
+
+    try {
+        o.add( 0, 5, VertexAttributeType::FLOAT );
+        return false;
+    } catch( const GraphicsException& ) {}
+
+    return o.empty();
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_add_tooMany )
+    VertexLayout o;
+    for( Brimstone::uint i = 0; i < VertexLayout::MAX_ATTRIBUTES; ++i )
+        o.add( i, 1, VertexAttributeType::FLOAT );
+
+    try {
+        o.add( 0, 1, VertexAttributeType::FLOAT );
+        return false;
+    } catch( const GraphicsException& ) {}
+
+    return o.getAttributeCount() == VertexLayout::MAX_ATTRIBUTES;
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_setStride )
+    VertexLayout o;
+    o.setStride( 32 )
+     .add( 0, 2, VertexAttributeType::FLOAT );
+
+    return o.getStride() == 32;
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_setDivisor )
+    VertexLayout o;
+    o.add( 0, 4, VertexAttributeType::FLOAT )
+     .setDivisor( 1 )
+     .add( 1, 4, VertexAttributeType::FLOAT );
+
+    return o.getAttribute(0).divisor == 1 &&
+           o.getAttribute(1).divisor == 1;
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_clear )
+    VertexLayout o;
+    o.setStride( 32 )
+     .setDivisor( 2 )
+     .add( 0, 4, VertexAttributeType::FLOAT );
+
+    o.clear();
+    o.add( 0, 1, VertexAttributeType::FLOAT );
+
+    return o.getAttributeCount()      == 1 &&
+           o.getStride()              == 4 &&
+           o.getAttribute(0).divisor == 0;
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_getAttribute_OOB )
+    VertexLayout o;
+    o.add( 0, 1, VertexAttributeType::FLOAT );
+
+    try {
+        o.getAttribute( 1 );
+        return false;
+    } catch( const BoundsException& ) {}
+
+    return true;
+UT_TEST_END()
+
+UT_TEST_BEGIN( VertexLayout_iterate )
+    VertexLayout o;
+    o.add( 0, 1, VertexAttributeType::FLOAT )
+     .add( 1, 1, VertexAttributeType::FLOAT )
+     .add( 2, 1, VertexAttributeType::FLOAT );
+
+    Brimstone::uint expected = 0;
+    for( const VertexAttribute& a : o )
+        if( a.index != expected++ )
+            return false;
+
+    return expected == 3;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
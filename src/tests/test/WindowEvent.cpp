@@ -0,0 +1,183 @@
+/*
+test/WindowEvent.cpp
+--------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Unit tests for coalesceWindowEvent
+*/
+
+
+
+
+//Includes
+#include "../Test.hpp"                       //UT_TEST_BEGIN, UT_TEST_END
+
+#include <brimstone/window/WindowEvent.hpp>  //Brimstone::WindowEvent, Brimstone::WindowEventType, Brimstone::WindowEventMouseRaw, Brimstone::coalesceWindowEvent
+#include <brimstone/util/RingBuffer.hpp>     //Brimstone::RingBuffer
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::WindowEvent;
+using ::Brimstone::WindowEventType;
+using ::Brimstone::WindowEventMouseRaw;
+using ::Brimstone::RingBuffer;
+using ::Brimstone::coalesceWindowEvent;
+using ::Brimstone::uint64;
+
+
+
+
+//Functions
+WindowEvent mouseMove( const int x, const int y, const int dx, const int dy, const bool shift = false ) {
+    WindowEvent e;
+    e.type             = WindowEventType::MouseMove;
+    e.mouseMove.x      = x;
+    e.mouseMove.y      = y;
+    e.mouseMove.firstX = x;
+    e.mouseMove.firstY = y;
+    e.mouseMove.dx     = dx;
+    e.mouseMove.dy     = dy;
+    e.mouseMove.count  = 1;
+    e.mouseMove.ctrl   = false;
+    e.mouseMove.alt    = false;
+    e.mouseMove.shift  = shift;
+    e.mouseMove.system = false;
+    return e;
+}
+
+WindowEvent move( const int x, const int y ) {
+    WindowEvent e;
+    e.type        = WindowEventType::Move;
+    e.move.x      = x;
+    e.move.y      = y;
+    e.move.firstX = x;
+    e.move.firstY = y;
+    e.move.count  = 1;
+    return e;
+}
+
+WindowEvent resize( const int w, const int h ) {
+    WindowEvent e;
+    e.type          = WindowEventType::Resize;
+    e.resize.w      = w;
+    e.resize.h      = h;
+    e.resize.firstW = w;
+    e.resize.firstH = h;
+    e.resize.count  = 1;
+    return e;
+}
+
+WindowEvent mouseRaw( const WindowEventType type, const double dx, const double dy, const uint64 time ) {
+    WindowEvent e;
+    e.type = type;
+    WindowEventMouseRaw& raw = type == WindowEventType::MouseSmoothScroll ? e.mouseSmoothScroll : e.mouseRaw;
+    raw.dx    = dx;
+    raw.dy    = dy;
+    raw.time  = time;
+    raw.count = 1;
+    return e;
+}
+
+WindowEvent other( const WindowEventType type ) {
+    WindowEvent e;
+    e.type = type;
+    return e;
+}
+
+
+
+
+} //namespace
+
+
+
+
+namespace UnitTest {
+
+
+
+
+UT_TEST_BEGIN( WindowEvent_coalesceMouseMove )
+    RingBuffer< WindowEvent > queue;
+
+    //Consecutive moves become one, keeping where the first ended and summing the movement
+    if( coalesceWindowEvent( queue, mouseMove( 10, 20, 1, 2 ) ) ||
+        !coalesceWindowEvent( queue, mouseMove( 13, 18, 3, -2 ) ) ||
+        !coalesceWindowEvent( queue, mouseMove( 20, 18, 7, 0 ) ) )
+        return false;
+    if( queue.size() != 1 )
+        return false;
+    const auto& merged = queue.front().mouseMove;
+    if( merged.x != 20 || merged.y != 18 || merged.firstX != 10 || merged.firstY != 20 ||
+        merged.dx != 11 || merged.dy != 0 || merged.count != 3 )
+        return false;
+
+    //Moves made with different modifiers are kept apart
+    if( coalesceWindowEvent( queue, mouseMove( 21, 18, 1, 0, true ) ) || queue.size() != 2 )
+        return false;
+
+    //Moves aren't merged across other events, so they stay in order with them
+    coalesceWindowEvent( queue, other( WindowEventType::MouseDown ) );
+    if( coalesceWindowEvent( queue, mouseMove( 22, 18, 1, 0, true ) ) || queue.size() != 4 )
+        return false;
+    return queue.back().mouseMove.count == 1 && queue[1].mouseMove.count == 1;
+UT_TEST_END()
+
+UT_TEST_BEGIN( WindowEvent_coalesceMouseRaw )
+    RingBuffer< WindowEvent > queue;
+
+    //Raw moves are summed and keep the last report's time
+    coalesceWindowEvent( queue, mouseRaw( WindowEventType::MouseRawMove, 1.0, -2.0, 100 ) );
+    if( !coalesceWindowEvent( queue, mouseRaw( WindowEventType::MouseRawMove, 3.0, 0.5, 101 ) ) || queue.size() != 1 )
+        return false;
+    const auto& merged = queue.front().mouseRaw;
+    if( merged.dx != 4.0 || merged.dy != -1.5 || merged.time != 101 || merged.count != 2 )
+        return false;
+
+    //Smooth scrolls aren't merged into raw moves, or across a cursor move
+    if( coalesceWindowEvent( queue, mouseRaw( WindowEventType::MouseSmoothScroll, 0.0, 0.25, 102 ) ) ||
+        !coalesceWindowEvent( queue, mouseRaw( WindowEventType::MouseSmoothScroll, 0.0, 0.5, 103 ) ) || queue.size() != 2 )
+        return false;
+    coalesceWindowEvent( queue, mouseMove( 1, 1, 1, 1 ) );
+    if( coalesceWindowEvent( queue, mouseRaw( WindowEventType::MouseSmoothScroll, 0.0, 0.25, 104 ) ) || queue.size() != 4 )
+        return false;
+    return queue[1].mouseSmoothScroll.dy == 0.75 && queue[1].mouseSmoothScroll.count == 2;
+UT_TEST_END()
+
+UT_TEST_BEGIN( WindowEvent_coalesceGeometry )
+    RingBuffer< WindowEvent > queue;
+
+    //Moves and resizes from dragging a window's corner are merged into the first of each
+    coalesceWindowEvent( queue, move( 0, 0 ) );
+    coalesceWindowEvent( queue, resize( 100, 100 ) );
+    if( !coalesceWindowEvent( queue, move( 5, 6 ) ) || !coalesceWindowEvent( queue, resize( 90, 80 ) ) ||
+        !coalesceWindowEvent( queue, move( 7, 9 ) ) || queue.size() != 2 )
+        return false;
+    const auto& m = queue[0].move;
+    const auto& r = queue[1].resize;
+    if( m.x != 7 || m.y != 9 || m.firstX != 0 || m.firstY != 0 || m.count != 3 ||
+        r.w != 90 || r.h != 80 || r.firstW != 100 || r.firstH != 100 || r.count != 2 )
+        return false;
+
+    //Other events in between stop the merge
+    coalesceWindowEvent( queue, other( WindowEventType::KeyDown ) );
+    if( coalesceWindowEvent( queue, resize( 50, 50 ) ) || queue.size() != 4 || queue[1].resize.count != 2 )
+        return false;
+
+    //Mouse moves don't merge into them, and they don't merge into mouse moves
+    coalesceWindowEvent( queue, mouseMove( 1, 1, 1, 1 ) );
+    return !coalesceWindowEvent( queue, move( 8, 8 ) ) && queue.size() == 6;
+UT_TEST_END()
+
+
+
+
+} //namespace UnitTest
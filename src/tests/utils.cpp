@@ -13,6 +13,30 @@ Description:
 //Includes
 #include "utils.hpp"  //Header
 
+#include <png.h>      //png_*
+
+
+
+
+namespace {
+
+
+
+
+//Functions
+void writeToVector( png_structp write, png_bytep data, png_size_t size ) {
+    std::vector< Brimstone::ubyte >& out = *static_cast< std::vector< Brimstone::ubyte >* >( png_get_io_ptr( write ) );
+    out.insert( out.end(), data, data + size );
+}
+
+void flushVector( png_structp ) {
+}
+
+
+
+
+} //namespace
+
 
 
 
@@ -33,4 +57,32 @@ bool allWithin( const float* values, const float* ideals, const float err, const
     return true;
 }
 
+//encodePNG
+//Encodes the given 8-bit pixels as a PNG and returns the contents of the file.
+//channels is 1 (gray), 3 (RGB) or 4 (RGBA). Returns an empty vector if encoding failed.
+std::vector< Brimstone::ubyte > encodePNG( const Brimstone::ubyte* pixels, const int width, const int height, const int channels, const bool interlaced ) {
+    const int colorType = channels == 1 ? PNG_COLOR_TYPE_GRAY : channels == 3 ? PNG_COLOR_TYPE_RGB : PNG_COLOR_TYPE_RGBA;
+
+    std::vector< Brimstone::ubyte > out;
+    png_structp write = png_create_write_struct( PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr );
+    png_infop   info  = png_create_info_struct( write );
+    if( setjmp( png_jmpbuf( write ) ) ) {
+        png_destroy_write_struct( &write, &info );
+        return std::vector< Brimstone::ubyte >();
+    }
+
+    png_set_write_fn( write, &out, writeToVector, flushVector );
+    png_set_IHDR( write, info, width, height, 8, colorType, interlaced ? PNG_INTERLACE_ADAM7 : PNG_INTERLACE_NONE,
+                  PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT );
+
+    std::vector< png_bytep > rows( height );
+    for( int y = 0; y < height; ++y )
+        rows[y] = const_cast< png_bytep >( pixels + (std::size_t)y * width * channels );
+    png_set_rows( write, info, rows.data() );
+    png_write_png( write, info, PNG_TRANSFORM_IDENTITY, nullptr );
+
+    png_destroy_write_struct( &write, &info );
+    return out;
+}
+
 }
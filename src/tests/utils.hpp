@@ -13,11 +13,14 @@ Description:
 
 
 //Includes
-#include <cstddef>      //std::size_t
-#include <algorithm>    //std::equal
-#include <iterator>     //std::begin, std::end
-#include <type_traits>  //std::is_same
-#include <cassert>      //assert
+#include <cstddef>              //std::size_t
+#include <algorithm>            //std::equal
+#include <iterator>             //std::begin, std::end
+#include <type_traits>          //std::is_same
+#include <cassert>              //assert
+#include <vector>               //std::vector
+
+#include <brimstone/types.hpp>  //Brimstone::ubyte
 
 
 
@@ -52,6 +55,7 @@ extern const float FAST_SQRT_ERROR;
 //Forward declarations
 bool isWithin( const float value, const float ideal, const float err );
 bool allWithin( const float* values, const float* ideals, const float err, const int size );
+std::vector< Brimstone::ubyte > encodePNG( const Brimstone::ubyte* pixels, const int width, const int height, const int channels, const bool interlaced = false );
 
 
 
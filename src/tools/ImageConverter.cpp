@@ -0,0 +1,131 @@
+/*
+tools/ImageConverter.cpp
+------------------------
+Copyright (c) 2024, theJ89
+
+Description:
+    Converts PNGs to .bsi files (see graphics/ImageFile.hpp) offline, so they can be loaded without being decoded at runtime.
+
+    Usage:
+        ImageConverter [-lz4] [-mips] [-filter box|bilinear|lanczos|kaiser] [-srgb] input.png output.bsi
+
+    Options:
+        -lz4:     Compress the texels with LZ4.
+        -mips:    Generate a complete mipmap chain and store it along with the image.
+        -filter:  The filter to generate mipmaps with (see util/Resample.hpp). Defaults to kaiser.
+        -srgb:    Store the image as SRGB8_ALPHA8 instead of RGBA8, so mipmaps are filtered (and it's sampled) in linear space.
+
+    Mipmaps are resampled on every core.
+*/
+
+
+
+
+//Includes
+#include <brimstone/Image.hpp>                 //Brimstone::Image
+#include <brimstone/graphics/ImageFile.hpp>    //Brimstone::ImageFile, Brimstone::ImageCompression
+#include <brimstone/graphics/TextureData.hpp>  //Brimstone::TextureData
+#include <brimstone/util/Resample.hpp>         //Brimstone::ResampleFilter
+#include <brimstone/util/ThreadPool.hpp>       //Brimstone::ThreadPool
+
+#include <iostream>                            //std::cout, std::cerr
+#include <string>                              //std::string
+
+
+
+
+namespace {
+
+
+
+
+//Types
+using ::Brimstone::Image;
+using ::Brimstone::ImageFile;
+using ::Brimstone::ImageCompression;
+using ::Brimstone::TextureData;
+using ::Brimstone::TextureFormat;
+using ::Brimstone::ResampleFilter;
+using ::Brimstone::ThreadPool;
+
+
+
+
+//Functions
+int usage() {
+    std::cerr << "Usage: ImageConverter [-lz4] [-mips] [-filter box|bilinear|lanczos|kaiser] [-srgb] input.png output.bsi" << std::endl;
+    return 1;
+}
+
+//Reads the name of a filter into filterOut. Returns false if it isn't one.
+bool parseFilter( const std::string& name, ResampleFilter& filterOut ) {
+    if( name == "box" )
+        filterOut = ResampleFilter::BOX;
+    else if( name == "bilinear" )
+        filterOut = ResampleFilter::BILINEAR;
+    else if( name == "lanczos" )
+        filterOut = ResampleFilter::LANCZOS3;
+    else if( name == "kaiser" )
+        filterOut = ResampleFilter::KAISER;
+    else
+        return false;
+    return true;
+}
+
+
+
+
+} //namespace
+
+
+
+
+int main( int argc, char** argv ) {
+    ImageCompression compression = ImageCompression::NONE;
+    bool             mipmaps     = false;
+    bool             srgb        = false;
+    ResampleFilter   filter      = ResampleFilter::KAISER;
+
+    int i = 1;
+    for( ; i < argc && argv[i][0] == '-'; ++i ) {
+        const std::string option = argv[i];
+        if( option == "-lz4" )
+            compression = ImageCompression::LZ4;
+        else if( option == "-mips" )
+            mipmaps = true;
+        else if( option == "-filter" && i + 1 < argc && parseFilter( argv[i + 1], filter ) )
+            ++i;
+        else if( option == "-srgb" )
+            srgb = true;
+        else
+            return usage();
+    }
+    if( argc - i != 2 )
+        return usage();
+
+    const std::string input  = argv[i];
+    const std::string output = argv[i + 1];
+
+    Image image;
+    if( !image.loadPNG( input ) ) {
+        std::cerr << "Couldn't load \"" << input << "\"." << std::endl;
+        return 1;
+    }
+
+    TextureData data;
+    if( mipmaps ) {
+        ThreadPool pool;
+        data = image.buildMipChain( filter, srgb, &pool );
+    } else {
+        data.set( srgb ? TextureFormat::SRGB8_ALPHA8 : TextureFormat::RGBA8, image.getSize().width, image.getSize().height, image.getData(), image.getStride() );
+    }
+
+    if( !ImageFile::save( output, data, compression ) ) {
+        std::cerr << "Couldn't write \"" << output << "\"." << std::endl;
+        return 1;
+    }
+
+    std::cout << input << " -> " << output << " (" << data.getWidth() << "x" << data.getHeight() << ", "
+              << data.getLevelCount() << ( data.getLevelCount() == 1 ? " level)" : " levels)" ) << std::endl;
+    return 0;
+}